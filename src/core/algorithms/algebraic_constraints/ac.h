@@ -1,59 +1,46 @@
 #pragma once
 
-#include <memory>
+#include <cstddef>
+#include <vector>
 
 namespace algos {
 
-/* Stores pair of values, indexes of values in the table
- * and the result of an arithmetic operation between them */
-class ACPair {
-public:
-    struct ColumnValueIndex {
-        size_t column;
-        size_t value_index;
-
-        bool operator==(ColumnValueIndex const& o) const {
-            return column == o.column && value_index == o.value_index;
-        }
-
-        bool operator!=(ColumnValueIndex const& o) const {
-            return !(o == *this);
-        }
-    };
-
+/* Stores results of an arithmetic operation between value pairs sampled from a pair
+ * of columns. Results have the type of the columns and lie contiguously in ascending
+ * order, so ranges can point directly into them */
+class ACPairs {
 private:
-    /* Index of the left operand and its value */
-    ColumnValueIndex lhs_;
-    std::byte const* lhs_val_;
-    /* Index of the right operand and its value */
-    ColumnValueIndex rhs_;
-    std::byte const* rhs_val_;
-    /* The result of a binary arithmetic operation */
-    std::unique_ptr<std::byte[]> res_;
+    size_t value_size_ = 0;
+    std::vector<std::byte> results_;
 
 public:
-    ACPair(ColumnValueIndex l, ColumnValueIndex r, std::byte const* la, std::byte const* ra,
-           std::unique_ptr<std::byte[]> res)
-        : lhs_(l), lhs_val_(la), rhs_(r), rhs_val_(ra), res_(std::move(res)) {}
+    /* Makes room for size results of type T, keeping the buffer if it is large enough,
+     * and returns it. The caller fills it and sorts it */
+    template <typename T>
+    T* Resize(size_t size) {
+        value_size_ = sizeof(T);
+        results_.resize(size * sizeof(T));
+        return reinterpret_cast<T*>(results_.data());
+    }
 
-    ColumnValueIndex GetLhsColumnValueIndex() const {
-        return lhs_;
+    size_t size() const {
+        return value_size_ == 0 ? 0 : results_.size() / value_size_;
     }
 
-    ColumnValueIndex GetRhsColumnValueIndex() const {
-        return rhs_;
+    bool empty() const {
+        return results_.empty();
     }
 
-    std::byte const* GetLhsValue() const {
-        return lhs_val_;
+    std::byte const* GetRes(size_t i) const {
+        return results_.data() + i * value_size_;
     }
 
-    std::byte const* GetRhsValue() const {
-        return rhs_val_;
+    std::byte const* Front() const {
+        return GetRes(0);
     }
 
-    std::byte const* GetRes() const {
-        return res_.get();
+    std::byte const* Back() const {
+        return GetRes(size() - 1);
     }
 };
 
@@ -1,15 +1,19 @@
 #include "core/algorithms/algebraic_constraints/ac_algorithm.h"
 
+#include <algorithm>
 #include <cmath>
-#include <functional>
 #include <iostream>
 #include <random>
 
+#include "core/algorithms/algebraic_constraints/binop_kernels.h"
 #include "core/config/exceptions.h"
 #include "core/config/names_and_descriptions.h"
 #include "core/config/tabular_data/input_table/option.h"
+#include "core/config/thread_number/option.h"
+#include "core/model/table/dataset.h"
 #include "core/model/types/create_type.h"
 #include "core/util/logger.h"
+#include "core/util/worker_thread_pool.h"
 
 namespace algos {
 
@@ -24,19 +28,12 @@ void ACAlgorithm::RegisterOptions() {
     using namespace config::descriptions;
     using config::Option;
 
-    auto check_and_set_binop = [this](Binop bin_operation) {
+    auto check_binop = [](Binop bin_operation) {
         switch (bin_operation) {
             case Binop::kAddition:
-                binop_pointer_ = &model::INumericType::Add;
-                break;
             case Binop::kSubtraction:
-                binop_pointer_ = &model::INumericType::Sub;
-                break;
             case Binop::kMultiplication:
-                binop_pointer_ = &model::INumericType::Mul;
-                break;
             case Binop::kDivision:
-                binop_pointer_ = &model::INumericType::Div;
                 break;
             default:
                 throw config::ConfigurationError(
@@ -64,7 +61,7 @@ void ACAlgorithm::RegisterOptions() {
 
     RegisterOption(config::kTableOpt(&input_table_));
     RegisterOption(Option{&bin_operation_, kBinaryOperation, kDBinaryOperation}.SetValueCheck(
-            check_and_set_binop));
+            check_binop));
     RegisterOption(Option{&fuzziness_, kFuzziness, kDFuzziness}.SetValueCheck(check_fuzziness));
     RegisterOption(Option{&p_fuzz_, kFuzzinessProbability, kDFuzzinessProbability}.SetValueCheck(
             check_p_fuzz));
@@ -74,17 +71,17 @@ void ACAlgorithm::RegisterOptions() {
     RegisterOption(Option{&iterations_limit_, kIterationsLimit, kDIterationsLimit}.SetValueCheck(
             check_positive));
     RegisterOption(Option{&seed_, kACSeed, kDACSeed});
+    RegisterOption(config::kThreadNumberOpt(&threads_));
 }
 
 void ACAlgorithm::LoadDataInternal() {
-    typed_relation_ = model::ColumnLayoutTypedRelationData::CreateFrom(*input_table_,
-                                                                       false);  // nulls are ignored
+    typed_relation_ = model::LoadTypedRelation(*input_table_, false);  // nulls are ignored
 }
 
 void ACAlgorithm::MakeExecuteOptsAvailable() {
     using namespace config::names;
     MakeOptionsAvailable({kFuzziness, kFuzzinessProbability, kWeight, kBumpsLimit, kIterationsLimit,
-                          kACSeed, kBinaryOperation});
+                          kACSeed, kBinaryOperation, config::kThreadNumberOpt.GetName()});
 }
 
 void ACAlgorithm::ResetState() {
@@ -126,9 +123,13 @@ size_t ACAlgorithm::CalculateSampleSize(size_t k_bumps) const {
     return sample_size > num_rows ? num_rows : sample_size;
 }
 
+template <typename T>
 std::vector<std::byte const*> ACAlgorithm::Sampling(std::vector<model::TypedColumnData> const& data,
-                                                    size_t lhs_i, size_t rhs_i) {
-    ACPairs ac_pairs;
+                                                    size_t lhs_i, size_t rhs_i,
+                                                    ACPairs& ac_pairs) const {
+    std::unique_ptr<model::INumericType> num_type =
+            model::CreateSpecificType<model::INumericType>(data.at(lhs_i).GetTypeId(), true);
+    std::vector<size_t> rows;
     std::vector<std::byte const*> ranges;
     size_t k_bumps = 1;
     size_t i = 0;
@@ -140,60 +141,46 @@ std::vector<std::byte const*> ACAlgorithm::Sampling(std::vector<model::TypedColu
         k_bumps = new_k_bumps;
         sample_size = CalculateSampleSize(k_bumps);
         double probability = sample_size / static_cast<double>(n_rows);
-        ranges = SamplingIteration(data, lhs_i, rhs_i, probability, ac_pairs);
+        ranges = SamplingIteration<T>(data, lhs_i, rhs_i, probability, *num_type, rows, ac_pairs);
         new_k_bumps = ranges.size() / 2;
         if (new_k_bumps == 0) {
             new_k_bumps = k_bumps + 1;
         }
         ++i;
     }
-    RestrictRangesAmount(ranges);
-    ac_pairs_.emplace_back(ACPairsCollection(
-            model::CreateSpecificType<model::INumericType>(data.at(lhs_i).GetTypeId(), true),
-            std::move(ac_pairs), lhs_i, rhs_i));
+    RestrictRangesAmount(ranges, *num_type);
     return ranges;
 }
 
+template <typename T>
 std::vector<std::byte const*> ACAlgorithm::SamplingIteration(
         std::vector<model::TypedColumnData> const& data, size_t lhs_i, size_t rhs_i,
-        double probability, ACPairs& ac_pairs) {
-    std::vector<std::byte const*> const& lhs = data.at(lhs_i).GetData();
-    std::vector<std::byte const*> const& rhs = data.at(rhs_i).GetData();
-    ac_pairs.clear();
+        double probability, model::INumericType const& num_type, std::vector<size_t>& rows,
+        ACPairs& ac_pairs) const {
+    model::TypedColumnData const& lhs = data.at(lhs_i);
+    model::TypedColumnData const& rhs = data.at(rhs_i);
+    size_t const n_rows = lhs.GetData().size();
+    rows.clear();
+    /* Every column pair gets its own generator seeded the same way, so the sample does not
+     * depend on the order in which threads pick column pairs */
     std::mt19937 gen(seed_);
 
     std::bernoulli_distribution d(probability);
-    for (size_t i = 0; i < lhs.size(); ++i) {
-        if (d(gen)) {
-            std::byte const* l = lhs.at(i);
-            std::byte const* r = rhs.at(i);
-            if (data[lhs_i].IsNullOrEmpty(i) || data[rhs_i].IsNullOrEmpty(i)) {
-                continue;
-            }
-            auto res = std::unique_ptr<std::byte[]>(num_type_->Allocate());
-            num_type_->ValueFromStr(res.get(), "0");
-            if (bin_operation_ == Binop::kDivision &&
-                num_type_->Compare(r, res.get()) == model::CompareResult::kEqual) {
-                continue;
-            }
-            InvokeBinop(l, r, res.get());
-            auto ac = std::make_unique<ACPair>(ACPair::ColumnValueIndex{lhs_i, i},
-                                               ACPair::ColumnValueIndex{rhs_i, i}, l, r,
-                                               std::move(res));
-            ac_pairs.emplace_back(std::move(ac));
+    for (size_t i = 0; i < n_rows; ++i) {
+        if (d(gen) && algebraic_constraints::IsOperandPair<T>(lhs, rhs, i, bin_operation_)) {
+            rows.push_back(i);
         }
     }
 
-    std::sort(ac_pairs.begin(), ac_pairs.end(),
-              [this](std::unique_ptr<ACPair> const& a, std::unique_ptr<ACPair> const& b) {
-                  return model::CompareResult::kLess ==
-                         this->num_type_->Compare(a->GetRes(), b->GetRes());
-              });
+    T* results = ac_pairs.Resize<T>(rows.size());
+    algebraic_constraints::ApplyBinop(bin_operation_, lhs.GetData(), rhs.GetData(), rows, results);
+    std::sort(results, results + rows.size());
 
-    return ConstructDisjunctiveRanges(ac_pairs);
+    return ConstructDisjunctiveRanges(ac_pairs, num_type);
 }
 
-void ACAlgorithm::RestrictRangesAmount(std::vector<std::byte const*>& ranges) const {
+void ACAlgorithm::RestrictRangesAmount(std::vector<std::byte const*>& ranges,
+                                       model::INumericType const& num_type) const {
     if (bumps_limit_ == 0) {
         return;
     }
@@ -208,7 +195,7 @@ void ACAlgorithm::RestrictRangesAmount(std::vector<std::byte const*>& ranges) co
         double min_dist = -1;
         size_t min_index = 1;
         for (size_t i = min_index; i < bumps * 2 - 1; i += 2) {
-            double dist = num_type_->Dist(ranges.at(i), ranges.at(i + 1));
+            double dist = num_type.Dist(ranges.at(i), ranges.at(i + 1));
             if (min_dist == -1 || dist < min_dist) {
                 min_dist = dist;
                 min_index = i;
@@ -267,39 +254,30 @@ void ACAlgorithm::PrintRanges(std::vector<model::TypedColumnData> const& data) c
 }
 
 std::vector<std::byte const*> ACAlgorithm::ConstructDisjunctiveRanges(
-        ACPairs const& ac_pairs) const {
+        ACPairs const& ac_pairs, model::INumericType const& num_type) const {
     std::vector<std::byte const*> ranges;
     if (ac_pairs.size() < 2) {
-        ranges = std::vector<std::byte const*>();
         return ranges;
     }
 
-    ACPair const* l_border = ac_pairs.front().get();
-    ACPair const* r_border = nullptr;
+    std::byte const* l_border = ac_pairs.Front();
 
     if (weight_ < 1) {
-        double delta = num_type_->Dist(ac_pairs.front()->GetRes(), ac_pairs.back()->GetRes()) *
-                       (weight_ / (1 - weight_));
+        double delta = num_type.Dist(ac_pairs.Front(), ac_pairs.Back()) * (weight_ / (1 - weight_));
 
         for (size_t i = 0; i < ac_pairs.size() - 1; ++i) {
-            if (num_type_->Dist(ac_pairs[i]->GetRes(), ac_pairs[i + 1]->GetRes()) <= delta) {
-                r_border = ac_pairs[i + 1].get();
-            } else {
-                ranges.emplace_back(l_border->GetRes());
-                ranges.emplace_back(ac_pairs[i]->GetRes());
-                l_border = ac_pairs[i + 1].get();
-                r_border = ac_pairs[i + 1].get();
+            if (num_type.Dist(ac_pairs.GetRes(i), ac_pairs.GetRes(i + 1)) > delta) {
+                ranges.emplace_back(l_border);
+                ranges.emplace_back(ac_pairs.GetRes(i));
+                l_border = ac_pairs.GetRes(i + 1);
             }
         }
     } else {
         assert(weight_ == 1);
-        r_border = ac_pairs.back().get();
     }
 
-    if (r_border == ac_pairs.back().get()) {
-        ranges.emplace_back(l_border->GetRes());
-        ranges.emplace_back(r_border->GetRes());
-    }
+    ranges.emplace_back(l_border);
+    ranges.emplace_back(ac_pairs.Back());
 
     return ranges;
 }
@@ -309,7 +287,8 @@ RangesCollection ACAlgorithm::ReconstructRangesByColumns(size_t lhs_i, size_t rh
     SetOption(config::names::kWeight, weight);
     ACPairsCollection const& constraints_collection = GetACPairsByColumns(lhs_i, rhs_i);
     ACPairs const& ac_pairs = constraints_collection.ac_pairs;
-    std::vector<std::byte const*> ranges = ConstructDisjunctiveRanges(ac_pairs);
+    std::vector<std::byte const*> ranges =
+            ConstructDisjunctiveRanges(ac_pairs, *constraints_collection.col_pair.num_type);
     model::TypeId type_id = constraints_collection.col_pair.num_type->GetTypeId();
     return RangesCollection{model::CreateSpecificType<model::INumericType>(type_id, true),
                             std::move(ranges), lhs_i, rhs_i};
@@ -322,29 +301,53 @@ unsigned long long ACAlgorithm::ExecuteInternal() {
     }
     auto start_time = std::chrono::system_clock::now();
 
+    std::vector<std::pair<size_t, size_t>> col_pairs;
     for (size_t col_i = 0; col_i < data.size() - 1; ++col_i) {
         if (!data.at(col_i).GetType().IsNumeric()) continue;
-        num_type_ =
-                model::CreateSpecificType<model::INumericType>(data.at(col_i).GetTypeId(), true);
         for (size_t col_k = col_i + 1; col_k < data.size(); ++col_k) {
             if (data.at(col_i).GetTypeId() == data.at(col_k).GetTypeId()) {
-                ranges_.emplace_back(
-                        RangesCollection{model::CreateSpecificType<model::INumericType>(
-                                                 data.at(col_i).GetTypeId(), true),
-                                         Sampling(data, col_i, col_k), col_i, col_k});
+                col_pairs.emplace_back(col_i, col_k);
                 /* Because of asymmetry and division by 0, we need to rediscover ranges.
                  * We don't need to do that for minus: (column1 - column2) lies in *some ranges*
                  * there we can express one column through another without possible problems */
                 if (bin_operation_ == Binop::kDivision) {
-                    ranges_.emplace_back(
-                            RangesCollection{model::CreateSpecificType<model::INumericType>(
-                                                     data.at(col_i).GetTypeId(), true),
-                                             Sampling(data, col_k, col_i), col_k, col_i});
+                    col_pairs.emplace_back(col_k, col_i);
                 }
             }
         }
     }
 
+    /* Ranges point into the results of their column pair, which are moved to ac_pairs_
+     * without reallocation */
+    std::vector<ACPairs> samples(col_pairs.size());
+    std::vector<std::vector<std::byte const*>> pair_ranges(col_pairs.size());
+    auto sample_pair = [&](size_t i) {
+        auto [lhs_i, rhs_i] = col_pairs[i];
+        pair_ranges[i] = algebraic_constraints::VisitNumericType(
+                data[lhs_i].GetTypeId(), [&]<typename T>(T) {
+                    return Sampling<T>(data, lhs_i, rhs_i, samples[i]);
+                });
+    };
+    if (threads_ > 1 && col_pairs.size() > 1) {
+        util::WorkerThreadPool pool(threads_);
+        pool.ExecIndex(sample_pair, col_pairs.size());
+    } else {
+        for (size_t i = 0; i < col_pairs.size(); ++i) {
+            sample_pair(i);
+        }
+    }
+
+    ac_pairs_.reserve(col_pairs.size());
+    ranges_.reserve(col_pairs.size());
+    for (size_t i = 0; i < col_pairs.size(); ++i) {
+        auto [lhs_i, rhs_i] = col_pairs[i];
+        model::TypeId type_id = data[lhs_i].GetTypeId();
+        ac_pairs_.emplace_back(model::CreateSpecificType<model::INumericType>(type_id, true),
+                               std::move(samples[i]), lhs_i, rhs_i);
+        ranges_.emplace_back(model::CreateSpecificType<model::INumericType>(type_id, true),
+                             std::move(pair_ranges[i]), lhs_i, rhs_i);
+    }
+
     auto elapsed_milliseconds = std::chrono::duration_cast<std::chrono::milliseconds>(
             std::chrono::system_clock::now() - start_time);
     PrintRanges(data);
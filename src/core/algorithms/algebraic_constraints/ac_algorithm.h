@@ -1,6 +1,5 @@
 #pragma once
 
-#include <functional>
 #include <unordered_map>
 #include <vector>
 
@@ -13,6 +12,7 @@
 #include "core/algorithms/algebraic_constraints/typed_column_pair.h"
 #include "core/algorithms/algorithm.h"
 #include "core/config/tabular_data/input_table_type.h"
+#include "core/config/thread_number/type.h"
 #include "core/model/table/column_layout_typed_relation_data.h"
 #include "core/model/types/types.h"
 
@@ -50,41 +50,43 @@ private:
      * by ratio of exceptional records */
     double p_fuzz_;
     size_t iterations_limit_;
-    std::unique_ptr<TypedRelation> typed_relation_;
+    std::shared_ptr<TypedRelation const> typed_relation_;
     std::unique_ptr<algebraic_constraints::ACExceptionFinder> ac_exception_finder_;
     double seed_;
+    config::ThreadNumType threads_;
     std::vector<ACPairsCollection> ac_pairs_;
     std::vector<RangesCollection> ranges_;
-    model::INumericType::NumericBinop binop_pointer_ = nullptr;
-    std::unique_ptr<model::INumericType> num_type_;
 
     /* Returns vector with ranges boundaries constructed for columns with lhs_i and rhs_i indices.
      * Value pairs (by which ranges constructed) fall into sample selection with chosen probability.
-     */
+     * Rows of the sample are collected into rows, results are written into ac_pairs. Both keep
+     * their buffers between iterations. */
+    template <typename T>
     std::vector<std::byte const*> SamplingIteration(std::vector<model::TypedColumnData> const& data,
                                                     size_t lhs_i, size_t rhs_i, double probability,
-                                                    ACPairs& ac_pairs);
+                                                    model::INumericType const& num_type,
+                                                    std::vector<size_t>& rows,
+                                                    ACPairs& ac_pairs) const;
     /* Returns vector with ranges boundaries constructed for columns with lhs_i and rhs_i indices.
      * These ranges are part of AC for that column pair (as in AC definition). Uses iterative
      * algorithm that uses SamplingIteration method. In the vast majority of cases there is less
-     *  than 4 iterations.  */
+     *  than 4 iterations. Touches no shared state, so column pairs are sampled in parallel. */
+    template <typename T>
     std::vector<std::byte const*> Sampling(std::vector<model::TypedColumnData> const& data,
-                                           size_t lhs_i, size_t rhs_i);
+                                           size_t lhs_i, size_t rhs_i, ACPairs& ac_pairs) const;
     /* Returns vector with ranges boundaries. Ranges constructed by grouping results of binary
      * operation between values in ac_pairs. */
-    std::vector<std::byte const*> ConstructDisjunctiveRanges(ACPairs const& ac_pairs) const;
+    std::vector<std::byte const*> ConstructDisjunctiveRanges(
+            ACPairs const& ac_pairs, model::INumericType const& num_type) const;
     /* Greedily combines ranges if there is more than bumps_limit_ */
-    void RestrictRangesAmount(std::vector<std::byte const*>& ranges) const;
+    void RestrictRangesAmount(std::vector<std::byte const*>& ranges,
+                              model::INumericType const& num_type) const;
     void RegisterOptions();
     void LoadDataInternal() override;
     void MakeExecuteOptsAvailable() override;
     void ResetState() override;
 
 public:
-    void InvokeBinop(std::byte const* l, std::byte const* r, std::byte* res) const {
-        std::invoke(binop_pointer_, num_type_, l, r, res);
-    }
-
     size_t CalculateSampleSize(size_t k_bumps) const;
     /* Returns ranges reconstructed with new weight for pair of columns */
     RangesCollection ReconstructRangesByColumns(size_t lhs_i, size_t rhs_i, double weight);
@@ -111,7 +113,7 @@ public:
     void PrintRanges(std::vector<model::TypedColumnData> const& data) const;
 
     void CollectACExceptions() const {
-        ac_exception_finder_->CollectExceptions(this);
+        ac_exception_finder_->CollectExceptions(this, threads_);
     }
 
     unsigned long long ExecuteInternal() override;
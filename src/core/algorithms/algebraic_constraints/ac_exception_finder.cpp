@@ -1,14 +1,19 @@
 #include "core/algorithms/algebraic_constraints/ac_exception_finder.h"
 
+#include <algorithm>
+#include <utility>
+
 #include "core/algorithms/algebraic_constraints/ac_algorithm.h"
 #include "core/algorithms/algebraic_constraints/bin_operation_enum.h"
+#include "core/algorithms/algebraic_constraints/binop_kernels.h"
+#include "core/util/worker_thread_pool.h"
 
 namespace algos::algebraic_constraints {
 
 bool ACExceptionFinder::ValueBelongsToRanges(RangesCollection const& ranges_collection,
                                              std::byte const* val) {
     model::INumericType* num_type = ranges_collection.col_pair.num_type.get();
-    for (size_t i = 0; i < ranges_collection.ranges.size() - 1; i += 2) {
+    for (size_t i = 0; i + 1 < ranges_collection.ranges.size(); i += 2) {
         std::byte const* l_border = ranges_collection.ranges[i];
         std::byte const* r_border = ranges_collection.ranges[i + 1];
         if (num_type->Compare(l_border, val) == model::CompareResult::kEqual ||
@@ -23,52 +28,74 @@ bool ACExceptionFinder::ValueBelongsToRanges(RangesCollection const& ranges_coll
     return false;
 }
 
-void ACExceptionFinder::AddException(size_t row_i, std::pair<size_t, size_t> const& col_pair) {
-    auto equal = [row_i](ACException const& e) { return e.row_i == row_i; };
-    auto exception_i = std::find_if(exceptions_.begin(), exceptions_.end(), equal);
-    if (exception_i == exceptions_.end()) {
-        exceptions_.push_back(ACException(row_i, col_pair));
-    } else {
-        exception_i->column_pairs.push_back(col_pair);
-    }
-}
-
-void ACExceptionFinder::CollectColumnPairExceptions(std::vector<model::TypedColumnData> const& data,
-                                                    RangesCollection const& ranges_collection) {
+template <typename T>
+std::vector<size_t> ACExceptionFinder::CollectColumnPairExceptions(
+        std::vector<model::TypedColumnData> const& data,
+        RangesCollection const& ranges_collection) const {
     size_t lhs_i = ranges_collection.col_pair.col_i.first;
     size_t rhs_i = ranges_collection.col_pair.col_i.second;
-    std::vector<std::byte const*> const& lhs = data.at(lhs_i).GetData();
-    std::vector<std::byte const*> const& rhs = data.at(rhs_i).GetData();
-    std::unique_ptr<model::INumericType> num_type =
-            model::CreateSpecificType<model::INumericType>(data.at(lhs_i).GetTypeId(), true);
-    for (size_t i = 0; i < lhs.size(); ++i) {
-        std::byte const* l = lhs.at(i);
-        std::byte const* r = rhs.at(i);
-        if (data[lhs_i].IsNullOrEmpty(i) || data[rhs_i].IsNullOrEmpty(i)) {
-            continue;
-        }
-        auto res = std::unique_ptr<std::byte[]>(num_type->Allocate());
-        num_type->ValueFromStr(res.get(), "0");
-        if (ac_alg_->GetBinOperation() == Binop::kDivision &&
-            num_type->Compare(r, res.get()) == model::CompareResult::kEqual) {
-            continue;
+    model::TypedColumnData const& lhs = data.at(lhs_i);
+    model::TypedColumnData const& rhs = data.at(rhs_i);
+    Binop const bin_operation = ac_alg_->GetBinOperation();
+
+    std::vector<size_t> rows;
+    for (size_t i = 0; i < lhs.GetData().size(); ++i) {
+        if (IsOperandPair<T>(lhs, rhs, i, bin_operation)) {
+            rows.push_back(i);
         }
-        ac_alg_->InvokeBinop(l, r, res.get());
-        if (!ValueBelongsToRanges(ranges_collection, res.get())) {
-            AddException(i, {lhs_i, rhs_i});
+    }
+    std::vector<T> results(rows.size());
+    ApplyBinop(bin_operation, lhs.GetData(), rhs.GetData(), rows, results.data());
+
+    std::vector<size_t> exception_rows;
+    for (size_t i = 0; i < rows.size(); ++i) {
+        if (!ValueBelongsToRanges(ranges_collection,
+                                  reinterpret_cast<std::byte const*>(&results[i]))) {
+            exception_rows.push_back(rows[i]);
         }
     }
+    return exception_rows;
 }
 
-void ACExceptionFinder::CollectExceptions(algos::ACAlgorithm const* ac_alg) {
+void ACExceptionFinder::CollectExceptions(algos::ACAlgorithm const* ac_alg,
+                                          config::ThreadNumType threads) {
     ac_alg_ = ac_alg;
+    exceptions_.clear();
     std::vector<model::TypedColumnData> const& data = ac_alg_->GetTypedData();
     std::vector<RangesCollection> const& ranges = ac_alg_->GetRangesCollections();
-    for (auto const& ranges_collection : ranges) {
-        CollectColumnPairExceptions(data, ranges_collection);
+
+    std::vector<std::vector<size_t>> pair_exceptions(ranges.size());
+    auto collect_pair = [&](size_t i) {
+        pair_exceptions[i] = VisitNumericType(
+                ranges[i].col_pair.num_type->GetTypeId(), [&]<typename T>(T) {
+                    return CollectColumnPairExceptions<T>(data, ranges[i]);
+                });
+    };
+    if (threads > 1 && ranges.size() > 1) {
+        util::WorkerThreadPool pool(threads);
+        pool.ExecIndex(collect_pair, ranges.size());
+    } else {
+        for (size_t i = 0; i < ranges.size(); ++i) {
+            collect_pair(i);
+        }
+    }
+
+    /* Ordering (row, ranges index) keeps column pairs of a row in the order of ranges */
+    std::vector<std::pair<size_t, size_t>> row_exceptions;
+    for (size_t i = 0; i < pair_exceptions.size(); ++i) {
+        for (size_t row_i : pair_exceptions[i]) {
+            row_exceptions.emplace_back(row_i, i);
+        }
+    }
+    std::sort(row_exceptions.begin(), row_exceptions.end());
+    for (auto [row_i, ranges_i] : row_exceptions) {
+        std::pair<size_t, size_t> const& col_pair = ranges[ranges_i].col_pair.col_i;
+        if (exceptions_.empty() || exceptions_.back().row_i != row_i) {
+            exceptions_.emplace_back(row_i, col_pair);
+        } else {
+            exceptions_.back().column_pairs.push_back(col_pair);
+        }
     }
-    auto comp = [](ACException const& a, ACException const& b) { return a.row_i < b.row_i; };
-    std::sort(exceptions_.begin(), exceptions_.end(), comp);
 }
 
 }  // namespace algos::algebraic_constraints
@@ -4,6 +4,7 @@
 
 #include "core/algorithms/algebraic_constraints/ac_exception.h"
 #include "core/algorithms/algebraic_constraints/ranges_collection.h"
+#include "core/config/thread_number/type.h"
 #include "core/model/table/column_layout_typed_relation_data.h"
 
 namespace algos {
@@ -18,13 +19,16 @@ private:
     ACAlgorithm const* ac_alg_;
     static bool ValueBelongsToRanges(RangesCollection const& ranges_collection,
                                      std::byte const* val);
-    /* Creates new ACException and adds it to exceptions_ or adds col_pair to existing one */
-    void AddException(size_t row_i, std::pair<size_t, size_t> const& col_pair);
-    void CollectColumnPairExceptions(std::vector<model::TypedColumnData> const& data,
-                                     RangesCollection const& ranges_collection);
+    /* Returns rows, in ascending order, where the result of the binary operation for the
+     * column pair of ranges_collection does not belong to its ranges */
+    template <typename T>
+    std::vector<size_t> CollectColumnPairExceptions(
+            std::vector<model::TypedColumnData> const& data,
+            RangesCollection const& ranges_collection) const;
 
 public:
-    void CollectExceptions(ACAlgorithm const* ac_alg);
+    /* Column pairs are scanned independently by up to threads threads */
+    void CollectExceptions(ACAlgorithm const* ac_alg, config::ThreadNumType threads);
 
     void ResetState() {
         exceptions_.clear();
@@ -1,15 +1,12 @@
 #pragma once
 
 #include <memory>
-#include <vector>
 
 #include "core/algorithms/algebraic_constraints/ac.h"
 #include "core/algorithms/algebraic_constraints/typed_column_pair.h"
 
 namespace algos {
 
-using ACPairs = std::vector<std::unique_ptr<ACPair>>;
-
 /* Contains value pairs for a specific pair of columns */
 struct ACPairsCollection {
     ACPairsCollection(std::unique_ptr<model::INumericType> num_type, ACPairs&& ac_pairs,
@@ -18,7 +15,7 @@ struct ACPairsCollection {
 
     /* Column pair indices and pointer to their type */
     TypedColumnPair col_pair;
-    /* Vector with ACPairs */
+    /* Sorted results of the binary operation between sampled value pairs */
     ACPairs ac_pairs;
 };
 
@@ -0,0 +1,69 @@
+#pragma once
+
+#include <cassert>
+#include <cstddef>
+#include <functional>
+#include <vector>
+
+#include "core/algorithms/algebraic_constraints/bin_operation_enum.h"
+#include "core/model/table/typed_column_data.h"
+#include "core/model/types/builtin.h"
+#include "core/model/types/type.h"
+
+namespace algos::algebraic_constraints {
+
+/* Calls func with a value of the C++ type that stores values of numeric type_id */
+template <typename Func>
+decltype(auto) VisitNumericType(model::TypeId type_id, Func&& func) {
+    switch (type_id) {
+        case model::TypeId::kInt:
+            return func(model::Int{});
+        case model::TypeId::kDouble:
+            return func(model::Double{});
+        default:
+            assert(false);
+            __builtin_unreachable();
+    }
+}
+
+/* Checks whether the values of lhs and rhs in row_i are operands of bin_operation:
+ * both are present and, in case of division, the divisor is not zero */
+template <typename T>
+bool IsOperandPair(model::TypedColumnData const& lhs, model::TypedColumnData const& rhs,
+                   size_t row_i, Binop bin_operation) {
+    if (lhs.IsNullOrEmpty(row_i) || rhs.IsNullOrEmpty(row_i)) {
+        return false;
+    }
+    return bin_operation != Binop::kDivision ||
+           model::Type::GetValue<T>(rhs.GetValue(row_i)) != T{0};
+}
+
+/* Writes the results of bin_operation between the values of lhs and rhs in each of rows
+ * to res, which has to hold rows.size() values. The operation is chosen once per call,
+ * so the loop itself makes no virtual calls and allocates nothing */
+template <typename T>
+void ApplyBinop(Binop bin_operation, std::vector<std::byte const*> const& lhs,
+                std::vector<std::byte const*> const& rhs, std::vector<size_t> const& rows, T* res) {
+    auto apply = [&lhs, &rhs, &rows, res](auto op) {
+        for (size_t i = 0; i < rows.size(); ++i) {
+            res[i] = op(model::Type::GetValue<T>(lhs[rows[i]]),
+                        model::Type::GetValue<T>(rhs[rows[i]]));
+        }
+    };
+    switch (bin_operation) {
+        case Binop::kAddition:
+            apply(std::plus<T>{});
+            break;
+        case Binop::kSubtraction:
+            apply(std::minus<T>{});
+            break;
+        case Binop::kMultiplication:
+            apply(std::multiplies<T>{});
+            break;
+        case Binop::kDivision:
+            apply(std::divides<T>{});
+            break;
+    }
+}
+
+}  // namespace algos::algebraic_constraints
@@ -87,7 +87,19 @@ unsigned long long Algorithm::Execute() {
     if (!AllRequiredOptionsAreSet())
         throw std::logic_error("All options need to be set before execution.");
     ResetState();
-    auto time_ms = ExecuteInternal();
+    arena_.Release();
+    cancellation_token_.Start();
+    unsigned long long time_ms = 0;
+    // Algorithms without safe points of their own can still be stopped before they start.
+    if (!ShouldStop()) {
+        try {
+            time_ms = ExecuteInternal();
+        } catch (...) {
+            cancellation_token_.Finish();
+            throw;
+        }
+    }
+    cancellation_token_.Finish();
     for (auto const& opt_name : available_options_) {
         possible_options_.at(opt_name)->Unset();
     }
@@ -1,5 +1,6 @@
 #pragma once
 
+#include <chrono>
 #include <filesystem>
 #include <string_view>
 #include <typeindex>
@@ -14,6 +15,8 @@
 #include "core/config/option.h"
 #include "core/model/table/idataset_stream.h"
 #include "core/parser/csv_parser/csv_parser.h"
+#include "core/util/arena.h"
+#include "core/util/cancellation_token.h"
 
 namespace algos {
 
@@ -28,6 +31,10 @@ private:
 
     bool data_loaded_ = false;
 
+    // Released after every ResetState, see GetArena
+    util::Arena arena_;
+    util::CancellationToken cancellation_token_;
+
     // Clear the necessary fields for Execute to run repeatedly with different
     // configuration parameters on the same dataset.
     virtual void ResetState() = 0;
@@ -66,6 +73,25 @@ protected:
     // given through LoadData
     virtual void MakeExecuteOptsAvailable();
 
+    // Safe point. Long-running algorithms should call this in their main loops and, if it
+    // returns true, stop and leave what they have found so far in their results. Thread-safe.
+    [[nodiscard]] bool ShouldStop() const {
+        return cancellation_token_.IsStopRequested();
+    }
+
+    // For helper classes and worker threads that poll the same condition as ShouldStop.
+    util::CancellationToken const& GetCancellationToken() const noexcept {
+        return cancellation_token_;
+    }
+
+    // Memory for the structures of one Execute call. Its memory counts against the memory
+    // budget, and all of it is returned to the heap at once right after ResetState, so everything
+    // allocated from it must be destroyed by ResetState at the latest. Data loaded by LoadData
+    // outlives that and must not be allocated from the arena.
+    util::Arena& GetArena() noexcept {
+        return arena_;
+    }
+
 public:
     Algorithm(Algorithm const& other) = delete;
     Algorithm& operator=(Algorithm const& other) = delete;
@@ -73,12 +99,41 @@ public:
     Algorithm& operator=(Algorithm&& other) = delete;
     virtual ~Algorithm() = default;
 
-    Algorithm() = default;
+    Algorithm() {
+        cancellation_token_.TrackArena(&arena_);
+    }
 
     void LoadData();
 
     unsigned long long Execute();
 
+    // Ask the running Execute (or the next one, if none is running) to stop at its next safe
+    // point. May be called from any thread.
+    void Cancel() noexcept {
+        cancellation_token_.Cancel();
+    }
+
+    // Limits for every following Execute call. Zero means no limit. The memory budget bounds
+    // the growth of the process' resident memory during Execute.
+    void SetTimeBudget(std::chrono::milliseconds budget) noexcept {
+        cancellation_token_.SetTimeBudget(budget);
+    }
+
+    void SetMemoryBudget(size_t bytes) noexcept {
+        cancellation_token_.SetMemoryBudget(bytes);
+    }
+
+    // Most memory the last Execute had allocated from its arena at once, in bytes.
+    [[nodiscard]] size_t GetPeakArenaBytes() const noexcept {
+        return arena_.GetPeakBytes();
+    }
+
+    // Why the last Execute stopped early, or kNone if it ran to completion. After an early
+    // stop the results contain only what had been found and checked by then.
+    [[nodiscard]] util::StopReason GetStopReason() const noexcept {
+        return cancellation_token_.GetStopReason();
+    }
+
     void SetOption(std::string_view option_name, boost::any const& value = {});
     bool OptionIsRequired(std::string_view option_name) const;
 
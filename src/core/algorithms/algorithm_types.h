@@ -8,12 +8,12 @@ namespace algos {
 
 using AlgorithmTypes =
         std::tuple<Depminer, DFD, FastFDs, FDep, FdMine, Pyro, Tane, PFDTane, FUN, hyfd::HyFD, Aid,
-                   EulerFD, Apriori, des::DES, metric::MetricVerifier, DataStats,
-                   fd_verifier::FDVerifier, HyUCC, PyroUCC, HPIValid, cfd::FDFirstAlgorithm,
-                   ACAlgorithm, UCCVerifier, Faida, Spider, Mind, INDVerifier, cind::CINDVerifier,
-                   Fastod, GfdValidator, EGfdValidator, NaiveGfdValidator, order::Order, dd::Split,
-                   Cords, hymd::HyMD, PFDVerifier, cfd_verifier::CFDVerifier,
-                   ar_verifier::ARVerifier, GSpan>;
+                   EulerFD, Apriori, Eclat, des::DES, metric::MetricVerifier, DataStats,
+                   fd_verifier::FDVerifier, fd_verifier::BatchVerifier, HyUCC, PyroUCC, HPIValid,
+                   cfd::FDFirstAlgorithm, ACAlgorithm, UCCVerifier, Faida, Spider, Mind,
+                   INDVerifier, cind::CINDVerifier, Fastod, GfdValidator, EGfdValidator,
+                   NaiveGfdValidator, order::Order, dd::Split, Cords, hymd::HyMD, PFDVerifier,
+                   cfd_verifier::CFDVerifier, ar_verifier::ARVerifier, GSpan>;
 
 // clang-format off
 /* Enumeration of all supported non-pipeline algorithms. If you implement a new
@@ -40,6 +40,7 @@ enum class AlgorithmType : char {
 
 /* Association rules mining algorithms */
     kApriori,
+    kEclat,
 
 /* Numerical association rules mining algorithms*/
     kDes,
@@ -50,8 +51,9 @@ enum class AlgorithmType : char {
 /* Statistic algorithms */
     kStats,
 
-/* FD verifier algorithm */
+/* FD verifier algorithms */
     kFdVerifier,
+    kBatchVerifier,
 
 /* Unique Column Combination mining algorithms */
     kHyucc,
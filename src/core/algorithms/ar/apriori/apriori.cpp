@@ -7,6 +7,10 @@
 
 namespace algos {
 
+std::pmr::list<Node>& Apriori::GetCandidates(Node* parent) {
+    return candidates_.try_emplace(parent, GetArena().GetPool()).first->second;
+}
+
 void Apriori::GenerateCandidates(std::vector<Node>& children) {
     auto const last_child_iter = std::prev(children.end());
     for (auto child_iter = children.begin(); child_iter != last_child_iter; ++child_iter) {
@@ -16,7 +20,7 @@ void Apriori::GenerateCandidates(std::vector<Node>& children) {
             items.push_back(child_right_sibling_iter->items.back());
 
             if (!CanBePruned(items)) {
-                candidates_[&(*child_iter)].emplace_back(std::move(items));
+                GetCandidates(&(*child_iter)).emplace_back(std::move(items));
             }
         }
     }
@@ -24,7 +28,7 @@ void Apriori::GenerateCandidates(std::vector<Node>& children) {
 
 void Apriori::CreateFirstLevelCandidates() {
     for (unsigned item_id = 0; item_id < transactional_data_->GetUniverseSize(); ++item_id) {
-        candidates_[&root_].emplace_back(item_id);
+        GetCandidates(&root_).emplace_back(item_id);
     }
     ++level_num_;
 }
@@ -116,6 +120,7 @@ bool Apriori::CanBePruned(std::vector<unsigned> const& itemset) {
 
 void Apriori::ResetStateAr() {
     level_num_ = 1;
+    candidate_hash_tree_.reset();
     candidates_.clear();
     root_ = Node();
 }
@@ -133,7 +138,8 @@ unsigned long long Apriori::FindFrequent() {
         auto const min_threshold = candidates_count / branching_degree + 1;
 
         candidate_hash_tree_ = std::make_unique<CandidateHashTree>(
-                transactional_data_.get(), candidates_, branching_degree, min_threshold);
+                transactional_data_.get(), candidates_, branching_degree, min_threshold,
+                GetArena().GetPool());
         candidate_hash_tree_->PerformCounting();
         candidate_hash_tree_->PruneNodes(minsup_);
         AppendToTree();
@@ -1,6 +1,7 @@
 #pragma once
 
 #include <list>
+#include <memory_resource>
 #include <queue>
 #include <stack>
 #include <vector>
@@ -19,9 +20,12 @@ private:
     std::unique_ptr<CandidateHashTree> candidate_hash_tree_;
 
     Node root_;
-    std::unordered_map<Node*, std::list<Node>> candidates_;
+    // candidates of a level and the hash tree counting them are allocated from the run's arena
+    std::unordered_map<Node*, std::pmr::list<Node>> candidates_;
     unsigned level_num_ = 1;
 
+    std::pmr::list<Node>& GetCandidates(Node* parent);
+
     bool GenerateNextCandidateLevel();
 
     bool CanBePruned(std::vector<unsigned> const& itemset);
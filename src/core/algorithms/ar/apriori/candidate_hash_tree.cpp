@@ -31,7 +31,8 @@ void CandidateHashTree::AddLevel(HashTreeNode& leaf_node) {
     leaf_node.children.reserve(branching_degree_);
     for (unsigned sibling_num = 0; sibling_num < branching_degree_; ++sibling_num) {
         // generate new leaf nodes
-        leaf_node.children.emplace_back(next_level_number);
+        leaf_node.children.emplace_back(next_level_number,
+                                        leaf_node.children.get_allocator().resource());
     }
 
     // distribute rows of an old leaf between new leaves
@@ -1,5 +1,10 @@
 #pragma once
 
+#include <list>
+#include <memory_resource>
+#include <unordered_map>
+#include <vector>
+
 #include "core/algorithms/ar/apriori/node.h"
 #include "core/model/transaction/transactional_data.h"
 
@@ -7,12 +12,12 @@ namespace algos {
 
 class CandidateHashTree {
 private:
-    using NodeIterator = std::list<Node>::iterator;
+    using NodeIterator = std::pmr::list<Node>::iterator;
 
     unsigned const branching_degree_;
     unsigned const min_threshold_;
     unsigned total_row_count_ = 0;
-    std::unordered_map<Node*, std::list<Node>>& candidates_;
+    std::unordered_map<Node*, std::pmr::list<Node>>& candidates_;
 
     model::TransactionalData const* const transactional_data_ = nullptr;
 
@@ -29,15 +34,17 @@ private:
         LeafRow(LeafRow const& other) = delete;
     };
 
+    // the nodes and rows of a tree live in the memory resource of the candidate lists
     struct HashTreeNode {
         unsigned level_number;
         int last_visited_transaction_id = -1;
-        std::vector<HashTreeNode> children;
-        std::list<LeafRow> candidates;
+        std::pmr::vector<HashTreeNode> children;
+        std::pmr::list<LeafRow> candidates;
 
         HashTreeNode() = delete;
 
-        explicit HashTreeNode(unsigned level_number) : level_number(level_number) {}
+        HashTreeNode(unsigned level_number, std::pmr::memory_resource* resource)
+            : level_number(level_number), children(resource), candidates(resource) {}
     };
 
     HashTreeNode root_;
@@ -58,13 +65,14 @@ private:
 
 public:
     CandidateHashTree(model::TransactionalData const* transactional_data,
-                      std::unordered_map<Node*, std::list<Node>>& candidates,
-                      unsigned branching_degree, unsigned min_threshold)
+                      std::unordered_map<Node*, std::pmr::list<Node>>& candidates,
+                      unsigned branching_degree, unsigned min_threshold,
+                      std::pmr::memory_resource* resource = std::pmr::get_default_resource())
         : branching_degree_(branching_degree),
           min_threshold_(min_threshold),
           candidates_(candidates),
           transactional_data_(transactional_data),
-          root_(1) {
+          root_(1, resource) {
         AddCandidates();
     }
 
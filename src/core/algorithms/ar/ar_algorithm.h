@@ -45,7 +45,7 @@ private:
     virtual void ResetStateAr() = 0;
 
 protected:
-    std::shared_ptr<model::TransactionalData> transactional_data_;
+    std::shared_ptr<model::TransactionalData const> transactional_data_;
     config::ArMinimumSupportType minsup_;
 
     void GenerateRulesFrom(std::vector<unsigned> const& frequent_itemset, double support);
@@ -54,7 +54,7 @@ protected:
     virtual unsigned long long GenerateAllRules() = 0;
     virtual unsigned long long FindFrequent() = 0;
     void LoadDataInternal() final;
-    void MakeExecuteOptsAvailable() final;
+    void MakeExecuteOptsAvailable() override;
     unsigned long long ExecuteInternal() final;
 
 public:
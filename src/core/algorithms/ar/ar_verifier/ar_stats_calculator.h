@@ -11,7 +11,7 @@
 namespace algos::ar_verifier {
 class ARStatsCalculator {
 private:
-    std::shared_ptr<::model::TransactionalData> data_;
+    std::shared_ptr<::model::TransactionalData const> data_;
 
     ::model::ArIDs rule_;
     double support_ = 0.0;
@@ -26,7 +26,7 @@ private:
     void CalculateConfidence();
 
 public:
-    ARStatsCalculator(std::shared_ptr<::model::TransactionalData> const& data,
+    ARStatsCalculator(std::shared_ptr<::model::TransactionalData const> const& data,
                       ::model::ArIDs const& rule)
         : data_(data), rule_(rule) {};
 
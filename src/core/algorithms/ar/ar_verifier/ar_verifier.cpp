@@ -68,7 +68,7 @@ void ARVerifier::MakeExecuteOptsAvailable() {
 }
 
 void ARVerifier::LoadDataInternal() {
-    transactional_data_ = ::model::TransactionalData::CreateFrom(transactional_data_params_);
+    transactional_data_ = ::model::TransactionalData::Load(transactional_data_params_);
     if (transactional_data_->GetNumTransactions() == 0) {
         throw std::runtime_error("Got an empty dataset: AR verifying is meaningless.");
     }
@@ -19,7 +19,7 @@ private:
     /* input options */
     ::model::TransactionalData::Params transactional_data_params_;
 
-    std::shared_ptr<::model::TransactionalData> transactional_data_;
+    std::shared_ptr<::model::TransactionalData const> transactional_data_;
     std::vector<std::string> string_rule_left_;
     std::vector<std::string> string_rule_right_;
     ::model::ArIDs ar_ids_;
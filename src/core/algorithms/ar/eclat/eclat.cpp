@@ -0,0 +1,174 @@
+#include "core/algorithms/ar/eclat/eclat.h"
+
+#include <algorithm>
+#include <chrono>
+#include <optional>
+
+#include "core/config/thread_number/option.h"
+#include "core/util/logger.h"
+#include "core/util/worker_thread_pool.h"
+
+namespace algos {
+
+Eclat::Eclat() : ARAlgorithm() {
+    RegisterOption(config::kThreadNumberOpt(&threads_));
+}
+
+void Eclat::MakeExecuteOptsAvailable() {
+    ARAlgorithm::MakeExecuteOptsAvailable();
+    MakeOptionsAvailable({config::kThreadNumberOpt.GetName()});
+}
+
+void Eclat::ResetStateAr() {
+    num_transactions_ = 0;
+    frequent_itemsets_.clear();
+    supports_.clear();
+}
+
+bool Eclat::IsFrequent(size_t count) const {
+    return static_cast<double>(count) / num_transactions_ >= minsup_;
+}
+
+std::vector<Eclat::ClassMember> Eclat::CreateFirstLevelClass() const {
+    size_t const universe_size = transactional_data_->GetUniverseSize();
+    auto const& transactions = transactional_data_->GetTransactions();
+
+    /* A transaction may list an item more than once, it is counted once per transaction */
+    std::vector<size_t> item_counts(universe_size, 0);
+    std::vector<size_t> last_tids(universe_size, num_transactions_);
+    size_t tid = 0;
+    for (auto const& [_, itemset] : transactions) {
+        for (unsigned item : itemset.GetItemsIDs()) {
+            if (last_tids[item] != tid) {
+                last_tids[item] = tid;
+                ++item_counts[item];
+            }
+        }
+        ++tid;
+    }
+
+    /* Only frequent items get a bitmap, infrequent ones are never extended */
+    std::vector<ClassMember> members;
+    std::vector<ClassMember*> item_members(universe_size, nullptr);
+    for (unsigned item = 0; item < universe_size; ++item) {
+        if (IsFrequent(item_counts[item])) {
+            members.push_back({item, TidBitmap(num_transactions_), item_counts[item]});
+        }
+    }
+    for (ClassMember& member : members) {
+        item_members[member.item] = &member;
+    }
+
+    tid = 0;
+    for (auto const& [_, itemset] : transactions) {
+        for (unsigned item : itemset.GetItemsIDs()) {
+            if (ClassMember* member = item_members[item]; member != nullptr) {
+                member->tids.Set(tid);
+            }
+        }
+        ++tid;
+    }
+
+    /* Rarer items first: they produce the smallest intersections for the members after them,
+     * and the largest classes come first, which balances the work between threads */
+    std::stable_sort(members.begin(), members.end(),
+                     [](ClassMember const& a, ClassMember const& b) { return a.count < b.count; });
+    return members;
+}
+
+void Eclat::ProcessClassMember(std::vector<unsigned>& prefix,
+                               std::vector<ClassMember> const& members, size_t member_index,
+                               std::vector<FrequentItemset>& result) const {
+    ClassMember const& member = members[member_index];
+    prefix.push_back(member.item);
+
+    std::vector<unsigned> items = prefix;
+    std::sort(items.begin(), items.end());
+    result.push_back({std::move(items), static_cast<double>(member.count) / num_transactions_});
+
+    std::vector<ClassMember> extensions;
+    for (size_t i = member_index + 1; i < members.size(); ++i) {
+        TidBitmap tids;
+        size_t const count = TidBitmap::Intersect(member.tids, members[i].tids, tids);
+        if (IsFrequent(count)) {
+            extensions.push_back({members[i].item, std::move(tids), count});
+        }
+    }
+
+    for (size_t i = 0; i < extensions.size(); ++i) {
+        ProcessClassMember(prefix, extensions, i, result);
+    }
+
+    prefix.pop_back();
+}
+
+unsigned long long Eclat::FindFrequent() {
+    auto start_time = std::chrono::system_clock::now();
+
+    num_transactions_ = transactional_data_->GetNumTransactions();
+    std::vector<ClassMember> const first_level = CreateFirstLevelClass();
+    std::vector<std::vector<FrequentItemset>> class_results(first_level.size());
+
+    auto process_class = [this, &first_level, &class_results](size_t index) {
+        std::vector<unsigned> prefix;
+        ProcessClassMember(prefix, first_level, index, class_results[index]);
+    };
+
+    if (threads_ > 1) {
+        util::WorkerThreadPool pool(threads_);
+        pool.ExecIndex(process_class, first_level.size());
+    } else {
+        for (size_t i = 0; i < first_level.size(); ++i) {
+            process_class(i);
+        }
+    }
+
+    for (auto& class_result : class_results) {
+        for (auto& itemset : class_result) {
+            supports_.emplace(itemset.items, itemset.support);
+            frequent_itemsets_.push_back(std::move(itemset));
+        }
+    }
+
+    auto elapsed_milliseconds = std::chrono::duration_cast<std::chrono::milliseconds>(
+            std::chrono::system_clock::now() - start_time);
+    return elapsed_milliseconds.count();
+}
+
+unsigned long long Eclat::GenerateAllRules() {
+    auto start_time = std::chrono::system_clock::now();
+
+    for (FrequentItemset const& itemset : frequent_itemsets_) {
+        if (itemset.items.size() >= 2) {
+            GenerateRulesFrom(itemset.items, itemset.support);
+        }
+    }
+
+    auto elapsed_milliseconds = std::chrono::duration_cast<std::chrono::milliseconds>(
+            std::chrono::system_clock::now() - start_time);
+
+    LOG_INFO("> Count of frequent itemsets: {}", frequent_itemsets_.size());
+    return elapsed_milliseconds.count();
+}
+
+double Eclat::GetSupport(std::vector<unsigned> const& frequent_itemset) const {
+    auto it = supports_.find(frequent_itemset);
+    return it == supports_.end() ? -1 : it->second;
+}
+
+std::list<std::set<std::string>> Eclat::GetFrequentList() const {
+    std::list<std::set<std::string>> frequent_itemsets;
+    auto const& item_universe = transactional_data_->GetItemUniverse();
+
+    for (FrequentItemset const& itemset : frequent_itemsets_) {
+        std::set<std::string> item_names;
+        for (unsigned item : itemset.items) {
+            item_names.insert(item_universe[item]);
+        }
+        frequent_itemsets.push_back(std::move(item_names));
+    }
+
+    return frequent_itemsets;
+}
+
+}  // namespace algos
@@ -0,0 +1,62 @@
+#pragma once
+
+#include <list>
+#include <set>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+#include <boost/functional/hash.hpp>
+
+#include "core/algorithms/ar/ar_algorithm.h"
+#include "core/algorithms/ar/eclat/tid_bitmap.h"
+#include "core/config/thread_number/type.h"
+
+namespace algos {
+
+/* Frequent itemset mining over a vertical layout. Every item gets a bitmap of the transactions
+ * containing it, and an itemset is extended depth-first by intersecting the bitmaps of the
+ * members of its prefix equivalence class. The dataset is scanned twice, to count the items and
+ * to fill the bitmaps of the frequent ones, unlike Apriori which scans it on every level.
+ * Top-level equivalence classes are independent and are mined in parallel.
+ */
+class Eclat : public ARAlgorithm {
+private:
+    struct FrequentItemset {
+        std::vector<unsigned> items;
+        double support;
+    };
+
+    struct ClassMember {
+        unsigned item;
+        TidBitmap tids;
+        size_t count;
+    };
+
+    config::ThreadNumType threads_ = 1;
+    size_t num_transactions_ = 0;
+
+    /* In the order of the prefix classes they were found in, items of each are sorted */
+    std::vector<FrequentItemset> frequent_itemsets_;
+    std::unordered_map<std::vector<unsigned>, double, boost::hash<std::vector<unsigned>>>
+            supports_;
+
+    bool IsFrequent(size_t count) const;
+    std::vector<ClassMember> CreateFirstLevelClass() const;
+    void ProcessClassMember(std::vector<unsigned>& prefix, std::vector<ClassMember> const& members,
+                            size_t member_index, std::vector<FrequentItemset>& result) const;
+
+    double GetSupport(std::vector<unsigned> const& frequent_itemset) const override;
+    unsigned long long GenerateAllRules() override;
+    unsigned long long FindFrequent() override;
+
+    void MakeExecuteOptsAvailable() override;
+    void ResetStateAr() final;
+
+public:
+    Eclat();
+
+    std::list<std::set<std::string>> GetFrequentList() const override;
+};
+
+}  // namespace algos
@@ -0,0 +1,55 @@
+#pragma once
+
+#include <bit>
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+namespace algos {
+
+/* Set of transaction ids stored as a dense bitmap. Intersections and support counting work on
+ * whole 64-bit words, so they are vectorized by the compiler and use hardware popcount.
+ */
+class TidBitmap {
+private:
+    using Word = std::uint64_t;
+    static constexpr size_t kWordBits = 64;
+
+    std::vector<Word> words_;
+
+public:
+    TidBitmap() = default;
+
+    explicit TidBitmap(size_t num_transactions)
+        : words_((num_transactions + kWordBits - 1) / kWordBits) {}
+
+    void Set(size_t tid) noexcept {
+        words_[tid / kWordBits] |= Word{1} << (tid % kWordBits);
+    }
+
+    size_t Count() const noexcept {
+        size_t count = 0;
+        for (Word word : words_) {
+            count += std::popcount(word);
+        }
+        return count;
+    }
+
+    /* Store the intersection of a and b in result and return its size */
+    static size_t Intersect(TidBitmap const& a, TidBitmap const& b, TidBitmap& result) {
+        size_t const size = a.words_.size();
+        result.words_.resize(size);
+
+        Word const* a_words = a.words_.data();
+        Word const* b_words = b.words_.data();
+        Word* result_words = result.words_.data();
+        size_t count = 0;
+        for (size_t i = 0; i < size; ++i) {
+            result_words[i] = a_words[i] & b_words[i];
+            count += std::popcount(result_words[i]);
+        }
+        return count;
+    }
+};
+
+}  // namespace algos
@@ -1,3 +1,4 @@
 #pragma once
 
 #include "core/algorithms/ar/apriori/apriori.h"
+#include "core/algorithms/ar/eclat/eclat.h"
@@ -5,6 +5,7 @@
 #include "core/config/names_and_descriptions.h"
 #include "core/config/option_using.h"
 #include "core/config/tabular_data/input_table/option.h"
+#include "core/config/tabular_data/load_columns/option.h"
 #include "core/util/logger.h"
 #include "core/util/timed_invoke.h"
 
@@ -22,7 +23,9 @@ void CFDVerifier::RegisterOptions() {
         auto get_attr_id = [this](std::string const& attr_name) -> cfd::AttributeIndex {
             cfd::AttributeIndex attr_id = relation_->GetAttr(attr_name);
             if (attr_id == -1) {
-                throw config::ConfigurationError("Attribute not found: " + attr_name);
+                throw config::ConfigurationError(
+                        "Attribute not found: " + attr_name +
+                        (projection_.IsIdentity() ? "" : ", it may not be in load_columns"));
             }
             return attr_id;
         };
@@ -43,7 +46,10 @@ void CFDVerifier::RegisterOptions() {
         check_item_ids({pair});
     };
 
-    RegisterOption(config::kTableOpt(&input_table_));
+    auto get_table_cols = [this]() { return input_table_->GetNumberOfColumns(); };
+
+    RegisterOption(config::kTableOpt(&input_table_).SetConditionalOpts({{{}, {kLoadColumns}}}));
+    RegisterOption(config::kLoadColumnsOpt(&load_columns_, std::move(get_table_cols)));
     RegisterOption(Option{&string_rule_left_, kCFDRuleLeft, kDCFDRuleLeft,
                           std::vector<CFDAttributeValuePair>{}}
                            .SetValueCheck(validate_rule_part));
@@ -55,7 +61,8 @@ void CFDVerifier::RegisterOptions() {
 }
 
 void CFDVerifier::LoadDataInternal() {
-    relation_ = cfd::CFDRelationData::CreateFrom(*input_table_);
+    projection_ = model::ColumnProjection(*input_table_, load_columns_);
+    relation_ = cfd::CFDRelationData::CreateFrom(*projection_.Apply(input_table_));
 
     if (relation_->GetColumnData().empty()) {
         throw std::runtime_error("Got an empty dataset: CFD verifying is meaningless.");
@@ -7,7 +7,9 @@
 
 #include "core/algorithms/algorithm.h"
 #include "core/algorithms/cfd/cfd_verifier/cfd_stats_calculator.h"
+#include "core/config/indices/type.h"
 #include "core/config/tabular_data/input_table_type.h"
+#include "core/model/table/column_projection.h"
 
 namespace algos::cfd_verifier {
 
@@ -16,6 +18,8 @@ using CFDAttributeValuePair = std::pair<std::string, std::string>;
 class CFDVerifier : public Algorithm {
 private:
     config::InputTable input_table_;
+    config::IndicesType load_columns_;
+    model::ColumnProjection projection_;
     std::vector<CFDAttributeValuePair> string_rule_left_;
     CFDAttributeValuePair string_rule_right_;
     cfd::ItemsetCFD cfd_;
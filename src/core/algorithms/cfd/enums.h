@@ -8,4 +8,9 @@ enum class Substrategy : char {
     kDfs = 0,  // dfs lattice traversal
     kBfs       // bfs lattice traversal
 };
+
+enum class TIdListType : char {
+    kVector = 0,  // sorted vectors of ids
+    kBitmap       // compressed bitmaps of ids
+};
 }  // namespace algos::cfd
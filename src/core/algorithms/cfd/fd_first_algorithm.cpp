@@ -1,9 +1,11 @@
 #include "core/algorithms/cfd/fd_first_algorithm.h"
 
 #include <iterator>
+#include <type_traits>
 
 #include <boost/unordered_map.hpp>
 
+#include "core/algorithms/cfd/model/tid_bitmap.h"
 #include "core/algorithms/cfd/util/partition_tidlist_util.h"
 #include "core/algorithms/cfd/util/partition_util.h"
 #include "core/algorithms/cfd/util/set_util.h"
@@ -12,6 +14,7 @@
 #include "core/config/exceptions.h"
 #include "core/config/names_and_descriptions.h"
 #include "core/config/option_using.h"
+#include "core/config/thread_number/option.h"
 #include "core/util/logger.h"
 
 // see algorithms/cfd/LICENSE
@@ -30,6 +33,9 @@ void FDFirstAlgorithm::RegisterOptions() {
     RegisterOption(Option{&min_conf_, kCfdMinimumConfidence, kDCfdMinimumConfidence, 0.0});
     RegisterOption(Option{&max_lhs_, kCfdMaximumLhs, kDCfdMaximumLhs, 0u});
     RegisterOption(Option{&substrategy_, kCfdSubstrategy, kDCfdSubstrategy, default_val});
+    RegisterOption(Option{&tidlist_type_, kCfdTIdListType, kDCfdTIdListType,
+                          TIdListType::kVector});
+    RegisterOption(config::kThreadNumberOpt(&threads_));
 }
 
 void FDFirstAlgorithm::ResetStateCFD() {
@@ -39,13 +45,18 @@ void FDFirstAlgorithm::ResetStateCFD() {
     free_map_.clear();
     free_itemsets_.clear();
     rules_.clear();
+    pool_.reset();
 }
 
 unsigned long long FDFirstAlgorithm::ExecuteInternal() {
     max_cfd_size_ = max_lhs_ + 1;
     CheckForIncorrectInput();
     auto start_time = std::chrono::system_clock::now();
+    if (threads_ > 1) {
+        pool_.emplace(threads_);
+    }
     FdsFirstDFS();
+    pool_.reset();
     auto elapsed_milliseconds = std::chrono::duration_cast<std::chrono::milliseconds>(
             std::chrono::system_clock::now() - start_time);
     unsigned long long apriori_millis = elapsed_milliseconds.count();
@@ -93,8 +104,45 @@ void FDFirstAlgorithm::CheckForIncorrectInput() const {
 void FDFirstAlgorithm::MakeExecuteOptsAvailable() {
     using namespace config::names;
 
-    MakeOptionsAvailable(
-            {kCfdMinimumSupport, kCfdMinimumConfidence, kCfdMaximumLhs, kCfdSubstrategy});
+    MakeOptionsAvailable({kCfdMinimumSupport, kCfdMinimumConfidence, kCfdMaximumLhs,
+                          kCfdSubstrategy, kCfdTIdListType, kThreads});
+}
+
+std::vector<Itemset>& FDFirstAlgorithm::GetRules(int rhs) {
+    unsigned const attr = rhs < 0 ? -1 - rhs : relation_->GetAttrIndex(rhs);
+    return rules_[attr][rhs];
+}
+
+void FDFirstAlgorithm::MergeBranchOutput(BranchOutput&& output) {
+    cfd_list_.insert(cfd_list_.end(), std::make_move_iterator(output.cfds.begin()),
+                     std::make_move_iterator(output.cfds.end()));
+    for (auto& [sp, sets] : output.free_map) {
+        auto& free_sets = free_map_[sp];
+        free_sets.insert(free_sets.end(), std::make_move_iterator(sets.begin()),
+                         std::make_move_iterator(sets.end()));
+    }
+    free_itemsets_.insert(std::make_move_iterator(output.free_itemsets.begin()),
+                          std::make_move_iterator(output.free_itemsets.end()));
+}
+
+// The pattern mining only finds free itemsets with constants. They never make an itemset of
+// variables non-free, so a branch checks them against the shared map and its own, and the ones
+// of concurrent branches do not change what is mined.
+bool FDFirstAlgorithm::AddFreeItemset(std::pair<int, int> sp, Itemset const& ns,
+                                      BranchOutput& output) const {
+    FreeMap const& branch_free_map = output.free_map;
+    for (FreeMap const* free_map : {&free_map_, &branch_free_map}) {
+        auto const free_map_pair = free_map->find(sp);
+        if (free_map_pair == free_map->end()) continue;
+        for (auto const& sub_cand : free_map_pair->second) {
+            if (IsSubsetOf(sub_cand, ns)) {
+                return false;
+            }
+        }
+    }
+    output.free_map[sp].push_back(ns);
+    output.free_itemsets.push_back(ns);
+    return true;
 }
 
 bool FDFirstAlgorithm::Precedes(Itemset const& a, Itemset const& b) {
@@ -137,7 +185,7 @@ bool FDFirstAlgorithm::IsConstRule(PartitionTIdList const& items, int rhs_a) {
 }
 
 void FDFirstAlgorithm::MineFD(MinerNode<PartitionTIdList> const& inode, Itemset const& lhs,
-                              int rhs) {
+                              int rhs, BranchOutput& output) {
     if (inode.tids.sets_number == 1 || IsConstRule(inode.tids, -1 - rhs)) return;
     auto const stored_sub = store_.find(lhs);
     if (stored_sub == store_.end()) {
@@ -147,14 +195,12 @@ void FDFirstAlgorithm::MineFD(MinerNode<PartitionTIdList> const& inode, Itemset
     if (free_itemsets_.find(lhs) == free_itemsets_.end()) {
         lhs_gen = false;
     }
-    if (rules_.find(rhs) != rules_.end()) {
-        for (auto const& sub_rule : rules_[rhs]) {
-            if (!std::any_of(sub_rule.begin(), sub_rule.end(),
-                             [](int si) -> bool { return si < 0; }))
-                continue;
-            if (Precedes(sub_rule, lhs)) {
-                lhs_gen = false;
-            }
+    std::vector<Itemset>& rules = GetRules(rhs);
+    for (auto const& sub_rule : rules) {
+        if (!std::any_of(sub_rule.begin(), sub_rule.end(), [](int si) -> bool { return si < 0; }))
+            continue;
+        if (Precedes(sub_rule, lhs)) {
+            lhs_gen = false;
         }
     }
     if (lhs_gen) {
@@ -162,10 +208,10 @@ void FDFirstAlgorithm::MineFD(MinerNode<PartitionTIdList> const& inode, Itemset
         double e = stored_sub->second.PartitionError(inode.tids);
         double conf = 1 - (e / TIdUtil::Support(stored_sub->second));
         if (conf >= min_conf_) {
-            cfd_list_.emplace_back(lhs, rhs);
+            output.cfds.emplace_back(lhs, rhs);
         }
         if (conf >= 1) {
-            rules_[rhs].push_back(lhs);
+            rules.push_back(lhs);
         }
     }
 }
@@ -173,6 +219,7 @@ void FDFirstAlgorithm::MineFD(MinerNode<PartitionTIdList> const& inode, Itemset
 // Initializing all objects that will be used in algorithm
 void FDFirstAlgorithm::FdsFirstDFS() {
     all_attrs_ = Range(-static_cast<int>(relation_->GetAttrsNumber()), 0);
+    rules_.assign(relation_->GetAttrsNumber(), Rules{});
     PIdListMiners items = GetPartitionSingletons();
     for (auto& a : items) {
         a.candidates = all_attrs_;
@@ -226,16 +273,24 @@ void FDFirstAlgorithm::FdsFirstDFS(Itemset const& prefix, PIdListMiners const& i
         MinerNode<PartitionTIdList> const& inode = items[ix];
         Itemset const iset = Join(prefix, inode.item);
         auto const insect = ConstructIntersection(iset, inode.candidates);
-        for (int out : insect) {
+        // rhses are different attributes, so their rules are kept apart, see GetRules
+        std::vector<BranchOutput> outputs(insect.size());
+        auto mine_rhs = [&](model::Index i) {
+            int const out = insect[i];
             Itemset const sub = ConstructSubset(iset, out);
-            MineFD(inode, sub, out);
-
-            if (ss == Substrategy::kDfs) {
-                MinePatternsDFS(sub, out, inode.tids);
-            } else if (ss == Substrategy::kBfs) {
-                MinePatternsBFS(sub, out, inode.tids);
+            MineFD(inode, sub, out, outputs[i]);
+            MinePatterns(sub, out, inode.tids, ss, outputs[i]);
+        };
+        if (pool_ && insect.size() > 1) {
+            pool_->ExecIndex(mine_rhs, insect.size());
+        } else {
+            for (model::Index i = 0; i < insect.size(); ++i) {
+                mine_rhs(i);
             }
         }
+        for (auto& output : outputs) {
+            MergeBranchOutput(std::move(output));
+        }
 
         if (inode.candidates.empty()) continue;
         if (iset.size() == max_cfd_size_) continue;
@@ -244,7 +299,8 @@ void FDFirstAlgorithm::FdsFirstDFS(Itemset const& prefix, PIdListMiners const& i
 
         auto const [expands, tmp_suffix] = ExpandMiningFd(inode, ix, iset, items);
 
-        auto const exps = PartitionTIdListUtil::ConstructIntersection(items[ix].tids, expands);
+        auto const exps = PartitionTIdListUtil::ConstructIntersection(
+                items[ix].tids, expands, pool_ ? std::addressof(*pool_) : nullptr);
         PIdListMiners suffix;
         for (size_t e = 0; e < exps.size(); e++) {
             bool gen = true;
@@ -309,41 +365,42 @@ void FDFirstAlgorithm::FillMinePatternsVars(PartitionList& partitions, RhsesPair
     }
 }
 
+template <typename TIdList>
 void FDFirstAlgorithm::AddCFDToCFDList(std::vector<int> const& sub, int out,
-                                       MinerNode<SimpleTIdList> const& inode,
-                                       PartitionList const& partitions) {
+                                       MinerNode<TIdList> const& inode,
+                                       PartitionList const& partitions, BranchOutput& output) {
     bool lhs_gen = true;
 
-    if (rules_.find(out) != rules_.end()) {
-        for (auto const& sub_rule : rules_[out]) {
-            if (out < 0 &&
-                !std::any_of(
-                        sub_rule.begin(), sub_rule.end(), [](int si) -> bool { return si < 0; }))
-                continue;
-            if (Precedes(sub_rule, sub)) {
-                lhs_gen = false;
-            }
+    std::vector<Itemset>& rules = GetRules(out);
+    for (auto const& sub_rule : rules) {
+        if (out < 0 &&
+            !std::any_of(sub_rule.begin(), sub_rule.end(), [](int si) -> bool { return si < 0; }))
+            continue;
+        if (Precedes(sub_rule, sub)) {
+            lhs_gen = false;
         }
     }
     if (lhs_gen) {
         unsigned e = PartitionUtil::GetPartitionError(inode.tids, partitions);
         double conf = 1.0 - (static_cast<double>(e) / static_cast<double>(inode.node_supp));
         if (conf >= min_conf_) {
-            cfd_list_.emplace_back(sub, out);
+            output.cfds.emplace_back(sub, out);
         }
         if (conf >= 1) {
-            rules_[out].push_back(sub);
+            rules.push_back(sub);
             if (out > 0) {
-                rules_[-1 - relation_->GetAttrIndex(out)].push_back(sub);
+                GetRules(-1 - relation_->GetAttrIndex(out)).push_back(sub);
             }
         }
     }
 }
 
+template <typename TIdList>
 void FDFirstAlgorithm::AnalyzeCFDFromPIdList(std::pair<int, SimpleTIdList> const& item,
                                              PartitionList const& partitions,
                                              std::vector<unsigned> const& p_supps,
-                                             TIdListMiners& items, Itemset const& lhs) {
+                                             TIdListMiners<TIdList>& items, Itemset const& lhs,
+                                             BranchOutput& output) {
     unsigned p_supp = PartitionUtil::GetPartitionSupport(item.second, p_supps);
     if (p_supp < min_supp_) {
         return;
@@ -354,66 +411,59 @@ void FDFirstAlgorithm::AnalyzeCFDFromPIdList(std::pair<int, SimpleTIdList> const
     for (int pid : item.second) {
         nr_parts.insert(partitions[pid].first);
     }
-    bool gen = true;
-    auto const sp = std::make_pair(p_supp, nr_parts.size());
-    auto const free_map_pair = free_map_.find(sp);
-    if (free_map_pair != free_map_.end()) {
-        auto const free_cands = free_map_pair->second;
-        for (auto const& sub_cand : free_cands) {
-            if (IsSubsetOf(sub_cand, ns)) {
-                gen = false;
-                break;
-            }
-        }
-    }
-    if (gen) {
-        free_map_[sp].push_back(ns);
-        free_itemsets_.insert(ns);
+    AddFreeItemset(std::make_pair(p_supp, nr_parts.size()), ns, output);
+    if constexpr (std::is_same_v<TIdList, TIdBitmap>) {
+        items.emplace_back(item.first, TIdBitmap::FromSorted(item.second), p_supp);
+    } else {
+        items.emplace_back(item.first, item.second, p_supp);
     }
-    items.emplace_back(item.first, item.second, p_supp);
 }
 
+template <typename TIdList>
 bool FDFirstAlgorithm::FillFreeMapAndItemsets(PartitionList const& partitions, Itemset const& lhs,
-                                              Itemset const& new_set, SimpleTIdList const& ij_tids,
-                                              unsigned ij_supp) {
+                                              Itemset const& new_set, TIdList const& ij_tids,
+                                              unsigned ij_supp, BranchOutput& output) {
     if (ij_supp < min_supp_) {
         return false;
     }
 
-    bool gen = true;
     auto const nas = relation_->GetAttrVectorItems(new_set);
     Itemset const ns = Join(new_set, SetDiff(lhs, nas));
     std::set<Itemset> nr_parts;
     for (int pid : ij_tids) {
         nr_parts.insert(partitions[pid].first);
     }
-    auto const sp = std::make_pair(ij_supp, nr_parts.size());
-    auto const free_map_pair = free_map_.find(sp);
-    if (free_map_pair != free_map_.end()) {
-        auto const free_cands = free_map_pair->second;
-        for (auto const& sub_cand : free_cands) {
-            if (IsSubsetOf(sub_cand, ns)) {
-                gen = false;
-                break;
-            }
+    AddFreeItemset(std::make_pair(ij_supp, nr_parts.size()), ns, output);
+    return true;
+}
+
+void FDFirstAlgorithm::MinePatterns(Itemset const& lhs, int rhs, PartitionTIdList const& all_tids,
+                                    Substrategy ss, BranchOutput& output) {
+    if (ss == Substrategy::kDfs) {
+        if (tidlist_type_ == TIdListType::kBitmap) {
+            MinePatternsDFS<TIdBitmap>(lhs, rhs, all_tids, output);
+        } else {
+            MinePatternsDFS<SimpleTIdList>(lhs, rhs, all_tids, output);
+        }
+    } else if (ss == Substrategy::kBfs) {
+        if (tidlist_type_ == TIdListType::kBitmap) {
+            MinePatternsBFS<TIdBitmap>(lhs, rhs, all_tids, output);
+        } else {
+            MinePatternsBFS<SimpleTIdList>(lhs, rhs, all_tids, output);
         }
     }
-    if (gen) {
-        free_map_[sp].push_back(ns);
-        free_itemsets_.insert(ns);
-    }
-    return true;
 }
 
+template <typename TIdList>
 void FDFirstAlgorithm::MinePatternsBFS(Itemset const& lhs, int rhs,
-                                       PartitionTIdList const& all_tids) {
+                                       PartitionTIdList const& all_tids, BranchOutput& output) {
     std::map<int, SimpleTIdList> pid_lists;
     PartitionList partitions;
     RhsesPair2DList rhses_pairs;
     RuleIxs rule_ixs;
     std::vector<int> rhses;
     FillMinePatternsVars(partitions, rhses_pairs, rule_ixs, rhses, lhs, rhs, all_tids);
-    TIdListMiners items;
+    TIdListMiners<TIdList> items;
     std::vector<unsigned> p_supps(partitions.size());
     int ri = 0;
     for (auto const& rule : partitions) {
@@ -426,21 +476,22 @@ void FDFirstAlgorithm::MinePatternsBFS(Itemset const& lhs, int rhs,
     }
 
     for (auto const& item : pid_lists) {
-        AnalyzeCFDFromPIdList(item, partitions, p_supps, items, lhs);
+        AnalyzeCFDFromPIdList(item, partitions, p_supps, items, lhs, output);
     }
 
     while (!items.empty()) {
-        TIdListMiners suffix;
+        TIdListMiners<TIdList> suffix;
         for (size_t i = 0; i < items.size(); i++) {
             auto const& inode = items[i];
             Itemset iset = inode.prefix;
             iset.push_back(inode.item);
             auto const node_attrs = relation_->GetAttrVectorItems(iset);
-            int out = (iset.size() == lhs.size()) ? GetMaxElem(rhses_pairs[inode.tids[0]]) : rhs;
+            int out = (iset.size() == lhs.size()) ? GetMaxElem(rhses_pairs[*inode.tids.begin()])
+                                                  : rhs;
             auto const sub = Join(iset, SetDiff(lhs, node_attrs));
 
             if (out > 0 || !PartitionUtil::IsConstRulePartition(inode.tids, rhses_pairs)) {
-                AddCFDToCFDList(sub, out, inode, partitions);
+                AddCFDToCFDList(sub, out, inode, partitions, output);
             }
             for (size_t j = i + 1; j < items.size(); j++) {
                 auto const& jnode = items[j];
@@ -451,9 +502,10 @@ void FDFirstAlgorithm::MinePatternsBFS(Itemset const& lhs, int rhs,
                 Itemset jset = jnode.prefix;
                 jset.push_back(jnode.item);
                 Itemset new_set = Join(jset, inode.item);
-                SimpleTIdList ij_tids = ConstructIntersection(inode.tids, jnode.tids);
+                TIdList ij_tids = ConstructIntersection(inode.tids, jnode.tids);
                 unsigned ij_supp = PartitionUtil::GetPartitionSupport(ij_tids, p_supps);
-                bool result = FillFreeMapAndItemsets(partitions, lhs, new_set, ij_tids, ij_supp);
+                bool result =
+                        FillFreeMapAndItemsets(partitions, lhs, new_set, ij_tids, ij_supp, output);
                 if (!result) continue;
                 int jtem = new_set.back();
                 new_set.pop_back();
@@ -464,15 +516,16 @@ void FDFirstAlgorithm::MinePatternsBFS(Itemset const& lhs, int rhs,
     }
 }
 
+template <typename TIdList>
 void FDFirstAlgorithm::MinePatternsDFS(Itemset const& lhs, int rhs,
-                                       PartitionTIdList const& all_tids) {
+                                       PartitionTIdList const& all_tids, BranchOutput& output) {
     std::map<int, SimpleTIdList> pid_lists;
     PartitionList partitions;
     RhsesPair2DList rhses_pairs;
     RuleIxs rule_ixs;
     std::vector<int> rhses;
     FillMinePatternsVars(partitions, rhses_pairs, rule_ixs, rhses, lhs, rhs, all_tids);
-    TIdListMiners items;
+    TIdListMiners<TIdList> items;
     std::vector<unsigned> p_supps(partitions.size());
     int ri = 0;
     for (auto const& rule : partitions) {
@@ -485,15 +538,17 @@ void FDFirstAlgorithm::MinePatternsDFS(Itemset const& lhs, int rhs,
     }
 
     for (auto const& item : pid_lists) {
-        AnalyzeCFDFromPIdList(item, partitions, p_supps, items, lhs);
+        AnalyzeCFDFromPIdList(item, partitions, p_supps, items, lhs, output);
     }
 
-    MinePatternsDFS(Itemset(), items, lhs, rhs, rhses_pairs, partitions, p_supps);
+    MinePatternsDFS(Itemset(), items, lhs, rhs, rhses_pairs, partitions, p_supps, output);
 }
 
-void FDFirstAlgorithm::MinePatternsDFS(Itemset const& prefix, TIdListMiners& items,
+template <typename TIdList>
+void FDFirstAlgorithm::MinePatternsDFS(Itemset const& prefix, TIdListMiners<TIdList>& items,
                                        Itemset const& lhs, int rhs, RhsesPair2DList& rhses_pair,
-                                       PartitionList& partitions, std::vector<unsigned>& psupps) {
+                                       PartitionList& partitions, std::vector<unsigned>& psupps,
+                                       BranchOutput& output) {
     for (int ix = static_cast<int>(items.size()) - 1; ix >= 0; ix--) {
         auto const& inode = items[ix];
         if (inode.tids.empty() && items[ix].tids.empty()) {
@@ -501,23 +556,24 @@ void FDFirstAlgorithm::MinePatternsDFS(Itemset const& prefix, TIdListMiners& ite
         }
         Itemset const iset = Join(prefix, inode.item);
         auto const node_attrs = relation_->GetAttrVectorItems(iset);
-        int out = (iset.size() == lhs.size()) ? GetMaxElem(rhses_pair[inode.tids[0]]) : rhs;
+        int out = (iset.size() == lhs.size()) ? GetMaxElem(rhses_pair[*inode.tids.begin()]) : rhs;
         auto const sub = Join(iset, SetDiff(lhs, node_attrs));
 
         if (out > 0 || !PartitionUtil::IsConstRulePartition(inode.tids, rhses_pair)) {
-            AddCFDToCFDList(sub, out, inode, partitions);
+            AddCFDToCFDList(sub, out, inode, partitions, output);
         }
-        TIdListMiners suffix;
+        TIdListMiners<TIdList> suffix;
         for (size_t j = ix + 1; j < items.size(); j++) {
             auto const& jnode = items[j];
             if (std::binary_search(node_attrs.begin(), node_attrs.end(),
                                    -1 - relation_->GetAttrIndex(jnode.item)))
                 continue;
             Itemset const new_set = Join(iset, jnode.item);
-            SimpleTIdList ij_tids = ConstructIntersection(inode.tids, jnode.tids);
+            TIdList ij_tids = ConstructIntersection(inode.tids, jnode.tids);
             unsigned ij_supp = PartitionUtil::GetPartitionSupport(ij_tids, psupps);
 
-            bool result = FillFreeMapAndItemsets(partitions, lhs, new_set, ij_tids, ij_supp);
+            bool result =
+                    FillFreeMapAndItemsets(partitions, lhs, new_set, ij_tids, ij_supp, output);
             if (!result) continue;
             suffix.emplace_back(jnode.item, ij_tids, ij_supp);
         }
@@ -525,7 +581,7 @@ void FDFirstAlgorithm::MinePatternsDFS(Itemset const& prefix, TIdListMiners& ite
             std::sort(suffix.begin(), suffix.end(), [](auto const& a, auto const& b) {
                 return TIdUtil::Support(a.tids) < TIdUtil::Support(b.tids);
             });
-            MinePatternsDFS(iset, suffix, lhs, rhs, rhses_pair, partitions, psupps);
+            MinePatternsDFS(iset, suffix, lhs, rhs, rhses_pair, partitions, psupps, output);
         }
     }
 }
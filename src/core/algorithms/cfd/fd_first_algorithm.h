@@ -1,10 +1,18 @@
 #pragma once
 
+#include <map>
+#include <optional>
+#include <set>
+#include <unordered_map>
+#include <vector>
+
 #include "core/algorithms/cfd/cfd_discovery.h"
 #include "core/algorithms/cfd/enums.h"
 #include "core/algorithms/cfd/miner_node.h"
 #include "core/algorithms/cfd/model/partition_tidlist.h"
 #include "core/algorithms/cfd/util/prefix_tree.h"
+#include "core/config/thread_number/type.h"
+#include "core/util/worker_thread_pool.h"
 
 // see algorithms/cfd/LICENSE
 
@@ -12,7 +20,20 @@ namespace algos::cfd {
 
 class FDFirstAlgorithm : public algos::cfd::CFDDiscovery {
     using PIdListMiners = std::vector<MinerNode<PartitionTIdList>>;
-    using TIdListMiners = std::vector<MinerNode<SimpleTIdList>>;
+    template <typename TIdList>
+    using TIdListMiners = std::vector<MinerNode<TIdList>>;
+    using FreeMap = std::map<std::pair<int, int>, std::vector<Itemset>>;
+    using Rules = std::unordered_map<int, std::vector<Itemset>>;
+
+    // What is found for one rhs of an itemset. Rhses of an itemset are mined in parallel: each
+    // writes its own output and only reads the shared state, then the outputs are merged in the
+    // order of the rhses.
+    struct BranchOutput {
+        ItemsetCFDList cfds;
+        // free itemsets with constants, found by the pattern mining
+        FreeMap free_map;
+        std::vector<Itemset> free_itemsets;
+    };
 
 private:
     unsigned min_supp_;
@@ -20,30 +41,46 @@ private:
     unsigned max_lhs_;
     double min_conf_;
     Substrategy substrategy_ = Substrategy::kDfs;
+    TIdListType tidlist_type_ = TIdListType::kVector;
+    config::ThreadNumType threads_;
+    std::optional<util::WorkerThreadPool> pool_;
 
     std::map<Itemset, PartitionTIdList> store_;
     PrefixTree<Itemset, Itemset> cand_store_;
     Itemset all_attrs_;
-    std::map<std::pair<int, int>, std::vector<Itemset>> free_map_;
+    FreeMap free_map_;
     std::set<Itemset> free_itemsets_;
-    std::unordered_map<int, std::vector<Itemset>> rules_;
+    // rules by the attribute of their rhs, so that different rhs attributes never share a map
+    std::vector<Rules> rules_;
 
     void ResetStateCFD() final;
     void CheckForIncorrectInput() const;
 
+    std::vector<Itemset>& GetRules(int rhs);
+    void MergeBranchOutput(BranchOutput&& output);
+
     void FdsFirstDFS();
     void FdsFirstDFS(Itemset const&, std::vector<MinerNode<PartitionTIdList>> const&,
                      Substrategy = Substrategy::kDfs);
-    void MinePatternsBFS(Itemset const& lhs, int rhs, PartitionTIdList const& all_tids);
-    void MinePatternsDFS(Itemset const& lhs, int rhs, PartitionTIdList const& all_tids);
-    void MinePatternsDFS(Itemset const&, std::vector<MinerNode<SimpleTIdList>>&, Itemset const&,
-                         int, RhsesPair2DList&, PartitionList&, std::vector<unsigned>&);
+    void MinePatterns(Itemset const& lhs, int rhs, PartitionTIdList const& all_tids,
+                      Substrategy ss, BranchOutput& output);
+    template <typename TIdList>
+    void MinePatternsBFS(Itemset const& lhs, int rhs, PartitionTIdList const& all_tids,
+                         BranchOutput& output);
+    template <typename TIdList>
+    void MinePatternsDFS(Itemset const& lhs, int rhs, PartitionTIdList const& all_tids,
+                         BranchOutput& output);
+    template <typename TIdList>
+    void MinePatternsDFS(Itemset const&, TIdListMiners<TIdList>&, Itemset const&, int,
+                         RhsesPair2DList&, PartitionList&, std::vector<unsigned>&,
+                         BranchOutput& output);
     std::vector<MinerNode<PartitionTIdList>> GetPartitionSingletons();
 
     bool Precedes(Itemset const& a, Itemset const& b);
     bool IsConstRule(PartitionTIdList const& items, int rhs_a);
 
-    void MineFD(MinerNode<PartitionTIdList> const& inode, Itemset const& lhs, int rhs);
+    void MineFD(MinerNode<PartitionTIdList> const& inode, Itemset const& lhs, int rhs,
+                BranchOutput& output);
     std::pair<std::vector<PartitionTIdList const*>, std::vector<MinerNode<PartitionTIdList>>>
     ExpandMiningFd(MinerNode<PartitionTIdList> const& inode, int ix, Itemset const& iset,
                    std::vector<MinerNode<PartitionTIdList>> const& items) const;
@@ -51,15 +88,20 @@ private:
     void FillMinePatternsVars(PartitionList&, RhsesPair2DList&, RuleIxs&, std::vector<int>&,
                               Itemset const&, int, PartitionTIdList const&) const;
 
-    void AddCFDToCFDList(std::vector<int> const& sub, int out,
-                         MinerNode<SimpleTIdList> const& inode, PartitionList const& partitions);
+    template <typename TIdList>
+    void AddCFDToCFDList(std::vector<int> const& sub, int out, MinerNode<TIdList> const& inode,
+                         PartitionList const& partitions, BranchOutput& output);
 
+    template <typename TIdList>
     void AnalyzeCFDFromPIdList(std::pair<int, SimpleTIdList> const&, PartitionList const&,
-                               std::vector<unsigned> const&, std::vector<MinerNode<SimpleTIdList>>&,
-                               Itemset const&);
+                               std::vector<unsigned> const&, TIdListMiners<TIdList>&,
+                               Itemset const&, BranchOutput& output);
 
+    template <typename TIdList>
     bool FillFreeMapAndItemsets(PartitionList const& partitions, Itemset const& lhs,
-                                Itemset const& new_set, SimpleTIdList const& ij_tids, unsigned);
+                                Itemset const& new_set, TIdList const& ij_tids, unsigned,
+                                BranchOutput& output);
+    bool AddFreeItemset(std::pair<int, int> sp, Itemset const& ns, BranchOutput& output) const;
 
 protected:
     void RegisterOptions();
@@ -1,5 +1,8 @@
 #include "core/algorithms/cfd/model/partition_tidlist.h"
 
+#include <algorithm>
+#include <vector>
+
 namespace algos::cfd {
 
 int const PartitionTIdList::kSep = -1;
@@ -70,11 +73,15 @@ PartitionTIdList PartitionTIdList::Intersection(PartitionTIdList const& rhs) con
 int PartitionTIdList::PartitionError(PartitionTIdList const& xa) const {
     int e = 0;
 
-    std::map<int, int> bigt;
+    // size of the class of xa by its last tid, 0 for other tids
+    std::vector<int> bigt;
+    if (!xa.tids.empty()) {
+        bigt.assign(*std::max_element(xa.tids.begin(), xa.tids.end()) + 1, 0);
+    }
     int count = 0;
     for (unsigned pi = 0; pi <= xa.tids.size(); pi++) {
         if (pi == xa.tids.size() || xa.tids[pi] == PartitionTIdList::kSep) {
-            bigt[xa.tids[pi - 1]] = count;
+            if (pi != 0) bigt[xa.tids[pi - 1]] = count;
             count = 0;
         } else {
             count++;
@@ -90,8 +97,8 @@ int PartitionTIdList::PartitionError(PartitionTIdList const& xa) const {
             count = 0;
         } else {
             count++;
-            int t = this->tids[cix];
-            if (bigt.count(t) && bigt[t] > m) {
+            auto const t = static_cast<unsigned>(this->tids[cix]);
+            if (t < bigt.size() && bigt[t] > m) {
                 m = bigt[t];
             }
         }
@@ -0,0 +1,130 @@
+#include "core/algorithms/cfd/model/tid_bitmap.h"
+
+#include <algorithm>
+#include <cassert>
+#include <utility>
+
+namespace algos::cfd {
+
+void TIdBitmap::ConstIterator::Settle() noexcept {
+    while (container_ != end_) {
+        if (container_->IsBitmap()) {
+            while (word_ == 0 && pos_ + 1 < kBitmapWords) {
+                word_ = container_->bitmap[++pos_];
+            }
+            if (word_ != 0) return;
+        } else if (pos_ < container_->array.size()) {
+            return;
+        }
+        ++container_;
+        Enter();
+    }
+}
+
+void TIdBitmap::AddContainer(Container container) {
+    if (container.cardinality == 0) return;
+    if (container.IsBitmap() && container.cardinality <= kMaxArraySize) {
+        container.array.reserve(container.cardinality);
+        for (std::size_t w = 0; w < kBitmapWords; ++w) {
+            for (std::uint64_t word = container.bitmap[w]; word != 0; word &= word - 1) {
+                container.array.push_back(
+                        static_cast<std::uint16_t>(w * kWordBits + std::countr_zero(word)));
+            }
+        }
+        container.bitmap = {};
+    }
+    size_ += container.cardinality;
+    containers_.push_back(std::move(container));
+}
+
+TIdBitmap TIdBitmap::FromSorted(SimpleTIdList const& tids) {
+    assert(std::is_sorted(tids.begin(), tids.end()));
+    TIdBitmap result;
+    auto it = tids.begin();
+    while (it != tids.end()) {
+        assert(*it >= 0);
+        auto const key = static_cast<std::uint32_t>(*it) >> kChunkBits;
+        auto const chunk_end = std::find_if(it, tids.end(), [key](Item tid) {
+            return static_cast<std::uint32_t>(tid) >> kChunkBits != key;
+        });
+        auto const cardinality = static_cast<std::uint32_t>(chunk_end - it);
+        Container container{key, cardinality, {}, {}};
+        if (cardinality > kMaxArraySize) {
+            container.bitmap.assign(kBitmapWords, 0);
+            for (; it != chunk_end; ++it) {
+                std::uint32_t const low = static_cast<std::uint32_t>(*it) & (kChunkSize - 1);
+                container.bitmap[low / kWordBits] |= std::uint64_t{1} << (low % kWordBits);
+            }
+        } else {
+            container.array.reserve(cardinality);
+            for (; it != chunk_end; ++it) {
+                container.array.push_back(static_cast<std::uint16_t>(*it & (kChunkSize - 1)));
+            }
+        }
+        result.AddContainer(std::move(container));
+    }
+    return result;
+}
+
+TIdBitmap::Container TIdBitmap::IntersectArrays(Container const& lhs, Container const& rhs) {
+    Container result{lhs.key, 0, {}, {}};
+    result.array.resize(std::min(lhs.array.size(), rhs.array.size()));
+    auto const end = std::set_intersection(lhs.array.begin(), lhs.array.end(), rhs.array.begin(),
+                                           rhs.array.end(), result.array.begin());
+    result.array.erase(end, result.array.end());
+    result.cardinality = result.array.size();
+    return result;
+}
+
+TIdBitmap::Container TIdBitmap::IntersectArrayBitmap(Container const& array,
+                                                     Container const& bitmap) {
+    Container result{array.key, 0, {}, {}};
+    result.array.reserve(array.array.size());
+    for (std::uint16_t low : array.array) {
+        if (bitmap.bitmap[low / kWordBits] >> (low % kWordBits) & 1) {
+            result.array.push_back(low);
+        }
+    }
+    result.cardinality = result.array.size();
+    return result;
+}
+
+TIdBitmap::Container TIdBitmap::IntersectBitmaps(Container const& lhs, Container const& rhs) {
+    Container result{lhs.key, 0, {}, std::vector<std::uint64_t>(kBitmapWords)};
+    std::uint32_t cardinality = 0;
+    for (std::size_t w = 0; w < kBitmapWords; ++w) {
+        std::uint64_t const word = lhs.bitmap[w] & rhs.bitmap[w];
+        result.bitmap[w] = word;
+        cardinality += std::popcount(word);
+    }
+    result.cardinality = cardinality;
+    return result;
+}
+
+TIdBitmap TIdBitmap::Intersect(TIdBitmap const& that) const {
+    TIdBitmap result;
+    auto lhs = containers_.begin();
+    auto rhs = that.containers_.begin();
+    while (lhs != containers_.end() && rhs != that.containers_.end()) {
+        if (lhs->key < rhs->key) {
+            ++lhs;
+        } else if (rhs->key < lhs->key) {
+            ++rhs;
+        } else {
+            if (lhs->IsBitmap() && rhs->IsBitmap()) {
+                result.AddContainer(IntersectBitmaps(*lhs, *rhs));
+            } else if (lhs->IsBitmap()) {
+                result.AddContainer(IntersectArrayBitmap(*rhs, *lhs));
+            } else if (rhs->IsBitmap()) {
+                result.AddContainer(IntersectArrayBitmap(*lhs, *rhs));
+            } else {
+                result.AddContainer(IntersectArrays(*lhs, *rhs));
+            }
+            ++lhs;
+            ++rhs;
+        }
+    }
+    return result;
+}
+
+}  // namespace algos::cfd
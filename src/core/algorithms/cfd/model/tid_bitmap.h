@@ -0,0 +1,141 @@
+#pragma once
+
+#include <bit>
+#include <cstddef>
+#include <cstdint>
+#include <iterator>
+#include <vector>
+
+#include "core/algorithms/cfd/model/cfd_types.h"
+
+namespace algos::cfd {
+
+// Compressed bitmap of non-negative ids, an alternative to a sorted SimpleTIdList.
+// Ids are split into chunks of 2^16 by their high bits, as in roaring bitmaps. A chunk with
+// few ids keeps their low bits in a sorted array, a dense chunk keeps a plain bitmap, so
+// intersecting dense chunks is a word-wise AND with popcount, which compilers vectorize.
+class TIdBitmap {
+private:
+    static constexpr unsigned kChunkBits = 16;
+    static constexpr std::size_t kChunkSize = std::size_t{1} << kChunkBits;
+    static constexpr std::size_t kWordBits = 64;
+    static constexpr std::size_t kBitmapWords = kChunkSize / kWordBits;
+    // A chunk with more ids than this takes less memory as a bitmap
+    static constexpr std::size_t kMaxArraySize = 4096;
+
+    struct Container {
+        std::uint32_t key;
+        std::uint32_t cardinality;
+        // low bits of the ids, sorted, when the bitmap is empty
+        std::vector<std::uint16_t> array;
+        std::vector<std::uint64_t> bitmap;
+
+        bool IsBitmap() const noexcept {
+            return !bitmap.empty();
+        }
+    };
+
+    std::vector<Container> containers_;
+    std::size_t size_ = 0;
+
+    void AddContainer(Container container);
+
+    static Container IntersectArrays(Container const& lhs, Container const& rhs);
+    static Container IntersectArrayBitmap(Container const& array, Container const& bitmap);
+    static Container IntersectBitmaps(Container const& lhs, Container const& rhs);
+
+public:
+    class ConstIterator {
+    private:
+        using ContainerIt = std::vector<Container>::const_iterator;
+
+        ContainerIt container_;
+        ContainerIt end_;
+        // index in the array or of the current word of the bitmap
+        std::size_t pos_ = 0;
+        // bits of the current word that are not visited yet
+        std::uint64_t word_ = 0;
+
+        void Enter() noexcept {
+            pos_ = 0;
+            word_ = container_ != end_ && container_->IsBitmap() ? container_->bitmap[0] : 0;
+        }
+
+        void Settle() noexcept;
+
+    public:
+        using iterator_category = std::forward_iterator_tag;
+        using value_type = Item;
+        using difference_type = std::ptrdiff_t;
+        using pointer = Item const*;
+        using reference = Item;
+
+        ConstIterator() = default;
+
+        ConstIterator(ContainerIt container, ContainerIt end) noexcept
+            : container_(container), end_(end) {
+            Enter();
+            Settle();
+        }
+
+        Item operator*() const noexcept {
+            unsigned const low = container_->IsBitmap()
+                                         ? pos_ * kWordBits + std::countr_zero(word_)
+                                         : container_->array[pos_];
+            return static_cast<Item>((container_->key << kChunkBits) | low);
+        }
+
+        ConstIterator& operator++() noexcept {
+            if (container_->IsBitmap()) {
+                word_ &= word_ - 1;
+            } else {
+                ++pos_;
+            }
+            Settle();
+            return *this;
+        }
+
+        ConstIterator operator++(int) noexcept {
+            ConstIterator it = *this;
+            ++*this;
+            return it;
+        }
+
+        bool operator==(ConstIterator const& that) const noexcept {
+            return container_ == that.container_ &&
+                   (container_ == end_ || (pos_ == that.pos_ && word_ == that.word_));
+        }
+    };
+
+    using const_iterator = ConstIterator;
+    using value_type = Item;
+
+    TIdBitmap() = default;
+
+    // Ids must be sorted
+    static TIdBitmap FromSorted(SimpleTIdList const& tids);
+
+    std::size_t size() const noexcept {
+        return size_;
+    }
+
+    bool empty() const noexcept {
+        return size_ == 0;
+    }
+
+    ConstIterator begin() const noexcept {
+        return {containers_.begin(), containers_.end()};
+    }
+
+    ConstIterator end() const noexcept {
+        return {containers_.end(), containers_.end()};
+    }
+
+    TIdBitmap Intersect(TIdBitmap const& that) const;
+};
+
+inline TIdBitmap ConstructIntersection(TIdBitmap const& lhs, TIdBitmap const& rhs) {
+    return lhs.Intersect(rhs);
+}
+
+}  // namespace algos::cfd
@@ -1,45 +1,75 @@
 #include "core/algorithms/cfd/util/partition_tidlist_util.h"
 
-#include "core/algorithms/cfd/util/tidlist_util.h"
+#include <algorithm>
 
 namespace algos::cfd {
 
+namespace {
+// Equivalence classes of a partition being split, with the ones that got tids since the last
+// flush. It is reused for all the partitions intersected by one thread.
+struct EqClasses {
+    std::vector<std::vector<int>> classes;
+    std::vector<unsigned> touched;
+};
+}  // namespace
+
 // Computes intersection
 std::vector<PartitionTIdList> PartitionTIdListUtil::ConstructIntersection(
-        PartitionTIdList const& lhs, std::vector<PartitionTIdList const*> const& rhses) {
-    std::unordered_map<int, int> eq_indices(TIdUtil::Support(lhs.tids));
-    std::vector<std::vector<int> > eq_classes(lhs.sets_number);
-    // Construct a lookup from tid to equivalence class
-    int eix = 0;
-    int count = 0;
+        PartitionTIdList const& lhs, std::vector<PartitionTIdList const*> const& rhses,
+        util::WorkerThreadPool* pool) {
+    // Construct a lookup from tid to equivalence class, counted from 1, 0 for tids not in lhs
+    std::vector<unsigned> class_sizes(lhs.sets_number + 1);
+    std::vector<unsigned> eq_indices;
+    if (!lhs.tids.empty()) {
+        eq_indices.assign(*std::max_element(lhs.tids.begin(), lhs.tids.end()) + 1, 0);
+    }
+    unsigned eix = 0;
+    unsigned count = 0;
     for (unsigned ix = 0; ix <= lhs.tids.size(); ix++) {
         count++;
         if (ix == lhs.tids.size() || lhs.tids[ix] == PartitionTIdList::kSep) {
-            eq_classes[eix++].reserve(count);
+            class_sizes[eix++] = count;
             count = 0;
         } else {
             eq_indices[lhs.tids[ix]] = eix + 1;
         }
     }
-    std::vector<PartitionTIdList> res;
-    for (PartitionTIdList const* rhs : rhses) {
-        PartitionTIdList p_tid_list = PartitionTIdList();
+
+    auto acquire_classes = [&]() {
+        EqClasses eq_classes;
+        eq_classes.classes.resize(lhs.sets_number);
+        for (unsigned i = 0; i < lhs.sets_number; ++i) {
+            eq_classes.classes[i].reserve(class_sizes[i]);
+        }
+        return eq_classes;
+    };
+
+    std::vector<PartitionTIdList> res(rhses.size());
+    auto intersect = [&](model::Index index, EqClasses& eq_classes) {
+        PartitionTIdList const* rhs = rhses[index];
+        PartitionTIdList& p_tid_list = res[index];
         p_tid_list.sets_number = 0;
         p_tid_list.tids.reserve(lhs.tids.size());
         for (unsigned ix = 0; ix <= rhs->tids.size(); ix++) {
             if (ix == rhs->tids.size() || rhs->tids[ix] == PartitionTIdList::kSep) {
-                for (auto& eqcl : eq_classes) {
-                    if (!eqcl.empty()) {
-                        p_tid_list.tids.insert(p_tid_list.tids.end(), eqcl.begin(), eqcl.end());
-                        p_tid_list.tids.push_back(PartitionTIdList::kSep);
-                        p_tid_list.sets_number++;
-                        eqcl.clear();
-                    }
+                // classes are flushed in the order of lhs, as if all of them were scanned
+                std::sort(eq_classes.touched.begin(), eq_classes.touched.end());
+                for (unsigned touched : eq_classes.touched) {
+                    auto& eqcl = eq_classes.classes[touched];
+                    p_tid_list.tids.insert(p_tid_list.tids.end(), eqcl.begin(), eqcl.end());
+                    p_tid_list.tids.push_back(PartitionTIdList::kSep);
+                    p_tid_list.sets_number++;
+                    eqcl.clear();
                 }
+                eq_classes.touched.clear();
             } else {
-                int jt = rhs->tids[ix];
-                if (eq_indices.count(jt)) {
-                    eq_classes[eq_indices[jt] - 1].push_back(jt);
+                auto const jt = static_cast<unsigned>(rhs->tids[ix]);
+                if (jt < eq_indices.size() && eq_indices[jt] != 0) {
+                    auto& eqcl = eq_classes.classes[eq_indices[jt] - 1];
+                    if (eqcl.empty()) {
+                        eq_classes.touched.push_back(eq_indices[jt] - 1);
+                    }
+                    eqcl.push_back(static_cast<int>(jt));
                 }
             }
         }
@@ -47,7 +77,15 @@ std::vector<PartitionTIdList> PartitionTIdListUtil::ConstructIntersection(
         if (!p_tid_list.tids.empty() && p_tid_list.tids.back() == PartitionTIdList::kSep) {
             p_tid_list.tids.pop_back();
         }
-        res.push_back(p_tid_list);
+    };
+
+    if (pool != nullptr && rhses.size() > 1) {
+        pool->ExecIndexWithResource(intersect, acquire_classes, rhses.size());
+    } else {
+        EqClasses eq_classes = acquire_classes();
+        for (model::Index index = 0; index < rhses.size(); ++index) {
+            intersect(index, eq_classes);
+        }
     }
     return res;
 }
@@ -1,12 +1,16 @@
 #pragma once
 
 #include "core/algorithms/cfd/model/partition_tidlist.h"
+#include "core/util/worker_thread_pool.h"
 
 namespace algos::cfd {
 
 class PartitionTIdListUtil {
 public:
+    // Intersections of lhs with every partition of rhses. They are computed on the pool, if it
+    // is given.
     static std::vector<PartitionTIdList> ConstructIntersection(
-            PartitionTIdList const& lhs, std::vector<PartitionTIdList const*> const& rhses);
+            PartitionTIdList const& lhs, std::vector<PartitionTIdList const*> const& rhses,
+            util::WorkerThreadPool* pool = nullptr);
 };
 }  // namespace algos::cfd
@@ -1,16 +1,56 @@
 #pragma once
 
+#include <algorithm>
+#include <numeric>
+
 #include "core/algorithms/cfd/model/cfd_types.h"
 
 // see algorithms/cfd/LICENSE
 
 namespace algos::cfd {
 
+// Functions over lists of partition ids, either SimpleTIdList or TIdBitmap
 class PartitionUtil {
 public:
-    static bool IsConstRulePartition(SimpleTIdList const& items, RhsesPair2DList const& rhses);
-    static unsigned GetPartitionSupport(SimpleTIdList const& pids,
-                                        std::vector<unsigned> const& partitions);
-    static unsigned GetPartitionError(SimpleTIdList const& pids, PartitionList const& partitions);
+    template <typename TIdList>
+    static bool IsConstRulePartition(TIdList const& items, RhsesPair2DList const& rhses) {
+        int rhs_value;
+        bool first = true;
+        for (int pi : items) {
+            if (first) {
+                first = false;
+                rhs_value = rhses[pi][0].first;
+            }
+            for (auto rp : rhses[pi]) {
+                int r = rp.first;
+                if (r != rhs_value) {
+                    return false;
+                }
+            }
+        }
+        return true;
+    }
+
+    template <typename TIdList>
+    static unsigned GetPartitionSupport(TIdList const& pids, std::vector<unsigned> const& psupps) {
+        unsigned res = 0;
+        for (int p : pids) {
+            res += psupps[p];
+        }
+        return res;
+    }
+
+    template <typename TIdList>
+    static unsigned GetPartitionError(TIdList const& pids, PartitionList const& partitions) {
+        unsigned res = 0;
+        for (int p : pids) {
+            unsigned max =
+                    *(std::max_element(partitions[p].second.begin(), partitions[p].second.end()));
+            unsigned total = std::accumulate(partitions[p].second.begin(),
+                                             partitions[p].second.end(), 0u);
+            res += total - max;
+        }
+        return res;
+    }
 };
 }  // namespace algos::cfd
@@ -22,4 +22,8 @@ unsigned TIdUtil::Hash(SimpleTIdList const& tids) {
 int TIdUtil::Support(SimpleTIdList const& tids) {
     return tids.size();
 }
+
+int TIdUtil::Support(TIdBitmap const& tids) {
+    return tids.size();
+}
 }  // namespace algos::cfd
@@ -2,6 +2,7 @@
 
 #include "core/algorithms/cfd/model/cfd_types.h"
 #include "core/algorithms/cfd/model/partition_tidlist.h"
+#include "core/algorithms/cfd/model/tid_bitmap.h"
 
 // see algorithms/cfd/LICENSE
 
@@ -13,5 +14,6 @@ public:
     static unsigned Hash(PartitionTIdList const& tids);
     static int Support(SimpleTIdList const& tids);
     static unsigned Hash(SimpleTIdList const& tids);
+    static int Support(TIdBitmap const& tids);
 };
 }  // namespace algos::cfd
@@ -51,6 +51,7 @@ void CindAlgorithm::CreateCindMinerAlgo() {
     } else {
         cind_miner_ = std::make_unique<PliCind>(spider_algo_->input_tables_);
     }
+    cind_miner_->threads_num_ = spider_algo_->threads_num_;
     RegisterCindMinerOptions();
 }
 
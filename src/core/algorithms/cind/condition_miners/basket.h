@@ -8,12 +8,18 @@
 namespace algos::cind {
 using ItemsInfo = std::unordered_map<Item, std::vector<size_t>>;
 
-struct Basket {
-    bool is_included{false};
-    ItemsInfo items{};
+/* Baskets of the left-outer join representation. They depend only on the dependent and the
+ * conditional columns, so AINDs that differ in the referenced columns share them, and whether a
+ * basket is included is kept apart, per AIND.
+ */
+struct Baskets {
+    /* values of the dependent columns of every basket */
+    std::vector<std::vector<int>> keys;
+    /* items of the conditional columns of every basket, with the rows they occur in */
+    std::vector<ItemsInfo> items;
 
-    bool IsContains(Item const& item) const {
-        return items.contains(item);
+    size_t Size() const noexcept {
+        return keys.size();
     }
 };
 }  // namespace algos::cind
@@ -1,9 +1,12 @@
 #include "cind_miner.h"
 
+#include <memory>
+#include <optional>
 #include <unordered_set>
 
 #include "core/algorithms/cind/types.h"
 #include "core/model/table/encoded_tables.h"
+#include "core/util/parallel_for.h"
 #include "core/util/timed_invoke.h"
 
 namespace algos::cind {
@@ -51,8 +54,27 @@ CindMiner::Attributes CindMiner::ClassifyAttributes(model::IND const& aind) cons
 unsigned long long CindMiner::Execute(std::list<model::IND> const& aind_list) {
     auto const execute = [&] {
         cind_collection_.Clear();
+        std::optional<util::WorkerThreadPool> pool;
+        if (threads_num_ > 1) {
+            pool.emplace(threads_num_);
+        }
+        pool_ = pool ? std::addressof(*pool) : nullptr;
+        std::vector<model::IND const*> ainds;
+        std::vector<Attributes> attributes;
         for (auto const& aind : aind_list) {
-            cind_collection_.Register(ExecuteSingle(aind));
+            ainds.push_back(&aind);
+            attributes.push_back(ClassifyAttributes(aind));
+        }
+        Prepare(attributes);
+
+        // AINDs are processed in parallel, but registered in the order of the list
+        std::vector<std::optional<CIND>> cinds(ainds.size());
+        util::ParallelFor(pool_, ainds.size(), [&](size_t i) {
+            cinds[i].emplace(ExecuteSingle(*ainds[i], attributes[i]));
+        });
+        pool_ = nullptr;
+        for (auto& cind : cinds) {
+            cind_collection_.Register(std::move(*cind));
         }
     };
     return util::TimedInvoke(execute);
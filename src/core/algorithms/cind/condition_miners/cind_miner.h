@@ -1,11 +1,16 @@
 #pragma once
 
+#include <list>
+#include <vector>
+
 #include "core/algorithms/cind/cind.h"
 #include "core/algorithms/cind/types.h"
 #include "core/algorithms/ind/ind.h"
 #include "core/config/tabular_data/input_tables_type.h"
+#include "core/config/thread_number/type.h"
 #include "core/model/table/encoded_tables.h"
 #include "core/util/primitive_collection.h"
+#include "core/util/worker_thread_pool.h"
 
 namespace algos::cind {
 using model::EncodedColumnData;
@@ -25,9 +30,15 @@ protected:
     double min_validity_;
     double min_completeness_;
     CondType condition_type_;
+    config::ThreadNumType threads_num_ = 1;
+    /* threads of the running Execute, nullptr if it runs on one thread */
+    util::WorkerThreadPool* pool_ = nullptr;
     util::PrimitiveCollection<CIND> cind_collection_;
 
-    virtual CIND ExecuteSingle(model::IND const& aind) = 0;
+    /* Builds the data that several AINDs can share before they are processed in parallel */
+    virtual void Prepare(std::vector<Attributes> const& /*attributes*/) {}
+    /* Called concurrently for different AINDs */
+    virtual CIND ExecuteSingle(model::IND const& aind, Attributes const& attributes) const = 0;
     Attributes ClassifyAttributes(model::IND const& aind) const;
     static std::vector<std::string> GetConditionalAttributesNames(AttrsType const& condition_attrs);
 
@@ -3,6 +3,8 @@
 
 #include <algorithm>
 #include <iterator>
+#include <memory>
+#include <mutex>
 #include <tuple>
 #include <unordered_map>
 #include <unordered_set>
@@ -61,28 +63,41 @@ std::vector<BasketInfo> MergeBaskets(std::vector<BasketInfo> const& baskets1,
 
 Cinderella::Cinderella(config::InputTables& input_tables) : CindMiner(input_tables) {}
 
-CIND Cinderella::ExecuteSingle(model::IND const& aind) {
-    auto attributes = ClassifyAttributes(aind);
+void Cinderella::Prepare(std::vector<Attributes> const& attributes) {
+    baskets_.clear();
+    // the map is filled in advance, so that the tasks only access its values
+    for (auto const& attrs : attributes) {
+        ++baskets_[GetBasketsKey(attrs)].pending_uses;
+    }
+}
+
+CIND Cinderella::ExecuteSingle(model::IND const& aind, Attributes const& attributes) const {
+    BasketsEntry& entry = baskets_.at(GetBasketsKey(attributes));
+    std::call_once(entry.built, [&] {
+        entry.baskets = std::make_shared<Baskets const>(GetBaskets(attributes));
+    });
+    std::shared_ptr<Baskets const> const baskets = entry.baskets;
+    if (entry.pending_uses.fetch_sub(1, std::memory_order_acq_rel) == 1) {
+        entry.baskets.reset();
+    }
+
     CIND cind{.ind = aind,
-              .conditions = GetConditions(GetBaskets(attributes), attributes.conditional),
+              .conditions = GetConditions(*baskets, GetIncludedBaskets(*baskets, attributes),
+                                          attributes.conditional),
               .conditional_attributes = GetConditionalAttributesNames(attributes.conditional)};
     return cind;
 }
 
-std::vector<Basket> Cinderella::GetBaskets(Attributes const& attributes) {
-    // algorithm uses modified left-outer join representation to build the baskets
-    std::unordered_set<std::vector<int>, VectorIntHash> rhs_values;
-
-    for (size_t index = 0; index < attributes.rhs_inclusion.front()->GetNumRows(); ++index) {
-        std::vector<int> row;
-        row.reserve(attributes.rhs_inclusion.size());
-        for (auto& attr : attributes.rhs_inclusion) {
-            row.push_back(attr->GetValue(index));
-        }
-        rhs_values.insert(std::move(row));
-    }
+AttrsType Cinderella::GetBasketsKey(Attributes const& attributes) {
+    AttrsType key = attributes.lhs_inclusion;
+    key.push_back(nullptr);
+    key.insert(key.end(), attributes.conditional.begin(), attributes.conditional.end());
+    return key;
+}
 
-    std::vector<Basket> result;
+Baskets Cinderella::GetBaskets(Attributes const& attributes) const {
+    // algorithm uses modified left-outer join representation to build the baskets
+    Baskets result;
     std::unordered_map<std::vector<int>, std::size_t, VectorIntHash> basket_id_by_value;
 
     for (size_t index = 0; index < attributes.lhs_inclusion.front()->GetNumRows(); ++index) {
@@ -95,17 +110,15 @@ std::vector<Basket> Cinderella::GetBaskets(Attributes const& attributes) {
         if (condition_type_ == CondType::kGroup) {
             auto it = basket_id_by_value.find(row);
             if (it == basket_id_by_value.end()) {
-                bool const included = rhs_values.contains(row);
-                std::size_t const id = result.size();
-
-                result.emplace_back(algos::cind::Basket{included, ItemsInfo{}});
-                it = basket_id_by_value.emplace(row, id).first;
+                it = basket_id_by_value.emplace(row, result.Size()).first;
+                result.keys.push_back(std::move(row));
+                result.items.emplace_back();
             }
 
             auto const basket_id = it->second;
             for (auto const& cond_attr : attributes.conditional) {
                 Item item{cond_attr->GetColumnId(), cond_attr->GetValue(index)};
-                result[basket_id].items[item].push_back(index);
+                result.items[basket_id][item].push_back(index);
             }
         } else {
             ItemsInfo basket_items;
@@ -113,35 +126,56 @@ std::vector<Basket> Cinderella::GetBaskets(Attributes const& attributes) {
                 Item item{cond_attr->GetColumnId(), cond_attr->GetValue(index)};
                 basket_items[item].push_back(index);
             }
-            result.emplace_back(
-                    algos::cind::Basket{rhs_values.contains(row), std::move(basket_items)});
+            result.keys.push_back(std::move(row));
+            result.items.push_back(std::move(basket_items));
         }
     }
     return result;
 }
 
-std::vector<Condition> Cinderella::GetConditions(std::vector<Basket> const& baskets,
+std::vector<bool> Cinderella::GetIncludedBaskets(Baskets const& baskets,
+                                                 Attributes const& attributes) {
+    std::unordered_set<std::vector<int>, VectorIntHash> rhs_values;
+
+    for (size_t index = 0; index < attributes.rhs_inclusion.front()->GetNumRows(); ++index) {
+        std::vector<int> row;
+        row.reserve(attributes.rhs_inclusion.size());
+        for (auto& attr : attributes.rhs_inclusion) {
+            row.push_back(attr->GetValue(index));
+        }
+        rhs_values.insert(std::move(row));
+    }
+
+    std::vector<bool> result;
+    result.reserve(baskets.Size());
+    for (auto const& key : baskets.keys) {
+        result.push_back(rhs_values.contains(key));
+    }
+    return result;
+}
+
+std::vector<Condition> Cinderella::GetConditions(Baskets const& baskets,
+                                                 std::vector<bool> const& included_baskets,
                                                  AttrsType const& condition_attrs) const {
     std::unordered_map<Item, std::vector<BasketInfo>> first_level_items;
 
     // scan all included baskets to extract all included items
     // number of all included baskets - needed for computing completeness of conditions
     std::size_t included_baskets_cnt = 0;
-    for (auto const& basket : baskets) {
-        if (!basket.is_included) {
+    for (size_t basket_id = 0; basket_id < baskets.Size(); ++basket_id) {
+        if (!included_baskets[basket_id]) {
             continue;
         }
         ++included_baskets_cnt;
-        for (auto const& [item, _] : basket.items) {
+        for (auto const& [item, _] : baskets.items[basket_id]) {
             first_level_items.try_emplace(item, std::vector<BasketInfo>{});
         }
     }
 
-    for (size_t basket_id = 0; basket_id < baskets.size(); ++basket_id) {
-        auto const& basket = baskets.at(basket_id);
-        for (auto const& [item, positions] : basket.items) {
+    for (size_t basket_id = 0; basket_id < baskets.Size(); ++basket_id) {
+        for (auto const& [item, positions] : baskets.items[basket_id]) {
             if (auto it = first_level_items.find(item); it != first_level_items.end()) {
-                it->second.emplace_back(basket_id, positions, basket.is_included);
+                it->second.emplace_back(basket_id, positions, included_baskets[basket_id]);
             }
         }
     }
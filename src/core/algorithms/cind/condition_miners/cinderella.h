@@ -1,7 +1,13 @@
 #pragma once
 
+#include <atomic>
+#include <memory>
+#include <mutex>
+#include <unordered_map>
 #include <vector>
 
+#include <boost/container_hash/hash.hpp>
+
 #include "basket.h"
 #include "core/algorithms/cind/cind.h"
 #include "core/algorithms/cind/condition_miners/cind_miner.h"
@@ -10,11 +16,34 @@
 namespace algos::cind {
 class Cinderella final : public CindMiner {
 private:
-    CIND ExecuteSingle(model::IND const& aind) final;
+    struct ColumnsHash {
+        std::size_t operator()(AttrsType const& columns) const noexcept {
+            return boost::hash_value(columns);
+        }
+    };
+
+    struct BasketsEntry {
+        std::once_flag built;
+        std::shared_ptr<Baskets const> baskets;
+        /* AINDs that have not taken the baskets yet, the last one frees them */
+        std::atomic<size_t> pending_uses = 0;
+    };
+
+    /* Baskets by the dependent columns followed by nullptr and the conditional columns. The
+     * keys are added by Prepare, the baskets are built by the first AIND that needs them, so
+     * only the baskets of the AINDs in progress and of the keys still awaited are held */
+    mutable std::unordered_map<AttrsType, BasketsEntry, ColumnsHash> baskets_;
+
+    void Prepare(std::vector<Attributes> const& attributes) final;
+    CIND ExecuteSingle(model::IND const& aind, Attributes const& attributes) const final;
 
-    std::vector<Basket> GetBaskets(Attributes const& attributes);
+    static AttrsType GetBasketsKey(Attributes const& attributes);
+    Baskets GetBaskets(Attributes const& attributes) const;
+    static std::vector<bool> GetIncludedBaskets(Baskets const& baskets,
+                                                Attributes const& attributes);
 
-    std::vector<Condition> GetConditions(std::vector<Basket> const& baskets,
+    std::vector<Condition> GetConditions(Baskets const& baskets,
+                                         std::vector<bool> const& included_baskets,
                                          AttrsType const& condition_attrs) const;
 
     void CreateNewItemsets(Itemset& itemset) const;
@@ -13,6 +13,7 @@
 #include "core/algorithms/cind/condition_miners/position_lists_set.h"
 #include "core/algorithms/cind/types.h"
 #include "core/model/table/encoded_column_data.h"
+#include "core/util/parallel_for.h"
 
 namespace algos::cind {
 
@@ -26,16 +27,31 @@ struct VectorIntHash {
 
 PliCind::PliCind(config::InputTables& input_tables) : CindMiner(input_tables) {}
 
-CIND PliCind::ExecuteSingle(model::IND const& aind) {
-    auto attributes = ClassifyAttributes(aind);
-    CIND result{.ind = aind,
-                .conditions = GetConditions(attributes),
-                .conditional_attributes = GetConditionalAttributesNames(attributes.conditional)};
-    Reset();
-    return result;
+void PliCind::Prepare(std::vector<Attributes> const& attributes) {
+    column_pls_.clear();
+    std::vector<EncodedColumnData const*> columns;
+    for (auto const& attrs : attributes) {
+        for (auto const* attr : attrs.conditional) {
+            if (column_pls_.try_emplace(attr).second) {
+                columns.push_back(attr);
+            }
+        }
+    }
+
+    // the map is filled in advance, so that the tasks only assign its values
+    util::ParallelFor(pool_, columns.size(), [&](size_t i) {
+        column_pls_.at(columns[i]) =
+                PLSet::CreateFor(columns[i]->GetValues(), columns[i]->GetNumRows());
+    });
+}
+
+CIND PliCind::ExecuteSingle(model::IND const& aind, Attributes const& attributes) const {
+    return {.ind = aind,
+            .conditions = GetConditions(attributes),
+            .conditional_attributes = GetConditionalAttributesNames(attributes.conditional)};
 }
 
-std::pair<std::vector<int>, std::vector<int>> PliCind::ClassifyRows(Attributes const& attrs) {
+std::pair<std::vector<int>, std::vector<int>> PliCind::ClassifyRows(Attributes const& attrs) const {
     std::unordered_set<std::vector<int>, VectorIntHash> rhs_values;
     for (size_t index = 0; index < attrs.rhs_inclusion.front()->GetNumRows(); ++index) {
         std::vector<int> row;
@@ -85,28 +101,24 @@ std::pair<std::vector<int>, std::vector<int>> PliCind::ClassifyRows(Attributes c
     return {included_pos, row_to_group};
 }
 
-void PliCind::MakePLs(Attributes const& attrs) {
-    relation_size_ = attrs.lhs_inclusion.front()->GetNumRows();
-    attr_idx_to_pls_.reserve(attrs.conditional.size());
-    for (auto const& attr : attrs.conditional) {
-        attr_idx_to_pls_.push_back(model::PLSet::CreateFor(attr->GetValues(), relation_size_));
-    }
-}
-
-std::vector<Condition> PliCind::GetConditions(Attributes const& attrs) {
+std::vector<Condition> PliCind::GetConditions(Attributes const& attrs) const {
     auto const& [included_pos, row_to_group] = ClassifyRows(attrs);
     if (included_pos.empty()) {
         return {};
     }
 
-    MakePLs(attrs);
+    std::vector<PLSet const*> attr_idx_to_pls;
+    attr_idx_to_pls.reserve(attrs.conditional.size());
+    for (auto const* attr : attrs.conditional) {
+        attr_idx_to_pls.push_back(column_pls_.at(attr).get());
+    }
 
     std::vector<Condition> result;
     std::vector<int> empty_attrs;
 
     for (size_t attr_idx = 0; attr_idx < attrs.conditional.size(); ++attr_idx) {
-        auto conditions = Analyze(attr_idx, empty_attrs, nullptr, attrs.conditional, row_to_group,
-                                  included_pos);
+        auto conditions = Analyze(attr_idx, empty_attrs, nullptr, attr_idx_to_pls,
+                                  attrs.conditional, row_to_group, included_pos);
 
         result.insert(result.end(), std::make_move_iterator(conditions.begin()),
                       std::make_move_iterator(conditions.end()));
@@ -116,31 +128,39 @@ std::vector<Condition> PliCind::GetConditions(Attributes const& attrs) {
 }
 
 std::vector<Condition> PliCind::Analyze(size_t attr_idx, std::vector<int> const& curr_attrs,
-                                        PLSetShared const& curr_pls, AttrsType const& cond_attrs,
+                                        PLSetShared const& curr_pls,
+                                        std::vector<PLSet const*> const& attr_idx_to_pls,
+                                        AttrsType const& cond_attrs,
                                         std::vector<int> const& row_to_group,
-                                        std::vector<int> const& included_pos) {
+                                        std::vector<int> const& included_pos) const {
     std::vector<int> new_curr_attrs = curr_attrs;
     new_curr_attrs.push_back(static_cast<int>(attr_idx));
 
-    PLSetShared curr_comb_pls = attr_idx_to_pls_.at(attr_idx);
+    PLSet const& attr_pls = *attr_idx_to_pls.at(attr_idx);
+    PLSetShared curr_comb_pls_owner;
+    PLSet const* curr_comb_pls = &attr_pls;
 
     bool const is_first_level = curr_attrs.empty();
     if (!is_first_level) {
-        curr_comb_pls = curr_pls->Intersect(attr_idx_to_pls_.at(attr_idx).get());
+        curr_comb_pls_owner = curr_pls->Intersect(attr_pls);
+        curr_comb_pls = curr_comb_pls_owner.get();
     }
 
     std::vector<Condition> result;
-    std::vector<PLSet::ClusterCollection::value_type> good_clusters;
+    auto good_clusters = std::make_shared<PLSet>(curr_comb_pls->GetArity(),
+                                                 cond_attrs.front()->GetNumRows());
+    std::vector<int> included_cluster;
+    std::vector<int> group_cluster;
 
-    for (auto& [cluster_value, cluster] : curr_comb_pls->GetClusters()) {
-        std::vector<int> included_cluster;
-        included_cluster.reserve(std::min(cluster.size(), included_pos.size()));
+    for (size_t cluster_id = 0; cluster_id < curr_comb_pls->GetNumCluster(); ++cluster_id) {
+        PLSet::Cluster const cluster = curr_comb_pls->GetCluster(cluster_id);
+        PLSet::ClusterValue const cluster_value = curr_comb_pls->GetClusterValue(cluster_id);
+        included_cluster.clear();
 
         size_t cluster_size = cluster.size();
 
         if (condition_type_ == CondType::kGroup) {
-            std::vector<int> group_cluster;
-            group_cluster.reserve(cluster.size());
+            group_cluster.clear();
             for (int row_id : cluster) {
                 group_cluster.push_back(row_to_group.at(static_cast<size_t>(row_id)));
             }
@@ -161,8 +181,7 @@ std::vector<Condition> PliCind::Analyze(size_t attr_idx, std::vector<int> const&
                                     static_cast<double>(included_pos.size());
 
         if (completeness >= min_completeness_) {
-            good_clusters.emplace_back(cluster_value,
-                                       is_first_level ? cluster : std::move(cluster));
+            good_clusters->AddCluster(cluster_value, cluster);
 
             double const validity = static_cast<double>(included_cluster.size()) /
                                     static_cast<double>(cluster_size);
@@ -174,13 +193,13 @@ std::vector<Condition> PliCind::Analyze(size_t attr_idx, std::vector<int> const&
         }
     }
 
-    if (!good_clusters.empty()) {
-        PLSetShared new_curr_pls = PLSet::CreateFor(std::move(good_clusters), relation_size_);
+    if (good_clusters->GetNumCluster() != 0) {
+        PLSetShared const new_curr_pls = std::move(good_clusters);
 
         for (size_t next_attr_idx = attr_idx + 1; next_attr_idx < cond_attrs.size();
              ++next_attr_idx) {
-            auto conditions = Analyze(next_attr_idx, new_curr_attrs, new_curr_pls, cond_attrs,
-                                      row_to_group, included_pos);
+            auto conditions = Analyze(next_attr_idx, new_curr_attrs, new_curr_pls,
+                                      attr_idx_to_pls, cond_attrs, row_to_group, included_pos);
 
             result.insert(result.end(), std::make_move_iterator(conditions.begin()),
                           std::make_move_iterator(conditions.end()));
@@ -190,9 +209,4 @@ std::vector<Condition> PliCind::Analyze(size_t attr_idx, std::vector<int> const&
     return result;
 }
 
-void PliCind::Reset() {
-    attr_idx_to_pls_.clear();
-    relation_size_ = static_cast<size_t>(0);
-}
-
 }  // namespace algos::cind
@@ -1,5 +1,6 @@
 #pragma once
 
+#include <unordered_map>
 #include <vector>
 
 // #include "algorithms/ind/cind/condition.h"
@@ -9,29 +10,29 @@
 
 namespace algos::cind {
 using model::PLSet;
-using PLSetShared = std::shared_ptr<model::PLSet>;
+using PLSetShared = std::shared_ptr<model::PLSet const>;
 
 class PliCind final : public CindMiner {
 private:
-    std::vector<PLSetShared> attr_idx_to_pls_;
-    size_t relation_size_;
+    /* Position lists of every conditional column, shared by all AINDs with that column */
+    std::unordered_map<EncodedColumnData const*, PLSetShared> column_pls_;
 
-    CIND ExecuteSingle(model::IND const& aind) final;
-    void MakePLs(Attributes const& attrs);
+    void Prepare(std::vector<Attributes> const& attributes) final;
+    CIND ExecuteSingle(model::IND const& aind, Attributes const& attributes) const final;
 
-    std::pair<std::vector<int>, std::vector<int>> ClassifyRows(Attributes const& attrs);
+    std::pair<std::vector<int>, std::vector<int>> ClassifyRows(Attributes const& attrs) const;
 
     std::vector<Condition> Analyze(size_t attr_idx, std::vector<int> const& curr_attrs,
-                                   PLSetShared const& curr_pls, AttrsType const& cond_attrs,
+                                   PLSetShared const& curr_pls,
+                                   std::vector<PLSet const*> const& attr_idx_to_pls,
+                                   AttrsType const& cond_attrs,
                                    std::vector<int> const& row_to_group,
-                                   std::vector<int> const& included_pos);
-
-    void Reset();
+                                   std::vector<int> const& included_pos) const;
 
 public:
     PliCind(config::InputTables& input_tables);
 
-    std::vector<Condition> GetConditions(Attributes const& attrs);
+    std::vector<Condition> GetConditions(Attributes const& attrs) const;
 };
 
 }  // namespace algos::cind
@@ -1,91 +1,139 @@
 #include "position_lists_set.h"
 
+#include <algorithm>
+#include <cassert>
 #include <memory>
+#include <numeric>
+#include <unordered_map>
 #include <utility>
 
-#include <boost/dynamic_bitset.hpp>
-
-#include "core/util/logger.h"
-
 namespace model {
 
-PositionListsSet::PositionListsSet(ClusterCollection clusters, size_t size, size_t relation_size)
-    : clusters_(std::move(clusters)), rows_number_(size), relation_size_(relation_size) {
-    ForceCacheProbingTable();
-}
-
 std::shared_ptr<PositionListsSet> PositionListsSet::CreateFor(std::vector<int> const& records,
                                                               size_t relation_size) {
-    ClusterCollection clusters;
-    for (size_t record_id = 0; record_id < records.size(); ++record_id) {
-        clusters[{records[record_id]}].push_back(record_id);
+    auto result = std::make_shared<PositionListsSet>(1, relation_size);
+    if (records.empty()) {
+        return result;
     }
-    return std::make_shared<PositionListsSet>(std::move(clusters), records.size(), relation_size);
-}
 
-std::shared_ptr<PositionListsSet> PositionListsSet::CreateFor(
-        std::vector<ClusterCollection::value_type> clusters, size_t relation_size) {
-    ClusterCollection cluster_collection;
-    for (auto& cluster : clusters) {
-        cluster_collection.insert(std::move(cluster));
+    // values are ids of a dictionary shared by all columns, so they are first mapped to dense
+    // local ids in the order of values. Rows are then bucketed by a counting sort over the local
+    // ids, which keeps them sorted within every cluster.
+    std::unordered_map<int, int> first_seen_ids;
+    std::vector<int> record_clusters;
+    record_clusters.reserve(records.size());
+    for (int value : records) {
+        record_clusters.push_back(
+                first_seen_ids.try_emplace(value, static_cast<int>(first_seen_ids.size()))
+                        .first->second);
+    }
+    std::vector<std::pair<int, int>> values_by_first_seen(first_seen_ids.begin(),
+                                                          first_seen_ids.end());
+    std::sort(values_by_first_seen.begin(), values_by_first_seen.end());
+    std::vector<int> cluster_ids(values_by_first_seen.size());
+    result->values_.reserve(values_by_first_seen.size());
+    for (auto const& [value, first_seen_id] : values_by_first_seen) {
+        cluster_ids[first_seen_id] = static_cast<int>(result->values_.size());
+        result->values_.push_back(value);
+    }
+    for (int& cluster : record_clusters) {
+        cluster = cluster_ids[cluster];
     }
-    return std::make_shared<PositionListsSet>(std::move(cluster_collection), clusters.size(),
-                                              relation_size);
-}
 
-std::shared_ptr<std::vector<int> const> PositionListsSet::CalculateAndGetProbingTable() {
-    cluster_values_cache_.clear();
-    std::vector<int> probing_table(relation_size_);
-    int next_cluster_id = 0;
-    for (auto& [value, cluster] : clusters_) {
-        int value_id = next_cluster_id++;
-        for (int position : cluster) {
-            probing_table[position] = value_id;
-        }
-        cluster_values_cache_.emplace_back(value);
+    std::vector<size_t> cluster_offsets(result->values_.size() + 1, 0);
+    for (int cluster_id : record_clusters) {
+        ++cluster_offsets[cluster_id + 1];
+    }
+    std::partial_sum(cluster_offsets.begin(), cluster_offsets.end(), cluster_offsets.begin());
+    result->offsets_.assign(cluster_offsets.begin(), cluster_offsets.end());
+
+    result->positions_.resize(records.size());
+    for (size_t record_id = 0; record_id < records.size(); ++record_id) {
+        result->positions_[cluster_offsets[record_clusters[record_id]]++] =
+                static_cast<int>(record_id);
     }
 
-    return std::make_shared<std::vector<int>>(probing_table);
+    result->probing_table_.resize(relation_size, -1);
+    std::copy(record_clusters.begin(), record_clusters.end(), result->probing_table_.begin());
+    return result;
+}
+
+void PositionListsSet::Reserve(size_t num_clusters, size_t num_positions) {
+    positions_.reserve(num_positions);
+    offsets_.reserve(num_clusters + 1);
+    values_.reserve(num_clusters * arity_);
+}
+
+void PositionListsSet::AddCluster(ClusterValue value, Cluster positions) {
+    assert(value.size() == arity_);
+    positions_.insert(positions_.end(), positions.begin(), positions.end());
+    offsets_.push_back(positions_.size());
+    values_.insert(values_.end(), value.begin(), value.end());
 }
 
-std::shared_ptr<PositionListsSet> PositionListsSet::Intersect(PositionListsSet const* that) const {
-    if (this->rows_number_ > that->rows_number_) {
-        return that->Probe(this);
-    } else {
-        return this->Probe(that);
+void PositionListsSet::BuildProbingTable() {
+    probing_table_.assign(relation_size_, -1);
+    for (size_t cluster_id = 0; cluster_id < GetNumCluster(); ++cluster_id) {
+        for (int position : GetCluster(cluster_id)) {
+            probing_table_[position] = static_cast<int>(cluster_id);
+        }
     }
 }
 
-std::shared_ptr<PositionListsSet> PositionListsSet::Probe(PositionListsSet const* that) const {
-    std::shared_ptr<std::vector<int> const> probing_table = that->GetCachedProbingTable();
-    std::vector<ClusterValue> const& cluster_values = that->GetClusterValuesCache();
-    ClusterCollection new_clusters;
-    unsigned int new_size = 0;
+std::shared_ptr<PositionListsSet> PositionListsSet::Intersect(PositionListsSet const& that) const {
+    assert(that.HasProbingTable());
+    auto result = std::make_shared<PositionListsSet>(arity_ + that.arity_, relation_size_);
+    result->Reserve(GetNumCluster(), GetSize());
+
+    // parts of the current cluster: for every cluster of that, the index of its part or -1,
+    // and for every part, its cluster of that and the offset of its end in part_positions
+    std::vector<int> part_ids(that.GetNumCluster(), -1);
+    std::vector<int> part_clusters;
+    std::vector<size_t> part_ends;
+    std::vector<int> part_positions;
+    std::vector<int> value(result->arity_);
 
-    std::unordered_map<int, std::pair<ClusterValue, Cluster>> partial_clusters;
+    for (size_t cluster_id = 0; cluster_id < GetNumCluster(); ++cluster_id) {
+        Cluster const cluster = GetCluster(cluster_id);
+        part_clusters.clear();
+        part_ends.clear();
+        for (int position : cluster) {
+            int const that_cluster = that.probing_table_[position];
+            if (that_cluster == -1) {
+                continue;
+            }
+            int& part_id = part_ids[that_cluster];
+            if (part_id == -1) {
+                part_id = static_cast<int>(part_clusters.size());
+                part_clusters.push_back(that_cluster);
+                part_ends.push_back(0);
+            }
+            ++part_ends[part_id];
+        }
 
-    for (auto const& [value, cluster] : clusters_) {
+        // a stable scatter, so positions stay sorted within every part
+        std::exclusive_scan(part_ends.begin(), part_ends.end(), part_ends.begin(), size_t{0});
+        part_positions.resize(cluster.size());
         for (int position : cluster) {
-            int probing_table_value_id = (*probing_table).at(position);
-            auto partial_cluster = partial_clusters.find(probing_table_value_id);
-            if (partial_cluster != partial_clusters.end()) {
-                auto& [_, positions] = partial_cluster->second;
-                positions.emplace_back(position);
-            } else {
-                ClusterValue key = value;
-                auto& cluster_value = cluster_values[probing_table_value_id];
-                key.insert(key.end(), cluster_value.begin(), cluster_value.end());
-                partial_clusters[probing_table_value_id] = {std::move(key), {position}};
+            int const that_cluster = that.probing_table_[position];
+            if (that_cluster != -1) {
+                part_positions[part_ends[part_ids[that_cluster]]++] = position;
             }
         }
 
-        for (auto& [_, new_cluster] : partial_clusters) {
-            new_size += new_cluster.second.size();
-            new_clusters.emplace(std::move(new_cluster));
+        ClusterValue const cluster_value = GetClusterValue(cluster_id);
+        std::copy(cluster_value.begin(), cluster_value.end(), value.begin());
+        size_t part_begin = 0;
+        for (size_t part = 0; part < part_clusters.size(); ++part) {
+            ClusterValue const that_value = that.GetClusterValue(part_clusters[part]);
+            std::copy(that_value.begin(), that_value.end(), value.begin() + arity_);
+            result->AddCluster(value, {part_positions.data() + part_begin,
+                                       part_positions.data() + part_ends[part]});
+            part_begin = part_ends[part];
+            part_ids[part_clusters[part]] = -1;
         }
-        partial_clusters.clear();
     }
 
-    return std::make_shared<PositionListsSet>(std::move(new_clusters), new_size, relation_size_);
+    return result;
 }
 }  // namespace model
@@ -1,77 +1,78 @@
 #pragma once
+#include <cstddef>
 #include <memory>
-#include <unordered_map>
+#include <span>
 #include <vector>
 
-#include <boost/container_hash/hash.hpp>
-
-template <>
-struct std::hash<std::vector<int>> {
-    std::size_t operator()(std::vector<int> const& vec) const noexcept {
-        return boost::hash_value(vec);
-    }
-};
-
 namespace model {
+/* Clusters of the rows that have equal values in some columns. All clusters are kept in a few
+ * flat buffers: the positions of all clusters one after another, each cluster's positions
+ * sorted, and the values of all clusters one after another, GetArity() values per cluster.
+ */
 class PositionListsSet {
 public:
-    using Cluster = std::vector<int>;
-    using ClusterValue = std::vector<int>;
-    using ClusterCollection = std::unordered_map<ClusterValue, Cluster>;
+    using Cluster = std::span<int const>;
+    using ClusterValue = std::span<int const>;
 
 private:
-    ClusterCollection clusters_;
-    size_t rows_number_;
+    size_t arity_;
     size_t relation_size_;
 
-    std::shared_ptr<std::vector<int> const> probing_table_cache_;
-    std::vector<ClusterValue> cluster_values_cache_;
+    std::vector<int> positions_;
+    /* positions of cluster i are positions_[offsets_[i]] .. positions_[offsets_[i + 1] - 1] */
+    std::vector<size_t> offsets_{0};
+    std::vector<int> values_;
+
+    /* cluster of every row of the relation, -1 for rows in no cluster */
+    std::vector<int> probing_table_;
 
 public:
-    PositionListsSet(ClusterCollection clusters, size_t size, size_t relation_size);
+    PositionListsSet(size_t arity, size_t relation_size) noexcept
+        : arity_(arity), relation_size_(relation_size) {}
 
+    /* Clusters of a single column, with a probing table, so that other sets can be intersected
+     * with it
+     */
     static std::shared_ptr<PositionListsSet> CreateFor(std::vector<int> const& records,
                                                        size_t relation_size);
 
-    static std::shared_ptr<PositionListsSet> CreateFor(
-            std::vector<ClusterCollection::value_type> clusters, size_t relation_size);
+    void Reserve(size_t num_clusters, size_t num_positions);
 
-    // Calculates PT -- heavy operation
-    std::shared_ptr<std::vector<int> const> CalculateAndGetProbingTable();
+    /* Appends a cluster, which must not share rows with the present ones */
+    void AddCluster(ClusterValue value, Cluster positions);
 
-    // Returns cached PT or nullptr, if PT has not been cached yet
-    std::shared_ptr<std::vector<int> const> GetCachedProbingTable() const {
-        return probing_table_cache_;
-    };
+    // Calculates PT -- heavy operation
+    void BuildProbingTable();
 
-    // Calculates PT and cache it
-    void ForceCacheProbingTable() {
-        probing_table_cache_ = CalculateAndGetProbingTable();
-    };
+    bool HasProbingTable() const noexcept {
+        return !probing_table_.empty() || relation_size_ == 0;
+    }
 
-    ClusterCollection const& GetClusters() const noexcept {
-        return clusters_;
-    };
+    size_t GetArity() const noexcept {
+        return arity_;
+    }
 
-    /* If you use this method and change index in any way, all other methods will become invalid */
-    ClusterCollection& GetClusters() noexcept {
-        return clusters_;
+    size_t GetNumCluster() const noexcept {
+        return offsets_.size() - 1;
     }
 
-    unsigned int GetNumCluster() const {
-        return clusters_.size();
+    /* Number of rows in all clusters */
+    size_t GetSize() const noexcept {
+        return positions_.size();
     }
 
-    unsigned int GetSize() const {
-        return rows_number_;
+    Cluster GetCluster(size_t index) const noexcept {
+        return {positions_.data() + offsets_[index], positions_.data() + offsets_[index + 1]};
     }
 
-    std::vector<ClusterValue> const& GetClusterValuesCache() const {
-        return cluster_values_cache_;
+    ClusterValue GetClusterValue(size_t index) const noexcept {
+        return {values_.data() + index * arity_, arity_};
     }
 
-    std::shared_ptr<PositionListsSet> Intersect(PositionListsSet const* that) const;
-    std::shared_ptr<PositionListsSet> Probe(PositionListsSet const* that) const;
+    /* Splits every cluster of this set by the clusters of that set, which must have a probing
+     * table. Values of the new clusters are the values of this set followed by those of that.
+     */
+    std::shared_ptr<PositionListsSet> Intersect(PositionListsSet const& that) const;
 };
 
 using PLSet = PositionListsSet;
@@ -14,6 +14,7 @@
 #include "core/config/option_using.h"
 #include "core/config/tabular_data/input_table/option.h"
 #include "core/model/table/column_layout_typed_relation_data.h"
+#include "core/model/table/dataset.h"
 #include "core/util/logger.h"
 
 namespace algos::dc {
@@ -60,7 +61,7 @@ util::WorkerThreadPool* FastADC::GetThreadPool() {
 
 void FastADC::LoadDataInternal() {
     // kMixed type will be treated as a string type
-    typed_relation_ = model::ColumnLayoutTypedRelationData::CreateFrom(*input_table_, true, true);
+    typed_relation_ = model::LoadTypedRelation(*input_table_, true, true);
 
     if (typed_relation_->GetColumnData().empty()) {
         throw std::runtime_error("Got an empty dataset: DC mining is meaningless.");
@@ -138,6 +139,13 @@ unsigned long long FastADC::ExecuteInternal() {
     evidence_set_builder.BuildEvidenceSet(evidence_aux_structures_builder.GetCorrectionMap(),
                                           evidence_aux_structures_builder.GetCardinalityMask());
 
+    if (ShouldStop()) {
+        LOG_DEBUG("Stopped before the evidence set was inverted");
+        return std::chrono::duration_cast<std::chrono::milliseconds>(
+                       std::chrono::system_clock::now() - start_time)
+                .count();
+    }
+
     LOG_DEBUG("Built evidence set");
     auto elapsed_milliseconds = std::chrono::duration_cast<std::chrono::milliseconds>(
             std::chrono::system_clock::now() - start_time);
@@ -147,7 +155,7 @@ unsigned long long FastADC::ExecuteInternal() {
                                      std::move(evidence_set_builder.evidence_set),
                                      typed_relation_->GetSharedPtrSchema());
 
-    dcs_ = dcbuilder.BuildDenialConstraints();
+    dcs_ = dcbuilder.BuildDenialConstraints(&GetCancellationToken());
 
     PrintResults();
 
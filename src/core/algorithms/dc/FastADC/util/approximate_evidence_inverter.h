@@ -13,6 +13,7 @@
 #include "core/algorithms/dc/FastADC/util/denial_constraint_set.h"
 #include "core/algorithms/dc/FastADC/util/predicate_builder.h"
 #include "core/algorithms/dc/FastADC/util/predicate_organizer.h"
+#include "core/util/cancellation_token.h"
 #include "core/util/logger.h"
 
 namespace algos::fastadc {
@@ -54,13 +55,16 @@ public:
     ApproxEvidenceInverter(ApproxEvidenceInverter&& other) noexcept = default;
     ApproxEvidenceInverter& operator=(ApproxEvidenceInverter&& other) noexcept = default;
 
-    DenialConstraintSet BuildDenialConstraints() {
+    // If the token requests a stop, returns the covers found so far. They are valid DCs, but
+    // some of them may turn out not to be minimal.
+    DenialConstraintSet BuildDenialConstraints(
+            util::CancellationToken const* cancellation_token = nullptr) {
         if (target_ == 0) return {predicate_provider_};
 
         auto cmp = [](Evidence const& o1, Evidence const& o2) { return o1.count > o2.count; };
         std::ranges::sort(evidences_, cmp);
 
-        InverseEvidenceSet();
+        InverseEvidenceSet(cancellation_token);
 
         std::vector<boost::dynamic_bitset<>> raw_dcs;
         approx_covers_.ForEach([this, &raw_dcs](DCCandidate const& transDC) {
@@ -112,7 +116,7 @@ private:
               target(target) {}
     };
 
-    void InverseEvidenceSet() {
+    void InverseEvidenceSet(util::CancellationToken const* cancellation_token) {
         LOG_DEBUG("  [AEI] Inverting evidences...");
 
         approx_covers_ = DCCandidateTrie(n_predicates_);
@@ -126,6 +130,10 @@ private:
         Walk(0, full_mask, std::move(dc_candidates), target_, nodes);
 
         while (!nodes.empty()) {
+            if (cancellation_token != nullptr && cancellation_token->IsStopRequested()) {
+                LOG_DEBUG("  [AEI] Stopped with {} search nodes left", nodes.size());
+                return;
+            }
             SearchNode nd = std::move(nodes.top());
             nodes.pop();
             if (nd.e >= evidences_.size() || nd.addable_predicates.none()) continue;
@@ -2,6 +2,7 @@
 
 #include <ranges>
 #include <stdexcept>
+#include <utility>
 
 #include <boost/algorithm/string.hpp>
 
@@ -16,9 +17,11 @@ namespace mo = model;
 namespace algos::dc {
 
 DCParser::DCParser(std::string dc_string, ColumnLayoutRelationData const* relation,
-                   std::vector<model::TypedColumnData> const& data)
+                   std::vector<model::TypedColumnData> const& data,
+                   model::ColumnProjection projection)
     : relation_(relation),
       data_(data),
+      projection_(std::move(projection)),
       dc_string_(std::move(dc_string)),
       has_next_predicate_(true),
       cur_(0) {
@@ -147,13 +150,15 @@ ColumnOperand DCParser::ConvertToVariableOperand(std::string const& operand) con
 
     Column* column = nullptr;
     if (it == cols.end()) {
+        mo::ColumnIndex source_ind;
         try {
             std::string str_ind = operand.substr(2);
-            size_t ind = static_cast<mo::ColumnIndex>(std::stoi(str_ind));
-            column = cols[ind].get();
+            source_ind = static_cast<mo::ColumnIndex>(std::stoi(str_ind));
         } catch (std::exception const& e) {
             throw std::invalid_argument("Unknown column index or name");
         }
+        size_t ind = projection_.ToLoaded(source_ind);
+        column = cols[ind].get();
     } else {
         column = it->get();
     }
@@ -6,6 +6,7 @@
 #include "core/algorithms/dc/model/operator.h"
 #include "core/algorithms/dc/model/predicate.h"
 #include "core/model/table/column_layout_relation_data.h"
+#include "core/model/table/column_projection.h"
 #include "core/model/table/typed_column_data.h"
 
 namespace algos::dc {
@@ -15,6 +16,8 @@ private:
     std::vector<std::string> str_operators_;
     ColumnLayoutRelationData const* relation_;
     std::vector<model::TypedColumnData> const& data_;
+    /* Columns given by index are numbered as in the original table */
+    model::ColumnProjection projection_;
     static constexpr std::string_view const kSep = " and ";
     std::string dc_string_;
     bool has_next_predicate_;
@@ -23,7 +26,8 @@ private:
 
 public:
     DCParser(std::string dc_string, ColumnLayoutRelationData const* relation,
-             std::vector<model::TypedColumnData> const& data);
+             std::vector<model::TypedColumnData> const& data,
+             model::ColumnProjection projection = {});
 
     DC Parse();
     Predicate GetNextPredicate();
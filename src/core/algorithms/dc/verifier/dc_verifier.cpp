@@ -1,14 +1,15 @@
 #include "core/algorithms/dc/verifier/dc_verifier.h"
 
 #include <algorithm>
+#include <atomic>
 #include <chrono>
 #include <cstddef>
 #include <cstring>
 #include <ctime>
 #include <functional>
 #include <iostream>
+#include <mutex>
 #include <unordered_map>
-#include <unordered_set>
 #include <utility>
 
 #include <boost/algorithm/string.hpp>
@@ -23,8 +24,11 @@
 #include "core/config/names_and_descriptions.h"
 #include "core/config/option_using.h"
 #include "core/config/tabular_data/input_table/option.h"
+#include "core/config/tabular_data/load_columns/option.h"
+#include "core/config/thread_number/option.h"
 #include "core/model/table/column_index.h"
 #include "core/model/table/column_layout_relation_data.h"
+#include "core/model/table/dataset.h"
 #include "core/model/table/typed_column_data.h"
 #include "core/util/get_preallocated_vector.h"
 #include "core/util/kdtree.h"
@@ -35,7 +39,8 @@ namespace algos {
 namespace mo = model;
 
 using Point = dc::Point<dc::Component>;
-using Tree = util::KDTree<Point>;
+using Tree = util::StaticKDTree<Point>;
+using Violations = std::vector<std::pair<size_t, size_t>>;
 
 DCVerifier::DCVerifier() : Algorithm() {
     using namespace config::names;
@@ -47,28 +52,35 @@ DCVerifier::DCVerifier() : Algorithm() {
 void DCVerifier::RegisterOptions() {
     DESBORDANTE_OPTION_USING;
 
+    auto get_table_cols = [this]() { return input_table_->GetNumberOfColumns(); };
+
     RegisterOption(Option<std::string>(&dc_string_, kDenialConstraint, kDDenialConstraint, ""));
-    RegisterOption(config::kTableOpt(&input_table_));
+    RegisterOption(config::kTableOpt(&input_table_).SetConditionalOpts({{{}, {kLoadColumns}}}));
+    RegisterOption(config::kLoadColumnsOpt(&load_columns_, std::move(get_table_cols)));
     RegisterOption(Option<bool>(&do_collect_violations_, kDoCollectViolations,
                                 kDDoCollectViolations, false));
+    RegisterOption(config::kThreadNumberOpt(&threads_));
 }
 
 void DCVerifier::MakeExecuteOptsAvailable() {
     MakeOptionsAvailable({config::names::kDenialConstraint});
     MakeOptionsAvailable({config::names::kDoCollectViolations});
+    MakeOptionsAvailable({config::kThreadNumberOpt.GetName()});
 }
 
 void DCVerifier::LoadDataInternal() {
-    data_ = model::CreateTypedColumnData(*input_table_, true);
-    input_table_->Reset();
-    relation_ = ColumnLayoutRelationData::CreateFrom(*input_table_);
+    projection_ = model::ColumnProjection(*input_table_, load_columns_);
+    config::InputTable table = projection_.Apply(input_table_);
+    data_ = model::CreateTypedColumnData(*table, true);
+    table->Reset();
+    relation_ = model::LoadRelation(*table);
 }
 
 unsigned long long int DCVerifier::ExecuteInternal() {
     auto start = std::chrono::system_clock::now();
     dc::DC dc;
     try {
-        dc::DCParser parser = dc::DCParser(dc_string_, relation_.get(), data_);
+        dc::DCParser parser = dc::DCParser(dc_string_, relation_.get(), data_, projection_);
         dc = parser.Parse();
     } catch (std::exception const& e) {
         LOG_INFO("{}", e.what());
@@ -79,7 +91,9 @@ unsigned long long int DCVerifier::ExecuteInternal() {
     boost::regex re("[0-9]+");
     bool has_header = !boost::regex_match(col_name, re);
     index_offset_ = 1 + static_cast<size_t>(has_header);
+    if (threads_ > 1) pool_.emplace(threads_);
     result_ = Verify(dc);
+    pool_.reset();
 
     auto elapsed_time = std::chrono::duration_cast<std::chrono::milliseconds>(
             std::chrono::system_clock::now() - start);
@@ -103,7 +117,7 @@ bool DCVerifier::Verify(dc::DC dc) {
     }
 
     size_t diseq_preds_count = diseq_preds.size();
-    size_t all_comb_count = std::pow(2, diseq_preds_count);
+    size_t all_comb_count = size_t{1} << diseq_preds_count;
     dc::DCType dc_type = dc.GetType();
 
     // Otherwise it is not possible to collect violations
@@ -112,7 +126,11 @@ bool DCVerifier::Verify(dc::DC dc) {
 
     auto check = kDCTypeToVerificationMethod.At(dc_type);
 
-    // TODO: check the article for optimization 2^l -> 2^(l-1) dc's
+    // Two-tuple verification checks both orders of every pair of rows. Signs with the
+    // highest bit set then give the same violations as their complements
+    if (dc_type == dc::DCType::kTwoTuples and diseq_preds_count > 0 and
+        IsSymmetric(no_diseq_preds, diseq_preds))
+        all_comb_count /= 2;
 
     // Consider 'cur_signs' as a set of operators where each digit
     // in binary representation (0 or 1) means '<' or '>' respectively
@@ -124,9 +142,90 @@ bool DCVerifier::Verify(dc::DC dc) {
         if (!do_collect_violations_ and !res) return false;
     }
 
+    std::sort(violations_.begin(), violations_.end());
+    violations_.erase(std::unique(violations_.begin(), violations_.end()), violations_.end());
     return violations_.empty();
 }
 
+bool DCVerifier::IsSymmetric(std::vector<dc::Predicate> const& no_diseq_preds,
+                             std::vector<dc::Predicate> const& diseq_preds) {
+    auto converse = [](dc::OperatorType type) {
+        switch (type) {
+            case dc::OperatorType::kLess:
+                return dc::OperatorType::kGreater;
+            case dc::OperatorType::kGreater:
+                return dc::OperatorType::kLess;
+            case dc::OperatorType::kLessEqual:
+                return dc::OperatorType::kGreaterEqual;
+            case dc::OperatorType::kGreaterEqual:
+                return dc::OperatorType::kLessEqual;
+            default:
+                return type;
+        }
+    };
+    auto is_same = [](dc::ColumnOperand const& operand, dc::Tuple tuple, Column const* column) {
+        return operand.GetTuple() == tuple and
+               operand.GetColumn()->GetIndex() == column->GetIndex();
+    };
+
+    // s.A != t.A turns into its flipped sign when the tuples are swapped
+    if (!std::ranges::all_of(diseq_preds, &dc::Predicate::IsOneColumn)) return false;
+
+    // The rest of the DC has to stay the same: s.A op t.B turns into t.A op s.B, which is also
+    // written as s.B op' t.A
+    for (dc::Predicate const& pred : no_diseq_preds) {
+        if (!pred.IsCrossTuple()) return false;
+
+        dc::ColumnOperand left = pred.GetLeftOperand();
+        dc::ColumnOperand right = pred.GetRightOperand();
+        dc::OperatorType type = pred.GetOperator().GetType();
+        auto is_swapped = [&](dc::Predicate const& other) {
+            if (!other.IsCrossTuple()) return false;
+            dc::ColumnOperand other_left = other.GetLeftOperand();
+            dc::ColumnOperand other_right = other.GetRightOperand();
+            dc::OperatorType other_type = other.GetOperator().GetType();
+            return (other_type == type and
+                    is_same(other_left, right.GetTuple(), left.GetColumn()) and
+                    is_same(other_right, left.GetTuple(), right.GetColumn())) or
+                   (other_type == converse(type) and
+                    is_same(other_left, left.GetTuple(), right.GetColumn()) and
+                    is_same(other_right, right.GetTuple(), left.GetColumn()));
+        };
+        if (std::ranges::none_of(no_diseq_preds, is_swapped)) return false;
+    }
+
+    return true;
+}
+
+template <typename Process>
+bool DCVerifier::ForEachRow(size_t num_rows, Process process) {
+    std::atomic<bool> stop = false;
+    auto process_block = [&](size_t block, Violations& violations) {
+        size_t last = std::min(num_rows, (block + 1) * kRowsPerTask);
+        for (size_t i = block * kRowsPerTask; i < last; ++i) {
+            if (stop.load(std::memory_order_relaxed)) return;
+            if (!process(i, violations)) stop.store(true, std::memory_order_relaxed);
+        }
+    };
+
+    size_t num_blocks = (num_rows + kRowsPerTask - 1) / kRowsPerTask;
+    if (pool_.has_value() and num_blocks > 1) {
+        std::mutex violations_mutex;
+        pool_->ExecIndexWithResource(process_block, [] { return Violations{}; }, num_blocks,
+                                     [&](Violations violations) {
+                                         std::lock_guard lock(violations_mutex);
+                                         violations_.insert(violations_.end(), violations.begin(),
+                                                            violations.end());
+                                     });
+    } else {
+        for (size_t block = 0; block < num_blocks; ++block) {
+            process_block(block, violations_);
+        }
+    }
+
+    return !stop.load();
+}
+
 dc::DC DCVerifier::GetDC(std::vector<dc::Predicate> const& no_diseq_preds,
                          std::vector<dc::Predicate> const& diseq_preds, size_t cur_signs) {
     size_t diseq_preds_count = diseq_preds.size();
@@ -169,69 +268,58 @@ bool DCVerifier::VerifyMixed(dc::DC const& dc) {
         }
     }
 
-    util::KDTree<Point> s_tree, t_tree;
     std::vector<mo::ColumnIndex> all_cols = dc.GetColumnIndices();
-    std::vector<dc::Predicate> var_preds =
+    dc::DC const var_dc =
             dc.GetPredicates([](dc::Predicate const& pred) { return pred.IsVariable(); });
 
+    // Rows that may play s and t, in one tree each. Every row is paired only with the
+    // rows before it
+    std::vector<size_t> rows;
+    std::vector<Point> s_points, t_points;
     for (size_t i = 0; i < data_.front().GetNumRows(); ++i) {
-        std::unordered_set<Point, Point::Hasher> res_points;
         if (ContainsNullOrEmpty(all_cols, i)) continue;
-        auto process =
-                std::bind(&DCVerifier::ProcessMixed, this, std::placeholders::_1,
-                          std::placeholders::_2, var_preds, all_cols, i, std::ref(res_points));
-
-        std::optional<Point> t_point = process(s_tree, t_predicates);
-        std::optional<Point> s_point = process(t_tree, s_predicates);
-
-        if (do_collect_violations_ == true) {
-            AddHighlights(res_points.begin(), res_points.end(), i + index_offset_);
-        } else if (!res_points.empty()) {
-            return false;
-        }
 
-        if (t_point.has_value()) t_tree.Insert(t_point.value());
-        if (s_point.has_value()) s_tree.Insert(s_point.value());
+        std::vector<std::byte const*> row = GetRow(i);
+        rows.push_back(i);
+        Point point = MakePoint(row, all_cols, i + index_offset_);
+        if (Eval(row, s_predicates)) s_points.push_back(point);
+        if (Eval(row, t_predicates)) t_points.push_back(std::move(point));
     }
+    Tree const s_tree(std::move(s_points)), t_tree(std::move(t_points));
 
-    return violations_.empty();
-}
+    bool completed = ForEachRow(rows.size(), [&](size_t k, Violations& violations) {
+        std::vector<std::byte const*> row = GetRow(rows[k]);
+        size_t cur_ind = rows[k] + index_offset_;
+        auto [box, inv_box] = SearchRanges(all_cols, var_dc, row);
 
-std::optional<Point> DCVerifier::ProcessMixed(
-        Tree const& search_tree, std::vector<dc::Predicate> const& const_preds,
-        dc::DC const& two_tuple_dc, std::vector<mo::ColumnIndex> const& all_cols, size_t i,
-        std::unordered_set<Point, Point::Hasher>& res_points) {
-    std::vector<std::byte const*> row = GetRow(i);
-    auto [box, inv_box] = SearchRanges(all_cols, two_tuple_dc, row);
-
-    std::optional<Point> insert_point;
-    if (Eval(row, const_preds)) {
-        std::vector<Point> search_res = search_tree.QuerySearch(box);
-        res_points.insert(search_res.begin(), search_res.end());
+        auto add_violation = [&](Point const& point) {
+            if (point.GetIndex() >= cur_ind) return true;
+            if (!do_collect_violations_) return false;
+            violations.emplace_back(point.GetIndex(), cur_ind);
+            return true;
+        };
+        if (Eval(row, t_predicates) and !s_tree.ForEachInRange(box, add_violation)) return false;
+        if (Eval(row, s_predicates) and !t_tree.ForEachInRange(box, add_violation)) return false;
+        return true;
+    });
 
-        size_t cur_ind = i + index_offset_;
-        insert_point = MakePoint(row, all_cols, cur_ind);
-    }
-    return insert_point;
+    return completed and violations_.empty();
 }
 
 bool DCVerifier::VerifyOneTuple(dc::DC const& dc) {
     std::vector<Column::IndexType> all_cols = dc.GetColumnIndices();
-    for (size_t i = 0; i < data_.front().GetNumRows(); ++i) {
-        if (ContainsNullOrEmpty(all_cols, i)) continue;
-        std::vector<std::byte const*> tuple = GetRow(i);
-        if (Eval(tuple, dc.GetPredicates())) {
-            size_t cur_ind = i + index_offset_;
-
-            if (do_collect_violations_) {
-                violations_.emplace(cur_ind, cur_ind);
-            } else {
-                return false;
-            }
-        }
-    }
-
-    return violations_.empty();
+    bool completed =
+            ForEachRow(data_.front().GetNumRows(), [&](size_t i, Violations& violations) {
+                if (ContainsNullOrEmpty(all_cols, i)) return true;
+                if (!Eval(GetRow(i), dc.GetPredicates())) return true;
+                if (!do_collect_violations_) return false;
+
+                size_t cur_ind = i + index_offset_;
+                violations.emplace_back(cur_ind, cur_ind);
+                return true;
+            });
+
+    return completed and violations_.empty();
 }
 
 bool DCVerifier::VerifyTwoTuples(dc::DC const& dc) {
@@ -241,38 +329,49 @@ bool DCVerifier::VerifyTwoTuples(dc::DC const& dc) {
     std::vector<mo::ColumnIndex> ineq_cols = dc.GetColumnIndicesWithOperator(
             [](dc::Operator op) { return op.GetType() != dc::OperatorType::kEqual; });
 
-    std::vector<Point> points;
-    std::unordered_map<Point, util::KDTree<Point>, Point::Hasher> hash;
-    std::vector<dc::Predicate> ineq_preds = dc.GetPredicates([](dc::Predicate pred) {
+    dc::DC const ineq_dc = dc.GetPredicates([](dc::Predicate pred) {
         return pred.GetOperator().GetType() != dc::OperatorType::kEqual;
     });
 
+    // Only rows equal on eq_cols can violate the DC, each such group gets its own tree
+    std::unordered_map<Point, size_t, Point::Hasher> group_ids;
+    std::vector<std::vector<Point>> group_points;
+    std::vector<std::pair<size_t, size_t>> rows;
     for (size_t i = 0; i < data_.front().GetNumRows(); ++i) {
         if (ContainsNullOrEmpty(all_cols, i)) continue;
 
         std::vector<std::byte const*> row = GetRow(i);
-        Point point = MakePoint(row, eq_cols);
-        Tree& tree = hash[point];
-        auto [box, inv_box] = SearchRanges(ineq_cols, ineq_preds, row);
-
-        std::unordered_set<Point, Point::Hasher> res_points;
-        std::vector<Point> search_res = tree.QuerySearch(box);
-        std::vector<Point> inv_search_res = tree.QuerySearch(inv_box);
+        auto [it, inserted] = group_ids.try_emplace(MakePoint(row, eq_cols), group_points.size());
+        if (inserted) group_points.emplace_back();
+        group_points[it->second].push_back(MakePoint(row, ineq_cols, i + index_offset_));
+        rows.emplace_back(i, it->second);
+    }
 
-        res_points.insert(search_res.begin(), search_res.end());
-        res_points.insert(inv_search_res.begin(), inv_search_res.end());
+    std::vector<Tree> trees(group_points.size());
+    auto build_tree = [&](size_t group) { trees[group] = Tree(std::move(group_points[group])); };
+    if (pool_.has_value() and trees.size() > 1) {
+        pool_->ExecIndex(build_tree, trees.size());
+    } else {
+        for (size_t group = 0; group < trees.size(); ++group) build_tree(group);
+    }
 
+    // The box of a row holds every row that violates the DC as the left operand of the
+    // predicates against it, so each violating pair is found from its right operand row
+    bool completed = ForEachRow(rows.size(), [&](size_t k, Violations& violations) {
+        auto [i, group] = rows[k];
         size_t cur_ind = i + index_offset_;
-        if (do_collect_violations_ == true) {
-            AddHighlights(res_points.begin(), res_points.end(), cur_ind);
-        } else if (!res_points.empty()) {
-            return false;
-        }
+        auto [box, inv_box] = SearchRanges(ineq_cols, ineq_dc, GetRow(i));
 
-        tree.Insert(MakePoint(row, ineq_cols, cur_ind));
-    }
+        return trees[group].ForEachInRange(box, [&](Point const& point) {
+            size_t ind = point.GetIndex();
+            if (ind == cur_ind) return true;
+            if (!do_collect_violations_) return false;
+            violations.emplace_back(std::min(ind, cur_ind), std::max(ind, cur_ind));
+            return true;
+        });
+    });
 
-    return violations_.empty();
+    return completed and violations_.empty();
 }
 
 bool DCVerifier::VerifyAllEquality(dc::DC const& dc) {
@@ -290,7 +389,7 @@ bool DCVerifier::VerifyAllEquality(dc::DC const& dc) {
 
             std::vector<size_t> viol_indexes = res_tuples[point];
             for (auto ind : viol_indexes) {
-                violations_.emplace(cur_ind, ind);
+                violations_.emplace_back(cur_ind, ind);
             }
             res_tuples[point].push_back(cur_ind);
         } else {
@@ -426,7 +525,8 @@ std::pair<util::Rect<Point>, util::Rect<Point>> DCVerifier::SearchRanges(
     return {box, inv_box};
 }
 
-bool DCVerifier::Eval(std::vector<std::byte const*> row, std::vector<dc::Predicate> preds) const {
+bool DCVerifier::Eval(std::vector<std::byte const*> const& row,
+                      std::vector<dc::Predicate> const& preds) const {
     dc::Component left_comp, right_comp;
     std::byte const* left_val = nullptr;
     std::byte const* right_val;
@@ -3,29 +3,26 @@
 #include <cstddef>
 #include <functional>
 #include <memory>
+#include <optional>
 #include <string>
+#include <utility>
 #include <vector>
 
 #include "core/algorithms/algorithm.h"
 #include "core/algorithms/dc/model/dc.h"
 #include "core/algorithms/dc/model/point.h"
+#include "core/config/indices/type.h"
 #include "core/config/tabular_data/input_table/option.h"
 #include "core/config/tabular_data/input_table_type.h"
+#include "core/config/thread_number/type.h"
 #include "core/model/table/column_layout_relation_data.h"
+#include "core/model/table/column_projection.h"
 #include "core/model/table/typed_column_data.h"
 #include "core/util/kdtree.h"
 #include "core/util/static_map.h"
+#include "core/util/worker_thread_pool.h"
 
 namespace algos {
-namespace dc {
-struct SetComparator {
-    bool operator()(std::pair<size_t, size_t> const& lhs,
-                    std::pair<size_t, size_t> const& rhs) const {
-        return (lhs.first != rhs.first) ? (lhs.first < rhs.first) : (lhs.second < rhs.second);
-    }
-};
-
-}  // namespace dc
 
 class DCVerifier final : public Algorithm {
 private:
@@ -37,14 +34,24 @@ private:
     // If a certain pair contains equal left and right record number
     // it means that that DC is a one-tuple one and it sufficient
     // for a single tuple to violate it. e.g. {{2, 2}}
-    std::set<std::pair<size_t, size_t>, dc::SetComparator> violations_;
-    std::unique_ptr<ColumnLayoutRelationData> relation_;
+    //
+    // Pairs are appended by the verification methods and sorted and
+    // deduplicated once all of them are done.
+    std::vector<std::pair<size_t, size_t>> violations_;
+    std::shared_ptr<ColumnLayoutRelationData const> relation_;
     std::vector<model::TypedColumnData> data_;
     config::InputTable input_table_;
+    config::IndicesType load_columns_;
+    model::ColumnProjection projection_;
     bool do_collect_violations_;
     std::string dc_string_;
     size_t index_offset_;
     bool result_;
+    config::ThreadNumType threads_;
+    std::optional<util::WorkerThreadPool> pool_;
+
+    // Rows are handed to threads in blocks of this size
+    static constexpr size_t kRowsPerTask = 256;
 
     void RegisterOptions();
 
@@ -52,6 +59,18 @@ private:
 
     bool Verify(dc::DC dc);
 
+    // Whether swapping the tuples of every pair maps the DC with signs cur_signs to the DC
+    // with the complementary signs. Then both have the same violations, and only half of
+    // the 2^l sign combinations have to be verified
+    static bool IsSymmetric(std::vector<dc::Predicate> const& no_diseq_preds,
+                            std::vector<dc::Predicate> const& diseq_preds);
+
+    // Calls process(row, violations) for every row in [0, num_rows) on pool_, if there is one.
+    // Each thread collects violations into its own vector, they are appended to violations_
+    // at the end. process returns false to stop all threads early
+    template <typename Process>
+    bool ForEachRow(size_t num_rows, Process process);
+
     bool VerifyOneTuple(dc::DC const& dc);
 
     bool VerifyTwoTuples(dc::DC const& dc);
@@ -64,7 +83,8 @@ private:
 
     std::vector<std::byte const*> GetRow(size_t row) const;
 
-    bool Eval(std::vector<std::byte const*> tuple, std::vector<dc::Predicate> preds) const;
+    bool Eval(std::vector<std::byte const*> const& tuple,
+              std::vector<dc::Predicate> const& preds) const;
 
     bool ContainsNullOrEmpty(std::vector<Column::IndexType> const& indices, size_t tuple_ind) const;
 
@@ -75,12 +95,6 @@ private:
     util::Rect<dc::Point<dc::Component>> SearchMixedRange(dc::DC const& dc, dc::DC const& mixed_dc,
                                                           std::vector<std::byte const*> row);
 
-    std::optional<dc::Point<dc::Component>> ProcessMixed(
-            util::KDTree<dc::Point<dc::Component>> const& search_tree,
-            std::vector<dc::Predicate> const& const_preds, dc::DC const& two_tuple_dc,
-            std::vector<Column::IndexType> const& all_cols, size_t i,
-            std::unordered_set<dc::Point<dc::Component>, dc::Point<dc::Component>::Hasher>&
-                    res_points);
 
     dc::Point<dc::Component> MakePoint(std::vector<std::byte const*> const& vec,
                                        std::vector<Column::IndexType> const& indices,
@@ -98,13 +112,6 @@ private:
                       {dc::DCType::kTwoTuples, &DCVerifier::VerifyTwoTuples},
                       {dc::DCType::kMixed, &DCVerifier::VerifyMixed}}}};
 
-    template <typename InputIt>
-    void AddHighlights(InputIt first, InputIt last, size_t cur_index) {
-        for (; first != last; ++first) {
-            violations_.emplace(first->GetIndex(), cur_index);
-        }
-    }
-
 public:
     DCVerifier();
 
@@ -113,7 +120,7 @@ public:
     }
 
     std::vector<std::pair<size_t, size_t>> GetViolations() {
-        return {violations_.begin(), violations_.end()};
+        return violations_;
     }
 
     void ResetState() final {
@@ -10,6 +10,7 @@
 #include "core/config/names.h"
 #include "core/config/option_using.h"
 #include "core/config/tabular_data/input_table/option.h"
+#include "core/model/table/dataset.h"
 #include "core/model/table/vertical.h"
 #include "core/util/logger.h"
 #include "core/util/timed_invoke.h"
@@ -102,7 +103,7 @@ std::vector<std::pair<std::size_t, std::size_t>> DDVerifier::GetRowsWhereLhsHold
 }
 
 void DDVerifier::LoadDataInternal() {
-    typed_relation_ = model::ColumnLayoutTypedRelationData::CreateFrom(*input_table_, false);
+    typed_relation_ = model::LoadTypedRelation(*input_table_, false);
 }
 
 void DDVerifier::MakeExecuteOptsAvailable() {
@@ -25,7 +25,7 @@ private:
     std::vector<model::ColumnIndex> lhs_column_indices_;
     std::vector<model::ColumnIndex> rhs_column_indices_;
     double error_ = 0.;
-    std::unique_ptr<model::ColumnLayoutTypedRelationData> typed_relation_;
+    std::shared_ptr<model::ColumnLayoutTypedRelationData const> typed_relation_;
     std::vector<Highlight> highlights_;
     std::unordered_map<std::string, std::shared_ptr<Metric>> metrics_;
     void RegisterOptions();
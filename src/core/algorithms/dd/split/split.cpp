@@ -22,6 +22,7 @@
 #include "core/config/option_using.h"
 #include "core/config/tabular_data/input_table/option.h"
 #include "core/model/table/column_index.h"
+#include "core/model/table/dataset.h"
 #include "core/model/types/numeric_type.h"
 #include "core/util/levenshtein_distance.h"
 #include "core/util/logger.h"
@@ -51,8 +52,7 @@ void Split::MakeExecuteOptsAvailable() {
 }
 
 void Split::LoadDataInternal() {
-    typed_relation_ = model::ColumnLayoutTypedRelationData::CreateFrom(*input_table_,
-                                                                       false);  // nulls are ignored
+    typed_relation_ = model::LoadTypedRelation(*input_table_, false);  // nulls are ignored
     if (typed_relation_->GetColumnData().empty()) {
         throw std::runtime_error("Got an empty dataset: DD mining is meaningless.");
     }
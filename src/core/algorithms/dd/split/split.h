@@ -27,7 +27,7 @@ class Split : public Algorithm {
 private:
     config::InputTable input_table_;
 
-    std::shared_ptr<model::ColumnLayoutTypedRelationData> typed_relation_;
+    std::shared_ptr<model::ColumnLayoutTypedRelationData const> typed_relation_;
     unsigned num_rows_;
     model::ColumnIndex num_columns_;
     std::vector<model::ColumnIndex> non_empty_cols_;
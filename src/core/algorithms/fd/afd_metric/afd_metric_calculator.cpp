@@ -10,6 +10,7 @@
 #include "core/config/names.h"
 #include "core/config/option_using.h"
 #include "core/config/tabular_data/input_table/option.h"
+#include "core/model/table/dataset.h"
 #include "core/util/timed_invoke.h"
 
 namespace algos::afd_metric_calculator {
@@ -40,7 +41,7 @@ void AFDMetricCalculator::MakeExecuteOptsAvailable() {
 }
 
 void AFDMetricCalculator::LoadDataInternal() {
-    relation_ = ColumnLayoutRelationData::CreateFrom(*input_table_);
+    relation_ = model::LoadRelation(*input_table_);
 
     if (relation_->GetColumnData().empty()) {
         throw std::runtime_error("Got an empty dataset: AFD metric calculation is meaningless.");
@@ -1,6 +1,11 @@
 #include "core/algorithms/fd/aidfd/aid.h"
 
+#include <memory>
+#include <optional>
+
 #include "core/config/tabular_data/input_table/option.h"
+#include "core/config/thread_number/option.h"
+#include "core/util/worker_thread_pool.h"
 
 namespace algos {
 
@@ -11,6 +16,11 @@ Aid::Aid() : FDAlgorithm() {
 
 void Aid::RegisterOptions() {
     RegisterOption(config::kTableOpt(&input_table_));
+    RegisterOption(config::kThreadNumberOpt(&threads_));
+}
+
+void Aid::MakeExecuteOptsAvailableFDInternal() {
+    MakeOptionsAvailable({config::kThreadNumberOpt.GetName()});
 }
 
 void Aid::LoadDataInternal() {
@@ -26,23 +36,14 @@ void Aid::LoadDataInternal() {
         schema_->AppendColumn(column_name);
     }
 
-    while (input_table_->HasNextRow()) {
-        std::vector<std::string> const& next_line = input_table_->GetNextRow();
-        if (next_line.empty()) {
-            break;
-        }
-
-        tuples_.emplace_back(std::vector<size_t>(number_of_attributes_));
-        for (size_t i = 0; i < number_of_attributes_; ++i) {
-            tuples_.back()[i] = std::hash<std::string>{}(next_line[i]);
-        }
-    }
-    number_of_tuples_ = tuples_.size();
+    tuples_ = model::TupleMatrix::ReadTable(*input_table_);
+    number_of_tuples_ = tuples_.GetNumRows();
     constant_columns_ = boost::dynamic_bitset<>(number_of_attributes_);
 }
 
 void Aid::ResetStateFd() {
-    clusters_.assign(number_of_attributes_, std::unordered_map<size_t, Cluster>{});
+    neg_cover_ = model::ColumnSetList(number_of_attributes_);
+    clusters_.assign(number_of_attributes_, std::vector<Cluster>{});
     indices_in_clusters_.assign(number_of_attributes_, std::vector<size_t>(number_of_tuples_));
     constant_columns_.reset();
     prev_ratios_.assign(kWindowSize, 1.0);
@@ -70,13 +71,13 @@ void Aid::BuildClusters() {
     }
 
     for (size_t attr_num = 0; attr_num < number_of_attributes_; ++attr_num) {
-        std::unordered_map<size_t, Cluster>& column_values = clusters_[attr_num];
-        bool is_constant = true;
-        size_t first_value = tuples_[0][attr_num];
+        std::vector<Cluster>& column_values = clusters_[attr_num];
         for (size_t tuple_num = 0; tuple_num < number_of_tuples_; ++tuple_num) {
-            size_t entry_value = tuples_[tuple_num][attr_num];
-            if (entry_value != first_value) {
-                is_constant = false;
+            // value ids are numbered in the order of first occurrence, so a new one is the
+            // next unused index
+            model::TupleMatrix::ValueId entry_value = tuples_.GetValue(tuple_num, attr_num);
+            if (entry_value == column_values.size()) {
+                column_values.emplace_back();
             }
 
             Cluster& cluster = column_values[entry_value];
@@ -84,7 +85,7 @@ void Aid::BuildClusters() {
             indices_in_clusters_[attr_num][tuple_num] = cluster.size() - 1;
         }
 
-        if (is_constant) {
+        if (column_values.size() == 1) {
             constant_columns_[attr_num] = true;
         }
     }
@@ -104,13 +105,23 @@ bool Aid::IsNegativeCoverGrowthSmall(size_t iteration_num, double curr_ratio) {
 }
 
 void Aid::CreateNegativeCover() {
+    std::optional<util::WorkerThreadPool> pool;
+    if (threads_ > 1) {
+        pool.emplace(threads_);
+    }
+    util::WorkerThreadPool* pool_ptr = pool ? std::addressof(*pool) : nullptr;
+
     size_t prev_neg_cover_size = 0;
+    std::vector<model::TupleMatrix::TuplePair> pairs;
     for (size_t index = 1;; ++index) {
+        pairs.clear();
         for (size_t tuple_num = 0; tuple_num < number_of_tuples_; ++tuple_num) {
-            HandleTuple(tuple_num, index);
+            HandleTuple(tuple_num, index, pairs);
         }
+        neg_cover_.Append(tuples_.GetAgreeSets(pairs, pool_ptr));
+        neg_cover_.SortAndDedup();
 
-        size_t curr_neg_cover_size = neg_cover_.size();
+        size_t curr_neg_cover_size = neg_cover_.Size();
         double curr_ratio;
         if (prev_neg_cover_size == 0) {
             curr_ratio = (curr_neg_cover_size == 0) ? 0.0 : 1.0;
@@ -127,30 +138,18 @@ void Aid::CreateNegativeCover() {
     }
 }
 
-void Aid::HandleTuple(size_t tuple_num, size_t iteration_num) {
+void Aid::HandleTuple(size_t tuple_num, size_t iteration_num,
+                      std::vector<model::TupleMatrix::TuplePair>& pairs) const {
     for (size_t attr_num = 0; attr_num < number_of_attributes_; ++attr_num) {
-        size_t value = tuples_[tuple_num][attr_num];
-        Cluster const& cluster = clusters_[attr_num].at(value);
+        model::TupleMatrix::ValueId value = tuples_.GetValue(tuple_num, attr_num);
+        Cluster const& cluster = clusters_[attr_num][value];
         size_t index_in_cluster = indices_in_clusters_[attr_num][tuple_num];
         if (iteration_num <= index_in_cluster) {
             size_t another_index_in_cluster =
                     GenerateSecondClusterIndex(index_in_cluster, iteration_num);
-            size_t another_tuple_num = cluster[another_index_in_cluster];
-            auto tuples_agree_set = BuildAgreeSet(tuple_num, another_tuple_num);
-            neg_cover_.insert(tuples_agree_set);
-        }
-    }
-}
-
-boost::dynamic_bitset<> Aid::BuildAgreeSet(size_t t1, size_t t2) {
-    boost::dynamic_bitset<> equal_attr(number_of_attributes_);
-    for (size_t attr_num = 0; attr_num < number_of_attributes_; ++attr_num) {
-        if (tuples_[t1][attr_num] == tuples_[t2][attr_num]) {
-            equal_attr.set(attr_num);
+            pairs.emplace_back(tuple_num, cluster[another_index_in_cluster]);
         }
     }
-
-    return equal_attr;
 }
 
 void Aid::HandleConstantColumns(boost::dynamic_bitset<>& attributes) {
@@ -198,7 +197,10 @@ void Aid::InvertNegativeCover() {
     HandleConstantColumns(attributes);
 
     std::vector<boost::dynamic_bitset<>> neg_cover_vector;
-    neg_cover_vector.insert(neg_cover_vector.end(), neg_cover_.begin(), neg_cover_.end());
+    neg_cover_vector.reserve(neg_cover_.Size());
+    for (size_t i = 0; i < neg_cover_.Size(); ++i) {
+        neg_cover_vector.push_back(neg_cover_.GetBitset(i));
+    }
     auto comp_by_card = [](boost::dynamic_bitset<> const& lhs, boost::dynamic_bitset<> const& rhs) {
         return lhs.count() > rhs.count();
     };
@@ -1,16 +1,18 @@
 #pragma once
 
 #include <memory>
-#include <unordered_map>
-#include <unordered_set>
+#include <vector>
 
 #include <boost/dynamic_bitset.hpp>
 
 #include "core/algorithms/fd/aidfd/search_tree.h"
 #include "core/algorithms/fd/fd_algorithm.h"
 #include "core/config/tabular_data/input_table_type.h"
+#include "core/config/thread_number/type.h"
 #include "core/model/table/column.h"
+#include "core/model/table/column_set_list.h"
 #include "core/model/table/relational_schema.h"
+#include "core/model/table/tuple_matrix.h"
 #include "core/model/table/vertical.h"
 
 namespace algos {
@@ -20,14 +22,16 @@ private:
     using Cluster = std::vector<size_t>;
 
     config::InputTable input_table_;
+    config::ThreadNumType threads_ = 1;
 
     std::shared_ptr<RelationalSchema> schema_{};
-    std::vector<std::vector<size_t>> tuples_;
+    model::TupleMatrix tuples_;
 
     size_t number_of_attributes_{};
     size_t number_of_tuples_{};
 
-    std::unordered_set<boost::dynamic_bitset<>> neg_cover_{};
+    // sorted and deduplicated after every iteration of sampling
+    model::ColumnSetList neg_cover_{};
 
     constexpr static double const kGrowthThreshold = 0.01;
     constexpr static size_t const kWindowSize = 10;
@@ -36,12 +40,14 @@ private:
     std::vector<double> prev_ratios_;
     double sum_{};
 
-    std::vector<std::unordered_map<size_t, Cluster>> clusters_;
+    // clusters of a column are indexed by the value ids of the column
+    std::vector<std::vector<Cluster>> clusters_;
     std::vector<std::vector<size_t>> indices_in_clusters_;
 
     boost::dynamic_bitset<> constant_columns_;
 
     void RegisterOptions();
+    void MakeExecuteOptsAvailableFDInternal() final;
 
     void ResetStateFd() final;
 
@@ -52,7 +58,8 @@ private:
     void CreateNegativeCover();
     void InvertNegativeCover();
 
-    void HandleTuple(size_t tuple_num, size_t index);
+    void HandleTuple(size_t tuple_num, size_t index,
+                     std::vector<model::TupleMatrix::TuplePair>& pairs) const;
     void HandleInvalidFd(boost::dynamic_bitset<> const& neg_cover_el, SearchTree& pos_cover_tree,
                          size_t rhs);
     size_t GenerateSecondClusterIndex(size_t index_in_cluster, size_t iteration_num) const;
@@ -66,8 +73,6 @@ private:
     std::vector<size_t> GetAttributesSortedByFrequency(
             std::vector<boost::dynamic_bitset<>> const& neg_cover_vector) const;
 
-    boost::dynamic_bitset<> BuildAgreeSet(size_t t1, size_t t2);
-
 public:
     Aid();
 };
@@ -1,9 +1,14 @@
 #include "core/algorithms/fd/depminer/depminer.h"
 
+#include <algorithm>
 #include <chrono>
 #include <list>
 #include <memory>
 
+#include <boost/asio/post.hpp>
+#include <boost/asio/thread_pool.hpp>
+
+#include "core/config/thread_number/option.h"
 #include "core/model/table/agree_set_factory.h"
 #include "core/model/table/relational_schema.h"
 #include "core/util/logger.h"
@@ -13,15 +18,42 @@ namespace algos {
 using boost::dynamic_bitset, std::make_shared, std::shared_ptr, std::setw, std::vector, std::list,
         std::dynamic_pointer_cast;
 
+Depminer::Depminer() : PliBasedFDAlgorithm() {
+    RegisterOptions();
+}
+
+void Depminer::RegisterOptions() {
+    RegisterOption(config::kThreadNumberOpt(&threads_));
+}
+
+void Depminer::MakeExecuteOptsAvailableFDInternal() {
+    MakeOptionsAvailable({config::kThreadNumberOpt.GetName()});
+}
+
+void Depminer::ForEachColumn(std::function<void(size_t)> const& task) const {
+    size_t const num_columns = schema_->GetNumColumns();
+    if (threads_ > 1 && num_columns > 1) {
+        boost::asio::thread_pool pool(threads_);
+        for (size_t i = 0; i < num_columns; ++i) {
+            boost::asio::post(pool, [&task, i]() { task(i); });
+        }
+        pool.join();
+    } else {
+        for (size_t i = 0; i < num_columns; ++i) {
+            task(i);
+        }
+    }
+}
+
 unsigned long long Depminer::ExecuteInternal() {
     auto const start_time = std::chrono::system_clock::now();
 
     schema_ = relation_->GetSchema();
 
     // Agree sets
-    model::AgreeSetFactory const agree_set_factory =
-            model::AgreeSetFactory(relation_.get(), model::AgreeSetFactory::Configuration());
-    auto const agree_sets = agree_set_factory.GenAgreeSets();
+    model::AgreeSetFactory const agree_set_factory(relation_.get(),
+                                                   model::AgreeSetFactory::Configuration(threads_));
+    model::ColumnSetList const agree_sets = agree_set_factory.GenAgreeSetList();
 
     // maximal sets
     std::vector<CMAXSet> const c_max_cets = GenerateCmaxSets(agree_sets);
@@ -29,9 +61,9 @@ unsigned long long Depminer::ExecuteInternal() {
     // LHS
     auto const lhs_time = std::chrono::system_clock::now();
     // 1
-    for (auto const& column : schema_->GetColumns()) {
-        LhsForColumn(column, c_max_cets);
-    }
+    ForEachColumn([this, &c_max_cets](size_t column_index) {
+        LhsForColumn(schema_->GetColumns()[column_index], c_max_cets);
+    });
 
     auto const lhs_elapsed_milliseconds = std::chrono::duration_cast<std::chrono::milliseconds>(
             std::chrono::system_clock::now() - lhs_time);
@@ -42,54 +74,39 @@ unsigned long long Depminer::ExecuteInternal() {
     return elapsed_milliseconds.count();
 }
 
-std::vector<CMAXSet> Depminer::GenerateCmaxSets(std::unordered_set<Vertical> const& agree_sets) {
+std::vector<CMAXSet> Depminer::GenerateCmaxSets(model::ColumnSetList const& agree_sets) {
     auto const start_time = std::chrono::system_clock::now();
 
     std::vector<CMAXSet> c_max_cets;
-
     for (auto const& column : this->schema_->GetColumns()) {
-        CMAXSet result(*column);
-
-        // finding all sets, which doesn't contain column
-        for (auto const& ag : agree_sets) {
-            if (!ag.Contains(*column)) {
-                result.AddCombination(ag);
-            }
-        }
-
-        // finding max sets
-        std::unordered_set<Vertical> super_sets;
-        std::unordered_set<Vertical> sets_delete;
-        bool to_add = true;
+        c_max_cets.emplace_back(*column);
+    }
 
-        for (auto const& set : result.GetCombinations()) {
-            for (auto const& super_set : super_sets) {
-                if (set.Contains(super_set)) {
-                    sets_delete.insert(super_set);
-                }
-                if (to_add) {
-                    to_add = !super_set.Contains(set);
-                }
-            }
-            for (auto const& to_delete : sets_delete) {
-                super_sets.erase(to_delete);
+    ForEachColumn([this, &agree_sets, &c_max_cets](size_t column_index) {
+        /* Maximal agree sets that do not contain the column. Agree sets are sorted so that
+         * supersets come after their subsets, so, walking them backwards, a set is maximal
+         * iff none of the maximal sets found before it contains it.
+         */
+        std::vector<size_t> max_sets;
+        for (size_t i = agree_sets.Size(); i-- > 0;) {
+            if (agree_sets.Contains(i, column_index)) {
+                continue;
             }
-            if (to_add) {
-                super_sets.insert(set);
-            } else {
-                to_add = true;
+            model::ColumnSetList::Word const* set = agree_sets.GetRow(i);
+            if (std::none_of(max_sets.begin(), max_sets.end(), [&agree_sets, set](size_t j) {
+                    return agree_sets.IsSubset(set, agree_sets.GetRow(j));
+                })) {
+                max_sets.push_back(i);
             }
-            sets_delete.clear();
         }
 
         // Inverting MaxSet
         std::unordered_set<Vertical> result_super_sets;
-        for (auto const& combination : super_sets) {
-            result_super_sets.insert(combination.Invert());
+        for (size_t i : max_sets) {
+            result_super_sets.insert(agree_sets.GetVertical(i, schema_).Invert());
         }
-        result.MakeNewCombinations(std::move(result_super_sets));
-        c_max_cets.push_back(result);
-    }
+        c_max_cets[column_index].MakeNewCombinations(std::move(result_super_sets));
+    });
 
     auto const elapsed_milliseconds = std::chrono::duration_cast<std::chrono::milliseconds>(
             std::chrono::system_clock::now() - start_time);
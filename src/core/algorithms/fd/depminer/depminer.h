@@ -1,11 +1,18 @@
 #pragma once
 
+#include <functional>
+
 #include "core/algorithms/fd/depminer/cmax_set.h"
 #include "core/algorithms/fd/pli_based_fd_algorithm.h"
+#include "core/config/thread_number/type.h"
+#include "core/model/table/column_set_list.h"
 
 namespace algos {
 
 class Depminer : public PliBasedFDAlgorithm {
+public:
+    Depminer();
+
 private:
     static CMAXSet GenFirstLevel(std::vector<CMAXSet> const& cmax_sets, Column const& attribute,
                                  std::unordered_set<Vertical>& level);
@@ -14,9 +21,15 @@ private:
     static bool CheckJoin(Vertical const& _p, Vertical const& _q);
 
     void LhsForColumn(std::unique_ptr<Column> const& column, std::vector<CMAXSet> const& cmax_sets);
-    std::vector<CMAXSet> GenerateCmaxSets(std::unordered_set<Vertical> const& agree_sets);
+    std::vector<CMAXSet> GenerateCmaxSets(model::ColumnSetList const& agree_sets);
+    /* Calls task for every column index, on threads_ threads */
+    void ForEachColumn(std::function<void(size_t)> const& task) const;
+
+    void RegisterOptions();
+    void MakeExecuteOptsAvailableFDInternal() final;
 
     RelationalSchema const* schema_ = nullptr;
+    config::ThreadNumType threads_;
 
     void ResetStateFd() final {}
 
@@ -1,9 +1,12 @@
 #include "core/algorithms/fd/dfd/dfd.h"
 
+#include <algorithm>
+
 #include <boost/asio.hpp>
 
 #include "core/algorithms/fd/dfd/lattice_traversal/lattice_traversal.h"
 #include "core/config/max_lhs/option.h"
+#include "core/config/mem_limit/option.h"
 #include "core/config/thread_number/option.h"
 #include "core/model/table/column_layout_relation_data.h"
 #include "core/model/table/position_list_index.h"
@@ -18,10 +21,12 @@ DFD::DFD() : PliBasedFDAlgorithm() {
 
 void DFD::RegisterOptions() {
     RegisterOption(config::kThreadNumberOpt(&number_of_threads_));
+    RegisterOption(config::kMemLimitMbOpt(&memory_limit_mb_));
 }
 
 void DFD::MakeExecuteOptsAvailableFDInternal() {
-    MakeOptionsAvailable({config::kThreadNumberOpt.GetName()});
+    MakeOptionsAvailable(
+            {config::kThreadNumberOpt.GetName(), config::kMemLimitMbOpt.GetName()});
 }
 
 void DFD::ResetStateFd() {
@@ -29,14 +34,16 @@ void DFD::ResetStateFd() {
 }
 
 unsigned long long DFD::ExecuteInternal() {
-    auto partition_storage = std::make_unique<PartitionStorage>(relation_.get());
+    // the computed PLIs are counted in the arena as well, so a memory budget sees them
+    auto partition_storage = std::make_unique<PartitionStorage>(
+            relation_.get(), static_cast<size_t>(memory_limit_mb_) << 20, GetArena().GetPool());
     RelationalSchema const* const schema = relation_->GetSchema();
 
     auto start_time = std::chrono::system_clock::now();
 
     // search for unique columns
     for (auto const& column : schema->GetColumns()) {
-        ColumnData& column_data = relation_->GetColumnData(column->GetIndex());
+        ColumnData const& column_data = relation_->GetColumnData(column->GetIndex());
         model::PositionListIndex const* const column_pli = column_data.GetPositionListIndex();
 
         if (column_pli->AllValuesAreUnique()) {
@@ -46,10 +53,26 @@ unsigned long long DFD::ExecuteInternal() {
         }
     }
 
+    /* A traversal is a random walk that depends on everything it has observed so far, so it
+     * cannot be split between threads. Traversals for columns with many distinct values tend to
+     * end with larger LHSs and take longest, so they are started first: the pool then finishes
+     * with the short ones instead of leaving a single long traversal running at the end.
+     */
+    auto nep = [this](Column const* column) {
+        return relation_->GetColumnData(column->GetIndex()).GetPositionListIndex()->GetNepAsLong();
+    };
+    std::vector<Column const*> rhss;
+    for (auto const& column : schema->GetColumns()) {
+        rhss.push_back(column.get());
+    }
+    std::stable_sort(rhss.begin(), rhss.end(),
+                     [&nep](Column const* lhs, Column const* rhs) { return nep(lhs) < nep(rhs); });
+
     boost::asio::thread_pool search_space_pool(number_of_threads_);
 
-    for (auto& rhs : schema->GetColumns()) {
-        boost::asio::post(search_space_pool, [this, &rhs, schema, &partition_storage]() {
+    for (Column const* rhs : rhss) {
+        boost::asio::post(search_space_pool, [this, rhs, schema, &partition_storage]() {
+            if (ShouldStop()) return;
             ColumnData const& rhs_data = relation_->GetColumnData(rhs->GetIndex());
             model::PositionListIndex const* const rhs_pli = rhs_data.GetPositionListIndex();
 
@@ -62,9 +85,9 @@ unsigned long long DFD::ExecuteInternal() {
                 return;
             }
 
-            auto search_space = LatticeTraversal(rhs.get(), relation_.get(), unique_columns_,
+            auto search_space = LatticeTraversal(rhs, relation_.get(), unique_columns_,
                                                  partition_storage.get());
-            auto const minimal_deps = search_space.FindLHSs();
+            auto const minimal_deps = search_space.FindLHSs(&GetCancellationToken());
 
             for (auto const& minimal_dependency_lhs : minimal_deps) {
                 RegisterFd(minimal_dependency_lhs, *rhs, relation_->GetSharedPtrSchema());
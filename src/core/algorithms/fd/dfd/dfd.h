@@ -5,6 +5,7 @@
 
 #include "core/algorithms/fd/dfd/partition_storage/partition_storage.h"
 #include "core/algorithms/fd/pli_based_fd_algorithm.h"
+#include "core/config/mem_limit/type.h"
 #include "core/config/thread_number/type.h"
 #include "core/model/table/vertical.h"
 
@@ -15,6 +16,8 @@ private:
     std::vector<Vertical> unique_columns_;
 
     config::ThreadNumType number_of_threads_;
+    /* Bounds the cached PLIs of column combinations */
+    config::MemLimitMBType memory_limit_mb_;
 
     void MakeExecuteOptsAvailableFDInternal() final;
     void RegisterOptions();
@@ -17,7 +17,8 @@ LatticeTraversal::LatticeTraversal(Column const* const rhs,
       partition_storage_(partition_storage),
       gen_(rd_()) {}
 
-std::unordered_set<Vertical> LatticeTraversal::FindLHSs() {
+std::unordered_set<Vertical> LatticeTraversal::FindLHSs(
+        util::CancellationToken const* cancellation_token) {
     RelationalSchema const* const schema = relation_->GetSchema();
 
     // processing of found unique columns
@@ -52,6 +53,9 @@ std::unordered_set<Vertical> LatticeTraversal::FindLHSs() {
             }
 
             do {
+                if (cancellation_token != nullptr && cancellation_token->IsStopRequested()) {
+                    return minimal_deps_;
+                }
                 auto const node_observation_iter = observations_.find(node);
 
                 if (node_observation_iter != observations_.end()) {
@@ -71,22 +75,12 @@ std::unordered_set<Vertical> LatticeTraversal::FindLHSs() {
                     }
                 } else if (!InferCategory(node, rhs_->GetIndex())) {
                     // if we were not able to infer category, we calculate the partitions
-                    auto node_pli = partition_storage_->GetOrCreateFor(node);
-                    auto node_pli_pointer =
-                            std::holds_alternative<model::PositionListIndex*>(node_pli)
-                                    ? std::get<model::PositionListIndex*>(node_pli)
-                                    : std::get<std::unique_ptr<model::PositionListIndex>>(node_pli)
-                                              .get();
-                    auto intersected_pli = partition_storage_->GetOrCreateFor(node.Union(*rhs_));
-                    auto intersected_pli_pointer =
-                            std::holds_alternative<model::PositionListIndex*>(intersected_pli)
-                                    ? std::get<model::PositionListIndex*>(intersected_pli)
-                                    : std::get<std::unique_ptr<model::PositionListIndex>>(
-                                              intersected_pli)
-                                              .get();
-
-                    if (node_pli_pointer->GetNepAsLong() ==
-                        intersected_pli_pointer->GetNepAsLong()) {
+                    PartitionStorage::PliPtr const node_pli =
+                            partition_storage_->GetOrCreateFor(node);
+                    PartitionStorage::PliPtr const intersected_pli =
+                            partition_storage_->GetOrCreateFor(node.Union(*rhs_));
+
+                    if (node_pli->GetNepAsLong() == intersected_pli->GetNepAsLong()) {
                         observations_.UpdateDependencyCategory(node);
                         if (observations_[node] == NodeCategory::kMinimalDependency) {
                             minimal_deps_.insert(node);
@@ -9,6 +9,7 @@
 #include "core/algorithms/fd/dfd/pruning_maps/dependencies_map.h"
 #include "core/algorithms/fd/dfd/pruning_maps/non_dependencies_map.h"
 #include "core/model/table/vertical.h"
+#include "core/util/cancellation_token.h"
 
 class LatticeTraversal {
 private:
@@ -43,5 +44,7 @@ public:
                      std::vector<Vertical> const& unique_verticals,
                      PartitionStorage* const partition_storage);
 
-    std::unordered_set<Vertical> FindLHSs();
+    /* If stopped early, returns the minimal LHSs confirmed so far */
+    std::unordered_set<Vertical> FindLHSs(
+            util::CancellationToken const* cancellation_token = nullptr);
 };
@@ -1,50 +1,109 @@
 #include "core/algorithms/fd/dfd/partition_storage/partition_storage.h"
 
-#include <boost/format.hpp>
+#include <algorithm>
+#include <cassert>
+#include <exception>
+#include <stdexcept>
+#include <tuple>
+#include <vector>
+
 #include <boost/optional.hpp>
 
-#include "core/model/table/vertical_map.h"
 #include "core/util/logger.h"
 
-model::PositionListIndex* PartitionStorage::Get(Vertical const& vertical) {
-    return index_->Get(vertical).get();
-}
-
-PartitionStorage::PartitionStorage(ColumnLayoutRelationData* relation_data)
+PartitionStorage::PartitionStorage(ColumnLayoutRelationData const* relation_data, size_t max_bytes,
+                                   std::pmr::memory_resource* resource)
     : relation_data_(relation_data),
-      index_(std::make_unique<model::BlockingVerticalMap<model::PositionListIndex>>(
-              relation_data->GetSchema())) {
+      counting_(resource),
+      index_(std::make_unique<model::BlockingVerticalMap<model::PositionListIndex const>>(
+              relation_data->GetSchema())),
+      max_bytes_(max_bytes) {
     for (auto& column_ptr : relation_data->GetSchema()->GetColumns()) {
         index_->Put(static_cast<Vertical>(*column_ptr),
                     relation_data->GetColumnData(column_ptr->GetIndex()).GetPliOwnership());
     }
 }
 
-PartitionStorage::~PartitionStorage() {}
+size_t PartitionStorage::EstimateBytes(model::PositionListIndex const& pli) {
+    return sizeof(model::PositionListIndex) +
+           pli.GetNumNonSingletonCluster() * sizeof(model::PositionListIndex::Cluster) +
+           pli.GetSize() * sizeof(int);
+}
+
+PartitionStorage::Shard& PartitionStorage::GetShard(Vertical const& vertical) {
+    return shards_[std::hash<Vertical>{}(vertical) % kNumShards];
+}
+
+PartitionStorage::PliPtr PartitionStorage::Get(Vertical const& vertical) const {
+    return index_->Get(vertical);
+}
 
 // obtains or calculates a PositionListIndex using cache
-std::variant<model::PositionListIndex*, std::unique_ptr<model::PositionListIndex>>
-PartitionStorage::GetOrCreateFor(Vertical const& vertical) {
-    std::scoped_lock lock(getting_pli_mutex_);
+PartitionStorage::PliPtr PartitionStorage::GetOrCreateFor(Vertical const& vertical) {
     LOG_DEBUG("PLI for {} requested: ", vertical.ToString());
+    if (vertical.GetArity() == 1) {
+        return Get(vertical);
+    }
 
-    // is PLI already cached?
-    model::PositionListIndex* pli = Get(vertical);
-    if (pli != nullptr) {
-        pli->IncFreq();
+    Shard& shard = GetShard(vertical);
+    std::promise<PliPtr> promise;
+    std::shared_future<PliPtr> cached;
+    {
+        std::scoped_lock lock(shard.mutex);
+        auto [it, inserted] = shard.entries.try_emplace(vertical);
+        if (inserted) {
+            it->second.pli = promise.get_future().share();
+        } else {
+            ++it->second.uses;
+            cached = it->second.pli;
+        }
+    }
+    if (cached.valid()) {
+        // either cached or being calculated by another traversal
         LOG_DEBUG("Served from PLI cache.");
-        // addToUsageCounter
-        return pli;
+        return cached.get();
     }
+
+    std::shared_ptr<model::PositionListIndex> pli;
+    try {
+        pli = Calculate(vertical);
+    } catch (...) {
+        {
+            std::scoped_lock lock(shard.mutex);
+            shard.entries.erase(vertical);
+        }
+        promise.set_exception(std::current_exception());
+        throw;
+    }
+
+    size_t const bytes = EstimateBytes(*pli);
+    bool over_budget = false;
+    {
+        std::scoped_lock lock(shard.mutex);
+        if (bytes > max_bytes_) {
+            shard.entries.erase(vertical);
+        } else {
+            // a nonzero size makes the entry evictable
+            shard.entries.at(vertical).bytes = bytes;
+            index_->Put(vertical, pli);
+            over_budget = counting_.GetBytes() > max_bytes_;
+        }
+    }
+    promise.set_value(pli);
+    if (over_budget) {
+        Evict();
+    }
+    return pli;
+}
+
+std::shared_ptr<model::PositionListIndex> PartitionStorage::Calculate(Vertical const& vertical) {
     // look for cached PLIs to construct the requested one
     auto subset_entries = index_->GetSubsetEntries(vertical);
     boost::optional<PositionListIndexRank> smallest_pli_rank;
     std::vector<PositionListIndexRank> ranks;
     ranks.reserve(subset_entries.size());
     for (auto& [sub_vertical, sub_pli_ptr] : subset_entries) {
-        PositionListIndexRank pli_rank(
-                &sub_vertical, std::const_pointer_cast<model::PositionListIndex>(sub_pli_ptr),
-                sub_vertical.GetArity());
+        PositionListIndexRank pli_rank(&sub_vertical, sub_pli_ptr, sub_vertical.GetArity());
         ranks.push_back(pli_rank);
         if (!smallest_pli_rank || smallest_pli_rank->pli_->GetSize() > pli_rank.pli_->GetSize() ||
             (smallest_pli_rank->pli_->GetSize() == pli_rank.pli_->GetSize() &&
@@ -52,13 +111,13 @@ PartitionStorage::GetOrCreateFor(Vertical const& vertical) {
             smallest_pli_rank = pli_rank;
         }
     }
-    assert(smallest_pli_rank);  // check if smallest_pli_rank is initialized
+    assert(smallest_pli_rank);  // column PLIs are never evicted
 
     std::vector<PositionListIndexRank> operands;
     boost::dynamic_bitset<> cover(relation_data_->GetNumColumns());
     boost::dynamic_bitset<> cover_tester(relation_data_->GetNumColumns());
     if (smallest_pli_rank) {
-        smallest_pli_rank->pli_->IncFreq();
+        Touch(*smallest_pli_rank->vertical_);
         operands.push_back(*smallest_pli_rank);
         cover |= smallest_pli_rank->vertical_->GetColumnIndices();
 
@@ -84,7 +143,7 @@ PartitionStorage::GetOrCreateFor(Vertical const& vertical) {
             }
 
             if (best_rank) {
-                best_rank->pli_->IncFreq();
+                Touch(*best_rank->vertical_);
                 operands.push_back(*best_rank);
                 cover |= best_rank->vertical_->GetColumnIndices();
             }
@@ -96,62 +155,127 @@ PartitionStorage::GetOrCreateFor(Vertical const& vertical) {
     for (auto& column : vertical.GetColumns()) {
         if (!cover[column->GetIndex()]) {
             vertical_columns.push_back(std::make_unique<Vertical>(static_cast<Vertical>(*column)));
-            auto column_pli = index_->Get(**vertical_columns.rbegin());
-            operands.emplace_back(vertical_columns.rbegin()->get(), column_pli, 1);
-            column_pli->IncFreq();
+            operands.emplace_back(vertical_columns.back().get(), Get(*vertical_columns.back()), 1);
         }
     }
     // sort operands by ascending order
     std::sort(operands.begin(), operands.end(),
               [](auto& el1, auto& el2) { return el1.pli_->GetSize() < el2.pli_->GetSize(); });
 
-    LOG_DEBUG("Intersecting [UNIMPLEMENTED]");
-
-    if (operands.empty()) {
-        throw std::logic_error("Current implementation assumes operands.size() > 0");
+    if (operands.size() < 2) {
+        throw std::logic_error("A PLI that is not cached must be built from several operands");
     }
 
     // Intersect and cache
-    std::variant<model::PositionListIndex*, std::unique_ptr<model::PositionListIndex>>
-            variant_intersection_pli;
+    std::shared_ptr<model::PositionListIndex> intersection_pli;
     if (operands.size() >= 4) {
-        PositionListIndexRank base_pli_rank = operands[0];
-        auto intersection_pli = base_pli_rank.pli_->ProbeAll(
-                vertical.Without(*base_pli_rank.vertical_), *relation_data_);
-        variant_intersection_pli = CachingProcess(vertical, std::move(intersection_pli));
+        PositionListIndexRank const& base_pli_rank = operands[0];
+        intersection_pli = base_pli_rank.pli_->ProbeAll(vertical.Without(*base_pli_rank.vertical_),
+                                                        *relation_data_, &counting_);
     } else {
-        Vertical current_vertical = *operands.begin()->vertical_;
-        variant_intersection_pli = operands.begin()->pli_.get();
+        Vertical current_vertical = *operands.front().vertical_;
+        model::PositionListIndex const* current_pli = operands.front().pli_.get();
 
         for (size_t i = 1; i < operands.size(); i++) {
             current_vertical = current_vertical.Union(*operands[i].vertical_);
-            variant_intersection_pli =
-                    std::holds_alternative<model::PositionListIndex*>(variant_intersection_pli)
-                            ? std::get<model::PositionListIndex*>(variant_intersection_pli)
-                                      ->Intersect(operands[i].pli_.get())
-                            : std::get<std::unique_ptr<model::PositionListIndex>>(
-                                      variant_intersection_pli)
-                                      ->Intersect(operands[i].pli_.get());
-            variant_intersection_pli = CachingProcess(
-                    current_vertical, std::move(std::get<std::unique_ptr<model::PositionListIndex>>(
-                                              variant_intersection_pli)));
+            intersection_pli = current_pli->Intersect(operands[i].pli_.get(), &counting_);
+            current_pli = intersection_pli.get();
+            if (i + 1 < operands.size()) {
+                CacheIntermediate(current_vertical, intersection_pli);
+            }
         }
     }
 
     LOG_DEBUG("Calculated from {} sub-PLIs (saved {} intersections).", operands.size(),
               (vertical.GetArity() - operands.size()));
 
-    return variant_intersection_pli;
+    return intersection_pli;
+}
+
+void PartitionStorage::Touch(Vertical const& vertical) {
+    if (vertical.GetArity() == 1) {
+        return;
+    }
+    Shard& shard = GetShard(vertical);
+    std::scoped_lock lock(shard.mutex);
+    if (auto it = shard.entries.find(vertical); it != shard.entries.end()) {
+        ++it->second.uses;
+    }
+}
+
+void PartitionStorage::CacheIntermediate(Vertical const& vertical,
+                                         std::shared_ptr<model::PositionListIndex> pli) {
+    size_t const bytes = EstimateBytes(*pli);
+    if (bytes > max_bytes_) {
+        return;
+    }
+    Shard& shard = GetShard(vertical);
+    bool over_budget = false;
+    {
+        std::scoped_lock lock(shard.mutex);
+        auto [it, inserted] = shard.entries.try_emplace(vertical);
+        if (!inserted) {
+            return;
+        }
+        std::promise<PliPtr> promise;
+        promise.set_value(pli);
+        it->second.pli = promise.get_future().share();
+        it->second.bytes = bytes;
+        index_->Put(vertical, std::move(pli));
+        over_budget = counting_.GetBytes() > max_bytes_;
+    }
+    if (over_budget) {
+        Evict();
+    }
+}
+
+void PartitionStorage::Evict() {
+    std::scoped_lock eviction_lock(eviction_mutex_);
+    if (counting_.GetBytes() <= max_bytes_) {
+        // evicted by another thread meanwhile
+        return;
+    }
+    std::vector<std::tuple<unsigned, size_t, Vertical>> candidates;
+    for (Shard& shard : shards_) {
+        std::scoped_lock lock(shard.mutex);
+        for (auto const& [vertical, entry] : shard.entries) {
+            if (entry.bytes != 0) {
+                candidates.emplace_back(entry.uses, entry.bytes, vertical);
+            }
+        }
+    }
+    // least used first, larger ones first among equally used
+    std::sort(candidates.begin(), candidates.end(), [](auto const& lhs, auto const& rhs) {
+        return std::get<0>(lhs) < std::get<0>(rhs) ||
+               (std::get<0>(lhs) == std::get<0>(rhs) && std::get<1>(lhs) > std::get<1>(rhs));
+    });
+
+    // free a quarter of the budget, so that eviction does not run on every insertion
+    size_t const target_bytes = max_bytes_ / 4 * 3;
+    size_t num_evicted = 0;
+    /* A single pass: PLIs used by traversals stay counted until they are done with them, so the
+     * target may be out of reach for now. PLIs cached meanwhile evict on their own */
+    for (auto const& [uses, bytes, vertical] : candidates) {
+        if (counting_.GetBytes() <= target_bytes) {
+            break;
+        }
+        Shard& shard = GetShard(vertical);
+        std::scoped_lock lock(shard.mutex);
+        auto it = shard.entries.find(vertical);
+        if (it == shard.entries.end() || it->second.bytes == 0) {
+            continue;
+        }
+        index_->Remove(vertical);
+        shard.entries.erase(it);
+        ++num_evicted;
+    }
+    LOG_DEBUG("Evicted {} PLIs, {} bytes are taken by PLIs.", num_evicted, counting_.GetBytes());
 }
 
 size_t PartitionStorage::Size() const {
     return index_->GetSize();
 }
 
-std::variant<model::PositionListIndex*, std::unique_ptr<model::PositionListIndex>>
-PartitionStorage::CachingProcess(Vertical const& vertical,
-                                 std::unique_ptr<model::PositionListIndex> pli) {
-    auto pli_pointer = pli.get();
-    index_->Put(vertical, std::move(pli));
-    return pli_pointer;
+size_t PartitionStorage::GetUsedBytes() const {
+    return counting_.GetBytes();
 }
@@ -1,39 +1,87 @@
 #pragma once
 
+#include <array>
+#include <cstddef>
+#include <future>
+#include <memory>
+#include <memory_resource>
 #include <mutex>
+#include <unordered_map>
 
 #include "core/model/table/column_layout_relation_data.h"
+#include "core/model/table/position_list_index.h"
+#include "core/model/table/vertical.h"
 #include "core/model/table/vertical_map.h"
+#include "core/util/arena.h"
 
+/* PLI cache shared by the lattice traversals of all RHSs.
+ * Entries are spread over shards by vertical, so requests for different verticals rarely wait
+ * for each other. A missing PLI is computed once: the first thread that requests it computes
+ * it, and the ones that request it meanwhile wait for that result. PLIs of single columns are
+ * always kept. The clusters of the computed PLIs are taken from the given memory resource and
+ * counted. When they take more than the byte budget, the cached ones are evicted, least used
+ * first. PLIs are handed out as shared pointers, so an evicted PLI stays alive and counted while
+ * a traversal still uses it.
+ */
 class PartitionStorage {
+public:
+    using PliPtr = std::shared_ptr<model::PositionListIndex const>;
+
 private:
     class PositionListIndexRank {
     public:
         Vertical const* vertical_;
-        std::shared_ptr<model::PositionListIndex> pli_;
+        PliPtr pli_;
         int added_arity_;
 
-        PositionListIndexRank(Vertical const* vertical,
-                              std::shared_ptr<model::PositionListIndex> pli, int initial_arity)
-            : vertical_(vertical), pli_(pli), added_arity_(initial_arity) {}
+        PositionListIndexRank(Vertical const* vertical, PliPtr pli, int initial_arity)
+            : vertical_(vertical), pli_(std::move(pli)), added_arity_(initial_arity) {}
     };
 
-    ColumnLayoutRelationData* relation_data_;
-    std::unique_ptr<model::VerticalMap<model::PositionListIndex>> index_;
+    struct Entry {
+        std::shared_future<PliPtr> pli;
+        /* Estimated size of the cached PLI, zero while it is being computed */
+        size_t bytes = 0;
+        unsigned uses = 1;
+    };
+
+    struct Shard {
+        std::mutex mutex;
+        std::unordered_map<Vertical, Entry> entries;
+    };
 
-    mutable std::mutex getting_pli_mutex_;
+    static constexpr size_t kNumShards = 64;
 
-    std::variant<model::PositionListIndex*, std::unique_ptr<model::PositionListIndex>>
-    CachingProcess(Vertical const& vertical, std::unique_ptr<model::PositionListIndex> pli);
+    ColumnLayoutRelationData const* relation_data_;
+    /* Declared before the cached PLIs, which give their clusters back to it */
+    util::CountingResource counting_;
+    /* Holds the PLIs of single columns and of ready entries. Used to find the cached PLIs a
+     * missing one can be intersected from */
+    std::unique_ptr<model::BlockingVerticalMap<model::PositionListIndex const>> index_;
+    std::array<Shard, kNumShards> shards_;
+
+    size_t const max_bytes_;
+    std::mutex eviction_mutex_;
+
+    static size_t EstimateBytes(model::PositionListIndex const& pli);
+
+    Shard& GetShard(Vertical const& vertical);
+    std::shared_ptr<model::PositionListIndex> Calculate(Vertical const& vertical);
+    /* Marks the entry of vertical as used, which lowers its chance to be evicted */
+    void Touch(Vertical const& vertical);
+    /* Caches a PLI that was computed on the way to another one, unless vertical already has an
+     * entry */
+    void CacheIntermediate(Vertical const& vertical, std::shared_ptr<model::PositionListIndex> pli);
+    void Evict();
 
 public:
-    PartitionStorage(ColumnLayoutRelationData* relation_data);
+    PartitionStorage(ColumnLayoutRelationData const* relation_data, size_t max_bytes,
+                     std::pmr::memory_resource* resource = std::pmr::get_default_resource());
 
-    model::PositionListIndex* Get(Vertical const& vertical);
-    std::variant<model::PositionListIndex*, std::unique_ptr<model::PositionListIndex>>
-    GetOrCreateFor(Vertical const& vertical);
+    PliPtr Get(Vertical const& vertical) const;
+    PliPtr GetOrCreateFor(Vertical const& vertical);
 
     size_t Size() const;
-
-    virtual ~PartitionStorage();
+    /* Bytes taken by the clusters of the computed PLIs that are alive, cached or not */
+    size_t GetUsedBytes() const;
 };
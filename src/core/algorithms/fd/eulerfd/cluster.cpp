@@ -32,9 +32,12 @@ double Cluster::Sample(RegisterTuplesFunction const& handle_tuples) {
     window_++;
 
     int64_t barrier = static_cast<int64_t>(cluster_data_.size()) - static_cast<int64_t>(window_);
+    std::vector<TuplePair> pairs;
+    pairs.reserve(std::max<int64_t>(barrier, 0));
     for (int64_t i = 0; i < barrier; i++) {
-        new_non_fds_ += handle_tuples(cluster_data_[i], cluster_data_[i + window_]);
+        pairs.emplace_back(cluster_data_[i], cluster_data_[i + window_]);
     }
+    new_non_fds_ = handle_tuples(pairs);
     new_tuples_pairs_ = cluster_data_.size() - window_;
 
     double cur_eff =
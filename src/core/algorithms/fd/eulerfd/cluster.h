@@ -2,13 +2,16 @@
 #include <array>
 #include <functional>
 #include <numeric>
+#include <utility>
 #include <vector>
 
 namespace algos {
 
 class Cluster {
 public:
-    using RegisterTuplesFunction = std::function<size_t(size_t, size_t)>;
+    using TuplePair = std::pair<size_t, size_t>;
+    // Gets all pairs of tuples compared by a sample, returns the number of new non-FDs they gave
+    using RegisterTuplesFunction = std::function<size_t(std::vector<TuplePair> const&)>;
     using RandomStrategy = std::function<int()>;
 
 private:
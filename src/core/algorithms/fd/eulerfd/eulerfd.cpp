@@ -1,11 +1,14 @@
 #include "core/algorithms/fd/eulerfd/eulerfd.h"
 
+#include "core/config/thread_number/option.h"
+
 namespace algos {
 
 EulerFD::EulerFD() : FDAlgorithm(), mlfq_(kQueuesNumber) {
     last_ncover_ratios_.fill(1);
     last_pcover_ratios_.fill(1);
     RegisterOption(config::kCustomRandomFlagOpt(&custom_random_opt_));
+    RegisterOption(config::kThreadNumberOpt(&threads_));
 
     // Set configuration options
     RegisterOption(config::kTableOpt(&input_table_));
@@ -16,7 +19,8 @@ EulerFD::EulerFD() : FDAlgorithm(), mlfq_(kQueuesNumber) {
 }
 
 void EulerFD::MakeExecuteOptsAvailable() {
-    MakeOptionsAvailable({config::kCustomRandomFlagOpt.GetName()});
+    MakeOptionsAvailable(
+            {config::kCustomRandomFlagOpt.GetName(), config::kThreadNumberOpt.GetName()});
 }
 
 void EulerFD::LoadDataInternal() {
@@ -34,30 +38,8 @@ void EulerFD::LoadDataInternal() {
 
     // In each column mapping string values into integer values.
     // Using only hash isn't good idea because collisions don't processing.
-    std::vector<std::unordered_map<std::string, size_t>> columns(number_of_attributes_);
-    std::vector<size_t> current_id(number_of_attributes_, 0);
-
-    while (input_table_->HasNextRow()) {
-        std::vector<std::string> line = input_table_->GetNextRow();
-        if (line.empty()) {
-            break;
-        }
-
-        tuples_.emplace_back(std::vector<size_t>(number_of_attributes_));
-        auto& current_tuple = tuples_.back();
-        for (size_t i = 0; i < number_of_attributes_; i++) {
-            auto& values = columns[i];
-            auto it = values.find(line[i]);
-            if (it != values.end()) {
-                current_tuple[i] = it->second;
-            } else {
-                size_t id = current_id[i]++;
-                values[std::move(line[i])] = id;
-                current_tuple[i] = id;
-            }
-        }
-    }
-    number_of_tuples_ = tuples_.size();
+    tuples_ = model::TupleMatrix::ReadTable(*input_table_);
+    number_of_tuples_ = tuples_.GetNumRows();
 }
 
 void EulerFD::ResetStateFd() {
@@ -140,7 +122,7 @@ void EulerFD::BuildPartition() {
     for (size_t attr_num = 0; attr_num < number_of_attributes_; attr_num++) {
         std::unordered_map<size_t, std::vector<size_t>> values;
         for (size_t tuple_num = 0; tuple_num < number_of_tuples_; tuple_num++) {
-            auto value = tuples_[tuple_num][attr_num];
+            size_t value = tuples_.GetValue(tuple_num, attr_num);
             auto& similar_values = values[value];
             similar_values.push_back(tuple_num);
         }
@@ -161,28 +143,23 @@ void EulerFD::BuildPartition() {
     }
 }
 
-EulerFD::Bitset EulerFD::BuildAgreeSet(size_t t1, size_t t2) const {
-    Bitset equal_attr(number_of_attributes_);
-    for (size_t attr_num = 0; attr_num < number_of_attributes_; ++attr_num) {
-        if (tuples_[t1][attr_num] == tuples_[t2][attr_num]) {
-            equal_attr.set(attr_num);
-        }
-    }
-    return equal_attr;
-}
-
 double EulerFD::SamplingInCluster(Cluster* cluster) {
-    return cluster->Sample([this](size_t t1, size_t t2) -> size_t {
-        Bitset agree_set = BuildAgreeSet(t1, t2);
-        auto&& [_, result] = invalids_.insert(agree_set);
-
-        // Check that this is a new FD
-        if (result) {
-            new_invalids_.insert(agree_set);
-            return agree_set.size() - agree_set.count();
-        } else {
-            return 0;
+    return cluster->Sample([this](std::vector<Cluster::TuplePair> const& pairs) -> size_t {
+        // Agree sets are computed in parallel, but registered in the order of the pairs
+        model::ColumnSetList const agree_sets =
+                tuples_.GetAgreeSets(pairs, pool_ ? std::addressof(*pool_) : nullptr);
+        size_t new_non_fds = 0;
+        for (size_t i = 0; i < agree_sets.Size(); ++i) {
+            Bitset agree_set = agree_sets.GetBitset(i);
+            auto&& [_, result] = invalids_.insert(agree_set);
+
+            // Check that this is a new FD
+            if (result) {
+                new_non_fds += agree_set.size() - agree_set.count();
+                new_invalids_.insert(std::move(agree_set));
+            }
         }
+        return new_non_fds;
     });
 }
 
@@ -396,6 +373,7 @@ unsigned long long EulerFD::ExecuteInternal() {
     }
 
     InitCovers();
+    if (threads_ > 1) pool_.emplace(threads_);
     size_t iteration_number = 0;
     while (true) {
         size_t ncover_size = invalids_.size();
@@ -418,6 +396,8 @@ unsigned long long EulerFD::ExecuteInternal() {
         iteration_number++;
     }
 
+    pool_.reset();
+
     // Convert answer from pcover trees to list of fd
     SaveAnswer();
 
@@ -6,6 +6,7 @@
 #include <limits>
 #include <memory>
 #include <numeric>
+#include <optional>
 #include <unordered_map>
 #include <unordered_set>
 #include <vector>
@@ -21,10 +22,13 @@
 #include "core/config/custom_random_seed/type.h"
 #include "core/config/equal_nulls/option.h"
 #include "core/config/tabular_data/input_table/option.h"
+#include "core/config/thread_number/type.h"
 #include "core/model/table/column.h"
 #include "core/model/table/relational_schema.h"
+#include "core/model/table/tuple_matrix.h"
 #include "core/model/table/vertical.h"
 #include "core/util/custom_random.h"
+#include "core/util/worker_thread_pool.h"
 
 namespace algos {
 
@@ -43,9 +47,12 @@ class EulerFD : public FDAlgorithm {
     size_t number_of_tuples_{};
     config::InputTable input_table_;
     std::shared_ptr<RelationalSchema> schema_{};
-    std::vector<std::vector<size_t>> tuples_;
+    model::TupleMatrix tuples_;
 
     config::EqNullsType is_null_equal_null_{};
+    config::ThreadNumType threads_ = 1;
+    // Computes agree sets of the sampled pairs during execution, if there is more than one thread
+    std::optional<util::WorkerThreadPool> pool_;
 
     // Thresholds to checking criterion of EulerFD cycles
     constexpr static double kPosCoverGrowthThreshold = 0.01;
@@ -84,8 +91,6 @@ class EulerFD : public FDAlgorithm {
     void ResetStateFd() final;
     void MakeExecuteOptsAvailable() final;
 
-    [[nodiscard]] Bitset BuildAgreeSet(size_t t1, size_t t2) const;
-
     void InitCovers();
     void BuildPartition();
 
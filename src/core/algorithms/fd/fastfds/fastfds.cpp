@@ -1,7 +1,6 @@
 #include "core/algorithms/fd/fastfds/fastfds.h"
 
 #include <algorithm>
-#include <mutex>
 #include <thread>
 
 #include <boost/asio/post.hpp>
@@ -13,7 +12,6 @@
 #include "core/config/thread_number/option.h"
 #include "core/model/table/agree_set_factory.h"
 #include "core/util/logger.h"
-#include "core/util/parallel_for.h"
 
 namespace algos {
 
@@ -32,7 +30,7 @@ void FastFDs::MakeExecuteOptsAvailableFDInternal() {
 }
 
 void FastFDs::ResetStateFd() {
-    diff_sets_.clear();
+    diff_sets_ = DiffSets();
 }
 
 unsigned long long FastFDs::ExecuteInternal() {
@@ -46,7 +44,7 @@ unsigned long long FastFDs::ExecuteInternal() {
             std::chrono::system_clock::now() - start_time);
     LOG_INFO("TIME TO DIFF SETS GENERATION: {}", elapsed_mills_to_gen_diff_sets.count());
 
-    if (diff_sets_.size() == 1 && diff_sets_.back().IsEmpty()) {
+    if (diff_sets_.Size() == 1 && diff_sets_.IsEmptySet(0)) {
         auto elapsed_milliseconds = std::chrono::duration_cast<std::chrono::milliseconds>(
                 std::chrono::system_clock::now() - start_time);
         return elapsed_milliseconds.count();
@@ -60,9 +58,9 @@ unsigned long long FastFDs::ExecuteInternal() {
             return;
         }
 
-        vector<DiffSet> diff_sets_mod = GetDiffSetsMod(*column);
-        assert(!diff_sets_mod.empty());
-        if (!(diff_sets_mod.size() == 1 && diff_sets_mod.back().IsEmpty())) {
+        DiffSets diff_sets_mod = GetDiffSetsMod(*column);
+        assert(!diff_sets_mod.Empty());
+        if (!(diff_sets_mod.Size() == 1 && diff_sets_mod.IsEmptySet(0))) {
             set<Column, OrderingComparator> init_ordering = GetInitOrdering(diff_sets_mod, *column);
             FindCovers(*column, diff_sets_mod, diff_sets_mod, empty_vertical, init_ordering);
         }
@@ -95,18 +93,18 @@ bool FastFDs::ColumnContainsOnlyEqualValues(Column const& column) const {
     return column_contains_only_equal_values;
 }
 
-void FastFDs::FindCovers(Column const& attribute, vector<DiffSet> const& diff_sets_mod,
-                         vector<DiffSet> const& cur_diff_sets, Vertical const& path,
+void FastFDs::FindCovers(Column const& attribute, DiffSets const& diff_sets_mod,
+                         DiffSets const& cur_diff_sets, Vertical const& path,
                          set<Column, OrderingComparator> const& ordering) {
     if (path.GetArity() > max_lhs_) {
         return;
     }
 
-    if (ordering.size() == 0 && !cur_diff_sets.empty()) {
+    if (ordering.size() == 0 && !cur_diff_sets.Empty()) {
         return;  // no FDs here
     }
 
-    if (cur_diff_sets.empty()) {
+    if (cur_diff_sets.Empty()) {
         if (CoverMinimal(path, diff_sets_mod)) {
             LOG_DEBUG("Registered FD: {} -> {}", path.ToString(), attribute.ToString());
             RegisterFd(path, attribute, relation_->GetSharedPtrSchema());
@@ -116,69 +114,53 @@ void FastFDs::FindCovers(Column const& attribute, vector<DiffSet> const& diff_se
     }
 
     for (Column const& column : ordering) {
-        vector<DiffSet> next_diff_sets;
-        for (DiffSet const& diff_set : cur_diff_sets) {
-            if (!diff_set.Contains(column)) {
-                next_diff_sets.push_back(diff_set);
-            }
-        }
+        DiffSets next_diff_sets = cur_diff_sets.Select(
+                [&cur_diff_sets, &column](size_t i) {
+                    return !cur_diff_sets.Contains(i, column.GetIndex());
+                });
 
         auto next_ordering = GetNextOrdering(next_diff_sets, column, ordering);
         FindCovers(attribute, diff_sets_mod, next_diff_sets, path.Union(column), next_ordering);
     }
 }
 
-bool FastFDs::IsCover(Vertical const& candidate, vector<Vertical> const& sets) const {
-    bool covers = true;
-
-    for (Vertical const& set : sets) {
-        if (!set.Intersects(candidate)) {
-            covers = false;
-            break;
+bool FastFDs::IsCover(DiffSets::Word const* candidate, DiffSets const& sets) {
+    for (size_t i = 0; i < sets.Size(); ++i) {
+        if (!sets.Intersects(sets.GetRow(i), candidate)) {
+            return false;
         }
     }
-
-    return covers;
+    return true;
 }
 
-bool FastFDs::CoverMinimal(Vertical const& cover, vector<DiffSet> const& diff_sets_mod) const {
+bool FastFDs::CoverMinimal(Vertical const& cover, DiffSets const& diff_sets_mod) const {
+    std::vector<DiffSets::Word> subset = diff_sets_mod.ToRow(cover.GetColumnIndices());
     for (Column const* column : cover.GetColumns()) {
-        Vertical subset = cover.Without(*column);
-        bool subset_covers = IsCover(subset, diff_sets_mod);
+        DiffSets::Reset(subset.data(), column->GetIndex());
+        bool subset_covers = IsCover(subset.data(), diff_sets_mod);
         if (subset_covers) {
             return false;  // cover is not minimal
         }
+        DiffSets::Set(subset.data(), column->GetIndex());
     }
     return true;  // cover is minimal
 }
 
-bool FastFDs::OrderingComp(vector<DiffSet> const& diff_sets, Column const& l_col,
-                           Column const& r_col) const {
-    unsigned cov_l = 0;
-    unsigned cov_r = 0;
-
-    for (DiffSet const& diff_set : diff_sets) {
-        if (diff_set.Contains(l_col)) {
-            ++cov_l;
-        }
-        if (diff_set.Contains(r_col)) {
-            ++cov_r;
+FastFDs::OrderingComparator FastFDs::MakeOrderingComp(DiffSets const& diff_sets) {
+    // counted once per ordering instead of on every comparison
+    return [coverage = diff_sets.CountColumns()](Column const& l_col, Column const& r_col) {
+        unsigned const cov_l = coverage[l_col.GetIndex()];
+        unsigned const cov_r = coverage[r_col.GetIndex()];
+        if (cov_l != cov_r) {
+            return cov_l > cov_r;
         }
-    }
-
-    if (cov_l != cov_r) {
-        return cov_l > cov_r;
-    }
-
-    return l_col > r_col;
+        return l_col > r_col;
+    };
 }
 
-set<Column, FastFDs::OrderingComparator> FastFDs::GetInitOrdering(vector<DiffSet> const& diff_sets,
+set<Column, FastFDs::OrderingComparator> FastFDs::GetInitOrdering(DiffSets const& diff_sets,
                                                                   Column const& attribute) const {
-    auto ordering_comp = [&diff_sets, this](Column const& l_col, Column const& r_col) {
-        return OrderingComp(diff_sets, l_col, r_col);
-    };
-    set<Column, OrderingComparator> ordering(ordering_comp);
+    set<Column, OrderingComparator> ordering(MakeOrderingComp(diff_sets));
 
     for (auto const& col : schema_->GetColumns()) {
         if (*col != attribute) {
@@ -190,25 +172,16 @@ set<Column, FastFDs::OrderingComparator> FastFDs::GetInitOrdering(vector<DiffSet
 }
 
 set<Column, FastFDs::OrderingComparator> FastFDs::GetNextOrdering(
-        vector<DiffSet> const& diff_sets, Column const& attribute,
+        DiffSets const& diff_sets, Column const& attribute,
         set<Column, OrderingComparator> const& cur_ordering) const {
-    auto ordering_comp = [&diff_sets, this](Column const& l_col, Column const& r_col) {
-        return OrderingComp(diff_sets, l_col, r_col);
-    };
-    set<Column, OrderingComparator> ordering(ordering_comp);
     // columns that are contained in at least one diff set
-    std::unordered_set<Column> diff_sets_cols;
-
-    for (DiffSet const& diff_set : diff_sets) {
-        for (Column const* const col : diff_set.GetColumns()) {
-            diff_sets_cols.insert(*col);
-        }
-    }
+    std::vector<unsigned> const coverage = diff_sets.CountColumns();
+    set<Column, OrderingComparator> ordering(MakeOrderingComp(diff_sets));
 
     auto p = cur_ordering.find(attribute);
     assert(p != cur_ordering.end());
     for (++p; p != cur_ordering.end(); ++p) {
-        if (diff_sets_cols.find(*p) != diff_sets_cols.end()) {
+        if (coverage[p->GetIndex()] != 0) {
             ordering.insert(*p);
         }
     }
@@ -218,34 +191,36 @@ set<Column, FastFDs::OrderingComparator> FastFDs::GetNextOrdering(
 /* Metanome uses thread pool here. No need for it because main loop over columns in
  * execute() is parallelized, this approach should be much better.
  */
-vector<FastFDs::DiffSet> FastFDs::GetDiffSetsMod(Column const& col) const {
-    vector<DiffSet> diff_sets_mod;
+FastFDs::DiffSets FastFDs::GetDiffSetsMod(Column const& col) const {
+    DiffSets diff_sets_mod(diff_sets_.GetNumColumns());
 
     /* diff_sets_ is sorted, before adding next diff_set to
      * diff_sets_mod need to check if diff_sets_mod contains
      * a subset of diff_set, that means that diff_set
      * is not minimal.
      */
-    for (DiffSet const& diff_set : diff_sets_) {
-        if (diff_set.Contains(col)) {
-            bool is_minimal = true;
-
-            for (DiffSet const& min_diff_set : diff_sets_mod) {
-                if (diff_set.Contains(min_diff_set)) {
-                    is_minimal = false;
-                    break;
-                }
-            }
+    for (size_t i = 0; i < diff_sets_.Size(); ++i) {
+        if (!diff_sets_.Contains(i, col.GetIndex())) {
+            continue;
+        }
+        DiffSets::Word const* diff_set = diff_sets_.GetRow(i);
+        bool is_minimal = true;
 
-            if (is_minimal) {
-                diff_sets_mod.push_back(diff_set.Without(col));
+        for (size_t j = 0; j < diff_sets_mod.Size(); ++j) {
+            if (diff_sets_mod.IsSubset(diff_sets_mod.GetRow(j), diff_set)) {
+                is_minimal = false;
+                break;
             }
         }
+
+        if (is_minimal) {
+            DiffSets::Reset(diff_sets_mod.Append(diff_set), col.GetIndex());
+        }
     }
 
     LOG_DEBUG("Compute minimal difference sets modulo {}:", col.ToString());
-    for (auto& item : diff_sets_mod) {
-        LOG_DEBUG("{}", item.ToString());
+    for (size_t i = 0; i < diff_sets_mod.Size(); ++i) {
+        LOG_DEBUG("{}", diff_sets_mod.GetVertical(i, schema_).ToString());
     }
 
     return diff_sets_mod;
@@ -259,36 +234,16 @@ void FastFDs::GenDiffSets() {
         // c.mc_gen_method = MCGenMethod::kParallel;
     }
     model::AgreeSetFactory factory(relation_.get(), c);
-    model::AgreeSetFactory::SetOfAgreeSets agree_sets = factory.GenAgreeSets();
-
-    LOG_DEBUG("Agree sets:");
-    for (auto const& agree_set : agree_sets) {
-        LOG_DEBUG("{}", agree_set.ToString());
-    }
+    diff_sets_ = factory.GenAgreeSetList();
 
     // Complement agree sets to get difference sets
-    diff_sets_.reserve(agree_sets.size());
-    if (threads_num_ > 1) {
-        std::mutex m;
-        auto const task = [&m, this](model::AgreeSet const& as) {
-            DiffSet diff_set = as.Invert();
-            std::lock_guard lock(m);
-            diff_sets_.push_back(std::move(diff_set));
-        };
-
-        util::ParallelForeach(agree_sets.begin(), agree_sets.end(), threads_num_, task);
-    } else {
-        for (model::AgreeSet const& agree_set : agree_sets) {
-            diff_sets_.push_back(agree_set.Invert());
-        }
-    }
-
+    diff_sets_.Invert();
     // sort diff_sets_, it will be used further to find minimal difference sets modulo column
-    std::sort(diff_sets_.begin(), diff_sets_.end());
+    diff_sets_.SortAndDedup();
 
     LOG_DEBUG("Compute difference sets:");
-    for (auto const& diff_set : diff_sets_) {
-        LOG_DEBUG("{}", diff_set.ToString());
+    for (size_t i = 0; i < diff_sets_.Size(); ++i) {
+        LOG_DEBUG("{}", diff_sets_.GetVertical(i, schema_).ToString());
     }
 }
 
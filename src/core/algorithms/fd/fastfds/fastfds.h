@@ -8,6 +8,7 @@
 #include "core/algorithms/fd/pli_based_fd_algorithm.h"
 #include "core/config/thread_number/type.h"
 #include "core/model/table/column_layout_relation_data.h"
+#include "core/model/table/column_set_list.h"
 #include "core/model/table/vertical.h"
 
 namespace algos {
@@ -18,7 +19,7 @@ public:
 
 private:
     using OrderingComparator = std::function<bool(Column const&, Column const&)>;
-    using DiffSet = Vertical;
+    using DiffSets = model::ColumnSetList;
 
     void RegisterOptions();
     void MakeExecuteOptsAvailableFDInternal() final;
@@ -32,43 +33,41 @@ private:
     /* Computes minimal difference sets
      * of `relation_` modulo `col`
      */
-    std::vector<DiffSet> GetDiffSetsMod(Column const& col) const;
+    DiffSets GetDiffSetsMod(Column const& col) const;
     /* Returns initial ordering,
      * the total ordering of { schema_->GetColumns() \ `attribute` } according to `diff_sets`
      */
-    std::set<Column, OrderingComparator> GetInitOrdering(std::vector<DiffSet> const& diff_sets,
+    std::set<Column, OrderingComparator> GetInitOrdering(DiffSets const& diff_sets,
                                                          Column const& attribute) const;
     /* Returns next ordering,
      * the total ordering of { B in schema_->GetColumns() | B > `attribute` (in `cur_ordering`) }
      * according to `diff_sets`
      */
     std::set<Column, OrderingComparator> GetNextOrdering(
-            std::vector<DiffSet> const& diff_sets, Column const& attribute,
+            DiffSets const& diff_sets, Column const& attribute,
             std::set<Column, OrderingComparator> const& cur_ordering) const;
-    void FindCovers(Column const& attribute, std::vector<DiffSet> const& diff_sets_mod,
-                    std::vector<DiffSet> const& cur_diff_sets, Vertical const& path,
+    void FindCovers(Column const& attribute, DiffSets const& diff_sets_mod,
+                    DiffSets const& cur_diff_sets, Vertical const& path,
                     std::set<Column, OrderingComparator> const& ordering);
     /* Returns true if `cover` is the minimal cover of `diff_sets_mod`,
      * false otherwise
      */
-    bool CoverMinimal(Vertical const& cover, std::vector<DiffSet> const& diff_sets_mod) const;
+    bool CoverMinimal(Vertical const& cover, DiffSets const& diff_sets_mod) const;
     /* Returns true if `candidate` covers `sets`,
      * false otherwise
      */
-    bool IsCover(Vertical const& candidate, std::vector<Vertical> const& sets) const;
-    /* Returns true if `l_col` > `r_col`,
-     * false otherwise.
-     * `l_col` > `r_col` iff
+    static bool IsCover(DiffSets::Word const* candidate, DiffSets const& sets);
+    /* Returns the comparator by which `l_col` > `r_col` iff
      * `l_col` covers more sets in `diff_sets` than `r_col` or
      * `l_col` and `r_col` cover the same number of sets but
      * `l_col` index less than `r_col` index
      */
-    bool OrderingComp(std::vector<DiffSet> const& diff_sets, Column const& l_col,
-                      Column const& r_col) const;
+    static OrderingComparator MakeOrderingComp(DiffSets const& diff_sets);
     bool ColumnContainsOnlyEqualValues(Column const& column) const;
 
     RelationalSchema const* schema_;
-    std::vector<DiffSet> diff_sets_;
+    /* Sorted, so that every difference set comes after its subsets */
+    DiffSets diff_sets_;
     config::ThreadNumType threads_num_;
 };
 
@@ -23,6 +23,7 @@ void FDAlgorithm::MakeExecuteOptsAvailable() {
 
 void FDAlgorithm::ResetState() {
     fd_collection_.Clear();
+    candidate_frontier_.clear();
     ResetStateFd();
 }
 
@@ -40,6 +40,11 @@ protected:
      */
     util::PrimitiveCollection<FD> fd_collection_;
 
+    /* Candidates that were neither confirmed nor refuted when Execute stopped early.
+     * Algorithms that can tell what is left to check should fill it before returning.
+     */
+    std::list<FD> candidate_frontier_;
+
     /* Registers new FD.
      * Should be overridden if custom behavior is needed
      */
@@ -68,6 +73,11 @@ public:
 
     std::list<FD>& SortedFdList();
 
+    /* Returns the unchecked candidates left by an interrupted Execute, empty if it finished */
+    std::list<FD> const& CandidateFrontier() const noexcept {
+        return candidate_frontier_;
+    }
+
     /* возвращает набор ФЗ в виде JSON-а. По сути, это просто представление фиксированного формата
      * для сравнения результатов разных алгоритмов. JSON - на всякий случай, если потом, например,
      * понадобится загрузить список в питон и как-нибудь его поанализировать
@@ -0,0 +1,231 @@
+#include "core/algorithms/fd/fd_verifier/batch_verifier.h"
+
+#include <algorithm>
+#include <chrono>
+#include <deque>
+#include <memory>
+#include <optional>
+#include <stdexcept>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+#include "core/algorithms/fd/fd_verifier/pli_prefix_tree.h"
+#include "core/algorithms/fd/fd_verifier/stats_calculator.h"
+#include "core/config/column_index/validate_index.h"
+#include "core/config/exceptions.h"
+#include "core/config/indices/option.h"
+#include "core/config/names_and_descriptions.h"
+#include "core/config/option_using.h"
+#include "core/config/tabular_data/input_table/option.h"
+#include "core/config/thread_number/option.h"
+#include "core/model/table/dataset.h"
+#include "core/util/logger.h"
+#include "core/util/worker_thread_pool.h"
+
+namespace algos::fd_verifier {
+
+BatchVerifier::BatchVerifier() : Algorithm() {
+    RegisterOptions();
+    MakeOptionsAvailable({config::kTableOpt.GetName()});
+}
+
+void BatchVerifier::RegisterOptions() {
+    DESBORDANTE_OPTION_USING;
+
+    auto check_indices = [this](config::IndicesType const& indices, std::string const& what) {
+        if (indices.empty()) {
+            throw config::ConfigurationError(what + " cannot be empty");
+        }
+        config::ValidateIndex(indices.back(), relation_->GetSchema()->GetNumColumns());
+    };
+    auto normalize_fds = [](FdList& fds) {
+        for (auto& [lhs, rhs] : fds) {
+            config::IndicesOption::NormalizeIndices(lhs);
+            config::IndicesOption::NormalizeIndices(rhs);
+        }
+    };
+    auto check_fds = [check_indices](FdList const& fds) {
+        for (auto const& [lhs, rhs] : fds) {
+            check_indices(lhs, "FD LHS");
+            check_indices(rhs, "FD RHS");
+        }
+    };
+    auto normalize_uccs = [](UccList& uccs) {
+        for (config::IndicesType& ucc : uccs) {
+            config::IndicesOption::NormalizeIndices(ucc);
+        }
+    };
+    auto check_uccs = [check_indices](UccList const& uccs) {
+        for (config::IndicesType const& ucc : uccs) {
+            check_indices(ucc, "UCC");
+        }
+    };
+
+    RegisterOption(config::kTableOpt(&input_table_));
+    RegisterOption(Option{&fds_, kFdsToVerify, kDFdsToVerify, FdList{}}
+                           .SetNormalizeFunc(std::move(normalize_fds))
+                           .SetValueCheck(std::move(check_fds)));
+    RegisterOption(Option{&uccs_, kUccsToVerify, kDUccsToVerify, UccList{}}
+                           .SetNormalizeFunc(std::move(normalize_uccs))
+                           .SetValueCheck(std::move(check_uccs)));
+    RegisterOption(Option{&max_highlights_, kMaxHighlights, kDMaxHighlights, 10u});
+    RegisterOption(config::kThreadNumberOpt(&threads_));
+}
+
+void BatchVerifier::MakeExecuteOptsAvailable() {
+    using namespace config::names;
+
+    MakeOptionsAvailable(
+            {kFdsToVerify, kUccsToVerify, kMaxHighlights, config::kThreadNumberOpt.GetName()});
+}
+
+void BatchVerifier::LoadDataInternal() {
+    relation_ = model::LoadRelation(*input_table_);
+    if (relation_->GetColumnData().empty()) {
+        throw std::runtime_error("Got an empty dataset: FD verifying is meaningless.");
+    }
+}
+
+FdVerificationSummary BatchVerifier::VerifyFd(model::PLI const* lhs_pli,
+                                              model::PLI const* rhs_pli) const {
+    FdVerificationSummary summary;
+    std::shared_ptr<std::vector<int> const> pt_shared = rhs_pli->CalculateAndGetProbingTable();
+    std::vector<int> const& pt = *pt_shared;
+    std::size_t num_tuples_conflicting_on_rhs = 0;
+
+    for (model::PLI::Cluster const& cluster : lhs_pli->GetIndex()) {
+        std::unordered_map<int, unsigned> const frequencies =
+                model::PLI::CreateFrequencies(cluster, pt);
+        std::size_t const num_distinct_rhs_values =
+                StatsCalculator::CalculateNumDistinctRhsValues(frequencies, cluster.size());
+        if (num_distinct_rhs_values == 1) {
+            continue;
+        }
+        num_tuples_conflicting_on_rhs +=
+                StatsCalculator::CalculateNumTuplesConflictingOnRhsInCluster(frequencies,
+                                                                             cluster.size());
+        ++summary.num_error_clusters;
+        summary.num_error_rows += cluster.size();
+        if (max_highlights_ != 0) {
+            summary.highlights.emplace_back(
+                    cluster, num_distinct_rhs_values,
+                    StatsCalculator::CalculateNumMostFrequentRhsValue(frequencies));
+        }
+    }
+    if (summary.Holds()) {
+        return summary;
+    }
+
+    std::size_t const num_rows = relation_->GetNumRows();
+    summary.error = (double)num_tuples_conflicting_on_rhs / (num_rows * num_rows - num_rows);
+
+    std::vector<Highlight>& highlights = summary.highlights;
+    std::size_t const num_kept = std::min<std::size_t>(max_highlights_, highlights.size());
+    std::partial_sort(highlights.begin(), highlights.begin() + num_kept, highlights.end(),
+                      StatsCalculator::CompareHighlightsByProportionDescending());
+    highlights.erase(highlights.begin() + num_kept, highlights.end());
+    return summary;
+}
+
+UccVerificationSummary BatchVerifier::VerifyUcc(model::PLI const* pli) const {
+    UccVerificationSummary summary;
+    std::deque<model::PLI::Cluster> const& clusters = pli->GetIndex();
+    std::size_t const num_rows = relation_->GetNumRows();
+    unsigned long long num_pairs_combinations = num_rows;
+    if (num_rows > 1) {
+        num_pairs_combinations *= (num_rows - 1);
+    }
+
+    summary.num_error_clusters = clusters.size();
+    for (model::PLI::Cluster const& cluster : clusters) {
+        summary.num_error_rows += cluster.size();
+        summary.error += static_cast<double>(cluster.size()) * (cluster.size() - 1) /
+                         num_pairs_combinations;
+    }
+
+    std::vector<model::PLI::Cluster const*> largest(clusters.size());
+    std::transform(clusters.begin(), clusters.end(), largest.begin(),
+                   [](model::PLI::Cluster const& cluster) { return &cluster; });
+    std::size_t const num_kept = std::min<std::size_t>(max_highlights_, largest.size());
+    std::partial_sort(largest.begin(), largest.begin() + num_kept, largest.end(),
+                      [](model::PLI::Cluster const* c1, model::PLI::Cluster const* c2) {
+                          return c1->size() > c2->size();
+                      });
+    summary.highlights.reserve(num_kept);
+    for (std::size_t i = 0; i < num_kept; ++i) {
+        summary.highlights.push_back(*largest[i]);
+    }
+    return summary;
+}
+
+unsigned long long BatchVerifier::ExecuteInternal() {
+    auto start_time = std::chrono::system_clock::now();
+
+    PliPrefixTree tree(relation_.get());
+
+    /* An FD is checked at the deeper level of its LHS and RHS, when both PLIs are alive */
+    struct FdNodes {
+        PliPrefixTree::NodeId lhs;
+        PliPrefixTree::NodeId rhs;
+    };
+
+    std::vector<FdNodes> fd_nodes;
+    fd_nodes.reserve(fds_.size());
+    for (auto const& [lhs, rhs] : fds_) {
+        fd_nodes.push_back({tree.Insert(lhs), tree.Insert(rhs)});
+    }
+    std::vector<PliPrefixTree::NodeId> ucc_nodes;
+    ucc_nodes.reserve(uccs_.size());
+    for (config::IndicesType const& ucc : uccs_) {
+        ucc_nodes.push_back(tree.Insert(ucc));
+    }
+
+    std::vector<std::vector<std::size_t>> fds_by_level(tree.GetMaxLevel() + 1);
+    for (std::size_t i = 0; i < fd_nodes.size(); ++i) {
+        auto [lhs, rhs] = fd_nodes[i];
+        std::size_t const level = std::max(tree.GetLevel(lhs), tree.GetLevel(rhs));
+        tree.Require(lhs, level);
+        tree.Require(rhs, level);
+        fds_by_level[level].push_back(i);
+    }
+    std::vector<std::vector<std::size_t>> uccs_by_level(tree.GetMaxLevel() + 1);
+    for (std::size_t i = 0; i < ucc_nodes.size(); ++i) {
+        uccs_by_level[tree.GetLevel(ucc_nodes[i])].push_back(i);
+    }
+
+    fd_results_.resize(fds_.size());
+    ucc_results_.resize(uccs_.size());
+
+    std::optional<util::WorkerThreadPool> pool;
+    if (threads_ > 1) {
+        pool.emplace(threads_);
+    }
+    auto for_each = [&pool](std::vector<std::size_t> const& items, auto func) {
+        auto process = [&items, &func](std::size_t i) { func(items[i]); };
+        if (pool.has_value() && items.size() > 1) {
+            pool->ExecIndex(process, items.size());
+        } else {
+            for (std::size_t i = 0; i < items.size(); ++i) {
+                process(i);
+            }
+        }
+    };
+
+    tree.Traverse(pool.has_value() ? &*pool : nullptr, [&](std::size_t level) {
+        for_each(fds_by_level[level], [&](std::size_t i) {
+            fd_results_[i] = VerifyFd(tree.GetPli(fd_nodes[i].lhs), tree.GetPli(fd_nodes[i].rhs));
+        });
+        for_each(uccs_by_level[level], [&](std::size_t i) {
+            ucc_results_[i] = VerifyUcc(tree.GetPli(ucc_nodes[i]));
+        });
+    });
+
+    LOG_DEBUG("Verified {} FDs and {} UCCs", fds_.size(), uccs_.size());
+
+    auto elapsed_milliseconds = std::chrono::duration_cast<std::chrono::milliseconds>(
+            std::chrono::system_clock::now() - start_time);
+    return elapsed_milliseconds.count();
+}
+
+}  // namespace algos::fd_verifier
@@ -0,0 +1,93 @@
+#pragma once
+
+#include <cstddef>
+#include <memory>
+#include <utility>
+#include <vector>
+
+#include "core/algorithms/algorithm.h"
+#include "core/algorithms/fd/fd_verifier/highlight.h"
+#include "core/config/indices/type.h"
+#include "core/config/tabular_data/input_table_type.h"
+#include "core/config/thread_number/type.h"
+#include "core/model/table/column_layout_relation_data.h"
+
+namespace algos::fd_verifier {
+
+/* Verification result of one FD, same statistics as FDVerifier provides */
+struct FdVerificationSummary {
+    long double error = 0;
+    std::size_t num_error_clusters = 0;
+    std::size_t num_error_rows = 0;
+    /* At most max_highlights violating clusters in the order FDVerifier sorts them by default:
+     * highest proportion of the most frequent RHS value first */
+    std::vector<Highlight> highlights;
+
+    bool Holds() const noexcept {
+        return num_error_clusters == 0;
+    }
+};
+
+/* Verification result of one UCC, same statistics as UCCVerifier provides */
+struct UccVerificationSummary {
+    double error = 0;
+    std::size_t num_error_clusters = 0;
+    std::size_t num_error_rows = 0;
+    /* At most max_highlights clusters of rows equal on the UCC columns, largest first */
+    std::vector<model::PLI::Cluster> highlights;
+
+    bool Holds() const noexcept {
+        return num_error_clusters == 0;
+    }
+};
+
+/* Verifies many FDs and UCCs over one table in a single run. Their LHSs, RHSs and UCC column
+ * sets are planned as a prefix tree, so every shared prefix is intersected once, and each
+ * dependency is checked in parallel with the others as soon as the PLIs it needs are ready. */
+class BatchVerifier : public Algorithm {
+public:
+    /* Pairs of LHS and RHS column indices */
+    using FdList = std::vector<std::pair<config::IndicesType, config::IndicesType>>;
+    using UccList = std::vector<config::IndicesType>;
+
+private:
+    config::InputTable input_table_;
+
+    FdList fds_;
+    UccList uccs_;
+    unsigned max_highlights_;
+    config::ThreadNumType threads_;
+
+    std::shared_ptr<ColumnLayoutRelationData const> relation_;
+
+    std::vector<FdVerificationSummary> fd_results_;
+    std::vector<UccVerificationSummary> ucc_results_;
+
+    void RegisterOptions();
+    void LoadDataInternal() override;
+    void MakeExecuteOptsAvailable() override;
+    unsigned long long ExecuteInternal() override;
+
+    void ResetState() override {
+        fd_results_.clear();
+        ucc_results_.clear();
+    }
+
+    FdVerificationSummary VerifyFd(model::PLI const* lhs_pli, model::PLI const* rhs_pli) const;
+    UccVerificationSummary VerifyUcc(model::PLI const* pli) const;
+
+public:
+    /* Results in the order of the fds option */
+    std::vector<FdVerificationSummary> const& GetFdResults() const noexcept {
+        return fd_results_;
+    }
+
+    /* Results in the order of the uccs option */
+    std::vector<UccVerificationSummary> const& GetUccResults() const noexcept {
+        return ucc_results_;
+    }
+
+    BatchVerifier();
+};
+
+}  // namespace algos::fd_verifier
@@ -22,7 +22,8 @@ void DynamicStatsCalculator::CalculateStatistics(model::DynPLI const* lhs_pli,
         num_tuples_conflicting_on_rhs +=
                 CalculateNumTuplesConflictingOnRhsInCluster(frequencies, cluster.size());
         num_error_rows_ += cluster.size();
-        highlights_.emplace_back(cluster, num_distinct_rhs_values,
+        highlights_.emplace_back(model::PLI::Cluster(cluster.begin(), cluster.end()),
+                                 num_distinct_rhs_values,
                                  CalculateNumMostFrequentRhsValue(frequencies));
     }
 
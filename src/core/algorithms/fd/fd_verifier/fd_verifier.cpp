@@ -9,6 +9,8 @@
 #include "core/config/names_and_descriptions.h"
 #include "core/config/option_using.h"
 #include "core/config/tabular_data/input_table/option.h"
+#include "core/config/tabular_data/load_columns/option.h"
+#include "core/model/table/dataset.h"
 
 namespace algos::fd_verifier {
 
@@ -20,12 +22,17 @@ FDVerifier::FDVerifier() : Algorithm() {
 void FDVerifier::RegisterOptions() {
     DESBORDANTE_OPTION_USING;
 
-    auto get_schema_cols = [this]() { return relation_->GetSchema()->GetNumColumns(); };
+    auto get_table_cols = [this]() { return input_table_->GetNumberOfColumns(); };
+    auto get_source_cols = [this]() { return projection_.GetNumSourceColumns(); };
+    auto check_loaded = [this](config::IndicesType const& indices) {
+        projection_.CheckLoaded(indices);
+    };
 
-    RegisterOption(config::kTableOpt(&input_table_));
+    RegisterOption(config::kTableOpt(&input_table_).SetConditionalOpts({{{}, {kLoadColumns}}}));
+    RegisterOption(config::kLoadColumnsOpt(&load_columns_, get_table_cols));
     RegisterOption(config::kEqualNullsOpt(&is_null_equal_null_));
-    RegisterOption(config::kLhsIndicesOpt(&lhs_indices_, get_schema_cols));
-    RegisterOption(config::kRhsIndicesOpt(&rhs_indices_, get_schema_cols));
+    RegisterOption(config::kLhsIndicesOpt(&lhs_indices_, get_source_cols, check_loaded));
+    RegisterOption(config::kRhsIndicesOpt(&rhs_indices_, get_source_cols, check_loaded));
 }
 
 void FDVerifier::MakeExecuteOptsAvailable() {
@@ -35,22 +42,25 @@ void FDVerifier::MakeExecuteOptsAvailable() {
 }
 
 void FDVerifier::LoadDataInternal() {
-    relation_ = ColumnLayoutRelationData::CreateFrom(*input_table_);
-    input_table_->Reset();
+    projection_ = model::ColumnProjection(*input_table_, load_columns_);
+    config::InputTable table = projection_.Apply(input_table_);
+    relation_ = model::LoadRelation(*table);
+    table->Reset();
     if (relation_->GetColumnData().empty()) {
         throw std::runtime_error("Got an empty dataset: FD verifying is meaningless.");
     }
-    typed_relation_ =
-            model::ColumnLayoutTypedRelationData::CreateFrom(*input_table_, is_null_equal_null_);
+    typed_relation_ = model::LoadTypedRelation(*table, is_null_equal_null_);
 }
 
 unsigned long long FDVerifier::ExecuteInternal() {
     auto start_time = std::chrono::system_clock::now();
 
-    stats_calculator_ = std::make_unique<StatsCalculator>(relation_, typed_relation_, lhs_indices_,
-                                                          rhs_indices_);
+    config::IndicesType const lhs_indices = projection_.ToLoaded(lhs_indices_);
+    config::IndicesType const rhs_indices = projection_.ToLoaded(rhs_indices_);
+    stats_calculator_ = std::make_unique<StatsCalculator>(relation_, typed_relation_, lhs_indices,
+                                                          rhs_indices);
 
-    VerifyFD();
+    VerifyFD(lhs_indices, rhs_indices);
     SortHighlightsByProportionDescending();
     stats_calculator_->PrintStatistics();
 
@@ -59,9 +69,10 @@ unsigned long long FDVerifier::ExecuteInternal() {
     return elapsed_milliseconds.count();
 }
 
-void FDVerifier::VerifyFD() const {
-    std::shared_ptr<model::PLI const> lhs_pli = relation_->CalculatePLI(lhs_indices_);
-    std::shared_ptr<model::PLI const> rhs_pli = relation_->CalculatePLI(rhs_indices_);
+void FDVerifier::VerifyFD(config::IndicesType const& lhs_indices,
+                          config::IndicesType const& rhs_indices) const {
+    std::shared_ptr<model::PLI const> lhs_pli = relation_->CalculatePLI(lhs_indices);
+    std::shared_ptr<model::PLI const> rhs_pli = relation_->CalculatePLI(rhs_indices);
 
     std::unique_ptr<model::PLI const> intersection_pli = lhs_pli->Intersect(rhs_pli.get());
     if (lhs_pli->GetNumCluster() == intersection_pli->GetNumCluster()) {
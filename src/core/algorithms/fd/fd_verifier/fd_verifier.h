@@ -10,6 +10,7 @@
 #include "core/config/equal_nulls/type.h"
 #include "core/config/indices/type.h"
 #include "core/config/tabular_data/input_table_type.h"
+#include "core/model/table/column_projection.h"
 
 namespace algos::fd_verifier {
 
@@ -18,16 +19,19 @@ namespace algos::fd_verifier {
 class FDVerifier : public Algorithm {
 private:
     config::InputTable input_table_;
+    config::IndicesType load_columns_;
+    model::ColumnProjection projection_;
 
     config::IndicesType lhs_indices_;
     config::IndicesType rhs_indices_;
     config::EqNullsType is_null_equal_null_;
 
-    std::shared_ptr<ColumnLayoutRelationData> relation_;
-    std::shared_ptr<model::ColumnLayoutTypedRelationData> typed_relation_;
+    std::shared_ptr<ColumnLayoutRelationData const> relation_;
+    std::shared_ptr<model::ColumnLayoutTypedRelationData const> typed_relation_;
     std::unique_ptr<StatsCalculator> stats_calculator_;
 
-    void VerifyFD() const;
+    void VerifyFD(config::IndicesType const& lhs_indices,
+                  config::IndicesType const& rhs_indices) const;
     void RegisterOptions();
 
     void ResetState() final {
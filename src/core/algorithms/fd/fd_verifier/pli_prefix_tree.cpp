@@ -0,0 +1,74 @@
+#include "core/algorithms/fd/fd_verifier/pli_prefix_tree.h"
+
+#include <algorithm>
+#include <cassert>
+
+namespace algos::fd_verifier {
+
+PliPrefixTree::PliPrefixTree(ColumnLayoutRelationData const* relation)
+    : relation_(relation), nodes_{Node{kRoot, 0, 0, 0, {}, nullptr}}, levels_{{kRoot}} {}
+
+PliPrefixTree::NodeId PliPrefixTree::Insert(config::IndicesType const& indices) {
+    assert(!indices.empty());
+    assert(std::is_sorted(indices.begin(), indices.end()));
+
+    NodeId node = kRoot;
+    for (config::IndexType column : indices) {
+        NodeId const new_node = nodes_.size();
+        auto const [it, inserted] = nodes_[node].children.try_emplace(column, new_node);
+        NodeId const child = it->second;
+        if (inserted) {
+            std::size_t const level = nodes_[node].level + 1;
+            nodes_.push_back(Node{node, column, level, level, {}, nullptr});
+            if (levels_.size() <= level) {
+                levels_.emplace_back();
+            }
+            levels_[level].push_back(child);
+            Require(node, level);
+        }
+        node = child;
+    }
+    return node;
+}
+
+void PliPrefixTree::Require(NodeId node, std::size_t level) {
+    Node& required = nodes_[node];
+    required.last_use_level = std::max(required.last_use_level, level);
+}
+
+void PliPrefixTree::ComputePli(Node& node) {
+    ColumnData const& column_data = relation_->GetColumnData(node.column);
+    if (node.parent == kRoot) {
+        node.pli = column_data.GetPliOwnership();
+    } else {
+        node.pli = nodes_[node.parent].pli->Intersect(column_data.GetPositionListIndex());
+    }
+}
+
+void PliPrefixTree::Traverse(util::WorkerThreadPool* pool,
+                             std::function<void(std::size_t level)> const& process_level) {
+    std::vector<std::vector<NodeId>> released_after(levels_.size());
+    for (NodeId node = kRoot + 1; node < nodes_.size(); ++node) {
+        released_after[nodes_[node].last_use_level].push_back(node);
+    }
+
+    for (std::size_t level = 1; level < levels_.size(); ++level) {
+        std::vector<NodeId> const& level_nodes = levels_[level];
+        auto compute = [this, &level_nodes](std::size_t i) { ComputePli(nodes_[level_nodes[i]]); };
+        if (pool != nullptr && level_nodes.size() > 1) {
+            pool->ExecIndex(compute, level_nodes.size());
+        } else {
+            for (std::size_t i = 0; i < level_nodes.size(); ++i) {
+                compute(i);
+            }
+        }
+
+        process_level(level);
+
+        for (NodeId node : released_after[level]) {
+            nodes_[node].pli.reset();
+        }
+    }
+}
+
+}  // namespace algos::fd_verifier
@@ -0,0 +1,72 @@
+#pragma once
+
+#include <cstddef>
+#include <functional>
+#include <map>
+#include <memory>
+#include <vector>
+
+#include "core/config/indices/type.h"
+#include "core/model/table/column_layout_relation_data.h"
+#include "core/util/worker_thread_pool.h"
+
+namespace algos::fd_verifier {
+
+/* Plans the PLIs of many column combinations as a prefix tree over their sorted column indices,
+ * so combinations with a common prefix share its intersections. The PLI of a node is the PLI of
+ * its parent intersected with the PLI of one more column. Nodes are computed level by level and
+ * every PLI is dropped right after the last level that needs it, so at most a few levels of
+ * intersections are alive at once.
+ */
+class PliPrefixTree {
+public:
+    using NodeId = std::size_t;
+
+private:
+    static constexpr NodeId kRoot = 0;
+
+    struct Node {
+        NodeId parent;
+        config::IndexType column;
+        std::size_t level;
+        /* The last level after which the PLI of the node is still needed */
+        std::size_t last_use_level;
+        std::map<config::IndexType, NodeId> children;
+        std::shared_ptr<model::PLI const> pli;
+    };
+
+    ColumnLayoutRelationData const* relation_;
+    std::vector<Node> nodes_;
+    std::vector<std::vector<NodeId>> levels_;
+
+    void ComputePli(Node& node);
+
+public:
+    explicit PliPrefixTree(ColumnLayoutRelationData const* relation);
+
+    /* Indices must be sorted, unique and not empty */
+    NodeId Insert(config::IndicesType const& indices);
+
+    /* Keep the PLI of the node until process_level has been called for the level */
+    void Require(NodeId node, std::size_t level);
+
+    std::size_t GetLevel(NodeId node) const {
+        return nodes_[node].level;
+    }
+
+    std::size_t GetMaxLevel() const {
+        return levels_.size() - 1;
+    }
+
+    /* Valid only during the process_level call of a level the PLI is required at */
+    model::PLI const* GetPli(NodeId node) const {
+        return nodes_[node].pli.get();
+    }
+
+    /* Computes the PLIs of every level, shallowest first, and calls process_level after each
+     * one. The PLIs of a level are computed in parallel if a pool is given. */
+    void Traverse(util::WorkerThreadPool* pool,
+                  std::function<void(std::size_t level)> const& process_level);
+};
+
+}  // namespace algos::fd_verifier
@@ -60,8 +60,8 @@ void StatsCalculator::PrintStatistics() const {
 
 void StatsCalculator::CalculateStatistics(model::PLI const* lhs_pli, model::PLI const* rhs_pli) {
     std::deque<model::PLI::Cluster> const& lhs_clusters = lhs_pli->GetIndex();
-    std::shared_ptr<model::PLI::Cluster const> pt_shared = rhs_pli->CalculateAndGetProbingTable();
-    model::PLI::Cluster const& pt = *pt_shared.get();
+    std::shared_ptr<std::vector<int> const> pt_shared = rhs_pli->CalculateAndGetProbingTable();
+    std::vector<int> const& pt = *pt_shared.get();
     size_t num_tuples_conflicting_on_rhs = 0.;
 
     for (auto& cluster : lhs_clusters) {
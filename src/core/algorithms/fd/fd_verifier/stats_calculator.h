@@ -16,8 +16,8 @@ class StatsCalculator {
 private:
     using ClusterIndex = model::PLI::Cluster::value_type;
 
-    std::shared_ptr<ColumnLayoutRelationData> relation_;
-    std::shared_ptr<model::ColumnLayoutTypedRelationData> typed_relation_;
+    std::shared_ptr<ColumnLayoutRelationData const> relation_;
+    std::shared_ptr<model::ColumnLayoutTypedRelationData const> typed_relation_;
 
     config::IndicesType lhs_indices_;
     config::IndicesType rhs_indices_;
@@ -30,6 +30,11 @@ private:
     std::string GetLhsStringValue(ClusterIndex row_index) const;
     std::string GetStringValueByIndex(ClusterIndex row_index, ClusterIndex col_index) const;
 
+    model::CompareResult CompareTypedValues(ClusterIndex i1, ClusterIndex i2) const;
+
+public:
+    using HighlightCompareFunction = std::function<bool(Highlight const& h1, Highlight const& h2)>;
+
     static size_t CalculateNumDistinctRhsValues(
             std::unordered_map<ClusterIndex, unsigned> const& frequencies, size_t cluster_size);
 
@@ -39,11 +44,6 @@ private:
     static size_t CalculateNumMostFrequentRhsValue(
             std::unordered_map<ClusterIndex, unsigned> const& frequencies);
 
-    model::CompareResult CompareTypedValues(ClusterIndex i1, ClusterIndex i2) const;
-
-public:
-    using HighlightCompareFunction = std::function<bool(Highlight const& h1, Highlight const& h2)>;
-
     void CalculateStatistics(model::PLI const* lhs_pli, model::PLI const* rhs_pli);
 
     void PrintStatistics() const;
@@ -85,9 +85,10 @@ public:
     HighlightCompareFunction CompareHighlightsByLhsAscending() const;
     HighlightCompareFunction CompareHighlightsByLhsDescending() const;
 
-    explicit StatsCalculator(std::shared_ptr<ColumnLayoutRelationData> relation,
-                             std::shared_ptr<model::ColumnLayoutTypedRelationData> typed_relation,
-                             config::IndicesType lhs_indices, config::IndicesType rhs_indices)
+    explicit StatsCalculator(
+            std::shared_ptr<ColumnLayoutRelationData const> relation,
+            std::shared_ptr<model::ColumnLayoutTypedRelationData const> typed_relation,
+            config::IndicesType lhs_indices, config::IndicesType rhs_indices)
         : relation_(std::move(relation)),
           typed_relation_(std::move(typed_relation)),
           lhs_indices_(std::move(lhs_indices)),
@@ -2,9 +2,18 @@
 
 #include "core/model/types/bitset.h"
 
-FDTreeElement::FDTreeElement(size_t max_attribute_number)
-    : max_attribute_number_(max_attribute_number) {
-    children_.resize(max_attribute_number);
+FDTreeElement::FDTreeElement(size_t max_attribute_number, std::pmr::memory_resource* resource)
+    : children_(max_attribute_number, resource), max_attribute_number_(max_attribute_number) {}
+
+void FDTreeElement::ChildDeleter::operator()(FDTreeElement* child) const {
+    std::pmr::polymorphic_allocator<FDTreeElement> allocator = child->children_.get_allocator();
+    allocator.delete_object(child);
+}
+
+std::unique_ptr<FDTreeElement, FDTreeElement::ChildDeleter> FDTreeElement::CreateChild() const {
+    std::pmr::polymorphic_allocator<FDTreeElement> allocator = children_.get_allocator();
+    return std::unique_ptr<FDTreeElement, ChildDeleter>(
+            allocator.new_object<FDTreeElement>(max_attribute_number_, allocator.resource()));
 }
 
 bool FDTreeElement::CheckFd(size_t index) const {
@@ -156,8 +165,7 @@ void FDTreeElement::AddFunctionalDependency(model::Bitset<FDTreeElement::kMaxAtt
 
     for (size_t i = lhs._Find_first(); i != kMaxAttrNum; i = lhs._Find_next(i)) {
         if (current_node->children_[i - 1] == nullptr) {
-            current_node->children_[i - 1] =
-                    std::make_unique<FDTreeElement>(this->max_attribute_number_);
+            current_node->children_[i - 1] = current_node->CreateChild();
         }
 
         current_node = current_node->GetChild(i - 1);
@@ -169,7 +177,8 @@ void FDTreeElement::AddFunctionalDependency(model::Bitset<FDTreeElement::kMaxAtt
 
 void FDTreeElement::FilterSpecializations() {
     model::Bitset<kMaxAttrNum> active_path;
-    auto filtered_tree = std::make_unique<FDTreeElement>(this->max_attribute_number_);
+    auto filtered_tree = std::make_unique<FDTreeElement>(this->max_attribute_number_,
+                                                         children_.get_allocator().resource());
 
     this->FilterSpecializationsHelper(*filtered_tree, active_path);
 
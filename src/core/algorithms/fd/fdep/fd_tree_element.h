@@ -2,6 +2,7 @@
 
 #include <list>
 #include <memory>
+#include <memory_resource>
 #include <vector>
 
 // For printing Dependencies
@@ -17,7 +18,9 @@ public:
     // The maximum number of columns in the dataset. Using in std::bitset template.
     static constexpr int kMaxAttrNum = 256;
 
-    explicit FDTreeElement(size_t max_attribute_number);
+    /* Children, and their children in turn, are allocated from the memory resource */
+    explicit FDTreeElement(size_t max_attribute_number,
+                           std::pmr::memory_resource* resource = std::pmr::get_default_resource());
 
     FDTreeElement(FDTreeElement const&) = delete;
     FDTreeElement& operator=(FDTreeElement const&) = delete;
@@ -49,11 +52,18 @@ public:
                           unsigned int max_lhs = std::numeric_limits<unsigned int>::max()) const;
 
 private:
-    std::vector<std::unique_ptr<FDTreeElement>> children_;
+    /* Returns a child to the memory resource of the tree */
+    struct ChildDeleter {
+        void operator()(FDTreeElement* child) const;
+    };
+
+    std::pmr::vector<std::unique_ptr<FDTreeElement, ChildDeleter>> children_;
     model::Bitset<kMaxAttrNum> rhs_attributes_;
     size_t max_attribute_number_;
     model::Bitset<kMaxAttrNum> is_fd_;
 
+    std::unique_ptr<FDTreeElement, ChildDeleter> CreateChild() const;
+
     void AddRhsAttribute(size_t index);
 
     [[nodiscard]] model::Bitset<kMaxAttrNum> const& GetRhsAttributes() const;
@@ -1,11 +1,15 @@
 #include "core/algorithms/fd/fdep/fdep.h"
 
 #include <chrono>
+#include <memory>
+#include <optional>
 
 #include "core/config/equal_nulls/option.h"
 #include "core/config/tabular_data/input_table/option.h"
+#include "core/config/thread_number/option.h"
 #include "core/model/table/column_layout_relation_data.h"
 #include "core/model/types/bitset.h"
+#include "core/util/worker_thread_pool.h"
 
 // #ifndef PRINT_FDS
 // #define PRINT_FDS
@@ -20,6 +24,11 @@ FDep::FDep() : FDAlgorithm() {
 
 void FDep::RegisterOptions() {
     RegisterOption(config::kTableOpt(&input_table_));
+    RegisterOption(config::kThreadNumberOpt(&threads_));
+}
+
+void FDep::MakeExecuteOptsAvailableFDInternal() {
+    MakeOptionsAvailable({config::kThreadNumberOpt.GetName()});
 }
 
 void FDep::LoadDataInternal() {
@@ -36,15 +45,7 @@ void FDep::LoadDataInternal() {
         schema_->AppendColumn(column_names_[i]);
     }
 
-    std::vector<std::string> next_line;
-    while (input_table_->HasNextRow()) {
-        next_line = input_table_->GetNextRow();
-        if (next_line.empty()) break;
-        tuples_.emplace_back(std::vector<size_t>(number_attributes_));
-        for (size_t i = 0; i < number_attributes_; ++i) {
-            tuples_.back()[i] = std::hash<std::string>{}(next_line[i]);
-        }
-    }
+    tuples_ = model::TupleMatrix::ReadTable(*input_table_);
 }
 
 void FDep::ResetStateFd() {
@@ -58,9 +59,9 @@ unsigned long long FDep::ExecuteInternal() {
 
     BuildNegativeCover();
 
-    this->tuples_.shrink_to_fit();
-
-    this->pos_cover_tree_ = std::make_unique<FDTreeElement>(this->number_attributes_);
+    // The positive cover only grows: generalizations found in it are unmarked, not removed
+    this->pos_cover_tree_ =
+            std::make_unique<FDTreeElement>(this->number_attributes_, GetArena().GetMonotonic());
     this->pos_cover_tree_->AddMostGeneralDependencies();
 
     model::Bitset<FDTreeElement::kMaxAttrNum> active_path;
@@ -79,24 +80,31 @@ unsigned long long FDep::ExecuteInternal() {
 }
 
 void FDep::BuildNegativeCover() {
-    this->neg_cover_tree_ = std::make_unique<FDTreeElement>(this->number_attributes_);
-    for (auto i = this->tuples_.begin(); i != this->tuples_.end(); ++i) {
-        for (auto j = i + 1; j != this->tuples_.end(); ++j) AddViolatedFDs(*i, *j);
+    // Filtering drops the nodes of the negative cover, which the pool can reuse
+    this->neg_cover_tree_ =
+            std::make_unique<FDTreeElement>(this->number_attributes_, GetArena().GetPool());
+    // Pairs of tuples with equal agree sets violate the same FDs, so each of them is added once
+    std::optional<util::WorkerThreadPool> pool;
+    if (threads_ > 1) {
+        pool.emplace(threads_);
     }
+    model::ColumnSetList const agree_sets =
+            this->tuples_.GetAllPairsAgreeSets(pool ? std::addressof(*pool) : nullptr);
+    for (size_t i = 0; i < agree_sets.Size(); ++i) AddViolatedFDs(agree_sets.GetRow(i));
 
     this->neg_cover_tree_->FilterSpecializations();
 }
 
-void FDep::AddViolatedFDs(std::vector<size_t> const& t1, std::vector<size_t> const& t2) {
-    model::Bitset<FDTreeElement::kMaxAttrNum> equal_attr((2 << this->number_attributes_) - 1);
-    equal_attr.reset(0);
+void FDep::AddViolatedFDs(model::ColumnSetList::Word const* agree_set) {
+    model::Bitset<FDTreeElement::kMaxAttrNum> equal_attr;
     model::Bitset<FDTreeElement::kMaxAttrNum> diff_attr;
 
     for (size_t attr = 0; attr < this->number_attributes_; ++attr) {
-        diff_attr[attr + 1] = (t1[attr] != t2[attr]);
+        bool const equal = model::ColumnSetList::Test(agree_set, attr);
+        equal_attr[attr + 1] = equal;
+        diff_attr[attr + 1] = !equal;
     }
 
-    equal_attr &= (~diff_attr);
     for (size_t attr = diff_attr._Find_first(); attr != FDTreeElement::kMaxAttrNum;
          attr = diff_attr._Find_next(attr)) {
         this->neg_cover_tree_->AddFunctionalDependency(equal_attr, attr);
@@ -7,8 +7,10 @@
 #include "core/algorithms/fd/fdep/fd_tree_element.h"
 #include "core/config/equal_nulls/type.h"
 #include "core/config/tabular_data/input_table_type.h"
+#include "core/config/thread_number/type.h"
 #include "core/model/table/relation_data.h"
 #include "core/model/table/relational_schema.h"
+#include "core/model/table/tuple_matrix.h"
 #include "core/model/types/bitset.h"
 
 namespace algos {
@@ -21,6 +23,7 @@ public:
 
 private:
     config::InputTable input_table_;
+    config::ThreadNumType threads_ = 1;
 
     std::shared_ptr<RelationalSchema> schema_{};
 
@@ -30,9 +33,10 @@ private:
     std::unique_ptr<FDTreeElement> neg_cover_tree_{};
     std::unique_ptr<FDTreeElement> pos_cover_tree_{};
 
-    std::vector<std::vector<size_t>> tuples_;
+    model::TupleMatrix tuples_;
 
     void RegisterOptions();
+    void MakeExecuteOptsAvailableFDInternal() final;
 
     void LoadDataInternal() final;
 
@@ -42,9 +46,8 @@ private:
     // Building negative cover via violated dependencies
     void BuildNegativeCover();
 
-    // Iterating over all pairs t1 and t2 of the relation
-    // Adding violated FDs to negative cover tree.
-    void AddViolatedFDs(std::vector<size_t> const& t1, std::vector<size_t> const& t2);
+    // Adding FDs violated by a pair of tuples with the given agree set to negative cover tree.
+    void AddViolatedFDs(model::ColumnSetList::Word const* agree_set);
 
     // Converting negative cover tree into positive cover tree
     void CalculatePositiveCover(FDTreeElement const& neg_cover_subtree,
@@ -12,13 +12,14 @@ namespace algos::hy::util {
 std::vector<ClusterId> SortAndGetMapping(PLIs& plis);
 Columns BuildInvertedPlis(PLIs const& plis);
 Rows BuildRecordRepresentation(Columns const& inverted_plis);
-PLIs BuildPLIs(ColumnLayoutRelationData* relation);
+PLIs BuildPLIs(ColumnLayoutRelationData const* relation);
 
 }  // namespace algos::hy::util
 
 namespace algos::hy {
 
-std::tuple<PLIs, Rows, std::vector<ClusterId>> Preprocess(ColumnLayoutRelationData* relation);
+std::tuple<PLIs, Rows, std::vector<ClusterId>> Preprocess(
+        ColumnLayoutRelationData const* relation);
 boost::dynamic_bitset<> RestoreAgreeSet(boost::dynamic_bitset<> const& as,
                                         std::vector<ClusterId> const& og_mapping, size_t num_cols);
 
@@ -1,5 +1,6 @@
 #pragma once
 
+#include <deque>
 #include <memory>
 #include <queue>
 #include <vector>
@@ -26,6 +27,8 @@ private:
     double efficiency_threshold_ = kEfficiencyThreshold;
 
     PLIsPtr plis_;
+    // PLIs belong to the relation, which may be shared, so clusters are sorted in a copy
+    std::vector<std::deque<model::PLI::Cluster>> sorted_clusters_;
     RowsPtr compressed_records_;
     std::priority_queue<Efficiency> efficiency_queue_;
     std::unique_ptr<AllColumnCombinations> agree_sets_;
@@ -43,11 +46,13 @@ private:
 
     void Match(boost::dynamic_bitset<>& attributes, size_t first_record_id,
                size_t second_record_id);
+    std::deque<model::PLI::Cluster> const& GetClusters(size_t attr) const;
     template <typename F>
-    void RunWindowImpl(Efficiency& efficiency, model::PositionListIndex const& pli, F store_match);
-    std::vector<boost::dynamic_bitset<>> RunWindowRet(Efficiency& efficiency,
-                                                      model::PositionListIndex const& pli);
-    void RunWindow(Efficiency& efficiency, model::PositionListIndex const& pli);
+    void RunWindowImpl(Efficiency& efficiency, std::deque<model::PLI::Cluster> const& clusters,
+                       F store_match);
+    std::vector<boost::dynamic_bitset<>> RunWindowRet(
+            Efficiency& efficiency, std::deque<model::PLI::Cluster> const& clusters);
+    void RunWindow(Efficiency& efficiency, std::deque<model::PLI::Cluster> const& clusters);
 
 public:
     Sampler(PLIsPtr plis, RowsPtr pli_records, config::ThreadNumType threads = 1);
@@ -39,14 +39,16 @@ unsigned long long HyFD::ExecuteInternal() {
 
     Sampler sampler(plis_shared, pli_records_shared, threads_num_);
 
+    // the tree is shared by the inductor and the validator, both of which end with the run
     auto const positive_cover_tree =
-            std::make_shared<fd_tree::FDTree>(GetRelation().GetNumColumns());
+            std::make_shared<fd_tree::FDTree>(GetRelation().GetNumColumns(), GetArena().GetPool());
     Inductor inductor(positive_cover_tree);
-    Validator validator(positive_cover_tree, plis_shared, pli_records_shared, threads_num_);
+    Validator validator(positive_cover_tree, plis_shared, pli_records_shared, threads_num_,
+                        &GetCancellationToken());
 
     IdPairs comparison_suggestions;
 
-    while (true) {
+    while (!ShouldStop()) {
         auto non_fds = sampler.GetNonFDs(comparison_suggestions);
 
         inductor.UpdateFdTree(std::move(non_fds));
@@ -61,6 +63,19 @@ unsigned long long HyFD::ExecuteInternal() {
     }
 
     auto fds = positive_cover_tree->FillFDs();
+    if (ShouldStop()) {
+        /* Candidates below the validator's level have been checked against the whole table */
+        auto unchecked = std::ranges::partition(fds, [&validator](RawFD const& fd) {
+            return fd.lhs_.count() < validator.GetLevelNum();
+        });
+        std::vector<RawFD> frontier(std::make_move_iterator(unchecked.begin()),
+                                    std::make_move_iterator(unchecked.end()));
+        fds.erase(unchecked.begin(), unchecked.end());
+        for (RawFD& fd : frontier) {
+            if (fd.lhs_.count() > max_lhs_) continue;
+            candidate_frontier_.push_back(RestoreFD(std::move(fd), og_mapping));
+        }
+    }
     RegisterFDs(std::move(fds), og_mapping);
 
     auto elapsed_milliseconds = std::chrono::duration_cast<std::chrono::milliseconds>(
@@ -68,17 +83,21 @@ unsigned long long HyFD::ExecuteInternal() {
     return elapsed_milliseconds.count();
 }
 
-void HyFD::RegisterFDs(std::vector<RawFD>&& fds, std::vector<hy::ClusterId> const& og_mapping) {
+FD HyFD::RestoreFD(RawFD&& fd, std::vector<hy::ClusterId> const& og_mapping) const {
     auto const* const schema = GetRelation().GetSchema();
-    for (auto&& [lhs, rhs] : fds) {
-        boost::dynamic_bitset<> mapped_lhs =
-                hy::RestoreAgreeSet(lhs, og_mapping, schema->GetNumColumns());
-        Vertical lhs_v(schema, std::move(mapped_lhs));
+    boost::dynamic_bitset<> mapped_lhs =
+            hy::RestoreAgreeSet(fd.lhs_, og_mapping, schema->GetNumColumns());
+    Vertical lhs_v(schema, std::move(mapped_lhs));
 
-        auto const mapped_rhs = og_mapping[rhs];
-        Column rhs_c(schema, schema->GetColumn(mapped_rhs)->GetName(), mapped_rhs);
+    auto const mapped_rhs = og_mapping[fd.rhs_];
+    Column rhs_c(schema, schema->GetColumn(mapped_rhs)->GetName(), mapped_rhs);
 
-        RegisterFd(std::move(lhs_v), std::move(rhs_c), relation_->GetSharedPtrSchema());
+    return FD(std::move(lhs_v), std::move(rhs_c), relation_->GetSharedPtrSchema());
+}
+
+void HyFD::RegisterFDs(std::vector<RawFD>&& fds, std::vector<hy::ClusterId> const& og_mapping) {
+    for (RawFD& fd : fds) {
+        RegisterFd(RestoreFD(std::move(fd), og_mapping));
     }
 }
 
@@ -42,6 +42,7 @@ private:
 
     unsigned long long ExecuteInternal() override;
 
+    FD RestoreFD(RawFD&& fd, std::vector<algos::hy::ClusterId> const& og_mapping) const;
     void RegisterFDs(std::vector<RawFD>&& fds, std::vector<algos::hy::ClusterId> const& og_mapping);
 
     void MakeExecuteOptsAvailableFDInternal() override;
@@ -1,6 +1,7 @@
 #pragma once
 
 #include <memory>
+#include <memory_resource>
 #include <vector>
 
 #include <boost/dynamic_bitset.hpp>
@@ -22,7 +23,14 @@ private:
     std::shared_ptr<FDTreeVertex> root_;
 
 public:
-    explicit FDTree(size_t num_attributes) : root_(std::make_shared<FDTreeVertex>(num_attributes)) {
+    /**
+     * @param resource memory resource the vertices of the tree are allocated from
+     */
+    explicit FDTree(size_t num_attributes,
+                    std::pmr::memory_resource* resource = std::pmr::get_default_resource())
+        : root_(std::allocate_shared<FDTreeVertex>(
+                  std::pmr::polymorphic_allocator<FDTreeVertex>(resource), num_attributes,
+                  resource)) {
         for (size_t id = 0; id < num_attributes; id++) {
             root_->SetFd(id);
         }
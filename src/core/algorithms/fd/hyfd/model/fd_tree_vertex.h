@@ -1,6 +1,7 @@
 #pragma once
 
 #include <memory>
+#include <memory_resource>
 #include <utility>
 #include <vector>
 
@@ -28,7 +29,10 @@ using LhsPair = std::pair<std::shared_ptr<FDTreeVertex>, boost::dynamic_bitset<>
  */
 class FDTreeVertex : public std::enable_shared_from_this<FDTreeVertex> {
 private:
-    std::vector<std::shared_ptr<FDTreeVertex>> children_;
+    /**
+     * Children are allocated from the memory resource of this vector
+     */
+    std::pmr::vector<std::shared_ptr<FDTreeVertex>> children_;
     boost::dynamic_bitset<> fds_;
 
     /**
@@ -84,7 +88,9 @@ private:
         }
 
         if (!ContainsChildAt(pos)) {
-            children_[pos] = std::make_shared<FDTreeVertex>(num_attributes_);
+            auto const allocator = children_.get_allocator();
+            children_[pos] = std::allocate_shared<FDTreeVertex>(allocator, num_attributes_,
+                                                                allocator.resource());
             children_count_++;
             return true;
         }
@@ -109,8 +115,13 @@ private:
     void FillFDs(std::vector<RawFD>& fds, boost::dynamic_bitset<>& lhs) const;
 
 public:
-    explicit FDTreeVertex(size_t numAttributes) noexcept
-        : fds_(numAttributes), attributes_(numAttributes), num_attributes_(numAttributes) {}
+    explicit FDTreeVertex(
+            size_t numAttributes,
+            std::pmr::memory_resource* resource = std::pmr::get_default_resource()) noexcept
+        : children_(resource),
+          fds_(numAttributes),
+          attributes_(numAttributes),
+          num_attributes_(numAttributes) {}
 
     size_t GetNumAttributes() const noexcept {
         return num_attributes_;
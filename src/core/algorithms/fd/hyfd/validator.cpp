@@ -286,6 +286,9 @@ algos::hy::IdPairs Validator::ValidateAndExtendCandidates() {
     size_t previous_num_invalid_fds = 0;
     algos::hy::IdPairs comparison_suggestions;
     while (!cur_level_vertices.empty()) {
+        if (cancellation_token_ != nullptr && cancellation_token_->IsStopRequested()) {
+            return {};
+        }
         FDValidations result;
         if (threads_num_ > 1) {
             result = ValidateAndExtendPar(cur_level_vertices);
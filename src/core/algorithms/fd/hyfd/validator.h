@@ -10,6 +10,7 @@
 #include "core/config/thread_number/type.h"
 #include "core/model/table/position_list_index.h"
 #include "core/model/types/types.h"
+#include "core/util/cancellation_token.h"
 
 namespace algos::hyfd {
 
@@ -36,20 +37,25 @@ private:
 
     FDValidations ValidateAndExtendPar(std::vector<LhsPair> const& vertices);
 
-    [[nodiscard]] unsigned GetLevelNum() const {
-        return current_level_number_;
-    }
-
     config::ThreadNumType threads_num_ = 1;
+    util::CancellationToken const* cancellation_token_;
 
 public:
     Validator(std::shared_ptr<fd_tree::FDTree> fds, hy::PLIsPtr plis,
-              hy::RowsPtr compressed_records, config::ThreadNumType threads_num) noexcept
+              hy::RowsPtr compressed_records, config::ThreadNumType threads_num,
+              util::CancellationToken const* cancellation_token = nullptr) noexcept
         : fds_(std::move(fds)),
           plis_(std::move(plis)),
           compressed_records_(std::move(compressed_records)),
-          threads_num_(threads_num) {}
+          threads_num_(threads_num),
+          cancellation_token_(cancellation_token) {}
+
+    /* All candidates with fewer LHS attributes than this are validated FDs */
+    [[nodiscard]] unsigned GetLevelNum() const {
+        return current_level_number_;
+    }
 
+    /* Returns no suggestions both when the tree is fully validated and when stopped early */
     hy::IdPairs ValidateAndExtendCandidates();
 };
 
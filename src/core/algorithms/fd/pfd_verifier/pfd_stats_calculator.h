@@ -10,7 +10,7 @@ namespace algos {
 
 class PFDStatsCalculator {
 private:
-    std::shared_ptr<ColumnLayoutRelationData> relation_;
+    std::shared_ptr<ColumnLayoutRelationData const> relation_;
     config::PfdErrorMeasureType error_measure_;
 
     std::vector<model::PLI::Cluster> clusters_violating_pfd_;
@@ -18,7 +18,7 @@ private:
     config::ErrorType error_ = 0.0;
 
 public:
-    explicit PFDStatsCalculator(std::shared_ptr<ColumnLayoutRelationData> relation,
+    explicit PFDStatsCalculator(std::shared_ptr<ColumnLayoutRelationData const> relation,
                                 config::PfdErrorMeasureType measure)
         : relation_(std::move(relation)), error_measure_(measure) {}
 
@@ -48,7 +48,8 @@ public:
                              model::PositionListIndex const* xa_pli) {
         using Cluster = model::PLI::Cluster;
         std::deque<Cluster> xa_index = xa_pli->GetIndex();
-        std::shared_ptr<Cluster const> probing_table = x_pli->CalculateAndGetProbingTable();
+        std::shared_ptr<std::vector<int> const> probing_table =
+                x_pli->CalculateAndGetProbingTable();
         std::sort(xa_index.begin(), xa_index.end(),
                   [&probing_table](Cluster const& a, Cluster const& b) {
                       return probing_table->at(a.front()) < probing_table->at(b.front());
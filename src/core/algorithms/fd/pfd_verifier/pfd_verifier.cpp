@@ -9,6 +9,7 @@
 #include "core/config/indices/option.h"
 #include "core/config/names.h"
 #include "core/config/tabular_data/input_table/option.h"
+#include "core/model/table/dataset.h"
 
 namespace algos {
 
@@ -26,7 +27,7 @@ void PFDVerifier::MakeExecuteOptsAvailable() {
 }
 
 void PFDVerifier::LoadDataInternal() {
-    relation_ = ColumnLayoutRelationData::CreateFrom(*input_table_);
+    relation_ = model::LoadRelation(*input_table_);
     if (relation_->GetColumnData().empty()) {
         throw std::runtime_error("Got an empty dataset: pFD verifying is meaningless.");
     }
@@ -2,6 +2,7 @@
 
 #include "core/config/equal_nulls/option.h"
 #include "core/config/tabular_data/input_table/option.h"
+#include "core/model/table/dataset.h"
 
 namespace algos {
 
@@ -15,7 +16,7 @@ void PliBasedFDAlgorithm::RegisterOptions() {
 }
 
 void PliBasedFDAlgorithm::LoadDataInternal() {
-    relation_ = ColumnLayoutRelationData::CreateFrom(*input_table_);
+    relation_ = model::LoadRelation(*input_table_);
 
     if (relation_->GetColumnData().empty()) {
         throw std::runtime_error("Got an empty dataset: FD mining is meaningless.");
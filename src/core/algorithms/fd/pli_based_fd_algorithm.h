@@ -16,7 +16,7 @@ class PliBasedFDAlgorithm : public FDAlgorithm {
     void LoadDataInternal() final;
 
 protected:
-    std::shared_ptr<ColumnLayoutRelationData> relation_;
+    std::shared_ptr<ColumnLayoutRelationData const> relation_;
 
     ColumnLayoutRelationData const& GetRelation() const noexcept {
         // GetRelation should be called after the dataset has been parsed, i.e. after algorithm
@@ -1,7 +1,10 @@
 #include "core/algorithms/fd/pyro/pyro.h"
 
+#include <algorithm>
+#include <atomic>
 #include <chrono>
 #include <mutex>
+#include <optional>
 #include <thread>
 
 #include "core/algorithms/fd/pyrocommon/core/fd_g1_strategy.h"
@@ -14,11 +17,22 @@
 
 namespace algos {
 
-std::mutex search_spaces_mutex;
+namespace {
+// First-level launch pads of a split search space, taken one at a time by the workers sharing it
+struct SharedLaunchPads {
+    std::mutex mutex;
+    std::vector<DependencyCandidate> launch_pads;
+    std::size_t next = 0;
+};
+}  // namespace
 
 Pyro::Pyro() : PliBasedFDAlgorithm() {
     RegisterOptions();
     fd_consumer_ = [this](auto const& fd) {
+        {
+            std::scoped_lock lock(registered_lhss_mutex_);
+            if (!registered_lhss_[fd.rhs_.GetIndex()].insert(fd.lhs_).second) return;
+        }
         this->DiscoverFd(fd);
         this->FDAlgorithm::RegisterFd(fd.lhs_, fd.rhs_, relation_->GetSharedPtrSchema());
     };
@@ -40,6 +54,7 @@ void Pyro::MakeExecuteOptsAvailableFDInternal() {
 
 void Pyro::ResetStateFd() {
     search_spaces_.clear();
+    registered_lhss_.clear();
 }
 
 unsigned long long Pyro::ExecuteInternal() {
@@ -60,18 +75,21 @@ unsigned long long Pyro::ExecuteInternal() {
         throw std::runtime_error("Unknown comparator type");
     }
 
-    int next_id = 0;
-    for (auto& rhs : schema->GetColumns()) {
+    auto const create_search_space = [this, schema, &launch_pad_order](Column const* rhs) {
         std::unique_ptr<DependencyStrategy> strategy;
         if (parameters_.ucc_error_measure == "g1prime") {
-            strategy = std::make_unique<FdG1Strategy>(rhs.get(), parameters_.max_ucc_error,
+            strategy = std::make_unique<FdG1Strategy>(rhs, parameters_.max_ucc_error,
                                                       parameters_.error_dev);
         } else {
             throw std::runtime_error("Unknown key error measure.");
         }
-        search_spaces_.push_back(std::make_unique<SearchSpace>(next_id++, std::move(strategy),
-                                                               schema, launch_pad_order));
+        return std::make_unique<SearchSpace>(rhs->GetIndex(), std::move(strategy), schema,
+                                             launch_pad_order);
+    };
+    for (auto& rhs : schema->GetColumns()) {
+        search_spaces_.push_back(create_search_space(rhs.get()));
     }
+    registered_lhss_.resize(search_spaces_.size());
     unsigned long long init_time_millis = std::chrono::duration_cast<std::chrono::milliseconds>(
                                                   std::chrono::system_clock::now() - start_time)
                                                   .count();
@@ -81,34 +99,90 @@ unsigned long long Pyro::ExecuteInternal() {
     unsigned long long total_ascension = 0;
     unsigned long long total_trickle = 0;
 
-    auto const work_on_search_space = [](std::list<std::unique_ptr<SearchSpace>>& search_spaces,
-                                         ProfilingContext* profiling_context,
-                                         [[maybe_unused]] int id) {
-        while (true) {
+    // Search spaces are handed out through a shared cursor. Each worker has its own random
+    // generator and samples in the profiling context and publishes the samples it created after
+    // every search space, while the PLI cache is shared by all of them.
+    // With more workers than search spaces, every search space is split: its first-level launch
+    // pads are shared, and workers left without a search space of their own join the one with the
+    // most launch pads left, each in a helper search space with its own visitees.
+    bool const split_search_spaces = parameters_.parallelism > search_spaces_.size();
+    std::vector<SharedLaunchPads> shared_launch_pads(split_search_spaces ? search_spaces_.size()
+                                                                         : 0);
+    std::atomic<std::size_t> num_unsplit_search_spaces = search_spaces_.size();
+    auto const take_launch_pad = [&shared_launch_pads](std::size_t index) {
+        SharedLaunchPads& shared = shared_launch_pads[index];
+        std::scoped_lock lock(shared.mutex);
+        if (shared.next == shared.launch_pads.size()) return std::optional<DependencyCandidate>();
+        return std::optional<DependencyCandidate>(shared.launch_pads[shared.next++]);
+    };
+    auto const find_busiest_search_space = [&shared_launch_pads]() {
+        std::optional<std::size_t> busiest;
+        std::size_t most_left = 0;
+        for (std::size_t index = 0; index != shared_launch_pads.size(); ++index) {
+            SharedLaunchPads& shared = shared_launch_pads[index];
+            std::scoped_lock lock(shared.mutex);
+            std::size_t const left = shared.launch_pads.size() - shared.next;
+            if (left > most_left) {
+                most_left = left;
+                busiest = index;
+            }
+        }
+        return busiest;
+    };
+
+    std::atomic<std::size_t> next_search_space = 0;
+    auto const work_on_search_space = [&](ProfilingContext* profiling_context,
+                                          util::CancellationToken const* cancellation_token,
+                                          std::size_t id) {
+        profiling_context->AttachWorker(id);
+        while (!cancellation_token->IsStopRequested()) {
+            std::size_t const index = next_search_space.fetch_add(1, std::memory_order_relaxed);
             std::unique_ptr<SearchSpace> polled_space;
-            {
-                std::scoped_lock<std::mutex> lock(search_spaces_mutex);
-                if (search_spaces.empty()) {
-                    break;
+            if (index < search_spaces_.size()) {
+                LOG_TRACE("Thread {} got SearchSpace", id);
+                polled_space = std::move(search_spaces_[index]);
+                polled_space->SetContext(profiling_context);
+                if (split_search_spaces) {
+                    std::vector<DependencyCandidate> launch_pads =
+                            polled_space->SplitLaunchPads();
+                    {
+                        std::scoped_lock lock(shared_launch_pads[index].mutex);
+                        shared_launch_pads[index].launch_pads = std::move(launch_pads);
+                    }
+                    num_unsplit_search_spaces.fetch_sub(1, std::memory_order_release);
+                    polled_space->SetSharedLaunchPads(
+                            [&take_launch_pad, index]() { return take_launch_pad(index); });
+                }
+                polled_space->EnsureInitialized();
+            } else {
+                if (!split_search_spaces) break;
+                std::optional<std::size_t> busiest = find_busiest_search_space();
+                if (!busiest.has_value()) {
+                    if (num_unsplit_search_spaces.load(std::memory_order_acquire) == 0) break;
+                    std::this_thread::yield();
+                    continue;
                 }
-                polled_space = std::move(search_spaces.front());
-                search_spaces.pop_front();
+                LOG_TRACE("Thread {} joins SearchSpace {}", id, *busiest);
+                polled_space = create_search_space(schema->GetColumn(*busiest));
+                polled_space->SetContext(profiling_context);
+                polled_space->SetSharedLaunchPads(
+                        [&take_launch_pad, index = *busiest]() { return take_launch_pad(index); });
             }
-            LOG_TRACE("Thread {} got SearchSpace", id);
-            polled_space->SetContext(profiling_context);
-            polled_space->EnsureInitialized();
-            polled_space->Discover();
+            polled_space->Discover(cancellation_token);
+            profiling_context->PublishSamples();
         }
     };
 
+    std::size_t const num_threads = parameters_.parallelism;
     std::vector<std::thread> threads;
-    for (int i = 0; i < parameters_.parallelism; i++) {
-        threads.emplace_back(work_on_search_space, std::ref(search_spaces_),
-                             profiling_context.get(), i);
+    threads.reserve(num_threads);
+    for (std::size_t i = 0; i != num_threads; ++i) {
+        threads.emplace_back(work_on_search_space, profiling_context.get(),
+                             &GetCancellationToken(), i);
     }
 
-    for (int i = 0; i < parameters_.parallelism; i++) {
-        threads[i].join();
+    for (std::thread& thread : threads) {
+        thread.join();
     }
 
     auto elapsed_milliseconds = std::chrono::duration_cast<std::chrono::milliseconds>(
@@ -1,18 +1,25 @@
 #pragma once
 
-#include <list>
+#include <memory>
 #include <mutex>
+#include <unordered_set>
+#include <vector>
 
 #include "core/algorithms/fd/pli_based_fd_algorithm.h"
 #include "core/algorithms/fd/pyrocommon/core/dependency_consumer.h"
 #include "core/algorithms/fd/pyrocommon/core/search_space.h"
+#include "core/util/custom_hashes.h"
 
 namespace algos {
 
 /* Class for mining FD with pyro algorithm */
 class Pyro : public DependencyConsumer, public PliBasedFDAlgorithm {
 private:
-    std::list<std::unique_ptr<SearchSpace>> search_spaces_;
+    std::vector<std::unique_ptr<SearchSpace>> search_spaces_;
+    // lhs of the registered FDs by rhs index: workers sharing a search space may reach the same
+    // minimal dependency
+    std::vector<std::unordered_set<Vertical>> registered_lhss_;
+    std::mutex registered_lhss_mutex_;
 
     CachingMethod caching_method_ = CachingMethod::kCoin;
     CacheEvictionMethod eviction_method_ = CacheEvictionMethod::kDefault;
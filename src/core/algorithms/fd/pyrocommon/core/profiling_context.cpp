@@ -1,5 +1,9 @@
 #include "core/algorithms/fd/pyrocommon/core/profiling_context.h"
 
+#include <algorithm>
+#include <cassert>
+#include <stdexcept>
+#include <string>
 #include <utility>
 
 #include "core/algorithms/fd/pyrocommon/model/list_agree_set_sample.h"
@@ -9,8 +13,13 @@
 
 using std::shared_ptr;
 
+namespace {
+// index of the worker the current thread works as, see ProfilingContext::AttachWorker
+thread_local std::size_t current_worker = 0;
+}  // namespace
+
 ProfilingContext::ProfilingContext(algos::pyro::Parameters parameters,
-                                   ColumnLayoutRelationData* relation_data,
+                                   ColumnLayoutRelationData const* relation_data,
                                    std::function<void(PartialKey const&)> const& ucc_consumer,
                                    std::function<void(PartialFD const&)> const& fd_consumer,
                                    CachingMethod const& caching_method,
@@ -18,10 +27,16 @@ ProfilingContext::ProfilingContext(algos::pyro::Parameters parameters,
                                    double caching_method_value)
     : parameters_(std::move(parameters)),
       relation_data_(relation_data),
-      random_(parameters_.seed == 0 ? std::mt19937() : std::mt19937(parameters_.seed)),
-      custom_random_(parameters_.seed == 0 ? CustomRandom() : CustomRandom(parameters_.seed)) {
+      random_(parameters_.seed == 0 ? std::mt19937() : std::mt19937(parameters_.seed)) {
     ucc_consumer_ = ucc_consumer;
     fd_consumer_ = fd_consumer;
+    // worker 0 gets the seed a sequential run uses, so that one worker reproduces it exactly
+    long long const seed = parameters_.seed == 0 ? CustomRandom::kDefaultSeed : parameters_.seed;
+    std::size_t const num_workers = std::max<std::size_t>(parameters_.parallelism, 1);
+    workers_.reserve(num_workers);
+    for (std::size_t i = 0; i != num_workers; ++i) {
+        workers_.push_back({CustomRandom(seed + i), nullptr});
+    }
     // TODO: тут проявляется косяк, что unique_ptr<PLI> приходится отбирать у CLRD.
     //       SetSample и MaxEntropy требуют CLRD. Приходится плясать-переставлять методы
     //       да на самом деле в коде подразумевается, что в CLRD есть какая-то ссылка на PLI, так
@@ -37,6 +52,12 @@ ProfilingContext::ProfilingContext(algos::pyro::Parameters parameters,
                     static_cast<Vertical>(*column),
                     relation_data->GetColumnData(column->GetIndex()).GetPositionListIndex(), 1);
         }
+        if (num_workers > 1) {
+            for (WorkerState& worker : workers_) {
+                worker.agree_set_samples =
+                        std::make_unique<model::VerticalMap<model::AgreeSetSample>>(schema);
+            }
+        }
     } else {
         agree_set_samples_ = nullptr;
     }
@@ -52,6 +73,35 @@ ProfilingContext::ProfilingContext(algos::pyro::Parameters parameters,
 
 ProfilingContext::~ProfilingContext() = default;
 
+ProfilingContext::WorkerState& ProfilingContext::GetWorker() {
+    assert(current_worker < workers_.size());
+    return workers_[current_worker];
+}
+
+ProfilingContext::WorkerState const& ProfilingContext::GetWorker() const {
+    assert(current_worker < workers_.size());
+    return workers_[current_worker];
+}
+
+void ProfilingContext::AttachWorker(std::size_t index) {
+    if (index >= workers_.size()) {
+        throw std::out_of_range("Worker index " + std::to_string(index) +
+                                " exceeds the parallelism of the profiling context");
+    }
+    current_worker = index;
+}
+
+void ProfilingContext::PublishSamples() {
+    auto& local_samples = GetWorker().agree_set_samples;
+    if (local_samples == nullptr || local_samples->IsEmpty()) {
+        return;
+    }
+    for (auto& [focus, sample] : local_samples->EntrySet()) {
+        agree_set_samples_->Put(focus, std::const_pointer_cast<model::AgreeSetSample>(sample));
+    }
+    local_samples = std::make_unique<model::VerticalMap<model::AgreeSetSample>>(GetSchema());
+}
+
 double ProfilingContext::GetMaximumEntropy(ColumnLayoutRelationData const* relation_data) {
     auto& columns = relation_data->GetColumnData();
     auto max_column = std::max_element(columns.begin(), columns.end(), [](auto& cd1, auto& cd2) {
@@ -138,15 +188,16 @@ double ProfilingContext::SetMaximumEntropy(ColumnLayoutRelationData const* relat
 model::AgreeSetSample const* ProfilingContext::CreateFocusedSample(Vertical const& focus,
                                                                    double boost_factor) {
     auto pli = pli_cache_->GetOrCreateFor(focus, this);
-    auto pli_pointer = std::holds_alternative<model::PositionListIndex*>(pli)
-                               ? std::get<model::PositionListIndex*>(pli)
+    auto pli_pointer = std::holds_alternative<model::PositionListIndex const*>(pli)
+                               ? std::get<model::PositionListIndex const*>(pli)
                                : std::get<std::unique_ptr<model::PositionListIndex>>(pli).get();
     std::unique_ptr<model::ListAgreeSetSample> sample = model::ListAgreeSetSample::CreateFocusedFor(
             relation_data_, focus, pli_pointer, parameters_.sample_size * boost_factor,
-            custom_random_);
+            GetWorker().custom_random);
     LOG_TRACE("Creating sample focused on: {}", focus.ToString());
     auto sample_ptr = sample.get();
-    agree_set_samples_->Put(focus, std::move(sample));
+    auto& local_samples = GetWorker().agree_set_samples;
+    (local_samples != nullptr ? local_samples : agree_set_samples_)->Put(focus, std::move(sample));
     return sample_ptr;
 }
 
@@ -155,7 +206,7 @@ model::AgreeSetSample const* ProfilingContext::CreateColumnFocusedSample(
         double boost_factor) {
     std::unique_ptr<model::ListAgreeSetSample> sample = model::ListAgreeSetSample::CreateFocusedFor(
             relation_data_, focus, restriction_pli, parameters_.sample_size * boost_factor,
-            custom_random_);
+            GetWorker().custom_random);
     LOG_TRACE("Creating sample focused on: {}", focus.ToString());
     auto sample_ptr = sample.get();
     agree_set_samples_->Put(focus, std::move(sample));
@@ -165,10 +216,16 @@ model::AgreeSetSample const* ProfilingContext::CreateColumnFocusedSample(
 shared_ptr<model::AgreeSetSample const> ProfilingContext::GetAgreeSetSample(
         Vertical const& focus) const {
     shared_ptr<model::AgreeSetSample const> sample = nullptr;
-    for (auto& [key, next_sample] : agree_set_samples_->GetSubsetEntries(focus)) {
-        if (sample == nullptr || next_sample->GetSamplingRatio() > sample->GetSamplingRatio()) {
-            sample = next_sample;
+    auto const choose_best = [&sample](auto const& entries) {
+        for (auto& [key, next_sample] : entries) {
+            if (sample == nullptr || next_sample->GetSamplingRatio() > sample->GetSamplingRatio()) {
+                sample = next_sample;
+            }
         }
+    };
+    choose_best(agree_set_samples_->GetSubsetEntries(focus));
+    if (auto const& local_samples = GetWorker().agree_set_samples; local_samples != nullptr) {
+        choose_best(local_samples->GetSubsetEntries(focus));
     }
     return sample;
 }
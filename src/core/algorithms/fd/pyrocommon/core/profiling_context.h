@@ -1,7 +1,9 @@
 #pragma once
 
+#include <cstddef>
 #include <random>
 #include <string>
+#include <vector>
 
 #include "core/algorithms/fd/pyrocommon/core/dependency_consumer.h"
 #include "core/algorithms/fd/pyrocommon/core/parameters.h"
@@ -28,9 +30,21 @@ private:
     algos::pyro::Parameters parameters_;
     std::unique_ptr<model::PLICache> pli_cache_;
     std::unique_ptr<model::VerticalMap<model::AgreeSetSample>> agree_set_samples_;
-    ColumnLayoutRelationData* relation_data_;
+    ColumnLayoutRelationData const* relation_data_;
     std::mt19937 random_;
-    CustomRandom custom_random_;
+
+    // What each worker of a parallel run owns, so that the workers neither race on the random
+    // generator nor take the lock of the shared sample map for every sample they create.
+    struct WorkerState {
+        CustomRandom custom_random;
+        // samples created by the worker since it last published them to agree_set_samples_;
+        // nullptr if there is only one worker, which then writes to agree_set_samples_ directly
+        std::unique_ptr<model::VerticalMap<model::AgreeSetSample>> agree_set_samples;
+    };
+    std::vector<WorkerState> workers_;
+
+    WorkerState& GetWorker();
+    WorkerState const& GetWorker() const;
 
     model::AgreeSetSample const* CreateColumnFocusedSample(
             Vertical const& focus, model::PositionListIndex const* restriction_pli,
@@ -39,12 +53,20 @@ private:
 public:
     enum class ObjectToCache { kPli, kAs };
 
-    ProfilingContext(algos::pyro::Parameters parameters, ColumnLayoutRelationData* relation_data,
+    ProfilingContext(algos::pyro::Parameters parameters,
+                     ColumnLayoutRelationData const* relation_data,
                      std::function<void(PartialKey const&)> const& ucc_consumer,
                      std::function<void(PartialFD const&)> const& fd_consumer,
                      CachingMethod const& caching_method,
                      CacheEvictionMethod const& eviction_method, double caching_method_value);
 
+    /* Binds the calling thread to the state of the worker with the given index, which must be less
+     * than the parallelism of the parameters. Threads that were never bound use worker 0.
+     */
+    void AttachWorker(std::size_t index);
+    // Makes the samples created by the calling worker visible to all workers
+    void PublishSamples();
+
     // Non-const as RandomGenerator state gets changed
     model::AgreeSetSample const* CreateFocusedSample(Vertical const& focus, double boost_factor);
     std::shared_ptr<model::AgreeSetSample const> GetAgreeSetSample(Vertical const& focus) const;
@@ -77,11 +99,11 @@ public:
     // int NextInt(int upper_bound) { return std::uniform_int_distribution<int>{0,
     // upper_bound}(random_); }
     int NextInt(int upper_bound) {
-        return custom_random_.NextInt(upper_bound);
+        return GetWorker().custom_random.NextInt(upper_bound);
     }
 
     double NextDouble() {
-        return custom_random_.NextDouble();
+        return GetWorker().custom_random.NextDouble();
     }
 
     ~ProfilingContext() override;
@@ -8,9 +8,10 @@
 // TODO: extra careful with const& -> shared_ptr conversions via make_shared-smart pointer may
 // delete the object - pass empty deleter [](*) {}
 
-void SearchSpace::Discover() {
+void SearchSpace::Discover(util::CancellationToken const* cancellation_token) {
     LOG_TRACE("Discovering in: {}", static_cast<std::string>(*strategy_));
     while (true) {  // на второй итерации дропается
+        if (cancellation_token != nullptr && cancellation_token->IsStopRequested()) break;
         auto now = std::chrono::system_clock::now();
         std::optional<DependencyCandidate> launch_pad = PollLaunchPad();
         if (!launch_pad.has_value()) break;
@@ -31,10 +32,17 @@ void SearchSpace::Discover() {
 std::optional<DependencyCandidate> SearchSpace::PollLaunchPad() {
     while (true) {
         if (launch_pads_.empty()) {
-            if (deferred_launch_pads_.empty()) return std::optional<DependencyCandidate>();
+            std::optional<DependencyCandidate> shared_launch_pad;
+            if (shared_launch_pads_) shared_launch_pad = shared_launch_pads_();
 
-            launch_pads_.insert(deferred_launch_pads_.begin(), deferred_launch_pads_.end());
-            deferred_launch_pads_.clear();
+            if (shared_launch_pad.has_value()) {
+                AddLaunchPad(*shared_launch_pad);
+            } else {
+                if (deferred_launch_pads_.empty()) return std::optional<DependencyCandidate>();
+
+                launch_pads_.insert(deferred_launch_pads_.begin(), deferred_launch_pads_.end());
+                deferred_launch_pads_.clear();
+            }
         }
 
         auto launch_pad = launch_pads_.extract(launch_pads_.begin()).value();
@@ -143,6 +151,30 @@ void SearchSpace::AddLaunchPad(DependencyCandidate const& launch_pad) {
     launch_pad_index_->Put(launch_pad.vertical_, std::make_unique<DependencyCandidate>(launch_pad));
 }
 
+std::vector<DependencyCandidate> SearchSpace::SplitLaunchPads() {
+    EnsureInitialized();
+    std::vector<DependencyCandidate> split_launch_pads;
+    if (launch_pads_.size() != 1) return split_launch_pads;
+
+    DependencyCandidate const& root = *launch_pads_.begin();
+    if (root.vertical_.GetArity() != 0 || !root.IsExact() ||
+        root.error_.Get() <= strategy_->max_dependency_error_) {
+        return split_launch_pads;
+    }
+    launch_pad_index_->Remove(root.vertical_);
+    launch_pads_.clear();
+
+    // every candidate lhs is a superset of some single column, so these launch pads cover the
+    // search space just like escaping the empty one would
+    if (context_->GetParameters().max_lhs == 0) return split_launch_pads;
+    for (auto const& column : context_->GetSchema()->GetColumns()) {
+        if (strategy_->IsIrrelevantColumn(*column)) continue;
+        split_launch_pads.push_back(
+                strategy_->CreateDependencyCandidate(static_cast<Vertical>(*column)));
+    }
+    return split_launch_pads;
+}
+
 void SearchSpace::ReturnLaunchPad(DependencyCandidate const& launch_pad, bool is_defer) {
     if (is_defer && context_->GetParameters().is_defer_failed_launch_pads) {
         deferred_launch_pads_.push_back(launch_pad);
@@ -1,9 +1,12 @@
 #pragma once
 
+#include <functional>
 #include <list>
 #include <memory>
+#include <optional>
 #include <set>
 #include <utility>
+#include <vector>
 
 #include "core/algorithms/fd/pyrocommon/core/dependency_candidate.h"
 #include "core/algorithms/fd/pyrocommon/core/dependency_strategy.h"
@@ -12,6 +15,7 @@
 #include "core/model/table/relational_schema.h"
 #include "core/model/table/vertical.h"
 #include "core/model/table/vertical_map.h"
+#include "core/util/cancellation_token.h"
 
 class SearchSpace : public std::enable_shared_from_this<SearchSpace> {
 private:
@@ -24,6 +28,7 @@ private:
     std::set<DependencyCandidate, DependencyCandidateComp> launch_pads_;
     std::unique_ptr<model::VerticalMap<DependencyCandidate>> launch_pad_index_;
     std::list<DependencyCandidate> deferred_launch_pads_;
+    std::function<std::optional<DependencyCandidate>()> shared_launch_pads_;
     std::unique_ptr<model::VerticalMap<Vertical>> scope_;
     double sample_boost_;
     int recursion_depth_;
@@ -111,8 +116,21 @@ public:
                       dependency_candidate_comparator, 0, 1) {}
 
     void EnsureInitialized();
-    void Discover();
+    /* Stops between launch pads if the token requests it. Everything reported up to then is a
+     * minimal dependency: nested search spaces of the trickle-down phase always run to the end.
+     */
+    void Discover(util::CancellationToken const* cancellation_token = nullptr);
     void AddLaunchPad(DependencyCandidate const& launch_pad);
+    /* Lets several workers share the search space. If the empty lhs is not a dependency, takes
+     * out the launch pads that follow it, one per relevant column, and returns them; otherwise
+     * returns nothing and the search space is discovered as usual.
+     */
+    std::vector<DependencyCandidate> SplitLaunchPads();
+
+    /* Launch pads are polled from the source whenever the search space runs out of its own */
+    void SetSharedLaunchPads(std::function<std::optional<DependencyCandidate>()> source) {
+        shared_launch_pads_ = std::move(source);
+    }
 
     void SetContext(ProfilingContext* context) {
         context_ = context;
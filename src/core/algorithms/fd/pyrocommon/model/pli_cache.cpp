@@ -7,19 +7,20 @@
 
 namespace model {
 
-PositionListIndex* PLICache::Get(Vertical const& vertical) {
+PositionListIndex const* PLICache::Get(Vertical const& vertical) {
     return index_->Get(vertical).get();
 }
 
-PLICache::PLICache(ColumnLayoutRelationData* relation_data, CachingMethod caching_method,
+PLICache::PLICache(ColumnLayoutRelationData const* relation_data, CachingMethod caching_method,
                    CacheEvictionMethod eviction_method, double caching_method_value,
                    double min_entropy, double mean_entropy, double median_entropy,
                    double maximum_entropy, double median_gini, double median_inverted_entropy)
     : relation_data_(relation_data),
       // TODO: сделать
-      // index_(std::make_unique<VerticalMap<PositionListIndex>>(relation_data->GetSchema())) при
-      // одном потоке
-      index_(std::make_unique<BlockingVerticalMap<PositionListIndex>>(relation_data->GetSchema())),
+      // index_(std::make_unique<VerticalMap<PositionListIndex const>>(relation_data->GetSchema()))
+      // при одном потоке
+      index_(std::make_unique<BlockingVerticalMap<PositionListIndex const>>(
+              relation_data->GetSchema())),
       caching_method_(caching_method),
       eviction_method_(eviction_method),
       caching_method_value_(caching_method_value),
@@ -44,13 +45,12 @@ PLICache::~PLICache() {
 }
 
 // obtains or calculates a PositionListIndex using cache
-std::variant<PositionListIndex*, std::unique_ptr<PositionListIndex>> PLICache::GetOrCreateFor(
-        Vertical const& vertical, ProfilingContext* profiling_context) {
-    std::scoped_lock lock(getting_pli_mutex_);
+std::variant<PositionListIndex const*, std::unique_ptr<PositionListIndex>>
+PLICache::GetOrCreateFor(Vertical const& vertical, ProfilingContext* profiling_context) {
     LOG_DEBUG("PLI for {} requested: ", vertical.ToString());
 
     // is PLI already cached?
-    PositionListIndex* pli = Get(vertical);
+    PositionListIndex const* pli = Get(vertical);
     if (pli != nullptr) {
         pli->IncFreq();
         LOG_DEBUG("Served from PLI cache.");
@@ -63,10 +63,7 @@ std::variant<PositionListIndex*, std::unique_ptr<PositionListIndex>> PLICache::G
     std::vector<PositionListIndexRank> ranks;
     ranks.reserve(subset_entries.size());
     for (auto& [sub_vertical, sub_pli_ptr] : subset_entries) {
-        // TODO: избавиться от таких const_cast, которые сбрасывают константность
-        PositionListIndexRank pli_rank(&sub_vertical,
-                                       std::const_pointer_cast<PositionListIndex>(sub_pli_ptr),
-                                       sub_vertical.GetArity());
+        PositionListIndexRank pli_rank(&sub_vertical, sub_pli_ptr, sub_vertical.GetArity());
         ranks.push_back(pli_rank);
         if (!smallest_pli_rank || smallest_pli_rank->pli_->GetSize() > pli_rank.pli_->GetSize() ||
             (smallest_pli_rank->pli_->GetSize() == pli_rank.pli_->GetSize() &&
@@ -138,7 +135,8 @@ std::variant<PositionListIndex*, std::unique_ptr<PositionListIndex>> PLICache::G
     // TODO: тут не очень понятно: CachingProcess может забрать себе PLI, а может и отдать обратно,
     //  поэтому приходится через variant разбирать. Проверить, насколько много платим за обёртку.
     // Intersect and cache
-    std::variant<PositionListIndex*, std::unique_ptr<PositionListIndex>> variant_intersection_pli;
+    std::variant<PositionListIndex const*, std::unique_ptr<PositionListIndex>>
+            variant_intersection_pli;
     if (operands.size() >= profiling_context->GetParameters().nary_intersection_size) {
         PositionListIndexRank base_pli_rank = operands[0];
         auto intersection_pli = base_pli_rank.pli_->ProbeAll(
@@ -152,8 +150,8 @@ std::variant<PositionListIndex*, std::unique_ptr<PositionListIndex>> PLICache::G
         for (size_t i = 1; i < operands.size(); i++) {
             current_vertical = current_vertical.Union(*operands[i].vertical_);
             variant_intersection_pli =
-                    std::holds_alternative<PositionListIndex*>(variant_intersection_pli)
-                            ? std::get<PositionListIndex*>(variant_intersection_pli)
+                    std::holds_alternative<PositionListIndex const*>(variant_intersection_pli)
+                            ? std::get<PositionListIndex const*>(variant_intersection_pli)
                                       ->Intersect(operands[i].pli_.get())
                             : std::get<std::unique_ptr<PositionListIndex>>(variant_intersection_pli)
                                       ->Intersect(operands[i].pli_.get());
@@ -175,28 +173,36 @@ size_t PLICache::Size() const {
     return index_->GetSize();
 }
 
-std::variant<PositionListIndex*, std::unique_ptr<PositionListIndex>> PLICache::CachingProcess(
-        Vertical const& vertical, std::unique_ptr<PositionListIndex> pli,
-        ProfilingContext* profiling_context) {
-    auto pli_pointer = pli.get();
+std::variant<PositionListIndex const*, std::unique_ptr<PositionListIndex>>
+PLICache::CachingProcess(Vertical const& vertical, std::unique_ptr<PositionListIndex> pli,
+                         ProfilingContext* profiling_context) {
     switch (caching_method_) {
         case CachingMethod::kCoin:
             if (profiling_context->NextDouble() <
                 profiling_context->GetParameters().caching_probability) {
-                index_->Put(vertical, std::move(pli));
-                return pli_pointer;
+                return PutIfAbsent(vertical, std::move(pli));
             } else {
                 return pli;
             }
         case CachingMethod::kNoCaching:
             return pli;
         case CachingMethod::kAllCaching:
-            index_->Put(vertical, std::move(pli));
-            return pli_pointer;
+            return PutIfAbsent(vertical, std::move(pli));
         default:
             throw std::runtime_error(
                     "Only kNoCaching and kAllCaching strategies are currently available");
     }
 }
 
+PositionListIndex const* PLICache::PutIfAbsent(Vertical const& vertical,
+                                               std::unique_ptr<PositionListIndex> pli) {
+    std::scoped_lock lock(caching_mutex_);
+    if (auto cached_pli = index_->Get(vertical); cached_pli != nullptr) {
+        return cached_pli.get();
+    }
+    auto pli_pointer = pli.get();
+    index_->Put(vertical, std::move(pli));
+    return pli_pointer;
+}
+
 }  // namespace model
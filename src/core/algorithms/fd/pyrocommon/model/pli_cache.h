@@ -17,17 +17,18 @@ private:
     class PositionListIndexRank {
     public:
         Vertical const* vertical_;
-        std::shared_ptr<PositionListIndex> pli_;
+        std::shared_ptr<PositionListIndex const> pli_;
         int added_arity_;
 
-        PositionListIndexRank(Vertical const* vertical, std::shared_ptr<PositionListIndex> pli,
-                              int initial_arity)
+        PositionListIndexRank(Vertical const* vertical,
+                              std::shared_ptr<PositionListIndex const> pli, int initial_arity)
             : vertical_(vertical), pli_(pli), added_arity_(initial_arity) {}
     };
 
-    // using CacheMap = VerticalMap<PositionListIndex>;
-    ColumnLayoutRelationData* relation_data_;
-    std::unique_ptr<VerticalMap<PositionListIndex>> index_;
+    // using CacheMap = VerticalMap<PositionListIndex const>;
+    ColumnLayoutRelationData const* relation_data_;
+    // PLIs of single columns belong to the relation, which may be shared with other algorithms
+    std::unique_ptr<VerticalMap<PositionListIndex const>> index_;
     // usageCounter - for parallelism
 
     // All these MAYBE_UNUSED_PRIVATE_FIELD variables are required to support Pyro's caching
@@ -36,7 +37,10 @@ private:
 
     MAYBE_UNUSED_PRIVATE_FIELD int saved_intersections_ = 0;
 
-    mutable std::mutex getting_pli_mutex_;
+    // Serializes insertions only: lookups go through the map's own read lock and intersections are
+    // computed without any lock, so that the workers of a parallel run do not queue up behind a
+    // single PLI computation.
+    std::mutex caching_mutex_;
 
     CachingMethod caching_method_;
     MAYBE_UNUSED_PRIVATE_FIELD CacheEvictionMethod eviction_method_;
@@ -49,18 +53,22 @@ private:
     MAYBE_UNUSED_PRIVATE_FIELD double median_gini_;
     MAYBE_UNUSED_PRIVATE_FIELD double median_inverted_entropy_;
 
-    std::variant<PositionListIndex*, std::unique_ptr<PositionListIndex>> CachingProcess(
+    // Cached PLIs are never replaced: a PLI handed out to one worker stays alive until the cache is
+    // destroyed. If another worker has cached the same vertical meanwhile, its PLI is returned.
+    std::variant<PositionListIndex const*, std::unique_ptr<PositionListIndex>> CachingProcess(
             Vertical const& vertical, std::unique_ptr<PositionListIndex> pli,
             ProfilingContext* profiling_context);
+    PositionListIndex const* PutIfAbsent(Vertical const& vertical,
+                                         std::unique_ptr<PositionListIndex> pli);
 
 public:
-    PLICache(ColumnLayoutRelationData* relation_data, CachingMethod caching_method,
+    PLICache(ColumnLayoutRelationData const* relation_data, CachingMethod caching_method,
              CacheEvictionMethod eviction_method, double caching_method_value, double min_entropy,
              double mean_entropy, double median_entropy, double maximum_entropy, double median_gini,
              double median_inverted_entropy);
 
-    PositionListIndex* Get(Vertical const& vertical);
-    std::variant<PositionListIndex*, std::unique_ptr<PositionListIndex>> GetOrCreateFor(
+    PositionListIndex const* Get(Vertical const& vertical);
+    std::variant<PositionListIndex const*, std::unique_ptr<PositionListIndex>> GetOrCreateFor(
             Vertical const& vertical, ProfilingContext* profiling_context);
 
     void SetMaximumEntropy(double e) {
@@ -13,6 +13,7 @@
 #include "core/config/option_using.h"
 #include "core/config/tabular_data/input_table/option.h"
 #include "core/model/table/column_index.h"
+#include "core/model/table/dataset.h"
 #include "core/model/table/typed_column_data.h"
 
 namespace algos {
@@ -88,8 +89,7 @@ void Cords::ResetStateFd() {
 }
 
 void Cords::LoadDataInternal() {
-    typed_relation_ =
-            model::ColumnLayoutTypedRelationData::CreateFrom(*input_table_, is_null_equal_null_);
+    typed_relation_ = model::LoadTypedRelation(*input_table_, is_null_equal_null_);
 }
 
 bool Cords::DetectSFD(Sample const& smp) {
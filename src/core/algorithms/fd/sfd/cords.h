@@ -23,7 +23,7 @@ private:
     using CorrelationCollection = util::PrimitiveCollection<Correlation>;
     config::InputTable input_table_;
     config::EqNullsType is_null_equal_null_;
-    std::unique_ptr<TypedRelation> typed_relation_;
+    std::shared_ptr<TypedRelation const> typed_relation_;
 
     bool only_sfd_;
     bool fixed_sample_ = false;
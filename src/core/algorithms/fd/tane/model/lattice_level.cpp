@@ -8,15 +8,16 @@ namespace model {
 
 using std::move, std::min, std::shared_ptr, std::vector, std::sort, std::make_shared;
 
-void LatticeLevel::Add(std::unique_ptr<LatticeVertex> vertex) {
-    vertices_.emplace(vertex->GetVertical().GetColumnIndices(), std::move(vertex));
+void LatticeLevel::Add(LatticeVertex vertex) {
+    boost::dynamic_bitset<> column_indices = vertex.GetVertical().GetColumnIndices();
+    vertices_.emplace(std::move(column_indices), std::move(vertex));
 }
 
 LatticeVertex const* LatticeLevel::GetLatticeVertex(
         boost::dynamic_bitset<> const& column_indices) const {
     auto it = vertices_.find(column_indices);
     if (it != vertices_.end()) {
-        return it->second.get();
+        return &it->second;
     } else {
         return nullptr;
     }
@@ -30,13 +31,14 @@ void LatticeLevel::GenerateNextLevel(std::vector<std::unique_ptr<LatticeLevel>>&
     LatticeLevel* current_level = levels[arity].get();
 
     std::vector<LatticeVertex*> current_level_vertices;
-    for (auto const& [map_key, vertex] : current_level->GetVertices()) {
-        current_level_vertices.push_back(vertex.get());
+    for (auto& [map_key, vertex] : current_level->GetVertices()) {
+        current_level_vertices.push_back(&vertex);
     }
 
     std::sort(current_level_vertices.begin(), current_level_vertices.end(),
               LatticeVertex::Comparator);
-    auto next_level = std::make_unique<LatticeLevel>(arity + 1);
+    auto next_level = std::make_unique<LatticeLevel>(
+            arity + 1, current_level->vertices_.get_allocator().resource());
 
     for (unsigned int vertex_index_1 = 0; vertex_index_1 < current_level_vertices.size();
          vertex_index_1++) {
@@ -60,19 +62,18 @@ void LatticeLevel::GenerateNextLevel(std::vector<std::unique_ptr<LatticeLevel>>&
             }
 
             Vertical child_columns = vertex1->GetVertical().Union(vertex2->GetVertical());
-            std::unique_ptr<LatticeVertex> child_vertex =
-                    std::make_unique<LatticeVertex>(child_columns);
+            LatticeVertex child_vertex(child_columns);
 
             boost::dynamic_bitset<> parent_indices(
                     vertex1->GetVertical().GetSchema()->GetNumColumns());
             parent_indices |= vertex1->GetVertical().GetColumnIndices();
             parent_indices |= vertex2->GetVertical().GetColumnIndices();
 
-            child_vertex->GetRhsCandidates() |= vertex1->GetRhsCandidates();
-            child_vertex->GetRhsCandidates() &= vertex2->GetRhsCandidates();
-            child_vertex->SetKeyCandidate(vertex1->GetIsKeyCandidate() &&
-                                          vertex2->GetIsKeyCandidate());
-            child_vertex->SetInvalid(vertex1->GetIsInvalid() || vertex2->GetIsInvalid());
+            child_vertex.GetRhsCandidates() |= vertex1->GetRhsCandidates();
+            child_vertex.GetRhsCandidates() &= vertex2->GetRhsCandidates();
+            child_vertex.SetKeyCandidate(vertex1->GetIsKeyCandidate() &&
+                                         vertex2->GetIsKeyCandidate());
+            child_vertex.SetInvalid(vertex1->GetIsInvalid() || vertex2->GetIsInvalid());
 
             for (unsigned int i = 0, skip_index = parent_indices.find_first(); i < arity - 1;
                  i++, skip_index = parent_indices.find_next(skip_index)) {
@@ -83,25 +84,25 @@ void LatticeLevel::GenerateNextLevel(std::vector<std::unique_ptr<LatticeLevel>>&
                 if (parent_vertex == nullptr) {
                     goto continueMidOuter;
                 }
-                child_vertex->GetRhsCandidates() &= parent_vertex->GetConstRhsCandidates();
-                if (child_vertex->GetRhsCandidates().none()) {
+                child_vertex.GetRhsCandidates() &= parent_vertex->GetConstRhsCandidates();
+                if (child_vertex.GetRhsCandidates().none()) {
                     goto continueMidOuter;
                 }
-                child_vertex->GetParents().push_back(parent_vertex);
+                child_vertex.GetParents().push_back(parent_vertex);
                 parent_indices[skip_index] = true;
 
-                child_vertex->SetKeyCandidate(child_vertex->GetIsKeyCandidate() &&
-                                              parent_vertex->GetIsKeyCandidate());
-                child_vertex->SetInvalid(child_vertex->GetIsInvalid() ||
-                                         parent_vertex->GetIsInvalid());
+                child_vertex.SetKeyCandidate(child_vertex.GetIsKeyCandidate() &&
+                                             parent_vertex->GetIsKeyCandidate());
+                child_vertex.SetInvalid(child_vertex.GetIsInvalid() ||
+                                        parent_vertex->GetIsInvalid());
 
-                if (!child_vertex->GetIsKeyCandidate() && child_vertex->GetRhsCandidates().none()) {
+                if (!child_vertex.GetIsKeyCandidate() && child_vertex.GetRhsCandidates().none()) {
                     goto continueMidOuter;
                 }
             }
 
-            child_vertex->GetParents().push_back(vertex1);
-            child_vertex->GetParents().push_back(vertex2);
+            child_vertex.GetParents().push_back(vertex1);
+            child_vertex.GetParents().push_back(vertex2);
 
             next_level->Add(std::move(child_vertex));
 
@@ -125,7 +126,7 @@ void LatticeLevel::ClearLevelsBelow(std::vector<std::unique_ptr<LatticeLevel>>&
     // Clear child references
     if (arity < levels.size()) {
         for (auto& [map_key, retained_vertex] : levels[arity]->GetVertices()) {
-            retained_vertex->GetParents().clear();
+            retained_vertex.GetParents().clear();
         }
     }
 }
@@ -1,6 +1,7 @@
 #pragma once
 
 #include <map>
+#include <memory_resource>
 #include <vector>
 
 #include "core/algorithms/fd/tane/model/lattice_vertex.h"
@@ -8,23 +9,29 @@
 namespace model {
 
 class LatticeLevel {
+public:
+    /* The vertices are stored in the nodes of the map, which are taken from its memory resource */
+    using VertexMap = std::pmr::map<boost::dynamic_bitset<>, LatticeVertex>;
+
 private:
     unsigned int arity_;
-    std::map<boost::dynamic_bitset<>, std::unique_ptr<LatticeVertex>> vertices_;
+    VertexMap vertices_;
 
 public:
-    explicit LatticeLevel(unsigned int m_arity) : arity_(m_arity) {}
+    explicit LatticeLevel(unsigned int m_arity,
+                          std::pmr::memory_resource* resource = std::pmr::get_default_resource())
+        : arity_(m_arity), vertices_(resource) {}
 
     unsigned int GetArity() const {
         return arity_;
     }
 
-    std::map<boost::dynamic_bitset<>, std::unique_ptr<LatticeVertex>>& GetVertices() {
+    VertexMap& GetVertices() {
         return vertices_;
     }
 
     LatticeVertex const* GetLatticeVertex(boost::dynamic_bitset<> const& column_indices) const;
-    void Add(std::unique_ptr<LatticeVertex> vertex);
+    void Add(LatticeVertex vertex);
 
     // using vectors instead of lists because of .get()
     static void GenerateNextLevel(std::vector<std::unique_ptr<LatticeLevel>>& levels);
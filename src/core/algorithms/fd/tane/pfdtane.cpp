@@ -46,7 +46,8 @@ config::ErrorType PFDTane::CalculatePFDError(model::PositionListIndex const* x_p
                                              model::PositionListIndex const* xa_pli,
                                              PfdErrorMeasure measure) {
     std::deque<Cluster> xa_index = xa_pli->GetIndex();
-    std::shared_ptr<Cluster const> probing_table_ptr = x_pli->CalculateAndGetProbingTable();
+    std::shared_ptr<std::vector<int> const> probing_table_ptr =
+            x_pli->CalculateAndGetProbingTable();
     auto const& probing_table = *probing_table_ptr;
     std::stable_sort(xa_index.begin(), xa_index.end(),
                      [&probing_table](Cluster const& a, Cluster const& b) {
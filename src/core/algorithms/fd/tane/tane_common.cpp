@@ -36,17 +36,17 @@ void TaneCommon::Prune(model::LatticeLevel* level) {
     RelationalSchema const* schema = relation_->GetSchema();
     std::list<model::LatticeVertex*> key_vertices;
     for (auto& [map_key, vertex] : level->GetVertices()) {
-        Vertical columns = vertex->GetVertical();  // Originally it's a ColumnCombination
+        Vertical const& columns = vertex.GetVertical();  // Originally it's a ColumnCombination
 
-        if (vertex->GetIsKeyCandidate()) {
-            double ucc_error = CalculateUccError(vertex->GetPositionListIndex(), relation_.get());
+        if (vertex.GetIsKeyCandidate()) {
+            double ucc_error = CalculateUccError(vertex.GetPositionListIndex(), relation_.get());
             if (ucc_error <= max_ucc_error_) {  // If a key candidate is an approx UCC
 
-                vertex->SetKeyCandidate(false);
+                vertex.SetKeyCandidate(false);
                 if (ucc_error == 0) {
-                    for (std::size_t rhs_index = vertex->GetRhsCandidates().find_first();
+                    for (std::size_t rhs_index = vertex.GetRhsCandidates().find_first();
                          rhs_index != boost::dynamic_bitset<>::npos;
-                         rhs_index = vertex->GetRhsCandidates().find_next(rhs_index)) {
+                         rhs_index = vertex.GetRhsCandidates().find_next(rhs_index)) {
                         Vertical rhs = static_cast<Vertical>(*schema->GetColumn((int)rhs_index));
                         if (!columns.Contains(rhs)) {
                             bool is_rhs_candidate = true;
@@ -70,42 +70,62 @@ void TaneCommon::Prune(model::LatticeLevel* level) {
                             }
                         }
                     }
-                    key_vertices.push_back(vertex.get());
+                    key_vertices.push_back(&vertex);
                 }
             }
         }
         // if we seek for exact FDs then SetInvalid
         if (max_fd_error_ == 0 && max_ucc_error_ == 0) {
             for (auto key_vertex : key_vertices) {
-                key_vertex->GetRhsCandidates() &= key_vertex->GetVertical().GetColumnIndices();
+                key_vertex->GetRhsCandidates() &= key_vertex->GetVertical().GetColumnIndicesRef();
                 key_vertex->SetInvalid(true);
             }
         }
     }
 }
 
-void TaneCommon::ComputeDependencies(model::LatticeLevel* level) {
+void TaneCommon::AddToFrontier(model::LatticeVertex const& xa_vertex) {
     RelationalSchema const* schema = relation_->GetSchema();
-    for (auto& [key_map, xa_vertex] : level->GetVertices()) {
-        if (xa_vertex->GetIsInvalid()) {
+    Vertical const& xa = xa_vertex.GetVertical();
+    dynamic_bitset<> a_candidates = xa_vertex.GetConstRhsCandidates() & xa.GetColumnIndicesRef();
+    for (std::size_t a_index = a_candidates.find_first(); a_index != dynamic_bitset<>::npos;
+         a_index = a_candidates.find_next(a_index)) {
+        Column const& rhs = *schema->GetColumns()[a_index];
+        candidate_frontier_.emplace_back(xa.Without(rhs), rhs, relation_->GetSharedPtrSchema());
+    }
+}
+
+bool TaneCommon::ComputeDependencies(model::LatticeLevel* level) {
+    RelationalSchema const* schema = relation_->GetSchema();
+    auto& vertices = level->GetVertices();
+    for (auto vertex_it = vertices.begin(); vertex_it != vertices.end(); ++vertex_it) {
+        if (ShouldStop()) {
+            for (; vertex_it != vertices.end(); ++vertex_it) {
+                if (!vertex_it->second.GetIsInvalid()) AddToFrontier(vertex_it->second);
+            }
+            return false;
+        }
+        model::LatticeVertex& xa_vertex = vertex_it->second;
+        if (xa_vertex.GetIsInvalid()) {
             continue;
         }
-        Vertical xa = xa_vertex->GetVertical();
+        Vertical const& xa = xa_vertex.GetVertical();
         // Calculate XA PLI
-        if (xa_vertex->GetPositionListIndex() == nullptr) {
-            auto parent_pli_1 = xa_vertex->GetParents()[0]->GetPositionListIndexWithSingletons();
-            auto parent_pli_2 = xa_vertex->GetParents()[1]->GetPositionListIndexWithSingletons();
-            xa_vertex->AcquirePLIWithSingletons(parent_pli_1->Intersect(parent_pli_2));
+        if (xa_vertex.GetPositionListIndex() == nullptr) {
+            auto parent_pli_1 = xa_vertex.GetParents()[0]->GetPositionListIndexWithSingletons();
+            auto parent_pli_2 = xa_vertex.GetParents()[1]->GetPositionListIndexWithSingletons();
+            xa_vertex.AcquirePLIWithSingletons(
+                    parent_pli_1->Intersect(parent_pli_2, GetArena().GetPool()));
         }
 
-        dynamic_bitset<> xa_indices = xa.GetColumnIndices();
-        dynamic_bitset<> a_candidates = xa_vertex->GetRhsCandidates();
-        auto xa_pli = xa_vertex->GetPositionListIndexWithSingletons();
-        for (auto const& x_vertex : xa_vertex->GetParents()) {
+        dynamic_bitset<> const& xa_indices = xa.GetColumnIndicesRef();
+        dynamic_bitset<> a_candidates = xa_vertex.GetRhsCandidates();
+        auto xa_pli = xa_vertex.GetPositionListIndexWithSingletons();
+        for (auto const& x_vertex : xa_vertex.GetParents()) {
             Vertical const& lhs = x_vertex->GetVertical();
 
             // Find index of A in XA.
-            dynamic_bitset<> differing_bits = xa_indices ^ lhs.GetColumnIndices();
+            dynamic_bitset<> differing_bits = xa_indices ^ lhs.GetColumnIndicesRef();
             std::size_t a_index = differing_bits.find_first();
             if (!a_candidates[a_index]) {
                 continue;
@@ -118,13 +138,14 @@ void TaneCommon::ComputeDependencies(model::LatticeLevel* level) {
                 Column const* rhs = schema->GetColumns()[a_index].get();
 
                 RegisterAndCountFd(lhs, rhs);
-                xa_vertex->GetRhsCandidates().set(rhs->GetIndex(), false);
+                xa_vertex.GetRhsCandidates().set(rhs->GetIndex(), false);
                 if (error == 0) {
-                    xa_vertex->GetRhsCandidates() &= lhs.GetColumnIndices();
+                    xa_vertex.GetRhsCandidates() &= lhs.GetColumnIndices();
                 }
             }
         }
     }
+    return true;
 }
 
 unsigned long long TaneCommon::ExecuteInternal() {
@@ -147,24 +168,25 @@ unsigned long long TaneCommon::ExecuteInternal() {
 
     // Initialize level 0
     std::vector<std::unique_ptr<model::LatticeLevel>> levels;
-    auto level0 = std::make_unique<model::LatticeLevel>(0);
+    // the vertices and the PLIs computed for them live until the end of the run
+    auto level0 = std::make_unique<model::LatticeLevel>(0, GetArena().GetPool());
     // TODO: через указатели кажется надо переделать
-    level0->Add(std::make_unique<model::LatticeVertex>(schema->CreateEmptyVertical()));
-    model::LatticeVertex const* empty_vertex = level0->GetVertices().begin()->second.get();
+    level0->Add(model::LatticeVertex(schema->CreateEmptyVertical()));
+    model::LatticeVertex const* empty_vertex = &level0->GetVertices().begin()->second;
     levels.push_back(std::move(level0));
 
     // Initialize level1
     dynamic_bitset<> zeroary_fd_rhs(schema->GetNumColumns());
-    auto level1 = std::make_unique<model::LatticeLevel>(1);
+    auto level1 = std::make_unique<model::LatticeLevel>(1, GetArena().GetPool());
     for (auto& column : schema->GetColumns()) {
         // for each attribute set vertex
         ColumnData const& column_data = relation_->GetColumnData(column->GetIndex());
-        auto vertex = std::make_unique<model::LatticeVertex>(static_cast<Vertical>(*column));
+        model::LatticeVertex vertex(static_cast<Vertical>(*column));
 
-        vertex->AddRhsCandidates(schema->GetColumns());
-        vertex->GetParents().push_back(empty_vertex);
-        vertex->SetKeyCandidate(true);
-        vertex->SetPLIWithSingletons(column_data.GetPLWSIndex());
+        vertex.AddRhsCandidates(schema->GetColumns());
+        vertex.GetParents().push_back(empty_vertex);
+        vertex.SetKeyCandidate(true);
+        vertex.SetPLIWithSingletons(column_data.GetPLWSIndex());
 
         // check FDs: 0->A
         double fd_error = CalculateZeroAryFdError(&column_data);
@@ -172,9 +194,9 @@ unsigned long long TaneCommon::ExecuteInternal() {
             zeroary_fd_rhs.set(column->GetIndex());
             RegisterAndCountFd(schema->CreateEmptyVertical(), column.get());
 
-            vertex->GetRhsCandidates().set(column->GetIndex(), false);
+            vertex.GetRhsCandidates().set(column->GetIndex(), false);
             if (fd_error == 0) {
-                vertex->GetRhsCandidates().reset();
+                vertex.GetRhsCandidates().reset();
             }
         }
 
@@ -182,8 +204,8 @@ unsigned long long TaneCommon::ExecuteInternal() {
     }
 
     for (auto& [key_map, vertex] : level1->GetVertices()) {
-        Vertical column = vertex->GetVertical();
-        vertex->GetRhsCandidates() &=
+        Vertical const& column = vertex.GetVertical();
+        vertex.GetRhsCandidates() &=
                 ~zeroary_fd_rhs;  //~ returns flipped copy <- removed already discovered zeroary FDs
 
         // вот тут костыль, чтобы вытянуть индекс колонки из вершины, в которой только один индекс
@@ -191,19 +213,19 @@ unsigned long long TaneCommon::ExecuteInternal() {
                 relation_->GetColumnData(column.GetColumnIndices().find_first());
         double ucc_error = CalculateUccError(column_data.GetPositionListIndex(), relation_.get());
         if (ucc_error <= max_ucc_error_) {
-            vertex->SetKeyCandidate(false);
+            vertex.SetKeyCandidate(false);
             if (ucc_error == 0 && max_lhs_ != 0) {
-                for (unsigned long rhs_index = vertex->GetRhsCandidates().find_first();
-                     rhs_index < vertex->GetRhsCandidates().size();
-                     rhs_index = vertex->GetRhsCandidates().find_next(rhs_index)) {
+                for (unsigned long rhs_index = vertex.GetRhsCandidates().find_first();
+                     rhs_index < vertex.GetRhsCandidates().size();
+                     rhs_index = vertex.GetRhsCandidates().find_next(rhs_index)) {
                     if (rhs_index != column.GetColumnIndices().find_first()) {
                         RegisterAndCountFd(column, schema->GetColumn(rhs_index));
                     }
                 }
-                vertex->GetRhsCandidates() &= column.GetColumnIndices();
+                vertex.GetRhsCandidates() &= column.GetColumnIndices();
                 // set vertex invalid if we seek for exact dependencies
                 if (max_fd_error_ == 0 && max_ucc_error_ == 0) {
-                    vertex->SetInvalid(true);
+                    vertex.SetInvalid(true);
                 }
             }
         }
@@ -222,7 +244,11 @@ unsigned long long TaneCommon::ExecuteInternal() {
             break;
         }
 
-        ComputeDependencies(level);
+        if (!ComputeDependencies(level)) {
+            LOG_DEBUG("Stopped at level {}, {} candidates left.", arity,
+                      candidate_frontier_.size());
+            break;
+        }
 
         if (arity == max_arity) {
             break;
@@ -18,7 +18,9 @@ private:
     void ResetStateFd() final {}
 
     void Prune(model::LatticeLevel* level);
-    void ComputeDependencies(model::LatticeLevel* level);
+    /* Returns false if stopped early, the unchecked candidates are then in the frontier */
+    bool ComputeDependencies(model::LatticeLevel* level);
+    void AddToFrontier(model::LatticeVertex const& xa_vertex);
     unsigned long long ExecuteInternal() final;
     virtual config::ErrorType CalculateZeroAryFdError(ColumnData const* rhs) = 0;
     virtual config::ErrorType CalculateFdError(model::PLIWS const* lhs_pli,
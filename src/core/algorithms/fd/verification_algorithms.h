@@ -1,4 +1,5 @@
 #pragma once
 
+#include "core/algorithms/fd/fd_verifier/batch_verifier.h"
 #include "core/algorithms/fd/fd_verifier/fd_verifier.h"
 #include "core/algorithms/fd/pfd_verifier/pfd_verifier.h"
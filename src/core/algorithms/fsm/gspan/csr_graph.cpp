@@ -0,0 +1,60 @@
+#include "csr_graph.h"
+
+#include <numeric>
+#include <tuple>
+
+#include <boost/range/iterator_range.hpp>
+
+namespace gspan {
+
+namespace {
+
+// Fills the CSR arrays from a list of undirected edges {vertex1, vertex2, label}
+void BuildAdjacency(std::size_t num_vertices, std::vector<std::tuple<int, int, int>> const& edges,
+                    std::vector<std::size_t>& offsets,
+                    std::vector<CsrGraph::Neighbor>& neighbors) {
+    offsets.assign(num_vertices + 1, 0);
+    for (auto const& [v1, v2, label] : edges) {
+        ++offsets[v1 + 1];
+        ++offsets[v2 + 1];
+    }
+    std::partial_sum(offsets.begin(), offsets.end(), offsets.begin());
+
+    std::vector<std::size_t> next(offsets.begin(), offsets.end() - 1);
+    neighbors.resize(offsets.back());
+    for (auto const& [v1, v2, label] : edges) {
+        neighbors[next[v1]++] = {v2, label};
+        neighbors[next[v2]++] = {v1, label};
+    }
+}
+
+}  // namespace
+
+CsrGraph::CsrGraph(graph_t const& graph) : original_id_(graph[boost::graph_bundle].original_id) {
+    vertex_labels_.reserve(boost::num_vertices(graph));
+    for (auto vertex : boost::make_iterator_range(boost::vertices(graph))) {
+        vertex_labels_.push_back(graph[vertex].label);
+    }
+
+    std::vector<std::tuple<int, int, int>> edges;
+    edges.reserve(boost::num_edges(graph));
+    for (auto edge : boost::make_iterator_range(boost::edges(graph))) {
+        int v1 = boost::source(edge, graph);
+        int v2 = boost::target(edge, graph);
+        if (v1 != v2) {
+            edges.emplace_back(v1, v2, graph[edge].label);
+        }
+    }
+    BuildAdjacency(vertex_labels_.size(), edges, offsets_, neighbors_);
+}
+
+CsrGraph::CsrGraph(DFSCode const& code) : vertex_labels_(code.GetVertexLabels()) {
+    std::vector<std::tuple<int, int, int>> edges;
+    edges.reserve(code.Size());
+    for (ExtendedEdge const& ee : code.GetExtendedEdges()) {
+        edges.emplace_back(ee.vertex1.id, ee.vertex2.id, ee.label);
+    }
+    BuildAdjacency(vertex_labels_.size(), edges, offsets_, neighbors_);
+}
+
+}  // namespace gspan
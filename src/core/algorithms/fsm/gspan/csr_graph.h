@@ -0,0 +1,51 @@
+#pragma once
+
+#include <cstddef>
+#include <span>
+#include <vector>
+
+#include "dfscode.h"
+#include "graph.h"
+
+namespace gspan {
+
+// A graph of the database in compressed sparse row layout: the neighbors of vertex v are
+// stored contiguously, from offsets[v] to offsets[v + 1].
+class CsrGraph {
+public:
+    struct Neighbor {
+        int vertex;
+        int edge_label;
+    };
+
+private:
+    std::vector<int> vertex_labels_;
+    std::vector<std::size_t> offsets_;
+    std::vector<Neighbor> neighbors_;
+    int original_id_ = -1;
+
+public:
+    CsrGraph() = default;
+    // Self-loops are left out, as no pattern can contain them
+    explicit CsrGraph(graph_t const& graph);
+    // The graph described by a DFS code
+    explicit CsrGraph(DFSCode const& code);
+
+    std::size_t NumVertices() const {
+        return vertex_labels_.size();
+    }
+
+    int GetLabel(int vertex) const {
+        return vertex_labels_[vertex];
+    }
+
+    std::span<Neighbor const> GetNeighbors(int vertex) const {
+        return {neighbors_.data() + offsets_[vertex], neighbors_.data() + offsets_[vertex + 1]};
+    }
+
+    int GetOriginalId() const {
+        return original_id_;
+    }
+};
+
+}  // namespace gspan
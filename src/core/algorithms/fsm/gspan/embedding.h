@@ -0,0 +1,21 @@
+#pragma once
+
+#include <vector>
+
+namespace gspan {
+
+// An occurrence of a DFS code in a graph of the database. Only the image of the last edge of the
+// code is stored, the images of the others are found through the occurrence of the code without
+// it, so that extending a code adds one small entry per occurrence.
+struct Embedding {
+    int graph_id;
+    // The graph vertices the vertices of the last edge are mapped to
+    int vertex1;
+    int vertex2;
+    Embedding const* prev;
+};
+
+// All occurrences of a DFS code in the database, ordered by graph id
+using Projected = std::vector<Embedding>;
+
+}  // namespace gspan
@@ -18,7 +18,6 @@ struct Edge {
 
 struct GraphProps {
     int original_id = 0;
-    std::unordered_map<int, std::vector<size_t>> label_to_vertices;
 };
 
 using graph_t = boost::adjacency_list<boost::vecS, boost::vecS, boost::undirectedS, Vertex, Edge,
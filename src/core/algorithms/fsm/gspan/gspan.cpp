@@ -2,11 +2,16 @@
 #include "gspan.h"
 
 #include <algorithm>
+#include <atomic>
+#include <map>
 
+#include <boost/asio/post.hpp>
+#include <boost/asio/thread_pool.hpp>
 #include <boost/functional/hash.hpp>
 #include <boost/range/iterator_range.hpp>
 
 #include "core/config/option_using.h"
+#include "core/config/thread_number/option.h"
 #include "core/util/logger.h"
 #include "core/util/timed_invoke.h"
 #include "graph_parser.h"
@@ -17,121 +22,111 @@ namespace algos {
 
 namespace {
 
-// Get all vertex descriptors having a given label
-std::vector<vertex_t> FindAllWithLabel(int target_label, graph_t const& graph) {
-    return graph[boost::graph_bundle].label_to_vertices.at(target_label);
-}
+// Codes with fewer edges are not mined as a whole, but split into the subtrees of their children
+constexpr std::size_t kSplitDepth = 2;
 
-// Find all isomorphisms between graph described by DFSCode and boost::graph, each
-// isomorphism is represented by a map
-std::vector<std::unordered_map<int, vertex_t>> SubgraphIsomorphisms(DFSCode const& code,
-                                                                    graph_t const& graph) {
-    LOG_TRACE("Finding subgraph isomorphisms: pattern size={}, target vertices={}, edges={}",
-              code.Size(), boost::num_vertices(graph), boost::num_edges(graph));
-    std::vector<std::unordered_map<int, vertex_t>> isoms;
-
-    // Initial isomorphisms by finding all vertices with same label as vertex 0 in code
-    int start_label = code.GetExtendedEdges()[0].vertex1.label;
-    for (vertex_t vertex : FindAllWithLabel(start_label, graph)) {
-        std::unordered_map<int, vertex_t> map;
-        map[0] = vertex;
-        isoms.push_back(std::move(map));
+struct ExtensionOrder {
+    bool operator()(ExtendedEdge const& lhs, ExtendedEdge const& rhs) const {
+        return lhs.SmallerThan(rhs);
     }
-    LOG_TRACE("Initial candidate mappings: {}", isoms.size());
-
-    // Each extended edge will update partial isomorphisms.
-    // For forward edge, each isomorphism will be either extended or discarded.
-    // For backward edge, each isomorphism will be either unchanged or discarded.
-    for (ExtendedEdge const& ee : code.GetExtendedEdges()) {
-        int v1 = ee.vertex1.id;
-        int v2 = ee.vertex2.id;
-        int v2_label = ee.vertex2.label;
-        int edge_label = ee.label;
-
-        std::vector<std::unordered_map<int, vertex_t>> update_isoms;
-        for (auto& iso : isoms) {
-            auto mapped_v1 = iso[v1];
-
-            // If it is a forward edge extension
-            if (v1 < v2) {
-                auto n = boost::num_vertices(graph);
-                std::vector<int> inv(n, -1);
-                for (auto& [dfs_id, graph_vertex] : iso) {
-                    inv[graph_vertex] = dfs_id;
-                }
-
-                // For each neighbor of the vertex corresponding to v1
-                for (auto edge : boost::make_iterator_range(boost::out_edges(mapped_v1, graph))) {
-                    vertex_t mapped_v2 = (boost::source(edge, graph) == mapped_v1)
-                                                 ? boost::target(edge, graph)
-                                                 : boost::source(edge, graph);
-                    auto& mapped_edge = graph[edge];
-
-                    if (v2_label == graph[mapped_v2].label && (inv[mapped_v2] == -1) &&
-                        (edge_label == mapped_edge.label)) {
-                        std::unordered_map<int, vertex_t> temp_map(iso);
-                        temp_map[v2] = mapped_v2;
+};
+
+// Occurrences of the extensions of a DFS code, in DFS lexicographic order of the extensions
+using Extensions = std::map<ExtendedEdge, Projected, ExtensionOrder>;
+
+// Finds the graph vertices the vertices of code are mapped to by embedding, by DFS id
+void MapVertices(DFSCode const& code, Embedding const& embedding, std::vector<int>& vertex_map) {
+    vertex_map.assign(code.GetRightMost() + 1, -1);
+    Embedding const* current = &embedding;
+    for (size_t i = code.Size(); i-- > 0; current = current->prev) {
+        vertex_map[code[i].vertex1.id] = current->vertex1;
+        vertex_map[code[i].vertex2.id] = current->vertex2;
+    }
+}
 
-                        update_isoms.push_back(std::move(temp_map));
+// Extends every occurrence of code by every edge on the rightmost path, as the original gSpan
+// does, instead of searching for the occurrences of each extended code anew
+Extensions RightMostPathExtensions(DFSCode const& code, Projected const& projected,
+                                   std::vector<CsrGraph> const& graphs) {
+    Extensions extensions;
+    if (code.Empty()) {
+        // If we have an empty subgraph that we want to extend,
+        // find all distinct label tuples
+        for (size_t graph_id = 0; graph_id < graphs.size(); graph_id++) {
+            CsrGraph const& graph = graphs[graph_id];
+            for (size_t vertex = 0; vertex < graph.NumVertices(); vertex++) {
+                int vertex_label = graph.GetLabel(vertex);
+                for (auto const& [neighbor, edge_label] : graph.GetNeighbors(vertex)) {
+                    int neighbor_label = graph.GetLabel(neighbor);
+                    // Edges between vertices with equal labels occur in both directions
+                    if (vertex_label <= neighbor_label) {
+                        ExtendedEdge ee(Vertex(0, vertex_label), Vertex(1, neighbor_label),
+                                        edge_label);
+                        extensions[ee].push_back({static_cast<int>(graph_id),
+                                                  static_cast<int>(vertex), neighbor, nullptr});
                     }
                 }
-            } else {
-                // If it is a backward edge extension.
-                // V2 has been visited, only require mappedV1 and mappedV2 are connected in graph.
-                auto mapped_v2 = iso[v2];
-                auto [mapped_edge, is_neighbors] = boost::edge(mapped_v1, mapped_v2, graph);
-                if (is_neighbors && edge_label == graph[mapped_edge].label) {
-                    update_isoms.push_back(iso);
-                }
             }
         }
-        isoms = update_isoms;
+        return extensions;
     }
 
-    LOG_TRACE("Found {} valid isomorphisms", isoms.size());
-    return isoms;
-}
-
-// Precalculate the list of vertices having each label
-void PrecalculateLabelsToVertices(graph_t& graph) {
-    auto& label_to_verts = graph[boost::graph_bundle].label_to_vertices;
-    for (auto v : boost::make_iterator_range(boost::vertices(graph))) {
-        label_to_verts[graph[v].label].push_back(v);
+    int rightmost = code.GetRightMost();
+    // Vertices a backward edge from the rightmost vertex can lead to
+    std::vector<int> backward_targets;
+    for (int vertex : code.GetRightMostPath()) {
+        if (code.NotPreOfRM(vertex) && !code.ContainEdge(rightmost, vertex)) {
+            backward_targets.push_back(vertex);
+        }
     }
-}
 
-graph_t CreateGraphFromDFSCode(DFSCode const& code) {
-    graph_t result;
-    std::unordered_map<int, vertex_t> id_to_desc;
-    for (auto const& ee : code.GetExtendedEdges()) {
-        vertex_t vertex1;
-        if (id_to_desc.contains(ee.vertex1.id)) {
-            vertex1 = id_to_desc[ee.vertex1.id];
-        } else {
-            vertex1 = boost::add_vertex(result);
-            id_to_desc[ee.vertex1.id] = vertex1;
+    std::vector<int> vertex_map;
+    for (Embedding const& embedding : projected) {
+        CsrGraph const& graph = graphs[embedding.graph_id];
+        MapVertices(code, embedding, vertex_map);
+
+        // Backward extensions from rightmost child
+        int mapped_rightmost = vertex_map[rightmost];
+        int mapped_rightmost_label = graph.GetLabel(mapped_rightmost);
+        for (auto const& [neighbor, edge_label] : graph.GetNeighbors(mapped_rightmost)) {
+            for (int target : backward_targets) {
+                if (vertex_map[target] == neighbor) {
+                    ExtendedEdge ee(Vertex(rightmost, mapped_rightmost_label),
+                                    Vertex(target, graph.GetLabel(neighbor)), edge_label);
+                    extensions[ee].push_back(
+                            {embedding.graph_id, mapped_rightmost, neighbor, &embedding});
+                }
+            }
         }
 
-        vertex_t vertex2;
-        if (id_to_desc.contains(ee.vertex2.id)) {
-            vertex2 = id_to_desc[ee.vertex2.id];
-        } else {
-            vertex2 = boost::add_vertex(result);
-            id_to_desc[ee.vertex2.id] = vertex2;
+        // Forward extensions from nodes on rightmost path
+        for (int vertex : code.GetRightMostPath()) {
+            int mapped_vertex = vertex_map[vertex];
+            int mapped_vertex_label = graph.GetLabel(mapped_vertex);
+            for (auto const& [neighbor, edge_label] : graph.GetNeighbors(mapped_vertex)) {
+                if (std::ranges::find(vertex_map, neighbor) == vertex_map.end()) {
+                    ExtendedEdge ee(Vertex(vertex, mapped_vertex_label),
+                                    Vertex(rightmost + 1, graph.GetLabel(neighbor)), edge_label);
+                    extensions[ee].push_back(
+                            {embedding.graph_id, mapped_vertex, neighbor, &embedding});
+                }
+            }
         }
-
-        result[vertex1].id = ee.vertex1.id;
-        result[vertex1].label = ee.vertex1.label;
-
-        result[vertex2].id = ee.vertex2.id;
-        result[vertex2].label = ee.vertex2.label;
-        auto edge = boost::add_edge(vertex1, vertex2, result);
-        result[edge.first].label = ee.label;
     }
+    return extensions;
+}
 
-    result[boost::graph_bundle].original_id = -1;
-    PrecalculateLabelsToVertices(result);
-    return result;
+// Number of graphs with an occurrence
+int Support(Projected const& projected) {
+    int support = 0;
+    int last_graph_id = -1;
+    for (Embedding const& embedding : projected) {
+        if (embedding.graph_id != last_graph_id) {
+            support++;
+            last_graph_id = embedding.graph_id;
+        }
+    }
+    return support;
 }
 
 std::unordered_set<int> TranslateToOriginalIds(std::unordered_set<int> const& internal_ids,
@@ -150,13 +145,13 @@ GSpan::GSpan() : Algorithm() {
     RegisterOptions();
     MakeOptionsAvailable({config::names::kGraphDatabase, config::names::kGSpanMinimumSupport,
                           config::names::kOutputSingleVertices, config::names::kMaxNumberOfEdges,
-                          config::names::kGSpanOutputPath});
+                          config::names::kGSpanOutputPath, config::names::kThreads});
 }
 
 void GSpan::MakeExecuteOptsAvailable() {
     using namespace config::names;
-    MakeOptionsAvailable(
-            {kGSpanMinimumSupport, kOutputSingleVertices, kMaxNumberOfEdges, kGSpanOutputPath});
+    MakeOptionsAvailable({kGSpanMinimumSupport, kOutputSingleVertices, kMaxNumberOfEdges,
+                          kGSpanOutputPath, kThreads});
 }
 
 void GSpan::RegisterOptions() {
@@ -187,6 +182,7 @@ void GSpan::RegisterOptions() {
 
     RegisterOption(config::Option{&output_path_, kGSpanOutputPath, kDGSpanOutputPath,
                                   std::filesystem::path{}});
+    RegisterOption(config::kThreadNumberOpt(&threads_));
 }
 
 void GSpan::LoadDataInternal() {
@@ -199,6 +195,7 @@ void GSpan::ResetState() {
     pruned_graphs_ = raw_dataset_;
     frequent_subgraphs_.clear();
     frequent_vertex_labels_.clear();
+    database_.clear();
     empty_graphs_removed_ = 0;
 }
 
@@ -228,24 +225,49 @@ void GSpan::MineSubgraphs() {
     RemoveInfrequentVertexPairs();
     LOG_DEBUG("Pruning complete");
 
-    // Set with all the graph ids
-    LOG_DEBUG("Building active graph set");
-    std::unordered_set<int> graph_ids;
-    for (size_t i = 0; i < pruned_graphs_.size(); i++) {
-        graph_t& graph = pruned_graphs_[i];
+    LOG_DEBUG("Building graph database");
+    for (graph_t const& graph : pruned_graphs_) {
         if (boost::num_vertices(graph) != 0) {
-            graph_ids.insert(i);
-            PrecalculateLabelsToVertices(graph);
+            database_.emplace_back(graph);
         } else {
             empty_graphs_removed_++;
         }
     }
-    LOG_DEBUG("Active graphs: {}, empty graphs removed: {}", graph_ids.size(),
+    LOG_DEBUG("Active graphs: {}, empty graphs removed: {}", database_.size(),
               empty_graphs_removed_);
 
     if (frequent_vertex_labels_.size() != 0) {
-        LOG_DEBUG("Starting DFS search with {} graphs", graph_ids.size());
-        GSpanDFS(DFSCode(), std::move(graph_ids));
+        LOG_DEBUG("Starting DFS search with {} graphs", database_.size());
+        std::deque<Subtree> subtrees;
+        SplitDFSCodeTree(DFSCode(), Projected(), subtrees);
+        LOG_DEBUG("Mining {} subtrees of the DFS code tree", subtrees.size());
+
+        std::atomic<size_t> next_subtree = 0;
+        auto mine = [&]() {
+            for (size_t i; (i = next_subtree.fetch_add(1)) < subtrees.size();) {
+                Subtree& subtree = subtrees[i];
+                if (!subtree.split) {
+                    GSpanDFS(subtree.code, subtree.projected, subtree.subgraphs);
+                }
+            }
+        };
+        if (threads_ > 1) {
+            boost::asio::thread_pool pool(threads_);
+            for (config::ThreadNumType t = 0; t < threads_; t++) {
+                boost::asio::post(pool, mine);
+            }
+            pool.join();
+        } else {
+            mine();
+        }
+
+        // Subtrees follow their parents, so this is the order a single DFS would find them in
+        for (Subtree& subtree : subtrees) {
+            for (FrequentSubgraph& subgraph : subtree.subgraphs) {
+                subgraph.id = frequent_subgraphs_.size();
+                frequent_subgraphs_.push_back(std::move(subgraph));
+            }
+        }
     }
 
     LOG_INFO("GSpan complete: {} frequent subgraphs found", frequent_subgraphs_.size());
@@ -340,25 +362,21 @@ void GSpan::RemoveInfrequentVertexPairs() {
     }
 }
 
-void GSpan::GSpanDFS(gspan::DFSCode const& code, std::unordered_set<int> graph_ids) {
-    LOG_TRACE("DFS step: pattern size={}, candidate graphs={}, patterns found={}", code.Size(),
-              graph_ids.size(), frequent_subgraphs_.size());
-
+template <typename Visit>
+void GSpan::ForEachFrequentChild(DFSCode const& code, Projected const& projected,
+                                 Visit visit) const {
     // If we have reached the maximum size, we do not need to extend this graph
     if (code.Size() == static_cast<size_t>(max_number_of_edges_)) {
         LOG_TRACE("Maximum pattern size reached, backtracking");
         return;
     }
 
-    // Find all the extensions of this graph, with their support values.
-    // They are stored in a map where the key is an extended edge, and the value
-    // is the list of graph ids where this edge extends the current subgraph.
-    std::unordered_map<ExtendedEdge, std::unordered_set<int>, ExtendedEdge::Hash> extensions =
-            RightMostPathExtensions(code, std::move(graph_ids));
+    // Find all the extensions of this graph, with their occurrences
+    Extensions extensions = RightMostPathExtensions(code, projected, database_);
     LOG_TRACE("Found {} candidate extensions", extensions.size());
 
-    for (auto& [extension, new_graph_ids] : extensions) {
-        int sup = new_graph_ids.size();
+    for (auto& [extension, child_projected] : extensions) {
+        int sup = Support(child_projected);
 
         // If the support is enough
         if (sup >= min_sup_) {
@@ -369,141 +387,68 @@ void GSpan::GSpanDFS(gspan::DFSCode const& code, std::unordered_set<int> graph_i
             // If the resulting graph is canonical (it means that the graph is non redundant)
             if (IsCanonical(new_code)) {
                 LOG_TRACE("New frequent subgraph: size={}, support={}", new_code.Size(), sup);
-                frequent_subgraphs_.emplace_back(
-                        frequent_subgraphs_.size(), new_code,
-                        TranslateToOriginalIds(new_graph_ids, pruned_graphs_), sup);
-                GSpanDFS(new_code, std::move(new_graph_ids));
-            }
-        }
-    }
-}
-
-template <class Emit>
-void EnumerateRightMostExtensions(DFSCode const& code, graph_t const& graph, Emit&& emit) {
-    LOG_TRACE("Computing sgraph extensions: pattern size={}, vertices={}", code.Size(),
-              boost::num_vertices(graph));
-    if (code.Empty()) {
-        // If we have an empty subgraph that we want to extend,
-        // find all distinct label tuples
-        LOG_TRACE("Empty pattern, collecting initial edges");
-        for (auto vertex : boost::make_iterator_range(boost::vertices(graph))) {
-            for (auto edge : boost::make_iterator_range(boost::out_edges(vertex, graph))) {
-                int vertex_label = graph[vertex].label;
-                auto neighbor = boost::target(edge, graph) == vertex ? boost::source(edge, graph)
-                                                                     : boost::target(edge, graph);
-                int neighbor_label = graph[neighbor].label;
-                ExtendedEdge ee =
-                        (vertex_label < neighbor_label)
-                                ? ExtendedEdge(Vertex(0, vertex_label), Vertex(1, neighbor_label),
-                                               graph[edge].label)
-                                : ExtendedEdge(Vertex(0, neighbor_label), Vertex(1, vertex_label),
-                                               graph[edge].label);
-                emit(ee);
-            }
-        }
-    } else {
-        // If we want to extend a subgraph
-        auto rightmost = code.GetRightMost();
-        std::vector<std::unordered_map<int, vertex_t>> isoms = SubgraphIsomorphisms(code, graph);
-        LOG_TRACE("Found {} embeddings for extension", isoms.size());
-        for (auto& isom : isoms) {
-            // Backward extensions from rightmost child
-            auto n = boost::num_vertices(graph);
-            std::vector<int> inverted_isom(n, -1);
-            for (auto& [dfs_id, graph_vertex] : isom) {
-                inverted_isom[graph_vertex] = dfs_id;
-            }
-
-            auto mapped_rightmost = isom[rightmost];
-            int mapped_rightmost_label = graph[mapped_rightmost].label;
-            for (auto edge :
-                 boost::make_iterator_range(boost::out_edges(mapped_rightmost, graph))) {
-                vertex_t neighbor = (boost::source(edge, graph) == mapped_rightmost)
-                                            ? boost::target(edge, graph)
-                                            : boost::source(edge, graph);
-                if (inverted_isom[neighbor] == -1) {
-                    continue;
-                }
-
-                auto inverted = inverted_isom[neighbor];
-                if (code.OnRightMostPath(inverted) && code.NotPreOfRM(inverted) &&
-                    !code.ContainEdge(rightmost, inverted)) {
-                    // Rightmost and inverted both have correspondings in graph, so label of
-                    // vertices and edge all can be found by correspondings
-                    int edge_label = graph[edge].label;
-                    ExtendedEdge ee(Vertex(rightmost, mapped_rightmost_label),
-                                    Vertex(inverted, graph[neighbor].label), edge_label);
-                    emit(ee);
-                }
-            }
-
-            // Forward extensions from nodes on rightmost path
-            for (auto vertex : code.GetRightMostPath()) {
-                auto mapped_vertex = isom[vertex];
-                int mapped_vertex_label = graph[mapped_vertex].label;
-                for (auto edge :
-                     boost::make_iterator_range(boost::out_edges(mapped_vertex, graph))) {
-                    vertex_t neighbor = (boost::source(edge, graph) == mapped_vertex)
-                                                ? boost::target(edge, graph)
-                                                : boost::source(edge, graph);
-                    if (inverted_isom[neighbor] == -1) {
-                        int edge_label = graph[edge].label;
-                        ExtendedEdge ee(Vertex(vertex, mapped_vertex_label),
-                                        Vertex(rightmost + 1, graph[neighbor].label), edge_label);
-                        emit(ee);
-                    }
+                std::unordered_set<int> graph_ids;
+                for (Embedding const& embedding : child_projected) {
+                    graph_ids.insert(database_[embedding.graph_id].GetOriginalId());
                 }
+                visit(FrequentSubgraph(0, new_code, graph_ids, sup), child_projected);
             }
         }
     }
 }
 
-std::unordered_map<ExtendedEdge, std::unordered_set<int>, ExtendedEdge::Hash>
-GSpan::RightMostPathExtensions(DFSCode const& code, std::unordered_set<int> graph_ids) {
-    std::unordered_map<ExtendedEdge, std::unordered_set<int>, ExtendedEdge::Hash> out;
-
-    for (int graph_id : graph_ids) {
-        auto const& graph = pruned_graphs_[graph_id];
-
-        EnumerateRightMostExtensions(code, graph,
-                                     [&](ExtendedEdge const& ee) { out[ee].insert(graph_id); });
-    }
-
-    return out;
+void GSpan::SplitDFSCodeTree(DFSCode const& code, Projected const& projected,
+                             std::deque<Subtree>& subtrees) const {
+    ForEachFrequentChild(code, projected, [&](FrequentSubgraph&& subgraph, Projected& child) {
+        DFSCode child_code = subgraph.dfs_code;
+        // The occurrences of the grandchildren refer to the ones of the child, so the child keeps
+        // them even if it is split
+        std::vector<FrequentSubgraph> subgraphs;
+        subgraphs.push_back(std::move(subgraph));
+        Subtree& subtree =
+                subtrees.emplace_back(child_code, std::move(child), std::move(subgraphs));
+        if (child_code.Size() < kSplitDepth) {
+            subtree.split = true;
+            SplitDFSCodeTree(child_code, subtree.projected, subtrees);
+        }
+    });
 }
 
-std::unordered_set<ExtendedEdge, ExtendedEdge::Hash> GSpan::RightMostPathExtensionsFromSingle(
-        DFSCode const& code, graph_t const& graph) {
-    std::unordered_set<ExtendedEdge, ExtendedEdge::Hash> out;
-
-    EnumerateRightMostExtensions(code, graph, [&](ExtendedEdge const& ee) { out.insert(ee); });
+void GSpan::GSpanDFS(DFSCode const& code, Projected const& projected,
+                     std::vector<FrequentSubgraph>& subgraphs) const {
+    LOG_TRACE("DFS step: pattern size={}, candidate graphs={}, patterns found={}", code.Size(),
+              Support(projected), subgraphs.size());
 
-    return out;
+    ForEachFrequentChild(code, projected, [&](FrequentSubgraph&& subgraph, Projected& child) {
+        DFSCode child_code = subgraph.dfs_code;
+        subgraphs.push_back(std::move(subgraph));
+        GSpanDFS(child_code, child, subgraphs);
+    });
 }
 
-bool GSpan::IsCanonical(DFSCode const& code) {
+bool GSpan::IsCanonical(DFSCode const& code) const {
     LOG_TRACE("Checking canonicity: pattern size={}", code.Size());
+    std::vector<CsrGraph> const canon_graph{CsrGraph(code)};
     DFSCode canon;
-    graph_t canon_graph = CreateGraphFromDFSCode(code);
+    // Occurrences of canon in the graph of code, for each of its prefixes, since the occurrences
+    // refer to the ones of the prefix
+    std::vector<Projected> canon_projected{Projected()};
     for (size_t i = 0; i < code.Size(); i++) {
-        std::unordered_set<ExtendedEdge, ExtendedEdge::Hash> extensions =
-                RightMostPathExtensionsFromSingle(canon, canon_graph);
+        Extensions extensions =
+                RightMostPathExtensions(canon, canon_projected.back(), canon_graph);
 
         if (extensions.empty()) {
             return false;
         }
 
-        ExtendedEdge min_ee = *extensions.begin();
-        for (auto const& ee : extensions) {
-            if (ee.SmallerThan(min_ee)) min_ee = ee;
-        }
-
+        auto& [min_ee, min_ee_projected] = *extensions.begin();
         if (min_ee.SmallerThan(code[i])) {
             LOG_TRACE("Non-canonical at edge {}", i);
             return false;
         }
 
         canon.Add(min_ee);
+        canon_projected.push_back(std::move(min_ee_projected));
     }
 
     LOG_TRACE("Pattern is canonical");
@@ -1,10 +1,14 @@
 #pragma once
 
 #include <cmath>
+#include <deque>
 #include <vector>
 
 #include "core/algorithms/algorithm.h"
 #include "core/config/names_and_descriptions.h"
+#include "core/config/thread_number/type.h"
+#include "csr_graph.h"
+#include "embedding.h"
 #include "frequent_subgraph.h"
 #include "graph.h"
 
@@ -30,23 +34,41 @@ protected:
     // Empty graphs removed count
     int empty_graphs_removed_;
 
+    config::ThreadNumType threads_;
+
     std::filesystem::path graph_database_path_;
     std::filesystem::path output_path_;
     std::vector<gspan::graph_t> raw_dataset_;
     std::vector<gspan::graph_t> pruned_graphs_;
 
+    // The non-empty pruned graphs, which are mined
+    std::vector<gspan::CsrGraph> database_;
+
+    // A subtree of the DFS code tree. Subtrees near the root are split into the subtrees of
+    // their children, the others are mined as a whole, in parallel
+    struct Subtree {
+        gspan::DFSCode code;
+        gspan::Projected projected;
+        // The subgraph of the code followed by the ones found in the subtree, in DFS order
+        std::vector<gspan::FrequentSubgraph> subgraphs;
+        bool split = false;
+    };
+
     void FindAllOnlyOneVertex();
     void RemoveInfrequentLabel(gspan::graph_t& graph, int label);
     void RemoveInfrequentVertexPairs();
-    void GSpanDFS(gspan::DFSCode const& code, std::unordered_set<int> graph_ids);
 
-    std::unordered_map<gspan::ExtendedEdge, std::unordered_set<int>, gspan::ExtendedEdge::Hash>
-    RightMostPathExtensions(gspan::DFSCode const& code, std::unordered_set<int> graph_ids);
+    void SplitDFSCodeTree(gspan::DFSCode const& code, gspan::Projected const& projected,
+                          std::deque<Subtree>& subtrees) const;
+    void GSpanDFS(gspan::DFSCode const& code, gspan::Projected const& projected,
+                  std::vector<gspan::FrequentSubgraph>& subgraphs) const;
 
-    std::unordered_set<gspan::ExtendedEdge, gspan::ExtendedEdge::Hash>
-    RightMostPathExtensionsFromSingle(gspan::DFSCode const& code, gspan::graph_t const& graph);
+    // Calls visit for every frequent canonical child of code with its subgraph and occurrences
+    template <typename Visit>
+    void ForEachFrequentChild(gspan::DFSCode const& code, gspan::Projected const& projected,
+                              Visit visit) const;
 
-    bool IsCanonical(gspan::DFSCode const& code);
+    bool IsCanonical(gspan::DFSCode const& code) const;
 
     unsigned long long ExecuteInternal();
 
@@ -38,13 +38,8 @@ bool IsSubgraph(gdd::graph_t const& query, gdd::graph_t const& graph) {
     return result;
 }
 
-}  // namespace gdd::detail
-
-namespace {
-
-bool CompareDistance(double dist, gdd::detail::CmpOp op, double threshold) {
+bool CompareDistance(double dist, CmpOp op, double threshold) {
     constexpr double eps = std::numeric_limits<double>::epsilon();
-    using ::model::gdd::detail::CmpOp;
 
     switch (op) {
         case CmpOp::kLe:
@@ -64,6 +59,10 @@ bool CompareDistance(double dist, gdd::detail::CmpOp op, double threshold) {
     }
 }
 
+}  // namespace gdd::detail
+
+namespace {
+
 double TryParseNumber(gdd::detail::ConstValue const& val) {
     if (std::holds_alternative<std::int64_t>(val)) {
         return std::get<std::int64_t>(val);
@@ -246,7 +245,7 @@ bool Gdd::SatisfiesAttributeConstraint(
     }
 
     double const dist = CalculateDistance(*lhs_scalar, *rhs_scalar, constraint.metric);
-    return CompareDistance(dist, constraint.op, constraint.threshold);
+    return gdd::detail::CompareDistance(dist, constraint.op, constraint.threshold);
 }
 
 bool Gdd::SatisfiesConstraint(gdd::graph_t const& g,
@@ -58,6 +58,8 @@ struct DistanceConstraint {
 
 bool IsSubgraph(gdd::graph_t const& query, gdd::graph_t const& graph);
 
+bool CompareDistance(double dist, CmpOp op, double threshold);
+
 }  // namespace gdd::detail
 
 class Gdd {
@@ -69,8 +71,6 @@ private:
     Phi lhs_;
     Phi rhs_;
 
-    static std::size_t ExtractVertexIdFromConst(gdd::detail::ConstValue const& cv);
-
     static std::optional<std::pair<std::size_t, std::string>> TokenAsRelation(
             gdd::detail::DistanceOperand const& operand);
 
@@ -110,6 +110,9 @@ private:
     }
 
 public:
+    // Vertex id a relation constraint compares targets with
+    static std::size_t ExtractVertexIdFromConst(gdd::detail::ConstValue const& cv);
+
     template <class GraphT, class LhsT, class RhsT>
         requires std::constructible_from<gdd::graph_t, GraphT&&> &&
                          std::constructible_from<Phi, LhsT&&> &&
@@ -31,24 +31,32 @@ GddValidator::GddValidator() : Algorithm() {
 }
 
 void GddValidator::LoadDataInternal() {
-    graph_ = parser::graph_parser::gdd::ReadGraph(graph_path_);
+    graph_ = parser::graph_parser::gdd::ReadGraph(graph_path_, threads_num_);
+}
+
+std::vector<std::optional<model::GddCounterexample>> GddValidator::FindCounterexamples(
+        std::span<model::Gdd const> gdds, model::gdd::graph_t const& graph) {
+    std::vector<std::optional<GddCounterexample>> counterexamples;
+    counterexamples.reserve(gdds.size());
+    for (model::Gdd const& gdd : gdds) {
+        counterexamples.push_back(Holds(gdd, graph));
+    }
+    return counterexamples;
 }
 
 void GddValidator::FilterValidGdds() {
     ResetState();
 
-    std::size_t gdd_index = 0;
-    std::ranges::copy_if(gdds_, std::back_inserter(result_),
-                         [this, &gdd_index](model::Gdd const& gdd) {
-                             if (auto ce = Holds(gdd, graph_); ce.has_value()) {
-                                 ce->gdd_index = gdd_index;
-                                 counterexamples_.emplace_back(std::move(*ce));
-                                 ++gdd_index;
-                                 return false;
-                             }
-                             ++gdd_index;
-                             return true;
-                         });
+    std::vector<std::optional<GddCounterexample>> counterexamples =
+            FindCounterexamples(gdds_, graph_);
+    for (std::size_t gdd_index = 0; gdd_index != gdds_.size(); ++gdd_index) {
+        if (std::optional<GddCounterexample>& ce = counterexamples[gdd_index]; ce.has_value()) {
+            ce->gdd_index = gdd_index;
+            counterexamples_.emplace_back(std::move(*ce));
+        } else {
+            result_.push_back(gdds_[gdd_index]);
+        }
+    }
 }
 
 }  // namespace algos
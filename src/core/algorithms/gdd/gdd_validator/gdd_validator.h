@@ -1,10 +1,14 @@
 #pragma once
 
 #include <filesystem>
+#include <optional>
+#include <span>
+#include <vector>
 
 #include "core/algorithms/algorithm.h"
 #include "core/algorithms/gdd/gdd.h"
 #include "core/algorithms/gdd/gdd_graph_description.h"
+#include "core/config/thread_number/type.h"
 
 namespace algos {
 
@@ -28,6 +32,9 @@ private:
     virtual void LoadDataInternal() final;
 
 protected:
+    // registered by the validators that support it, also used to load the graph
+    config::ThreadNumType threads_num_ = 1;
+
     model::gdd::graph_t const& GetGraph() const noexcept {
         return graph_;
     }
@@ -39,6 +46,11 @@ protected:
     virtual std::optional<GddCounterexample> Holds(model::Gdd const& gdd,
                                                    model::gdd::graph_t const& graph) = 0;
 
+    // Counterexample to every GDD, or nullopt for the GDDs that hold. Checks them one by one
+    // unless a validator can do better.
+    virtual std::vector<std::optional<GddCounterexample>> FindCounterexamples(
+            std::span<model::Gdd const> gdds, model::gdd::graph_t const& graph);
+
 public:
     GddValidator();
 
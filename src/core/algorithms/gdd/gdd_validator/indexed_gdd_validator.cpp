@@ -0,0 +1,604 @@
+#include "core/algorithms/gdd/gdd_validator/indexed_gdd_validator.h"
+
+#include <algorithm>
+#include <atomic>
+#include <cmath>
+#include <cstdint>
+#include <limits>
+#include <memory>
+#include <mutex>
+#include <string_view>
+#include <type_traits>
+#include <unordered_map>
+#include <variant>
+
+#include <boost/range/iterator_range.hpp>
+
+#include "core/config/thread_number/option.h"
+#include "core/util/levenshtein_distance.h"
+#include "core/util/parallel_for.h"
+#include "core/util/worker_thread_pool.h"
+
+namespace algos {
+
+namespace {
+
+using model::gdd::graph_t;
+using model::gdd::vertex_t;
+using namespace model::gdd::detail;
+
+constexpr std::uint32_t kNoLabel = std::numeric_limits<std::uint32_t>::max();
+constexpr std::size_t kNoPosition = std::numeric_limits<std::size_t>::max();
+
+// Candidates of the first pattern vertex of a GDD are searched in chunks of this many vertices,
+// which are the units of parallel work
+constexpr std::size_t kRootChunkSize = 64;
+
+struct Arc {
+    std::uint32_t label;
+    vertex_t vertex;
+
+    auto operator<=>(Arc const&) const = default;
+};
+
+// Labels of vertices and edges are interned, so they are matched by comparing ids. This is
+// what Gdd::LabelsMatch does as long as it is plain string equality.
+class GraphIndex {
+    std::unordered_map<std::string_view, std::uint32_t> labels_;
+    std::vector<std::uint32_t> vertex_labels_;
+    std::vector<std::vector<vertex_t>> vertices_by_label_;
+    // arcs of vertex v are arcs[offsets[v]] .. arcs[offsets[v + 1] - 1], sorted by label, then
+    // by the other end
+    std::vector<std::size_t> out_offsets_;
+    std::vector<Arc> out_arcs_;
+    std::vector<std::size_t> in_offsets_;
+    std::vector<Arc> in_arcs_;
+
+    std::uint32_t Intern(std::string const& label) {
+        return labels_.try_emplace(label, labels_.size()).first->second;
+    }
+
+public:
+    GraphIndex(graph_t const& graph, util::WorkerThreadPool* pool) {
+        std::size_t const num_vertices = boost::num_vertices(graph);
+        vertex_labels_.reserve(num_vertices);
+        for (vertex_t v = 0; v != num_vertices; ++v) {
+            vertex_labels_.push_back(Intern(graph[v].label));
+        }
+        for (auto const e : boost::make_iterator_range(boost::edges(graph))) {
+            Intern(graph[e].label);
+        }
+        vertices_by_label_.resize(labels_.size());
+        for (vertex_t v = 0; v != num_vertices; ++v) {
+            vertices_by_label_[vertex_labels_[v]].push_back(v);
+        }
+
+        out_offsets_.assign(num_vertices + 1, 0);
+        in_offsets_.assign(num_vertices + 1, 0);
+        for (vertex_t v = 0; v != num_vertices; ++v) {
+            out_offsets_[v + 1] = out_offsets_[v] + boost::out_degree(v, graph);
+            in_offsets_[v + 1] = in_offsets_[v] + boost::in_degree(v, graph);
+        }
+        out_arcs_.resize(out_offsets_.back());
+        in_arcs_.resize(in_offsets_.back());
+        util::ParallelForRanges(
+                pool, num_vertices, kRootChunkSize, [&](vertex_t begin, vertex_t end) {
+                    for (vertex_t v = begin; v != end; ++v) {
+                        Arc* out = out_arcs_.data() + out_offsets_[v];
+                        for (auto const e :
+                             boost::make_iterator_range(boost::out_edges(v, graph))) {
+                            *out++ = {labels_.at(graph[e].label), boost::target(e, graph)};
+                        }
+                        std::sort(out_arcs_.data() + out_offsets_[v], out);
+                        Arc* in = in_arcs_.data() + in_offsets_[v];
+                        for (auto const e : boost::make_iterator_range(boost::in_edges(v, graph))) {
+                            *in++ = {labels_.at(graph[e].label), boost::source(e, graph)};
+                        }
+                        std::sort(in_arcs_.data() + in_offsets_[v], in);
+                    }
+                });
+    }
+
+    std::uint32_t FindLabel(std::string const& label) const {
+        auto const it = labels_.find(label);
+        return it == labels_.end() ? kNoLabel : it->second;
+    }
+
+    std::uint32_t GetLabel(vertex_t v) const {
+        return vertex_labels_[v];
+    }
+
+    std::vector<vertex_t> const& GetVertices(std::uint32_t label) const {
+        static std::vector<vertex_t> const kNone;
+        return label == kNoLabel ? kNone : vertices_by_label_[label];
+    }
+
+    // Arcs of v with the given label, sorted by the other end, which may repeat
+    std::span<Arc const> GetArcs(vertex_t v, bool out, std::uint32_t label) const {
+        std::vector<Arc> const& arcs = out ? out_arcs_ : in_arcs_;
+        std::vector<std::size_t> const& offsets = out ? out_offsets_ : in_offsets_;
+        Arc const* begin = arcs.data() + offsets[v];
+        Arc const* end = arcs.data() + offsets[v + 1];
+        auto const [first, last] = std::equal_range(
+                begin, end, Arc{label, 0},
+                [](Arc const& l, Arc const& r) { return l.label < r.label; });
+        return {first, last};
+    }
+
+    bool HasArc(vertex_t v, bool out, std::uint32_t label, vertex_t other) const {
+        std::span<Arc const> const arcs = GetArcs(v, out, label);
+        return std::binary_search(arcs.begin(), arcs.end(), Arc{label, other});
+    }
+};
+
+// Pattern edge between the vertex matched at some step and the one matched at step other,
+// which is either an earlier step or the same one for a loop
+struct StepEdge {
+    std::size_t other;
+    std::uint32_t label;
+    // whether the edge goes from the vertex of this step to other
+    bool out;
+
+    auto operator<=>(StepEdge const&) const = default;
+};
+
+struct Step {
+    vertex_t pattern_vertex;
+    std::uint32_t label;
+    // labels of the edges every candidate must have, a necessary condition for a match
+    std::vector<std::uint32_t> out_labels;
+    std::vector<std::uint32_t> in_labels;
+    std::vector<StepEdge> edges;
+    // only for steps not connected to earlier ones, otherwise candidates are neighbours of the
+    // vertex matched to edges.front().other
+    std::vector<vertex_t> candidates;
+};
+
+struct Operand {
+    enum class Kind { kConst, kId, kLabel, kAttribute, kRelation, kUnresolved };
+
+    Kind kind;
+    std::size_t position = kNoPosition;
+    std::string const* name = nullptr;
+    ConstValue const* value = nullptr;
+};
+
+struct Constraint {
+    DistanceConstraint const* source;
+    Operand lhs;
+    Operand rhs;
+    // whether the LHS is a relation, the constraint then compares the ends of its edges
+    bool is_relation = false;
+    std::uint32_t relation_label = kNoLabel;
+};
+
+using Scalar = std::variant<std::int64_t, double, std::string_view>;
+
+double ToNumber(Scalar const& value) {
+    if (std::holds_alternative<std::int64_t>(value)) {
+        return std::get<std::int64_t>(value);
+    }
+    if (std::holds_alternative<double>(value)) {
+        return std::get<double>(value);
+    }
+    return std::stod(std::string(std::get<std::string_view>(value)));
+}
+
+// Decides dist op threshold for the edit distance without computing distances that are larger
+// than the threshold: all of them compare the same way
+bool EditDistanceCompares(std::string_view lhs, std::string_view rhs, CmpOp op,
+                          double threshold) {
+    constexpr unsigned kMaxBound = 1U << 30;
+    unsigned const bound = threshold >= 0 ? static_cast<unsigned>(std::min<double>(
+                                                    std::floor(threshold) + 1, kMaxBound))
+                                          : 0;
+    return CompareDistance(util::BoundedLevenshteinDistance(lhs, rhs, bound), op, threshold);
+}
+
+class Matcher {
+    graph_t const& graph_;
+    GraphIndex const& index_;
+    model::Gdd const& gdd_;
+    std::vector<Step> steps_;
+    std::vector<Constraint> lhs_;
+    std::vector<Constraint> rhs_;
+    bool has_matches_ = true;
+
+    Operand CompileOperand(DistanceOperand const& operand,
+                           std::unordered_map<std::size_t, std::size_t> const& positions) const {
+        if (std::holds_alternative<ConstValue>(operand)) {
+            return {.kind = Operand::Kind::kConst, .value = &std::get<ConstValue>(operand)};
+        }
+        auto const& [pattern_vertex_id, field] = std::get<GddToken>(operand);
+        auto const it = positions.find(pattern_vertex_id);
+        if (it == positions.end()) return {.kind = Operand::Kind::kUnresolved};
+        if (std::holds_alternative<RelTag>(field)) {
+            return {.kind = Operand::Kind::kRelation,
+                    .position = it->second,
+                    .name = &std::get<RelTag>(field).name};
+        }
+        std::string const& name = std::get<AttrTag>(field).name;
+        Operand::Kind const kind = name == "id"      ? Operand::Kind::kId
+                                   : name == "label" ? Operand::Kind::kLabel
+                                                     : Operand::Kind::kAttribute;
+        return {.kind = kind, .position = it->second, .name = &name};
+    }
+
+    std::vector<Constraint> CompileConstraints(
+            model::Gdd::Phi const& phi,
+            std::unordered_map<std::size_t, std::size_t> const& positions) const {
+        std::vector<Constraint> constraints;
+        for (DistanceConstraint const& constraint : phi) {
+            Constraint compiled{.source = &constraint,
+                                .lhs = CompileOperand(constraint.lhs, positions),
+                                .rhs = CompileOperand(constraint.rhs, positions)};
+            auto const* lhs_token = std::get_if<GddToken>(&constraint.lhs);
+            if (lhs_token != nullptr && std::holds_alternative<RelTag>(lhs_token->field)) {
+                compiled.is_relation = true;
+                compiled.relation_label =
+                        index_.FindLabel(std::get<RelTag>(lhs_token->field).name);
+            }
+            constraints.push_back(compiled);
+        }
+        return constraints;
+    }
+
+    bool Admits(Step const& step, vertex_t v) const {
+        if (index_.GetLabel(v) != step.label) return false;
+        auto has_arcs = [&](bool out) {
+            return [this, v, out](std::uint32_t label) {
+                return !index_.GetArcs(v, out, label).empty();
+            };
+        };
+        return std::ranges::all_of(step.out_labels, has_arcs(true)) &&
+               std::ranges::all_of(step.in_labels, has_arcs(false));
+    }
+
+    bool Connects(std::size_t position, std::vector<vertex_t> const& match, vertex_t v) const {
+        return std::ranges::all_of(steps_[position].edges, [&](StepEdge const& edge) {
+            vertex_t const other = edge.other == position ? v : match[edge.other];
+            return index_.HasArc(other, !edge.out, edge.label, v);
+        });
+    }
+
+    std::optional<Scalar> Resolve(Operand const& operand,
+                                  std::vector<vertex_t> const& match) const {
+        switch (operand.kind) {
+            case Operand::Kind::kConst:
+                return std::visit(
+                        [](auto const& value) {
+                            if constexpr (std::is_same_v<decltype(value), std::string const&>) {
+                                return Scalar{std::string_view{value}};
+                            } else {
+                                return Scalar{value};
+                            }
+                        },
+                        *operand.value);
+            case Operand::Kind::kId: {
+                std::size_t const id = graph_[match[operand.position]].id;
+                if (id > std::numeric_limits<std::int64_t>::max()) {
+                    throw std::out_of_range("Vertex id is too big to be resolved");
+                }
+                return static_cast<std::int64_t>(id);
+            }
+            case Operand::Kind::kLabel:
+                return Scalar{std::string_view{graph_[match[operand.position]].label}};
+            case Operand::Kind::kAttribute: {
+                auto const& attributes = graph_[match[operand.position]].attributes;
+                auto const it = attributes.find(*operand.name);
+                if (it == attributes.end()) return std::nullopt;
+                return Scalar{std::string_view{it->second}};
+            }
+            case Operand::Kind::kRelation:
+                throw std::logic_error("Relation operand in an attribute constraint");
+            case Operand::Kind::kUnresolved:
+                return std::nullopt;
+        }
+        return std::nullopt;
+    }
+
+    bool SatisfiesRelation(Constraint const& constraint,
+                           std::vector<vertex_t> const& match) const {
+        if (constraint.lhs.kind == Operand::Kind::kUnresolved) return false;
+        std::span<Arc const> const lhs_targets =
+                constraint.relation_label == kNoLabel
+                        ? std::span<Arc const>{}
+                        : index_.GetArcs(match[constraint.lhs.position], true,
+                                         constraint.relation_label);
+
+        // 1. exists edge with the relation label that ends at the vertex with the given id
+        if (constraint.rhs.kind == Operand::Kind::kConst) {
+            return std::ranges::any_of(lhs_targets, [&](Arc const& arc) {
+                return graph_[arc.vertex].id ==
+                       model::Gdd::ExtractVertexIdFromConst(*constraint.rhs.value);
+            });
+        }
+
+        // 2. both vertices have an edge with the same label that ends at the same vertex
+        if (constraint.rhs.kind == Operand::Kind::kRelation) {
+            auto const& rhs_token = std::get<GddToken>(constraint.source->rhs);
+            auto const& lhs_token = std::get<GddToken>(constraint.source->lhs);
+            if (!model::Gdd::LabelsMatch(std::get<RelTag>(lhs_token.field).name,
+                                         std::get<RelTag>(rhs_token.field).name)) {
+                return false;
+            }
+            if (constraint.relation_label == kNoLabel) return false;
+            std::span<Arc const> const rhs_targets = index_.GetArcs(
+                    match[constraint.rhs.position], true, constraint.relation_label);
+            auto lhs_it = lhs_targets.begin();
+            auto rhs_it = rhs_targets.begin();
+            while (lhs_it != lhs_targets.end() && rhs_it != rhs_targets.end()) {
+                if (lhs_it->vertex == rhs_it->vertex) return true;
+                if (lhs_it->vertex < rhs_it->vertex) {
+                    ++lhs_it;
+                } else {
+                    ++rhs_it;
+                }
+            }
+            return false;
+        }
+
+        return false;
+    }
+
+    bool Satisfies(Constraint const& constraint, std::vector<vertex_t> const& match) const {
+        if (constraint.is_relation) {
+            return SatisfiesRelation(constraint, match);
+        }
+        std::optional<Scalar> const lhs = Resolve(constraint.lhs, match);
+        std::optional<Scalar> const rhs = Resolve(constraint.rhs, match);
+        if (!lhs || !rhs) return false;
+
+        DistanceConstraint const& source = *constraint.source;
+        switch (source.metric) {
+            case DistanceMetric::kAbsDiff:
+                return CompareDistance(std::abs(ToNumber(*lhs) - ToNumber(*rhs)), source.op,
+                                       source.threshold);
+            case DistanceMetric::kEditDistance:
+                if (!std::holds_alternative<std::string_view>(*lhs)) {
+                    throw std::logic_error("Expected string in LHS for edit distance metric");
+                }
+                if (!std::holds_alternative<std::string_view>(*rhs)) {
+                    throw std::logic_error("Expected string in RHS for edit distance metric");
+                }
+                return EditDistanceCompares(std::get<std::string_view>(*lhs),
+                                            std::get<std::string_view>(*rhs), source.op,
+                                            source.threshold);
+        }
+        throw std::logic_error("Unimplemented distance metric type");
+    }
+
+    bool IsCounterexample(std::vector<vertex_t> const& match) const {
+        auto satisfies = [&](Constraint const& c) { return Satisfies(c, match); };
+        return std::ranges::all_of(lhs_, satisfies) && !std::ranges::all_of(rhs_, satisfies);
+    }
+
+    template <typename Cancelled>
+    bool Search(std::size_t depth, std::vector<vertex_t>& match,
+                Cancelled const& cancelled) const {
+        if (depth == steps_.size()) return IsCounterexample(match);
+        if (cancelled()) return false;
+
+        Step const& step = steps_[depth];
+        auto try_candidate = [&](vertex_t v) {
+            if (!Admits(step, v) || !Connects(depth, match, v)) return false;
+            match[depth] = v;
+            return Search(depth + 1, match, cancelled);
+        };
+        if (step.edges.empty() || step.edges.front().other == depth) {
+            return std::ranges::any_of(step.candidates, try_candidate);
+        }
+        StepEdge const& anchor = step.edges.front();
+        std::span<Arc const> const arcs =
+                index_.GetArcs(match[anchor.other], !anchor.out, anchor.label);
+        for (auto it = arcs.begin(); it != arcs.end(); ++it) {
+            if (it != arcs.begin() && std::prev(it)->vertex == it->vertex) continue;
+            if (try_candidate(it->vertex)) return true;
+        }
+        return false;
+    }
+
+public:
+    Matcher(graph_t const& graph, GraphIndex const& index, model::Gdd const& gdd)
+        : graph_(graph), index_(index), gdd_(gdd) {
+        graph_t const& pattern = gdd.GetPattern();
+        std::size_t const num_vertices = boost::num_vertices(pattern);
+
+        std::vector<Step> vertex_steps(num_vertices);
+        for (vertex_t u = 0; u != num_vertices; ++u) {
+            Step& step = vertex_steps[u];
+            step.pattern_vertex = u;
+            step.label = index.FindLabel(pattern[u].label);
+            for (auto const e : boost::make_iterator_range(boost::out_edges(u, pattern))) {
+                step.out_labels.push_back(index.FindLabel(pattern[e].label));
+            }
+            for (auto const e : boost::make_iterator_range(boost::in_edges(u, pattern))) {
+                step.in_labels.push_back(index.FindLabel(pattern[e].label));
+            }
+            for (auto* labels : {&step.out_labels, &step.in_labels}) {
+                std::ranges::sort(*labels);
+                labels->erase(std::unique(labels->begin(), labels->end()), labels->end());
+                if (!labels->empty() && labels->back() == kNoLabel) step.label = kNoLabel;
+            }
+            if (index.GetVertices(step.label).empty()) has_matches_ = false;
+        }
+        if (!has_matches_) return;
+
+        // Vertices are matched starting with the one with the rarest label, then the one with
+        // the most edges to the matched ones, so that most candidates come from arcs
+        std::vector<std::size_t> positions(num_vertices, kNoPosition);
+        while (steps_.size() != num_vertices) {
+            vertex_t best = num_vertices;
+            std::size_t best_connections = 0;
+            for (vertex_t u = 0; u != num_vertices; ++u) {
+                if (positions[u] != kNoPosition) continue;
+                std::size_t connections = 0;
+                for (auto const e : boost::make_iterator_range(boost::out_edges(u, pattern))) {
+                    connections += positions[boost::target(e, pattern)] != kNoPosition;
+                }
+                for (auto const e : boost::make_iterator_range(boost::in_edges(u, pattern))) {
+                    connections += positions[boost::source(e, pattern)] != kNoPosition;
+                }
+                if (best == num_vertices || connections > best_connections ||
+                    (connections == best_connections &&
+                     index.GetVertices(vertex_steps[u].label).size() <
+                             index.GetVertices(vertex_steps[best].label).size())) {
+                    best = u;
+                    best_connections = connections;
+                }
+            }
+
+            std::size_t const position = steps_.size();
+            positions[best] = position;
+            Step step = std::move(vertex_steps[best]);
+            for (auto const e : boost::make_iterator_range(boost::out_edges(best, pattern))) {
+                std::size_t const other = positions[boost::target(e, pattern)];
+                if (other == kNoPosition) continue;
+                step.edges.push_back({other, index.FindLabel(pattern[e].label), true});
+            }
+            for (auto const e : boost::make_iterator_range(boost::in_edges(best, pattern))) {
+                std::size_t const other = positions[boost::source(e, pattern)];
+                // a loop is already stored as an out-edge
+                if (other == kNoPosition || other == position) continue;
+                step.edges.push_back({other, index.FindLabel(pattern[e].label), false});
+            }
+            // edges to earlier steps go first, the first of them is used to enumerate candidates
+            std::ranges::sort(step.edges, [position](StepEdge const& l, StepEdge const& r) {
+                return std::pair{l.other == position, l} < std::pair{r.other == position, r};
+            });
+            step.edges.erase(std::unique(step.edges.begin(), step.edges.end()), step.edges.end());
+            // only the vertices of such steps are filtered in advance, the others are
+            // checked as they are reached through arcs
+            if (step.edges.empty() || step.edges.front().other == position) {
+                for (vertex_t v : index.GetVertices(step.label)) {
+                    if (Admits(step, v)) step.candidates.push_back(v);
+                }
+                if (step.candidates.empty()) has_matches_ = false;
+            }
+            steps_.push_back(std::move(step));
+        }
+
+        std::unordered_map<std::size_t, std::size_t> id_positions;
+        for (vertex_t u = 0; u != num_vertices; ++u) {
+            id_positions.try_emplace(pattern[u].id, positions[u]);
+        }
+        lhs_ = CompileConstraints(gdd.GetLhs(), id_positions);
+        rhs_ = CompileConstraints(gdd.GetRhs(), id_positions);
+    }
+
+    bool HasMatches() const noexcept {
+        return has_matches_;
+    }
+
+    // Number of candidates of the first pattern vertex, or 1 for an empty pattern
+    std::size_t NumRoots() const noexcept {
+        return steps_.empty() ? 1 : steps_.front().candidates.size();
+    }
+
+    // Searches matches that map the first pattern vertex to one of its candidates in
+    // [begin, end), returning the first one that violates the GDD
+    template <typename Cancelled>
+    std::optional<model::GddCounterexample> FindCounterexample(
+            std::size_t begin, std::size_t end, Cancelled const& cancelled) const {
+        std::vector<vertex_t> match(steps_.size());
+        auto build_counterexample = [&]() {
+            std::unordered_map<vertex_t, vertex_t> mapping;
+            for (std::size_t i = 0; i != steps_.size(); ++i) {
+                mapping.emplace(steps_[i].pattern_vertex, match[i]);
+            }
+            return model::BuildCounterexample(gdd_.GetPattern(), graph_, mapping);
+        };
+        if (steps_.empty()) {
+            if (IsCounterexample(match)) return build_counterexample();
+            return std::nullopt;
+        }
+        Step const& root = steps_.front();
+        for (std::size_t i = begin; i != end; ++i) {
+            if (cancelled()) break;
+            match[0] = root.candidates[i];
+            if (Connects(0, match, match[0]) && Search(1, match, cancelled)) {
+                return build_counterexample();
+            }
+        }
+        return std::nullopt;
+    }
+};
+
+}  // namespace
+
+IndexedGddValidator::IndexedGddValidator() : GddValidator() {
+    RegisterOption(config::kThreadNumberOpt(&threads_num_));
+    MakeOptionsAvailable({config::kThreadNumberOpt.GetName()});
+}
+
+std::optional<model::GddCounterexample> IndexedGddValidator::Holds(model::Gdd const& gdd,
+                                                                   graph_t const& graph) {
+    return FindCounterexamples({&gdd, 1}, graph).front();
+}
+
+std::vector<std::optional<model::GddCounterexample>> IndexedGddValidator::FindCounterexamples(
+        std::span<model::Gdd const> gdds, graph_t const& graph) {
+    std::optional<util::WorkerThreadPool> pool;
+    if (threads_num_ > 1) {
+        pool.emplace(threads_num_);
+    }
+    util::WorkerThreadPool* pool_ptr = pool ? std::addressof(*pool) : nullptr;
+    GraphIndex const index(graph, pool_ptr);
+
+    std::vector<std::optional<Matcher>> matchers(gdds.size());
+    util::ParallelFor(pool_ptr, gdds.size(),
+                      [&](std::size_t i) { matchers[i].emplace(graph, index, gdds[i]); });
+
+    // The search of a GDD is split into chunks of candidates of its first pattern vertex. The
+    // counterexample found in the earliest chunk is kept, so the result does not depend on
+    // scheduling, and later chunks of the GDD are cancelled.
+    struct Task {
+        std::size_t gdd;
+        std::size_t chunk;
+    };
+
+    struct Outcome {
+        std::atomic<std::size_t> first_chunk = std::numeric_limits<std::size_t>::max();
+        std::mutex mutex;
+        std::optional<GddCounterexample> counterexample;
+    };
+
+    std::vector<Task> tasks;
+    for (std::size_t i = 0; i != gdds.size(); ++i) {
+        if (!matchers[i]->HasMatches()) continue;
+        std::size_t const num_chunks = (matchers[i]->NumRoots() + kRootChunkSize - 1) /
+                                       kRootChunkSize;
+        for (std::size_t chunk = 0; chunk != num_chunks; ++chunk) {
+            tasks.push_back({i, chunk});
+        }
+    }
+    std::vector<Outcome> outcomes(gdds.size());
+    util::ParallelFor(pool_ptr, tasks.size(), [&](std::size_t t) {
+        auto const [i, chunk] = tasks[t];
+        Outcome& outcome = outcomes[i];
+        auto cancelled = [&outcome, chunk]() {
+            return outcome.first_chunk.load(std::memory_order_relaxed) < chunk;
+        };
+        if (cancelled()) return;
+        Matcher const& matcher = *matchers[i];
+        std::size_t const begin = chunk * kRootChunkSize;
+        std::size_t const end = std::min(matcher.NumRoots(), begin + kRootChunkSize);
+        std::optional<GddCounterexample> counterexample =
+                matcher.FindCounterexample(begin, end, cancelled);
+        if (!counterexample) return;
+        std::scoped_lock lock(outcome.mutex);
+        if (chunk < outcome.first_chunk) {
+            outcome.counterexample = std::move(counterexample);
+            outcome.first_chunk = chunk;
+        }
+    });
+
+    std::vector<std::optional<GddCounterexample>> counterexamples;
+    counterexamples.reserve(gdds.size());
+    for (Outcome& outcome : outcomes) {
+        counterexamples.push_back(std::move(outcome.counterexample));
+    }
+    return counterexamples;
+}
+
+}  // namespace algos
@@ -0,0 +1,27 @@
+#pragma once
+
+#include "core/algorithms/gdd/gdd_validator/gdd_validator.h"
+
+namespace algos {
+
+// Validates all GDDs against indexes of the graph built once per run: vertices grouped by
+// label, and in- and out-arcs of every vertex sorted by edge label. Matches of a GDD are
+// enumerated along the pattern edges, candidates are filtered by label and by the edge labels
+// they need, and the search of a GDD stops at its first counterexample. GDDs, and the
+// candidates of the first pattern vertex of every GDD, are validated in parallel.
+class IndexedGddValidator : public GddValidator {
+private:
+    using GddCounterexample = model::GddCounterexample;
+
+protected:
+    virtual std::optional<GddCounterexample> Holds(model::Gdd const& gdd,
+                                                   model::gdd::graph_t const& graph) final;
+
+    virtual std::vector<std::optional<GddCounterexample>> FindCounterexamples(
+            std::span<model::Gdd const> gdds, model::gdd::graph_t const& graph) final;
+
+public:
+    IndexedGddValidator();
+};
+
+}  // namespace algos
@@ -396,8 +396,7 @@ void GfdMiner::RegisterOptions() {
 }
 
 void GfdMiner::LoadDataInternal() {
-    std::ifstream f(graph_path_);
-    graph_ = parser::graph_parser::gfd::ReadGraph(f);
+    graph_ = parser::graph_parser::gfd::ReadGraph(graph_path_);
 }
 
 void GfdMiner::ResetState() {}
@@ -1,22 +1,151 @@
 #include "core/algorithms/gfd/gfd_validator/egfd_validator.h"
 
-#include <iostream>
+#include <algorithm>
+#include <memory>
+#include <numeric>
+#include <optional>
+#include <unordered_map>
 
+#include <boost/dynamic_bitset.hpp>
 #include <boost/graph/vf2_sub_graph_iso.hpp>
 
 #include "core/config/equal_nulls/option.h"
 #include "core/config/names_and_descriptions.h"
 #include "core/config/option_using.h"
 #include "core/config/tabular_data/input_table/option.h"
+#include "core/config/thread_number/option.h"
 #include "core/util/logger.h"
+#include "core/util/parallel_for.h"
+#include "core/util/worker_thread_pool.h"
 
 namespace {
 
 using namespace algos;
 using namespace algos::egfd_validator;
 
-using Match = std::vector<
-        std::pair<std::set<model::vertex_t>::iterator, std::set<model::vertex_t>::iterator>>;
+// The graph with its labels replaced by integers and its adjacency lists stored as one sorted
+// array, so that candidates are found without string comparisons or pointer chasing
+class GraphIndex {
+public:
+    struct Neighbour {
+        model::vertex_t vertex;
+        int edge_label;
+    };
+
+private:
+    std::unordered_map<std::string, int> vertex_label_ids_;
+    std::unordered_map<std::string, int> edge_label_ids_;
+    std::vector<int> labels_;
+    std::vector<std::size_t> offsets_;
+    std::vector<Neighbour> neighbours_;
+    std::vector<std::size_t> max_neighbour_degrees_;
+    std::vector<std::vector<model::vertex_t>> label_classes_;
+
+    static int Intern(std::unordered_map<std::string, int>& ids, std::string const& label) {
+        return ids.try_emplace(label, ids.size()).first->second;
+    }
+
+    static int Find(std::unordered_map<std::string, int> const& ids, std::string const& label) {
+        auto it = ids.find(label);
+        return it == ids.end() ? -1 : it->second;
+    }
+
+public:
+    explicit GraphIndex(model::graph_t const& graph) {
+        std::size_t const num_vertices = boost::num_vertices(graph);
+        labels_.reserve(num_vertices);
+        offsets_.reserve(num_vertices + 1);
+        offsets_.push_back(0);
+        for (model::vertex_t v = 0; v < num_vertices; ++v) {
+            int label = Intern(vertex_label_ids_, graph[v].attributes.at("label"));
+            labels_.push_back(label);
+            if (label_classes_.size() <= static_cast<std::size_t>(label)) {
+                label_classes_.resize(label + 1);
+            }
+            label_classes_[label].push_back(v);
+
+            typename boost::graph_traits<model::graph_t>::out_edge_iterator it, end;
+            for (boost::tie(it, end) = boost::out_edges(v, graph); it != end; ++it) {
+                neighbours_.push_back(
+                        {boost::target(*it, graph), Intern(edge_label_ids_, graph[*it].label)});
+            }
+            // stable, so that the first of parallel edges is found first, as by boost::edge
+            std::stable_sort(neighbours_.begin() + offsets_.back(), neighbours_.end(),
+                             [](Neighbour const& a, Neighbour const& b) {
+                                 return a.vertex < b.vertex;
+                             });
+            offsets_.push_back(neighbours_.size());
+        }
+
+        max_neighbour_degrees_.resize(num_vertices);
+        for (model::vertex_t v = 0; v < num_vertices; ++v) {
+            for (Neighbour const& neighbour : GetNeighbours(v)) {
+                max_neighbour_degrees_[v] =
+                        std::max(max_neighbour_degrees_[v], GetDegree(neighbour.vertex));
+            }
+        }
+    }
+
+    std::size_t NumVertices() const {
+        return labels_.size();
+    }
+
+    int GetLabel(model::vertex_t v) const {
+        return labels_[v];
+    }
+
+    std::size_t GetDegree(model::vertex_t v) const {
+        return offsets_[v + 1] - offsets_[v];
+    }
+
+    std::size_t GetMaxNeighbourDegree(model::vertex_t v) const {
+        return max_neighbour_degrees_[v];
+    }
+
+    std::span<Neighbour const> GetNeighbours(model::vertex_t v) const {
+        return {neighbours_.data() + offsets_[v], neighbours_.data() + offsets_[v + 1]};
+    }
+
+    std::vector<model::vertex_t> const& GetLabelClass(int label) const {
+        return label_classes_[label];
+    }
+
+    // Id of a vertex label, -1 if no vertex has it
+    int FindVertexLabel(std::string const& label) const {
+        return Find(vertex_label_ids_, label);
+    }
+
+    // Id of an edge label, -1 if no edge has it
+    int FindEdgeLabel(std::string const& label) const {
+        return Find(edge_label_ids_, label);
+    }
+
+    // Label of the edge between v and w, -1 if there is none
+    int GetEdgeLabel(model::vertex_t v, model::vertex_t w) const {
+        std::span<Neighbour const> neighbours = GetNeighbours(v);
+        auto it = std::lower_bound(
+                neighbours.begin(), neighbours.end(), w,
+                [](Neighbour const& neighbour, model::vertex_t w) { return neighbour.vertex < w; });
+        return (it == neighbours.end() || it->vertex != w) ? -1 : it->edge_label;
+    }
+};
+
+// A pattern vertex, with the properties its candidates are checked against, and labels replaced
+// by the ids of the graph
+struct PatternVertex {
+    int label;
+    std::size_t degree;
+    std::size_t max_neighbour_degree;
+    // number of neighbours with each label
+    std::vector<std::pair<int, std::size_t>> label_degrees;
+};
+
+// Runs fn for every vertex of a level of the BFS tree, on the threads of pool if there is one
+template <typename F>
+void ForEachInLevel(std::set<model::vertex_t> const& lev, util::WorkerThreadPool* pool, F fn) {
+    std::vector<model::vertex_t> const vertices(lev.begin(), lev.end());
+    util::ParallelFor(pool, vertices.size(), [&](std::size_t i) { fn(vertices[i]); });
+}
 
 void FstStepForest(model::graph_t const& graph,
                    std::map<model::vertex_t, std::set<model::vertex_t>>& rooted_subtree,
@@ -122,69 +251,63 @@ void CfDecompose(model::graph_t const& graph, std::set<model::vertex_t>& core,
     }
 }
 
-int Mnd(model::graph_t const& graph, model::vertex_t const& v) {
-    typename boost::graph_traits<model::graph_t>::adjacency_iterator adjacency_it, adjacency_end;
-    boost::tie(adjacency_it, adjacency_end) = boost::adjacent_vertices(v, graph);
-    std::size_t result = 0;
-    for (; adjacency_it != adjacency_end; ++adjacency_it) {
-        if (result < boost::degree(*adjacency_it, graph)) {
-            result = boost::degree(*adjacency_it, graph);
+std::vector<PatternVertex> IndexPattern(GraphIndex const& graph, model::graph_t const& query) {
+    std::vector<PatternVertex> result;
+    typename boost::graph_traits<model::graph_t>::vertex_iterator it, end;
+    for (boost::tie(it, end) = vertices(query); it != end; ++it) {
+        PatternVertex vertex{graph.FindVertexLabel(query[*it].attributes.at("label")),
+                             boost::degree(*it, query), 0, {}};
+        std::map<int, std::size_t> label_degrees;
+        typename boost::graph_traits<model::graph_t>::adjacency_iterator adjacency_it,
+                adjacency_end;
+        boost::tie(adjacency_it, adjacency_end) = boost::adjacent_vertices(*it, query);
+        for (; adjacency_it != adjacency_end; ++adjacency_it) {
+            vertex.max_neighbour_degree =
+                    std::max(vertex.max_neighbour_degree, boost::degree(*adjacency_it, query));
+            label_degrees[graph.FindVertexLabel(query[*adjacency_it].attributes.at("label"))]++;
         }
+        vertex.label_degrees.assign(label_degrees.begin(), label_degrees.end());
+        result.push_back(std::move(vertex));
     }
     return result;
 }
 
-void CountLabelDegrees(model::graph_t const& graph, model::vertex_t const& v,
-                       std::map<std::string, model::vertex_t>& result) {
-    typename boost::graph_traits<model::graph_t>::adjacency_iterator adjacency_it, adjacency_end;
-    boost::tie(adjacency_it, adjacency_end) = boost::adjacent_vertices(v, graph);
-    for (; adjacency_it != adjacency_end; ++adjacency_it) {
-        if (result.find(graph[*adjacency_it].attributes.at("label")) != result.end()) {
-            result[graph[*adjacency_it].attributes.at("label")]++;
-        } else {
-            result.emplace(graph[*adjacency_it].attributes.at("label"), 1);
-        }
-    }
-}
-
-bool CandVerify(model::graph_t const& graph, model::vertex_t const& v, model::graph_t const& query,
-                model::vertex_t const& u) {
-    if (Mnd(graph, v) < Mnd(query, u)) {
+bool CandVerify(GraphIndex const& graph, model::vertex_t const& v, PatternVertex const& u) {
+    if (graph.GetMaxNeighbourDegree(v) < u.max_neighbour_degree) {
         return false;
     }
-    std::map<std::string, model::vertex_t> graph_label_degrees;
-    CountLabelDegrees(graph, v, graph_label_degrees);
-    std::map<std::string, model::vertex_t> query_label_degrees;
-    CountLabelDegrees(query, u, query_label_degrees);
-
-    for (auto const& label_degree : query_label_degrees) {
-        std::string const& label = label_degree.first;
-        std::size_t const& degree = label_degree.second;
-        if (graph_label_degrees.find(label) == graph_label_degrees.end() ||
-            graph_label_degrees.at(label) < degree) {
+    std::vector<std::size_t> degrees(u.label_degrees.size());
+    for (GraphIndex::Neighbour const& neighbour : graph.GetNeighbours(v)) {
+        int label = graph.GetLabel(neighbour.vertex);
+        for (std::size_t i = 0; i < u.label_degrees.size(); ++i) {
+            if (u.label_degrees[i].first == label) {
+                degrees[i]++;
+            }
+        }
+    }
+    for (std::size_t i = 0; i < u.label_degrees.size(); ++i) {
+        if (degrees[i] < u.label_degrees[i].second) {
             return false;
         }
     }
     return true;
 }
 
-void SortComplexity(std::vector<model::vertex_t>& order, model::graph_t const& graph,
-                    model::graph_t const& query,
-                    std::map<std::string, std::set<model::vertex_t>> const& label_classes) {
-    auto cmp_complexity = [&graph, &query, &label_classes](model::vertex_t const& a,
-                                                           model::vertex_t const& b) {
-        std::size_t a_degree = boost::degree(a, query);
+void SortComplexity(std::vector<model::vertex_t>& order, GraphIndex const& graph,
+                    std::vector<PatternVertex> const& pattern) {
+    auto cmp_complexity = [&graph, &pattern](model::vertex_t const& a, model::vertex_t const& b) {
+        std::size_t a_degree = pattern[a].degree;
         int an = 0;
-        for (model::vertex_t const& e : label_classes.at(query[a].attributes.at("label"))) {
-            if (boost::degree(e, graph) >= a_degree) {
+        for (model::vertex_t const& e : graph.GetLabelClass(pattern[a].label)) {
+            if (graph.GetDegree(e) >= a_degree) {
                 an++;
             }
         }
 
-        std::size_t b_degree = boost::degree(b, query);
+        std::size_t b_degree = pattern[b].degree;
         int bn = 0;
-        for (model::vertex_t const& e : label_classes.at(query[b].attributes.at("label"))) {
-            if (boost::degree(e, graph) >= b_degree) {
+        for (model::vertex_t const& e : graph.GetLabelClass(pattern[b].label)) {
+            if (graph.GetDegree(e) >= b_degree) {
                 bn++;
             }
         }
@@ -193,24 +316,23 @@ void SortComplexity(std::vector<model::vertex_t>& order, model::graph_t const& g
     std::sort(order.begin(), order.end(), cmp_complexity);
 }
 
-void SortAccurateComplexity(std::vector<model::vertex_t>& order, model::graph_t const& graph,
-                            model::graph_t const& query,
-                            std::map<std::string, std::set<model::vertex_t>> const& label_classes) {
+void SortAccurateComplexity(std::vector<model::vertex_t>& order, GraphIndex const& graph,
+                            std::vector<PatternVertex> const& pattern) {
     int top = std::min(int(order.size()), 3);
-    auto cmp_accurate_complexity = [&graph, &query, &label_classes](model::vertex_t const& a,
-                                                                    model::vertex_t const& b) {
-        int a_degree = boost::degree(a, query);
+    auto cmp_accurate_complexity = [&graph, &pattern](model::vertex_t const& a,
+                                                      model::vertex_t const& b) {
+        int a_degree = pattern[a].degree;
         int an = 0;
-        for (model::vertex_t const& e : label_classes.at(query[a].attributes.at("label"))) {
-            if (CandVerify(graph, e, query, a)) {
+        for (model::vertex_t const& e : graph.GetLabelClass(pattern[a].label)) {
+            if (CandVerify(graph, e, pattern[a])) {
                 an++;
             }
         }
 
-        int b_degree = boost::degree(b, query);
+        int b_degree = pattern[b].degree;
         int bn = 0;
-        for (model::vertex_t const& e : label_classes.at(query[b].attributes.at("label"))) {
-            if (CandVerify(graph, e, query, b)) {
+        for (model::vertex_t const& e : graph.GetLabelClass(pattern[b].label)) {
+            if (CandVerify(graph, e, pattern[b])) {
                 bn++;
             }
         }
@@ -219,22 +341,12 @@ void SortAccurateComplexity(std::vector<model::vertex_t>& order, model::graph_t
     std::sort(order.begin(), std::next(order.begin(), top), cmp_accurate_complexity);
 }
 
-int GetRoot(model::graph_t const& graph, model::graph_t const& query,
+int GetRoot(GraphIndex const& graph, std::vector<PatternVertex> const& pattern,
             std::set<model::vertex_t> const& core) {
-    std::map<std::string, std::set<model::vertex_t>> label_classes;
-    typename boost::graph_traits<model::graph_t>::vertex_iterator it, end;
-    for (boost::tie(it, end) = vertices(graph); it != end; ++it) {
-        if (label_classes.find(graph[*it].attributes.at("label")) != label_classes.end()) {
-            label_classes[graph[*it].attributes.at("label")].insert(*it);
-        } else {
-            std::set<model::vertex_t> value = {*it};
-            label_classes.emplace(graph[*it].attributes.at("label"), value);
-        }
-    }
     std::vector<model::vertex_t> order(core.begin(), core.end());
 
-    SortComplexity(order, graph, query, label_classes);
-    SortAccurateComplexity(order, graph, query, label_classes);
+    SortComplexity(order, graph, pattern);
+    SortAccurateComplexity(order, graph, pattern);
     return *order.begin();
 }
 
@@ -297,317 +409,213 @@ void BfsTree(model::graph_t const& query, model::vertex_t const& root,
     MakeNte(query, levels, parent, nte, snte);
 }
 
-void DirectConstruction(std::set<model::vertex_t> const& lev, model::graph_t const& graph,
-                        model::graph_t const& query,
-                        std::map<model::vertex_t, std::set<model::vertex_t>>& candidates,
-                        std::map<model::vertex_t, int>& cnts,
+// Graph vertices that may be matched to u, judged by label and degree, adjacent to some
+// candidate of the pattern vertex w
+boost::dynamic_bitset<> Reached(GraphIndex const& graph, CPI const& cpi, model::vertex_t w,
+                                PatternVertex const& u) {
+    boost::dynamic_bitset<> reached(graph.NumVertices());
+    for (model::vertex_t const& v : cpi.GetCandidates(w)) {
+        for (GraphIndex::Neighbour const& neighbour : graph.GetNeighbours(v)) {
+            if (graph.GetLabel(neighbour.vertex) == u.label &&
+                graph.GetDegree(neighbour.vertex) >= u.degree) {
+                reached.set(neighbour.vertex);
+            }
+        }
+    }
+    return reached;
+}
+
+// Intersects the sets of vertices reached from the candidates of each of the neighbours
+void Intersect(boost::dynamic_bitset<>& allowed, boost::dynamic_bitset<>&& reached, int& cnt) {
+    if (cnt == 0) {
+        allowed = std::move(reached);
+    } else {
+        allowed &= reached;
+    }
+    cnt++;
+}
+
+void DirectConstruction(std::set<model::vertex_t> const& lev, GraphIndex const& graph,
+                        model::graph_t const& query, std::vector<PatternVertex> const& pattern,
+                        CPI& cpi,
                         std::map<model::vertex_t, std::set<model::vertex_t>>& unvisited_neighbours,
                         std::set<model::edge_t> const& snte, std::set<model::vertex_t>& visited) {
     for (model::vertex_t const& u : lev) {
         int cnt = 0;
+        boost::dynamic_bitset<> allowed;
         typename boost::graph_traits<model::graph_t>::adjacency_iterator adjacency_it,
                 adjacency_end;
         boost::tie(adjacency_it, adjacency_end) = boost::adjacent_vertices(u, query);
         for (; adjacency_it != adjacency_end; ++adjacency_it) {
-            if (visited.find(query[*adjacency_it].node_id) == visited.end() &&
+            if (visited.find(*adjacency_it) == visited.end() &&
                 snte.find(boost::edge(*adjacency_it, u, query).first) != snte.end()) {
-                if (unvisited_neighbours.find(u) != unvisited_neighbours.end()) {
-                    unvisited_neighbours.at(u).insert(*adjacency_it);
-                } else {
-                    std::set<model::vertex_t> value = {*adjacency_it};
-                    unvisited_neighbours.emplace(u, value);
-                }
+                unvisited_neighbours[u].insert(*adjacency_it);
             } else if (visited.find(*adjacency_it) != visited.end()) {
-                for (model::vertex_t const& v : candidates.at(*adjacency_it)) {
-                    typename boost::graph_traits<model::graph_t>::adjacency_iterator g_adj_it,
-                            g_adj_end;
-                    boost::tie(g_adj_it, g_adj_end) = boost::adjacent_vertices(v, graph);
-                    for (; g_adj_it != g_adj_end; ++g_adj_it) {
-                        if (graph[*g_adj_it].attributes.at("label") ==
-                                    query[u].attributes.at("label") &&
-                            boost::degree(*g_adj_it, graph) >= boost::degree(u, query)) {
-                            if (cnts.find(*g_adj_it) == cnts.end()) {
-                                if (cnt == 0) {
-                                    cnts.emplace(*g_adj_it, 1);
-                                }
-                            } else {
-                                if (cnts.at(*g_adj_it) == cnt) {
-                                    cnts[*g_adj_it]++;
-                                }
-                            }
-                        }
-                    }
-                }
-                cnt++;
+                Intersect(allowed, Reached(graph, cpi, *adjacency_it, pattern[u]), cnt);
             }
         }
-        typename boost::graph_traits<model::graph_t>::vertex_iterator g_it, g_end;
-        for (boost::tie(g_it, g_end) = vertices(graph); g_it != g_end; ++g_it) {
-            if (((cnts.find(*g_it) == cnts.end()) && (cnt == 0)) ||
-                ((cnts.find(*g_it) != cnts.end()) && (cnts.at(*g_it) == cnt))) {
-                if (CandVerify(graph, *g_it, query, u)) {
-                    candidates.at(u).insert(*g_it);
+
+        std::vector<model::vertex_t>& candidates = cpi.GetCandidates(u);
+        if (cnt == 0) {
+            for (model::vertex_t const& v : graph.GetLabelClass(pattern[u].label)) {
+                if (graph.GetDegree(v) >= pattern[u].degree && CandVerify(graph, v, pattern[u])) {
+                    candidates.push_back(v);
+                }
+            }
+        } else {
+            for (std::size_t v = allowed.find_first(); v != boost::dynamic_bitset<>::npos;
+                 v = allowed.find_next(v)) {
+                if (CandVerify(graph, v, pattern[u])) {
+                    candidates.push_back(v);
                 }
             }
         }
         visited.insert(u);
-        cnts.clear();
     }
 }
 
 void ReverseConstruction(
-        std::set<model::vertex_t> const& lev, model::graph_t const& graph,
-        model::graph_t const& query,
-        std::map<model::vertex_t, std::set<model::vertex_t>>& candidates,
-        std::map<model::vertex_t, int>& cnts,
-        std::map<model::vertex_t, std::set<model::vertex_t>>& unvisited_neighbours) {
+        std::set<model::vertex_t> const& lev, GraphIndex const& graph,
+        std::vector<PatternVertex> const& pattern, CPI& cpi,
+        std::map<model::vertex_t, std::set<model::vertex_t>> const& unvisited_neighbours) {
     for (auto j = lev.rbegin(); j != lev.rend(); ++j) {
         model::vertex_t u = *j;
+        if (unvisited_neighbours.find(u) == unvisited_neighbours.end()) {
+            continue;
+        }
         int cnt = 0;
-        if (unvisited_neighbours.find(u) != unvisited_neighbours.end()) {
-            for (model::vertex_t const& un : unvisited_neighbours.at(u)) {
-                for (model::vertex_t const& v : candidates.at(un)) {
-                    typename boost::graph_traits<model::graph_t>::adjacency_iterator g_adj_it,
-                            g_adj_end;
-                    boost::tie(g_adj_it, g_adj_end) =
-                            boost::adjacent_vertices(boost::vertex(v, graph), graph);
-                    for (; g_adj_it != g_adj_end; ++g_adj_it) {
-                        if (graph[*g_adj_it].attributes.at("label") ==
-                                    query[u].attributes.at("label") &&
-                            boost::degree(*g_adj_it, graph) >= boost::degree(u, query)) {
-                            if (cnts.find(*g_adj_it) == cnts.end()) {
-                                if (cnt == 0) {
-                                    cnts.emplace(*g_adj_it, 1);
-                                }
-                            } else {
-                                if (cnts.at(*g_adj_it) == cnt) {
-                                    cnts[*g_adj_it]++;
-                                }
-                            }
-                        }
-                    }
-                }
-                cnt++;
-            }
+        boost::dynamic_bitset<> allowed;
+        for (model::vertex_t const& un : unvisited_neighbours.at(u)) {
+            Intersect(allowed, Reached(graph, cpi, un, pattern[u]), cnt);
         }
 
-        std::set<model::vertex_t> to_delete = {};
-        for (model::vertex_t const& v : candidates.at(u)) {
-            if (!(((cnts.find(v) == cnts.end()) && (cnt == 0)) ||
-                  ((cnts.find(v) != cnts.end()) && (cnts.at(v) == cnt)))) {
-                to_delete.insert(v);
-            }
-        }
-        for (model::vertex_t const& d : to_delete) {
-            candidates.at(u).erase(d);
-        }
-        cnts.clear();
+        std::vector<model::vertex_t>& candidates = cpi.GetCandidates(u);
+        std::erase_if(candidates, [&allowed](model::vertex_t v) { return !allowed.test(v); });
     }
 }
 
-void FinalConstruction(std::set<model::vertex_t> const& lev, CPI& cpi, model::graph_t const& graph,
+void FinalConstruction(std::set<model::vertex_t> const& lev, CPI& cpi, GraphIndex const& graph,
                        model::graph_t const& query,
                        std::map<model::vertex_t, model::vertex_t> const& parent,
-                       std::map<model::vertex_t, std::set<model::vertex_t>>& candidates) {
-    for (model::vertex_t const& u : lev) {
+                       util::WorkerThreadPool* pool) {
+    ForEachInLevel(lev, pool, [&](model::vertex_t const& u) {
         model::vertex_t up = parent.at(u);
-        for (model::vertex_t const& vp : candidates.at(up)) {
-            typename boost::graph_traits<model::graph_t>::adjacency_iterator g_adj_it, g_adj_end;
-            boost::tie(g_adj_it, g_adj_end) = boost::adjacent_vertices(vp, graph);
-            for (; g_adj_it != g_adj_end; ++g_adj_it) {
-                if (graph[*g_adj_it].attributes.at("label") == query[u].attributes.at("label") &&
-                    boost::degree(*g_adj_it, graph) >= boost::degree(u, query) &&
-                    candidates.at(u).find(*g_adj_it) != candidates.at(u).end() &&
-                    query[boost::edge(up, u, query).first].label ==
-                            graph[boost::edge(vp, *g_adj_it, graph).first].label) {
-                    std::pair<model::vertex_t, model::vertex_t> cpi_edge(up, u);
-                    if (cpi.find(cpi_edge) != cpi.end()) {
-                        if (cpi.at(cpi_edge).find(vp) != cpi.at(cpi_edge).end()) {
-                            cpi.at(cpi_edge).at(vp).insert(*g_adj_it);
-                        } else {
-                            std::set<model::vertex_t> value = {*g_adj_it};
-                            cpi.at(cpi_edge).emplace(vp, value);
-                        }
-                    } else {
-                        std::map<model::vertex_t, std::set<model::vertex_t>> edge_map;
-                        std::set<model::vertex_t> value = {*g_adj_it};
-                        edge_map.emplace(vp, value);
-                        cpi.emplace(cpi_edge, edge_map);
-                    }
+        int label = graph.FindEdgeLabel(query[boost::edge(up, u, query).first].label);
+        std::vector<model::vertex_t> const& candidates = cpi.GetCandidates(u);
+        CPI::TreeEdge& edge = cpi.GetTreeEdge(u);
+        for (model::vertex_t const& vp : cpi.GetCandidates(up)) {
+            std::size_t row_begin = edge.children.size();
+            for (GraphIndex::Neighbour const& neighbour : graph.GetNeighbours(vp)) {
+                // neighbours are sorted, so parallel edges are adjacent
+                if (neighbour.edge_label == label &&
+                    (edge.children.size() == row_begin ||
+                     edge.children.back() != neighbour.vertex) &&
+                    std::binary_search(candidates.begin(), candidates.end(), neighbour.vertex)) {
+                    edge.children.push_back(neighbour.vertex);
                 }
             }
+            edge.offsets.push_back(edge.children.size());
         }
-    }
+    });
 }
 
-void TopDownConstruct(CPI& cpi, model::graph_t const& graph, model::graph_t const& query,
+void TopDownConstruct(CPI& cpi, GraphIndex const& graph, model::graph_t const& query,
+                      std::vector<PatternVertex> const& pattern,
                       std::vector<std::set<model::vertex_t>> const& levels,
                       std::map<model::vertex_t, model::vertex_t> const& parent,
-                      std::map<model::vertex_t, std::set<model::vertex_t>>& candidates,
-                      std::set<model::edge_t> const& snte) {
+                      std::set<model::edge_t> const& snte, util::WorkerThreadPool* pool) {
     model::vertex_t root = *levels.at(0).begin();
-    typename boost::graph_traits<model::graph_t>::vertex_iterator it, end;
-    for (boost::tie(it, end) = vertices(query); it != end; ++it) {
-        std::set<model::vertex_t> empty = {};
-        candidates.emplace(*it, empty);
-    }
-
-    for (boost::tie(it, end) = vertices(graph); it != end; ++it) {
-        if (graph[*it].attributes.at("label") == query[root].attributes.at("label") &&
-            boost::degree(*it, graph) >= boost::degree(root, query) &&
-            CandVerify(graph, *it, query, root)) {
-            candidates.at(root).insert(*it);
+    for (model::vertex_t const& v : graph.GetLabelClass(pattern[root].label)) {
+        if (graph.GetDegree(v) >= pattern[root].degree && CandVerify(graph, v, pattern[root])) {
+            cpi.GetCandidates(root).push_back(v);
         }
     }
     std::set<model::vertex_t> visited = {root};
     std::map<model::vertex_t, std::set<model::vertex_t>> unvisited_neighbours;
-    std::map<model::vertex_t, int> cnts;
 
     std::vector<std::set<model::vertex_t>>::const_iterator i = std::next(levels.cbegin());
     for (; i != levels.cend(); ++i) {
-        std::set<model::vertex_t> lev = *i;
-        DirectConstruction(lev, graph, query, candidates, cnts, unvisited_neighbours, snte,
-                           visited);
-        ReverseConstruction(lev, graph, query, candidates, cnts, unvisited_neighbours);
-        FinalConstruction(lev, cpi, graph, query, parent, candidates);
-    }
-}
-
-void InitialRefinement(model::vertex_t const& u, model::graph_t const& graph,
-                       model::graph_t const& query,
-                       std::map<model::vertex_t, model::vertex_t> const& parent,
-                       std::map<model::vertex_t, std::set<model::vertex_t>>& candidates,
-                       std::map<model::vertex_t, int>& cnts, int& cnt) {
-    typename boost::graph_traits<model::graph_t>::adjacency_iterator q_adj_it, q_adj_end;
-    boost::tie(q_adj_it, q_adj_end) = boost::adjacent_vertices(u, query);
-    for (; q_adj_it != q_adj_end; ++q_adj_it) {
-        if ((parent.find(*q_adj_it) != parent.end()) && (parent.at(*q_adj_it) == u)) {
-            for (model::vertex_t const& v : candidates.at(*q_adj_it)) {
-                typename boost::graph_traits<model::graph_t>::adjacency_iterator g_adj_it,
-                        g_adj_end;
-                boost::tie(g_adj_it, g_adj_end) = boost::adjacent_vertices(v, graph);
-                for (; g_adj_it != g_adj_end; ++g_adj_it) {
-                    if (graph[*g_adj_it].attributes.at("label") ==
-                                query[u].attributes.at("label") &&
-                        boost::degree(*g_adj_it, graph) >= boost::degree(u, query)) {
-                        if (cnts.find(*g_adj_it) == cnts.end()) {
-                            if (cnt == 0) {
-                                cnts.emplace(*g_adj_it, 1);
-                            }
-                        } else {
-                            if (cnts.at(*g_adj_it) == cnt) {
-                                cnts[*g_adj_it]++;
-                            }
-                        }
-                    }
-                }
-            }
-            cnt++;
-        }
+        std::set<model::vertex_t> const& lev = *i;
+        DirectConstruction(lev, graph, query, pattern, cpi, unvisited_neighbours, snte, visited);
+        ReverseConstruction(lev, graph, pattern, cpi, unvisited_neighbours);
+        FinalConstruction(lev, cpi, graph, query, parent, pool);
     }
 }
 
-void OddDeletion(model::vertex_t const& u, CPI& cpi,
-                 std::map<model::vertex_t, std::set<model::vertex_t>>& candidates,
-                 std::map<model::vertex_t, int>& cnts, int& cnt) {
-    std::set<model::vertex_t> to_delete = {};
-    for (model::vertex_t const& v : candidates.at(u)) {
-        if (!(((cnts.find(v) == cnts.end()) && (cnt == 0)) ||
-              ((cnts.find(v) != cnts.end()) && (cnts.at(v) == cnt)))) {
-            to_delete.insert(v);
-        }
+// Removes the candidates of u that are not adjacent to a candidate of each of its children in
+// the BFS tree, and the children that are no longer candidates from the tree edges below u
+void Refine(model::vertex_t const& u, CPI& cpi, GraphIndex const& graph,
+            std::vector<PatternVertex> const& pattern,
+            std::vector<model::vertex_t> const& children) {
+    if (children.empty()) {
+        return;
     }
-    for (model::vertex_t const& d : to_delete) {
-        candidates.at(u).erase(d);
-        for (auto const& e : cpi) {
-            if (e.second.find(d) != e.second.end()) {
-                cpi.at(e.first).erase(d);
-            }
-        }
+    int cnt = 0;
+    boost::dynamic_bitset<> allowed;
+    for (model::vertex_t const& child : children) {
+        Intersect(allowed, Reached(graph, cpi, child, pattern[u]), cnt);
     }
-    cnts.clear();
-}
 
-void FinalRefinement(model::vertex_t const& u, CPI& cpi, model::graph_t const& query,
-                     std::map<model::vertex_t, model::vertex_t> const& parent,
-                     std::map<model::vertex_t, std::set<model::vertex_t>>& candidates) {
-    for (model::vertex_t const& v : candidates.at(u)) {
-        typename boost::graph_traits<model::graph_t>::adjacency_iterator q_adj_it, q_adj_end;
-        boost::tie(q_adj_it, q_adj_end) = boost::adjacent_vertices(u, query);
-        for (; q_adj_it != q_adj_end; ++q_adj_it) {
-            model::vertex_t u2 = *q_adj_it;
-            if ((parent.find(u2) != parent.end()) && (parent.at(u2) == u)) {
-                std::pair<model::vertex_t, model::vertex_t> cpi_edge(u, u2);
-                for (model::vertex_t const& v2 : cpi.at(cpi_edge).at(v)) {
-                    if (candidates.at(u2).find(v2) == candidates.at(u2).end()) {
-                        cpi.at(cpi_edge).at(v).erase(v2);
-                    }
+    std::vector<model::vertex_t>& candidates = cpi.GetCandidates(u);
+    for (model::vertex_t const& child : children) {
+        std::vector<model::vertex_t> const& child_candidates = cpi.GetCandidates(child);
+        CPI::TreeEdge& edge = cpi.GetTreeEdge(child);
+        CPI::TreeEdge refined;
+        for (std::size_t i = 0; i < candidates.size(); ++i) {
+            if (!allowed.test(candidates[i])) {
+                continue;
+            }
+            for (model::vertex_t const& v : cpi.GetChildren(child, i)) {
+                if (std::binary_search(child_candidates.begin(), child_candidates.end(), v)) {
+                    refined.children.push_back(v);
                 }
             }
+            refined.offsets.push_back(refined.children.size());
         }
+        edge = std::move(refined);
     }
+    std::erase_if(candidates, [&allowed](model::vertex_t v) { return !allowed.test(v); });
 }
 
-void BottomUpRefinement(CPI& cpi, model::graph_t const& graph, model::graph_t const& query,
+void BottomUpRefinement(CPI& cpi, GraphIndex const& graph,
+                        std::vector<PatternVertex> const& pattern,
                         std::vector<std::set<model::vertex_t>> const& levels,
                         std::map<model::vertex_t, model::vertex_t> const& parent,
-                        std::map<model::vertex_t, std::set<model::vertex_t>>& candidates) {
-    std::map<model::vertex_t, int> cnts;
-
-    std::vector<std::set<model::vertex_t>>::const_iterator lev_it;
-    for (lev_it = --levels.cend(); lev_it != std::next(levels.begin(), -1); --lev_it) {
-        for (model::vertex_t const& u : *lev_it) {
-            int cnt = 0;
-            InitialRefinement(u, graph, query, parent, candidates, cnts, cnt);
-            OddDeletion(u, cpi, candidates, cnts, cnt);
-            FinalRefinement(u, cpi, query, parent, candidates);
-        }
-    }
-}
-
-int NumOfEmbeddings(const CPI& cpi, std::vector<model::vertex_t> const& path,
-                    model::vertex_t const& origin) {
-    std::map<std::pair<model::vertex_t, model::vertex_t>, int> result;
-    std::pair<model::vertex_t, model::vertex_t> edge(*(std::next(path.end(), -2)),
-                                                     *(std::next(path.end(), -1)));
-    for (auto& vert_cans : cpi.at(edge)) {
-        for (model::vertex_t const& can : vert_cans.second) {
-            std::pair<model::vertex_t, model::vertex_t> key(*(std::next(path.end(), -1)), can);
-            result.emplace(key, 1);
-        }
-    }
-
-    for (int i = path.size() - 1; path.at(i) != origin; --i) {
-        std::map<std::pair<model::vertex_t, model::vertex_t>, int> new_result;
-        std::pair<model::vertex_t, model::vertex_t> cur_edge(path.at(i - 1), path.at(i));
-        for (auto& vert_cans : cpi.at(cur_edge)) {
-            for (model::vertex_t const& can : vert_cans.second) {
-                std::pair<model::vertex_t, model::vertex_t> key(path.at(i - 1), vert_cans.first);
-                std::pair<model::vertex_t, model::vertex_t> counted(path.at(i), can);
-                if (new_result.find(key) != new_result.end()) {
-                    new_result[key] += result.at(counted);
-                } else {
-                    new_result.emplace(key, result.at(counted));
-                }
+                        util::WorkerThreadPool* pool) {
+    std::vector<std::vector<model::vertex_t>> children(pattern.size());
+    for (auto const& [child, up] : parent) {
+        children[up].push_back(child);
+    }
+
+    // vertices of a level only change their own candidates and the tree edges to their
+    // children, so they are refined in parallel
+    std::vector<std::set<model::vertex_t>>::const_reverse_iterator lev_it;
+    for (lev_it = levels.crbegin(); lev_it != levels.crend(); ++lev_it) {
+        ForEachInLevel(*lev_it, pool, [&](model::vertex_t const& u) {
+            Refine(u, cpi, graph, pattern, children[u]);
+        });
+    }
+}
+
+// Number of embeddings of the part of the path below origin in the CPI
+std::size_t NumOfEmbeddings(const CPI& cpi, std::vector<model::vertex_t> const& path,
+                            model::vertex_t const& origin) {
+    std::vector<std::size_t> counts(cpi.GetCandidates(path.back()).size(), 1);
+    for (std::size_t i = path.size() - 1; path.at(i) != origin; --i) {
+        model::vertex_t u = path.at(i);
+        std::vector<std::size_t> parent_counts(cpi.GetCandidates(path.at(i - 1)).size());
+        for (std::size_t j = 0; j < parent_counts.size(); ++j) {
+            for (model::vertex_t const& v : cpi.GetChildren(u, j)) {
+                parent_counts[j] += counts[cpi.FindCandidate(u, v)];
             }
         }
-        result = new_result;
-    }
-    int answer = 0;
-    for (auto& values : result) {
-        answer += values.second;
+        counts = std::move(parent_counts);
     }
-    return answer;
+    return std::accumulate(counts.begin(), counts.end(), std::size_t{0});
 }
 
-int CandidatesCardinality(const CPI& cpi, model::vertex_t const& u) {
-    for (auto& edge_cans : cpi) {
-        auto edge = edge_cans.first;
-        if (edge.first == u) {
-            return edge_cans.second.size();
-        }
-    }
-    return 1;
+std::size_t CandidatesCardinality(const CPI& cpi, model::vertex_t const& u) {
+    return std::max<std::size_t>(cpi.GetCandidates(u).size(), 1);
 }
 
 void BuildOptimalSeq(const CPI& cpi, std::vector<std::vector<model::vertex_t>> const& paths_origin,
@@ -676,32 +684,18 @@ std::vector<model::vertex_t> MatchingOrder(
     while (!paths.empty()) {
         std::vector<model::vertex_t> pi_new;
         BuildAccurateOptimalSeq(cpi, paths_origin, origins, paths, pi_new);
+        // paths share their beginnings with the ones already in seq, the rest of the path goes
+        // after them, so that every vertex follows its parent
         std::vector<model::vertex_t>::iterator pi_it = pi_new.begin();
-        std::vector<model::vertex_t>::iterator seq_it = seq.begin();
-        for (; *pi_it == *seq_it; ++pi_it, ++seq_it) {
+        while (pi_it != pi_new.end() && std::find(seq.begin(), seq.end(), *pi_it) != seq.end()) {
+            ++pi_it;
         }
-        seq.insert(seq_it, pi_it, pi_new.end());
+        seq.insert(seq.end(), pi_it, pi_new.end());
         paths.erase(std::remove(paths.begin(), paths.end(), pi_new), paths.end());
     }
     return seq;
 }
 
-bool ValidateNt(model::graph_t const& graph, model::vertex_t const& v, model::graph_t const& query,
-                model::vertex_t const& u, std::vector<model::vertex_t> const& seq,
-                std::map<model::vertex_t, model::vertex_t> const& parent, Match match) {
-    int index = std::find(seq.begin(), seq.end(), u) - seq.begin();
-    for (int i = 0; i < index; ++i) {
-        if ((seq.at(i) != parent.at(u)) && boost::edge(seq.at(i), u, query).second) {
-            if (!boost::edge(*match.at(i).first, v, graph).second ||
-                graph[boost::edge(*match.at(i).first, v, graph).first].label !=
-                        query[boost::edge(seq.at(i), u, query).first].label) {
-                return false;
-            }
-        }
-    }
-    return true;
-}
-
 std::vector<std::vector<model::vertex_t>> GetPaths(
         std::set<model::vertex_t> const& indices,
         std::map<model::vertex_t, model::vertex_t> const& parent_) {
@@ -739,58 +733,6 @@ std::vector<std::vector<model::vertex_t>> GetPaths(
     return result;
 }
 
-bool Visited(Match const& match, model::vertex_t const& v, std::size_t const& index) {
-    for (std::size_t i = 0; i < match.size(); ++i) {
-        if (i != index) {
-            if ((match.at(i).first != match.at(i).second) && (*match.at(i).first == v)) {
-                return true;
-            }
-        }
-    }
-    return false;
-}
-
-bool Satisfied(model::graph_t const& graph, model::graph_t const& query,
-               std::vector<model::vertex_t> const& seq, Match const& match,
-               std::vector<model::Gfd::Literal> const& literals) {
-    for (model::Gfd::Literal const& l : literals) {
-        auto fst_token = l.first;
-        auto snd_token = l.second;
-        std::string fst;
-        std::string snd;
-        if (fst_token.first == -1) {
-            fst = fst_token.second;
-        } else {
-            model::vertex_t v;
-            model::vertex_t u = boost::vertex(fst_token.first, query);
-            int index = std::find(seq.begin(), seq.end(), u) - seq.begin();
-            v = *match.at(index).first;
-            auto attrs = graph[v].attributes;
-            if (attrs.find(fst_token.second) == attrs.end()) {
-                return false;
-            }
-            fst = attrs.at(fst_token.second);
-        }
-        if (snd_token.first == -1) {
-            snd = snd_token.second;
-        } else {
-            model::vertex_t v;
-            model::vertex_t u = boost::vertex(snd_token.first, query);
-            int index = std::find(seq.begin(), seq.end(), u) - seq.begin();
-            v = *match.at(index).first;
-            auto attrs = graph[v].attributes;
-            if (attrs.find(snd_token.second) == attrs.end()) {
-                return false;
-            }
-            snd = attrs.at(snd_token.second);
-        }
-        if (fst != snd) {
-            return false;
-        }
-    }
-    return true;
-}
-
 void FullNTs(std::vector<std::vector<model::vertex_t>> const& paths,
              std::set<model::edge_t> const& nte, model::graph_t const& query,
              std::vector<model::vertex_t>& NTs) {
@@ -808,7 +750,7 @@ void FullNTs(std::vector<std::vector<model::vertex_t>> const& paths,
     }
 }
 
-void CompleteSeq(CPI& cpi, std::vector<std::set<model::vertex_t>> const& forest,
+void CompleteSeq(CPI const& cpi, std::vector<std::set<model::vertex_t>> const& forest,
                  std::map<model::vertex_t, model::vertex_t> const& parent,
                  model::graph_t const& query, std::set<model::edge_t> const& nte,
                  std::vector<model::vertex_t>& seq) {
@@ -834,217 +776,126 @@ void CompleteSeq(CPI& cpi, std::vector<std::set<model::vertex_t>> const& forest,
     }
 }
 
-bool FullMatch(CPI& cpi, Match& match, std::set<model::vertex_t> const& root_candidates,
-               std::set<model::vertex_t> const& core, std::vector<model::vertex_t> const& seq,
-               std::map<model::vertex_t, model::vertex_t> const& parent,
-               model::graph_t const& graph, model::graph_t const& query) {
-    match.emplace_back(root_candidates.begin(), root_candidates.end());
-    for (std::size_t i = 1; i < core.size(); ++i) {
-        std::pair<model::vertex_t, model::vertex_t> edge(parent.at(seq.at(i)), seq.at(i));
-        int index = std::find(seq.begin(), seq.end(), parent.at(seq.at(i))) - seq.begin();
-        std::pair<std::set<model::vertex_t>::iterator, std::set<model::vertex_t>::iterator> its(
-                cpi.at(edge).at(*match.at(index).first).begin(),
-                cpi.at(edge).at(*match.at(index).first).end());
-        match.push_back(its);
-
-        while ((match.at(i).first != match.at(i).second) &&
-               (Visited(match, *match.at(i).first, i) ||
-                !ValidateNt(graph, *match.at(i).first, query, seq.at(i), seq, parent, match))) {
-            match.at(i).first++;
-        }
-        if (match.at(i).first == match.at(i).second) {
-            LOG_DEBUG("Trivially satisfied");
-            return true;
-        }
-    }
-    for (std::size_t i = core.size(); i < seq.size(); ++i) {
-        match.emplace_back(root_candidates.end(), root_candidates.end());
+std::string const* GetValue(model::graph_t const& graph, std::vector<model::vertex_t> const& match,
+                            model::Gfd::Token const& token) {
+    if (token.first == -1) {
+        return &token.second;
     }
-    return false;
+    auto const& attrs = graph[match.at(token.first)].attributes;
+    auto it = attrs.find(token.second);
+    return it == attrs.end() ? nullptr : &it->second;
 }
 
-void IncrementMatch(int& i, const CPI& cpi, Match& match,
-                    std::map<model::vertex_t, model::vertex_t> const& parent,
-                    std::set<model::vertex_t> const& core, std::vector<model::vertex_t> const& seq,
-                    model::graph_t const& graph, model::graph_t const& query) {
-    while ((i != static_cast<int>(core.size())) && (i != -1)) {
-        if (match.at(i).first == match.at(i).second) {
-            std::pair<model::vertex_t, model::vertex_t> edge(parent.at(seq.at(i)), seq.at(i));
-            std::size_t index =
-                    std::find(seq.begin(), seq.end(), parent.at(seq.at(i))) - seq.begin();
-            std::pair<std::set<model::vertex_t>::iterator, std::set<model::vertex_t>::iterator> its(
-                    cpi.at(edge).at(*match.at(index).first).begin(),
-                    cpi.at(edge).at(*match.at(index).first).end());
-            match[i] = its;
-        } else {
-            match.at(i).first++;
-        }
-
-        while ((match.at(i).first != match.at(i).second) &&
-               (Visited(match, *match.at(i).first, i) ||
-                !ValidateNt(graph, *match.at(i).first, query, seq.at(i), seq, parent, match))) {
-            match.at(i).first++;
-        };
-
-        if (match.at(i).first == match.at(i).second) {
-            i--;
-            continue;
-        }
-        i++;
-    }
-}
-
-bool CheckTrivially(const CPI& cpi, Match& match,
-                    std::map<model::vertex_t, model::vertex_t> const& parent,
-                    std::set<model::vertex_t> const& core,
-                    std::vector<model::vertex_t> const& seq) {
-    for (std::size_t k = core.size(); k < seq.size(); ++k) {
-        std::pair<model::vertex_t, model::vertex_t> edge(parent.at(seq.at(k)), seq.at(k));
-        std::size_t index = std::find(seq.begin(), seq.end(), parent.at(seq.at(k))) - seq.begin();
-        std::pair<std::set<model::vertex_t>::iterator, std::set<model::vertex_t>::iterator> its(
-                cpi.at(edge).at(*match.at(index).first).begin(),
-                cpi.at(edge).at(*match.at(index).first).end());
-        match[k] = its;
-
-        while ((match.at(k).first != match.at(k).second) && Visited(match, *match.at(k).first, k)) {
-            match.at(k).first++;
-        }
-        if (match.at(k).first == match.at(k).second) {
-            LOG_DEBUG("Trivially satisfied");
-            return true;
-        }
-    }
-    return false;
-}
-
-bool CheckMatch(const CPI& cpi, Match& match,
-                std::map<model::vertex_t, model::vertex_t> const& parent,
-                std::set<model::vertex_t> const& core, std::vector<model::vertex_t> const& seq,
-                model::graph_t const& graph, model::graph_t const& query, model::Gfd const& gfd,
-                int& amount) {
-    while (true) {
-        std::size_t j = seq.size() - 1;
-        while ((j != seq.size()) && (j != core.size() - 1)) {
-            if (match.at(j).first == match.at(j).second) {
-                std::pair<model::vertex_t, model::vertex_t> edge(parent.at(seq.at(j)), seq.at(j));
-                std::size_t index =
-                        std::find(seq.begin(), seq.end(), parent.at(seq.at(j))) - seq.begin();
-                std::pair<std::set<model::vertex_t>::iterator, std::set<model::vertex_t>::iterator>
-                        its(cpi.at(edge).at(*match.at(index).first).begin(),
-                            cpi.at(edge).at(*match.at(index).first).end());
-                match[j] = its;
-            } else {
-                match.at(j).first++;
-            }
-
-            while ((match.at(j).first != match.at(j).second) &&
-                   Visited(match, *match.at(j).first, j)) {
-                match.at(j).first++;
-            };
-            if (match.at(j).first == match.at(j).second) {
-                j--;
-                continue;
-            }
-            j++;
-        }
-        if (j == core.size() - 1) {
-            break;
-        }
-
-        amount++;
-        // check
-        if (!Satisfied(graph, query, seq, match, gfd.GetPremises())) {
-            continue;
+bool Satisfied(model::graph_t const& graph, std::vector<model::vertex_t> const& match,
+               std::vector<model::Gfd::Literal> const& literals) {
+    for (model::Gfd::Literal const& l : literals) {
+        std::string const* fst = GetValue(graph, match, l.first);
+        if (fst == nullptr) {
+            return false;
         }
-        if (!Satisfied(graph, query, seq, match, gfd.GetConclusion())) {
-            LOG_DEBUG("Checked embeddings: {}", amount);
+        std::string const* snd = GetValue(graph, match, l.second);
+        if (snd == nullptr || *fst != *snd) {
             return false;
         }
     }
     return true;
 }
 
-bool Check(CPI& cpi, model::graph_t const& graph, model::Gfd const& gfd,
+bool Check(CPI const& cpi, model::graph_t const& graph, GraphIndex const& index,
+           model::Gfd const& gfd, model::vertex_t const& root,
            std::set<model::vertex_t> const& core,
            std::vector<std::set<model::vertex_t>> const& forest,
            std::map<model::vertex_t, model::vertex_t> const& parent,
            std::set<model::edge_t> const& nte) {
-    model::graph_t query = gfd.GetPattern();
+    model::graph_t const& query = gfd.GetPattern();
     std::vector<std::vector<model::vertex_t>> paths = GetPaths(core, parent);
 
     std::vector<model::vertex_t> nts = {};
     FullNTs(paths, nte, query, nts);
-    std::vector<model::vertex_t> seq = MatchingOrder(cpi, paths, nts);
+    std::vector<model::vertex_t> seq = paths.empty() ? std::vector<model::vertex_t>{root}
+                                                     : MatchingOrder(cpi, paths, nts);
 
     CompleteSeq(cpi, forest, parent, query, nte, seq);
 
-    std::set<model::vertex_t> root_candidates = {};
-    std::pair<model::vertex_t, model::vertex_t> edge(*seq.begin(), *(++seq.begin()));
-    for (auto& vertices : cpi.at(edge)) {
-        root_candidates.insert(vertices.first);
-    }
-
-    std::vector<std::pair<std::set<model::vertex_t>::iterator, std::set<model::vertex_t>::iterator>>
-            match = {};
-
-    if (FullMatch(cpi, match, root_candidates, core, seq, parent, graph, query)) {
-        return true;
-    }
-    int amount = 1;
-    // check
-    if (Satisfied(graph, query, seq, match, gfd.GetPremises()) &&
-        !Satisfied(graph, query, seq, match, gfd.GetConclusion())) {
-        LOG_DEBUG("Checked embeddings: {}", amount);
-        return false;
+    // For every position in seq, the position of the parent and the edges to the vertices
+    // matched before it, other than the parent, with their labels
+    std::size_t const size = seq.size();
+    std::vector<std::size_t> position(boost::num_vertices(query));
+    for (std::size_t i = 0; i < size; ++i) {
+        position[seq[i]] = i;
+    }
+    std::vector<std::size_t> parent_position(size);
+    std::vector<std::vector<std::pair<std::size_t, int>>> non_tree_edges(size);
+    for (std::size_t i = 1; i < size; ++i) {
+        parent_position[i] = position[parent.at(seq[i])];
+        for (std::size_t j = 0; j < i; ++j) {
+            auto [edge, exists] = boost::edge(seq[j], seq[i], query);
+            if (exists && j != parent_position[i]) {
+                non_tree_edges[i].emplace_back(j, index.FindEdgeLabel(query[edge].label));
+            }
+        }
     }
 
-    while (true) {
-        int i = static_cast<int>(core.size()) - 1;
-        IncrementMatch(i, cpi, match, parent, core, seq, graph, query);
-        if (i == -1) {
-            break;
+    // graph vertices matched to the pattern vertices, and their positions among the candidates
+    std::vector<model::vertex_t> match(boost::num_vertices(query));
+    std::vector<std::size_t> match_candidates(size);
+    int amount = 0;
+    auto matches = [&](std::size_t i, model::vertex_t v) {
+        for (std::size_t j = 0; j < i; ++j) {
+            if (match[seq[j]] == v) {
+                return false;
+            }
         }
-
-        if (forest.empty()) {
-            amount++;
-            // check
-            if (!Satisfied(graph, query, seq, match, gfd.GetPremises())) {
-                continue;
+        for (auto const& [j, label] : non_tree_edges[i]) {
+            if (label == -1 || index.GetEdgeLabel(match[seq[j]], v) != label) {
+                return false;
             }
-            if (!Satisfied(graph, query, seq, match, gfd.GetConclusion())) {
+        }
+        return true;
+    };
+    // Extends the match of the first i vertices of seq in every possible way, returns false if
+    // an embedding violating the GFD is found
+    auto extend = [&](auto const& self, std::size_t i) -> bool {
+        if (i == size) {
+            amount++;
+            if (Satisfied(graph, match, gfd.GetPremises()) &&
+                !Satisfied(graph, match, gfd.GetConclusion())) {
                 LOG_DEBUG("Checked embeddings: {}", amount);
                 return false;
             }
-            continue;
-        }
-
-        if (CheckTrivially(cpi, match, parent, core, seq)) {
             return true;
         }
-
-        if (!CheckMatch(cpi, match, parent, core, seq, graph, query, gfd, amount)) {
-            return false;
+        std::span<model::vertex_t const> range =
+                i == 0 ? std::span<model::vertex_t const>(cpi.GetCandidates(seq[0]))
+                       : cpi.GetChildren(seq[i], match_candidates[parent_position[i]]);
+        for (model::vertex_t const& v : range) {
+            if (!matches(i, v)) {
+                continue;
+            }
+            match[seq[i]] = v;
+            match_candidates[i] = cpi.FindCandidate(seq[i], v);
+            if (!self(self, i + 1)) {
+                return false;
+            }
         }
+        return true;
+    };
+
+    bool satisfied = extend(extend, 0);
+    if (satisfied) {
+        LOG_DEBUG("total number of embeddings: {}", amount);
     }
-    LOG_DEBUG("total number of embeddings: {}", amount);
-    return true;
+    return satisfied;
 }
 
-bool Validate(model::graph_t const& graph, model::Gfd const& gfd) {
+bool Validate(model::graph_t const& graph, GraphIndex const& index, model::Gfd const& gfd,
+              util::WorkerThreadPool* pool) {
     auto start_time = std::chrono::system_clock::now();
 
-    model::graph_t pat = gfd.GetPattern();
-    std::set<std::string> graph_labels = {};
-    std::set<std::string> pat_labels = {};
-    typename boost::graph_traits<model::graph_t>::vertex_iterator it, end;
-    for (boost::tie(it, end) = vertices(graph); it != end; ++it) {
-        graph_labels.insert(graph[*it].attributes.at("label"));
-    }
-    for (boost::tie(it, end) = vertices(pat); it != end; ++it) {
-        pat_labels.insert(pat[*it].attributes.at("label"));
-    }
-    for (auto const& label : pat_labels) {
-        if (graph_labels.find(label) == graph_labels.end()) {
+    model::graph_t const& pat = gfd.GetPattern();
+    std::vector<PatternVertex> pattern = IndexPattern(index, pat);
+    for (PatternVertex const& u : pattern) {
+        if (u.label == -1) {
             return true;
         }
     }
@@ -1053,32 +904,58 @@ bool Validate(model::graph_t const& graph, model::Gfd const& gfd) {
     std::vector<std::set<model::vertex_t>> forest = {};
     CfDecompose(pat, core, forest);
 
-    int root = GetRoot(graph, pat, core);
+    int root = GetRoot(index, pattern, core);
     std::vector<std::set<model::vertex_t>> levels = {};
     std::map<model::vertex_t, model::vertex_t> parent;
     std::set<model::edge_t> snte = {};
     std::set<model::edge_t> nte = {};
     BfsTree(pat, root, levels, parent, nte, snte);
 
-    std::map<model::vertex_t, std::set<model::vertex_t>> candidates;
-    CPI cpi;
-    TopDownConstruct(cpi, graph, pat, levels, parent, candidates, snte);
-    BottomUpRefinement(cpi, graph, pat, levels, parent, candidates);
+    CPI cpi(pattern.size());
+    TopDownConstruct(cpi, index, pat, pattern, levels, parent, snte, pool);
+    BottomUpRefinement(cpi, index, pattern, levels, parent, pool);
     auto elapsed_milliseconds = std::chrono::duration_cast<std::chrono::milliseconds>(
             std::chrono::system_clock::now() - start_time);
 
     LOG_DEBUG("CPI constructed in {}. Matching...", elapsed_milliseconds.count());
-    return Check(cpi, graph, gfd, core, forest, parent, nte);
+    for (std::size_t u = 0; u < pattern.size(); ++u) {
+        if (cpi.GetCandidates(u).empty()) {
+            LOG_DEBUG("Trivially satisfied");
+            return true;
+        }
+    }
+    return Check(cpi, graph, index, gfd, root, core, forest, parent, nte);
 }
 
 }  // namespace
 
 namespace algos {
 
+namespace egfd_validator {
+
+std::size_t CPI::FindCandidate(model::vertex_t u, model::vertex_t v) const {
+    std::vector<model::vertex_t> const& candidates = candidates_[u];
+    return std::lower_bound(candidates.begin(), candidates.end(), v) - candidates.begin();
+}
+
+}  // namespace egfd_validator
+
+EGfdValidator::EGfdValidator() : GfdHandler() {
+    RegisterOption(config::kThreadNumberOpt(&threads_num_));
+    MakeOptionsAvailable({config::kThreadNumberOpt.GetName()});
+}
+
 std::vector<model::Gfd> EGfdValidator::GenerateSatisfiedGfds(model::graph_t const& graph,
                                                              std::vector<model::Gfd> const& gfds) {
+    GraphIndex const index(graph);
+    // one pool serves the levels of all patterns
+    std::optional<util::WorkerThreadPool> pool;
+    if (threads_num_ > 1) {
+        pool.emplace(threads_num_);
+    }
+    util::WorkerThreadPool* pool_ptr = pool ? std::addressof(*pool) : nullptr;
     for (auto& gfd : gfds) {
-        if (Validate(graph, gfd)) {
+        if (Validate(graph, index, gfd, pool_ptr)) {
             result_.push_back(gfd);
         }
     }
@@ -1,4 +1,8 @@
 #pragma once
+#include <cstddef>
+#include <span>
+#include <vector>
+
 #include "core/algorithms/gfd/gfd.h"
 #include "core/algorithms/gfd/gfd_validator/gfd_handler.h"
 #include "core/config/names_and_descriptions.h"
@@ -7,8 +11,48 @@ namespace algos {
 
 namespace egfd_validator {
 
-using CPI = std::map<std::pair<model::vertex_t, model::vertex_t>,
-                     std::map<model::vertex_t, std::set<model::vertex_t>>>;
+// Candidate space index of a pattern in a graph. The candidates of every pattern vertex are a
+// sorted array of graph vertices. Every edge of the BFS tree of the pattern is stored with its
+// child u as a CSR over the candidates of the parent of u: the candidates of u adjacent to the
+// i-th candidate of the parent are children[offsets[i]] .. children[offsets[i + 1] - 1], sorted.
+class CPI {
+public:
+    struct TreeEdge {
+        std::vector<std::size_t> offsets = {0};
+        std::vector<model::vertex_t> children;
+    };
+
+private:
+    std::vector<std::vector<model::vertex_t>> candidates_;
+    std::vector<TreeEdge> edges_;
+
+public:
+    explicit CPI(std::size_t num_pattern_vertices)
+        : candidates_(num_pattern_vertices), edges_(num_pattern_vertices) {}
+
+    std::vector<model::vertex_t>& GetCandidates(model::vertex_t u) {
+        return candidates_[u];
+    }
+
+    std::vector<model::vertex_t> const& GetCandidates(model::vertex_t u) const {
+        return candidates_[u];
+    }
+
+    // Position of v among the candidates of u, or the number of candidates if v is not one
+    std::size_t FindCandidate(model::vertex_t u, model::vertex_t v) const;
+
+    TreeEdge& GetTreeEdge(model::vertex_t u) {
+        return edges_[u];
+    }
+
+    // Candidates of u adjacent to the candidate of the parent of u at position parent_candidate
+    std::span<model::vertex_t const> GetChildren(model::vertex_t u,
+                                                 std::size_t parent_candidate) const {
+        TreeEdge const& edge = edges_[u];
+        return {edge.children.data() + edge.offsets[parent_candidate],
+                edge.children.data() + edge.offsets[parent_candidate + 1]};
+    }
+};
 
 }  // namespace egfd_validator
 
@@ -17,7 +61,7 @@ public:
     std::vector<model::Gfd> GenerateSatisfiedGfds(model::graph_t const& graph,
                                                   std::vector<model::Gfd> const& gfds);
 
-    EGfdValidator() : GfdHandler() {};
+    EGfdValidator();
 
     EGfdValidator(model::graph_t graph_, std::vector<model::Gfd> gfds_)
         : GfdHandler(graph_, gfds_) {}
@@ -33,9 +33,8 @@ void GfdHandler::RegisterOptions() {
 }
 
 void GfdHandler::LoadDataInternal() {
-    std::ifstream f(graph_path_);
-    graph_ = parser::graph_parser::gfd::ReadGraph(f);
-    f.close();
+    graph_ = parser::graph_parser::gfd::ReadGraph(graph_path_, threads_num_);
+    std::ifstream f;
     for (auto const& path : gfd_paths_) {
         auto gfd_path = path;
         f.open(gfd_path);
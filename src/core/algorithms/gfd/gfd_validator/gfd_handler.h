@@ -4,6 +4,7 @@
 #include "core/algorithms/algorithm.h"
 #include "core/algorithms/gfd/gfd.h"
 #include "core/config/names_and_descriptions.h"
+#include "core/config/thread_number/type.h"
 #include "core/parser/graph_parser/graph_parser.h"
 
 namespace algos {
@@ -12,6 +13,8 @@ class GfdHandler : public Algorithm {
 protected:
     std::filesystem::path graph_path_;
     std::vector<std::filesystem::path> gfd_paths_;
+    // registered by the validators that support it, also used to load the graph
+    config::ThreadNumType threads_num_ = 1;
 
     model::graph_t graph_;
     std::vector<model::Gfd> gfds_;
@@ -1,13 +1,29 @@
 #include "core/algorithms/ind/faida/inclusion_testing/combined_inclusion_tester.h"
 
-#ifdef __AVX2__
-#include <immintrin.h>
-#endif
 #include "core/algorithms/ind/faida/hashing/hashing.h"
 #include "core/util/parallel_for.h"
+#include "core/util/target_clones.h"
 
 namespace algos::faida {
 
+namespace {
+
+/* Folds the hashes of one more column into the combined hashes of the rows and marks the rows
+ * where the column is null. Written without intrinsics: the AVX2 and AVX-512 clones vectorize the
+ * rotation, the xor and the null comparison.
+ */
+DESBORDANTE_TARGET_CLONES
+void CombineColumnHashes(size_t const* col_hashes, size_t* combined_hashes,
+                         unsigned char* nul_combs, size_t num_rows, size_t null_hash) {
+    for (size_t row = 0; row < num_rows; ++row) {
+        size_t const hash = col_hashes[row];
+        nul_combs[row] |= (hash == null_hash ? 0xFF : 0);
+        combined_hashes[row] = std::rotl(combined_hashes[row], 1) ^ hash;
+    }
+}
+
+}  // namespace
+
 IInclusionTester::ActiveColumns CombinedInclusionTester::SetCCs(
         std::vector<std::shared_ptr<SimpleCC>>& combinations) {
     hlls_by_table_.clear();
@@ -78,66 +94,10 @@ void CombinedInclusionTester::InsertRows(IRowIterator::Block const& hashed_cols,
                 IRowIterator::AlignedVector combined_hashes(chunk_size, 0);
                 std::vector<unsigned char> nul_combs(chunk_size, 0);
 
-#ifdef __AVX2__
-                __m256i const nullhashes_vect = _mm256_set1_epi64x(null_hash_);
-                int constexpr vect_reg_size = 4;
-#endif
-
                 for (ColumnIndex col_idx : cc->GetColumnIndices()) {
-                    IRowIterator::AlignedVector const& col_hashes_chunk =
-                            hashed_cols[col_idx].value();
-#ifdef __AVX2__
-                    for (unsigned int row_offset = 0;
-                         row_offset < chunk_size - chunk_size % vect_reg_size;
-                         row_offset += vect_reg_size) {
-                        __m256i const hashes_vect =
-                                _mm256_load_si256((__m256i*)(&col_hashes_chunk[row_offset]));
-                        __m256i const comb_hashes_vect =
-                                _mm256_load_si256((__m256i*)(&combined_hashes[row_offset]));
-
-                        __m256i const cmp_res = _mm256_cmpeq_epi64(hashes_vect, nullhashes_vect);
-                        unsigned int const cmp_res_mask = _mm256_movemask_epi8(cmp_res);
-                        (unsigned int&)*(&nul_combs[row_offset]) |= cmp_res_mask;
-
-                        // Emulate rotl vector instruction
-                        int constexpr num_shift_left = 1;
-                        int constexpr num_shift_right = 63;
-                        __m256i const sh_left_vect =
-                                _mm256_slli_epi64(comb_hashes_vect, num_shift_left);
-                        __m256i const sh_right_vect =
-                                _mm256_srli_epi64(comb_hashes_vect, num_shift_right);
-                        __m256i const rotated_hashes_vect =
-                                _mm256_or_si256(sh_left_vect, sh_right_vect);
-
-                        __m256i const xored_hashes_vect =
-                                _mm256_xor_si256(rotated_hashes_vect, hashes_vect);
-                        _mm256_store_si256((__m256i*)(&combined_hashes[row_offset]),
-                                           xored_hashes_vect);
-                    }
-
-                    for (unsigned int row_offset = chunk_size - chunk_size % vect_reg_size;
-                         row_offset < chunk_size; row_offset++) {
-                        size_t const hash = col_hashes_chunk[row_offset];
-                        size_t const comb_hash = combined_hashes[row_offset];
-
-                        unsigned char const cmp_res = (hash == null_hash_ ? 0xFF : 0);
-                        nul_combs[row_offset] |= cmp_res;
-
-                        size_t const combined_hash = std::rotl(comb_hash, 1) ^ hash;
-                        combined_hashes[row_offset] = combined_hash;
-                    }
-#else
-                    for (unsigned int row_offset = 0; row_offset < chunk_size; row_offset++) {
-                        size_t const hash = col_hashes_chunk[row_offset];
-                        size_t const comb_hash = combined_hashes[row_offset];
-
-                        unsigned char const cmp_res = (hash == null_hash_ ? 0xFF : 0);
-                        nul_combs[row_offset] |= cmp_res;
-
-                        size_t const combined_hash = std::rotl(comb_hash, 1) ^ hash;
-                        combined_hashes[row_offset] = combined_hash;
-                    }
-#endif
+                    CombineColumnHashes(hashed_cols[col_idx].value().data(),
+                                        combined_hashes.data(), nul_combs.data(), chunk_size,
+                                        null_hash_);
                 }
 
                 for (unsigned int i = 0; i < chunk_size; i++) {
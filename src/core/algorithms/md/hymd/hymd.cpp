@@ -208,16 +208,28 @@ unsigned long long HyMD::ExecuteInternal() {
             level_getter,
             {pool_holder.GetPtr(), records_info_.get(), similarity_data.GetColumnMatchesInfo(),
              min_support_, &lattice},
-            pool_holder.GetPtr()};
+            pool_holder.GetPtr(),
+            &GetCancellationToken()};
     algorithm_finished = lattice_traverser.TraverseLattice(algorithm_finished);
 
-    while (!algorithm_finished) {
+    while (!algorithm_finished && !ShouldStop()) {
         algorithm_finished =
                 record_pair_inferrer.InferFromRecordPairs(lattice_traverser.TakeRecommendations());
         algorithm_finished = lattice_traverser.TraverseLattice(algorithm_finished);
     }
 
-    RegisterResults(similarity_data, lattice.GetAll());
+    if (ShouldStop()) {
+        // Only the levels the traverser has finished hold validated MDs.
+        std::vector<lattice::MdLatticeNodeInfo> validated;
+        for (std::size_t level = 0; level < level_getter.GetCurrentLevel(); ++level) {
+            for (auto const& messenger : lattice.GetLevel(level)) {
+                validated.push_back(messenger.GetNodeInfo());
+            }
+        }
+        RegisterResults(similarity_data, std::move(validated));
+    } else {
+        RegisterResults(similarity_data, lattice.GetAll());
+    }
 
     return std::chrono::duration_cast<std::chrono::milliseconds>(std::chrono::system_clock::now() -
                                                                  start_time)
@@ -1,5 +1,7 @@
 #include "core/algorithms/md/hymd/indexes/records_info.h"
 
+#include <algorithm>
+#include <numeric>
 #include <string>
 #include <vector>
 
@@ -12,33 +14,50 @@ namespace {
 using namespace algos::hymd::indexes;
 using ValueMapType = boost::unordered::unordered_flat_map<std::string, GlobalValueIdentifier>;
 
-std::shared_ptr<DictionaryCompressor> MakeCompressor(model::IDatasetStream& table,
-                                                     ValueMapType& value_map,
-                                                     std::vector<std::string>& values,
-                                                     GlobalValueIdentifier& next_value_id) {
+std::vector<model::ColumnIndex> AllColumns(model::IDatasetStream const& table) {
+    std::vector<model::ColumnIndex> columns(table.GetNumberOfColumns());
+    std::iota(columns.begin(), columns.end(), 0);
+    return columns;
+}
+
+std::shared_ptr<DictionaryCompressor> MakeCompressor(
+        model::IDatasetStream& table, std::vector<model::ColumnIndex> const& columns,
+        ValueMapType& value_map, std::vector<std::string>& values,
+        GlobalValueIdentifier& next_value_id) {
     std::size_t records_processed = 0;
     std::size_t const attributes_num = table.GetNumberOfColumns();
+    bool const is_projected = columns.size() != attributes_num;
     std::vector<GlobalValueIdentifier> row_values(attributes_num);
+    if (is_projected) {
+        // Columns that are not read get the empty value in every record
+        auto [it, is_value_new] = value_map.try_emplace(std::string{}, next_value_id);
+        if (is_value_new) {
+            values.emplace_back();
+            ++next_value_id;
+        }
+        std::ranges::fill(row_values, it->second);
+    }
     std::shared_ptr<DictionaryCompressor> compressor =
             std::make_shared<DictionaryCompressor>(attributes_num);
     while (table.HasNextRow()) {
-        std::vector<std::string> record = table.GetNextRow();
+        std::vector<std::string> record =
+                is_projected ? table.GetNextProjectedRow(columns) : table.GetNextRow();
         std::size_t record_size = record.size();
-        if (record_size != attributes_num) {
+        if (record_size != columns.size()) {
             LOG_WARN(
                     "Unexpected number of columns for a record, "
                     "skipping (expected {}, got {}). Records processed so far: {}.",
                     attributes_num, record_size, records_processed);
             continue;
         }
-        for (model::Index i = 0; i != attributes_num; ++i) {
+        for (model::Index i = 0; i != record_size; ++i) {
             std::string& value = record[i];
             auto [it, is_value_new] = value_map.try_emplace(value, next_value_id);
             if (is_value_new) {
                 values.push_back(std::move(value));
                 ++next_value_id;
             }
-            row_values[i] = it->second;
+            row_values[columns[i]] = it->second;
         }
         compressor->AddRecord(row_values);
         ++records_processed;
@@ -49,23 +68,35 @@ std::shared_ptr<DictionaryCompressor> MakeCompressor(model::IDatasetStream& tabl
 
 namespace algos::hymd::indexes {
 std::unique_ptr<RecordsInfo> RecordsInfo::CreateFrom(model::IDatasetStream& left_table) {
+    return CreateFrom(left_table, AllColumns(left_table));
+}
+
+std::unique_ptr<RecordsInfo> RecordsInfo::CreateFrom(model::IDatasetStream& left_table,
+                                                     model::IDatasetStream& right_table) {
+    return CreateFrom(left_table, right_table, AllColumns(left_table), AllColumns(right_table));
+}
+
+std::unique_ptr<RecordsInfo> RecordsInfo::CreateFrom(
+        model::IDatasetStream& left_table, std::vector<model::ColumnIndex> const& left_columns) {
     ValueMapType value_map;
     std::vector<std::string> values;
     GlobalValueIdentifier next_value_id = 0;
     std::shared_ptr<DictionaryCompressor> compressor =
-            MakeCompressor(left_table, value_map, values, next_value_id);
+            MakeCompressor(left_table, left_columns, value_map, values, next_value_id);
     return std::make_unique<RecordsInfo>(std::move(values), std::move(compressor));
 }
 
-std::unique_ptr<RecordsInfo> RecordsInfo::CreateFrom(model::IDatasetStream& left_table,
-                                                     model::IDatasetStream& right_table) {
+std::unique_ptr<RecordsInfo> RecordsInfo::CreateFrom(
+        model::IDatasetStream& left_table, model::IDatasetStream& right_table,
+        std::vector<model::ColumnIndex> const& left_columns,
+        std::vector<model::ColumnIndex> const& right_columns) {
     ValueMapType value_map;
     std::vector<std::string> values;
     GlobalValueIdentifier next_value_id = 0;
     std::shared_ptr<DictionaryCompressor> left_compressor =
-            MakeCompressor(left_table, value_map, values, next_value_id);
+            MakeCompressor(left_table, left_columns, value_map, values, next_value_id);
     std::shared_ptr<DictionaryCompressor> right_compressor =
-            MakeCompressor(right_table, value_map, values, next_value_id);
+            MakeCompressor(right_table, right_columns, value_map, values, next_value_id);
     return std::make_unique<RecordsInfo>(std::move(values), std::move(left_compressor),
                                          std::move(right_compressor));
 }
@@ -6,6 +6,8 @@
 #include <vector>
 
 #include "core/algorithms/md/hymd/indexes/dictionary_compressor.h"
+#include "core/model/table/column_index.h"
+#include "core/model/table/idataset_stream.h"
 
 namespace algos::hymd::indexes {
 
@@ -52,6 +54,16 @@ public:
 
     static std::unique_ptr<RecordsInfo> CreateFrom(model::IDatasetStream& left_table,
                                                    model::IDatasetStream& right_table);
+
+    /* Only the values of the given columns, sorted and unique, are read. Every other column
+     * holds the same value in all records, so records keep the column indices of the table */
+    static std::unique_ptr<RecordsInfo> CreateFrom(
+            model::IDatasetStream& left_table, std::vector<model::ColumnIndex> const& left_columns);
+
+    static std::unique_ptr<RecordsInfo> CreateFrom(
+            model::IDatasetStream& left_table, model::IDatasetStream& right_table,
+            std::vector<model::ColumnIndex> const& left_columns,
+            std::vector<model::ColumnIndex> const& right_columns);
 };
 
 }  // namespace algos::hymd::indexes
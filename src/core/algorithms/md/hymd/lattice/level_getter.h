@@ -26,6 +26,11 @@ protected:
 public:
     LevelGetter(MdLattice* lattice) : lattice_(lattice) {}
 
+    // MDs on the levels below this one have been validated.
+    std::size_t GetCurrentLevel() const noexcept {
+        return cur_level_;
+    }
+
     std::vector<ValidationInfo> GetPendingGroupedMinimalLhsMds() {
         while (cur_level_ <= lattice_->GetMaxLevel()) {
             messengers_ = lattice_->GetLevel(cur_level_);
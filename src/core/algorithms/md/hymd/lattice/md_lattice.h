@@ -76,6 +76,10 @@ public:
             return *node_info_.node;
         }
 
+        MdLatticeNodeInfo const& GetNodeInfo() const noexcept {
+            return node_info_;
+        }
+
         void MarkUnsupported();
 
         void LowerAndSpecialize(utility::InvalidatedRhss const& invalidated);
@@ -55,6 +55,7 @@ auto LatticeTraverser::ProcessResults(std::vector<lattice::ValidationInfo>& vali
 bool LatticeTraverser::TraverseLattice(bool const traverse_all) {
     std::vector<lattice::ValidationInfo> validations;
     while (!(validations = level_getter_.GetPendingGroupedMinimalLhsMds()).empty()) {
+        if (cancellation_token_ != nullptr && cancellation_token_->IsStopRequested()) break;
         std::vector<BatchValidator::Result> const& results = validator_.ValidateBatch(validations);
 
         LatticeStatistics lattice_statistics = ProcessResults(validations, results);
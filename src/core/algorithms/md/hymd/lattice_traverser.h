@@ -7,6 +7,7 @@
 #include "core/algorithms/md/hymd/recommendation.h"
 #include "core/algorithms/md/hymd/similarity_data.h"
 #include "core/algorithms/md/hymd/validator.h"
+#include "core/util/cancellation_token.h"
 #include "core/util/worker_thread_pool.h"
 
 namespace algos::hymd {
@@ -51,6 +52,7 @@ private:
     BatchValidator validator_;
 
     util::WorkerThreadPool* pool_;
+    util::CancellationToken const* cancellation_token_;
 
     void AddRecommendations(std::vector<BatchValidator::Result> const& results);
     static LatticeStatistics AdjustLattice(std::vector<lattice::ValidationInfo>& validations,
@@ -60,9 +62,14 @@ private:
 
 public:
     LatticeTraverser(lattice::LevelGetter& level_getter, BatchValidator validator,
-                     util::WorkerThreadPool* pool) noexcept
-        : level_getter_(level_getter), validator_(std::move(validator)), pool_(pool) {}
-
+                     util::WorkerThreadPool* pool,
+                     util::CancellationToken const* cancellation_token = nullptr) noexcept
+        : level_getter_(level_getter),
+          validator_(std::move(validator)),
+          pool_(pool),
+          cancellation_token_(cancellation_token) {}
+
+    // Also returns true if stopped by the cancellation token.
     bool TraverseLattice(bool traverse_all);
 
     ClearingRecRef TakeRecommendations() noexcept {
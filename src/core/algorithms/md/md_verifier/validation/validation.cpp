@@ -1,16 +1,41 @@
 #include "core/algorithms/md/md_verifier/validation/validation.h"
 
 #include <ranges>
+#include <utility>
 
 #include <boost/hof/first_of.hpp>
 
 #include "core/algorithms/md/hymd/indexes/records_info.h"
 #include "core/algorithms/md/hymd/similarity_data.h"
 #include "core/algorithms/md/hymd/utility/index_range.h"
+#include "core/model/table/column_projection.h"
 #include "core/util/worker_thread_pool.h"
 
 namespace algos::md {
 
+std::unique_ptr<hymd::indexes::RecordsInfo> MDValidationCalculator::LoadRecords(
+        config::InputTable const& left_table, config::InputTable const& right_table,
+        std::vector<CMPtr> const& column_matches) {
+    std::vector<model::ColumnIndex> left_columns;
+    std::vector<model::ColumnIndex> right_columns;
+    for (CMPtr const& column_match : column_matches) {
+        auto [left_index, right_index] = column_match->GetIndices();
+        left_columns.push_back(left_index);
+        right_columns.push_back(right_index);
+    }
+
+    if (right_table == nullptr) {
+        left_columns.insert(left_columns.end(), right_columns.begin(), right_columns.end());
+        model::ColumnProjection const projection(*left_table, std::move(left_columns));
+        return hymd::indexes::RecordsInfo::CreateFrom(*left_table, projection.GetLoadedColumns());
+    }
+    model::ColumnProjection const left_projection(*left_table, std::move(left_columns));
+    model::ColumnProjection const right_projection(*right_table, std::move(right_columns));
+    return hymd::indexes::RecordsInfo::CreateFrom(*left_table, *right_table,
+                                                  left_projection.GetLoadedColumns(),
+                                                  right_projection.GetLoadedColumns());
+}
+
 void MDValidationCalculator::Validate(util::WorkerThreadPool* thread_pool) {
     hymd::SimilarityData similarity_data =
             hymd::SimilarityData::CreateFrom(records_info_.get(), column_matches_, thread_pool)
@@ -40,6 +40,12 @@ private:
     model::md::DecisionBoundary true_rhs_decision_boundary_;
     std::shared_ptr<MDHighlights> highlights_;
 
+    // Only the columns of the column matches are read, unless a table is materialized and is
+    // loaded whole anyway
+    static std::unique_ptr<hymd::indexes::RecordsInfo> LoadRecords(
+            config::InputTable const& left_table, config::InputTable const& right_table,
+            std::vector<CMPtr> const& column_matches);
+
     void SelectStartingLhsClassifierIndex();
 
     void ExecuteValidationFrom(model::Index lhs_classifier_index);
@@ -77,11 +83,7 @@ public:
           column_similarity_classifiers_(std::move(column_similarity_classifiers)),
           true_rhs_decision_boundary_(column_similarity_classifiers.back().GetDecisionBoundary()),
           highlights_(highlights) {
-        if (right_table == nullptr) {
-            records_info_ = hymd::indexes::RecordsInfo::CreateFrom(*left_table);
-        } else {
-            records_info_ = hymd::indexes::RecordsInfo::CreateFrom(*left_table, *right_table);
-        }
+        records_info_ = LoadRecords(left_table, right_table, column_matches_);
     }
 
     void Validate(util::WorkerThreadPool* thread_pool);
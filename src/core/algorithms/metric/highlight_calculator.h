@@ -10,7 +10,7 @@ namespace algos::metric {
 class HighlightCalculator {
 private:
     std::vector<std::vector<Highlight>> highlights_;
-    std::shared_ptr<model::ColumnLayoutTypedRelationData> typed_relation_;
+    std::shared_ptr<model::ColumnLayoutTypedRelationData const> typed_relation_;
     config::IndicesType rhs_indices_;
 
     template <typename Compare>
@@ -21,23 +21,29 @@ private:
     }
 
     template <typename T>
-    void BruteCalculateHighlights(std::vector<IndexedPoint<T>> const& indexed_points,
-                                  std::vector<Highlight>&& cluster_highlights,
-                                  DistanceFunction<T> const& dist_func);
+    static std::vector<Highlight> BruteCalculateHighlights(
+            std::vector<IndexedPoint<T>> const& indexed_points,
+            std::vector<Highlight>&& cluster_highlights, DistanceFunction<T> const& dist_func);
 
 public:
-    void CalculateOneDimensionalHighlights(
+    /* Calculate* functions only read the relation, so clusters can be processed concurrently.
+     * Their results are stored with AddClusterHighlights. */
+    std::vector<Highlight> CalculateOneDimensionalHighlights(
             std::vector<IndexedOneDimensionalPoint> const& indexed_points,
-            std::vector<Highlight>&& cluster_highlights);
+            std::vector<Highlight>&& cluster_highlights) const;
 
-    void CalculateHighlightsForStrings(
+    std::vector<Highlight> CalculateHighlightsForStrings(
             std::vector<IndexedPoint<std::byte const*>> const& indexed_points,
             std::vector<Highlight>&& cluster_highlights,
-            DistanceFunction<std::byte const*> const& dist_func);
+            DistanceFunction<std::byte const*> const& dist_func) const;
 
-    void CalculateMultidimensionalHighlights(
+    std::vector<Highlight> CalculateMultidimensionalHighlights(
             std::vector<IndexedPoint<std::vector<long double>>> const& indexed_points,
-            std::vector<Highlight>&& cluster_highlights);
+            std::vector<Highlight>&& cluster_highlights) const;
+
+    void AddClusterHighlights(std::vector<Highlight>&& cluster_highlights) {
+        highlights_.push_back(std::move(cluster_highlights));
+    }
 
     void SortHighlightsByDistanceAscending();
     void SortHighlightsByDistanceDescending();
@@ -51,7 +57,7 @@ public:
     }
 
     explicit HighlightCalculator(
-            std::shared_ptr<model::ColumnLayoutTypedRelationData> typed_relation,
+            std::shared_ptr<model::ColumnLayoutTypedRelationData const> typed_relation,
             config::IndicesType rhs_indices)
         : typed_relation_(std::move(typed_relation)), rhs_indices_(std::move(rhs_indices)) {};
 };
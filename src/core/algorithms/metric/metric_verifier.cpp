@@ -1,9 +1,13 @@
 #include "core/algorithms/metric/metric_verifier.h"
 
 #include <algorithm>
+#include <atomic>
 #include <cassert>
 #include <chrono>
+#include <cmath>
+#include <deque>
 #include <memory>
+#include <numeric>
 #include <stdexcept>
 #include <string>
 #include <utility>
@@ -14,7 +18,11 @@
 #include "core/config/names_and_descriptions.h"
 #include "core/config/option_using.h"
 #include "core/config/tabular_data/input_table/option.h"
+#include "core/config/tabular_data/load_columns/option.h"
+#include "core/config/thread_number/option.h"
+#include "core/model/table/dataset.h"
 #include "core/util/logger.h"
+#include "core/util/worker_thread_pool.h"
 
 namespace algos::metric {
 
@@ -27,7 +35,8 @@ void MetricVerifier::ValidateRhs(config::IndicesType const& rhs_indices) {
     assert(!rhs_indices.empty());
     if (rhs_indices.size() == 1) {
         config::IndexType column_index = rhs_indices[0];
-        model::TypedColumnData const& column = typed_relation_->GetColumnData(column_index);
+        model::TypedColumnData const& column =
+                typed_relation_->GetColumnData(projection_.ToLoaded(column_index));
         model::TypeId type_id = column.GetTypeId();
         if (type_id == model::TypeId::kUndefined) {
             throw config::ConfigurationError("Column with index \"" + std::to_string(column_index) +
@@ -51,7 +60,8 @@ void MetricVerifier::ValidateRhs(config::IndicesType const& rhs_indices) {
     }
     if (metric_ == Metric::kEuclidean) {
         for (config::IndexType column_index : rhs_indices) {
-            model::TypedColumnData const& column = typed_relation_->GetColumnData(column_index);
+            model::TypedColumnData const& column =
+                    typed_relation_->GetColumnData(projection_.ToLoaded(column_index));
             model::TypeId type_id = column.GetTypeId();
             if (type_id == model::TypeId::kUndefined) {
                 throw config::ConfigurationError("Column with index \"" +
@@ -82,8 +92,15 @@ void MetricVerifier::RegisterOptions() {
     auto check_parameter = [](long double parameter) {
         if (parameter < 0) throw config::ConfigurationError("Parameter out of range");
     };
-    auto get_schema_columns = [this]() { return relation_->GetSchema()->GetNumColumns(); };
-    auto check_rhs = [this](config::IndicesType const& rhs_indices) { ValidateRhs(rhs_indices); };
+    auto get_table_columns = [this]() { return input_table_->GetNumberOfColumns(); };
+    auto get_source_columns = [this]() { return projection_.GetNumSourceColumns(); };
+    auto check_lhs = [this](config::IndicesType const& lhs_indices) {
+        projection_.CheckLoaded(lhs_indices);
+    };
+    auto check_rhs = [this](config::IndicesType const& rhs_indices) {
+        projection_.CheckLoaded(rhs_indices);
+        ValidateRhs(rhs_indices);
+    };
     auto need_algo_and_q = [this]([[maybe_unused]] config::IndicesType const& _) {
         return metric_ == Metric::kCosine;
     };
@@ -104,35 +121,38 @@ void MetricVerifier::RegisterOptions() {
         if (q <= 0) throw config::ConfigurationError("Q-gram length should be greater than zero.");
     };
 
-    RegisterOption(config::kTableOpt(&input_table_));
+    RegisterOption(config::kTableOpt(&input_table_).SetConditionalOpts({{{}, {kLoadColumns}}}));
+    RegisterOption(config::kLoadColumnsOpt(&load_columns_, get_table_columns));
     RegisterOption(config::kEqualNullsOpt(&is_null_equal_null_));
-    RegisterOption(config::kLhsIndicesOpt(&lhs_indices_, get_schema_columns));
+    RegisterOption(config::kLhsIndicesOpt(&lhs_indices_, get_source_columns, check_lhs));
     RegisterOption(Option{&algo_, kMetricAlgorithm, kDMetricAlgorithm}.SetValueCheck(algo_check));
     RegisterOption(Option{&dist_from_null_is_infinity_, kDistFromNullIsInfinity,
                           kDDistFromNullIsInfinity, false});
     RegisterOption(Option{&parameter_, kParameter, kDParameter}.SetValueCheck(check_parameter));
     RegisterOption(Option{&q_, kQGramLength, kDQGramLength, 2u}.SetValueCheck(q_check));
-    RegisterOption(config::kRhsIndicesOpt(&rhs_indices_, get_schema_columns, check_rhs)
+    RegisterOption(config::kRhsIndicesOpt(&rhs_indices_, get_source_columns, check_rhs)
                            .SetConditionalOpts({{need_algo_and_q, {kMetricAlgorithm, kQGramLength}},
                                                 {need_algo_only, {kMetricAlgorithm}}}));
     RegisterOption(Option{&metric_, kMetric, kDMetric}.SetConditionalOpts(
             {{{}, {config::kRhsIndicesOpt.GetName()}}}));
+    RegisterOption(config::kThreadNumberOpt(&threads_));
 }
 
 void MetricVerifier::MakeExecuteOptsAvailable() {
     using namespace config::names;
-    MakeOptionsAvailable(
-            {kDistFromNullIsInfinity, kParameter, kMetric, config::kLhsIndicesOpt.GetName()});
+    MakeOptionsAvailable({kDistFromNullIsInfinity, kParameter, kMetric,
+                          config::kLhsIndicesOpt.GetName(), config::kThreadNumberOpt.GetName()});
 }
 
 void MetricVerifier::LoadDataInternal() {
-    relation_ = ColumnLayoutRelationData::CreateFrom(*input_table_);
-    input_table_->Reset();
+    projection_ = model::ColumnProjection(*input_table_, load_columns_);
+    config::InputTable table = projection_.Apply(input_table_);
+    relation_ = model::LoadRelation(*table);
+    table->Reset();
     if (relation_->GetColumnData().empty()) {
         throw std::runtime_error("Got an empty dataset: metric FD verifying is meaningless.");
     }
-    typed_relation_ =
-            model::ColumnLayoutTypedRelationData::CreateFrom(*input_table_, is_null_equal_null_);
+    typed_relation_ = model::LoadTypedRelation(*table, is_null_equal_null_);
 }
 
 void MetricVerifier::ResetState() {
@@ -142,9 +162,13 @@ void MetricVerifier::ResetState() {
 unsigned long long MetricVerifier::ExecuteInternal() {
     auto start_time = std::chrono::system_clock::now();
 
+    loaded_lhs_indices_ = projection_.ToLoaded(lhs_indices_);
+    loaded_rhs_indices_ = projection_.ToLoaded(rhs_indices_);
+    q_gram_profiles_.reset();
     points_calculator_ = std::make_unique<PointsCalculator>(dist_from_null_is_infinity_,
-                                                            typed_relation_, rhs_indices_);
-    highlight_calculator_ = std::make_unique<HighlightCalculator>(typed_relation_, rhs_indices_);
+                                                            typed_relation_, loaded_rhs_indices_);
+    highlight_calculator_ =
+            std::make_unique<HighlightCalculator>(typed_relation_, loaded_rhs_indices_);
     assert(points_calculator_.get() != nullptr || highlight_calculator_.get() != nullptr);
 
     VerifyMetricFD();
@@ -195,13 +219,13 @@ void MetricVerifier::VisualizeHighlights() const {
     }
     for (auto const& cluster_highlight : highlight_calculator_->GetHighlights()) {
         LOG_DEBUG("----------------------------------------- LHS value: {}",
-                  GetStringValue(lhs_indices_, cluster_highlight[0].data_index));
+                  GetStringValue(loaded_lhs_indices_, cluster_highlight[0].data_index));
+        model::TypedColumnData const& rhs_column =
+                typed_relation_->GetColumnData(loaded_rhs_indices_[0]);
         for (auto const& highlight : cluster_highlight) {
-            bool is_null =
-                    typed_relation_->GetColumnData(rhs_indices_[0]).IsNull(highlight.data_index);
-            bool is_empty =
-                    typed_relation_->GetColumnData(rhs_indices_[0]).IsEmpty(highlight.data_index);
-            std::string value = GetStringValue(rhs_indices_, highlight.data_index);
+            bool is_null = rhs_column.IsNull(highlight.data_index);
+            bool is_empty = rhs_column.IsEmpty(highlight.data_index);
+            std::string value = GetStringValue(loaded_rhs_indices_, highlight.data_index);
             std::string begin_desc;
             if (!is_empty) {
                 begin_desc = std::string("[") + (highlight.max_distance <= parameter_ ? "✓" : "X") +
@@ -212,7 +236,7 @@ void MetricVerifier::VisualizeHighlights() const {
                 end_desc = "\t| furthest point index: " +
                            std::to_string(highlight.furthest_data_index) +
                            "\t| furthest point value: " +
-                           GetStringValue(rhs_indices_, highlight.furthest_data_index);
+                           GetStringValue(loaded_rhs_indices_, highlight.furthest_data_index);
             }
             LOG_DEBUG("{}index: {}\t| value: {}{}", begin_desc, highlight.data_index, value,
                       end_desc);
@@ -222,26 +246,55 @@ void MetricVerifier::VisualizeHighlights() const {
 
 void MetricVerifier::VerifyMetricFD() {
     std::shared_ptr<model::PLI const> pli =
-            relation_->GetColumnData(lhs_indices_[0]).GetPliOwnership();
+            relation_->GetColumnData(loaded_lhs_indices_[0]).GetPliOwnership();
 
-    for (size_t i = 1; i < lhs_indices_.size(); ++i) {
-        pli = pli->Intersect(relation_->GetColumnData(lhs_indices_[i]).GetPositionListIndex());
+    for (size_t i = 1; i < loaded_lhs_indices_.size(); ++i) {
+        pli = pli->Intersect(
+                relation_->GetColumnData(loaded_lhs_indices_[i]).GetPositionListIndex());
     }
 
-    metric_fd_holds_ = true;
-    auto cluster_func = GetClusterFunction();
-    for (auto const& cluster : pli->GetIndex()) {
-        if (!cluster_func(cluster)) {
-            metric_fd_holds_ = false;
-            if (algo_ == MetricAlgo::kApprox) {
-                break;
-            }
+    std::deque<model::PLI::Cluster> const& clusters = pli->GetIndex();
+    /* Largest clusters are verified first, so that threads finish at about the same time */
+    std::vector<size_t> order(clusters.size());
+    std::iota(order.begin(), order.end(), 0);
+    std::stable_sort(order.begin(), order.end(), [&clusters](size_t a, size_t b) {
+        return clusters[a].size() > clusters[b].size();
+    });
+
+    /* Approximate verification calculates no highlights, so it stops at the first violation */
+    bool const stop_at_violation = algo_ == MetricAlgo::kApprox;
+    std::atomic<bool> holds = true;
+    std::vector<std::vector<Highlight>> cluster_highlights(clusters.size());
+    ClusterFunction cluster_func = GetClusterFunction();
+    auto verify_cluster = [&](size_t i) {
+        if (stop_at_violation && !holds.load(std::memory_order_relaxed)) {
+            return;
+        }
+        size_t const cluster_index = order[i];
+        if (!cluster_func(clusters[cluster_index], cluster_highlights[cluster_index])) {
+            holds.store(false, std::memory_order_relaxed);
+        }
+    };
+
+    if (threads_ > 1 && clusters.size() > 1) {
+        util::WorkerThreadPool pool(threads_);
+        pool.ExecIndex(verify_cluster, clusters.size());
+    } else {
+        for (size_t i = 0; i < clusters.size(); ++i) {
+            verify_cluster(i);
+        }
+    }
+
+    metric_fd_holds_ = holds.load();
+    for (std::vector<Highlight>& highlights : cluster_highlights) {
+        if (!highlights.empty()) {
+            highlight_calculator_->AddClusterHighlights(std::move(highlights));
         }
     }
 }
 
 ClusterFunction MetricVerifier::GetClusterFunctionForOneDimension() {
-    model::TypedColumnData const& col = typed_relation_->GetColumnData(rhs_indices_[0]);
+    model::TypedColumnData const& col = typed_relation_->GetColumnData(loaded_rhs_indices_[0]);
 
     if (metric_ == Metric::kEuclidean) {
         assert(col.IsNumeric());
@@ -262,12 +315,14 @@ ClusterFunction MetricVerifier::GetClusterFunctionForOneDimension() {
     std::function<ClusterFunction(DistanceFunction<std::byte const*>)> verify_func;
     if (algo_ == MetricAlgo::kBrute) {
         verify_func = [this](auto dist_func) {
+            /* Cosine distance does not satisfy the triangle inequality */
+            bool const is_metric = metric_ != Metric::kCosine;
             return CalculateClusterFunction<IndexedOneDimensionalPoint>(
                     [this](auto const& cluster) {
                         return points_calculator_->CalculateIndexedPoints(cluster);
                     },
-                    [this, dist_func](auto const& points) {
-                        return this->BruteVerifyCluster(points, dist_func);
+                    [this, dist_func, is_metric](auto const& points) {
+                        return this->BruteVerifyCluster(points, dist_func, is_metric);
                     },
                     [this, dist_func](auto const& points,
                                       std::vector<Highlight>&& cluster_highlights) {
@@ -290,15 +345,16 @@ ClusterFunction MetricVerifier::GetClusterFunctionForOneDimension() {
                 [&type](std::byte const* l, std::byte const* r) { return type.Dist(l, r); });
     }
 
-    return [this, &type, verify_func](model::PLI::Cluster const& cluster) {
-        std::unordered_map<std::string, util::QGramVector> q_gram_map;
-        return verify_func(GetCosineDistFunction(type, q_gram_map))(cluster);
-    };
+    q_gram_profiles_ = std::make_unique<QGramProfiles>(col, q_);
+    return verify_func([profiles = q_gram_profiles_.get()](std::byte const* l, std::byte const* r) {
+        return profiles->CosineDistance(l, r);
+    });
 }
 
 ClusterFunction MetricVerifier::GetClusterFunctionForSeveralDimensions() {
     if (algo_ == MetricAlgo::kCalipers) {
-        return [this](model::PLI::Cluster const& cluster) {
+        return [this](model::PLI::Cluster const& cluster,
+                      std::vector<Highlight>& cluster_highlights) {
             auto result = points_calculator_->CalculateMultidimensionalPointsForCalipers(cluster);
             if (!CheckMFDFailIfHasNulls(result.has_nulls) &&
                 CalipersCompareNumericValues(result.points)) {
@@ -307,7 +363,7 @@ ClusterFunction MetricVerifier::GetClusterFunctionForSeveralDimensions() {
 
             auto result_indexed =
                     points_calculator_->CalculateMultidimensionalIndexedPoints(cluster);
-            highlight_calculator_->CalculateMultidimensionalHighlights(
+            cluster_highlights = highlight_calculator_->CalculateMultidimensionalHighlights(
                     result_indexed.points, std::move(result_indexed.cluster_highlights));
             return false;
         };
@@ -318,8 +374,8 @@ ClusterFunction MetricVerifier::GetClusterFunctionForSeveralDimensions() {
                     return points_calculator_->CalculateMultidimensionalIndexedPoints(cluster);
                 },
                 [this](auto const& points) {
-                    return BruteVerifyCluster<std::vector<long double>>(points,
-                                                                        util::EuclideanDistance);
+                    return BruteVerifyCluster<std::vector<long double>>(
+                            points, util::EuclideanDistance, true);
                 },
                 [this](auto const& points, std::vector<Highlight>&& cluster_highlights) {
                     return highlight_calculator_->CalculateMultidimensionalHighlights(
@@ -334,39 +390,23 @@ ClusterFunction MetricVerifier::GetClusterFunctionForSeveralDimensions() {
 }
 
 ClusterFunction MetricVerifier::GetClusterFunction() {
-    if (rhs_indices_.size() == 1) {
+    if (loaded_rhs_indices_.size() == 1) {
         return GetClusterFunctionForOneDimension();
     }
     return GetClusterFunctionForSeveralDimensions();
 }
 
-DistanceFunction<std::byte const*> MetricVerifier::GetCosineDistFunction(
-        model::StringType const& type,
-        std::unordered_map<std::string, util::QGramVector>& q_gram_map) const {
-    return [this, &type, &q_gram_map](std::byte const* a, std::byte const* b) -> long double {
-        std::string str1 = type.ValueToString(a);
-        std::string str2 = type.ValueToString(b);
-        if (str1.length() < q_ || str2.length() < q_) {
-            throw std::runtime_error(
-                    "q-gram length should not exceed the minimum string length "
-                    "in the dataset.");
-        }
-        util::QGramVector const& v1 = q_gram_map.try_emplace(str1, str1, q_).first->second;
-        util::QGramVector const& v2 = q_gram_map.try_emplace(str2, str2, q_).first->second;
-        return v1.CosineDistance(v2);
-    };
-}
-
 template <typename T>
 ClusterFunction MetricVerifier::CalculateClusterFunction(
         IndexedPointsFunction<T> points_func, CompareFunction<T> compare_func,
         HighlightFunction<T> highlight_func) const {
-    return [this, points_func, compare_func, highlight_func](model::PLI::Cluster const& cluster) {
+    return [this, points_func, compare_func, highlight_func](
+                   model::PLI::Cluster const& cluster, std::vector<Highlight>& cluster_highlights) {
         auto result = points_func(cluster);
         if (!CheckMFDFailIfHasNulls(result.has_nulls) && compare_func(result.points)) {
             return true;
         }
-        highlight_func(result.points, std::move(result.cluster_highlights));
+        cluster_highlights = highlight_func(result.points, std::move(result.cluster_highlights));
         return false;
     };
 }
@@ -374,7 +414,8 @@ ClusterFunction MetricVerifier::CalculateClusterFunction(
 template <typename T>
 ClusterFunction MetricVerifier::CalculateApproxClusterFunction(
         PointsFunction<T> points_func, DistanceFunction<T> dist_func) const {
-    return [points_func, dist_func, this](model::PLI::Cluster const& cluster) {
+    return [points_func, dist_func, this](model::PLI::Cluster const& cluster,
+                                          std::vector<Highlight>&) {
         auto result = points_func(cluster);
         return !CheckMFDFailIfHasNulls(result.has_nulls) &&
                ApproxVerifyCluster(result.points, dist_func);
@@ -386,7 +427,7 @@ bool MetricVerifier::CompareNumericValues(
     if (points.size() < 2) {
         return true;
     }
-    model::TypedColumnData const& col = typed_relation_->GetColumnData(rhs_indices_[0]);
+    model::TypedColumnData const& col = typed_relation_->GetColumnData(loaded_rhs_indices_[0]);
     auto const& type = static_cast<model::INumericType const&>(col.GetType());
 
     std::byte const* max_value = points[0].point;
@@ -418,10 +459,59 @@ bool MetricVerifier::ApproxVerifyCluster(std::vector<T> const& points,
 
 template <typename T>
 bool MetricVerifier::BruteVerifyCluster(std::vector<IndexedPoint<T>> const& points,
-                                        DistanceFunction<T> const& dist_func) const {
-    for (size_t i = 0; i + 1 < points.size(); ++i) {
-        for (size_t j = i + 1; j < points.size(); ++j) {
-            if (dist_func(points[i].point, points[j].point) > parameter_) {
+                                        DistanceFunction<T> const& dist_func,
+                                        bool is_metric) const {
+    if (!is_metric || points.size() < kMinClusterSizeToPrune) {
+        for (size_t i = 0; i + 1 < points.size(); ++i) {
+            for (size_t j = i + 1; j < points.size(); ++j) {
+                if (dist_func(points[i].point, points[j].point) > parameter_) {
+                    return false;
+                }
+            }
+        }
+        return true;
+    }
+
+    /* Distances to two pivots, the first point and the point farthest from it, bound every
+     * pairwise distance by the triangle inequality: |d(x, p) - d(y, p)| <= d(x, y) <=
+     * d(x, p) + d(p, y). A cluster inside a ball of diameter parameter_ needs no pairwise checks,
+     * and only pairs that no pivot decides are compared. */
+    size_t const size = points.size();
+    std::vector<long double> to_first(size, 0);
+    size_t farthest = 0;
+    for (size_t i = 1; i < size; ++i) {
+        to_first[i] = dist_func(points[0].point, points[i].point);
+        if (to_first[i] > parameter_) {
+            return false;
+        }
+        if (to_first[i] > to_first[farthest]) {
+            farthest = i;
+        }
+    }
+    if (to_first[farthest] * 2 <= parameter_) {
+        return true;
+    }
+
+    std::vector<long double> to_second(size, 0);
+    for (size_t i = 0; i < size; ++i) {
+        if (i == farthest) {
+            continue;
+        }
+        to_second[i] = dist_func(points[farthest].point, points[i].point);
+        if (to_second[i] > parameter_) {
+            return false;
+        }
+    }
+
+    for (size_t i = 0; i + 1 < size; ++i) {
+        for (size_t j = i + 1; j < size; ++j) {
+            if (to_first[i] + to_first[j] <= parameter_ ||
+                to_second[i] + to_second[j] <= parameter_) {
+                continue;
+            }
+            if (std::abs(to_first[i] - to_first[j]) > parameter_ ||
+                std::abs(to_second[i] - to_second[j]) > parameter_ ||
+                dist_func(points[i].point, points[j].point) > parameter_) {
                 return false;
             }
         }
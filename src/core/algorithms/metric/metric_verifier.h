@@ -15,19 +15,23 @@
 #include "core/algorithms/metric/highlight_calculator.h"
 #include "core/algorithms/metric/points.h"
 #include "core/algorithms/metric/points_calculator.h"
+#include "core/algorithms/metric/q_gram_profiles.h"
 #include "core/config/equal_nulls/type.h"
 #include "core/config/indices/type.h"
 #include "core/config/tabular_data/input_table_type.h"
+#include "core/config/thread_number/type.h"
 #include "core/model/table/column_layout_relation_data.h"
 #include "core/model/table/column_layout_typed_relation_data.h"
+#include "core/model/table/column_projection.h"
 #include "core/util/convex_hull.h"
-#include "core/util/qgram_vector.h"
 
 namespace algos::metric {
 
 class MetricVerifier : public Algorithm {
 private:
     config::InputTable input_table_;
+    config::IndicesType load_columns_;
+    model::ColumnProjection projection_;
 
     Metric metric_ = magic_enum::enum_values<Metric>().front();
     MetricAlgo algo_ = magic_enum::enum_values<MetricAlgo>().front();
@@ -37,17 +41,21 @@ private:
     unsigned int q_;
     bool dist_from_null_is_infinity_;
     config::EqNullsType is_null_equal_null_;
+    config::ThreadNumType threads_;
+
+    /* Smallest cluster for which brute verification bounds distances with pivots */
+    static constexpr size_t kMinClusterSizeToPrune = 8;
 
     bool metric_fd_holds_ = false;
+    /* lhs_indices_ and rhs_indices_ in the numbering of the loaded relation */
+    config::IndicesType loaded_lhs_indices_;
+    config::IndicesType loaded_rhs_indices_;
 
-    std::shared_ptr<model::ColumnLayoutTypedRelationData> typed_relation_;
-    std::shared_ptr<ColumnLayoutRelationData> relation_;  // temporarily parsing twice
+    std::shared_ptr<model::ColumnLayoutTypedRelationData const> typed_relation_;
+    std::shared_ptr<ColumnLayoutRelationData const> relation_;  // temporarily parsing twice
     std::unique_ptr<PointsCalculator> points_calculator_;
     std::unique_ptr<HighlightCalculator> highlight_calculator_;
-
-    DistanceFunction<std::byte const*> GetCosineDistFunction(
-            model::StringType const& type,
-            std::unordered_map<std::string, util::QGramVector>& q_gram_map) const;
+    std::unique_ptr<QGramProfiles> q_gram_profiles_;
 
     bool CheckMFDFailIfHasNulls(bool has_nulls) const {
         return dist_from_null_is_infinity_ && has_nulls;
@@ -61,7 +69,7 @@ private:
 
     template <typename T>
     bool BruteVerifyCluster(std::vector<IndexedPoint<T>> const& points,
-                            DistanceFunction<T> const& dist_func) const;
+                            DistanceFunction<T> const& dist_func, bool is_metric) const;
 
     bool CalipersCompareNumericValues(std::vector<util::Point>& points) const;
 
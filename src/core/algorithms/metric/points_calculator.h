@@ -10,7 +10,7 @@ namespace algos::metric {
 class PointsCalculator {
 private:
     bool dist_from_null_is_infinity_;
-    std::shared_ptr<model::ColumnLayoutTypedRelationData> typed_relation_;
+    std::shared_ptr<model::ColumnLayoutTypedRelationData const> typed_relation_;
     config::IndicesType rhs_indices_;
 
     long double GetCoordinate(bool& has_values, ClusterIndex row_index, bool& has_nulls,
@@ -43,9 +43,10 @@ public:
     PointsCalculationResult<std::byte const*> CalculatePoints(
             model::PLI::Cluster const& cluster) const;
 
-    explicit PointsCalculator(bool dist_from_null_is_infinity,
-                              std::shared_ptr<model::ColumnLayoutTypedRelationData> typed_relation,
-                              config::IndicesType rhs_indices)
+    explicit PointsCalculator(
+            bool dist_from_null_is_infinity,
+            std::shared_ptr<model::ColumnLayoutTypedRelationData const> typed_relation,
+            config::IndicesType rhs_indices)
         : dist_from_null_is_infinity_(dist_from_null_is_infinity),
           typed_relation_(std::move(typed_relation)),
           rhs_indices_(std::move(rhs_indices)) {};
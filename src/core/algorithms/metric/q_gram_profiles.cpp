@@ -0,0 +1,84 @@
+#include "core/algorithms/metric/q_gram_profiles.h"
+
+#include <algorithm>
+#include <cassert>
+#include <cmath>
+#include <stdexcept>
+#include <string>
+#include <string_view>
+
+namespace algos::metric {
+
+QGramProfiles::QGramProfiles(model::TypedColumnData const& column, unsigned q) : q_(q) {
+    model::Type const& type = column.GetType();
+    std::vector<std::byte const*> const& data = column.GetData();
+    std::unordered_map<std::string, std::size_t> string_profiles;
+    std::unordered_map<std::string, unsigned> q_gram_ids;
+
+    value_profiles_.reserve(data.size());
+    for (std::size_t i = 0; i < data.size(); ++i) {
+        if (column.IsNullOrEmpty(i)) {
+            continue;
+        }
+        std::string str = type.ValueToString(data[i]);
+        if (str.length() < q_) {
+            value_profiles_.emplace(data[i], kTooShort);
+            continue;
+        }
+        auto [it, is_new] = string_profiles.try_emplace(std::move(str), profiles_.size());
+        value_profiles_.emplace(data[i], it->second);
+        if (!is_new) {
+            continue;
+        }
+
+        std::string_view const view = it->first;
+        std::unordered_map<unsigned, unsigned> counts;
+        for (std::size_t j = 0; j + q_ <= view.size(); ++j) {
+            auto id_it = q_gram_ids.try_emplace(std::string(view.substr(j, q_)), q_gram_ids.size())
+                                 .first;
+            ++counts[id_it->second];
+        }
+        Profile profile{{counts.begin(), counts.end()}, 0};
+        std::sort(profile.q_grams.begin(), profile.q_grams.end());
+        long double squares = 0;
+        for (auto [id, count] : profile.q_grams) {
+            squares += static_cast<long double>(count) * count;
+        }
+        profile.length = std::sqrt(squares);
+        profiles_.push_back(std::move(profile));
+    }
+}
+
+QGramProfiles::Profile const& QGramProfiles::GetProfile(std::byte const* value) const {
+    auto it = value_profiles_.find(value);
+    assert(it != value_profiles_.end());
+    if (it->second == kTooShort) {
+        throw std::runtime_error(
+                "q-gram length should not exceed the minimum string length "
+                "in the dataset.");
+    }
+    return profiles_[it->second];
+}
+
+long double QGramProfiles::CosineDistance(std::byte const* a, std::byte const* b) const {
+    Profile const& p1 = GetProfile(a);
+    Profile const& p2 = GetProfile(b);
+
+    long double inner_product = 0;
+    auto it1 = p1.q_grams.begin();
+    auto it2 = p2.q_grams.begin();
+    while (it1 != p1.q_grams.end() && it2 != p2.q_grams.end()) {
+        if (it1->first < it2->first) {
+            ++it1;
+        } else if (it2->first < it1->first) {
+            ++it2;
+        } else {
+            inner_product += static_cast<long double>(it1->second) * it2->second;
+            ++it1;
+            ++it2;
+        }
+    }
+    return 1 - inner_product / (p1.length * p2.length);
+}
+
+}  // namespace algos::metric
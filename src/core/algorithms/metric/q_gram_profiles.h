@@ -0,0 +1,37 @@
+#pragma once
+
+#include <cstddef>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+
+#include "core/model/table/typed_column_data.h"
+
+namespace algos::metric {
+
+/* Q-gram vectors of all distinct strings of a column, built once per execution and shared by
+ * the threads verifying clusters. Q-grams are numbered, so a vector is a list of (q-gram id,
+ * count) pairs sorted by id and the inner product of two vectors is a merge. */
+class QGramProfiles {
+private:
+    struct Profile {
+        std::vector<std::pair<unsigned, unsigned>> q_grams;
+        long double length;
+    };
+
+    static constexpr std::size_t kTooShort = -1;
+
+    unsigned q_;
+    std::vector<Profile> profiles_;
+    /* Profile index of every value of the column, kTooShort for strings shorter than q */
+    std::unordered_map<std::byte const*, std::size_t> value_profiles_;
+
+    Profile const& GetProfile(std::byte const* value) const;
+
+public:
+    QGramProfiles(model::TypedColumnData const& column, unsigned q);
+
+    long double CosineDistance(std::byte const* a, std::byte const* b) const;
+};
+
+}  // namespace algos::metric
@@ -4,12 +4,14 @@
 #include <chrono>
 #include <cstddef>
 #include <memory>
+#include <optional>
 #include <vector>
 
 #include "core/algorithms/nar/value_range.h"
 #include "core/config/names_and_descriptions.h"
 #include "core/config/option_using.h"
 #include "core/config/tabular_data/input_table/option.h"
+#include "core/config/thread_number/option.h"
 #include "core/model/types/types.h"
 
 namespace algos::des {
@@ -33,13 +35,14 @@ void DES::RegisterOptions() {
                           kDCrossoverProbability, 0.9});
     RegisterOption(Option{&differential_options_.differential_strategy, kDifferentialStrategy,
                           kDDifferentialStrategy, default_strategy});
+    RegisterOption(config::kThreadNumberOpt(&threads_));
 }
 
 void DES::MakeExecuteOptsAvailable() {
     NARAlgorithm::MakeExecuteOptsAvailable();
     using namespace config::names;
     MakeOptionsAvailable({kSeed, kPopulationSize, kMaxFitnessEvaluations, kDifferentialScale,
-                          kCrossoverProbability, kDifferentialStrategy});
+                          kCrossoverProbability, kDifferentialStrategy, kThreads});
 }
 
 FeatureDomains DES::FindFeatureDomains(TypedRelation const* typed_relation) {
@@ -50,12 +53,40 @@ FeatureDomains DES::FindFeatureDomains(TypedRelation const* typed_relation) {
     return feature_domains;
 }
 
+void DES::EvaluateQualities(std::vector<Evaluation>& evaluations,
+                            model::FeatureColumns const& columns, util::WorkerThreadPool* pool) {
+    auto evaluate = [&evaluations, &columns](size_t i) {
+        Evaluation& evaluation = evaluations[i];
+        evaluation.decoded.SetQualities(columns.CalculateQualities(evaluation.decoded));
+        evaluation.individual.SetQualities(evaluation.decoded.GetQualities());
+    };
+    if (pool != nullptr && evaluations.size() > 1) {
+        pool->ExecIndex(evaluate, evaluations.size());
+    } else {
+        for (size_t i = 0; i < evaluations.size(); ++i) {
+            evaluate(i);
+        }
+    }
+}
+
 std::vector<EncodedNAR> DES::GetRandomPopulationInDomains(FeatureDomains const& domains,
-                                                          RNG& rng) const {
+                                                          model::FeatureColumns const& columns,
+                                                          RNG& rng,
+                                                          util::WorkerThreadPool* pool) const {
+    std::vector<Evaluation> evaluations;
+    evaluations.reserve(population_size_);
+    for (size_t i = 0; i < population_size_; ++i) {
+        EncodedNAR individual(domains.size(), rng);
+        NAR decoded = individual.Decode(domains, rng);
+        evaluations.push_back({std::move(individual), std::move(decoded), i});
+    }
+    EvaluateQualities(evaluations, columns, pool);
+
     std::vector<EncodedNAR> population;
     population.reserve(population_size_);
-    std::generate_n(std::back_inserter(population), population_size_,
-                    [&]() { return EncodedNAR(domains, typed_relation_.get(), rng); });
+    for (Evaluation& evaluation : evaluations) {
+        population.push_back(std::move(evaluation.individual));
+    }
     auto compare_by_fitness = [](EncodedNAR const& a, EncodedNAR const& b) {
         return a.GetQualities().fitness > b.GetQualities().fitness;
     };
@@ -64,10 +95,10 @@ std::vector<EncodedNAR> DES::GetRandomPopulationInDomains(FeatureDomains const&
 }
 
 EncodedNAR DES::MutatedIndividual(std::vector<EncodedNAR> const& population, size_t at,
-                                  RNG& rng) const {
+                                  std::vector<size_t> const& sample_indices, RNG& rng) const {
     MutationFunction diff_func =
             EnumToMutationStrategy(differential_options_.differential_strategy);
-    return (*diff_func)(population, at, differential_options_, rng);
+    return (*diff_func)(population, at, sample_indices, differential_options_, rng);
 }
 
 unsigned long long DES::ExecuteInternal() {
@@ -75,21 +106,57 @@ unsigned long long DES::ExecuteInternal() {
     auto const start_time = std::chrono::system_clock::now();
 
     FeatureDomains feature_domains = FindFeatureDomains(typed_relation_.get());
-    std::vector<EncodedNAR> population = GetRandomPopulationInDomains(feature_domains, rng_);
+    model::FeatureColumns const columns(*typed_relation_);
+    std::optional<util::WorkerThreadPool> pool;
+    if (threads_ > 1) {
+        pool.emplace(threads_);
+    }
+    util::WorkerThreadPool* pool_ptr = pool ? std::addressof(*pool) : nullptr;
+
+    std::vector<EncodedNAR> population =
+            GetRandomPopulationInDomains(feature_domains, columns, rng_, pool_ptr);
+
+    /* All random numbers are drawn here, in the same order as if every mutant were evaluated
+     * right away, and only the fitness computations are batched. A mutant joins the batch
+     * unless it reads an individual that a mutant in the batch may replace, so the result is
+     * the same for any number of threads. */
+    size_t const sample_count = GetSampleCount(differential_options_.differential_strategy);
+    std::vector<Evaluation> batch;
+    std::vector<bool> is_pending(population_size_, false);
+    auto apply_batch = [&]() {
+        EvaluateQualities(batch, columns, pool_ptr);
+        for (Evaluation& evaluation : batch) {
+            size_t const candidate_i = evaluation.candidate_index;
+            is_pending[candidate_i] = false;
+            double candidate_fitness = population[candidate_i].GetQualities().fitness;
+            auto mutant_qualities = evaluation.decoded.GetQualities();
+            if (mutant_qualities.fitness > candidate_fitness) {
+                population[candidate_i] = std::move(evaluation.individual);
+                if (mutant_qualities.support > minsup_ && mutant_qualities.confidence > minconf_) {
+                    nar_collection_.emplace_back(std::move(evaluation.decoded));
+                }
+            }
+        }
+        batch.clear();
+    };
 
     for (unsigned i = 0; i < num_evaluations_; ++i) {
         size_t candidate_i = i % population_size_;
-        EncodedNAR mutant = MutatedIndividual(population, candidate_i, rng_);
-        NAR mutant_decoded = mutant.SetQualities(feature_domains, typed_relation_.get(), rng_);
-        double candidate_fitness = population[candidate_i].GetQualities().fitness;
-        auto mutant_qualities = mutant_decoded.GetQualities();
-        if (mutant_qualities.fitness > candidate_fitness) {
-            population[candidate_i] = std::move(mutant);
-            if (mutant_qualities.support > minsup_ && mutant_qualities.confidence > minconf_) {
-                nar_collection_.emplace_back(std::move(mutant_decoded));
-            }
+        std::vector<size_t> sample_indices =
+                GetRandIndices(candidate_i, population_size_, sample_count, rng_);
+        bool const depends_on_batch =
+                is_pending[candidate_i] ||
+                std::ranges::any_of(sample_indices, [&](size_t j) { return is_pending[j]; });
+        if (depends_on_batch || pool_ptr == nullptr) {
+            apply_batch();
         }
+
+        EncodedNAR mutant = MutatedIndividual(population, candidate_i, sample_indices, rng_);
+        NAR mutant_decoded = mutant.Decode(feature_domains, rng_);
+        batch.push_back({std::move(mutant), std::move(mutant_decoded), candidate_i});
+        is_pending[candidate_i] = true;
     }
+    apply_batch();
 
     auto compare_by_fitness = [](const NAR& a, const NAR& b) -> bool {
         return a.GetQualities().fitness > b.GetQualities().fitness;
@@ -4,8 +4,11 @@
 #include "core/algorithms/nar/des/encoded_nar.h"
 #include "core/algorithms/nar/des/enums.h"
 #include "core/algorithms/nar/des/rng.h"
+#include "core/algorithms/nar/feature_columns.h"
 #include "core/algorithms/nar/nar_algorithm.h"
 #include "core/config/names.h"
+#include "core/config/thread_number/type.h"
+#include "core/util/worker_thread_pool.h"
 
 namespace algos::des {
 using FeatureDomains = std::vector<std::shared_ptr<model::ValueRange>> const;
@@ -17,14 +20,27 @@ private:
     unsigned int population_size_;
     unsigned int num_evaluations_;
     DifferentialOptions differential_options_;
+    config::ThreadNumType threads_ = 1;
     RNG rng_;
     void RegisterOptions();
 
+    /* An individual whose random decisions have all been made, waiting for its fitness */
+    struct Evaluation {
+        EncodedNAR individual;
+        NAR decoded;
+        size_t candidate_index;
+    };
+
     static FeatureDomains FindFeatureDomains(TypedRelation const* typed_relation);
     std::vector<EncodedNAR> GetRandomPopulationInDomains(FeatureDomains const& domains,
-                                                         RNG& rng) const;
+                                                         model::FeatureColumns const& columns,
+                                                         RNG& rng,
+                                                         util::WorkerThreadPool* pool) const;
     EncodedNAR MutatedIndividual(std::vector<EncodedNAR> const& population, size_t at,
-                                 RNG& rng) const;
+                                 std::vector<size_t> const& sample_indices, RNG& rng) const;
+    static void EvaluateQualities(std::vector<Evaluation>& evaluations,
+                                  model::FeatureColumns const& columns,
+                                  util::WorkerThreadPool* pool);
 
 protected:
     void MakeExecuteOptsAvailable() override;
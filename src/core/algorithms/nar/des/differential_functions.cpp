@@ -19,8 +19,9 @@ std::vector<size_t> GetRandIndices(size_t except_index, size_t population, size_
 }
 
 EncodedNAR Rand1Bin(std::vector<EncodedNAR> const& population, size_t candidate_index,
-                    DifferentialOptions const& options, RNG& rng) {
-    auto sample_indices = GetRandIndices(candidate_index, population.size(), 3, rng);
+                    std::vector<size_t> const& sample_indices, DifferentialOptions const& options,
+                    RNG& rng) {
+    assert(sample_indices.size() == 3);
     auto new_individual = population[candidate_index];
     auto sample1 = population[sample_indices[0]];
     auto sample2 = population[sample_indices[1]];
@@ -47,4 +48,13 @@ MutationFunction EnumToMutationStrategy(DifferentialStrategy strategy) {
     }
 }
 
+size_t GetSampleCount(DifferentialStrategy strategy) {
+    switch (strategy) {
+        case DifferentialStrategy::kRand1Bin:
+            return 3;
+        default:
+            throw std::logic_error("No mutation function corresponding to DifferentialStrategy.");
+    }
+}
+
 }  // namespace algos::des
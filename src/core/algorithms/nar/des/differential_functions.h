@@ -12,13 +12,23 @@ struct DifferentialOptions {
     DifferentialStrategy differential_strategy = DifferentialStrategy::kBest1Exp;
 };
 
+std::vector<size_t> GetRandIndices(size_t except_index, size_t population, size_t number_of_indices,
+                                   RNG& rng);
+
 EncodedNAR Rand1Bin(std::vector<EncodedNAR> const& population, size_t candidate_index,
-                    DifferentialOptions const& options, RNG& rng);
+                    std::vector<size_t> const& sample_indices, DifferentialOptions const& options,
+                    RNG& rng);
 
+/* A mutation reads the candidate and the individuals at sample_indices, which are drawn with
+ * GetRandIndices beforehand, so the caller knows what the mutant depends on. */
 using MutationFunction = EncodedNAR (*)(std::vector<EncodedNAR> const& population,
-                                        size_t candidate_index, DifferentialOptions const& options,
-                                        RNG& rng);
+                                        size_t candidate_index,
+                                        std::vector<size_t> const& sample_indices,
+                                        DifferentialOptions const& options, RNG& rng);
 
 MutationFunction EnumToMutationStrategy(DifferentialStrategy strategy);
 
+/* Number of sample indices the mutation function of the strategy needs */
+size_t GetSampleCount(DifferentialStrategy strategy);
+
 }  // namespace algos::des
@@ -37,13 +37,9 @@ double const& EncodedNAR::operator[](size_t index) const {
     return encoded_value_ranges_[feature][feature_field];
 }
 
-NAR EncodedNAR::SetQualities(FeatureDomains& domains, TypedRelation const* typed_relation,
-                             RNG& rng) {
-    NAR this_decoded = Decode(domains, rng);
-    this_decoded.SetQualities(typed_relation);
-    qualities_ = this_decoded.GetQualities();
+void EncodedNAR::SetQualities(model::NARQualities const& qualities) {
+    qualities_ = qualities;
     qualities_consistent_ = true;
-    return this_decoded;
 }
 
 model::NARQualities const& EncodedNAR::GetQualities() const {
@@ -83,15 +79,6 @@ NAR EncodedNAR::Decode(FeatureDomains& domains, RNG& rng) const {
     return resulting_nar;
 }
 
-EncodedNAR::EncodedNAR(FeatureDomains& domains, TypedRelation const* typed_relation, RNG& rng)
-    : implication_sign_pos_(rng.Next()) {
-    size_t feature_count = domains.size();
-    encoded_value_ranges_.reserve(feature_count);
-    std::generate_n(std::back_inserter(encoded_value_ranges_), feature_count,
-                    [&rng]() { return EncodedValueRange(rng); });
-    SetQualities(domains, typed_relation, rng);
-}
-
 EncodedNAR::EncodedNAR(size_t feature_count, RNG& rng) : implication_sign_pos_(rng.Next()) {
     encoded_value_ranges_.reserve(feature_count);
     std::generate_n(std::back_inserter(encoded_value_ranges_), feature_count,
@@ -9,7 +9,6 @@ using model::NAR;
 
 class EncodedNAR {
 private:
-    using TypedRelation = model::ColumnLayoutTypedRelationData;
     using FeatureDomains = std::vector<std::shared_ptr<model::ValueRange>> const;
 
     double implication_sign_pos_ = -1;
@@ -25,10 +24,9 @@ public:
     double const& operator[](size_t index) const;
 
     model::NARQualities const& GetQualities() const;
-    NAR SetQualities(FeatureDomains& domains, TypedRelation const* typed_relation, RNG& rng);
+    void SetQualities(model::NARQualities const& qualities);
 
     NAR Decode(FeatureDomains& domains, RNG& rng) const;
-    EncodedNAR(FeatureDomains& domains, TypedRelation const* typed_relation, RNG& rng);
     EncodedNAR(size_t feature_count, RNG& rng);
 };
 
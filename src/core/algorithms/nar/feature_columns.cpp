@@ -0,0 +1,183 @@
+#include "core/algorithms/nar/feature_columns.h"
+
+#include <algorithm>
+#include <bit>
+#include <stdexcept>
+
+namespace model {
+
+namespace {
+
+/* Clears the bits of rows whose value does not fit. Words without set bits are skipped, so every
+ * next predicate of a conjunction scans fewer rows. */
+template <typename Fits>
+void AndScan(std::vector<std::uint64_t>& rows, std::vector<std::uint64_t> const& has_value,
+             size_t num_rows, Fits fits) {
+    constexpr size_t kWordBits = 64;
+    for (size_t w = 0; w < rows.size(); ++w) {
+        if (rows[w] == 0) {
+            continue;
+        }
+        size_t const begin = w * kWordBits;
+        size_t const end = std::min(begin + kWordBits, num_rows);
+        std::uint64_t mask = 0;
+        for (size_t row = begin; row < end; ++row) {
+            mask |= std::uint64_t{fits(row)} << (row - begin);
+        }
+        rows[w] &= mask & has_value[w];
+    }
+}
+
+}  // namespace
+
+FeatureColumns::FeatureColumns(ColumnLayoutTypedRelationData const& typed_relation)
+    : num_rows_(typed_relation.GetNumRows()) {
+    columns_.reserve(typed_relation.GetNumColumns());
+    for (TypedColumnData const& column_data : typed_relation.GetColumnData()) {
+        Column& column = columns_.emplace_back();
+        column.type_id = column_data.GetTypeId();
+        column.has_value.assign(WordCount(), 0);
+
+        auto has_value = [&column_data](size_t row) {
+            return !column_data.IsMixed() && !column_data.IsNullOrEmpty(row);
+        };
+        for (size_t row = 0; row < num_rows_; ++row) {
+            if (has_value(row)) {
+                column.has_value[row / kWordBits] |= Word{1} << (row % kWordBits);
+            }
+        }
+
+        switch (column.type_id) {
+            case TypeId::kInt:
+                column.ints.resize(num_rows_);
+                for (size_t row = 0; row < num_rows_; ++row) {
+                    if (has_value(row)) {
+                        column.ints[row] = Type::GetValue<Int>(column_data.GetValue(row));
+                    }
+                }
+                break;
+            case TypeId::kDouble:
+                column.doubles.resize(num_rows_);
+                for (size_t row = 0; row < num_rows_; ++row) {
+                    if (has_value(row)) {
+                        column.doubles[row] = Type::GetValue<Double>(column_data.GetValue(row));
+                    }
+                }
+                break;
+            case TypeId::kBool:
+                column.codes.resize(num_rows_);
+                for (size_t row = 0; row < num_rows_; ++row) {
+                    if (has_value(row)) {
+                        column.codes[row] = Type::GetValue<bool>(column_data.GetValue(row));
+                    }
+                }
+                break;
+            case TypeId::kString: {
+                column.codes.resize(num_rows_);
+                for (size_t row = 0; row < num_rows_; ++row) {
+                    if (!has_value(row)) {
+                        continue;
+                    }
+                    String const& value = Type::GetValue<String>(column_data.GetValue(row));
+                    auto [it, _] = column.dictionary.try_emplace(value, column.dictionary.size());
+                    column.codes[row] = it->second;
+                }
+                break;
+            }
+            default:
+                /* Such columns have no value ranges */
+                break;
+        }
+    }
+}
+
+std::vector<FeatureColumns::Word> FeatureColumns::AllRows() const {
+    std::vector<Word> rows(WordCount(), ~Word{0});
+    if (size_t const tail = num_rows_ % kWordBits; tail != 0) {
+        rows.back() = (Word{1} << tail) - 1;
+    }
+    return rows;
+}
+
+void FeatureColumns::AndPredicate(size_t feature, ValueRange const& range,
+                                  std::vector<Word>& rows) const {
+    Column const& column = columns_.at(feature);
+    switch (range.GetTypeId()) {
+        case TypeId::kInt: {
+            auto const& int_range = static_cast<NumericValueRange<Int> const&>(range);
+            Int const* values = column.ints.data();
+            Int const lower = int_range.lower_bound;
+            Int const upper = int_range.upper_bound;
+            AndScan(rows, column.has_value, num_rows_, [values, lower, upper](size_t row) {
+                return (values[row] >= lower) & (values[row] <= upper);
+            });
+            break;
+        }
+        case TypeId::kDouble: {
+            auto const& double_range = static_cast<NumericValueRange<Double> const&>(range);
+            Double const* values = column.doubles.data();
+            Double const lower = double_range.lower_bound;
+            Double const upper = double_range.upper_bound;
+            AndScan(rows, column.has_value, num_rows_, [values, lower, upper](size_t row) {
+                return (values[row] >= lower) & (values[row] <= upper);
+            });
+            break;
+        }
+        case TypeId::kBool: {
+            auto const& bool_range = static_cast<BoolValueRange const&>(range);
+            std::uint32_t const* values = column.codes.data();
+            std::uint32_t const lower = bool_range.lower_bound;
+            std::uint32_t const upper = bool_range.upper_bound;
+            AndScan(rows, column.has_value, num_rows_, [values, lower, upper](size_t row) {
+                return (values[row] >= lower) & (values[row] <= upper);
+            });
+            break;
+        }
+        case TypeId::kString: {
+            auto const& string_range = static_cast<StringValueRange const&>(range);
+            std::vector<std::uint8_t> allowed(column.dictionary.size(), 0);
+            for (String const& value : string_range.domain) {
+                auto it = column.dictionary.find(value);
+                if (it != column.dictionary.end()) {
+                    allowed[it->second] = 1;
+                }
+            }
+            std::uint32_t const* values = column.codes.data();
+            std::uint8_t const* allowed_codes = allowed.data();
+            AndScan(rows, column.has_value, num_rows_, [values, allowed_codes](size_t row) {
+                return allowed_codes[values[row]] != 0;
+            });
+            break;
+        }
+        default:
+            throw std::logic_error("No predicate scan for the type of the value range.");
+    }
+}
+
+NARQualities FeatureColumns::CalculateQualities(NAR const& nar) const {
+    if (nar.GetAnte().empty() || nar.GetCons().empty()) {
+        return {0.0, 0.0, 0.0};
+    }
+
+    std::vector<Word> ante_rows = AllRows();
+    for (auto const& [feature, range] : nar.GetAnte()) {
+        AndPredicate(feature, *range, ante_rows);
+    }
+    /* Only rows fitting the antecedent matter for the consequent */
+    std::vector<Word> ante_and_cons_rows = ante_rows;
+    for (auto const& [feature, range] : nar.GetCons()) {
+        AndPredicate(feature, *range, ante_and_cons_rows);
+    }
+
+    size_t num_rows_fit_ante = 0;
+    size_t num_rows_fit_ante_and_cons = 0;
+    for (size_t w = 0; w < ante_rows.size(); ++w) {
+        num_rows_fit_ante += std::popcount(ante_rows[w]);
+        num_rows_fit_ante_and_cons += std::popcount(ante_and_cons_rows[w]);
+    }
+
+    return CalcQualities(num_rows_fit_ante, num_rows_fit_ante_and_cons,
+                         nar.GetAnte().size() + nar.GetCons().size(), columns_.size(), num_rows_);
+}
+
+}  // namespace model
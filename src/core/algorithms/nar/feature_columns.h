@@ -0,0 +1,59 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <unordered_map>
+#include <vector>
+
+#include "core/algorithms/nar/nar.h"
+#include "core/algorithms/nar/value_range.h"
+#include "core/model/table/column_layout_typed_relation_data.h"
+
+namespace model {
+
+/* Columns of a relation copied into flat typed arrays, so that a value range predicate over a
+ * feature is a branch-free scan producing a row bitmap. The qualities of a NAR are then counted
+ * with AND and popcount over the bitmaps of its antecedent and consequent. Safe to use from
+ * several threads at once.
+ */
+class FeatureColumns {
+private:
+    using Word = std::uint64_t;
+    static constexpr size_t kWordBits = 64;
+
+    struct Column {
+        TypeId type_id;
+        std::vector<Int> ints;
+        std::vector<Double> doubles;
+        /* Bools and dictionary codes of strings */
+        std::vector<std::uint32_t> codes;
+        std::unordered_map<String, std::uint32_t> dictionary;
+        /* Null and empty values never satisfy a predicate */
+        std::vector<Word> has_value;
+    };
+
+    size_t num_rows_;
+    std::vector<Column> columns_;
+
+    size_t WordCount() const noexcept {
+        return (num_rows_ + kWordBits - 1) / kWordBits;
+    }
+
+    std::vector<Word> AllRows() const;
+    void AndPredicate(size_t feature, ValueRange const& range, std::vector<Word>& rows) const;
+
+public:
+    explicit FeatureColumns(ColumnLayoutTypedRelationData const& typed_relation);
+
+    NARQualities CalculateQualities(NAR const& nar) const;
+
+    size_t GetNumRows() const noexcept {
+        return num_rows_;
+    }
+
+    size_t GetNumColumns() const noexcept {
+        return columns_.size();
+    }
+};
+
+}  // namespace model
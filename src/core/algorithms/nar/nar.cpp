@@ -36,42 +36,6 @@ NARQualities CalcQualities(size_t num_rows_fit_ante, size_t num_rows_fit_ante_an
     return {fitness, support, confidence};
 }
 
-void NAR::SetQualities(TypedRelation const* typed_relation) {
-    if (ante_.empty() || cons_.empty()) {
-        qualities_ = {0.0, 0.0, 0.0};
-        qualities_consistent_ = true;
-        return;
-    }
-    size_t num_rows_fit_ante = 0;
-    size_t num_rows_fit_ante_and_cons = 0;
-    size_t num_rows = typed_relation->GetNumRows();
-    size_t num_columns = typed_relation->GetNumColumns();
-    for (size_t rowi = 0; rowi < num_rows; ++rowi) {
-        bool row_fits_ante = true;
-        bool row_fits_cons = true;
-        for (size_t coli = 0; coli < num_columns; ++coli) {
-            model::TypedColumnData const& column = typed_relation->GetColumnData(coli);
-            std::byte const* value = column.GetValue(rowi);
-            if (row_fits_ante) {
-                row_fits_ante = AnteFitsValue(coli, value);
-                row_fits_cons &= ConsFitsValue(coli, value);
-            } else {
-                break;
-            }
-        }
-        if (row_fits_ante) {
-            ++num_rows_fit_ante;
-            if (row_fits_cons) {
-                ++num_rows_fit_ante_and_cons;
-            }
-        }
-    }
-
-    qualities_ = CalcQualities(num_rows_fit_ante, num_rows_fit_ante_and_cons,
-                               ante_.size() + cons_.size(), num_columns, num_rows);
-    qualities_consistent_ = true;
-}
-
 model::NARQualities const& NAR::GetQualities() const {
     if (!qualities_consistent_) {
         throw std::logic_error("Getting uninitialized qualities from NAR.");
@@ -89,13 +53,4 @@ void NAR::InsertInCons(size_t feature_index, std::shared_ptr<ValueRange> range)
     cons_.insert({feature_index, std::move(range)});
 }
 
-bool NAR::MapFitsValue(std::unordered_map<size_t, std::shared_ptr<ValueRange>> const& map,
-                       size_t feature_index, std::byte const* value) {
-    auto it = map.find(feature_index);
-    if (it == map.end()) {
-        return true;
-    }
-    return it->second->Includes(value);
-}
-
 }  // namespace model
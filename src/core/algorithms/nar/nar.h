@@ -20,29 +20,24 @@ struct NARQualities {
     }
 };
 
+NARQualities CalcQualities(size_t num_rows_fit_ante, size_t num_rows_fit_ante_and_cons,
+                           size_t included_features, size_t feature_count, size_t num_rows);
+
 class NAR {
 private:
-    using TypedRelation = model::ColumnLayoutTypedRelationData;
     NARQualities qualities_;
     bool qualities_consistent_ = false;
 
     std::unordered_map<size_t, std::shared_ptr<ValueRange>> ante_{};
     std::unordered_map<size_t, std::shared_ptr<ValueRange>> cons_{};
 
-    bool AnteFitsValue(size_t feature_index, std::byte const* value_of_feature) const {
-        return MapFitsValue(ante_, feature_index, value_of_feature);
-    }
-
-    bool ConsFitsValue(size_t feature_index, std::byte const* value_of_feature) const {
-        return MapFitsValue(cons_, feature_index, value_of_feature);
-    }
-
-    static bool MapFitsValue(std::unordered_map<size_t, std::shared_ptr<ValueRange>> const& map,
-                             size_t feature_index, std::byte const* value);
-
 public:
     std::string ToString() const;
-    void SetQualities(TypedRelation const* typed_relation);
+
+    void SetQualities(NARQualities const& qualities) {
+        qualities_ = qualities;
+        qualities_consistent_ = true;
+    }
     NARQualities const& GetQualities() const;
 
     auto const& GetAnte() const noexcept {
@@ -5,6 +5,7 @@
 #include "core/config/names_and_descriptions.h"
 #include "core/config/option_using.h"
 #include "core/config/tabular_data/input_table/option.h"
+#include "core/model/table/dataset.h"
 
 namespace algos {
 
@@ -15,7 +16,7 @@ NARAlgorithm::NARAlgorithm() : Algorithm() {
 }
 
 void NARAlgorithm::LoadDataInternal() {
-    typed_relation_ = model::ColumnLayoutTypedRelationData::CreateFrom(*input_table_, true);
+    typed_relation_ = model::LoadTypedRelation(*input_table_, true);
     input_table_->Reset();
     if (typed_relation_->GetColumnData().empty()) {
         throw std::runtime_error("Got an empty dataset: Numeric AR mining is meaningless.");
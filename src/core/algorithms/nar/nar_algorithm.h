@@ -19,7 +19,7 @@ private:
 
 protected:
     std::vector<NAR> nar_collection_;
-    std::unique_ptr<TypedRelation> typed_relation_;
+    std::shared_ptr<TypedRelation const> typed_relation_;
     config::ArMinimumSupportType minsup_;
     config::ArMinimumConfidenceType minconf_;
 
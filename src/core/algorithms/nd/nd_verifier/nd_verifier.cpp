@@ -17,6 +17,7 @@
 #include "core/config/option_using.h"
 #include "core/config/tabular_data/input_table/option.h"
 #include "core/model/table/column_layout_typed_relation_data.h"
+#include "core/model/table/dataset.h"
 #include "core/model/table/typed_column_data.h"
 #include "core/model/types/builtin.h"
 #include "core/model/types/type.h"
@@ -44,8 +45,7 @@ void NDVerifier::RegisterOptions() {
 }
 
 void NDVerifier::LoadDataInternal() {
-    typed_relation_ =
-            model::ColumnLayoutTypedRelationData::CreateFrom(*input_table_, is_null_equal_null_);
+    typed_relation_ = model::LoadTypedRelation(*input_table_, is_null_equal_null_);
     input_table_->Reset();
     if (typed_relation_->GetColumnData().empty()) {
         throw std::runtime_error("Got an empty dataset: ND verifying is meaningless.");
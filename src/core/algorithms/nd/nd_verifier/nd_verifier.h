@@ -30,7 +30,7 @@ private:
     model::WeightType weight_;
     config::EqNullsType is_null_equal_null_;
 
-    std::shared_ptr<model::ColumnLayoutTypedRelationData> typed_relation_;
+    std::shared_ptr<model::ColumnLayoutTypedRelationData const> typed_relation_;
 
     util::StatsCalculator stats_calculator_;
 
@@ -1,11 +1,16 @@
 #include "core/algorithms/od/fastod/fastod.h"
 
+#include <algorithm>
+#include <atomic>
+#include <iterator>
 #include <memory>
 
 #include <boost/unordered/unordered_map.hpp>
 
 #include "core/config/error/option.h"
+#include "core/config/mem_limit/option.h"
 #include "core/config/tabular_data/input_table/option.h"
+#include "core/config/thread_number/option.h"
 #include "core/config/time_limit/option.h"
 #include "core/util/logger.h"
 #include "core/util/timed_invoke.h"
@@ -16,8 +21,9 @@ Fastod::Fastod() : Algorithm() {
     PrepareOptions();
 }
 
-bool Fastod::IsTimeUp() const {
-    return time_limit_seconds_ > 0 && timer_.GetElapsedSeconds() >= time_limit_seconds_;
+bool Fastod::ShouldFinishEarly() const {
+    return (time_limit_seconds_ > 0 && timer_.GetElapsedSeconds() >= time_limit_seconds_) ||
+           ShouldStop();
 }
 
 void Fastod::CCPut(AttributeSet const& key, AttributeSet attribute_set) {
@@ -28,6 +34,12 @@ fastod::AttributeSet const& Fastod::CCGet(AttributeSet const& key) {
     return cc_[key];
 }
 
+fastod::AttributeSet const& Fastod::CCFind(AttributeSet const& key) const {
+    static AttributeSet const kEmptySet;
+    auto it = cc_.find(key);
+    return it == cc_.end() ? kEmptySet : it->second;
+}
+
 void Fastod::PrepareOptions() {
     RegisterOptions();
     MakeLoadOptionsAvailable();
@@ -37,6 +49,8 @@ void Fastod::RegisterOptions() {
     RegisterOption(config::kTableOpt(&input_table_));
     RegisterOption(config::kTimeLimitSecondsOpt(&time_limit_seconds_));
     RegisterOption(config::kErrorOpt(&error_));
+    RegisterOption(config::kThreadNumberOpt(&threads_));
+    RegisterOption(config::kMemLimitMbOpt(&memory_limit_mb_));
 }
 
 void Fastod::MakeLoadOptionsAvailable() {
@@ -44,7 +58,8 @@ void Fastod::MakeLoadOptionsAvailable() {
 }
 
 void Fastod::MakeExecuteOptsAvailable() {
-    MakeOptionsAvailable({config::kTimeLimitSecondsOpt.GetName(), config::kErrorOpt.GetName()});
+    MakeOptionsAvailable({config::kTimeLimitSecondsOpt.GetName(), config::kErrorOpt.GetName(),
+                          config::kThreadNumberOpt.GetName(), config::kMemLimitMbOpt.GetName()});
 }
 
 void Fastod::LoadDataInternal() {
@@ -52,7 +67,7 @@ void Fastod::LoadDataInternal() {
 }
 
 void Fastod::ResetState() {
-    is_complete_ = false;
+    is_complete_ = true;
     level_ = 1;
 
     result_asc_.clear();
@@ -65,6 +80,7 @@ void Fastod::ResetState() {
 
     timer_ = Timer();
     partition_cache_.Clear();
+    partition_cache_.SetMemoryLimit(size_t{memory_limit_mb_} << 20);
 }
 
 unsigned long long Fastod::ExecuteInternal() {
@@ -113,76 +129,109 @@ std::vector<fastod::SimpleCanonicalOD> const& Fastod::GetSimpleDependencies() co
 void Fastod::Initialize() {
     timer_.Start();
 
-    schema_ = AttributeSet(data_.GetColumnCount(), (1 << data_.GetColumnCount()) - 1);
-
     AttributeSet empty_set(data_.GetColumnCount());
-    CCPut(std::move(empty_set), schema_);
+    schema_ = empty_set;
+
+    for (model::ColumnIndex i = 0; i < data_.GetColumnCount(); ++i) {
+        schema_.Set(i);
+        context_in_current_level_.insert(fastod::AddAttribute(empty_set, i));
+    }
 
-    for (model::ColumnIndex i = 0; i < data_.GetColumnCount(); ++i)
-        context_in_current_level_.emplace(data_.GetColumnCount(), 1 << i);
+    CCPut(std::move(empty_set), schema_);
 }
 
-void Fastod::ComputeODs() {
-    Timer timer(true);
-    std::vector<std::vector<AttributeSet>> deleted_attrs(context_in_current_level_.size());
-    size_t context_ind = 0;
+void Fastod::ForEachContext(size_t context_count, std::function<void(size_t)> const& process) {
+    if (pool_.has_value()) {
+        pool_->ExecIndex(process, context_count);
+    } else {
+        for (size_t i = 0; i < context_count; ++i) {
+            process(i);
+        }
+    }
+}
 
-    for (AttributeSet const& context : context_in_current_level_) {
-        auto& del_attrs = deleted_attrs[context_ind++];
-        del_attrs.reserve(data_.GetColumnCount());
+Fastod::ContextResult Fastod::ProcessContext(AttributeSet const& context) {
+    ContextResult result;
+    std::vector<AttributeSet> del_attrs;
+    del_attrs.reserve(data_.GetColumnCount());
 
-        for (model::ColumnIndex column = 0; column < data_.GetColumnCount(); ++column) {
-            del_attrs.push_back(fastod::DeleteAttribute(context, column));
-        }
+    for (model::ColumnIndex column = 0; column < data_.GetColumnCount(); ++column) {
+        del_attrs.push_back(fastod::DeleteAttribute(context, column));
+    }
 
-        if (IsTimeUp()) {
-            is_complete_ = false;
-            return;
-        }
+    AttributeSet cc = schema_;
 
-        AttributeSet context_cc = schema_;
+    context.Iterate([this, &cc, &del_attrs](model::ColumnIndex attr) {
+        cc = fastod::Intersect(cc, CCFind(del_attrs[attr]));
+    });
 
-        context.Iterate([this, &context_cc, &del_attrs](model::ColumnIndex attr) {
-            context_cc = fastod::Intersect(context_cc, CCGet(del_attrs[attr]));
-        });
+    AddCandidates<od::Ordering::kDescending>(context, del_attrs, result.cs_desc);
+    AddCandidates<od::Ordering::kAscending>(context, del_attrs, result.cs_asc);
 
-        CCPut(context, context_cc);
+    AttributeSet context_intersect_cc_context = fastod::Intersect(context, cc);
 
-        AddCandidates<od::Ordering::kDescending>(context, del_attrs);
-        AddCandidates<od::Ordering::kAscending>(context, del_attrs);
-    }
+    context_intersect_cc_context.Iterate([this, &context, &del_attrs, &cc,
+                                          &result](model::ColumnIndex attr) {
+        SimpleCanonicalOD od(del_attrs[attr], attr);
 
-    size_t delete_index = 0;
+        if (od.IsValid(data_, partition_cache_, error_)) {
+            result.simple.push_back(std::move(od));
+            cc = fastod::DeleteAttribute(cc, attr);
 
-    for (AttributeSet const& context : context_in_current_level_) {
-        auto const& del_attrs = deleted_attrs[delete_index++];
+            AttributeSet const diff = fastod::Difference(schema_, context);
 
-        if (IsTimeUp()) {
-            is_complete_ = false;
-            return;
+            if (diff.Any()) {
+                cc = cc & (~diff);
+            }
         }
+    });
 
-        AttributeSet const& cc = CCGet(context);
-        AttributeSet context_intersect_cc_context = fastod::Intersect(context, cc);
+    result.cc = std::move(cc);
 
-        context_intersect_cc_context.Iterate(
-                [this, &context, &del_attrs, &cc](model::ColumnIndex attr) {
-                    SimpleCanonicalOD od(del_attrs[attr], attr);
+    CalculateODs<od::Ordering::kDescending>(del_attrs, result.cs_desc, result.desc);
+    CalculateODs<od::Ordering::kAscending>(del_attrs, result.cs_asc, result.asc);
 
-                    if (od.IsValid(data_, partition_cache_, error_)) {
-                        AddToResult(std::move(od));
-                        CCPut(context, fastod::DeleteAttribute(cc, attr));
+    result.is_processed = true;
+    return result;
+}
 
-                        AttributeSet const diff = fastod::Difference(schema_, context);
+void Fastod::MergeContextResult(AttributeSet const& context, ContextResult&& result) {
+    CCPut(context, std::move(result.cc));
+    CSGet<od::Ordering::kAscending>(context) = std::move(result.cs_asc);
+    CSGet<od::Ordering::kDescending>(context) = std::move(result.cs_desc);
 
-                        if (diff.Any()) {
-                            CCPut(context, cc & (~diff));
-                        }
-                    }
-                });
+    std::ranges::move(result.simple, std::back_inserter(result_simple_));
+    std::ranges::move(result.desc, std::back_inserter(result_desc_));
+    std::ranges::move(result.asc, std::back_inserter(result_asc_));
+}
 
-        CalculateODs<od::Ordering::kDescending>(context, del_attrs);
-        CalculateODs<od::Ordering::kAscending>(context, del_attrs);
+void Fastod::ComputeODs() {
+    /* A context only reads the state of the previous level, so the contexts of a level are
+     * processed concurrently. Results are merged in the order of the contexts, which makes the
+     * output independent of the number of threads.
+     */
+    std::vector<AttributeSet> const contexts(context_in_current_level_.begin(),
+                                             context_in_current_level_.end());
+    std::vector<ContextResult> results(contexts.size());
+    std::atomic<bool> should_finish = false;
+
+    ForEachContext(contexts.size(), [this, &contexts, &results, &should_finish](size_t i) {
+        if (should_finish.load(std::memory_order_relaxed)) {
+            return;
+        }
+        if (ShouldFinishEarly()) {
+            should_finish.store(true, std::memory_order_relaxed);
+            return;
+        }
+        results[i] = ProcessContext(contexts[i]);
+    });
+
+    for (size_t i = 0; i < contexts.size(); ++i) {
+        if (!results[i].is_processed) {
+            is_complete_ = false;
+            return;
+        }
+        MergeContextResult(contexts[i], std::move(results[i]));
     }
 }
 
@@ -214,7 +263,7 @@ void Fastod::CalculateNextLevel() {
     }
 
     for (auto const& [prefix, single_attributes] : prefix_blocks) {
-        if (IsTimeUp()) {
+        if (ShouldFinishEarly()) {
             is_complete_ = false;
             return;
         }
@@ -251,17 +300,25 @@ void Fastod::CalculateNextLevel() {
 void Fastod::Discover() {
     Initialize();
 
+    if (threads_ > 1) {
+        pool_.emplace(threads_);
+    }
+
     while (!context_in_current_level_.empty()) {
         ComputeODs();
+        OnLevelComputed();
 
-        if (IsTimeUp()) {
+        if (ShouldFinishEarly()) {
+            is_complete_ = false;
             break;
         }
 
         PruneLevels();
         CalculateNextLevel();
 
-        if (IsTimeUp()) {
+        // Stopping after the last level has been computed still leaves the result complete
+        if (!context_in_current_level_.empty() && ShouldFinishEarly()) {
+            is_complete_ = false;
             break;
         }
 
@@ -269,11 +326,12 @@ void Fastod::Discover() {
     }
 
     timer_.Stop();
+    pool_.reset();
 
     if (IsComplete()) {
         LOG_DEBUG("FastOD finished successfully");
     } else {
-        LOG_DEBUG("FastOD finished with a time-out");
+        LOG_DEBUG("FastOD finished early");
     }
 
     PrintStatistics();
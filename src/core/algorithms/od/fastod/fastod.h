@@ -1,7 +1,8 @@
 #pragma once
 
-#include <initializer_list>
+#include <functional>
 #include <memory>
+#include <optional>
 #include <string>
 #include <unordered_map>
 #include <unordered_set>
@@ -14,8 +15,11 @@
 #include "core/algorithms/od/fastod/storage/partition_cache.h"
 #include "core/algorithms/od/fastod/util/timer.h"
 #include "core/config/error/type.h"
+#include "core/config/mem_limit/type.h"
 #include "core/config/tabular_data/input_table_type.h"
+#include "core/config/thread_number/type.h"
 #include "core/config/time_limit/type.h"
+#include "core/util/worker_thread_pool.h"
 
 namespace algos {
 
@@ -50,6 +54,9 @@ private:
     DataFrame data_;
     config::InputTable input_table_;
     config::ErrorType error_;
+    config::ThreadNumType threads_ = 1;
+    config::MemLimitMBType memory_limit_mb_;
+    std::optional<util::WorkerThreadPool> pool_;
 
     void MakeExecuteOptsAvailable() override;
     void LoadDataInternal() override;
@@ -60,7 +67,7 @@ private:
     void RegisterOptions();
     void MakeLoadOptionsAvailable();
 
-    bool IsTimeUp() const;
+    bool ShouldFinishEarly() const;
 
     void Initialize();
     void ComputeODs();
@@ -68,32 +75,34 @@ private:
     void CalculateNextLevel();
     void Discover();
 
+    using Candidates = std::unordered_set<AttributePair>;
+
+    /* Everything computed for one context of a level. Contexts of a level are processed
+     * independently and their results are merged into the shared state afterwards.
+     */
+    struct ContextResult {
+        AttributeSet cc;
+        Candidates cs_asc;
+        Candidates cs_desc;
+        std::vector<AscCanonicalOD> asc;
+        std::vector<DescCanonicalOD> desc;
+        std::vector<SimpleCanonicalOD> simple;
+        bool is_processed = false;
+    };
+
+    void ForEachContext(size_t context_count, std::function<void(size_t)> const& process);
+    ContextResult ProcessContext(AttributeSet const& context);
+    void MergeContextResult(AttributeSet const& context, ContextResult&& result);
+
     void CCPut(AttributeSet const& key, AttributeSet attribute_set);
     AttributeSet const& CCGet(AttributeSet const& key);
+    AttributeSet const& CCFind(AttributeSet const& key) const;
 
     template <od::Ordering Ordering>
     [[nodiscard]] static consteval bool IsAscending() {
         return Ordering == od::Ordering::kAscending;
     }
 
-    template <od::Ordering Ordering>
-    void CSPut(AttributeSet const& key, AttributePair const& value) {
-        if constexpr (IsAscending<Ordering>()) {
-            cs_asc_[key].emplace(value);
-        } else {
-            cs_desc_[key].emplace(value);
-        }
-    }
-
-    template <od::Ordering Ordering>
-    void CSPut(AttributeSet const& key, AttributePair&& value) {
-        if constexpr (IsAscending<Ordering>()) {
-            cs_asc_[key].emplace(std::move(value));
-        } else {
-            cs_desc_[key].emplace(std::move(value));
-        }
-    }
-
     template <od::Ordering Ordering>
     std::unordered_set<AttributePair>& CSGet(AttributeSet const& key) {
         if constexpr (IsAscending<Ordering>()) {
@@ -103,35 +112,27 @@ private:
         }
     }
 
+    /* Unlike CSGet, never inserts, so it can be called concurrently */
     template <od::Ordering Ordering>
-    void AddToResult(fastod::CanonicalOD<Ordering>&& od) {
-        if constexpr (IsAscending<Ordering>()) {
-            result_asc_.emplace_back(std::move(od));
-        } else {
-            result_desc_.emplace_back(std::move(od));
-        }
-    }
-
-    void AddToResult(SimpleCanonicalOD&& od) {
-        result_simple_.emplace_back(std::move(od));
+    Candidates const& CSFind(AttributeSet const& key) const {
+        static Candidates const kNoCandidates;
+        auto const& cs = IsAscending<Ordering>() ? cs_asc_ : cs_desc_;
+        auto it = cs.find(key);
+        return it == cs.end() ? kNoCandidates : it->second;
     }
 
     template <od::Ordering Ordering>
-    void AddCandidates(AttributeSet const& context,
-                       std::vector<AttributeSet> const& deleted_attrs) {
+    void AddCandidates(AttributeSet const& context, std::vector<AttributeSet> const& deleted_attrs,
+                       Candidates& context_cs) const {
         if (level_ == 2) {
-            for (model::ColumnIndex i = 0; i < data_.GetColumnCount(); i++) {
-                for (model::ColumnIndex j = 0; j < data_.GetColumnCount(); j++) {
-                    if (i == j) continue;
-                    CSPut<Ordering>(fastod::CreateAttributeSet(
-                                            std::initializer_list<model::ColumnIndex>{i, j},
-                                            data_.GetColumnCount()),
-                                    AttributePair(i, j));
-                }
-            }
+            context.Iterate([&context, &context_cs](model::ColumnIndex i) {
+                context.Iterate([i, &context_cs](model::ColumnIndex j) {
+                    if (i != j) context_cs.emplace(i, j);
+                });
+            });
         } else if (level_ > 2) {
-            context.Iterate([this, &deleted_attrs, &context](model::ColumnIndex attr) {
-                auto const& candidates = CSGet<Ordering>(deleted_attrs[attr]);
+            context.Iterate([this, &deleted_attrs, &context_cs](model::ColumnIndex attr) {
+                auto const& candidates = CSFind<Ordering>(deleted_attrs[attr]);
 
                 for (AttributePair const& attribute_pair : candidates) {
                     AttributeSet const context_delete_ab = fastod::DeleteAttribute(
@@ -141,8 +142,7 @@ private:
 
                     context_delete_ab.Iterate([this, &deleted_attrs, &attribute_pair,
                                                &add_context](model::ColumnIndex attr) {
-                        std::unordered_set<AttributePair> const& cs =
-                                CSGet<Ordering>(deleted_attrs[attr]);
+                        Candidates const& cs = CSFind<Ordering>(deleted_attrs[attr]);
 
                         if (cs.find(attribute_pair) == cs.end()) {
                             add_context = false;
@@ -151,7 +151,7 @@ private:
                     });
 
                     if (add_context) {
-                        CSPut<Ordering>(context, attribute_pair);
+                        context_cs.emplace(attribute_pair);
                     }
                 }
             });
@@ -159,30 +159,33 @@ private:
     }
 
     template <od::Ordering Ordering>
-    void CalculateODs(AttributeSet const& context, std::vector<AttributeSet> const& deleted_attrs) {
-        auto& cs_for_con = CSGet<Ordering>(context);
-
-        for (auto it = cs_for_con.begin(); it != cs_for_con.end();) {
+    void CalculateODs(std::vector<AttributeSet> const& deleted_attrs, Candidates& context_cs,
+                      std::vector<fastod::CanonicalOD<Ordering>>& result) {
+        for (auto it = context_cs.begin(); it != context_cs.end();) {
             model::ColumnIndex a = it->left;
             model::ColumnIndex b = it->right;
 
-            if (ContainsAttribute(CCGet(deleted_attrs[b]), a) &&
-                ContainsAttribute(CCGet(deleted_attrs[a]), b)) {
+            if (ContainsAttribute(CCFind(deleted_attrs[b]), a) &&
+                ContainsAttribute(CCFind(deleted_attrs[a]), b)) {
                 fastod::CanonicalOD<Ordering> od(fastod::DeleteAttribute(deleted_attrs[a], b), a,
                                                  b);
 
                 if (od.IsValid(data_, partition_cache_, error_)) {
-                    AddToResult(std::move(od));
-                    cs_for_con.erase(it++);
+                    result.emplace_back(std::move(od));
+                    context_cs.erase(it++);
                 } else {
                     ++it;
                 }
             } else {
-                cs_for_con.erase(it++);
+                context_cs.erase(it++);
             }
         }
     }
 
+protected:
+    // Called after the ODs of every level have been computed, before the next level is built
+    virtual void OnLevelComputed() {}
+
 public:
     Fastod();
 
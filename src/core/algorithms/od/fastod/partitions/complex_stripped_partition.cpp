@@ -53,6 +53,13 @@ bool ComplexStrippedPartition::ShouldBeConvertedToStrippedPartition() const {
     return should_be_converted_to_sp_;
 }
 
+size_t ComplexStrippedPartition::GetMemoryUsage() const noexcept {
+    return sizeof(ComplexStrippedPartition) + sp_indexes_.capacity() * sizeof(size_t) +
+           sp_begins_.capacity() * sizeof(size_t) +
+           rb_indexes_.capacity() * sizeof(DataFrame::Range) +
+           rb_begins_.capacity() * sizeof(size_t);
+}
+
 void ComplexStrippedPartition::ToStrippedPartition() {
     assert(sp_begins_.empty());
     assert(sp_indexes_.empty());
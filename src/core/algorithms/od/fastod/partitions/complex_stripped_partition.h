@@ -68,6 +68,9 @@ public:
     bool ShouldBeConvertedToStrippedPartition() const;
     void ToStrippedPartition();
 
+    /* Approximate number of bytes held by the partition */
+    size_t GetMemoryUsage() const noexcept;
+
     template <od::Ordering Ordering>
     bool Swap(model::ColumnIndex left, model::ColumnIndex right) const;
     template <od::Ordering Ordering>
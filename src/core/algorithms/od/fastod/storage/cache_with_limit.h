@@ -1,47 +1,139 @@
 #pragma once
 
 #include <cstddef>
-#include <queue>
+#include <list>
+#include <memory>
+#include <mutex>
 #include <unordered_map>
 
 namespace algos::fastod {
 
+/* Thread-safe cache bounded by the total size of its values in bytes.
+ * Eviction is a segmented LRU: new entries go to the probation segment and are moved to the
+ * protected segment when they are requested again. Entries are evicted from the tail of the
+ * probation segment first, so values that are computed once and never reused do not push out
+ * the ones that are. Values are handed out as shared pointers, so an evicted value stays alive
+ * while someone still uses it.
+ */
 template <typename K, typename V>
 class CacheWithLimit {
+public:
+    using ValuePtr = std::shared_ptr<V const>;
+
 private:
-    std::unordered_map<K, V> entries_;
-    std::queue<K> keys_in_order_;
-    size_t const max_size_;
+    using Segment = std::list<K>;
+
+    struct Entry {
+        ValuePtr value;
+        size_t bytes;
+        bool is_protected;
+        typename Segment::iterator position;
+    };
+
+    static constexpr size_t kProtectedSharePercent = 80;
+
+    std::unordered_map<K, Entry> entries_;
+    /* Most recently used keys are at the front */
+    Segment probation_;
+    Segment protected_;
+    size_t max_bytes_;
+    size_t used_bytes_ = 0;
+    size_t protected_bytes_ = 0;
+    mutable std::mutex mutex_;
+
+    void Promote(Entry& entry) {
+        if (entry.is_protected) {
+            protected_.splice(protected_.begin(), protected_, entry.position);
+            return;
+        }
+
+        protected_.splice(protected_.begin(), probation_, entry.position);
+        entry.is_protected = true;
+        protected_bytes_ += entry.bytes;
+
+        size_t const max_protected_bytes = max_bytes_ / 100 * kProtectedSharePercent;
+        while (protected_bytes_ > max_protected_bytes && protected_.size() > 1) {
+            Entry& demoted = entries_.at(protected_.back());
+            probation_.splice(probation_.begin(), protected_, demoted.position);
+            demoted.is_protected = false;
+            protected_bytes_ -= demoted.bytes;
+        }
+    }
+
+    void EvictOne() {
+        Segment& segment = probation_.empty() ? protected_ : probation_;
+        auto it = entries_.find(segment.back());
+        used_bytes_ -= it->second.bytes;
+        if (it->second.is_protected) {
+            protected_bytes_ -= it->second.bytes;
+        }
+        segment.pop_back();
+        entries_.erase(it);
+    }
+
+    void Shrink(size_t max_bytes) {
+        while (used_bytes_ > max_bytes && !entries_.empty()) {
+            EvictOne();
+        }
+    }
 
 public:
-    explicit CacheWithLimit(size_t max_size) : max_size_(max_size) {};
+    explicit CacheWithLimit(size_t max_bytes) : max_bytes_(max_bytes) {};
 
     void Clear() {
+        std::lock_guard lock(mutex_);
         entries_.clear();
-        keys_in_order_ = {};
+        probation_.clear();
+        protected_.clear();
+        used_bytes_ = 0;
+        protected_bytes_ = 0;
     }
 
-    bool Contains(K const& key) const noexcept {
-        return entries_.find(key) != entries_.end();
+    void SetMaxBytes(size_t max_bytes) {
+        std::lock_guard lock(mutex_);
+        max_bytes_ = max_bytes;
+        Shrink(max_bytes_);
     }
 
-    V const& Get(K const& key) const {
-        return entries_.at(key);
+    size_t GetUsedBytes() const {
+        std::lock_guard lock(mutex_);
+        return used_bytes_;
     }
 
-    V const& GetOrInsert(K const& key, V const& value) {
-        auto [it, inserted] = entries_.try_emplace(key, value);
-        if (!inserted) {
-            return it->second;
+    bool Contains(K const& key) const {
+        std::lock_guard lock(mutex_);
+        return entries_.find(key) != entries_.end();
+    }
+
+    /* Returns nullptr if there is no value for the key. A found entry counts as reused. */
+    ValuePtr Find(K const& key) {
+        std::lock_guard lock(mutex_);
+        auto it = entries_.find(key);
+        if (it == entries_.end()) {
+            return nullptr;
         }
+        Promote(it->second);
+        return it->second.value;
+    }
 
-        if (keys_in_order_.size() >= max_size_) {
-            entries_.erase(keys_in_order_.front());
-            keys_in_order_.pop();
+    /* If another value was inserted for the key in the meantime, that value is returned.
+     * A value that is larger than the whole budget is returned without being cached.
+     */
+    ValuePtr GetOrInsert(K const& key, ValuePtr value, size_t bytes) {
+        std::lock_guard lock(mutex_);
+        auto it = entries_.find(key);
+        if (it != entries_.end()) {
+            return it->second.value;
+        }
+        if (bytes > max_bytes_) {
+            return value;
         }
 
-        keys_in_order_.push(key);
-        return it->second;
+        Shrink(max_bytes_ - bytes);
+        probation_.push_front(key);
+        entries_.emplace(key, Entry{value, bytes, false, probation_.begin()});
+        used_bytes_ += bytes;
+        return value;
     }
 };
 
@@ -8,9 +8,15 @@
 
 namespace algos::fastod {
 
+/* Safe to use from several threads at once */
 class PartitionCache {
+public:
+    using PartitionPtr = std::shared_ptr<ComplexStrippedPartition const>;
+
+    static constexpr size_t kDefaultMemoryLimit = size_t{2} << 30;
+
 private:
-    CacheWithLimit<AttributeSet, ComplexStrippedPartition> cache_{static_cast<size_t>(1e8)};
+    CacheWithLimit<AttributeSet, ComplexStrippedPartition> cache_{kDefaultMemoryLimit};
 
     void CallProductWithAttribute(ComplexStrippedPartition& partition, size_t attribute) {
         partition.Product(attribute);
@@ -22,20 +28,27 @@ private:
 
     bool CallProductWithAttributesInCache(ComplexStrippedPartition& result,
                                           AttributeSet const& attribute_set) {
-        bool is_product_called = false;
-
-        attribute_set.Iterate(
-                [this, &attribute_set, &result, &is_product_called](model::ColumnIndex attr) {
-                    AttributeSet one_less = DeleteAttribute(attribute_set, attr);
-
-                    if (one_less.Any() && cache_.Contains(one_less)) {
-                        result = cache_.Get(one_less);
-                        CallProductWithAttribute(result, attr);
-                        is_product_called = true;
-                    }
-                });
+        PartitionPtr base;
+        model::ColumnIndex base_attr = 0;
+
+        attribute_set.Iterate([this, &attribute_set, &base, &base_attr](model::ColumnIndex attr) {
+            AttributeSet one_less = DeleteAttribute(attribute_set, attr);
+
+            if (one_less.Any()) {
+                if (PartitionPtr partition = cache_.Find(one_less)) {
+                    base = std::move(partition);
+                    base_attr = attr;
+                }
+            }
+        });
+
+        if (!base) {
+            return false;
+        }
 
-        return is_product_called;
+        result = *base;
+        CallProductWithAttribute(result, base_attr);
+        return true;
     }
 
 public:
@@ -43,10 +56,17 @@ public:
         cache_.Clear();
     }
 
-    ComplexStrippedPartition const& GetStrippedPartition(AttributeSet const& attribute_set,
-                                                         DataFrame const& data) {
-        if (cache_.Contains(attribute_set)) {
-            return cache_.Get(attribute_set);
+    void SetMemoryLimit(size_t bytes) {
+        cache_.SetMaxBytes(bytes);
+    }
+
+    size_t GetMemoryUsage() const {
+        return cache_.GetUsedBytes();
+    }
+
+    PartitionPtr GetStrippedPartition(AttributeSet const& attribute_set, DataFrame const& data) {
+        if (PartitionPtr partition = cache_.Find(attribute_set)) {
+            return partition;
         }
 
         ComplexStrippedPartition result_partition;
@@ -64,7 +84,11 @@ public:
             });
         }
 
-        return cache_.GetOrInsert(attribute_set, result_partition);
+        size_t const bytes = result_partition.GetMemoryUsage();
+        return cache_.GetOrInsert(
+                attribute_set,
+                std::make_shared<ComplexStrippedPartition const>(std::move(result_partition)),
+                bytes);
     }
 };
 
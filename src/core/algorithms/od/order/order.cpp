@@ -10,6 +10,7 @@
 #include "core/algorithms/od/order/order_utility.h"
 #include "core/config/names_and_descriptions.h"
 #include "core/config/tabular_data/input_table/option.h"
+#include "core/model/table/dataset.h"
 #include "core/model/table/tuple_index.h"
 #include "core/model/types/types.h"
 #include "core/util/logger.h"
@@ -30,7 +31,7 @@ void Order::RegisterOptions() {
 }
 
 void Order::LoadDataInternal() {
-    typed_relation_ = model::ColumnLayoutTypedRelationData::CreateFrom(*input_table_, false);
+    typed_relation_ = model::LoadTypedRelation(*input_table_, false);
 }
 
 void Order::ResetState() {}
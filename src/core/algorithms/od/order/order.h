@@ -20,7 +20,7 @@ public:
     using TypedRelation = model::ColumnLayoutTypedRelationData;
 
     config::InputTable input_table_;
-    std::unique_ptr<TypedRelation> typed_relation_;
+    std::shared_ptr<TypedRelation const> typed_relation_;
     SortedPartitions sorted_partitions_;
     std::vector<AttributeList> single_attributes_;
     CandidateSets previous_candidate_sets_;
@@ -10,7 +10,9 @@
 #include <boost/thread.hpp>
 
 #include "core/config/equal_nulls/option.h"
+#include "core/config/names.h"
 #include "core/config/tabular_data/input_table/option.h"
+#include "core/config/tabular_data/load_columns/option.h"
 #include "core/config/thread_number/option.h"
 
 namespace algos {
@@ -24,7 +26,12 @@ DataStats::DataStats() : Algorithm() {
 }
 
 void DataStats::RegisterOptions() {
-    RegisterOption(config::kTableOpt(&input_table_));
+    using config::names::kLoadColumns;
+
+    auto get_table_cols = [this]() { return input_table_->GetNumberOfColumns(); };
+
+    RegisterOption(config::kTableOpt(&input_table_).SetConditionalOpts({{{}, {kLoadColumns}}}));
+    RegisterOption(config::kLoadColumnsOpt(&load_columns_, std::move(get_table_cols)));
     RegisterOption(config::kEqualNullsOpt(&is_null_equal_null_));
     RegisterOption(config::kThreadNumberOpt(&threads_num_));
 }
@@ -1230,6 +1237,11 @@ size_t DataStats::GetNumberOfColumns() const {
     return col_data_.size();
 }
 
+std::vector<size_t> DataStats::GetLoadedColumns() const {
+    std::vector<model::ColumnIndex> const loaded_columns = projection_.GetLoadedColumns();
+    return {loaded_columns.begin(), loaded_columns.end()};
+}
+
 ColumnStats const& DataStats::GetAllStats(size_t index) const {
     return all_stats_[index];
 }
@@ -1244,15 +1256,17 @@ std::vector<model::TypedColumnData> const& DataStats::GetData() const noexcept {
 
 std::string DataStats::ToString() const {
     std::stringstream res;
+    std::vector<size_t> const loaded_columns = GetLoadedColumns();
     for (size_t i = 0; i < GetNumberOfColumns(); ++i) {
-        res << "Column num = " << i << '\n';
+        res << "Column num = " << loaded_columns[i] << '\n';
         res << all_stats_[i].ToString() << '\n';
     }
     return res.str();
 }
 
 void DataStats::LoadDataInternal() {
-    col_data_ = mo::CreateTypedColumnData(*input_table_, is_null_equal_null_);
+    projection_ = mo::ColumnProjection(*input_table_, load_columns_);
+    col_data_ = mo::CreateTypedColumnData(*projection_.Apply(input_table_), is_null_equal_null_);
     all_stats_ = std::vector<ColumnStats>{col_data_.size()};
 }
 
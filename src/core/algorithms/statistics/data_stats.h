@@ -5,15 +5,19 @@
 #include "core/algorithms/fd/fd_algorithm.h"
 #include "core/algorithms/statistics/statistic.h"
 #include "core/config/equal_nulls/type.h"
+#include "core/config/indices/type.h"
 #include "core/config/tabular_data/input_table_type.h"
 #include "core/config/thread_number/type.h"
 #include "core/model/table/column_layout_typed_relation_data.h"
+#include "core/model/table/column_projection.h"
 
 namespace algos {
 
 class DataStats : public Algorithm {
     config::EqNullsType is_null_equal_null_;
     config::ThreadNumType threads_num_;
+    config::IndicesType load_columns_;
+    model::ColumnProjection projection_;
 
     std::vector<model::TypedColumnData> col_data_;
     std::vector<ColumnStats> all_stats_;
@@ -76,142 +80,148 @@ protected:
     unsigned long long ExecuteInternal() final;
 
 public:
+    // Columns are numbered by loaded index: the position of the column in GetLoadedColumns().
+    // Without load_columns it is the index in the table. Unlike the verifiers, DataStats keeps no
+    // data for skipped columns, so only ToString reports table indices.
     DataStats();
 
     std::vector<model::TypedColumnData> const& GetData() const noexcept;
 
     // Returns number of non-NULL and nonempty values in the column.
-    size_t NumberOfValues(size_t index) const;
-    // Returns number of columns in table.
+    size_t NumberOfValues(size_t loaded_index) const;
+    // Returns number of loaded columns.
     size_t GetNumberOfColumns() const;
-    // Returns columns which contain a null value.
+    // Returns indices in the original table of the loaded columns.
+    std::vector<size_t> GetLoadedColumns() const;
+    // Returns loaded indices of columns which contain a null value.
     std::vector<size_t> GetColumnsWithNull() const;
-    // Returns columns with only null values.
+    // Returns loaded indices of columns with only null values.
     std::vector<size_t> GetNullColumns() const;
-    // Returns columns with only unique values.
+    // Returns loaded indices of columns with only unique values.
     std::vector<size_t> GetColumnsWithUniqueValues();
     // Returns number of unique values in the column.
-    size_t Distinct(size_t index);
+    size_t Distinct(size_t loaded_index);
     // Check if quantity <= count of unique values in the column.
-    bool IsCategorical(size_t index, size_t quantity);
-    // Returns table slice from start_row to end_row and from start_col to end_col.
-    // Data values converted to string type.
+    bool IsCategorical(size_t loaded_index, size_t quantity);
+    // Returns table slice from start_row to end_row and from start_col to end_col, which are
+    // loaded indices. Data values converted to string type.
     std::vector<std::vector<std::string>> ShowSample(size_t start_row, size_t end_row,
                                                      size_t start_col, size_t end_col) const;
     // Returns average value in the column if it's numeric.
-    Statistic GetAvg(size_t index) const;
+    Statistic GetAvg(size_t loaded_index) const;
     // Returns corrected standard deviation of the column if it's numeric.
-    Statistic GetCorrectedSTD(size_t index) const;
+    Statistic GetCorrectedSTD(size_t loaded_index) const;
     // Returns skewness of the column if it's numeric.
-    Statistic GetSkewness(size_t index) const;
+    Statistic GetSkewness(size_t loaded_index) const;
     // Returns kurtosis of the column if it's numeric.
-    Statistic GetKurtosis(size_t index) const;
+    Statistic GetKurtosis(size_t loaded_index) const;
     // Returns central moment of the column if it's numeric.
-    Statistic GetCentralMomentOfDist(size_t index, int number) const;
+    Statistic GetCentralMomentOfDist(size_t loaded_index, int number) const;
     // Returns standardized moment of the column if it's numeric.
-    Statistic GetStandardizedCentralMomentOfDist(size_t index, int number) const;
+    Statistic GetStandardizedCentralMomentOfDist(size_t loaded_index, int number) const;
     // Returns central moment of the column if it's numeric.
-    Statistic CalculateCentralMoment(size_t index, int number, bool bessel_correction) const;
+    Statistic CalculateCentralMoment(size_t loaded_index, int number, bool bessel_correction) const;
     // Returns minimum (maximumin if order = mo::CompareResult::kGreater) value of the column.
-    Statistic GetMin(size_t index, model::CompareResult order = model::CompareResult::kLess) const;
+    Statistic GetMin(size_t loaded_index,
+                     model::CompareResult order = model::CompareResult::kLess) const;
     // Returns maximumin value of the column.
-    Statistic GetMax(size_t index) const;
+    Statistic GetMax(size_t loaded_index) const;
     // Returns sum of the column's values if it's numeric.
-    Statistic GetSum(size_t index) const;
+    Statistic GetSum(size_t loaded_index) const;
     // Returns quantile of the column if its type is comparable.
-    Statistic GetQuantile(double part, size_t index, bool calc_all = false);
+    Statistic GetQuantile(double part, size_t loaded_index, bool calc_all = false);
     // Deletes null and empty values in the column.
-    std::vector<std::byte const*> DeleteNullAndEmpties(size_t index) const;
+    std::vector<std::byte const*> DeleteNullAndEmpties(size_t loaded_index) const;
     // Returns number of zeros in the column if it's numeric.
-    Statistic GetNumberOfZeros(size_t index) const;
+    Statistic GetNumberOfZeros(size_t loaded_index) const;
     // Returns number of negative numbers in the column if it's numeric.
-    Statistic GetNumberOfNegatives(size_t index) const;
+    Statistic GetNumberOfNegatives(size_t loaded_index) const;
     // Returns sum of numbers' squares in the column if it's numeric.
-    Statistic GetSumOfSquares(size_t index) const;
+    Statistic GetSumOfSquares(size_t loaded_index) const;
     // Returns geometric mean of numbers in the column if it's numeric.
-    Statistic GetGeometricMean(size_t index) const;
+    Statistic GetGeometricMean(size_t loaded_index) const;
     // Returns mean absolute deviation if it's numeric.
-    Statistic GetMeanAD(size_t index) const;
+    Statistic GetMeanAD(size_t loaded_index) const;
     // Returns median of the column if it's numeric.
-    Statistic GetMedian(size_t index) const;
+    Statistic GetMedian(size_t loaded_index) const;
     // Returns meadian absolute deviation in the column if it's numeric.
-    Statistic GetMedianAD(size_t index) const;
+    Statistic GetMedianAD(size_t loaded_index) const;
     // Returns number of nulls in the column.
-    size_t GetNumNulls(size_t index) const;
+    size_t GetNumNulls(size_t loaded_index) const;
     // Returns all distinct symbols of the column as a sorted string.
-    Statistic GetVocab(size_t index) const;
+    Statistic GetVocab(size_t loaded_index) const;
     // Returns number of non-letter chars in a string column.
-    Statistic GetNumberOfNonLetterChars(size_t index) const;
+    Statistic GetNumberOfNonLetterChars(size_t loaded_index) const;
     // Returns number of digit chars in a string column.
-    Statistic GetNumberOfDigitChars(size_t index) const;
+    Statistic GetNumberOfDigitChars(size_t loaded_index) const;
     // Returns number of digit chars in a string column.
-    Statistic GetNumberOfLowercaseChars(size_t index) const;
+    Statistic GetNumberOfLowercaseChars(size_t loaded_index) const;
     // Returns number of digit chars in a string column.
-    Statistic GetNumberOfUppercaseChars(size_t index) const;
+    Statistic GetNumberOfUppercaseChars(size_t loaded_index) const;
     // Returns the minimal amount of chars in a column.
-    Statistic GetMinNumberOfChars(size_t index) const;
+    Statistic GetMinNumberOfChars(size_t loaded_index) const;
     // Returns the maximal amount of chars in a column.
-    Statistic GetMaxNumberOfChars(size_t index) const;
+    Statistic GetMaxNumberOfChars(size_t loaded_index) const;
     // Returns all distinct words of the column as a set of strings.
-    std::set<std::string> GetWords(size_t index) const;
+    std::set<std::string> GetWords(size_t loaded_index) const;
     // Returns the minimal amount of words in a column.
-    Statistic GetMinNumberOfWords(size_t index) const;
+    Statistic GetMinNumberOfWords(size_t loaded_index) const;
     // Returns the maximal amount of words in a column.
-    Statistic GetMaxNumberOfWords(size_t index) const;
+    Statistic GetMaxNumberOfWords(size_t loaded_index) const;
     // Returns the total amount of words in a column.
-    Statistic GetNumberOfWords(size_t index) const;
+    Statistic GetNumberOfWords(size_t loaded_index) const;
     // Returns total number of characters in a string column.
-    Statistic GetNumberOfChars(size_t index) const;
+    Statistic GetNumberOfChars(size_t loaded_index) const;
     // Returns average number of chars in a string column.
-    Statistic GetAvgNumberOfChars(size_t index) const;
+    Statistic GetAvgNumberOfChars(size_t loaded_index) const;
     // Returns top k most frequent chars in a string column as a vector of chars.
-    std::vector<char> GetTopKChars(size_t index, size_t k) const;
+    std::vector<char> GetTopKChars(size_t loaded_index, size_t k) const;
     // Returns top k most frequent words in a string column as a vector of strings.
-    std::vector<std::string> GetTopKWords(size_t index, size_t k) const;
+    std::vector<std::string> GetTopKWords(size_t loaded_index, size_t k) const;
     // Returns the amount of entirely uppercase words in a string column.
-    Statistic GetNumberOfEntirelyUppercaseWords(size_t index) const;
+    Statistic GetNumberOfEntirelyUppercaseWords(size_t loaded_index) const;
     // Returns the amount of entirely lowercase words in a string column.
-    Statistic GetNumberOfEntirelyLowercaseWords(size_t index) const;
+    Statistic GetNumberOfEntirelyLowercaseWords(size_t loaded_index) const;
     // Returns the interquartile range (IQR) for a numeric column.
-    Statistic GetInterquartileRange(size_t index) const;
+    Statistic GetInterquartileRange(size_t loaded_index) const;
     // Returns the coefficient of variation for a numeric column.
-    Statistic GetCoefficientOfVariation(size_t index) const;
+    Statistic GetCoefficientOfVariation(size_t loaded_index) const;
     // Returns a flag of monotonicity for a comparable column.
-    Statistic GetMonotonicity(size_t index) const;
+    Statistic GetMonotonicity(size_t loaded_index) const;
     // Returns the Jarque-Bera test statistic for normality for a numeric column.
-    Statistic GetJarqueBeraStatistic(size_t index) const;
+    Statistic GetJarqueBeraStatistic(size_t loaded_index) const;
     // Returns the entropy value for a column.
-    Statistic GetEntropy(size_t index) const;
+    Statistic GetEntropy(size_t loaded_index) const;
     // Returns the Gini coefficient for a column.
-    Statistic GetGiniCoefficient(size_t index) const;
+    Statistic GetGiniCoefficient(size_t loaded_index) const;
     // Returns the number of rows that consist only of whitespace characters (spaces and tabs).
-    Statistic GetWhitespaceOnlyCount(size_t index) const;
+    Statistic GetWhitespaceOnlyCount(size_t loaded_index) const;
     // Returns the number of rows that have leading whitespace characters.
-    Statistic GetNumberOfRowsWithLeadingWhitespace(size_t index) const;
+    Statistic GetNumberOfRowsWithLeadingWhitespace(size_t loaded_index) const;
     // Returns the number of rows that have trailing whitespace characters.
-    Statistic GetNumberOfRowsWithTrailingWhitespace(size_t index) const;
+    Statistic GetNumberOfRowsWithTrailingWhitespace(size_t loaded_index) const;
     // Returns the number of rows that contain special characters.
-    Statistic GetNumberOfRowsWithSpecialChars(size_t index) const;
+    Statistic GetNumberOfRowsWithSpecialChars(size_t loaded_index) const;
     // Returns the most frequent first character.
-    Statistic GetFirstCharFrequency(size_t index) const;
+    Statistic GetFirstCharFrequency(size_t loaded_index) const;
     // Returns the most frequent last character.
-    Statistic GetLastCharFrequency(size_t index) const;
+    Statistic GetLastCharFrequency(size_t loaded_index) const;
     // Returns minimal number of whitespaces in a string column.
-    Statistic GetMinWhiteSpaces(size_t index) const;
+    Statistic GetMinWhiteSpaces(size_t loaded_index) const;
     // Returns maximal number of whitespaces in a string column.
-    Statistic GetMaxWhiteSpaces(size_t index) const;
+    Statistic GetMaxWhiteSpaces(size_t loaded_index) const;
     // Counts boolean values equal to expected.
-    Statistic CountBool(size_t index, bool expected) const;
+    Statistic CountBool(size_t loaded_index, bool expected) const;
     // Returns number of true values in a bool column.
-    Statistic GetTrueCount(size_t index) const;
+    Statistic GetTrueCount(size_t loaded_index) const;
     // Returns number of false values in a bool column.
-    Statistic GetFalseCount(size_t index) const;
+    Statistic GetFalseCount(size_t loaded_index) const;
     // Returns percentage of zero values in a numeric column.
-    Statistic GetZeroPercent(size_t index) const;
+    Statistic GetZeroPercent(size_t loaded_index) const;
     // Returns number of characters with diacritical marks in a string column.
-    Statistic GetNumberOfDiacriticChars(size_t index) const;
+    Statistic GetNumberOfDiacriticChars(size_t loaded_index) const;
 
-    ColumnStats const& GetAllStats(size_t index) const;
+    ColumnStats const& GetAllStats(size_t loaded_index) const;
     std::vector<ColumnStats> const& GetAllStats() const;
     std::string ToString() const;
 };
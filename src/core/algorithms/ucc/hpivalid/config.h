@@ -15,6 +15,9 @@ struct Config {
 
     // whether or not to use the tiebreaker heuristic
     bool tiebreaker_heuristic = true;
+
+    // number of threads the search tree is searched with
+    unsigned threads = 1;
 };
 
 }  // namespace algos::hpiv
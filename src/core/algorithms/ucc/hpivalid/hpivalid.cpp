@@ -9,6 +9,7 @@
 #include "core/algorithms/ucc/hpivalid/config.h"
 #include "core/algorithms/ucc/hpivalid/result_collector.h"
 #include "core/algorithms/ucc/hpivalid/tree_search.h"
+#include "core/model/table/dataset.h"
 #include "core/util/logger.h"
 
 // see algorithms/ucc/hpivalid/LICENSE
@@ -16,7 +17,7 @@
 namespace algos {
 
 void HPIValid::LoadDataInternal() {
-    relation_ = ColumnLayoutRelationData::CreateFrom(*input_table_);
+    relation_ = model::LoadRelation(*input_table_);
 
     if (relation_->GetColumnData().empty()) {
         throw std::runtime_error("Got an empty dataset: UCC mining is meaningless.");
@@ -42,6 +43,7 @@ hpiv::PLITable HPIValid::Preprocess() {
 
 unsigned long long HPIValid::ExecuteInternal() {
     hpiv::Config cfg;
+    cfg.threads = threads_;
     hpiv::ResultCollector rc(3600);
 
     rc.SetStartTime();
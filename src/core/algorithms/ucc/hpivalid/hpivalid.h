@@ -6,6 +6,8 @@
 #include "core/algorithms/ucc/hpivalid/pli_table.h"
 #include "core/algorithms/ucc/hpivalid/result_collector.h"
 #include "core/algorithms/ucc/ucc_algorithm.h"
+#include "core/config/thread_number/option.h"
+#include "core/config/thread_number/type.h"
 #include "core/model/table/column_layout_relation_data.h"
 
 // see algorithms/ucc/hpivalid/LICENSE
@@ -14,7 +16,8 @@ namespace algos {
 
 class HPIValid : public UCCAlgorithm {
 private:
-    std::shared_ptr<ColumnLayoutRelationData> relation_;
+    std::shared_ptr<ColumnLayoutRelationData const> relation_;
+    config::ThreadNumType threads_ = 1;
 
     void LoadDataInternal() override;
     unsigned long long ExecuteInternal() override;
@@ -23,6 +26,15 @@ private:
     void PrintInfo(hpiv::ResultCollector const& rc) const;
 
     void ResetUCCAlgorithmState() override {}
+
+    void MakeExecuteOptsAvailable() final {
+        MakeOptionsAvailable({config::kThreadNumberOpt.GetName()});
+    }
+
+public:
+    HPIValid() : UCCAlgorithm() {
+        RegisterOption(config::kThreadNumberOpt(&threads_));
+    }
 };
 
 }  // namespace algos
@@ -1,5 +1,6 @@
 #include "core/algorithms/ucc/hpivalid/result_collector.h"
 
+#include <algorithm>
 #include <chrono>
 #include <sstream>
 #include <string>
@@ -22,6 +23,26 @@ ResultCollector::ResultCollector(double timeout)
       intersections_(0),
       intersection_cluster_size_(0) {}
 
+ResultCollector ResultCollector::EmptyCopy() const {
+    ResultCollector copy(timeout_);
+    copy.exec_start_ = exec_start_;
+    return copy;
+}
+
+void ResultCollector::Merge(std::vector<ResultCollector> const& parts) {
+    for (ResultCollector const& part : parts) {
+        diff_sets_ += part.diff_sets_;
+        tree_complexity_ += part.tree_complexity_;
+        tree_nodes_ += part.tree_nodes_;
+        intersections_ += part.intersections_;
+        intersection_cluster_size_ += part.intersection_cluster_size_;
+        ucc_vector_.insert(ucc_vector_.end(), part.ucc_vector_.begin(), part.ucc_vector_.end());
+    }
+    std::sort(ucc_vector_.begin(), ucc_vector_.end());
+    ucc_vector_.erase(std::unique(ucc_vector_.begin(), ucc_vector_.end()), ucc_vector_.end());
+    ucc_count_ = ucc_vector_.size();
+}
+
 void ResultCollector::AddUCC(Edge const& ucc) {
     ucc_count_++;
     ucc_vector_.push_back(ucc);
@@ -32,6 +32,15 @@ class ResultCollector {
 public:
     explicit ResultCollector(double timeout);
 
+    // Return a collector with the same timeout and start time, but nothing
+    // collected yet, for a part of the search.
+    ResultCollector EmptyCopy() const;
+
+    // Add what the collectors of the parts of the search collected. The UCCs
+    // are sorted, so that their order does not depend on how the search was
+    // split.
+    void Merge(std::vector<ResultCollector> const& parts);
+
     //////////////////////////////////////////////////////////////////////////////
     // collecting information
 
@@ -1,6 +1,7 @@
 #include "core/algorithms/ucc/hpivalid/tree_search.h"
 
 #include <algorithm>
+#include <atomic>
 #include <cstddef>
 #include <deque>
 #include <limits>
@@ -10,6 +11,9 @@
 #include <utility>
 #include <vector>
 
+#include <boost/asio/post.hpp>
+#include <boost/asio/thread_pool.hpp>
+
 #include "core/algorithms/ucc/hpivalid/config.h"
 #include "core/algorithms/ucc/hpivalid/pli_table.h"
 #include "core/algorithms/ucc/hpivalid/result_collector.h"
@@ -19,13 +23,16 @@
 
 namespace algos::hpiv {
 
+namespace {
+
+// with several threads the search tree is split into more subtrees than there are threads, so
+// that a thread that is done with a small subtree can take another one
+constexpr std::size_t kSubtreesPerThread = 16;
+
+}  // namespace
+
 TreeSearch::TreeSearch(PLITable const& tab, Config const& cfg, ResultCollector& rc)
-    : tab_(tab),
-      cfg_(cfg),
-      rc_(rc),
-      partial_hg_(tab.nr_cols),
-      clusterid_to_recordindices_(tab.nr_rows),
-      gen_(cfg.seed) {
+    : tab_(tab), cfg_(cfg), rc_(rc), partial_hg_(tab.nr_cols), gen_(cfg.seed) {
     // add single edge containing all vertices to partial hypergraph
     partial_hg_.AddEdge(~Edge(partial_hg_.NumVertices()));
 
@@ -36,32 +43,176 @@ TreeSearch::TreeSearch(PLITable const& tab, Config const& cfg, ResultCollector&
 
 void TreeSearch::Run() {
     for (auto const& pli : tab_.plis) {
-        Hypergraph gen = Sample(pli);
+        Hypergraph gen = Sample(pli, gen_, rc_);
         for (Edge const& e : gen) {
             partial_hg_.AddEdgeAndMinimizeInclusion(e);
         }
     }
     rc_.StopInitialSampling();
 
+    if (cfg_.threads == 1) {
+        // one thread searches the whole tree from the root and goes on with the random engine
+        // of the initial sampling
+        Worker worker{partial_hg_, &rc_, gen_, std::vector<model::PLI::Cluster>(tab_.nr_rows)};
+        try {
+            SearchTree(worker);
+        } catch (unsigned) {
+            timed_out_ = true;
+        }
+        partial_hg_ = std::move(worker.partial_hg);
+    } else {
+        SearchSubtrees();
+    }
+
+    if (timed_out_) {
+        // report current partial hypergraph
+        LOG_DEBUG("Current partial hypergraph:");
+    } else {
+        // report final hypergraph
+        LOG_DEBUG("Final hypergraph:");
+    }
+    rc_.FinalHypergraph(partial_hg_);
+}
+
+void TreeSearch::SearchSubtrees() {
+    std::vector<Subtree> const subtrees = SplitSearchTree(cfg_.threads * kSubtreesPerThread);
+
+    // every subtree has its own collector, so that the results can be merged in the same order
+    // however the subtrees were distributed among the threads
+    std::vector<ResultCollector> collectors(subtrees.size(), rc_.EmptyCopy());
+    std::atomic<std::size_t> next_subtree;
+    std::size_t round = 0;
+    auto search = [&]() {
+        Worker worker{Hypergraph(tab_.nr_cols), nullptr, std::default_random_engine(),
+                      std::vector<model::PLI::Cluster>(tab_.nr_rows)};
+        for (std::size_t i; !timed_out_ && (i = next_subtree.fetch_add(1)) < subtrees.size();) {
+            worker.rc = &collectors[i];
+            worker.gen.seed(cfg_.seed + round * subtrees.size() + i);
+            try {
+                SearchSubtree(subtrees[i], worker);
+            } catch (unsigned) {
+                timed_out_ = true;
+            }
+        }
+    };
+
+    if (subtrees.size() == 1) {
+        next_subtree = 0;
+        search();
+    } else {
+        // the search relies on the edges sampled in the subtrees before, which subtrees searched
+        // at the same time do not see. So the subtrees are searched again, until no edges are
+        // sampled in a round: then every minimal hitting set of the partial hypergraph was
+        // confirmed to be a UCC, and these are all minimal UCCs. The UCCs found before are not
+        // validated again
+        do {
+            edges_sampled_ = false;
+            next_subtree = 0;
+            boost::asio::thread_pool pool(cfg_.threads);
+            for (unsigned t = 0; t < cfg_.threads; ++t) {
+                boost::asio::post(pool, search);
+            }
+            pool.join();
+
+            known_uccs_.clear();
+            for (ResultCollector const& collector : collectors) {
+                known_uccs_.insert(known_uccs_.end(), collector.GetUCCs().begin(),
+                                   collector.GetUCCs().end());
+            }
+            std::sort(known_uccs_.begin(), known_uccs_.end());
+            ++round;
+        } while (edges_sampled_ && !timed_out_);
+        LOG_DEBUG("Searched the tree in {} rounds.", round);
+    }
+
+    rc_.Merge(collectors);
+}
+
+std::vector<Edgemark> TreeSearch::VertexHittings(Hypergraph const& hg) const {
+    std::vector<Edgemark> vertexhittings(hg.NumVertices(), Edgemark(hg.NumEdges()));
+    for (std::vector<Edge>::size_type i_e = 0; i_e < hg.NumEdges(); ++i_e) {
+        for (Edge::size_type i_v = hg[i_e].find_first(); i_v != Edge::npos;
+             i_v = hg[i_e].find_next(i_v)) {
+            vertexhittings[i_v].set(i_e);
+        }
+    }
+    return vertexhittings;
+}
+
+Edge TreeSearch::SmallestUncoveredEdge(Hypergraph const& hg, Edge const& cand,
+                                       Edgemark const& uncov) const {
+    // find edge from uncov with smallest intersection C with CAND
+    Edge c = hg[uncov.find_first()] & cand;
+    for (Edge::size_type i_e = uncov.find_next(uncov.find_first()); i_e != Edge::npos;
+         i_e = uncov.find_next(i_e)) {
+        Edge c_new = (hg[i_e] & cand);
+        if (c_new.count() < c.count() ||
+            (c_new.count() == c.count() && Niceness(c_new) < Niceness(c))) {
+            c = std::move(c_new);
+        }
+    }
+    return c;
+}
+
+std::vector<TreeSearch::Subtree> TreeSearch::SplitSearchTree(std::size_t min_subtrees) const {
+    std::vector<Edgemark> vertexhittings = VertexHittings(partial_hg_);
+    std::vector<std::vector<Edgemark>> removed_critical_stack;
+
+    Subtree root{{}, Edge(partial_hg_.NumVertices()), {}, Edgemark(partial_hg_.NumEdges())};
+    root.cand.set();
+    root.uncov.set();
+    std::vector<Subtree> subtrees;
+    subtrees.push_back(std::move(root));
+
+    // branch on the vertices of C like ExtendOrConfirmS does, level by level, until there are
+    // enough subtrees; violaters are not skipped here, as the edges sampled until a subtree is
+    // searched decide that
+    bool split = true;
+    for (std::size_t depth = 0; split && (depth == 0 || subtrees.size() < min_subtrees);
+         ++depth) {
+        split = false;
+        std::vector<Subtree> next_level;
+        for (Subtree& subtree : subtrees) {
+            if (subtree.uncov.none()) {
+                next_level.push_back(std::move(subtree));
+                continue;
+            }
+            split = true;
+            Edge const c = SmallestUncoveredEdge(partial_hg_, subtree.cand, subtree.uncov);
+            Edge cand = subtree.cand - c;
+            for (Edge::size_type v = c.find_first(); v != Edge::npos; v = c.find_next(v)) {
+                Subtree child{subtree.s, cand, subtree.crit, subtree.uncov};
+                UpdateCritAndUncov(removed_critical_stack, child.crit, child.uncov,
+                                   vertexhittings[v]);
+                removed_critical_stack.clear();
+                child.s.push_back(v);
+                next_level.push_back(std::move(child));
+
+                // update CAND
+                cand.set(v);
+            }
+        }
+        subtrees = std::move(next_level);
+    }
+
+    return subtrees;
+}
+
+void TreeSearch::SearchTree(Worker& worker) {
+    Hypergraph const& partial_hg = worker.partial_hg;
+
     // S, CAND
-    Edge s(partial_hg_.NumVertices());
-    Edge cand(partial_hg_.NumVertices());
+    Edge s(partial_hg.NumVertices());
+    Edge cand(partial_hg.NumVertices());
     cand.set();
 
     // crit, uncov
     std::vector<Edgemark> crit;
-    Edgemark uncov(partial_hg_.NumEdges());
+    Edgemark uncov(partial_hg.NumEdges());
     uncov.set();
 
     // vertexhittings
-    std::vector<Edgemark> vertexhittings(partial_hg_.NumVertices(),
-                                         Edgemark(partial_hg_.NumEdges()));
-    for (std::vector<Edge>::size_type i_e = 0; i_e < partial_hg_.NumEdges(); ++i_e) {
-        for (Edge::size_type i_v = partial_hg_[i_e].find_first(); i_v != Edge::npos;
-             i_v = partial_hg_[i_e].find_next(i_v)) {
-            vertexhittings[i_v].set(i_e);
-        }
-    }
+    std::vector<Edgemark> vertexhittings = VertexHittings(partial_hg);
 
     std::vector<std::vector<Edgemark>> removed_critical_stack;
 
@@ -71,45 +222,73 @@ void TreeSearch::Run() {
 
     // Searching
     // find edge from uncov with smallest intersection C with CAND
-    Edge c = partial_hg_[uncov.find_first()] & cand;
+    Edge c = partial_hg[uncov.find_first()] & cand;
     for (Edge::size_type i_e = uncov.find_next(uncov.find_first()); i_e != Edge::npos;
          i_e = uncov.find_next(i_e)) {
-        if ((partial_hg_[i_e] & cand).count() < c.count()) {
-            c = partial_hg_[i_e] & cand;
+        if ((partial_hg[i_e] & cand).count() < c.count()) {
+            c = partial_hg[i_e] & cand;
         }
     }
 
     cand -= c;
 
-    try {
-        for (Edge::size_type v = c.find_first(); v != Edge::npos; v = c.find_next(v)) {
-            // update crit and uncov
-            UpdateCritAndUncov(removed_critical_stack, crit, uncov, vertexhittings[v]);
+    for (Edge::size_type v = c.find_first(); v != Edge::npos; v = c.find_next(v)) {
+        // update crit and uncov
+        UpdateCritAndUncov(removed_critical_stack, crit, uncov, vertexhittings[v]);
 
-            // branch
-            s.set(v);
-            intersection_stack.push(tab_.plis[v]);
-            ExtendOrConfirmS(s, cand, crit, uncov, vertexhittings, removed_critical_stack,
-                             intersection_stack, tointersect_queue);
-            intersection_stack.pop();
-            s.reset(v);
+        // branch
+        s.set(v);
+        intersection_stack.push(tab_.plis[v]);
+        ExtendOrConfirmS(worker, s, cand, crit, uncov, vertexhittings, removed_critical_stack,
+                         intersection_stack, tointersect_queue);
+        intersection_stack.pop();
+        s.reset(v);
 
-            // reset update of crit and uncov
-            RestoreCritAndUncov(removed_critical_stack, crit, uncov);
+        // reset update of crit and uncov
+        RestoreCritAndUncov(removed_critical_stack, crit, uncov);
 
-            // update CAND
-            cand.set(v);
-        }
-        // report final hypergraph
-        LOG_DEBUG("Final hypergraph:");
-        rc_.FinalHypergraph(partial_hg_);
-    } catch (unsigned timeout) {
-        // report current partial hypergraph
-        LOG_DEBUG("Current partial hypergraph:");
-        rc_.FinalHypergraph(partial_hg_);
+        // update CAND
+        cand.set(v);
     }
 }
 
+void TreeSearch::SearchSubtree(Subtree const& subtree, Worker& worker) {
+    {
+        std::scoped_lock lock(partial_hg_mutex_);
+        worker.partial_hg = partial_hg_;
+    }
+
+    // S, CAND
+    Edge s(worker.partial_hg.NumVertices());
+    Edge cand = subtree.cand;
+
+    // crit, uncov and vertexhittings are computed anew, since edges may have been sampled
+    // since the split
+    std::vector<Edgemark> crit;
+    Edgemark uncov(worker.partial_hg.NumEdges());
+    uncov.set();
+    std::vector<Edgemark> vertexhittings = VertexHittings(worker.partial_hg);
+    std::vector<std::vector<Edgemark>> removed_critical_stack;
+    for (Edge::size_type v : subtree.s) {
+        UpdateCritAndUncov(removed_critical_stack, crit, uncov, vertexhittings[v]);
+        s.set(v);
+    }
+    removed_critical_stack.clear();
+
+    // with these edges S may be no minimal hitting set, then neither are its supersets
+    if (!SFulfillsMinimalityCondition(crit)) {
+        return;
+    }
+
+    // intersections
+    std::stack<std::deque<model::PLI::Cluster>> intersection_stack;
+    intersection_stack.push(tab_.plis[subtree.s.front()]);
+    std::deque<Edge::size_type> tointersect_queue(subtree.s.begin() + 1, subtree.s.end());
+
+    ExtendOrConfirmS(worker, s, cand, crit, uncov, vertexhittings, removed_critical_stack,
+                     intersection_stack, tointersect_queue);
+}
+
 void TreeSearch::ComputeNiceness() {
     std::vector<std::pair<unsigned long, unsigned long>> sq_sizes_col_id_pairs(tab_.nr_cols);
 
@@ -142,7 +321,8 @@ unsigned long TreeSearch::Niceness(Edge const& e) const {
     return niceness;
 }
 
-Hypergraph TreeSearch::Sample(std::deque<model::PLI::Cluster> const& pli) {
+Hypergraph TreeSearch::Sample(std::deque<model::PLI::Cluster> const& pli,
+                              std::default_random_engine& gen, ResultCollector& rc) const {
     Hypergraph difference_graph(tab_.nr_cols);
     Edge temp_edge(tab_.nr_cols);
 
@@ -165,16 +345,16 @@ Hypergraph TreeSearch::Sample(std::deque<model::PLI::Cluster> const& pli) {
         to_view = 1;
     }
 
-    rc_.CountDiffSets(to_view);
+    rc.CountDiffSets(to_view);
 
     std::discrete_distribution<int> rand_cluster(weights.begin(), weights.end());
     std::uniform_int_distribution<> rand_int(0, std::numeric_limits<int>::max());
     std::vector<std::tuple<int, int, int>> samples(to_view);
     for (std::size_t i = 0; i < to_view; ++i) {
-        std::get<0>(samples[i]) = rand_cluster(gen_);
+        std::get<0>(samples[i]) = rand_cluster(gen);
         unsigned size = pli[std::get<0>(samples[i])].size();
-        int i_i_r1 = rand_int(gen_) % size;
-        int i_i_r2 = (i_i_r1 + 1 + rand_int(gen_) % (size - 1)) % size;
+        int i_i_r1 = rand_int(gen) % size;
+        int i_i_r2 = (i_i_r1 + 1 + rand_int(gen) % (size - 1)) % size;
         std::get<1>(samples[i]) = i_i_r1;
         std::get<2>(samples[i]) = i_i_r2;
     }
@@ -235,23 +415,29 @@ inline void TreeSearch::RestoreCritAndUncov(
 }
 
 inline bool TreeSearch::ExtendOrConfirmS(
-        Edge& s, Edge& cand, std::vector<Edgemark>& crit, Edgemark& uncov,
+        Worker& worker, Edge& s, Edge& cand, std::vector<Edgemark>& crit, Edgemark& uncov,
         std::vector<Edgemark>& vertexhittings,
         std::vector<std::vector<Edgemark>>& removed_critical_stack,
         std::stack<std::deque<model::PLI::Cluster>>& intersection_stack,
         std::deque<Edge::size_type>& tointersect_queue) {
-    rc_.CountTreeNode();
+    worker.rc->CountTreeNode();
     if (uncov.none()) {
-        PullUpIntersections(intersection_stack, tointersect_queue);
+        // S was confirmed to be a UCC in a previous round
+        if (std::binary_search(known_uccs_.begin(), known_uccs_.end(), s)) {
+            return false;
+        }
+
+        PullUpIntersections(worker, intersection_stack, tointersect_queue);
 
         if (intersection_stack.top().empty()) {
-            rc_.AddUCC(s);
-            if (rc_.TimedOut()) throw timeout_;
+            worker.rc->AddUCC(s);
+            if (worker.rc->TimedOut()) throw timeout_;
             return false;
         }
 
         // gain new edges and minimize
-        UpdateEdges(crit, uncov, vertexhittings, removed_critical_stack, intersection_stack.top());
+        UpdateEdges(worker, crit, uncov, vertexhittings, removed_critical_stack,
+                    intersection_stack.top());
 
         // check if minimality still holds
         if (!SFulfillsMinimalityCondition(crit)) {
@@ -259,17 +445,8 @@ inline bool TreeSearch::ExtendOrConfirmS(
         }
     }
 
-    // find edge from uncov with smallest intersection C with CAND
-    rc_.CountTreeComplexity(uncov.count());
-    Edge c = partial_hg_[uncov.find_first()] & cand;
-    for (Edge::size_type i_e = uncov.find_next(uncov.find_first()); i_e != Edge::npos;
-         i_e = uncov.find_next(i_e)) {
-        Edge c_new = (partial_hg_[i_e] & cand);
-        if (c_new.count() < c.count() ||
-            (c_new.count() == c.count() && Niceness(c_new) < Niceness(c))) {
-            c = std::move(c_new);
-        }
-    }
+    worker.rc->CountTreeComplexity(uncov.count());
+    Edge c = SmallestUncoveredEdge(worker.partial_hg, cand, uncov);
 
     cand -= c;
 
@@ -284,8 +461,9 @@ inline bool TreeSearch::ExtendOrConfirmS(
 
         s.set(v);
         tointersect_queue.push_back(v);
-        bool check = ExtendOrConfirmS(s, cand, crit, uncov, vertexhittings, removed_critical_stack,
-                                      intersection_stack, tointersect_queue);
+        bool check = ExtendOrConfirmS(worker, s, cand, crit, uncov, vertexhittings,
+                                      removed_critical_stack, intersection_stack,
+                                      tointersect_queue);
         if (tointersect_queue.empty()) {
             intersection_stack.pop();
         } else {
@@ -315,28 +493,32 @@ inline bool TreeSearch::ExtendOrConfirmS(
 }
 
 inline void TreeSearch::PullUpIntersections(
-        std::stack<std::deque<model::PLI::Cluster>>& intersection_stack,
+        Worker& worker, std::stack<std::deque<model::PLI::Cluster>>& intersection_stack,
         std::deque<Edge::size_type>& tointersect_queue) {
     while (!tointersect_queue.empty()) {
         intersection_stack.push(IntersectClusterListAndClusterMapping(
-                intersection_stack.top(), tab_.inverse_mapping[tointersect_queue.front()]));
+                worker, intersection_stack.top(),
+                tab_.inverse_mapping[tointersect_queue.front()]));
 
         tointersect_queue.pop_front();
     }
 }
 
 std::deque<model::PLI::Cluster> TreeSearch::IntersectClusterListAndClusterMapping(
-        std::deque<model::PLI::Cluster> const& pli, std::vector<unsigned> const& inverse_mapping) {
-    rc_.CountIntersections();
+        Worker& worker, std::deque<model::PLI::Cluster> const& pli,
+        std::vector<unsigned> const& inverse_mapping) {
+    worker.rc->CountIntersections();
+    std::vector<model::PLI::Cluster>& clusterid_to_recordindices =
+            worker.clusterid_to_recordindices;
     std::deque<model::PLI::Cluster> intersection;
 
     std::vector<unsigned long> clusterids;
     for (auto const& cluster : pli) {
-        rc_.CountIntersectionClusterSize(cluster.size());
+        worker.rc->CountIntersectionClusterSize(cluster.size());
         clusterids.clear();
         for (std::vector<unsigned>::size_type i_r : cluster) {
             if (inverse_mapping[i_r] != kSizeOneCluster) {
-                auto& map_entry = clusterid_to_recordindices_[inverse_mapping[i_r]];
+                auto& map_entry = clusterid_to_recordindices[inverse_mapping[i_r]];
                 if (map_entry.size() == 0) {
                     clusterids.push_back(inverse_mapping[i_r]);
                 }
@@ -344,33 +526,45 @@ std::deque<model::PLI::Cluster> TreeSearch::IntersectClusterListAndClusterMappin
             }
         }
         for (auto clusterid : clusterids) {
-            auto& map_entry = clusterid_to_recordindices_[clusterid];
+            auto& map_entry = clusterid_to_recordindices[clusterid];
             if (map_entry.size() != 1) {
                 intersection.emplace_back(std::move(map_entry));
             }
-            clusterid_to_recordindices_[clusterid] = {};
+            clusterid_to_recordindices[clusterid] = {};
         }
     }
 
     return intersection;
 }
 
-inline void TreeSearch::UpdateEdges(std::vector<Edgemark>& crit, Edgemark& uncov,
-                                    std::vector<Edgemark>& vertexhittings,
+inline void TreeSearch::UpdateEdges(Worker& worker, std::vector<Edgemark>& crit,
+                                    Edgemark& uncov, std::vector<Edgemark>& vertexhittings,
                                     std::vector<std::vector<Edgemark>>& removed_critical_stack,
                                     std::deque<model::PLI::Cluster> const& pli) {
+    Hypergraph& partial_hg = worker.partial_hg;
+
     // sample new edges
-    Hypergraph new_edges = Sample(pli);
+    Hypergraph new_edges = Sample(pli, worker.gen, *worker.rc);
+
+    // share them with the subtrees searched later; a single thread searching the whole tree
+    // has the only copy of the partial hypergraph
+    if (cfg_.threads > 1) {
+        edges_sampled_ = true;
+        std::scoped_lock lock(partial_hg_mutex_);
+        for (Edge const& e : new_edges) {
+            partial_hg_.AddEdgeAndMinimizeInclusion(e);
+        }
+    }
 
     // find out which edges are supersets and therefore can be removed and save
     // indices in descending order
     std::vector<std::vector<Edge>::size_type> supsets_indices;
-    for (std::vector<Edge>::size_type i_e = partial_hg_.NumEdges(); i_e > 0;
+    for (std::vector<Edge>::size_type i_e = partial_hg.NumEdges(); i_e > 0;
          /* gets decreased below */) {
         --i_e;
 
         for (Edge const& new_edge : new_edges) {
-            if (new_edge.is_subset_of(partial_hg_[i_e])) {
+            if (new_edge.is_subset_of(partial_hg[i_e])) {
                 supsets_indices.push_back(i_e);
                 break;
             }
@@ -382,8 +576,8 @@ inline void TreeSearch::UpdateEdges(std::vector<Edgemark>& crit, Edgemark& uncov
 
     for (std::vector<Edge>::size_type i_e : supsets_indices) {
         // difference_graph
-        partial_hg_[i_e] = partial_hg_[partial_hg_.NumEdges() - 1];
-        partial_hg_.RemoveLastEdge();
+        partial_hg[i_e] = partial_hg[partial_hg.NumEdges() - 1];
+        partial_hg.RemoveLastEdge();
 
         // vertexhittings
         for (Edgemark& hittings : vertexhittings) {
@@ -415,33 +609,33 @@ inline void TreeSearch::UpdateEdges(std::vector<Edgemark>& crit, Edgemark& uncov
 
     // difference graph
     for (Edge const& e : new_edges) {
-        partial_hg_.AddEdge(e);
+        partial_hg.AddEdge(e);
     }
 
     // vertexhittings
-    for (Edge::size_type i_v = 0; i_v < partial_hg_.NumVertices(); ++i_v) {
-        vertexhittings[i_v].resize(partial_hg_.NumEdges());
+    for (Edge::size_type i_v = 0; i_v < partial_hg.NumVertices(); ++i_v) {
+        vertexhittings[i_v].resize(partial_hg.NumEdges());
     }
-    for (std::size_t i_e = partial_hg_.NumEdges() - new_edges.NumEdges();
-         i_e < partial_hg_.NumEdges(); ++i_e) {
-        for (Edge::size_type i_v = partial_hg_[i_e].find_first(); i_v != Edge::npos;
-             i_v = partial_hg_[i_e].find_next(i_v)) {
+    for (std::size_t i_e = partial_hg.NumEdges() - new_edges.NumEdges();
+         i_e < partial_hg.NumEdges(); ++i_e) {
+        for (Edge::size_type i_v = partial_hg[i_e].find_first(); i_v != Edge::npos;
+             i_v = partial_hg[i_e].find_next(i_v)) {
             vertexhittings[i_v].set(i_e);
         }
     }
 
     // uncov
-    uncov.resize(partial_hg_.NumEdges(), true);
+    uncov.resize(partial_hg.NumEdges(), true);
 
     // crit
     for (Edgemark& em : crit) {
-        em.resize(partial_hg_.NumEdges());
+        em.resize(partial_hg.NumEdges());
     }
 
     // removed_critical
     for (auto& removed_critical : removed_critical_stack) {
         for (auto& removed : removed_critical) {
-            removed.resize(partial_hg_.NumEdges());
+            removed.resize(partial_hg.NumEdges());
         }
     }
 }
@@ -1,11 +1,15 @@
 #pragma once
 
+#include <atomic>
+#include <cstddef>
 #include <deque>
+#include <mutex>
 #include <random>
 #include <stack>
 #include <vector>
 
 #include "core/algorithms/ucc/hpivalid/hypergraph.h"
+#include "core/algorithms/ucc/hpivalid/result_collector.h"
 #include "core/model/table/position_list_index.h"
 
 // see algorithms/ucc/hpivalid/LICENSE
@@ -14,24 +18,52 @@ namespace algos::hpiv {
 
 struct Config;
 struct PLITable;
-class ResultCollector;
 
 class TreeSearch {
 private:
+    // root of a subtree of the search tree, that is searched on a single thread
+    struct Subtree {
+        // vertices of S in the order they were branched on
+        std::vector<Edge::size_type> s;
+        Edge cand;
+        std::vector<Edgemark> crit;
+        Edgemark uncov;
+    };
+
+    // state of a thread searching subtrees
+    struct Worker {
+        // the partial hypergraph as known to the subtree being searched
+        Hypergraph partial_hg;
+        // collector of the subtree being searched
+        ResultCollector* rc;
+        std::default_random_engine gen;
+
+        // a mapping from clusterid to record indices that is used for the
+        // intersection of PLIs with single-column PLIs
+        std::vector<model::PLI::Cluster> clusterid_to_recordindices;
+    };
+
     PLITable const& tab_;
     Config const& cfg_;
     ResultCollector& rc_;
 
-    // the partial hypergraph of difference sets
+    // the partial hypergraph of difference sets, shared by all subtrees; the
+    // search of a subtree starts with a copy and adds the edges it samples to it
     Hypergraph partial_hg_;
+    std::mutex partial_hg_mutex_;
+
+    // set when edges are sampled in a round of the parallel search
+    std::atomic<bool> edges_sampled_ = false;
+
+    // sorted UCCs found in the previous rounds of the parallel search
+    std::vector<Edge> known_uccs_;
+
+    // set when a search times out, so that the remaining subtrees are skipped
+    std::atomic<bool> timed_out_ = false;
 
     // exception to throw, when timeout happens
     unsigned const timeout_ = 10;
 
-    // a mapping from clusterid to record indices that is used for the
-    // intersection of PLIs with single-column PLIs
-    std::vector<model::PLI::Cluster> clusterid_to_recordindices_;
-
     // mapping from column to niceness (in [0, nr_cols)) with smaller
     // values being nicer columns
     std::vector<unsigned long> niceness_;
@@ -39,7 +71,19 @@ private:
     unsigned long Niceness(Edge const& e) const;
 
     std::default_random_engine gen_;
-    Hypergraph Sample(std::deque<model::PLI::Cluster> const& pli);
+    Hypergraph Sample(std::deque<model::PLI::Cluster> const& pli, std::default_random_engine& gen,
+                      ResultCollector& rc) const;
+
+    Edge SmallestUncoveredEdge(Hypergraph const& hg, Edge const& cand,
+                               Edgemark const& uncov) const;
+    std::vector<Edgemark> VertexHittings(Hypergraph const& hg) const;
+
+    // search with one thread, from the root of the search tree
+    void SearchTree(Worker& worker);
+    // search with several threads, that share the subtrees of the split search tree
+    void SearchSubtrees();
+    std::vector<Subtree> SplitSearchTree(std::size_t min_subtrees) const;
+    void SearchSubtree(Subtree const& subtree, Worker& worker);
 
     inline void UpdateCritAndUncov(std::vector<std::vector<Edgemark>>& removed_critical_stack,
                                    std::vector<Edgemark>& crit, Edgemark& uncov,
@@ -47,20 +91,21 @@ private:
     inline void RestoreCritAndUncov(std::vector<std::vector<Edgemark>>& removed_critical_stack,
                                     std::vector<Edgemark>& crit, Edgemark& uncov) const;
 
-    inline bool ExtendOrConfirmS(Edge& s, Edge& cand, std::vector<Edgemark>& crit, Edgemark& uncov,
-                                 std::vector<Edgemark>& vertexhittings,
+    inline bool ExtendOrConfirmS(Worker& worker, Edge& s, Edge& cand, std::vector<Edgemark>& crit,
+                                 Edgemark& uncov, std::vector<Edgemark>& vertexhittings,
                                  std::vector<std::vector<Edgemark>>& removed_critical_stack,
                                  std::stack<std::deque<model::PLI::Cluster>>& intersection_stack,
                                  std::deque<Edge::size_type>& tointersect_queue);
 
-    inline void PullUpIntersections(std::stack<std::deque<model::PLI::Cluster>>& intersection_stack,
+    inline void PullUpIntersections(Worker& worker,
+                                    std::stack<std::deque<model::PLI::Cluster>>& intersection_stack,
                                     std::deque<Edge::size_type>& tointersect_queue);
 
     std::deque<model::PLI::Cluster> IntersectClusterListAndClusterMapping(
-            std::deque<model::PLI::Cluster> const& pli,
+            Worker& worker, std::deque<model::PLI::Cluster> const& pli,
             std::vector<unsigned> const& inverse_mapping);
 
-    inline void UpdateEdges(std::vector<Edgemark>& crit, Edgemark& uncov,
+    inline void UpdateEdges(Worker& worker, std::vector<Edgemark>& crit, Edgemark& uncov,
                             std::vector<Edgemark>& vertexhittings,
                             std::vector<std::vector<Edgemark>>& removed_critical_stack,
                             std::deque<model::PLI::Cluster> const& pli);
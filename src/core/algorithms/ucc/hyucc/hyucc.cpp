@@ -7,12 +7,13 @@
 #include "core/algorithms/ucc/hyucc/preprocessor.h"
 #include "core/algorithms/ucc/hyucc/sampler.h"
 #include "core/algorithms/ucc/hyucc/validator.h"
+#include "core/model/table/dataset.h"
 #include "core/util/logger.h"
 
 namespace algos {
 
 void HyUCC::LoadDataInternal() {
-    relation_ = ColumnLayoutRelationData::CreateFrom(*input_table_);
+    relation_ = model::LoadRelation(*input_table_);
 
     if (relation_->GetColumnData().empty()) {
         throw std::runtime_error("Got an empty dataset: UCC mining is meaningless.");
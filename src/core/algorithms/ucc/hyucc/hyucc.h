@@ -13,7 +13,7 @@ namespace algos {
 
 class HyUCC : public UCCAlgorithm {
 private:
-    std::unique_ptr<ColumnLayoutRelationData> relation_;
+    std::shared_ptr<ColumnLayoutRelationData const> relation_;
     config::ThreadNumType threads_num_ = 1;
 
     void LoadDataInternal() override;
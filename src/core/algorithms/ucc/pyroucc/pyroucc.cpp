@@ -9,6 +9,7 @@
 #include "core/config/max_lhs/option.h"
 #include "core/config/names_and_descriptions.h"
 #include "core/config/option_using.h"
+#include "core/model/table/dataset.h"
 #include "core/util/logger.h"
 
 namespace algos {
@@ -36,7 +37,7 @@ void PyroUCC::MakeExecuteOptsAvailable() {
 }
 
 void PyroUCC::LoadDataInternal() {
-    relation_ = ColumnLayoutRelationData::CreateFrom(*input_table_);
+    relation_ = model::LoadRelation(*input_table_);
 
     if (relation_->GetColumnData().empty()) {
         throw std::runtime_error("Got an empty dataset: UCC mining is meaningless.");
@@ -81,7 +82,7 @@ unsigned long long PyroUCC::ExecuteInternal() {
 
     search_space_->SetContext(profiling_context.get());
     search_space_->EnsureInitialized();
-    search_space_->Discover();
+    search_space_->Discover(&GetCancellationToken());
 
     auto elapsed_milliseconds = std::chrono::duration_cast<std::chrono::milliseconds>(
             std::chrono::system_clock::now() - start_time);
@@ -1,7 +1,6 @@
 #include "core/algorithms/ucc/ucc_verifier/ucc_verifier.h"
 
 #include <chrono>
-#include <numeric>
 #include <stdexcept>
 
 #include "core/config/equal_nulls/option.h"
@@ -9,6 +8,8 @@
 #include "core/config/names_and_descriptions.h"
 #include "core/config/option_using.h"
 #include "core/config/tabular_data/input_table/option.h"
+#include "core/config/tabular_data/load_columns/option.h"
+#include "core/model/table/dataset.h"
 
 namespace algos {
 
@@ -19,16 +20,18 @@ UCCVerifier::UCCVerifier() : Algorithm() {
 
 void UCCVerifier::RegisterOptions() {
     DESBORDANTE_OPTION_USING;
-    auto get_schema_cols = [this]() { return relation_->GetSchema()->GetNumColumns(); };
-    auto calculate_default = [get_schema_cols]() {
-        config::IndicesType indices(get_schema_cols());
-        std::iota(indices.begin(), indices.end(), 0);
-        return indices;
+    auto get_table_cols = [this]() { return input_table_->GetNumberOfColumns(); };
+    auto get_source_cols = [this]() { return projection_.GetNumSourceColumns(); };
+    auto calculate_default = [this]() { return projection_.GetLoadedColumns(); };
+    auto check_loaded = [this](config::IndicesType const& indices) {
+        projection_.CheckLoaded(indices);
     };
-    RegisterOption(config::kTableOpt(&input_table_));
+    RegisterOption(config::kTableOpt(&input_table_).SetConditionalOpts({{{}, {kLoadColumns}}}));
+    RegisterOption(config::kLoadColumnsOpt(&load_columns_, std::move(get_table_cols)));
     RegisterOption(config::IndicesOption{
             kUCCIndices, kDUCCIndices, config::IndicesOption::NormalizeIndices,
-            std::move(calculate_default)}(&column_indices_, std::move(get_schema_cols)));
+            std::move(calculate_default)}(&column_indices_, std::move(get_source_cols),
+                                          std::move(check_loaded)));
 }
 
 void UCCVerifier::MakeExecuteOptsAvailable() {
@@ -37,7 +40,8 @@ void UCCVerifier::MakeExecuteOptsAvailable() {
 }
 
 void UCCVerifier::LoadDataInternal() {
-    relation_ = ColumnLayoutRelationData::CreateFrom(*input_table_);
+    projection_ = model::ColumnProjection(*input_table_, load_columns_);
+    relation_ = model::LoadRelation(*projection_.Apply(input_table_));
 
     if (relation_->GetColumnData().empty()) {
         throw std::runtime_error("Got an empty dataset: UCC verifying is meaningless.");
@@ -52,17 +56,18 @@ unsigned long long UCCVerifier::ExecuteInternal() {
     return elapsed_milliseconds.count();
 }
 
-std::shared_ptr<model::PLI const> UCCVerifier::CalculatePLI() {
+std::shared_ptr<model::PLI const> UCCVerifier::CalculatePLI(
+        config::IndicesType const& column_indices) {
     std::shared_ptr<model::PLI const> pli =
-            relation_->GetColumnData(column_indices_[0]).GetPliOwnership();
-    for (size_t i = 1; i < column_indices_.size(); ++i) {
-        pli = pli->Intersect(relation_->GetColumnData(column_indices_[i]).GetPositionListIndex());
+            relation_->GetColumnData(column_indices[0]).GetPliOwnership();
+    for (size_t i = 1; i < column_indices.size(); ++i) {
+        pli = pli->Intersect(relation_->GetColumnData(column_indices[i]).GetPositionListIndex());
     }
     return pli;
 }
 
 void UCCVerifier::VerifyUCC() {
-    std::shared_ptr<model::PLI const> pli = CalculatePLI();
+    std::shared_ptr<model::PLI const> pli = CalculatePLI(projection_.ToLoaded(column_indices_));
     stats_calculator_ = std::make_unique<UCCStatsCalculator>(relation_);
     stats_calculator_->CalculateStatistics(pli->GetIndex());
 }
@@ -8,6 +8,7 @@
 #include "core/config/indices/type.h"
 #include "core/config/tabular_data/input_table_type.h"
 #include "core/model/table/column_layout_relation_data.h"
+#include "core/model/table/column_projection.h"
 
 namespace algos {
 
@@ -19,7 +20,9 @@ private:
     config::IndicesType column_indices_;
 
     config::InputTable input_table_;
-    std::shared_ptr<ColumnLayoutRelationData> relation_;
+    config::IndicesType load_columns_;
+    model::ColumnProjection projection_;
+    std::shared_ptr<ColumnLayoutRelationData const> relation_;
     std::unique_ptr<UCCStatsCalculator> stats_calculator_;
     /* results of work */
     size_t num_rows_violating_ucc_ = 0;
@@ -31,7 +34,7 @@ private:
     void LoadDataInternal() override;
     void MakeExecuteOptsAvailable() override;
     unsigned long long ExecuteInternal() override;
-    std::shared_ptr<model::PLI const> CalculatePLI();
+    std::shared_ptr<model::PLI const> CalculatePLI(config::IndicesType const& column_indices);
 
     void ResetState() override {
         if (stats_calculator_) {
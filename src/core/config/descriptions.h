@@ -25,6 +25,8 @@ std::string const kDMetricAlgorithmString =
         "MFD algorithm to use\n" + util::EnumToAvailableValues<algos::metric::MetricAlgo>();
 std::string const kDCfdSubstrategyString = "CFD lattice traversal strategy to use\n" +
                                            util::EnumToAvailableValues<algos::cfd::Substrategy>();
+std::string const kDCfdTIdListTypeString = "CFD pattern tid-list representation to use\n" +
+                                           util::EnumToAvailableValues<algos::cfd::TIdListType>();
 std::string const kDPfdErrorMeasureString =
         "PFD error measure to use\n" + util::EnumToAvailableValues<algos::PfdErrorMeasure>();
 std::string const kDAfdErrorMeasureString =
@@ -47,6 +49,9 @@ std::string const kDAlgoTypeString =
 constexpr auto kDEqualNulls = "specify whether two NULLs should be considered equal";
 constexpr auto kDError = "error threshold value for Approximate FD algorithms";
 constexpr auto kDLhsIndices = "LHS column indices";
+constexpr auto kDLoadColumns =
+        "indices of the table columns to load. Other columns are skipped while reading the "
+        "table. If not set, all columns are loaded.";
 constexpr auto kDMaximumLhs = "max considered LHS size";
 constexpr auto kDRhsIndices = "RHS column indices";
 constexpr auto kDSeed = "RNG seed";
@@ -87,6 +92,7 @@ constexpr auto kDCfdMinimumSupport =
 constexpr auto kDCFDRuleLeft = "CFD left rule";
 constexpr auto kDCFDRuleRight = "CFD right rule";
 auto const kDCfdSubstrategy = details::kDCfdSubstrategyString.c_str();
+auto const kDCfdTIdListType = details::kDCfdTIdListTypeString.c_str();
 constexpr auto kDCfdTuplesNumber =
         "Number of tuples in the part of the dataset if you "
         "want to use algo not on the full dataset, but on its part";
@@ -243,6 +249,10 @@ constexpr auto kDRatio =
         "cluster's size";
 // UCC verifier
 constexpr auto kDUCCIndices = "column indices for UCC verification";
+// Batch verifier
+constexpr auto kDFdsToVerify = "FDs to verify, as pairs of LHS and RHS column indices";
+constexpr auto kDUccsToVerify = "UCCs to verify, as lists of column indices";
+constexpr auto kDMaxHighlights = "maximum number of violating clusters kept per dependency";
 // MD verifier
 constexpr auto kDMDLHS = "Left-hand side of Matching Dependency";
 constexpr auto kDMDRHS = "Right-hand side of Matching Dependency";
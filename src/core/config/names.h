@@ -6,6 +6,7 @@ constexpr auto kCsvConfig = "csv_config";
 constexpr auto kEqualNulls = "is_null_equal_null";
 constexpr auto kError = "error";
 constexpr auto kLhsIndices = "lhs_indices";
+constexpr auto kLoadColumns = "load_columns";
 constexpr auto kMaximumLhs = "max_lhs";
 constexpr auto kRhsIndices = "rhs_indices";
 constexpr auto kSeed = "seed";
@@ -37,6 +38,7 @@ constexpr auto kCfdMinimumSupport = "cfd_minsup";
 constexpr auto kCFDRuleLeft = "cfd_rule_left";
 constexpr auto kCFDRuleRight = "cfd_rule_right";
 constexpr auto kCfdSubstrategy = "cfd_substrategy";
+constexpr auto kCfdTIdListType = "cfd_tidlist_type";
 constexpr auto kCfdTuplesNumber = "tuples_number";
 // CORDS
 constexpr auto kDelta = "delta";
@@ -131,6 +133,10 @@ constexpr auto kRadius = "radius";
 constexpr auto kRatio = "ratio";
 // UCC verifier
 constexpr auto kUCCIndices = "ucc_indices";
+// Batch verifier
+constexpr auto kFdsToVerify = "fds";
+constexpr auto kUccsToVerify = "uccs";
+constexpr auto kMaxHighlights = "max_highlights";
 // MD verifier
 constexpr auto kMDLHS = "lhs";
 constexpr auto kMDRHS = "rhs";
@@ -0,0 +1,38 @@
+#include "core/config/tabular_data/load_columns/option.h"
+
+#include <cassert>
+#include <numeric>
+#include <string>
+
+#include "core/config/column_index/validate_index.h"
+#include "core/config/exceptions.h"
+#include "core/config/indices/option.h"
+#include "core/config/names_and_descriptions.h"
+
+namespace config {
+using names::kLoadColumns, descriptions::kDLoadColumns;
+
+Option<IndicesType> LoadColumnsOption::operator()(IndicesType* value_ptr,
+                                                  std::function<IndexType()> get_col_count) const {
+    assert(get_col_count);
+    Option<IndicesType> option{value_ptr, kLoadColumns, kDLoadColumns, [get_col_count]() {
+                                   IndicesType all_columns(get_col_count());
+                                   std::iota(all_columns.begin(), all_columns.end(), 0);
+                                   return all_columns;
+                               }};
+    option.SetNormalizeFunc(IndicesOption::NormalizeIndices);
+    option.SetValueCheck([get_col_count](IndicesType const& indices) {
+        if (indices.empty()) {
+            throw ConfigurationError(std::string{kLoadColumns} + " cannot be empty");
+        }
+        ValidateIndex(indices.back(), get_col_count());
+    });
+    return option;
+}
+
+std::string_view LoadColumnsOption::GetName() const {
+    return kLoadColumns;
+}
+
+extern LoadColumnsOption const kLoadColumnsOpt{};
+}  // namespace config
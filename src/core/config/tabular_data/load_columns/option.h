@@ -0,0 +1,23 @@
+// This option is meant for algorithms that only use some columns of their table and can skip
+// reading the rest. Indices are in the numbering of the original table.
+
+#pragma once
+
+#include <functional>
+#include <string_view>
+
+#include "core/config/indices/type.h"
+#include "core/config/option.h"
+
+namespace config {
+// Unlike other index options, the default depends on the table: if the option is not set, every
+// column is loaded. An empty list is rejected, as it would load no columns at all.
+struct LoadColumnsOption {
+    [[nodiscard]] Option<IndicesType> operator()(IndicesType* value_ptr,
+                                                 std::function<IndexType()> get_col_count) const;
+
+    [[nodiscard]] std::string_view GetName() const;
+};
+
+extern LoadColumnsOption const kLoadColumnsOpt;
+}  // namespace config
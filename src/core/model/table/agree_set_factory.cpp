@@ -1,7 +1,9 @@
 #include "core/model/table/agree_set_factory.h"
 
+#include <algorithm>
 #include <atomic>
 #include <condition_variable>
+#include <mutex>
 #include <shared_mutex>
 #include <thread>
 #include <unordered_set>
@@ -220,7 +222,7 @@ AgreeSetFactory::SetOfAgreeSets AgreeSetFactory::GenAsUsingGetAgreeSets() const
     // ~40436 ms on CIPublicHighway700 (Debug build)
     for (ColumnData const& column_data : columns_data) {
         PositionListIndex const* const pli = column_data.GetPositionListIndex();
-        for (vector<int> const& cluster : pli->GetIndex()) {
+        for (PositionListIndex::Cluster const& cluster : pli->GetIndex()) {
             for (auto p = cluster.begin(); p != cluster.end(); ++p) {
                 for (auto q = std::next(p); q != cluster.end(); ++q) {
                     agree_sets.insert(GetAgreeSet(*p, *q));
@@ -232,6 +234,122 @@ AgreeSetFactory::SetOfAgreeSets AgreeSetFactory::GenAsUsingGetAgreeSets() const
     return agree_sets;
 }
 
+ColumnSetList AgreeSetFactory::GenAgreeSetList() const {
+    SetOfVectors const max_representation = GenPliMaxRepresentation();
+    auto start_time = std::chrono::system_clock::now();
+    size_t const num_columns = relation_->GetNumColumns();
+
+    /* Value ids of the tuples that occur in the maximal representation, a row per tuple, so
+     * that comparing two tuples reads two contiguous rows
+     */
+    std::vector<int> tuple_rows(relation_->GetNumRows(), -1);
+    std::vector<int> values;
+    std::vector<std::vector<int> const*> clusters;
+    clusters.reserve(max_representation.size());
+    for (auto const& cluster : max_representation) {
+        clusters.push_back(&cluster);
+        for (int tuple_index : cluster) {
+            if (tuple_rows[tuple_index] == -1) {
+                tuple_rows[tuple_index] = values.size() / num_columns;
+                std::vector<int> const tuple = relation_->GetTuple(tuple_index);
+                values.insert(values.end(), tuple.begin(), tuple.end());
+            }
+        }
+    }
+
+    /* Tuples [begin, end) of a cluster are paired with all the tuples that follow them.
+     * Large clusters are split into several tasks, so that threads get similar amounts of pairs
+     */
+    struct PairRange {
+        size_t cluster;
+        size_t begin;
+        size_t end;
+    };
+
+    constexpr size_t kPairsPerTask = 1 << 14;
+    std::vector<PairRange> tasks;
+    for (size_t c = 0; c < clusters.size(); ++c) {
+        size_t const cluster_size = clusters[c]->size();
+        size_t begin = 0;
+        size_t num_pairs = 0;
+        for (size_t p = 0; p + 1 < cluster_size; ++p) {
+            num_pairs += cluster_size - 1 - p;
+            if (num_pairs >= kPairsPerTask) {
+                tasks.push_back({c, begin, p + 1});
+                begin = p + 1;
+                num_pairs = 0;
+            }
+        }
+        if (begin + 1 < cluster_size) {
+            tasks.push_back({c, begin, cluster_size - 1});
+        }
+    }
+
+    /* Agree sets of one thread. They are deduplicated whenever their number doubles, which
+     * keeps memory proportional to the number of distinct agree sets
+     */
+    struct ThreadAgreeSets {
+        ColumnSetList sets;
+        size_t dedup_size;
+    };
+
+    constexpr size_t kMinDedupSize = 1 << 16;
+    auto process = [&](PairRange const& range, ThreadAgreeSets& agree_sets) {
+        std::vector<int> const& cluster = *clusters[range.cluster];
+        for (size_t p = range.begin; p < range.end; ++p) {
+            int const* const lhs = values.data() + tuple_rows[cluster[p]] * num_columns;
+            for (size_t q = p + 1; q < cluster.size(); ++q) {
+                int const* const rhs = values.data() + tuple_rows[cluster[q]] * num_columns;
+                ColumnSetList::Word* const row = agree_sets.sets.AppendEmpty();
+                for (size_t i = 0; i < num_columns; ++i) {
+                    if (lhs[i] != 0 && lhs[i] == rhs[i]) {
+                        ColumnSetList::Set(row, i);
+                    }
+                }
+            }
+        }
+        if (agree_sets.sets.Size() >= agree_sets.dedup_size) {
+            agree_sets.sets.SortAndDedup();
+            agree_sets.dedup_size = std::max(kMinDedupSize, 2 * agree_sets.sets.Size());
+        }
+    };
+
+    ColumnSetList agree_sets(num_columns);
+    if (config_.threads_num > 1 && tasks.size() > 1) {
+        std::atomic<size_t> next_task = 0;
+        std::mutex merge_mutex;
+        boost::asio::thread_pool pool(config_.threads_num);
+        for (unsigned short t = 0; t < config_.threads_num; ++t) {
+            boost::asio::post(pool, [&]() {
+                ThreadAgreeSets thread_agree_sets{ColumnSetList(num_columns), kMinDedupSize};
+                for (size_t i; (i = next_task.fetch_add(1)) < tasks.size();) {
+                    process(tasks[i], thread_agree_sets);
+                }
+                thread_agree_sets.sets.SortAndDedup();
+                std::scoped_lock lock(merge_mutex);
+                agree_sets.Append(thread_agree_sets.sets);
+            });
+        }
+        pool.join();
+    } else {
+        ThreadAgreeSets thread_agree_sets{ColumnSetList(num_columns), kMinDedupSize};
+        for (PairRange const& range : tasks) {
+            process(range, thread_agree_sets);
+        }
+        agree_sets = std::move(thread_agree_sets.sets);
+    }
+
+    agree_sets.AppendEmpty();
+    agree_sets.SortAndDedup();
+
+    auto elapsed_mills_to_gen_agree_sets = std::chrono::duration_cast<std::chrono::milliseconds>(
+            std::chrono::system_clock::now() - start_time);
+    LOG_INFO("TIME TO GENERATE {} AGREE SETS AS BITSETS: {}", agree_sets.Size(),
+             elapsed_mills_to_gen_agree_sets.count());
+
+    return agree_sets;
+}
+
 AgreeSet AgreeSetFactory::GetAgreeSet(int const tuple1_index, int const tuple2_index) const {
     std::vector<int> const tuple1 = relation_->GetTuple(tuple1_index);
     std::vector<int> const tuple2 = relation_->GetTuple(tuple2_index);
@@ -295,8 +413,10 @@ AgreeSetFactory::SetOfVectors AgreeSetFactory::GenMcUsingCalculateSupersets() co
         return max_representation;
     }
 
-    max_representation.insert(not_empty_pli->GetPositionListIndex()->GetIndex().begin(),
-                              not_empty_pli->GetPositionListIndex()->GetIndex().end());
+    for (PositionListIndex::Cluster const& cluster :
+         not_empty_pli->GetPositionListIndex()->GetIndex()) {
+        max_representation.emplace(cluster.begin(), cluster.end());
+    }
 
     for (auto p = std::next(not_empty_pli); p != columns_data.end(); ++p) {
         PositionListIndex const* pli = p->GetPositionListIndex();
@@ -361,8 +481,9 @@ set<vector<int>, AgreeSetFactory::VectorComp> AgreeSetFactory::GenSortedEqvClass
 
     // Fill sorted_partitions
     for (ColumnData const& data : columns_data) {
-        std::deque<vector<int>> const& index = data.GetPositionListIndex()->GetIndex();
-        sorted_eqv_classes.insert(index.begin(), index.end());
+        for (PositionListIndex::Cluster const& cluster : data.GetPositionListIndex()->GetIndex()) {
+            sorted_eqv_classes.emplace(cluster.begin(), cluster.end());
+        }
     }
 
     return sorted_eqv_classes;
@@ -531,13 +652,13 @@ void AgreeSetFactory::HandleEqvClass(vector<int>& eqv_class,
 
 void AgreeSetFactory::CalculateSupersets(
         std::unordered_set<std::vector<int>, boost::hash<std::vector<int>>>& max_representation,
-        std::deque<vector<int>> const& partition) const {
+        std::deque<PositionListIndex::Cluster> const& partition) const {
     SetOfVectors to_add_to_mc;
     auto hash = [beg = max_representation.begin()](SetOfVectors::const_iterator it) {
         return std::distance<SetOfVectors::const_iterator>(beg, it);
     };
     unordered_set<SetOfVectors::const_iterator, decltype(hash)> to_delete_from_mc(1, hash);
-    set<std::deque<vector<int>>::const_iterator> to_exclude_from_partition;
+    set<std::deque<PositionListIndex::Cluster>::const_iterator> to_exclude_from_partition;
 
     for (auto it = max_representation.begin(); it != max_representation.end(); ++it) {
         for (auto p = partition.begin();
@@ -548,7 +669,7 @@ void AgreeSetFactory::CalculateSupersets(
 
             if (it->size() >= p->size() &&
                 std::includes(it->begin(), it->end(), p->begin(), p->end())) {
-                to_add_to_mc.erase(*p);
+                to_add_to_mc.erase(vector<int>(p->begin(), p->end()));
                 to_exclude_from_partition.insert(p);
                 break;
             }
@@ -558,7 +679,7 @@ void AgreeSetFactory::CalculateSupersets(
                 to_delete_from_mc.insert(it);
             }
 
-            to_add_to_mc.insert(*p);
+            to_add_to_mc.emplace(p->begin(), p->end());
         }
     }
 
@@ -9,6 +9,7 @@
 #include <boost/functional/hash.hpp>
 
 #include "core/model/table/column_layout_relation_data.h"
+#include "core/model/table/column_set_list.h"
 #include "core/model/table/vertical.h"
 #include "core/util/custom_hashes.h"
 
@@ -150,6 +151,13 @@ public:
     // Computes all agree sets of `relation_` using specified method
     SetOfAgreeSets GenAgreeSets() const;
 
+    /* Computes the same agree sets as GenAgreeSets, sorted and stored as bitsets.
+     * Tuple pairs of the maximal representation are compared on value ids by config_.threads_num
+     * threads, each of which deduplicates its own agree sets before they are merged.
+     * config_.as_gen_method is not used.
+     */
+    ColumnSetList GenAgreeSetList() const;
+
     SetOfVectors GenPliMaxRepresentation() const;
 
     AgreeSet GetAgreeSet(int const tuple1_index, int const tuple2_index) const;
@@ -169,7 +177,7 @@ private:
 
     void CalculateSupersets(
             std::unordered_set<std::vector<int>, boost::hash<std::vector<int>>>& max_representation,
-            std::deque<std::vector<int>> const& partition) const;
+            std::deque<PositionListIndex::Cluster> const& partition) const;
     /* From Metanome: `handleList`.
      * Extremely slow for anything big eqv_class,
      * I think it is not usable at all
@@ -8,6 +8,7 @@
 #include <memory>
 #include <utility>
 
+#include "core/model/table/relation_snapshot.h"
 #include "core/util/logger.h"
 
 std::vector<int> ColumnLayoutRelationData::GetTuple(int tuple_index) const {
@@ -45,6 +46,10 @@ std::shared_ptr<model::PLIWS const> ColumnLayoutRelationData::CalculatePLIWS(
 
 std::unique_ptr<ColumnLayoutRelationData> ColumnLayoutRelationData::CreateFrom(
         model::IDatasetStream& data_stream) {
+    if (auto* snapshot_stream = dynamic_cast<model::SnapshotDatasetStream*>(&data_stream)) {
+        return CreateFrom(*snapshot_stream->GetSnapshot());
+    }
+
     auto schema = std::make_unique<RelationalSchema>(data_stream.GetRelationName());
     std::unordered_map<std::string, int> value_dictionary;
     int next_value_id = 0;
@@ -88,3 +93,30 @@ std::unique_ptr<ColumnLayoutRelationData> ColumnLayoutRelationData::CreateFrom(
 
     return std::make_unique<ColumnLayoutRelationData>(std::move(schema), std::move(column_data));
 }
+
+std::unique_ptr<ColumnLayoutRelationData> ColumnLayoutRelationData::CreateFrom(
+        model::RelationSnapshot const& snapshot) {
+    auto to_deque = [](model::RelationSnapshot::Clusters const& clusters) {
+        std::deque<model::PLI::Cluster> result;
+        for (size_t i = 0; i != clusters.Size(); ++i) {
+            std::span<int const> cluster = clusters[i];
+            result.emplace_back(cluster.begin(), cluster.end());
+        }
+        return result;
+    };
+
+    auto schema = std::make_unique<RelationalSchema>(std::string{snapshot.GetRelationName()});
+    std::vector<ColumnData> column_data;
+    column_data.reserve(snapshot.GetNumColumns());
+    for (size_t i = 0; i < snapshot.GetNumColumns(); ++i) {
+        model::RelationSnapshot::ColumnView const& column = snapshot.GetColumn(i);
+        schema->AppendColumn(Column(schema.get(), std::string{column.name}, i));
+        model::RelationSnapshot::PliStats const& stats = *column.pli_stats;
+        auto pli = std::make_unique<model::PLIWithSingletons>(
+                to_deque(column.clusters), to_deque(column.singletons), stats.size, stats.entropy,
+                stats.nep, stats.relation_size, stats.inverted_entropy, stats.gini_impurity);
+        column_data.emplace_back(schema->GetColumn(i), std::move(pli));
+    }
+
+    return std::make_unique<ColumnLayoutRelationData>(std::move(schema), std::move(column_data));
+}
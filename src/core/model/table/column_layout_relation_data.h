@@ -14,6 +14,10 @@
 #include "core/model/table/relation_data.h"
 #include "core/model/table/relational_schema.h"
 
+namespace model {
+class RelationSnapshot;
+}  // namespace model
+
 class ColumnLayoutRelationData final : public RelationData {
 public:
     using RelationData::AbstractRelationData;
@@ -34,4 +38,6 @@ public:
             std::vector<unsigned int> const& indices) const;
 
     static std::unique_ptr<ColumnLayoutRelationData> CreateFrom(model::IDatasetStream& data_stream);
+    static std::unique_ptr<ColumnLayoutRelationData> CreateFrom(
+            model::RelationSnapshot const& snapshot);
 };
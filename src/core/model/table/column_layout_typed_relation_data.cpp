@@ -1,11 +1,17 @@
 #include "core/model/table/column_layout_typed_relation_data.h"
 
+#include "core/model/table/relation_snapshot.h"
 #include "core/util/logger.h"
 
 namespace model {
 
 std::unique_ptr<ColumnLayoutTypedRelationData> ColumnLayoutTypedRelationData::CreateFrom(
         IDatasetStream& data_stream, bool is_null_eq_null, bool treat_mixed_as_string) {
+    if (auto* snapshot_stream = dynamic_cast<SnapshotDatasetStream*>(&data_stream)) {
+        return CreateFrom(*snapshot_stream->GetSnapshot(), is_null_eq_null,
+                          treat_mixed_as_string);
+    }
+
     auto schema = std::make_unique<RelationalSchema>(data_stream.GetRelationName());
     size_t const num_columns = data_stream.GetNumberOfColumns();
 
@@ -46,4 +52,34 @@ std::unique_ptr<ColumnLayoutTypedRelationData> ColumnLayoutTypedRelationData::Cr
                                                            std::move(column_data));
 }
 
+std::unique_ptr<ColumnLayoutTypedRelationData> ColumnLayoutTypedRelationData::CreateFrom(
+        RelationSnapshot const& snapshot, bool is_null_eq_null, bool treat_mixed_as_string) {
+    auto schema = std::make_unique<RelationalSchema>(std::string{snapshot.GetRelationName()});
+    std::vector<TypedColumnData> column_data;
+    column_data.reserve(snapshot.GetNumColumns());
+    for (size_t i = 0; i < snapshot.GetNumColumns(); ++i) {
+        RelationSnapshot::ColumnView const& column = snapshot.GetColumn(i);
+        schema->AppendColumn(Column(schema.get(), std::string{column.name}, i));
+
+        std::vector<std::string> unparsed;
+        unparsed.reserve(snapshot.GetNumRows());
+        for (size_t row = 0; row != snapshot.GetNumRows(); ++row) {
+            unparsed.emplace_back(column.GetValue(row));
+        }
+
+        /* The stored layout was inferred with mixed columns kept as mixed */
+        if (treat_mixed_as_string && column.type_id == TypeId::kMixed) {
+            column_data.push_back(TypedColumnDataFactory::CreateFrom(
+                    schema->GetColumn(i), std::move(unparsed), is_null_eq_null, true));
+        } else {
+            column_data.push_back(TypedColumnDataFactory::CreateFrom(
+                    schema->GetColumn(i), std::move(unparsed), column.type_id,
+                    column.type_layout, is_null_eq_null));
+        }
+    }
+
+    return std::make_unique<ColumnLayoutTypedRelationData>(std::move(schema),
+                                                           std::move(column_data));
+}
+
 }  // namespace model
@@ -6,6 +6,8 @@
 
 namespace model {
 
+class RelationSnapshot;
+
 using TypedRelationData = AbstractRelationData<TypedColumnData>;
 
 class ColumnLayoutTypedRelationData final : public TypedRelationData {
@@ -23,6 +25,9 @@ public:
     static std::unique_ptr<ColumnLayoutTypedRelationData> CreateFrom(
             model::IDatasetStream& data_stream, bool is_null_eq_null,
             bool treat_mixed_as_string = false);
+    static std::unique_ptr<ColumnLayoutTypedRelationData> CreateFrom(
+            RelationSnapshot const& snapshot, bool is_null_eq_null,
+            bool treat_mixed_as_string = false);
 };
 
 }  // namespace model
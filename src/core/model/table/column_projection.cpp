@@ -0,0 +1,72 @@
+#include "core/model/table/column_projection.h"
+
+#include <algorithm>
+#include <numeric>
+#include <string>
+#include <utility>
+
+#include "core/config/exceptions.h"
+#include "core/model/table/dataset.h"
+#include "core/model/table/dataset_stream_projection.h"
+#include "core/model/table/relation_snapshot.h"
+
+namespace model {
+
+ColumnProjection::ColumnProjection(IDatasetStream const& stream, std::vector<ColumnIndex> columns)
+    : num_source_columns_(stream.GetNumberOfColumns()) {
+    bool const is_materialized = dynamic_cast<Dataset const*>(&stream) != nullptr ||
+                                 dynamic_cast<SnapshotDatasetStream const*>(&stream) != nullptr;
+    std::sort(columns.begin(), columns.end());
+    columns.erase(std::unique(columns.begin(), columns.end()), columns.end());
+    if (is_materialized || columns.size() == num_source_columns_) {
+        return;
+    }
+    loaded_columns_ = std::move(columns);
+}
+
+std::vector<ColumnIndex> ColumnProjection::GetLoadedColumns() const {
+    if (!IsIdentity()) {
+        return loaded_columns_;
+    }
+    std::vector<ColumnIndex> columns(num_source_columns_);
+    std::iota(columns.begin(), columns.end(), 0);
+    return columns;
+}
+
+std::shared_ptr<IDatasetStream> ColumnProjection::Apply(
+        std::shared_ptr<IDatasetStream> stream) const {
+    if (IsIdentity()) {
+        return stream;
+    }
+    return std::make_shared<DatasetStreamProjection<>>(std::move(stream), loaded_columns_);
+}
+
+ColumnIndex ColumnProjection::ToLoaded(ColumnIndex source_index) const {
+    if (IsIdentity()) {
+        return source_index;
+    }
+    auto it = std::lower_bound(loaded_columns_.begin(), loaded_columns_.end(), source_index);
+    if (it == loaded_columns_.end() || *it != source_index) {
+        throw config::ConfigurationError("Column " + std::to_string(source_index) +
+                                         " was not loaded, add it to load_columns");
+    }
+    return it - loaded_columns_.begin();
+}
+
+std::vector<ColumnIndex> ColumnProjection::ToLoaded(
+        std::vector<ColumnIndex> const& source_indices) const {
+    std::vector<ColumnIndex> loaded_indices;
+    loaded_indices.reserve(source_indices.size());
+    for (ColumnIndex index : source_indices) {
+        loaded_indices.push_back(ToLoaded(index));
+    }
+    return loaded_indices;
+}
+
+void ColumnProjection::CheckLoaded(std::vector<ColumnIndex> const& source_indices) const {
+    for (ColumnIndex index : source_indices) {
+        [[maybe_unused]] ColumnIndex loaded_index = ToLoaded(index);
+    }
+}
+
+}  // namespace model
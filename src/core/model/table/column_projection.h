@@ -0,0 +1,58 @@
+/** \file
+ * \brief Columns of a table that an algorithm loads
+ */
+#pragma once
+
+#include <cstddef>
+#include <memory>
+#include <vector>
+
+#include "core/model/table/column_index.h"
+#include "core/model/table/idataset_stream.h"
+
+namespace model {
+
+///
+/// \brief Subset of table columns an algorithm declared it needs before loading.
+///
+/// Apply wraps the table in a DatasetStreamProjection, so readers only unquote and store the
+/// values of the loaded columns. Loaded relations are numbered densely, while options of the
+/// algorithm keep the numbering of the original table; ToLoaded translates between the two.
+///
+/// \note Tables that are already materialized (a shared Dataset, a relation snapshot) are
+///       loaded whole: projecting them would only lose the shared representation.
+///
+class ColumnProjection {
+    /* Sorted indices of the loaded columns in the original table, empty if all are loaded */
+    std::vector<ColumnIndex> loaded_columns_;
+    size_t num_source_columns_ = 0;
+
+public:
+    ColumnProjection() = default;
+    ColumnProjection(IDatasetStream const& stream, std::vector<ColumnIndex> columns);
+
+    [[nodiscard]] bool IsIdentity() const noexcept {
+        return loaded_columns_.empty();
+    }
+
+    [[nodiscard]] size_t GetNumSourceColumns() const noexcept {
+        return num_source_columns_;
+    }
+
+    /// Indices of the loaded columns in the original table.
+    [[nodiscard]] std::vector<ColumnIndex> GetLoadedColumns() const;
+
+    [[nodiscard]] std::shared_ptr<IDatasetStream> Apply(
+            std::shared_ptr<IDatasetStream> stream) const;
+
+    /// Index of a column of the original table in the loaded relation. Throws
+    /// config::ConfigurationError if the column was not loaded.
+    [[nodiscard]] ColumnIndex ToLoaded(ColumnIndex source_index) const;
+    [[nodiscard]] std::vector<ColumnIndex> ToLoaded(
+            std::vector<ColumnIndex> const& source_indices) const;
+
+    /// Throws config::ConfigurationError if any of the columns was not loaded.
+    void CheckLoaded(std::vector<ColumnIndex> const& source_indices) const;
+};
+
+}  // namespace model
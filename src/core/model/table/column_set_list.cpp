@@ -0,0 +1,123 @@
+#include "core/model/table/column_set_list.h"
+
+#include <array>
+#include <bit>
+#include <numeric>
+
+namespace model {
+
+namespace {
+
+/* One stable counting sort pass of an LSD radix sort, by the byte of key(item) at shift.
+ * Leaves items as they are and returns false if all of them have the same byte there.
+ */
+template <typename T, typename Key>
+bool SortByByte(std::vector<T>& items, std::vector<T>& buffer, size_t shift, Key key) {
+    auto digit = [shift, &key](T const& item) { return (key(item) >> shift) & 0xFF; };
+    std::array<size_t, 256> offsets{};
+    for (T const& item : items) {
+        ++offsets[digit(item)];
+    }
+    if (offsets[digit(items.front())] == items.size()) {
+        return false;
+    }
+    std::exclusive_scan(offsets.begin(), offsets.end(), offsets.begin(), size_t{0});
+    buffer.resize(items.size());
+    for (T const& item : items) {
+        buffer[offsets[digit(item)]++] = item;
+    }
+    items.swap(buffer);
+    return true;
+}
+
+}  // namespace
+
+void ColumnSetList::SortAndDedup() {
+    if (Size() < 2) {
+        return;
+    }
+
+    if (num_words_ == 1) {
+        std::vector<Word> buffer;
+        for (size_t shift = 0; shift < kWordBits; shift += 8) {
+            SortByByte(words_, buffer, shift, [](Word word) { return word; });
+        }
+        words_.erase(std::unique(words_.begin(), words_.end()), words_.end());
+        return;
+    }
+
+    // rows are too wide to be moved on every pass, so their indices are sorted instead, least
+    // significant word first
+    std::vector<size_t> order(Size());
+    std::iota(order.begin(), order.end(), 0);
+    std::vector<size_t> buffer;
+    for (size_t w = 0; w < num_words_; ++w) {
+        for (size_t shift = 0; shift < kWordBits; shift += 8) {
+            SortByByte(order, buffer, shift, [this, w](size_t i) { return GetRow(i)[w]; });
+        }
+    }
+
+    std::vector<Word> sorted;
+    sorted.reserve(words_.size());
+    Word const* prev = nullptr;
+    for (size_t i : order) {
+        Word const* row = GetRow(i);
+        if (prev != nullptr && std::equal(row, row + num_words_, prev)) {
+            continue;
+        }
+        sorted.insert(sorted.end(), row, row + num_words_);
+        prev = row;
+    }
+    words_ = std::move(sorted);
+}
+
+void ColumnSetList::Invert() {
+    size_t const used_bits = num_columns_ % kWordBits;
+    Word const last_word_mask = used_bits == 0 ? ~Word{0} : (Word{1} << used_bits) - 1;
+    for (size_t i = 0; i < words_.size(); ++i) {
+        words_[i] = ~words_[i];
+        if (i % num_words_ == num_words_ - 1) {
+            words_[i] &= last_word_mask;
+        }
+    }
+}
+
+std::vector<unsigned> ColumnSetList::CountColumns() const {
+    std::vector<unsigned> counts(num_columns_);
+    for (size_t i = 0; i < Size(); ++i) {
+        Word const* row = GetRow(i);
+        for (size_t w = 0; w < num_words_; ++w) {
+            for (Word word = row[w]; word != 0; word &= word - 1) {
+                ++counts[w * kWordBits + std::countr_zero(word)];
+            }
+        }
+    }
+    return counts;
+}
+
+std::vector<ColumnSetList::Word> ColumnSetList::ToRow(
+        boost::dynamic_bitset<> const& indices) const {
+    std::vector<Word> row(num_words_);
+    for (size_t index = indices.find_first(); index != boost::dynamic_bitset<>::npos;
+         index = indices.find_next(index)) {
+        Set(row.data(), index);
+    }
+    return row;
+}
+
+boost::dynamic_bitset<> ColumnSetList::GetBitset(size_t i) const {
+    Word const* row = GetRow(i);
+    boost::dynamic_bitset<> indices(num_columns_);
+    for (size_t w = 0; w < num_words_; ++w) {
+        for (Word word = row[w]; word != 0; word &= word - 1) {
+            indices.set(w * kWordBits + std::countr_zero(word));
+        }
+    }
+    return indices;
+}
+
+Vertical ColumnSetList::GetVertical(size_t i, RelationalSchema const* schema) const {
+    return schema->GetVertical(GetBitset(i));
+}
+
+}  // namespace model
@@ -0,0 +1,147 @@
+#pragma once
+
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+#include <boost/dynamic_bitset.hpp>
+
+#include "core/model/table/relational_schema.h"
+#include "core/model/table/vertical.h"
+
+namespace model {
+
+/* List of column sets of one relation, such as agree sets or difference sets.
+ * Every set is a row of the same number of 64-bit words, bit i standing for column i, so the
+ * whole list is one flat buffer and set operations work a word at a time. After SortAndDedup
+ * the sets are distinct and ordered by their value as numbers, so every set comes after all of
+ * its subsets.
+ */
+class ColumnSetList {
+public:
+    using Word = std::uint64_t;
+    static constexpr size_t kWordBits = 64;
+
+private:
+    size_t num_columns_;
+    size_t num_words_;
+    std::vector<Word> words_;
+
+public:
+    explicit ColumnSetList(size_t num_columns = 0)
+        : num_columns_(num_columns),
+          num_words_(std::max<size_t>(1, (num_columns + kWordBits - 1) / kWordBits)) {}
+
+    size_t GetNumColumns() const noexcept {
+        return num_columns_;
+    }
+
+    size_t GetNumWords() const noexcept {
+        return num_words_;
+    }
+
+    size_t Size() const noexcept {
+        return words_.size() / num_words_;
+    }
+
+    bool Empty() const noexcept {
+        return words_.empty();
+    }
+
+    Word const* GetRow(size_t i) const noexcept {
+        return words_.data() + i * num_words_;
+    }
+
+    Word* GetRow(size_t i) noexcept {
+        return words_.data() + i * num_words_;
+    }
+
+    void Reserve(size_t num_sets) {
+        words_.reserve(num_sets * num_words_);
+    }
+
+    /* Removes the sets past num_sets or appends empty ones */
+    void Resize(size_t num_sets) {
+        words_.resize(num_sets * num_words_);
+    }
+
+    /* Appends an empty set and returns its row */
+    Word* AppendEmpty() {
+        words_.resize(words_.size() + num_words_);
+        return words_.data() + words_.size() - num_words_;
+    }
+
+    Word* Append(Word const* row) {
+        words_.insert(words_.end(), row, row + num_words_);
+        return words_.data() + words_.size() - num_words_;
+    }
+
+    void Append(ColumnSetList const& other) {
+        words_.insert(words_.end(), other.words_.begin(), other.words_.end());
+    }
+
+    /* Returns the list of the sets for which pred(i) is true */
+    template <typename Pred>
+    ColumnSetList Select(Pred pred) const {
+        ColumnSetList selected(num_columns_);
+        for (size_t i = 0; i < Size(); ++i) {
+            if (pred(i)) {
+                selected.Append(GetRow(i));
+            }
+        }
+        return selected;
+    }
+
+    static void Set(Word* row, size_t column) noexcept {
+        row[column / kWordBits] |= Word{1} << (column % kWordBits);
+    }
+
+    static void Reset(Word* row, size_t column) noexcept {
+        row[column / kWordBits] &= ~(Word{1} << (column % kWordBits));
+    }
+
+    static bool Test(Word const* row, size_t column) noexcept {
+        return (row[column / kWordBits] >> (column % kWordBits)) & 1;
+    }
+
+    bool Contains(size_t i, size_t column) const noexcept {
+        return Test(GetRow(i), column);
+    }
+
+    bool IsEmptySet(size_t i) const noexcept {
+        Word const* row = GetRow(i);
+        return std::all_of(row, row + num_words_, [](Word word) { return word == 0; });
+    }
+
+    bool IsSubset(Word const* subset, Word const* superset) const noexcept {
+        for (size_t w = 0; w < num_words_; ++w) {
+            if ((subset[w] & ~superset[w]) != 0) {
+                return false;
+            }
+        }
+        return true;
+    }
+
+    bool Intersects(Word const* lhs, Word const* rhs) const noexcept {
+        for (size_t w = 0; w < num_words_; ++w) {
+            if ((lhs[w] & rhs[w]) != 0) {
+                return true;
+            }
+        }
+        return false;
+    }
+
+    /* Sorts the sets by radix sort and removes duplicates */
+    void SortAndDedup();
+    /* Replaces every set with its complement. The sets have to be sorted again afterwards */
+    void Invert();
+    /* Returns the number of sets each column is contained in */
+    std::vector<unsigned> CountColumns() const;
+
+    std::vector<Word> ToRow(boost::dynamic_bitset<> const& indices) const;
+    boost::dynamic_bitset<> GetBitset(size_t i) const;
+    Vertical GetVertical(size_t i, RelationalSchema const* schema) const;
+};
+
+}  // namespace model
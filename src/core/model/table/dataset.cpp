@@ -0,0 +1,52 @@
+#include "core/model/table/dataset.h"
+
+#include "core/model/table/relation_snapshot.h"
+
+namespace model {
+
+std::shared_ptr<Dataset> Dataset::FromCsv(
+        CSVConfig const& csv_config, std::optional<std::filesystem::path> const& snapshot_dir) {
+    if (snapshot_dir.has_value()) {
+        RelationSnapshotCache cache(*snapshot_dir);
+        return std::make_shared<Dataset>(
+                std::make_shared<SnapshotDatasetStream>(cache.GetOrCreate(csv_config)));
+    }
+    return std::make_shared<Dataset>(std::make_shared<CSVParser>(csv_config));
+}
+
+std::shared_ptr<ColumnLayoutRelationData const> Dataset::GetRelation() {
+    return GetOrCreate<ColumnLayoutRelationData>("column_layout", [](IDatasetStream& stream) {
+        return std::shared_ptr<ColumnLayoutRelationData const>(
+                ColumnLayoutRelationData::CreateFrom(stream));
+    });
+}
+
+std::shared_ptr<ColumnLayoutTypedRelationData const> Dataset::GetTypedRelation(
+        bool is_null_eq_null, bool treat_mixed_as_string) {
+    std::string key = "typed:";
+    key += is_null_eq_null ? '1' : '0';
+    key += treat_mixed_as_string ? '1' : '0';
+    return GetOrCreate<ColumnLayoutTypedRelationData>(key, [&](IDatasetStream& stream) {
+        return std::shared_ptr<ColumnLayoutTypedRelationData const>(
+                ColumnLayoutTypedRelationData::CreateFrom(stream, is_null_eq_null,
+                                                          treat_mixed_as_string));
+    });
+}
+
+std::shared_ptr<ColumnLayoutRelationData const> LoadRelation(IDatasetStream& stream) {
+    if (auto* dataset = dynamic_cast<Dataset*>(&stream)) {
+        return dataset->GetRelation();
+    }
+    return ColumnLayoutRelationData::CreateFrom(stream);
+}
+
+std::shared_ptr<ColumnLayoutTypedRelationData const> LoadTypedRelation(
+        IDatasetStream& stream, bool is_null_eq_null, bool treat_mixed_as_string) {
+    if (auto* dataset = dynamic_cast<Dataset*>(&stream)) {
+        return dataset->GetTypedRelation(is_null_eq_null, treat_mixed_as_string);
+    }
+    return ColumnLayoutTypedRelationData::CreateFrom(stream, is_null_eq_null,
+                                                     treat_mixed_as_string);
+}
+
+}  // namespace model
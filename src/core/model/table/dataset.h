@@ -0,0 +1,118 @@
+/** \file
+ * \brief Table shared by several algorithms
+ */
+#pragma once
+
+#include <filesystem>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <optional>
+#include <string>
+#include <unordered_map>
+
+#include "core/model/table/column_layout_relation_data.h"
+#include "core/model/table/column_layout_typed_relation_data.h"
+#include "core/model/table/idataset_stream.h"
+#include "core/parser/csv_parser/csv_parser.h"
+
+namespace model {
+
+///
+/// \brief A table that is loaded once and reused by every algorithm it is passed to.
+///
+/// Dataset is an IDatasetStream, so it can be used as the value of any table option. Rows are
+/// read from the source stream as usual. Representations that algorithms build from the table
+/// (encoded columns with PLIs, typed columns, transactions) are materialized on first request
+/// and shared afterwards, so a profiling session that runs N algorithms parses and encodes the
+/// table once instead of N times.
+///
+/// Shared representations are handed out as pointers to const, since every algorithm run on the
+/// dataset reads the same object.
+///
+class Dataset final : public IDatasetStream {
+    std::shared_ptr<IDatasetStream> source_;
+    /* Guards the source stream while a representation is being built and the cache */
+    mutable std::mutex mutex_;
+    std::unordered_map<std::string, std::shared_ptr<void const>> representations_;
+
+public:
+    explicit Dataset(std::shared_ptr<IDatasetStream> source) : source_(std::move(source)) {}
+
+    /// Create a dataset from a CSV file. If snapshot_dir is set, the table is loaded through
+    /// a RelationSnapshotCache kept in that directory.
+    static std::shared_ptr<Dataset> FromCsv(
+            CSVConfig const& csv_config,
+            std::optional<std::filesystem::path> const& snapshot_dir = std::nullopt);
+
+    /// Get the representation stored under key or build it from the source stream with create.
+    /// The source stream is reset before and after create is called.
+    template <typename T>
+    std::shared_ptr<T const> GetOrCreate(
+            std::string const& key,
+            std::function<std::shared_ptr<T const>(IDatasetStream&)> const& create) {
+        std::lock_guard lock(mutex_);
+        auto it = representations_.find(key);
+        if (it != representations_.end()) {
+            return std::static_pointer_cast<T const>(it->second);
+        }
+        source_->Reset();
+        std::shared_ptr<T const> representation = create(*source_);
+        source_->Reset();
+        representations_.emplace(key, representation);
+        return representation;
+    }
+
+    std::shared_ptr<ColumnLayoutRelationData const> GetRelation();
+    std::shared_ptr<ColumnLayoutTypedRelationData const> GetTypedRelation(
+            bool is_null_eq_null, bool treat_mixed_as_string = false);
+
+    /// Number of representations currently materialized.
+    size_t GetNumRepresentations() const {
+        std::lock_guard lock(mutex_);
+        return representations_.size();
+    }
+
+    /// Drop all materialized representations. Algorithms that already hold one keep it alive.
+    void ReleaseRepresentations() {
+        std::lock_guard lock(mutex_);
+        representations_.clear();
+    }
+
+    Row GetNextRow() override {
+        return source_->GetNextRow();
+    }
+
+    Row GetNextProjectedRow(std::vector<ColumnIndex> const& column_indices) override {
+        return source_->GetNextProjectedRow(column_indices);
+    }
+
+    [[nodiscard]] bool HasNextRow() const override {
+        return source_->HasNextRow();
+    }
+
+    [[nodiscard]] size_t GetNumberOfColumns() const override {
+        return source_->GetNumberOfColumns();
+    }
+
+    [[nodiscard]] std::string GetColumnName(size_t index) const override {
+        return source_->GetColumnName(index);
+    }
+
+    [[nodiscard]] std::string GetRelationName() const override {
+        return source_->GetRelationName();
+    }
+
+    void Reset() override {
+        source_->Reset();
+    }
+};
+
+/// Build the column layout relation of a table, or get the shared one if the table is a Dataset.
+std::shared_ptr<ColumnLayoutRelationData const> LoadRelation(IDatasetStream& stream);
+
+/// Build the typed relation of a table, or get the shared one if the table is a Dataset.
+std::shared_ptr<ColumnLayoutTypedRelationData const> LoadTypedRelation(
+        IDatasetStream& stream, bool is_null_eq_null, bool treat_mixed_as_string = false);
+
+}  // namespace model
@@ -43,15 +43,7 @@ public:
     }
 
     Row GetNextRow() override {
-        Row projected_row;
-        projected_row.reserve(GetNumberOfColumns());
-
-        Row row = this->stream_->GetNextRow();
-        std::transform(column_indices_.begin(), column_indices_.end(),
-                       std::back_inserter(projected_row),
-                       [&row](ColumnIndex index) { return std::move(row[index]); });
-
-        return projected_row;
+        return this->stream_->GetNextProjectedRow(column_indices_);
     }
 
     [[nodiscard]] size_t GetNumberOfColumns() const override {
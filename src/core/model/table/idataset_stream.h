@@ -1,7 +1,9 @@
 #pragma once
 #include <string>
+#include <utility>
 #include <vector>
 
+#include "core/model/table/column_index.h"
 #include "core/util/export.h"
 
 namespace model {
@@ -11,6 +13,23 @@ public:
     using Row = std::vector<std::string>;
 
     virtual Row GetNextRow() = 0;
+
+    /// Read the next row keeping only the values of the given columns, in the given order.
+    /// Returns an empty row if the source row has the wrong number of values. Streams that can
+    /// skip unneeded values while parsing override this.
+    virtual Row GetNextProjectedRow(std::vector<ColumnIndex> const& column_indices) {
+        Row row = GetNextRow();
+        if (row.size() != GetNumberOfColumns()) {
+            return {};
+        }
+        Row projected_row;
+        projected_row.reserve(column_indices.size());
+        for (ColumnIndex index : column_indices) {
+            projected_row.push_back(std::move(row[index]));
+        }
+        return projected_row;
+    }
+
     [[nodiscard]] virtual bool HasNextRow() const = 0;
     [[nodiscard]] virtual size_t GetNumberOfColumns() const = 0;
     [[nodiscard]] virtual std::string GetColumnName(size_t index) const = 0;
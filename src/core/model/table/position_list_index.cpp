@@ -6,6 +6,7 @@
 #include "core/model/table/position_list_index.h"
 
 #include <algorithm>
+#include <atomic>
 #include <chrono>
 #include <cmath>
 #include <deque>
@@ -25,7 +26,7 @@ int const PositionListIndex::kSingletonValueId = 0;
 unsigned long long PositionListIndex::micros_ = 0;
 int PositionListIndex::intersection_count_ = 0;
 
-PositionListIndex::PositionListIndex(std::deque<std::vector<int>> index, unsigned int size,
+PositionListIndex::PositionListIndex(std::deque<Cluster> index, unsigned int size,
                                      double entropy, unsigned long long nep,
                                      unsigned int relation_size, double inverted_entropy,
                                      double gini_impurity)
@@ -39,7 +40,7 @@ PositionListIndex::PositionListIndex(std::deque<std::vector<int>> index, unsigne
       probing_table_cache_() {}
 
 std::unique_ptr<PositionListIndex> PositionListIndex::CreateFor(std::vector<int>& data) {
-    std::unordered_map<int, std::vector<int>> index;
+    std::unordered_map<int, Cluster> index;
     for (unsigned long position = 0; position < data.size(); ++position) {
         int value_id = data[position];
         index[value_id].push_back(position);
@@ -50,7 +51,7 @@ std::unique_ptr<PositionListIndex> PositionListIndex::CreateFor(std::vector<int>
     double gini_gap = 0;
     unsigned long long nep = 0;
     unsigned int size = 0;
-    std::deque<std::vector<int>> clusters;
+    std::deque<Cluster> clusters;
 
     for (auto& iter : index) {
         if (iter.second.size() == 1) {
@@ -97,9 +98,21 @@ std::unordered_map<int, unsigned> PositionListIndex::CreateFrequencies(
 //
 // }
 
-void PositionListIndex::SortClusters(std::deque<std::vector<int>>& clusters) {
-    sort(clusters.begin(), clusters.end(),
-         [](std::vector<int> const& a, std::vector<int> const& b) { return a[0] < b[0]; });
+void PositionListIndex::SortClusters(std::deque<Cluster>& clusters) {
+    // clusters from different memory resources must not be swapped, so they are sorted by
+    // pointers and then moved into place, and each of them keeps its resource
+    std::vector<Cluster*> order;
+    order.reserve(clusters.size());
+    for (Cluster& cluster : clusters) {
+        order.push_back(&cluster);
+    }
+    std::sort(order.begin(), order.end(),
+              [](Cluster const* a, Cluster const* b) { return (*a)[0] < (*b)[0]; });
+    std::deque<Cluster> sorted;
+    for (Cluster* cluster : order) {
+        sorted.push_back(std::move(*cluster));
+    }
+    clusters = std::move(sorted);
 }
 
 std::shared_ptr<std::vector<int> const> PositionListIndex::CalculateAndGetProbingTable() const {
@@ -134,25 +147,27 @@ std::shared_ptr<std::vector<int> const> PositionListIndex::CalculateAndGetProbin
 // }
 
 std::unique_ptr<PositionListIndex> PositionListIndex::Intersect(
-        PositionListIndex const* that) const {
+        PositionListIndex const* that, std::pmr::memory_resource* resource) const {
     assert(this->relation_size_ == that->relation_size_);
 
     if (this->size_ > that->size_) {
-        return that->Probe(this->CalculateAndGetProbingTable());
+        return that->Probe(this->CalculateAndGetProbingTable(), resource);
     } else {
-        return this->Probe(that->CalculateAndGetProbingTable());
+        return this->Probe(that->CalculateAndGetProbingTable(), resource);
     }
 }
 
 std::unique_ptr<PositionListIndex> PositionListIndex::Probe(
-        std::shared_ptr<std::vector<int> const> probing_table) const {
+        std::shared_ptr<std::vector<int> const> probing_table,
+        std::pmr::memory_resource* resource) const {
     assert(this->relation_size_ == probing_table->size());
-    std::deque<std::vector<int>> new_index;
+    std::deque<Cluster> new_index;
     unsigned int new_size = 0;
     double new_key_gap = 0.0;
     unsigned long long new_nep = 0;
 
-    std::unordered_map<int, std::vector<int>> partial_index;
+    std::unordered_map<int, Cluster> partial_index;
+    int probed_positions = 0;
 
     for (auto& positions : index_) {
         for (int position : positions) {
@@ -165,8 +180,9 @@ std::unique_ptr<PositionListIndex> PositionListIndex::Probe(
             }
             int probing_table_value_id = (*probing_table)[position];
             if (probing_table_value_id == kSingletonValueId) continue;
-            intersection_count_++;
-            partial_index[probing_table_value_id].push_back(position);
+            probed_positions++;
+            partial_index.try_emplace(probing_table_value_id, resource)
+                    .first->second.push_back(position);
         }
 
         for (auto& iter : partial_index) {
@@ -181,6 +197,8 @@ std::unique_ptr<PositionListIndex> PositionListIndex::Probe(
         }
         partial_index.clear();
     }
+    // PLIs may be probed from several threads at once, e.g. by parallel Pyro
+    std::atomic_ref(intersection_count_).fetch_add(probed_positions, std::memory_order_relaxed);
 
     double new_entropy = log(relation_size_) - new_key_gap / relation_size_;
     SortClusters(new_index);
@@ -190,14 +208,15 @@ std::unique_ptr<PositionListIndex> PositionListIndex::Probe(
 }
 
 std::unique_ptr<PositionListIndex> PositionListIndex::ProbeAll(
-        Vertical const& probing_columns, ColumnLayoutRelationData& relation_data) {
+        Vertical const& probing_columns, ColumnLayoutRelationData const& relation_data,
+        std::pmr::memory_resource* resource) const {
     assert(this->relation_size_ == relation_data.GetNumRows());
-    std::deque<std::vector<int>> new_index;
+    std::deque<Cluster> new_index;
     unsigned int new_size = 0;
     double new_key_gap = 0.0;
     unsigned long long new_nep = 0;
 
-    std::map<std::vector<int>, std::vector<int>> partial_index;
+    std::map<std::vector<int>, Cluster> partial_index;
     std::vector<int> probe;
 
     for (auto& cluster : this->index_) {
@@ -207,7 +226,7 @@ std::unique_ptr<PositionListIndex> PositionListIndex::ProbeAll(
                 continue;
             }
 
-            partial_index[probe].push_back(position);
+            partial_index.try_emplace(probe, resource).first->second.push_back(position);
             probe.clear();
         }
 
@@ -232,7 +251,7 @@ std::unique_ptr<PositionListIndex> PositionListIndex::ProbeAll(
                                                this->relation_size_, this->relation_size_);
 }
 
-bool PositionListIndex::TakeProbe(int position, ColumnLayoutRelationData& relation_data,
+bool PositionListIndex::TakeProbe(int position, ColumnLayoutRelationData const& relation_data,
                                   Vertical const& probing_columns, std::vector<int>& probe) {
     boost::dynamic_bitset<> probing_indices = probing_columns.GetColumnIndices();
     for (unsigned long index = probing_indices.find_first(); index < probing_indices.size();
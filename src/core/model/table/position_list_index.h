@@ -4,8 +4,10 @@
 //
 
 #pragma once
+#include <atomic>
 #include <deque>
 #include <memory>
+#include <memory_resource>
 #include <unordered_map>
 #include <vector>
 
@@ -17,8 +19,9 @@ namespace model {
 
 class PositionListIndex {
 public:
-    /* Vector of tuple indices */
-    using Cluster = std::vector<int>;
+    /* Vector of tuple indices. Clusters take nearly all the memory of a PLI, so the PLIs an
+     * algorithm computes during a run may take them from its arena, see Intersect */
+    using Cluster = std::pmr::vector<int>;
 
 protected:
     std::deque<Cluster> index_;
@@ -30,7 +33,7 @@ protected:
     }
 
     static void SortClusters(std::deque<Cluster>& clusters);
-    static bool TakeProbe(int position, ColumnLayoutRelationData& relation_data,
+    static bool TakeProbe(int position, ColumnLayoutRelationData const& relation_data,
                           Vertical const& probing_columns, std::vector<int>& probe);
 
 private:
@@ -39,7 +42,8 @@ private:
     double gini_impurity_;
     unsigned long long nep_;
     std::shared_ptr<std::vector<int> const> probing_table_cache_;
-    unsigned int freq_ = 0;
+    // usage counter of PLI caches, not a property of the partition
+    mutable unsigned int freq_ = 0;
 
 public:
     static int intersection_count_;
@@ -100,8 +104,9 @@ public:
         return index_.size() + relation_size_ - size_;
     }
 
+    // Pyro's workers increment the counter while others read it, see IncFreq
     unsigned int GetFreq() const {
-        return freq_;
+        return std::atomic_ref(freq_).load(std::memory_order_relaxed);
     }
 
     unsigned int GetSize() const {
@@ -140,15 +145,22 @@ public:
         return relation_size_ <= 1 || (GetNumNonSingletonCluster() == 1 && size_ == relation_size_);
     }
 
-    void IncFreq() {
-        freq_++;
+    // cached PLIs are shared by the workers of a parallel run and by the algorithms run on the
+    // same dataset
+    void IncFreq() const {
+        std::atomic_ref(freq_).fetch_add(1, std::memory_order_relaxed);
     }
 
-    std::unique_ptr<PositionListIndex> Intersect(PositionListIndex const* that) const;
+    /* The clusters of the resulting PLI are allocated from resource */
+    std::unique_ptr<PositionListIndex> Intersect(
+            PositionListIndex const* that,
+            std::pmr::memory_resource* resource = std::pmr::get_default_resource()) const;
     std::unique_ptr<PositionListIndex> Probe(
-            std::shared_ptr<std::vector<int> const> probing_table) const;
-    std::unique_ptr<PositionListIndex> ProbeAll(Vertical const& probing_columns,
-                                                ColumnLayoutRelationData& relation_data);
+            std::shared_ptr<std::vector<int> const> probing_table,
+            std::pmr::memory_resource* resource = std::pmr::get_default_resource()) const;
+    std::unique_ptr<PositionListIndex> ProbeAll(
+            Vertical const& probing_columns, ColumnLayoutRelationData const& relation_data,
+            std::pmr::memory_resource* resource = std::pmr::get_default_resource()) const;
     std::string ToString() const;
 };
 
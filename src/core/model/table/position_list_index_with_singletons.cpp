@@ -5,6 +5,7 @@
 #include "position_list_index_with_singletons.h"
 
 #include <algorithm>
+#include <atomic>
 #include <chrono>
 #include <cmath>
 #include <deque>
@@ -19,20 +20,19 @@
 #include "core/util/logger.h"
 
 namespace model {
-PLIWithSingletons::PLIWithSingletons(std::deque<std::vector<int>> index,
-                                     std::deque<std::vector<int>> singletons, unsigned int size,
-                                     double entropy, unsigned long long nep,
+PLIWithSingletons::PLIWithSingletons(std::deque<Cluster> index, std::deque<Cluster> singletons,
+                                     unsigned int size, double entropy, unsigned long long nep,
                                      unsigned int relation_size, double inverted_entropy,
                                      double gini_impurity)
-    : PositionListIndex(index, size, entropy, nep, relation_size, inverted_entropy, gini_impurity),
+    : PositionListIndex(std::move(index), size, entropy, nep, relation_size, inverted_entropy,
+                        gini_impurity),
       singletons_(std::move(singletons)) {}
 
 PLIWithSingletons::PLIWithSingletons(std::unique_ptr<PositionListIndex> positional_list_index)
     : PositionListIndex(*positional_list_index.get()) {
     Cluster sngt;
 
-    std::shared_ptr<model::PositionListIndex::Cluster const> probing_table =
-            CalculateAndGetProbingTable();
+    std::shared_ptr<std::vector<int> const> probing_table = CalculateAndGetProbingTable();
 
     for (size_t position = 0; position < probing_table->size(); position++) {
         if ((*probing_table)[position] == kSingletonValueId) sngt.push_back(position);
@@ -42,7 +42,7 @@ PLIWithSingletons::PLIWithSingletons(std::unique_ptr<PositionListIndex> position
 }
 
 std::unique_ptr<PLIWithSingletons> PLIWithSingletons::CreateFor(std::vector<int>& data) {
-    std::unordered_map<int, std::vector<int>> index;
+    std::unordered_map<int, Cluster> index;
     for (unsigned long position = 0; position < data.size(); ++position) {
         int value_id = data[position];
         index[value_id].push_back(position);
@@ -53,8 +53,8 @@ std::unique_ptr<PLIWithSingletons> PLIWithSingletons::CreateFor(std::vector<int>
     double gini_gap = 0;
     unsigned long long nep = 0;
     unsigned int size = 0;
-    std::deque<std::vector<int>> clusters;
-    std::deque<std::vector<int>> singletons;
+    std::deque<Cluster> clusters;
+    std::deque<Cluster> singletons;
 
     for (auto& iter : index) {
         if (iter.second.size() == 1) {
@@ -85,16 +85,21 @@ std::unique_ptr<PLIWithSingletons> PLIWithSingletons::CreateFor(std::vector<int>
 }
 
 std::unique_ptr<PLIWithSingletons> PLIWithSingletons::Probe(
-        std::shared_ptr<std::vector<int> const> probing_table) const {
+        std::shared_ptr<std::vector<int> const> probing_table,
+        std::pmr::memory_resource* resource) const {
     if (this->relation_size_ != probing_table->size())
         throw std::invalid_argument("received different number of rows");
-    std::deque<std::vector<int>> new_index;
-    std::deque<std::vector<int>> singletons(singletons_);
+    std::deque<Cluster> new_index;
+    std::deque<Cluster> singletons;
+    for (Cluster const& singleton : singletons_) {
+        singletons.emplace_back(singleton, resource);
+    }
     unsigned int new_size = 0;
     double new_key_gap = 0.0;
     unsigned long long new_nep = 0;
 
-    std::unordered_map<int, std::vector<int>> partial_index;
+    std::unordered_map<int, Cluster> partial_index;
+    int probed_positions = 0;
 
     for (auto& positions : index_) {
         for (int position : positions) {
@@ -107,11 +112,13 @@ std::unique_ptr<PLIWithSingletons> PLIWithSingletons::Probe(
             }
             int probing_table_value_id = (*probing_table)[position];
             if (probing_table_value_id == kSingletonValueId) {
-                partial_index[kSingletonValueId].push_back(position);
+                partial_index.try_emplace(kSingletonValueId, resource)
+                        .first->second.push_back(position);
                 continue;
             }
-            intersection_count_++;
-            partial_index[probing_table_value_id].push_back(position);
+            probed_positions++;
+            partial_index.try_emplace(probing_table_value_id, resource)
+                    .first->second.push_back(position);
         }
 
         for (auto& iter : partial_index) {
@@ -129,6 +136,8 @@ std::unique_ptr<PLIWithSingletons> PLIWithSingletons::Probe(
         }
         partial_index.clear();
     }
+    // PLIs may be probed from several threads at once, e.g. by parallel Pyro
+    std::atomic_ref(intersection_count_).fetch_add(probed_positions, std::memory_order_relaxed);
 
     double new_entropy = log(relation_size_) - new_key_gap / relation_size_;
     SortClusters(singletons);
@@ -140,27 +149,32 @@ std::unique_ptr<PLIWithSingletons> PLIWithSingletons::Probe(
 }
 
 std::unique_ptr<PLIWithSingletons> PLIWithSingletons::ProbeAll(
-        Vertical const& probing_columns, ColumnLayoutRelationData& relation_data) {
+        Vertical const& probing_columns, ColumnLayoutRelationData const& relation_data,
+        std::pmr::memory_resource* resource) {
     if (this->relation_size_ != relation_data.GetNumRows())
         throw std::invalid_argument("received different number of rows");
-    std::deque<std::vector<int>> new_index;
-    std::deque<std::vector<int>> singletons(singletons_);
+    std::deque<Cluster> new_index;
+    std::deque<Cluster> singletons;
+    for (Cluster const& singleton : singletons_) {
+        singletons.emplace_back(singleton, resource);
+    }
     unsigned int new_size = 0;
     double new_key_gap = 0.0;
     unsigned long long new_nep = 0;
 
-    std::map<std::vector<int>, std::vector<int>> partial_index;
+    std::map<std::vector<int>, Cluster> partial_index;
     std::vector<int> probe;
 
     for (auto& cluster : this->index_) {
         for (int position : cluster) {
             if (!TakeProbe(position, relation_data, probing_columns, probe)) {
-                partial_index[{kSingletonValueId}].push_back(position);
+                partial_index.try_emplace({kSingletonValueId}, resource)
+                        .first->second.push_back(position);
                 probe.clear();
                 continue;
             }
 
-            partial_index[probe].push_back(position);
+            partial_index.try_emplace(probe, resource).first->second.push_back(position);
             probe.clear();
         }
 
@@ -190,14 +204,14 @@ std::unique_ptr<PLIWithSingletons> PLIWithSingletons::ProbeAll(
 }
 
 std::unique_ptr<PLIWithSingletons> PLIWithSingletons::Intersect(
-        PLIWithSingletons const* that) const {
+        PLIWithSingletons const* that, std::pmr::memory_resource* resource) const {
     if (this->relation_size_ != that->relation_size_)
         throw std::invalid_argument("different size of relations");
 
     if (this->size_ > that->size_) {
-        return that->Probe(this->CalculateAndGetProbingTable());
+        return that->Probe(this->CalculateAndGetProbingTable(), resource);
     }
-    return this->Probe(that->CalculateAndGetProbingTable());
+    return this->Probe(that->CalculateAndGetProbingTable(), resource);
 }
 
 }  // namespace model
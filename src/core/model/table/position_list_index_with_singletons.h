@@ -5,6 +5,7 @@
 #pragma once
 #include <deque>
 #include <memory>
+#include <memory_resource>
 #include <unordered_map>
 #include <vector>
 
@@ -35,13 +36,18 @@ public:
         return all_clusters;
     }
 
-    std::unique_ptr<PLIWithSingletons> ProbeAll(Vertical const& probing_columns,
-                                                ColumnLayoutRelationData& relation_data);
+    /* The clusters of the resulting PLI, singletons included, are allocated from resource */
+    std::unique_ptr<PLIWithSingletons> ProbeAll(
+            Vertical const& probing_columns, ColumnLayoutRelationData const& relation_data,
+            std::pmr::memory_resource* resource = std::pmr::get_default_resource());
 
     std::unique_ptr<PLIWithSingletons> Probe(
-            std::shared_ptr<std::vector<int> const> probing_table) const;
+            std::shared_ptr<std::vector<int> const> probing_table,
+            std::pmr::memory_resource* resource = std::pmr::get_default_resource()) const;
 
-    std::unique_ptr<PLIWithSingletons> Intersect(PLIWithSingletons const* that) const;
+    std::unique_ptr<PLIWithSingletons> Intersect(
+            PLIWithSingletons const* that,
+            std::pmr::memory_resource* resource = std::pmr::get_default_resource()) const;
 
     unsigned int GetSizeWithSngltns() const {
         return size_ + singletons_.size();
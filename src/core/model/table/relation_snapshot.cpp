@@ -0,0 +1,434 @@
+#include "core/model/table/relation_snapshot.h"
+
+#include <algorithm>
+#include <cstring>
+#include <fstream>
+#include <random>
+#include <stdexcept>
+#include <string_view>
+#include <system_error>
+#include <type_traits>
+#include <unordered_map>
+
+#include <magic_enum/magic_enum.hpp>
+
+#include "core/model/table/column.h"
+#include "core/model/table/position_list_index_with_singletons.h"
+#include "core/model/table/relational_schema.h"
+#include "core/model/table/typed_column_data.h"
+#include "core/util/logger.h"
+
+namespace {
+
+using model::RelationSnapshot;
+
+constexpr char kMagic[8] = {'D', 'E', 'S', 'B', 'S', 'N', 'A', 'P'};
+constexpr size_t kAlignment = 8;
+
+struct FileHeader {
+    char magic[8];
+    std::uint32_t version;
+    std::uint32_t reserved;
+    std::uint64_t file_size;
+    std::int64_t mtime;
+    std::uint64_t path_size;
+    std::uint64_t relation_name_size;
+    std::uint64_t num_rows;
+    std::uint64_t num_columns;
+    char separator;
+    std::uint8_t has_header;
+    std::uint8_t padding[6];
+};
+
+struct ColumnHeader {
+    std::uint64_t name_size;
+    RelationSnapshot::PliStats pli_stats;
+    std::uint64_t num_clusters;
+    std::uint64_t num_cluster_rows;
+    std::uint64_t num_singletons;
+    std::uint64_t num_singleton_rows;
+    std::uint64_t values_size;
+    model::TypeId type_id;
+    std::uint8_t padding[7];
+};
+
+static_assert(std::is_trivially_copyable_v<FileHeader> && sizeof(FileHeader) % kAlignment == 0);
+static_assert(std::is_trivially_copyable_v<ColumnHeader> &&
+              sizeof(ColumnHeader) % kAlignment == 0);
+static_assert(sizeof(model::TypeId) == 1);
+
+class Writer {
+    std::ofstream out_;
+    size_t written_ = 0;
+
+public:
+    explicit Writer(std::filesystem::path const& path) : out_(path, std::ios::binary) {
+        if (!out_) {
+            throw std::runtime_error("Cannot create relation snapshot " + path.string());
+        }
+    }
+
+    template <typename T>
+    void WriteArray(T const* data, size_t count) {
+        static_assert(std::is_trivially_copyable_v<T>);
+        size_t const bytes = sizeof(T) * count;
+        out_.write(reinterpret_cast<char const*>(data), bytes);
+        written_ += bytes;
+        if (size_t const remainder = written_ % kAlignment; remainder != 0) {
+            static constexpr char kZeros[kAlignment] = {};
+            out_.write(kZeros, kAlignment - remainder);
+            written_ += kAlignment - remainder;
+        }
+    }
+
+    template <typename T>
+    void Write(T const& value) {
+        WriteArray(&value, 1);
+    }
+
+    void Write(std::string_view str) {
+        WriteArray(str.data(), str.size());
+    }
+
+    void WriteClusters(std::deque<model::PLI::Cluster> const& clusters) {
+        std::vector<std::uint64_t> offsets;
+        offsets.reserve(clusters.size() + 1);
+        offsets.push_back(0);
+        for (auto const& cluster : clusters) {
+            offsets.push_back(offsets.back() + cluster.size());
+        }
+        WriteArray(offsets.data(), offsets.size());
+
+        std::vector<int> rows;
+        rows.reserve(offsets.back());
+        for (auto const& cluster : clusters) {
+            rows.insert(rows.end(), cluster.begin(), cluster.end());
+        }
+        WriteArray(rows.data(), rows.size());
+    }
+
+    void Close() {
+        out_.close();
+        if (!out_) throw std::runtime_error("Failed to write relation snapshot");
+    }
+};
+
+/* Offsets into an array of the given size are used to slice it without further checks, so they
+ * must start at 0, never decrease and end at the size */
+bool AreValidOffsets(std::span<std::uint64_t const> offsets, std::uint64_t size) {
+    return !offsets.empty() && offsets.front() == 0 && offsets.back() == size &&
+           std::ranges::is_sorted(offsets);
+}
+
+/* Row ids index the probing tables and typed columns built from the snapshot */
+bool AreValidRows(std::span<int const> rows, std::uint64_t num_rows) {
+    return std::ranges::all_of(rows, [num_rows](int row) {
+        return row >= 0 && static_cast<std::uint64_t>(row) < num_rows;
+    });
+}
+
+bool AreValidTypes(std::span<model::TypeId const> type_ids) {
+    return std::ranges::all_of(type_ids, [](model::TypeId type_id) {
+        return magic_enum::enum_contains<model::TypeId>(type_id);
+    });
+}
+
+class Reader {
+    std::byte const* begin_;
+    size_t size_;
+    size_t pos_ = 0;
+
+public:
+    Reader(void const* data, size_t size)
+        : begin_(static_cast<std::byte const*>(data)), size_(size) {}
+
+    template <typename T>
+    std::span<T const> TakeArray(size_t count) {
+        static_assert(alignof(T) <= kAlignment);
+        if (count > (size_ - pos_) / sizeof(T)) {
+            throw std::runtime_error("Relation snapshot is truncated");
+        }
+        std::span<T const> result{reinterpret_cast<T const*>(begin_ + pos_), count};
+        pos_ += sizeof(T) * count;
+        pos_ = std::min(size_, (pos_ + kAlignment - 1) / kAlignment * kAlignment);
+        return result;
+    }
+
+    template <typename T>
+    T const& Take() {
+        return TakeArray<T>(1).front();
+    }
+
+    std::string_view TakeString(size_t size) {
+        std::span<char const> chars = TakeArray<char>(size);
+        return {chars.data(), chars.size()};
+    }
+
+    RelationSnapshot::Clusters TakeClusters(size_t num_clusters, size_t num_cluster_rows,
+                                            size_t num_rows) {
+        RelationSnapshot::Clusters clusters;
+        clusters.offsets = TakeArray<std::uint64_t>(num_clusters + 1);
+        clusters.rows = TakeArray<int>(num_cluster_rows);
+        if (!AreValidOffsets(clusters.offsets, num_cluster_rows) ||
+            !AreValidRows(clusters.rows, num_rows)) {
+            throw std::runtime_error("Relation snapshot is corrupted");
+        }
+        return clusters;
+    }
+};
+
+/* FNV-1a, stable across platforms and builds, unlike std::hash */
+class Fnv1a {
+    std::uint64_t hash_ = 0xcbf29ce484222325ULL;
+
+public:
+    template <typename T>
+    void Add(T const& value) {
+        Add(std::string_view{reinterpret_cast<char const*>(&value), sizeof(value)});
+    }
+
+    void Add(std::string_view bytes) {
+        for (char c : bytes) {
+            hash_ ^= static_cast<unsigned char>(c);
+            hash_ *= 0x100000001b3ULL;
+        }
+    }
+
+    std::uint64_t Get() const noexcept {
+        return hash_;
+    }
+};
+
+}  // namespace
+
+namespace model {
+
+RelationSnapshotKey RelationSnapshotKey::For(CSVConfig const& csv_config) {
+    std::filesystem::path const canonical = std::filesystem::canonical(csv_config.path);
+    RelationSnapshotKey key;
+    key.path = canonical.string();
+    key.file_size = std::filesystem::file_size(canonical);
+    key.mtime = std::filesystem::last_write_time(canonical).time_since_epoch().count();
+    key.separator = csv_config.separator;
+    key.has_header = csv_config.has_header;
+    return key;
+}
+
+std::string RelationSnapshotKey::Digest() const {
+    Fnv1a hash;
+    hash.Add(std::string_view{path});
+    hash.Add(file_size);
+    hash.Add(mtime);
+    hash.Add(separator);
+    hash.Add(has_header);
+    hash.Add(RelationSnapshot::kVersion);
+
+    static constexpr char kHexDigits[] = "0123456789abcdef";
+    std::string digest(16, '0');
+    std::uint64_t value = hash.Get();
+    for (auto it = digest.rbegin(); it != digest.rend(); ++it, value >>= 4) {
+        *it = kHexDigits[value & 0xf];
+    }
+    return digest;
+}
+
+RelationSnapshot::RelationSnapshot(std::filesystem::path const& path) {
+    namespace bip = boost::interprocess;
+    try {
+        file_ = bip::file_mapping(path.c_str(), bip::read_only);
+        region_ = bip::mapped_region(file_, bip::read_only);
+    } catch (bip::interprocess_exception const& e) {
+        throw std::runtime_error("Cannot map relation snapshot " + path.string() + ": " +
+                                 e.what());
+    }
+
+    Reader reader(region_.get_address(), region_.get_size());
+    FileHeader const& header = reader.Take<FileHeader>();
+    if (std::memcmp(header.magic, kMagic, sizeof(kMagic)) != 0 || header.version != kVersion) {
+        throw std::runtime_error(path.string() + " is not a compatible relation snapshot");
+    }
+    key_.path = reader.TakeString(header.path_size);
+    key_.file_size = header.file_size;
+    key_.mtime = header.mtime;
+    key_.separator = header.separator;
+    key_.has_header = header.has_header;
+    relation_name_ = reader.TakeString(header.relation_name_size);
+    num_rows_ = header.num_rows;
+
+    columns_.reserve(header.num_columns);
+    for (size_t i = 0; i != header.num_columns; ++i) {
+        ColumnHeader const& column_header = reader.Take<ColumnHeader>();
+        ColumnView column;
+        column.name = reader.TakeString(column_header.name_size);
+        column.pli_stats = &column_header.pli_stats;
+        column.clusters = reader.TakeClusters(column_header.num_clusters,
+                                              column_header.num_cluster_rows, num_rows_);
+        column.singletons = reader.TakeClusters(column_header.num_singletons,
+                                                column_header.num_singleton_rows, num_rows_);
+        column.type_id = column_header.type_id;
+        column.type_layout = reader.TakeArray<TypeId>(num_rows_);
+        column.value_offsets = reader.TakeArray<std::uint64_t>(num_rows_ + 1);
+        column.values = reader.TakeString(column_header.values_size);
+        if (!AreValidOffsets(column.value_offsets, column_header.values_size) ||
+            !AreValidTypes({&column.type_id, 1}) || !AreValidTypes(column.type_layout)) {
+            throw std::runtime_error("Relation snapshot is corrupted");
+        }
+        columns_.push_back(column);
+    }
+}
+
+std::shared_ptr<RelationSnapshot const> RelationSnapshot::Open(std::filesystem::path const& path) {
+    return std::shared_ptr<RelationSnapshot const>(new RelationSnapshot(path));
+}
+
+void RelationSnapshot::Write(std::filesystem::path const& path, RelationSnapshotKey const& key,
+                             IDatasetStream& stream) {
+    size_t const num_columns = stream.GetNumberOfColumns();
+    std::vector<std::vector<std::string>> columns(num_columns);
+    while (stream.HasNextRow()) {
+        std::vector<std::string> row = stream.GetNextRow();
+        if (row.size() != num_columns) {
+            LOG_WARN(
+                    "Unexpected number of columns for a row, "
+                    "skipping (expected {}, got {})",
+                    num_columns, row.size());
+            continue;
+        }
+        for (size_t index = 0; index < row.size(); ++index) {
+            columns[index].push_back(std::move(row[index]));
+        }
+    }
+    size_t const num_rows = columns.empty() ? 0 : columns.front().size();
+    std::string const relation_name = stream.GetRelationName();
+
+    RelationalSchema schema(relation_name);
+    for (size_t i = 0; i < num_columns; ++i) {
+        schema.AppendColumn(Column(&schema, stream.GetColumnName(i), i));
+    }
+
+    std::filesystem::path tmp_path = path;
+    tmp_path += ".tmp" + std::to_string(std::random_device{}());
+    Writer writer(tmp_path);
+
+    FileHeader header{};
+    std::memcpy(header.magic, kMagic, sizeof(kMagic));
+    header.version = kVersion;
+    header.file_size = key.file_size;
+    header.mtime = key.mtime;
+    header.path_size = key.path.size();
+    header.relation_name_size = relation_name.size();
+    header.num_rows = num_rows;
+    header.num_columns = num_columns;
+    header.separator = key.separator;
+    header.has_header = key.has_header;
+    writer.Write(header);
+    writer.Write(std::string_view{key.path});
+    writer.Write(std::string_view{relation_name});
+
+    for (size_t i = 0; i < num_columns; ++i) {
+        std::vector<std::string>& values = columns[i];
+
+        std::unordered_map<std::string_view, int> value_dictionary;
+        std::vector<int> codes;
+        codes.reserve(num_rows);
+        for (std::string const& value : values) {
+            codes.push_back(
+                    value_dictionary.try_emplace(value, value_dictionary.size()).first->second);
+        }
+        value_dictionary.clear();
+        std::unique_ptr<PLIWithSingletons> pli = PLIWithSingletons::CreateFor(codes);
+
+        /* Only the type layout is stored: values of string-like types own heap memory, so they
+         * are re-created from the raw values on load, which is cheap compared to inference */
+        std::vector<TypeId> type_layout;
+        type_layout.reserve(num_rows);
+        TypeId type_id;
+        {
+            TypedColumnData typed = TypedColumnDataFactory::CreateFrom(
+                    schema.GetColumn(i), values, /*is_null_equal_null=*/true,
+                    /*treat_mixed_as_string=*/false);
+            type_id = typed.GetTypeId();
+            for (size_t row = 0; row != num_rows; ++row) {
+                type_layout.push_back(typed.GetValueTypeId(row));
+            }
+        }
+
+        std::vector<std::uint64_t> value_offsets;
+        value_offsets.reserve(num_rows + 1);
+        value_offsets.push_back(0);
+        std::string joined_values;
+        for (std::string const& value : values) {
+            joined_values += value;
+            value_offsets.push_back(joined_values.size());
+        }
+        values = {};
+
+        std::string const name = schema.GetColumn(i)->GetName();
+        ColumnHeader column_header{};
+        column_header.name_size = name.size();
+        column_header.pli_stats = {pli->GetSize(),           pli->GetRelationSize(),
+                                   pli->GetNepAsLong(),      pli->GetEntropy(),
+                                   pli->GetInvertedEntropy(), pli->GetGiniImpurity()};
+        column_header.num_clusters = pli->GetIndex().size();
+        column_header.num_cluster_rows = pli->GetSize();
+        column_header.num_singletons = pli->GetSingletons().size();
+        column_header.num_singleton_rows = 0;
+        for (auto const& singleton : pli->GetSingletons()) {
+            column_header.num_singleton_rows += singleton.size();
+        }
+        column_header.values_size = joined_values.size();
+        column_header.type_id = type_id;
+
+        writer.Write(column_header);
+        writer.Write(std::string_view{name});
+        writer.WriteClusters(pli->GetIndex());
+        writer.WriteClusters(pli->GetSingletons());
+        writer.WriteArray(type_layout.data(), type_layout.size());
+        writer.WriteArray(value_offsets.data(), value_offsets.size());
+        writer.Write(std::string_view{joined_values});
+    }
+    writer.Close();
+
+    std::filesystem::rename(tmp_path, path);
+}
+
+RelationSnapshotCache::RelationSnapshotCache(std::filesystem::path directory)
+    : directory_(std::move(directory)) {
+    std::filesystem::create_directories(directory_);
+}
+
+std::filesystem::path RelationSnapshotCache::GetSnapshotPath(RelationSnapshotKey const& key) const {
+    return directory_ / (key.Digest() + ".snapshot");
+}
+
+std::shared_ptr<RelationSnapshot const> RelationSnapshotCache::GetOrCreate(
+        CSVConfig const& csv_config) const {
+    RelationSnapshotKey const key = RelationSnapshotKey::For(csv_config);
+    std::filesystem::path const path = GetSnapshotPath(key);
+
+    if (std::error_code ec; std::filesystem::exists(path, ec)) {
+        try {
+            std::shared_ptr<RelationSnapshot const> snapshot = RelationSnapshot::Open(path);
+            if (snapshot->GetKey() == key) return snapshot;
+            LOG_INFO("Relation snapshot {} is stale, rebuilding", path.string());
+        } catch (std::runtime_error const& e) {
+            LOG_WARN("Ignoring relation snapshot {}: {}", path.string(), e.what());
+        }
+    }
+
+    CSVParser parser(csv_config);
+    RelationSnapshot::Write(path, key, parser);
+    return RelationSnapshot::Open(path);
+}
+
+IDatasetStream::Row SnapshotDatasetStream::GetNextRow() {
+    Row row;
+    row.reserve(snapshot_->GetNumColumns());
+    for (size_t i = 0; i != snapshot_->GetNumColumns(); ++i) {
+        row.emplace_back(snapshot_->GetColumn(i).GetValue(next_row_));
+    }
+    ++next_row_;
+    return row;
+}
+
+}  // namespace model
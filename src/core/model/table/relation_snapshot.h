@@ -0,0 +1,183 @@
+/** \file
+ * \brief Binary, memory-mappable snapshot of a parsed relation
+ *
+ * A snapshot stores everything the relation factories compute from a CSV file: PLIs with
+ * singletons for ColumnLayoutRelationData, the per-row type layout for
+ * ColumnLayoutTypedRelationData and the raw field values. Loading from a snapshot skips
+ * tokenizing, dictionary encoding and regex-based type inference, but it is not zero-copy: the
+ * clusters are copied into the relation's PLIs, and typed values are parsed again from the
+ * stored raw values along the stored layout. The file is mapped read-only, so only the snapshot
+ * itself is shared between processes working on it.
+ */
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <filesystem>
+#include <memory>
+#include <span>
+#include <string>
+#include <string_view>
+#include <vector>
+
+#include <boost/interprocess/file_mapping.hpp>
+#include <boost/interprocess/mapped_region.hpp>
+
+#include "core/model/table/idataset_stream.h"
+#include "core/model/types/builtin.h"
+#include "core/parser/csv_parser/csv_parser.h"
+
+namespace model {
+
+/// Identity of the source file and the parse options a snapshot was built with. A snapshot is
+/// only reused if all of them match.
+struct RelationSnapshotKey {
+    std::string path;
+    std::uintmax_t file_size = 0;
+    std::int64_t mtime = 0;
+    char separator = ',';
+    bool has_header = true;
+
+    static RelationSnapshotKey For(CSVConfig const& csv_config);
+
+    /// Hex digest of the key, used to name snapshot files inside a cache directory.
+    std::string Digest() const;
+
+    bool operator==(RelationSnapshotKey const& other) const = default;
+};
+
+class RelationSnapshot {
+public:
+    /// Clusters stored as a CSR pair: cluster i spans rows[offsets[i], offsets[i + 1]).
+    struct Clusters {
+        std::span<std::uint64_t const> offsets;
+        std::span<int const> rows;
+
+        size_t Size() const noexcept {
+            return offsets.empty() ? 0 : offsets.size() - 1;
+        }
+
+        std::span<int const> operator[](size_t i) const noexcept {
+            return rows.subspan(offsets[i], offsets[i + 1] - offsets[i]);
+        }
+    };
+
+    /// Precomputed PLI statistics, laid out exactly as they are stored in the file.
+    struct PliStats {
+        std::uint32_t size;
+        std::uint32_t relation_size;
+        std::uint64_t nep;
+        double entropy;
+        double inverted_entropy;
+        double gini_impurity;
+    };
+
+    struct ColumnView {
+        std::string_view name;
+        PliStats const* pli_stats;
+        Clusters clusters;
+        Clusters singletons;
+        TypeId type_id;
+        /* TypeId of every value after type inference */
+        std::span<TypeId const> type_layout;
+        std::span<std::uint64_t const> value_offsets;
+        std::string_view values;
+
+        std::string_view GetValue(size_t row) const noexcept {
+            return values.substr(value_offsets[row], value_offsets[row + 1] - value_offsets[row]);
+        }
+    };
+
+private:
+    boost::interprocess::file_mapping file_;
+    boost::interprocess::mapped_region region_;
+    RelationSnapshotKey key_;
+    std::string_view relation_name_;
+    size_t num_rows_ = 0;
+    std::vector<ColumnView> columns_;
+
+    explicit RelationSnapshot(std::filesystem::path const& path);
+
+public:
+    static constexpr std::uint32_t kVersion = 1;
+
+    /// Map an existing snapshot. Throws std::runtime_error if the file is not a valid snapshot.
+    static std::shared_ptr<RelationSnapshot const> Open(std::filesystem::path const& path);
+
+    /// Consume the whole stream and write a snapshot of it to path. The file is written under
+    /// a temporary name first and then renamed, so concurrent readers never see a partial file.
+    static void Write(std::filesystem::path const& path, RelationSnapshotKey const& key,
+                      IDatasetStream& stream);
+
+    RelationSnapshotKey const& GetKey() const noexcept {
+        return key_;
+    }
+
+    std::string_view GetRelationName() const noexcept {
+        return relation_name_;
+    }
+
+    size_t GetNumRows() const noexcept {
+        return num_rows_;
+    }
+
+    size_t GetNumColumns() const noexcept {
+        return columns_.size();
+    }
+
+    ColumnView const& GetColumn(size_t index) const noexcept {
+        return columns_[index];
+    }
+};
+
+/// Keeps snapshots of CSV files in a directory, rebuilding a snapshot when its source file or
+/// the parse options change.
+class RelationSnapshotCache {
+    std::filesystem::path directory_;
+
+public:
+    explicit RelationSnapshotCache(std::filesystem::path directory);
+
+    std::filesystem::path GetSnapshotPath(RelationSnapshotKey const& key) const;
+
+    std::shared_ptr<RelationSnapshot const> GetOrCreate(CSVConfig const& csv_config) const;
+};
+
+/// Dataset stream replaying a snapshot. Relation factories recognize it and build their
+/// structures directly from the mapped data; other consumers just read rows as usual.
+class SnapshotDatasetStream final : public IDatasetStream {
+    std::shared_ptr<RelationSnapshot const> snapshot_;
+    size_t next_row_ = 0;
+
+public:
+    explicit SnapshotDatasetStream(std::shared_ptr<RelationSnapshot const> snapshot)
+        : snapshot_(std::move(snapshot)) {}
+
+    std::shared_ptr<RelationSnapshot const> const& GetSnapshot() const noexcept {
+        return snapshot_;
+    }
+
+    Row GetNextRow() override;
+
+    [[nodiscard]] bool HasNextRow() const override {
+        return next_row_ < snapshot_->GetNumRows();
+    }
+
+    [[nodiscard]] size_t GetNumberOfColumns() const override {
+        return snapshot_->GetNumColumns();
+    }
+
+    [[nodiscard]] std::string GetColumnName(size_t index) const override {
+        return std::string{snapshot_->GetColumn(index).name};
+    }
+
+    [[nodiscard]] std::string GetRelationName() const override {
+        return std::string{snapshot_->GetRelationName()};
+    }
+
+    void Reset() override {
+        next_row_ = 0;
+    }
+};
+
+}  // namespace model
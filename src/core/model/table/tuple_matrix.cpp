@@ -0,0 +1,161 @@
+#include "core/model/table/tuple_matrix.h"
+
+#include <algorithm>
+#include <mutex>
+#include <string>
+#include <unordered_map>
+
+#include "core/util/parallel_for.h"
+#include "core/util/target_clones.h"
+
+namespace model {
+
+namespace {
+
+/* Rows of the tuples compared against all the others at once. A tile of 128 tuples of 32
+ * columns takes 16 KiB, so it stays in L1 while the following tiles stream past it
+ */
+constexpr size_t kTileRows = 128;
+/* A thread deduplicates its agree sets whenever their number reaches this or twice the number
+ * left after the previous deduplication
+ */
+constexpr size_t kMinDedupSize = 1 << 16;
+/* Agree sets of explicitly given pairs are computed in ranges of at least this many pairs */
+constexpr size_t kPairsPerTask = 1 << 12;
+
+using ValueId = TupleMatrix::ValueId;
+using Word = ColumnSetList::Word;
+
+void CompareRows(ValueId const* lhs, ValueId const* rhs, size_t num_columns,
+                 Word* agree_set) noexcept {
+    for (size_t begin = 0; begin < num_columns; begin += ColumnSetList::kWordBits) {
+        size_t const end = std::min(num_columns, begin + ColumnSetList::kWordBits);
+        /* a branchless loop over a fixed-width block, which the compiler turns into vector
+         * compares and a mask
+         */
+        Word word = 0;
+        for (size_t i = begin; i < end; ++i) {
+            word |= Word{lhs[i] == rhs[i]} << (i - begin);
+        }
+        agree_set[begin / ColumnSetList::kWordBits] = word;
+    }
+}
+
+/* Agree sets of the tuple lhs with the num_rhs consecutive tuples from rhs on, written to
+ * consecutive sets of num_words words
+ */
+DESBORDANTE_TARGET_CLONES
+void CompareWithRows(ValueId const* lhs, ValueId const* rhs, size_t num_rhs, size_t num_columns,
+                     Word* agree_sets, size_t num_words) noexcept {
+    for (size_t k = 0; k < num_rhs; ++k) {
+        CompareRows(lhs, rhs + k * num_columns, num_columns, agree_sets + k * num_words);
+    }
+}
+
+DESBORDANTE_TARGET_CLONES
+void ComparePairs(ValueId const* values, size_t num_columns, TupleMatrix::TuplePair const* pairs,
+                  size_t num_pairs, Word* agree_sets, size_t num_words) noexcept {
+    for (size_t k = 0; k < num_pairs; ++k) {
+        CompareRows(values + pairs[k].first * num_columns, values + pairs[k].second * num_columns,
+                    num_columns, agree_sets + k * num_words);
+    }
+}
+
+}  // namespace
+
+TupleMatrix TupleMatrix::ReadTable(IDatasetStream& stream) {
+    TupleMatrix matrix;
+    matrix.num_columns_ = stream.GetNumberOfColumns();
+    std::vector<std::unordered_map<std::string, ValueId>> dictionaries(matrix.num_columns_);
+    while (stream.HasNextRow()) {
+        std::vector<std::string> row = stream.GetNextRow();
+        if (row.empty()) {
+            break;
+        }
+        for (size_t i = 0; i < matrix.num_columns_; ++i) {
+            auto& dictionary = dictionaries[i];
+            matrix.values_.push_back(
+                    dictionary.try_emplace(std::move(row[i]), dictionary.size()).first->second);
+        }
+        ++matrix.num_rows_;
+    }
+    return matrix;
+}
+
+void TupleMatrix::GetAgreeSet(size_t t1, size_t t2,
+                              ColumnSetList::Word* agree_set) const noexcept {
+    CompareRows(GetRow(t1), GetRow(t2), num_columns_, agree_set);
+}
+
+ColumnSetList TupleMatrix::GetAllPairsAgreeSets(util::WorkerThreadPool* pool) const {
+    size_t const num_tiles = (num_rows_ + kTileRows - 1) / kTileRows;
+
+    struct ThreadAgreeSets {
+        ColumnSetList sets;
+        size_t dedup_size;
+    };
+
+    /* Compares the tuples of the tile with those of the tile and of all the following ones */
+    auto process = [&](size_t tile, ThreadAgreeSets& agree_sets) {
+        size_t const tile_begin = tile * kTileRows;
+        size_t const tile_end = std::min(num_rows_, tile_begin + kTileRows);
+        for (size_t other = tile; other < num_tiles; ++other) {
+            size_t const other_begin = other * kTileRows;
+            size_t const other_end = std::min(num_rows_, other_begin + kTileRows);
+            for (size_t p = tile_begin; p < tile_end; ++p) {
+                size_t const q_begin = std::max(other_begin, p + 1);
+                if (q_begin >= other_end) {
+                    continue;
+                }
+                ColumnSetList& sets = agree_sets.sets;
+                size_t const first = sets.Size();
+                sets.Resize(first + (other_end - q_begin));
+                CompareWithRows(GetRow(p), GetRow(q_begin), other_end - q_begin, num_columns_,
+                                sets.GetRow(first), sets.GetNumWords());
+            }
+            if (agree_sets.sets.Size() >= agree_sets.dedup_size) {
+                agree_sets.sets.SortAndDedup();
+                agree_sets.dedup_size = std::max(kMinDedupSize, 2 * agree_sets.sets.Size());
+            }
+        }
+    };
+
+    ColumnSetList agree_sets(num_columns_);
+    if (pool != nullptr && num_tiles > 1) {
+        /* earlier tiles have more tiles to be compared with, so handing them out in order keeps
+         * the last tasks short
+         */
+        std::mutex merge_mutex;
+        pool->ExecIndexWithResource(
+                process,
+                [this]() { return ThreadAgreeSets{ColumnSetList(num_columns_), kMinDedupSize}; },
+                num_tiles,
+                [&](ThreadAgreeSets thread_agree_sets) {
+                    thread_agree_sets.sets.SortAndDedup();
+                    std::scoped_lock lock(merge_mutex);
+                    agree_sets.Append(thread_agree_sets.sets);
+                });
+    } else {
+        ThreadAgreeSets thread_agree_sets{ColumnSetList(num_columns_), kMinDedupSize};
+        for (size_t tile = 0; tile < num_tiles; ++tile) {
+            process(tile, thread_agree_sets);
+        }
+        agree_sets = std::move(thread_agree_sets.sets);
+    }
+
+    agree_sets.SortAndDedup();
+    return agree_sets;
+}
+
+ColumnSetList TupleMatrix::GetAgreeSets(std::span<TuplePair const> pairs,
+                                        util::WorkerThreadPool* pool) const {
+    ColumnSetList agree_sets(num_columns_);
+    agree_sets.Resize(pairs.size());
+    util::ParallelForRanges(pool, pairs.size(), kPairsPerTask, [&](size_t begin, size_t end) {
+        ComparePairs(values_.data(), num_columns_, pairs.data() + begin, end - begin,
+                     agree_sets.GetRow(begin), agree_sets.GetNumWords());
+    });
+    return agree_sets;
+}
+
+}  // namespace model
@@ -0,0 +1,71 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <span>
+#include <utility>
+#include <vector>
+
+#include "core/model/table/column_set_list.h"
+#include "core/model/table/idataset_stream.h"
+#include "core/util/worker_thread_pool.h"
+
+namespace model {
+
+/* Tuples of a relation as a row-major matrix of dictionary-encoded values. In every column
+ * equal strings get equal ids, numbered from 0 in the order of their first occurrence, so
+ * comparing two tuples reads two contiguous rows and never confuses different values.
+ * Agree sets of tuple pairs are computed 64 columns to a word into a ColumnSetList.
+ */
+class TupleMatrix {
+public:
+    using ValueId = std::uint32_t;
+    using TuplePair = std::pair<size_t, size_t>;
+
+private:
+    size_t num_columns_ = 0;
+    size_t num_rows_ = 0;
+    std::vector<ValueId> values_;
+
+public:
+    TupleMatrix() = default;
+
+    /* Reads the rows of the stream up to its end or to the first empty row */
+    static TupleMatrix ReadTable(IDatasetStream& stream);
+
+    size_t GetNumColumns() const noexcept {
+        return num_columns_;
+    }
+
+    size_t GetNumRows() const noexcept {
+        return num_rows_;
+    }
+
+    ValueId const* GetRow(size_t row) const noexcept {
+        return values_.data() + row * num_columns_;
+    }
+
+    ValueId GetValue(size_t row, size_t column) const noexcept {
+        return values_[row * num_columns_ + column];
+    }
+
+    /* Writes the agree set of the two tuples to agree_set, a row of a ColumnSetList of
+     * GetNumColumns() columns
+     */
+    void GetAgreeSet(size_t t1, size_t t2, ColumnSetList::Word* agree_set) const noexcept;
+
+    /* Agree sets of all pairs of distinct tuples, sorted and deduplicated. The tuples are
+     * compared in tiles of rows that stay in cache, tiles are spread over the threads of pool (or
+     * processed sequentially if it is nullptr) and every thread deduplicates its own agree sets
+     * before they are merged.
+     */
+    ColumnSetList GetAllPairsAgreeSets(util::WorkerThreadPool* pool) const;
+
+    /* The i-th set of the result is the agree set of pairs[i]. Ranges of pairs are spread over
+     * the threads of pool, if it is not nullptr.
+     */
+    ColumnSetList GetAgreeSets(std::span<TuplePair const> pairs,
+                               util::WorkerThreadPool* pool) const;
+};
+
+}  // namespace model
@@ -126,6 +126,15 @@ TypedColumnDataFactory::TypeMap TypedColumnDataFactory::CreateTypeMap(TypeId con
     return type_map;
 }
 
+TypedColumnDataFactory::TypeMap TypedColumnDataFactory::CreateTypeMap(
+        std::span<TypeId const> types_layout) const {
+    TypeMap type_map;
+    for (size_t i = 0; i != types_layout.size(); ++i) {
+        type_map[types_layout[i]].insert(i);
+    }
+    return type_map;
+}
+
 std::vector<TypeId> TypedColumnDataFactory::GetTypesLayout(TypeMap const& tm) const {
     std::vector<TypeId> types_layout(unparsed_.size(), TypeId::kString);
 
@@ -257,6 +266,17 @@ TypedColumnData TypedColumnDataFactory::CreateFrom() {
     return CreateFromTypeMap(CreateType(type_id, is_null_equal_null_), std::move(type_map));
 }
 
+TypedColumnData TypedColumnDataFactory::CreateFrom(Column const* col,
+                                                   std::vector<std::string> unparsed,
+                                                   TypeId type_id,
+                                                   std::span<TypeId const> types_layout,
+                                                   bool is_null_equal_null) {
+    assert(unparsed.size() == types_layout.size());
+    TypedColumnDataFactory f(col, std::move(unparsed), is_null_equal_null, false);
+    return f.CreateFromTypeMap(CreateType(type_id, is_null_equal_null),
+                               f.CreateTypeMap(types_layout));
+}
+
 std::vector<TypedColumnData> CreateTypedColumnData(IDatasetStream& dataset_stream,
                                                    bool is_null_equal_null) {
     std::unique_ptr<model::ColumnLayoutTypedRelationData> relation_data =
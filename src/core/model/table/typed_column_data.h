@@ -1,6 +1,7 @@
 #pragma once
 
 #include <bitset>
+#include <span>
 #include <string>
 #include <vector>
 
@@ -256,6 +257,7 @@ private:
     TypeIdToType MapTypeIdsToTypes(TypeMap const& tm) const;
     TypeId DeduceColumnType() const;
     TypeMap CreateTypeMap(TypeId const type_id) const;
+    TypeMap CreateTypeMap(std::span<TypeId const> types_layout) const;
     TypedColumnData CreateMixedFromTypeMap(std::unique_ptr<Type const> type, TypeMap type_map);
     TypedColumnData CreateConcreteFromTypeMap(std::unique_ptr<Type const> type, TypeMap type_map);
     TypedColumnData CreateFromTypeMap(std::unique_ptr<Type const> type, TypeMap type_map);
@@ -275,6 +277,12 @@ public:
                                  treat_mixed_as_string);
         return f.CreateFrom();
     }
+
+    /* Build a column whose type and per-value type layout are already known (e.g. they were
+     * stored in a relation snapshot), skipping regex-based type inference */
+    static TypedColumnData CreateFrom(Column const* col, std::vector<std::string> unparsed,
+                                      TypeId type_id, std::span<TypeId const> types_layout,
+                                      bool is_null_equal_null);
 };
 
 std::vector<TypedColumnData> CreateTypedColumnData(IDatasetStream& dataset_stream,
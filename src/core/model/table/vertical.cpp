@@ -1,78 +1,225 @@
 #include "core/model/table/vertical.h"
 
+#include <algorithm>
+#include <bit>
+#include <cassert>
 #include <utility>
 
+#include <boost/container_hash/hash.hpp>
+
+Vertical::Indices const Vertical::kEmptyIndices{boost::dynamic_bitset<>()};
+
+Vertical::Indices::Indices(boost::dynamic_bitset<> indices)
+    : num_bits(indices.size()), is_inline(indices.num_blocks() <= kInlineBlocks) {
+    if (is_inline) {
+        boost::to_block_range(indices, blocks.begin());
+        Init(blocks.data(), blocks.data() + indices.num_blocks());
+        return;
+    }
+    std::vector<Block> wide_blocks(indices.num_blocks());
+    boost::to_block_range(indices, wide_blocks.begin());
+    Init(wide_blocks.data(), wide_blocks.data() + wide_blocks.size());
+    bits_ = std::move(indices);
+}
+
+Vertical::Indices::Indices(std::size_t num_bits, Blocks const& blocks)
+    : num_bits(num_bits), is_inline(true), blocks(blocks) {
+    Init(this->blocks.data(),
+         this->blocks.data() + (num_bits + boost::dynamic_bitset<>::bits_per_block - 1) /
+                                       boost::dynamic_bitset<>::bits_per_block);
+}
+
+void Vertical::Indices::Init(Block const* first, Block const* last) {
+    arity = 0;
+    for (Block const* block = first; block != last; ++block) {
+        arity += std::popcount(*block);
+    }
+    // Verticals of the first 64 columns hash to their bits, as they always did
+    if (first != last && std::all_of(first + 1, last, [](Block block) { return block == 0; })) {
+        hash = *first;
+    } else {
+        hash = boost::hash_range(first, last);
+    }
+}
+
+boost::dynamic_bitset<> const& Vertical::Indices::GetBits() const {
+    if (is_inline) {
+        std::call_once(bits_built_, [this]() { bits_ = CopyBits(); });
+    }
+    return bits_;
+}
+
+boost::dynamic_bitset<> Vertical::Indices::CopyBits() const {
+    if (!is_inline) return bits_;
+    boost::dynamic_bitset<> bits(num_bits);
+    boost::from_block_range(blocks.begin(), blocks.begin() + bits.num_blocks(), bits);
+    return bits;
+}
+
 Vertical::Vertical(RelationalSchema const* rel_schema, boost::dynamic_bitset<> indices)
-    : column_indices_(std::move(indices)), schema_(rel_schema) {}
+    : indices_(std::make_shared<Indices const>(std::move(indices))), schema_(rel_schema) {}
 
 Vertical::Vertical(Column const& col) : schema_(col.GetSchema()) {
-    column_indices_ = boost::dynamic_bitset<>(schema_->GetNumColumns());
-    column_indices_.set(col.GetIndex());
+    boost::dynamic_bitset<> column_indices(schema_->GetNumColumns());
+    column_indices.set(col.GetIndex());
+    indices_ = std::make_shared<Indices const>(std::move(column_indices));
+}
+
+Vertical Vertical::WithBlocks(Indices::Blocks const& blocks) const {
+    Vertical result;
+    result.indices_ = std::make_shared<Indices const>(GetIndices().num_bits, blocks);
+    result.schema_ = schema_;
+    return result;
+}
+
+bool Vertical::operator==(Vertical const& other) const {
+    Indices const& lhs = GetIndices();
+    Indices const& rhs = other.GetIndices();
+    if (&lhs == &rhs) return true;
+    if (lhs.hash != rhs.hash || lhs.arity != rhs.arity) return false;
+    if (lhs.InlineWith(rhs)) return lhs.blocks == rhs.blocks;
+    return lhs.GetBits() == rhs.GetBits();
 }
 
 bool Vertical::Contains(Vertical const& that) const {
-    boost::dynamic_bitset<> const& that_indices = that.column_indices_;
-    if (column_indices_.size() < that_indices.size()) return false;
+    Indices const& indices = GetIndices();
+    Indices const& that_indices = that.GetIndices();
+    if (indices.num_bits < that_indices.num_bits) return false;
+    if (indices.arity < that_indices.arity) return false;
 
-    return that.column_indices_.is_subset_of(column_indices_);
+    if (indices.InlineWith(that_indices)) {
+        for (std::size_t i = 0; i < Indices::kInlineBlocks; ++i) {
+            if ((that_indices.blocks[i] & ~indices.blocks[i]) != 0) return false;
+        }
+        return true;
+    }
+    return that_indices.GetBits().is_subset_of(indices.GetBits());
 }
 
 bool Vertical::Contains(Column const& that) const {
-    return column_indices_.test(that.GetIndex());
+    Indices const& indices = GetIndices();
+    std::size_t const index = that.GetIndex();
+    if (indices.is_inline) {
+        assert(index < indices.num_bits);
+        std::size_t const bits_per_block = boost::dynamic_bitset<>::bits_per_block;
+        return (indices.blocks[index / bits_per_block] >> (index % bits_per_block)) & 1;
+    }
+    return indices.GetBits().test(index);
 }
 
 bool Vertical::Intersects(Vertical const& that) const {
-    boost::dynamic_bitset<> const& that_indices = that.column_indices_;
-    return column_indices_.intersects(that_indices);
+    Indices const& indices = GetIndices();
+    Indices const& that_indices = that.GetIndices();
+    if (indices.InlineWith(that_indices)) {
+        for (std::size_t i = 0; i < Indices::kInlineBlocks; ++i) {
+            if ((that_indices.blocks[i] & indices.blocks[i]) != 0) return true;
+        }
+        return false;
+    }
+    return indices.GetBits().intersects(that_indices.GetBits());
 }
 
 Vertical Vertical::Union(Vertical const& that) const {
-    boost::dynamic_bitset<> retained_column_indices(column_indices_);
-    retained_column_indices |= that.column_indices_;
-    return schema_->GetVertical(retained_column_indices);
+    Indices const& indices = GetIndices();
+    Indices const& that_indices = that.GetIndices();
+    if (indices.InlineWith(that_indices)) {
+        Indices::Blocks blocks;
+        for (std::size_t i = 0; i < Indices::kInlineBlocks; ++i) {
+            blocks[i] = indices.blocks[i] | that_indices.blocks[i];
+        }
+        return WithBlocks(blocks);
+    }
+    boost::dynamic_bitset<> retained_column_indices(GetColumnIndicesRef());
+    retained_column_indices |= that.GetColumnIndicesRef();
+    return schema_->GetVertical(std::move(retained_column_indices));
 }
 
 Vertical Vertical::Union(Column const& that) const {
-    boost::dynamic_bitset<> retained_column_indices(column_indices_);
+    Indices const& indices = GetIndices();
+    if (indices.is_inline) {
+        assert(that.GetIndex() < indices.num_bits);
+        std::size_t const bits_per_block = boost::dynamic_bitset<>::bits_per_block;
+        Indices::Blocks blocks = indices.blocks;
+        blocks[that.GetIndex() / bits_per_block] |= Indices::Block{1}
+                                                    << (that.GetIndex() % bits_per_block);
+        return WithBlocks(blocks);
+    }
+    boost::dynamic_bitset<> retained_column_indices(GetColumnIndicesRef());
     retained_column_indices.set(that.GetIndex());
-    return schema_->GetVertical(retained_column_indices);
+    return schema_->GetVertical(std::move(retained_column_indices));
 }
 
 Vertical Vertical::Project(Vertical const& that) const {
-    boost::dynamic_bitset<> retained_column_indices(column_indices_);
-    retained_column_indices &= that.column_indices_;
-    return schema_->GetVertical(retained_column_indices);
+    Indices const& indices = GetIndices();
+    Indices const& that_indices = that.GetIndices();
+    if (indices.InlineWith(that_indices)) {
+        Indices::Blocks blocks;
+        for (std::size_t i = 0; i < Indices::kInlineBlocks; ++i) {
+            blocks[i] = indices.blocks[i] & that_indices.blocks[i];
+        }
+        return WithBlocks(blocks);
+    }
+    boost::dynamic_bitset<> retained_column_indices(GetColumnIndicesRef());
+    retained_column_indices &= that.GetColumnIndicesRef();
+    return schema_->GetVertical(std::move(retained_column_indices));
 }
 
 Vertical Vertical::Without(Vertical const& that) const {
-    boost::dynamic_bitset<> retained_column_indices(column_indices_);
-    retained_column_indices &= ~that.column_indices_;
-    return schema_->GetVertical(retained_column_indices);
+    Indices const& indices = GetIndices();
+    Indices const& that_indices = that.GetIndices();
+    if (indices.InlineWith(that_indices)) {
+        Indices::Blocks blocks;
+        for (std::size_t i = 0; i < Indices::kInlineBlocks; ++i) {
+            blocks[i] = indices.blocks[i] & ~that_indices.blocks[i];
+        }
+        return WithBlocks(blocks);
+    }
+    boost::dynamic_bitset<> retained_column_indices(GetColumnIndicesRef());
+    retained_column_indices &= ~that.GetColumnIndicesRef();
+    return schema_->GetVertical(std::move(retained_column_indices));
 }
 
 Vertical Vertical::Without(Column const& that) const {
-    boost::dynamic_bitset<> retained_column_indices(column_indices_);
+    Indices const& indices = GetIndices();
+    if (indices.is_inline) {
+        assert(that.GetIndex() < indices.num_bits);
+        std::size_t const bits_per_block = boost::dynamic_bitset<>::bits_per_block;
+        Indices::Blocks blocks = indices.blocks;
+        blocks[that.GetIndex() / bits_per_block] &= ~(Indices::Block{1}
+                                                      << (that.GetIndex() % bits_per_block));
+        return WithBlocks(blocks);
+    }
+    boost::dynamic_bitset<> retained_column_indices(GetColumnIndicesRef());
     retained_column_indices.reset(that.GetIndex());
-    return schema_->GetVertical(retained_column_indices);
+    return schema_->GetVertical(std::move(retained_column_indices));
 }
 
 Vertical Vertical::Invert() const {
-    boost::dynamic_bitset<> flipped_indices(column_indices_);
+    boost::dynamic_bitset<> flipped_indices(GetColumnIndices());
     flipped_indices.resize(schema_->GetNumColumns());
     flipped_indices.flip();
-    return schema_->GetVertical(flipped_indices);
+    return schema_->GetVertical(std::move(flipped_indices));
 }
 
 Vertical Vertical::Invert(Vertical const& scope) const {
-    boost::dynamic_bitset<> flipped_indices(column_indices_);
-    flipped_indices ^= scope.column_indices_;
-    return schema_->GetVertical(flipped_indices);
+    Indices const& indices = GetIndices();
+    Indices const& scope_indices = scope.GetIndices();
+    if (indices.InlineWith(scope_indices)) {
+        Indices::Blocks blocks;
+        for (std::size_t i = 0; i < Indices::kInlineBlocks; ++i) {
+            blocks[i] = indices.blocks[i] ^ scope_indices.blocks[i];
+        }
+        return WithBlocks(blocks);
+    }
+    boost::dynamic_bitset<> flipped_indices(GetColumnIndicesRef());
+    flipped_indices ^= scope.GetColumnIndicesRef();
+    return schema_->GetVertical(std::move(flipped_indices));
 }
 
 std::vector<Column const*> Vertical::GetColumns() const {
     std::vector<Column const*> columns;
-    for (size_t index = column_indices_.find_first(); index != boost::dynamic_bitset<>::npos;
-         index = column_indices_.find_next(index)) {
+    for (size_t index = GetColumnIndicesRef().find_first(); index != boost::dynamic_bitset<>::npos;
+         index = GetColumnIndicesRef().find_next(index)) {
         columns.push_back(schema_->GetColumns()[index].get());
     }
     return columns;
@@ -80,8 +227,8 @@ std::vector<Column const*> Vertical::GetColumns() const {
 
 std::vector<unsigned> Vertical::GetColumnIndicesAsVector() const {
     std::vector<unsigned> columns;
-    for (size_t index = column_indices_.find_first(); index != boost::dynamic_bitset<>::npos;
-         index = column_indices_.find_next(index)) {
+    for (size_t index = GetColumnIndicesRef().find_first(); index != boost::dynamic_bitset<>::npos;
+         index = GetColumnIndicesRef().find_next(index)) {
         columns.push_back(schema_->GetColumns()[index].get()->GetIndex());
     }
     return columns;
@@ -90,12 +237,12 @@ std::vector<unsigned> Vertical::GetColumnIndicesAsVector() const {
 std::string Vertical::ToString() const {
     std::string result = "[";
 
-    if (column_indices_.find_first() == boost::dynamic_bitset<>::npos) return "[]";
+    if (GetColumnIndicesRef().find_first() == boost::dynamic_bitset<>::npos) return "[]";
 
-    for (size_t index = column_indices_.find_first(); index != boost::dynamic_bitset<>::npos;
-         index = column_indices_.find_next(index)) {
+    for (size_t index = GetColumnIndicesRef().find_first(); index != boost::dynamic_bitset<>::npos;
+         index = GetColumnIndicesRef().find_next(index)) {
         result += schema_->GetColumn(index)->GetName();
-        if (column_indices_.find_next(index) != boost::dynamic_bitset<>::npos) {
+        if (GetColumnIndicesRef().find_next(index) != boost::dynamic_bitset<>::npos) {
             result += ' ';
         }
     }
@@ -108,14 +255,14 @@ std::string Vertical::ToString() const {
 std::string Vertical::ToIndicesString() const {
     std::string result = "[";
 
-    if (column_indices_.find_first() == boost::dynamic_bitset<>::npos) {
+    if (GetColumnIndicesRef().find_first() == boost::dynamic_bitset<>::npos) {
         return "[]";
     }
 
-    for (size_t index = column_indices_.find_first(); index != boost::dynamic_bitset<>::npos;
-         index = column_indices_.find_next(index)) {
+    for (size_t index = GetColumnIndicesRef().find_first(); index != boost::dynamic_bitset<>::npos;
+         index = GetColumnIndicesRef().find_next(index)) {
         result += std::to_string(index);
-        if (column_indices_.find_next(index) != boost::dynamic_bitset<>::npos) {
+        if (GetColumnIndicesRef().find_next(index) != boost::dynamic_bitset<>::npos) {
             result += ',';
         }
     }
@@ -129,20 +276,27 @@ std::vector<Vertical> Vertical::GetParents() const {
     if (GetArity() < 2) return std::vector<Vertical>();
     std::vector<Vertical> parents(GetArity());
     int i = 0;
-    for (size_t column_index = column_indices_.find_first();
+    for (size_t column_index = GetColumnIndicesRef().find_first();
          column_index != boost::dynamic_bitset<>::npos;
-         column_index = column_indices_.find_next(column_index)) {
-        auto parent_column_indices = column_indices_;
-        parent_column_indices.reset(column_index);
-        parents[i++] = GetSchema()->GetVertical(std::move(parent_column_indices));
+         column_index = GetColumnIndicesRef().find_next(column_index)) {
+        parents[i++] = Without(*schema_->GetColumns()[column_index]);
     }
     return parents;
 }
 
 bool Vertical::operator<(Vertical const& rhs) const {
     assert(*schema_ == *rhs.schema_);
-    if (this->column_indices_ == rhs.column_indices_) return false;
+    if (*this == rhs) return false;
 
-    boost::dynamic_bitset<> const& lr_xor = (this->column_indices_ ^ rhs.column_indices_);
-    return rhs.column_indices_.test(lr_xor.find_first());
+    Indices const& lhs_indices = GetIndices();
+    Indices const& rhs_indices = rhs.GetIndices();
+    if (lhs_indices.InlineWith(rhs_indices)) {
+        for (std::size_t i = 0; i < Indices::kInlineBlocks; ++i) {
+            Indices::Block const lr_xor = lhs_indices.blocks[i] ^ rhs_indices.blocks[i];
+            if (lr_xor != 0) return (rhs_indices.blocks[i] >> std::countr_zero(lr_xor)) & 1;
+        }
+        return false;
+    }
+    boost::dynamic_bitset<> const& lr_xor = (lhs_indices.GetBits() ^ rhs_indices.GetBits());
+    return rhs_indices.GetBits().test(lr_xor.find_first());
 }
@@ -5,7 +5,10 @@
 
 #pragma once
 
+#include <array>
+#include <cstddef>
 #include <memory>
+#include <mutex>
 #include <string>
 #include <vector>
 
@@ -15,11 +18,52 @@
 
 class Vertical {
 private:
-    // Vertical(shared_ptr<RelationalSchema>& relSchema, int indices);
+    // Column indices of a vertical. They never change after construction, so copies of a
+    // vertical share them, and copying a vertical does not copy the bitset.
+    struct Indices {
+        using Block = boost::dynamic_bitset<>::block_type;
+        // Verticals of at most 256 columns keep their bits inline, so that comparing them does not
+        // follow a heap pointer and the node is their only allocation
+        static constexpr std::size_t kInlineBlocks = 256 / boost::dynamic_bitset<>::bits_per_block;
+        using Blocks = std::array<Block, kInlineBlocks>;
+
+        std::size_t num_bits;
+        std::size_t hash = 0;
+        unsigned arity;
+        bool is_inline;
+        Blocks blocks{};
+
+        // Whether the blocks of both can be compared instead of the bitsets
+        bool InlineWith(Indices const& that) const noexcept {
+            return is_inline && that.is_inline && num_bits == that.num_bits;
+        }
+
+        // The bitset of a wide vertical, or of an inline one built from its blocks on first use
+        boost::dynamic_bitset<> const& GetBits() const;
+        boost::dynamic_bitset<> CopyBits() const;
+
+        explicit Indices(boost::dynamic_bitset<> indices);
+        Indices(std::size_t num_bits, Blocks const& blocks);
+
+    private:
+        mutable boost::dynamic_bitset<> bits_;
+        mutable std::once_flag bits_built_;
+
+        void Init(Block const* first, Block const* last);
+    };
+
+    static Indices const kEmptyIndices;
+
+    std::shared_ptr<Indices const> indices_;
+    RelationalSchema const* schema_ = nullptr;
+
+    // Default constructed and moved from verticals have no indices of their own
+    Indices const& GetIndices() const noexcept {
+        return indices_ ? *indices_ : kEmptyIndices;
+    }
 
-    // TODO: unique_ptr<column_indices_> if this is big
-    boost::dynamic_bitset<> column_indices_;
-    RelationalSchema const* schema_;
+    // A vertical of the same schema and width as this inline one
+    Vertical WithBlocks(Indices::Blocks const& blocks) const;
 
 public:
     Vertical(RelationalSchema const* rel_schema, boost::dynamic_bitset<> indices);
@@ -34,20 +78,18 @@ public:
 
     virtual ~Vertical() = default;
 
-    /* @return Returns true if lhs.column_indices_ lexicographically less than
-     * rhs.column_indices_ treating bitsets big endian.
+    /* @return Returns true if lhs column indices are lexicographically less than
+     * rhs column indices treating bitsets big endian.
      * @brief We do not use directly boost::dynamic_bitset<> operator< because
      * it treats bitsets little endian during comparison and this is not
      * suitable for this case, check out operator< for Columns.
      */
     bool operator<(Vertical const& rhs) const;
 
-    bool operator==(Vertical const& other) const {
-        return column_indices_ == other.column_indices_;
-    }
+    bool operator==(Vertical const& other) const;
 
     bool operator!=(Vertical const& other) const {
-        return column_indices_ != other.column_indices_;
+        return !(*this == other);
     }
 
     bool operator>(Vertical const& rhs) const {
@@ -55,17 +97,23 @@ public:
     }
 
     boost::dynamic_bitset<> GetColumnIndices() const {
-        return column_indices_;
+        return GetIndices().CopyBits();
     }
 
+    // Builds and keeps the bitset of an inline vertical, prefer GetColumnIndices for a copy
     boost::dynamic_bitset<> const& GetColumnIndicesRef() const {
-        return column_indices_;
+        return GetIndices().GetBits();
     }
 
     RelationalSchema const* GetSchema() const {
         return schema_;
     }
 
+    // Computed once on construction
+    std::size_t Hash() const noexcept {
+        return GetIndices().hash;
+    }
+
     bool Contains(Vertical const& that) const;
     bool Contains(Column const& that) const;
     bool Intersects(Vertical const& that) const;
@@ -78,11 +126,11 @@ public:
     Vertical Invert(Vertical const& scope) const;
 
     unsigned int GetArity() const {
-        return column_indices_.count();
+        return GetIndices().arity;
     }
 
     bool IsEmpty() const {
-        return column_indices_.none();
+        return GetIndices().arity == 0;
     }
 
     std::vector<Column const*> GetColumns() const;
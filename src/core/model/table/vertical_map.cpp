@@ -1,10 +1,13 @@
 #include "core/model/table/vertical_map.h"
 
+#include <algorithm>
+#include <bit>
 #include <exception>
 #include <mutex>
 #include <queue>
 #include <shared_mutex>
 #include <unordered_set>
+#include <utility>
 
 #include "core/algorithms/fd/pyrocommon/core/dependency_candidate.h"
 #include "core/algorithms/fd/pyrocommon/core/vertical_info.h"
@@ -14,224 +17,143 @@
 namespace model {
 
 template <class Value>
-std::shared_ptr<Value> VerticalMap<Value>::SetTrie::Associate(Bitset const& key, size_t next_bit,
-                                                              std::shared_ptr<Value> value) {
-    next_bit = (next_bit == 0 ? key.find_first() : key.find_next(next_bit - 1));
-    if (next_bit == boost::dynamic_bitset<>::npos) {
-        std::swap(value, value_);
-        return value;
-    }
-    return GetOrCreateSubTrie(next_bit)->Associate(key, next_bit + 1, std::move(value));
+size_t VerticalMap<Value>::TablePosition(Vertical const& key) const noexcept {
+    // Hashes of narrow verticals are their bits, so they are mixed before taking the low bits
+    return (key.Hash() * 0x9E3779B97F4A7C15ULL) & (table_.size() - 1);
 }
 
 template <class Value>
-std::shared_ptr<Value const> VerticalMap<Value>::SetTrie::Get(Bitset const& key,
-                                                              size_t next_bit) const {
-    next_bit = (next_bit == 0 ? key.find_first() : key.find_next(next_bit - 1));
-    if (next_bit == boost::dynamic_bitset<>::npos) {
-        return value_;
+size_t VerticalMap<Value>::FindSlot(Vertical const& key) const {
+    if (table_.empty()) return kNoSlot;
+    for (size_t pos = TablePosition(key);; pos = (pos + 1) & (table_.size() - 1)) {
+        size_t const slot = table_[pos];
+        if (slot == kNoSlot) return kNoSlot;
+        if (slot != kRemovedSlot && slots_[slot].key == key) return slot;
     }
-
-    auto subtrie = GetSubtrie(next_bit);
-    if (subtrie == nullptr) return nullptr;
-    return subtrie->Get(key, next_bit + 1);
 }
 
 template <class Value>
-std::shared_ptr<Value> VerticalMap<Value>::SetTrie::Remove(Bitset const& key, size_t next_bit) {
-    next_bit = (next_bit == 0 ? key.find_first() : key.find_next(next_bit - 1));
-    if (next_bit == Bitset::npos) {
-        auto removed_value = value_;
-        value_ = nullptr;
-        return removed_value;
-    }
-
-    auto subtrie = GetSubtrie(next_bit);
-    if (subtrie == nullptr) return nullptr;
-    auto removed_value = subtrie->Remove(key, next_bit + 1);
-    if (subtrie->IsEmpty()) {
-        subtries_[next_bit - offset_] = nullptr;
+void VerticalMap<Value>::Rehash(size_t table_size) {
+    table_.assign(table_size, kNoSlot);
+    removed_in_table_ = 0;
+    for (size_t slot = live_slots_.find_first(); slot != Bitset::npos;
+         slot = live_slots_.find_next(slot)) {
+        size_t pos = TablePosition(slots_[slot].key);
+        while (table_[pos] != kNoSlot) {
+            pos = (pos + 1) & (table_.size() - 1);
+        }
+        table_[pos] = slot;
     }
-
-    return removed_value;
 }
 
 template <class Value>
-bool VerticalMap<Value>::SetTrie::IsEmpty() const {
-    if (value_ == nullptr) return false;
-    return std::all_of(subtries_.begin(), subtries_.end(),
-                       [](auto& subtrie_ptr) { return subtrie_ptr == nullptr; });
-}
+size_t VerticalMap<Value>::AcquireSlot(Vertical const& key) {
+    // keep the table at most half full, counting removed positions
+    if ((size_ + removed_in_table_ + 1) * 2 > table_.size()) {
+        Rehash(std::max<size_t>(16, std::bit_ceil((size_ + 1) * 4)));
+    }
 
-template <class Value>
-typename VerticalMap<Value>::SetTrie* VerticalMap<Value>::SetTrie::GetOrCreateSubTrie(
-        size_t index) {
-    if (subtries_.empty()) {
-        subtries_ = std::vector<std::unique_ptr<SetTrie>>(dimension_ - offset_);
+    size_t slot;
+    if (!free_slots_.empty()) {
+        slot = free_slots_.back();
+        free_slots_.pop_back();
+        slots_[slot].key = key;
+    } else {
+        slot = slots_.size();
+        slots_.push_back({key, nullptr});
+        if (slots_.size() > live_slots_.size()) {
+            size_t const slot_capacity = std::max<size_t>(64, live_slots_.size() * 2);
+            live_slots_.resize(slot_capacity);
+            for (Bitset& column_slots : column_slots_) {
+                column_slots.resize(slot_capacity);
+            }
+        }
     }
-    SetTrie* subtrie = GetSubtrie(index);
-    if (subtrie == nullptr) {
-        subtries_[index - offset_] = std::make_unique<SetTrie>(index + 1, dimension_);
+    live_slots_.set(slot);
+    Bitset const& indices = key.GetColumnIndicesRef();
+    for (size_t column = indices.find_first(); column != Bitset::npos;
+         column = indices.find_next(column)) {
+        column_slots_[column].set(slot);
     }
-    return subtries_[index - offset_].get();
-}
-
-template <class Value>
-typename VerticalMap<Value>::SetTrie* VerticalMap<Value>::SetTrie::GetSubtrie(size_t index) {
-    return const_cast<VerticalMap<Value>::SetTrie*>(
-            (const_cast<VerticalMap<Value>::SetTrie const*>(this))->GetSubtrie(index));
-}
 
-template <class Value>
-typename VerticalMap<Value>::SetTrie const* VerticalMap<Value>::SetTrie::GetSubtrie(
-        size_t index) const {
-    if (subtries_.empty()) {
-        return nullptr;
+    size_t pos = TablePosition(key);
+    while (table_[pos] != kNoSlot && table_[pos] != kRemovedSlot) {
+        pos = (pos + 1) & (table_.size() - 1);
     }
-    if (index < offset_ || index >= dimension_) {
-        throw std::runtime_error("Error in GetSubtrie: index must be in [offset_; dimension_)");
-    }
-    return subtries_[index - offset_].get();
+    if (table_[pos] == kRemovedSlot) removed_in_table_--;
+    table_[pos] = slot;
+    size_++;
+    return slot;
 }
 
 template <class Value>
-void VerticalMap<Value>::SetTrie::TraverseEntries(
-        Bitset& subset_key,
-        std::function<void(Bitset const&, std::shared_ptr<Value const>)> collector) const {
-    if (value_ != nullptr) {
-        collector(Bitset(subset_key), value_);
+std::shared_ptr<Value> VerticalMap<Value>::ReleaseSlot(size_t slot) {
+    Slot& released = slots_[slot];
+    size_t pos = TablePosition(released.key);
+    while (table_[pos] != slot) {
+        pos = (pos + 1) & (table_.size() - 1);
     }
-    for (size_t i = offset_; i < dimension_; i++) {
-        auto subtrie = GetSubtrie(i);
-        if (subtrie != nullptr) {
-            subset_key.set(i);
-            subtrie->TraverseEntries(subset_key, collector);
-            subset_key.reset(i);
-        }
+    table_[pos] = kRemovedSlot;
+    removed_in_table_++;
+
+    live_slots_.reset(slot);
+    Bitset const& indices = released.key.GetColumnIndicesRef();
+    for (size_t column = indices.find_first(); column != Bitset::npos;
+         column = indices.find_next(column)) {
+        column_slots_[column].reset(slot);
     }
+    released.key = Vertical();
+    free_slots_.push_back(slot);
+    size_--;
+    return std::exchange(released.value, nullptr);
 }
 
 template <class Value>
-bool VerticalMap<Value>::SetTrie::CollectSubsetKeys(
-        Bitset const& key, size_t next_bit, Bitset& subset_key,
-        std::function<bool(Bitset const&, std::shared_ptr<Value const>)> const& collector) const {
-    if (value_ != nullptr) {
-        if (!collector(Bitset(subset_key), value_)) return false;
+typename VerticalMap<Value>::Bitset VerticalMap<Value>::SupersetSlots(
+        Bitset const& key, Bitset const* blacklist) const {
+    Bitset slots = live_slots_;
+    for (size_t column = key.find_first(); column != Bitset::npos && slots.any();
+         column = key.find_next(column)) {
+        slots &= column_slots_[column];
     }
-
-    for (next_bit = (next_bit == 0 ? key.find_first() : key.find_next(next_bit - 1));
-         next_bit != Bitset::npos; next_bit = key.find_next(next_bit)) {
-        auto subtrie = GetSubtrie(next_bit);
-        if (subtrie != nullptr) {
-            subset_key.set(next_bit);
-            if (!subtrie->CollectSubsetKeys(key, next_bit + 1, subset_key, collector)) return false;
-            subset_key.reset(next_bit);
+    if (blacklist != nullptr) {
+        for (size_t column = blacklist->find_first(); column != Bitset::npos && slots.any();
+             column = blacklist->find_next(column)) {
+            slots -= column_slots_[column];
         }
     }
-    return true;
+    return slots;
 }
 
 template <class Value>
-bool VerticalMap<Value>::SetTrie::CollectSupersetKeys(
-        Bitset const& key, size_t next_bit, Bitset& superset_key,
-        std::function<bool(Bitset const&, std::shared_ptr<Value const>)> const& collector) const {
-    if (next_bit != Bitset::npos) {
-        next_bit = (next_bit == 0 ? key.find_first() : key.find_next(next_bit - 1));
-    }
-    if (next_bit == Bitset::npos) {
-        if (value_ != nullptr) {
-            if (!collector(Bitset(superset_key), value_)) return false;
-        }
-        for (size_t i = offset_; i < dimension_; i++) {
-            auto subtrie = GetSubtrie(i);
-            if (subtrie != nullptr) {
-                superset_key.set(i);
-                if (!subtrie->CollectSupersetKeys(key, next_bit, superset_key, collector))
-                    return false;
-                superset_key.reset(i);
-            }
-        }
-    } else {
-        for (size_t i = offset_; i < next_bit; i++) {
-            auto subtrie = GetSubtrie(i);
-            if (subtrie != nullptr) {
-                superset_key.set(i);
-                if (!subtrie->CollectSupersetKeys(key, next_bit, superset_key, collector))
-                    return false;
-                superset_key.reset(i);
-            }
-        }
-
-        auto subtrie = GetSubtrie(next_bit);
-        if (subtrie != nullptr) {
-            superset_key.set(next_bit);
-            if (!subtrie->CollectSupersetKeys(key, next_bit + 1, superset_key, collector))
-                return false;
-            superset_key.reset(next_bit);
+typename VerticalMap<Value>::Bitset VerticalMap<Value>::SubsetSlots(Bitset const& key) const {
+    Bitset slots = live_slots_;
+    for (size_t column = 0; column < column_slots_.size() && slots.any(); ++column) {
+        if (column >= key.size() || !key.test(column)) {
+            slots -= column_slots_[column];
         }
     }
-    return true;
+    return slots;
 }
 
 template <class Value>
-bool VerticalMap<Value>::SetTrie::CollectRestrictedSupersetKeys(
-        Bitset const& key, Bitset const& blacklist, size_t next_bit, Bitset& superset_key,
-        std::function<void(Bitset const&, std::shared_ptr<Value const>)> const& collector) const {
-    if (next_bit != Bitset::npos) {
-        next_bit = (next_bit == 0 ? key.find_first() : key.find_next(next_bit - 1));
+void VerticalMap<Value>::VisitSlots(
+        Bitset const& slots,
+        std::function<bool(Vertical const&, std::shared_ptr<Value const>)> const& collector)
+        const {
+    for (size_t slot = slots.find_first(); slot != Bitset::npos; slot = slots.find_next(slot)) {
+        if (!collector(slots_[slot].key, slots_[slot].value)) return;
     }
-    if (next_bit == Bitset::npos) {
-        if (value_ != nullptr) {
-            collector(Bitset(superset_key), value_);
-        }
-        for (size_t i = offset_; i < dimension_; i++) {
-            if (blacklist.test(i)) continue;
-            auto subtrie = GetSubtrie(i);
-            if (subtrie != nullptr) {
-                superset_key.set(i);
-                if (!subtrie->CollectRestrictedSupersetKeys(key, blacklist, next_bit, superset_key,
-                                                            collector)) {
-                    return false;
-                }
-                superset_key.reset(i);
-            }
-        }
-    } else {
-        for (size_t i = offset_; i < next_bit; i++) {
-            if (blacklist.test(i)) continue;
-            auto subtrie = GetSubtrie(i);
-            if (subtrie != nullptr) {
-                superset_key.set(i);
-                if (!subtrie->CollectRestrictedSupersetKeys(key, blacklist, next_bit, superset_key,
-                                                            collector)) {
-                    return false;
-                }
-                superset_key.reset(i);
-            }
-        }
-
-        auto subtrie = GetSubtrie(next_bit);
-        if (subtrie != nullptr) {
-            superset_key.set(next_bit);
-            if (!subtrie->CollectRestrictedSupersetKeys(key, blacklist, next_bit + 1, superset_key,
-                                                        collector)) {
-                return false;
-            }
-            superset_key.reset(next_bit);
-        }
-    }
-    return true;
 }
 
 template <class Value>
 std::vector<Vertical> VerticalMap<Value>::GetSubsetKeys(Vertical const& vertical) const {
     std::vector<Vertical> subset_keys;
-    Bitset subset_key(relation_->GetNumColumns());
-    set_trie_.CollectSubsetKeys(vertical.GetColumnIndices(), 0, subset_key,
-                                [&subset_keys, this](auto& indices, [[maybe_unused]] auto value) {
-                                    subset_keys.push_back(relation_->GetVertical(indices));
-                                    return true;
-                                });
+    VisitSlots(SubsetSlots(vertical.GetColumnIndicesRef()),
+               [&subset_keys](Vertical const& key, [[maybe_unused]] auto value) {
+                   subset_keys.push_back(key);
+                   return true;
+               });
     return subset_keys;
 }
 
@@ -239,12 +161,11 @@ template <class Value>
 std::vector<typename VerticalMap<Value>::Entry> VerticalMap<Value>::GetSubsetEntries(
         Vertical const& vertical) const {
     std::vector<typename VerticalMap<Value>::Entry> entries;
-    Bitset subset_key(relation_->GetNumColumns());
-    set_trie_.CollectSubsetKeys(vertical.GetColumnIndices(), 0, subset_key,
-                                [&entries, this](auto& indices, auto value) {
-                                    entries.emplace_back(relation_->GetVertical(indices), value);
-                                    return true;
-                                });
+    VisitSlots(SubsetSlots(vertical.GetColumnIndicesRef()),
+               [&entries](Vertical const& key, auto value) {
+                   entries.emplace_back(key, value);
+                   return true;
+               });
     return entries;
 }
 
@@ -253,12 +174,11 @@ template <class Value>
 typename VerticalMap<Value>::Entry VerticalMap<Value>::GetAnySubsetEntry(
         Vertical const& vertical) const {
     typename VerticalMap<Value>::Entry entry;
-    Bitset subset_key(relation_->GetNumColumns());
-    set_trie_.CollectSubsetKeys(vertical.GetColumnIndices(), 0, subset_key,
-                                [&entry, this](auto& indices, auto value) {
-                                    entry = {relation_->GetVertical(indices), value};
-                                    return false;
-                                });
+    VisitSlots(SubsetSlots(vertical.GetColumnIndicesRef()),
+               [&entry](Vertical const& key, auto value) {
+                   entry = {key, value};
+                   return false;
+               });
     return entry;
 }
 
@@ -267,17 +187,14 @@ typename VerticalMap<Value>::Entry VerticalMap<Value>::GetAnySubsetEntry(
         Vertical const& vertical,
         std::function<bool(Vertical const*, std::shared_ptr<Value const>)> const& condition) const {
     typename VerticalMap<Value>::Entry entry;
-    Bitset subset_key(relation_->GetNumColumns());
-    set_trie_.CollectSubsetKeys(vertical.GetColumnIndices(), 0, subset_key,
-                                [&entry, this, &condition](auto& indices, auto value) {
-                                    auto kv = relation_->GetVertical(indices);
-                                    if (condition(&kv, value)) {
-                                        entry = {kv, value};
-                                        return false;
-                                    } else {
-                                        return true;
-                                    }
-                                });
+    VisitSlots(SubsetSlots(vertical.GetColumnIndicesRef()),
+               [&entry, &condition](Vertical const& key, auto value) {
+                   if (condition(&key, value)) {
+                       entry = {key, value};
+                       return false;
+                   }
+                   return true;
+               });
     return entry;
 }
 
@@ -285,12 +202,11 @@ template <class Value>
 std::vector<typename VerticalMap<Value>::Entry> VerticalMap<Value>::GetSupersetEntries(
         Vertical const& vertical) const {
     std::vector<typename VerticalMap<Value>::Entry> entries;
-    Bitset superset_key(relation_->GetNumColumns());
-    set_trie_.CollectSupersetKeys(vertical.GetColumnIndices(), 0, superset_key,
-                                  [&entries, this](auto& indices, auto value) {
-                                      entries.emplace_back(relation_->GetVertical(indices), value);
-                                      return true;
-                                  });
+    VisitSlots(SupersetSlots(vertical.GetColumnIndicesRef()),
+               [&entries](Vertical const& key, auto value) {
+                   entries.emplace_back(key, value);
+                   return true;
+               });
     return entries;
 }
 
@@ -298,12 +214,11 @@ template <class Value>
 typename VerticalMap<Value>::Entry VerticalMap<Value>::GetAnySupersetEntry(
         Vertical const& vertical) const {
     typename VerticalMap<Value>::Entry entry;
-    Bitset superset_key(relation_->GetNumColumns());
-    set_trie_.CollectSupersetKeys(vertical.GetColumnIndices(), 0, superset_key,
-                                  [&entry, this](auto& indices, auto value) {
-                                      entry = {relation_->GetVertical(indices), value};
-                                      return false;
-                                  });
+    VisitSlots(SupersetSlots(vertical.GetColumnIndicesRef()),
+               [&entry](Vertical const& key, auto value) {
+                   entry = {key, value};
+                   return false;
+               });
     return entry;
 }
 
@@ -312,63 +227,58 @@ typename VerticalMap<Value>::Entry VerticalMap<Value>::GetAnySupersetEntry(
         Vertical const& vertical,
         std::function<bool(Vertical const*, std::shared_ptr<Value const>)> condition) const {
     typename VerticalMap<Value>::Entry entry;
-    Bitset superset_key(relation_->GetNumColumns());
-    set_trie_.CollectSupersetKeys(vertical.GetColumnIndices(), 0, superset_key,
-                                  [&entry, this, &condition](auto& indices, auto value) {
-                                      auto kv = relation_->GetVertical(indices);
-                                      if (condition(&kv, value)) {
-                                          entry = {kv, value};
-                                          return false;
-                                      } else {
-                                          return true;
-                                      }
-                                  });
+    VisitSlots(SupersetSlots(vertical.GetColumnIndicesRef()),
+               [&entry, &condition](Vertical const& key, auto value) {
+                   if (condition(&key, value)) {
+                       entry = {key, value};
+                       return false;
+                   }
+                   return true;
+               });
     return entry;
 }
 
 template <class Value>
 std::vector<typename VerticalMap<Value>::Entry> VerticalMap<Value>::GetRestrictedSupersetEntries(
         Vertical const& vertical, Vertical const& exclusion) const {
-    if (vertical.GetColumnIndices().intersects(exclusion.GetColumnIndices()))
+    if (vertical.Intersects(exclusion))
         throw std::runtime_error(
                 "Error in GetRestrictedSupersetEntries: a vertical shouldn't intersect with a "
                 "restriction");
 
     std::vector<typename VerticalMap<Value>::Entry> entries;
-    Bitset superset_key(relation_->GetNumColumns());
-    set_trie_.CollectRestrictedSupersetKeys(
-            vertical.GetColumnIndices(), exclusion.GetColumnIndices(), 0, superset_key,
-            [&entries, this](auto& indices, auto value) {
-                entries.emplace_back(relation_->GetVertical(indices), value);
-                return true;
-            });
+    VisitSlots(SupersetSlots(vertical.GetColumnIndicesRef(), &exclusion.GetColumnIndicesRef()),
+               [&entries](Vertical const& key, auto value) {
+                   entries.emplace_back(key, value);
+                   return true;
+               });
     return entries;
 }
 
 template <class Value>
 bool VerticalMap<Value>::RemoveSupersetEntries(Vertical const& key) {
-    std::vector<typename VerticalMap<Value>::Entry> superset_entries = GetSupersetEntries(key);
-    for (auto superset_entry : superset_entries) {
-        Remove(superset_entry.first);
+    Bitset const slots = SupersetSlots(key.GetColumnIndicesRef());
+    for (size_t slot = slots.find_first(); slot != Bitset::npos; slot = slots.find_next(slot)) {
+        ReleaseSlot(slot);
     }
-    return !superset_entries.empty();
+    return slots.any();
 }
 
 template <class Value>
 bool VerticalMap<Value>::RemoveSubsetEntries(Vertical const& key) {
-    std::vector<typename VerticalMap<Value>::Entry> subset_entries = GetSubsetEntries(key);
-    for (auto subset_entry : subset_entries) {
-        Remove(subset_entry.first);
+    Bitset const slots = SubsetSlots(key.GetColumnIndicesRef());
+    for (size_t slot = slots.find_first(); slot != Bitset::npos; slot = slots.find_next(slot)) {
+        ReleaseSlot(slot);
     }
-    return !subset_entries.empty();
+    return slots.any();
 }
 
 template <class Value>
 std::unordered_set<Vertical> VerticalMap<Value>::KeySet() {
-    std::unordered_set<Vertical> key_set;
-    Bitset subset_key(relation_->GetNumColumns());
-    set_trie_.TraverseEntries(subset_key, [&key_set, this](auto& k, [[maybe_unused]] auto v) {
-        key_set.insert(relation_->GetVertical(k));
+    std::unordered_set<Vertical> key_set(size_);
+    VisitSlots(live_slots_, [&key_set](Vertical const& key, [[maybe_unused]] auto value) {
+        key_set.insert(key);
+        return true;
     });
     return key_set;
 }
@@ -376,19 +286,20 @@ std::unordered_set<Vertical> VerticalMap<Value>::KeySet() {
 template <class Value>
 std::vector<std::shared_ptr<Value const>> VerticalMap<Value>::Values() {
     std::vector<std::shared_ptr<Value const>> values;
-    Bitset subset_key(relation_->GetNumColumns());
-    set_trie_.TraverseEntries(subset_key, [&values]([[maybe_unused]] auto& k, auto v) -> void {
-        values.push_back(v);
+    values.reserve(size_);
+    VisitSlots(live_slots_, [&values]([[maybe_unused]] Vertical const& key, auto value) {
+        values.push_back(value);
+        return true;
     });
     return values;
 }
 
 template <class Value>
 std::unordered_set<typename VerticalMap<Value>::Entry> VerticalMap<Value>::EntrySet() {
-    std::unordered_set<typename VerticalMap<Value>::Entry> entry_set;
-    Bitset subset_key(relation_->GetNumColumns());
-    set_trie_.TraverseEntries(subset_key, [&entry_set, this](auto& k, auto v) -> void {
-        entry_set.emplace(relation_->GetVertical(k), v);
+    std::unordered_set<typename VerticalMap<Value>::Entry> entry_set(size_);
+    VisitSlots(live_slots_, [&entry_set](Vertical const& key, auto value) {
+        entry_set.emplace(key, value);
+        return true;
     });
     return entry_set;
 }
@@ -401,16 +312,14 @@ unsigned int VerticalMap<Value>::RemoveFromUsageCounter(
 
 template <class Value>
 std::shared_ptr<Value> VerticalMap<Value>::Remove(Vertical const& key) {
-    auto removed_value = set_trie_.Remove(key.GetColumnIndices(), 0);
-    if (removed_value != nullptr) size_--;
-    return removed_value;
+    size_t const slot = FindSlot(key);
+    if (slot == kNoSlot) return nullptr;
+    return ReleaseSlot(slot);
 }
 
 template <class Value>
 std::shared_ptr<Value> VerticalMap<Value>::Remove(VerticalMap::Bitset const& key) {
-    auto removed_value = set_trie_.Remove(key, 0);
-    if (removed_value != nullptr) size_--;
-    return removed_value;
+    return Remove(relation_->GetVertical(key));
 }
 
 // comparator is of Compare type - check ascending/descending issues
@@ -421,11 +330,11 @@ void VerticalMap<Value>::Shrink(double factor, std::function<bool(Entry, Entry)>
 
     std::priority_queue<Entry, std::vector<Entry>, std::function<bool(Entry, Entry)>> key_queue(
             compare, std::vector<Entry>(size_));
-    Bitset subset_key(relation_->GetNumColumns());
-    set_trie_.TraverseEntries(subset_key, [&key_queue, this, &can_remove](auto& k, auto v) {
-        if (Entry entry(relation_->GetVertical(k), v); can_remove(entry)) {
+    VisitSlots(live_slots_, [&key_queue, &can_remove](Vertical const& key, auto value) {
+        if (Entry entry(key, value); can_remove(entry)) {
             key_queue.push(entry);
         }
+        return true;
     });
     // unsigned int num_of_removed = 0;
     unsigned int target_size = size_ * factor;
@@ -459,16 +368,14 @@ void VerticalMap<Value>::Shrink(std::unordered_map<Vertical, unsigned int>& usag
                                            : usage_counters[usage_counters.size() / 2];
 
     std::queue<Entry> key_queue;
-    Bitset subset_key(relation_->GetNumColumns());
-    set_trie_.TraverseEntries(
-            subset_key,
-            [&key_queue, this, &can_remove, &usage_counter, median_of_usage](auto& k,
-                                                                             auto v) -> void {
-                if (Entry entry(relation_->GetVertical(k), v);
-                    can_remove(entry) && usage_counter.at(entry.first) <= median_of_usage) {
-                    key_queue.push(entry);
-                }
-            });
+    VisitSlots(live_slots_, [&key_queue, &can_remove, &usage_counter, median_of_usage](
+                                    Vertical const& key, auto value) {
+        if (Entry entry(key, value);
+            can_remove(entry) && usage_counter.at(entry.first) <= median_of_usage) {
+            key_queue.push(entry);
+        }
+        return true;
+    });
     // unsigned int num_of_removed = 0;
     while (!key_queue.empty()) {
         auto key = key_queue.front().first;
@@ -492,29 +399,35 @@ void VerticalMap<Value>::Shrink(std::unordered_map<Vertical, unsigned int>& usag
 
 template <class Value>
 std::shared_ptr<Value> VerticalMap<Value>::Put(Vertical const& key, std::shared_ptr<Value> value) {
-    auto old_value = set_trie_.Associate(key.GetColumnIndices(), 0, std::move(value));
-    if (old_value == nullptr) size_++;
-
-    return old_value;
+    if (value == nullptr) return Remove(key);
+    size_t slot = FindSlot(key);
+    if (slot == kNoSlot) {
+        slot = AcquireSlot(key);
+    }
+    return std::exchange(slots_[slot].value, std::move(value));
 }
 
 template <class Value>
 std::shared_ptr<Value const> VerticalMap<Value>::Get(Vertical const& key) const {
-    return set_trie_.Get(key.GetColumnIndices(), 0);
+    size_t const slot = FindSlot(key);
+    if (slot == kNoSlot) return nullptr;
+    return slots_[slot].value;
 }
 
 template <class Value>
 std::shared_ptr<Value> VerticalMap<Value>::Get(Vertical const& key) {
-    return std::const_pointer_cast<Value>(set_trie_.Get(key.GetColumnIndices(), 0));
+    size_t const slot = FindSlot(key);
+    if (slot == kNoSlot) return nullptr;
+    return slots_[slot].value;
 }
 
 template <class Value>
 std::shared_ptr<Value const> VerticalMap<Value>::Get(Bitset const& key) const {
-    return set_trie_.Get(key, 0);
+    return Get(relation_->GetVertical(key));
 }
 
 // explicitly instantiate to solve template implementation linking issues
-template class VerticalMap<PositionListIndex>;
+template class VerticalMap<PositionListIndex const>;
 
 template class VerticalMap<AgreeSetSample>;
 
@@ -694,7 +607,7 @@ long long BlockingVerticalMap<V>::GetTimeSpentOnShrinking() {
     return VerticalMap<V>::GetTimeSpentOnShrinking();
 }
 
-template class BlockingVerticalMap<PositionListIndex>;
+template class BlockingVerticalMap<PositionListIndex const>;
 
 template class BlockingVerticalMap<AgreeSetSample>;
 
@@ -21,79 +21,45 @@ class VerticalMap {
 protected:
     using Bitset = boost::dynamic_bitset<>;
 
-    // typename std::shared_ptr<Value> shared_ptr<Value>;
-
-    // Each node corresponds to a bit in a bitset. Each node also has a vector of the possible
-    // consequent set bits.
-    class SetTrie {
-    private:
-        size_t offset_;
-        size_t dimension_;
-        std::vector<std::unique_ptr<SetTrie>> subtries_;  // unique_ptr?
-        std::shared_ptr<Value> value_;
-
-        bool IsEmpty() const;
-
-    public:
-        explicit SetTrie(size_t dimension) : SetTrie(0, dimension) {}
-
-        SetTrie(size_t offset, size_t dimension) : offset_(offset), dimension_(dimension) {}
-
-        // Sets given key to a given value
-        // Returns the old value with ownership
-        // Not a const method as SetTrie gets changed
-        std::shared_ptr<Value> Associate(Bitset const& key, size_t next_bit,
-                                         std::shared_ptr<Value> value);
-
-        // Returns a pointer to the value mapped by the given key
-        std::shared_ptr<Value const> Get(Bitset const& key, size_t next_bit) const;
-
-        // Erases an entry with the given key
-        // Returns the old value with ownership
-        std::shared_ptr<Value> Remove(Bitset const& key, size_t next_bit);
-
-        // Gets the subtrie with the given index. If such a subtrie does not exist, creates one
-        // Not a const method as a SetTrie may be created
-        SetTrie* GetOrCreateSubTrie(size_t index);
-
-        // Gets the subtrie with the given index
-        // Non-const version of the method -- needed in getOrCreateSubtrie to manipulate SetTrie*
-        SetTrie* GetSubtrie(size_t index);
-
-        // Gets the subtrie with the given index
-        // Const version of the method
-        SetTrie const* GetSubtrie(size_t index) const;
-
-        // Calls collector on every trie that is a subset of the given subset_key
-        bool CollectSubsetKeys(
-                Bitset const& key, size_t next_bit, Bitset& subset_key,
-                std::function<bool(Bitset const&, std::shared_ptr<Value const>)> const& collector)
-                const;
-
-        // Calls collector on every trie that is a superset of the given subsetKey
-        bool CollectSupersetKeys(
-                Bitset const& key, size_t next_bit, Bitset& superset_key,
-                std::function<bool(Bitset const&, std::shared_ptr<Value const>)> const& collector)
-                const;
-
-        // Calls collector on every trie that is a superset of the given subsetKey with no bits from
-        // the blacklist
-        bool CollectRestrictedSupersetKeys(
-                Bitset const& key, Bitset const& blacklist, size_t next_bit, Bitset& superset_key,
-                std::function<void(Bitset const&, std::shared_ptr<Value const>)> const& collector)
-                const;
-
-        // Calls collector on every entry
-        void TraverseEntries(
-                Bitset& subset_key,
-                std::function<void(Bitset const&, std::shared_ptr<Value const>)> collector) const;
+    // Entries are kept in a flat array of slots. Keys are looked up through an open-addressing
+    // table of slot numbers, and subset and superset queries through per-column bitmaps over the
+    // slots, each marking the slots whose key contains the column.
+    struct Slot {
+        Vertical key;
+        // nullptr if the slot is free
+        std::shared_ptr<Value> value;
     };
 
+    static constexpr size_t kNoSlot = -1;
+    static constexpr size_t kRemovedSlot = -2;
+
     RelationalSchema const* relation_;
     size_t size_ = 0;
     long long shrink_invocations_ = 0;
     long long time_spent_on_shrinking_ = 0;
-    SetTrie set_trie_;
+
+    std::vector<Slot> slots_;
+    std::vector<size_t> free_slots_;
+    Bitset live_slots_;
+    std::vector<Bitset> column_slots_;
+    // slot numbers by key hash with linear probing, its size is a power of two
+    std::vector<size_t> table_;
+    size_t removed_in_table_ = 0;
+
+    size_t TablePosition(Vertical const& key) const noexcept;
+    // Returns the slot of the key or kNoSlot
+    size_t FindSlot(Vertical const& key) const;
+    void Rehash(size_t table_size);
+    size_t AcquireSlot(Vertical const& key);
+    std::shared_ptr<Value> ReleaseSlot(size_t slot);
+
+    // Slots whose keys are supersets of the key without columns of the blacklist
+    Bitset SupersetSlots(Bitset const& key, Bitset const* blacklist = nullptr) const;
+    Bitset SubsetSlots(Bitset const& key) const;
+    // Calls collector on entries of the slots until it returns false
+    void VisitSlots(Bitset const& slots,
+                    std::function<bool(Vertical const&, std::shared_ptr<Value const>)> const&
+                            collector) const;
 
     unsigned int RemoveFromUsageCounter(std::unordered_map<Vertical, unsigned int>& usage_counter,
                                         Vertical const& key);
@@ -102,7 +68,7 @@ public:
     using Entry = std::pair<Vertical, std::shared_ptr<Value const>>;
 
     explicit VerticalMap(RelationalSchema const* relation)
-        : relation_(relation), set_trie_(relation->GetNumColumns()) {}
+        : relation_(relation), column_slots_(relation->GetNumColumns()) {}
 
     virtual size_t GetSize() const {
         return size_;
@@ -5,6 +5,7 @@
 #include <unordered_map>
 
 #include "core/config/exceptions.h"
+#include "core/model/table/dataset.h"
 
 namespace model {
 
@@ -111,4 +112,30 @@ std::unique_ptr<TransactionalData> TransactionalData::CreateFrom(Params& params)
     }
     throw config::ConfigurationError("Unsupported or unknown input format specified.");
 }
+
+std::shared_ptr<TransactionalData const> TransactionalData::Load(Params& params) {
+    auto* dataset = dynamic_cast<Dataset*>(params.input_table.get());
+    if (dataset == nullptr) {
+        return CreateFrom(params);
+    }
+
+    std::string key = "transactional:" + std::to_string(static_cast<int>(params.input_format_type));
+    if (params.input_format_type == InputFormatType::kSingular) {
+        key += ':' + std::to_string(params.tid_column_index) + ':' +
+               std::to_string(params.item_column_index);
+    } else {
+        key += params.first_column_tid ? ":1" : ":0";
+    }
+    return dataset->GetOrCreate<TransactionalData>(key, [&params](IDatasetStream& stream) {
+        switch (params.input_format_type) {
+            case InputFormatType::kSingular:
+                return std::shared_ptr<TransactionalData const>(CreateFromSingular(
+                        stream, params.tid_column_index, params.item_column_index));
+            case InputFormatType::kTabular:
+                return std::shared_ptr<TransactionalData const>(
+                        CreateFromTabular(stream, params.first_column_tid));
+        }
+        throw config::ConfigurationError("Unsupported or unknown input format specified.");
+    });
+}
 }  // namespace model
@@ -50,6 +50,10 @@ public:
 
     [[nodiscard]] static std::unique_ptr<TransactionalData> CreateFrom(Params& params);
 
+    /* Same as CreateFrom, but if params.input_table is a model::Dataset, the transactions are
+     * built once and shared with every algorithm using that dataset */
+    [[nodiscard]] static std::shared_ptr<TransactionalData const> Load(Params& params);
+
     std::vector<std::string> const& GetItemUniverse() const noexcept {
         return item_universe_;
     }
@@ -121,7 +121,12 @@ std::string CSVParser::GetUnparsedLine(unsigned long long const line_index) {
     return line;
 }
 
-std::vector<std::string> CSVParser::ParseString(std::string const& s) const {
+namespace {
+
+using Tokenizer = boost::tokenizer<boost::escaped_list_separator<char>>;
+
+/* Doubles backslashes and escapes double quotes so that they survive boost parsing */
+std::string PreserveSpecialSymbols(std::string const& s) {
     std::size_t const length = s.size();
     std::string t;
     for (std::size_t index = 0; index < length; ++index) {
@@ -133,32 +138,80 @@ std::vector<std::string> CSVParser::ParseString(std::string const& s) const {
             t.push_back(s[index]);
         }
     }
+    return t;
+}
+
+std::string UnquoteToken(std::string const& token) {
+    std::size_t const token_length = token.size();
+    bool is_enclosed = token_length >= 2 && token.front() == '"' &&
+                       token.back() == '"';  // states whether a field is enclosed in double-quotes
+
+    std::string new_token;
+    for (std::size_t index = 0; index < token_length; ++index) {
+        if (token[index] == '"') {
+            if (is_enclosed && index > 0 && index < token_length - 2 &&
+                token[index + 1] == '"') {  // transfer "" to " if the current field is enclosed
+                                            // in double-quotes
+                new_token.push_back(token[index]);
+                ++index;
+            }
+        } else {
+            new_token.push_back(token[index]);
+        }
+    }
+    return new_token;
+}
+
+}  // namespace
+
+std::vector<std::string> CSVParser::ParseString(std::string const& s) const {
+    std::string const t = PreserveSpecialSymbols(s);
 
     std::vector<std::string> tokens;
     tokens.reserve(number_of_columns_);
     boost::escaped_list_separator<char> list_sep(escape_symbol_, separator_, quote_);
-    boost::tokenizer<boost::escaped_list_separator<char>> tokenizer(t, list_sep);
+    Tokenizer tokenizer(t, list_sep);
 
     for (auto& token : tokenizer) {
-        std::size_t const token_length = token.size();
-        bool is_enclosed =
-                token_length >= 2 && token.front() == '"' &&
-                token.back() == '"';  // states whether a field is enclosed in double-quotes
-
-        std::string new_token;
-        for (std::size_t index = 0; index < token_length; ++index) {
-            if (token[index] == '"') {
-                if (is_enclosed && index > 0 && index < token_length - 2 &&
-                    token[index + 1] == '"') {  // transfer "" to " if the current field is enclosed
-                                                // in double-quotes
-                    new_token.push_back(token[index]);
-                    ++index;
-                }
-            } else {
-                new_token.push_back(token[index]);
-            }
+        tokens.push_back(UnquoteToken(token));
+    }
+
+    return tokens;
+}
+
+std::vector<std::string> CSVParser::ParseStringProjection(
+        std::string const& s, std::vector<model::ColumnIndex> const& column_indices) {
+    if (column_indices != projection_indices_) {
+        projection_indices_ = column_indices;
+        projection_positions_.assign(number_of_columns_, kNotProjected);
+        for (std::size_t i = 0; i < column_indices.size(); ++i) {
+            assert(column_indices[i] < projection_positions_.size());
+            projection_positions_[column_indices[i]] = i;
         }
-        tokens.push_back(std::move(new_token));
+    }
+
+    std::string const t = PreserveSpecialSymbols(s);
+    boost::escaped_list_separator<char> list_sep(escape_symbol_, separator_, quote_);
+    Tokenizer tokenizer(t, list_sep);
+
+    // Fields outside the projection are only split off, never unquoted or stored
+    std::vector<std::string> tokens(column_indices.size());
+    int num_fields = 0;
+    for (auto it = tokenizer.begin(); it != tokenizer.end(); ++it, ++num_fields) {
+        if (num_fields >= number_of_columns_) {
+            continue;
+        }
+        int const position = projection_positions_[num_fields];
+        if (position != kNotProjected) {
+            tokens[position] = UnquoteToken(*it);
+        }
+    }
+    // An empty line of a single-column table holds one empty value
+    if (num_fields == 0 && number_of_columns_ == 1) {
+        num_fields = 1;
+    }
+    if (num_fields != number_of_columns_) {
+        return {};
     }
 
     return tokens;
@@ -180,3 +233,12 @@ std::vector<std::string> CSVParser::GetNextRow() {
 
     return result;
 }
+
+std::vector<std::string> CSVParser::GetNextProjectedRow(
+        std::vector<model::ColumnIndex> const& column_indices) {
+    std::vector<std::string> result = ParseStringProjection(next_line_, column_indices);
+
+    GetNextIfHas();
+
+    return result;
+}
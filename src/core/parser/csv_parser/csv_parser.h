@@ -10,6 +10,7 @@
 #include <string>
 #include <vector>
 
+#include "core/model/table/column_index.h"
 #include "core/model/table/idataset_stream.h"
 
 struct CSVConfig {
@@ -30,10 +31,17 @@ private:
     int number_of_columns_;
     std::vector<std::string> column_names_;
     std::string relation_name_;
+    /* Projection used by the last GetNextProjectedRow call and, for every source column, its
+     * position in the projected row or kNotProjected */
+    std::vector<model::ColumnIndex> projection_indices_;
+    std::vector<int> projection_positions_;
+    static constexpr int kNotProjected = -1;
     void GetNext();
     void PeekNext();
     void GetLine(unsigned long long const line_index);
     std::vector<std::string> ParseString(std::string const& s) const;
+    std::vector<std::string> ParseStringProjection(
+            std::string const& s, std::vector<model::ColumnIndex> const& column_indices);
     void GetNextIfHas();
     void SkipLine();
 
@@ -46,6 +54,8 @@ public:
     explicit CSVParser(CSVConfig const& csv_config);
 
     std::vector<std::string> GetNextRow() override;
+    std::vector<std::string> GetNextProjectedRow(
+            std::vector<model::ColumnIndex> const& column_indices) override;
     std::string GetUnparsedLine(unsigned long long const line_index);
     std::vector<std::string> ParseLine(unsigned long long const line_index);
 
@@ -1,4 +1,9 @@
+#include <cstdint>
 #include <fstream>
+#include <memory>
+#include <stdexcept>
+#include <string>
+#include <utility>
 
 #include <boost/graph/adjacency_list.hpp>
 #include <boost/graph/graphviz.hpp>
@@ -6,6 +11,8 @@
 
 #include "core/algorithms/gdd/gdd_graph_description.h"
 #include "core/parser/graph_parser/graph_parser.h"
+#include "core/parser/graph_parser/graph_table.h"
+#include "core/util/parallel_for.h"
 
 namespace parser::graph_parser::gdd {
 
@@ -42,6 +49,38 @@ public:
     }
 };
 
+model::gdd::graph_t BuildGraph(GraphTable const& table, util::WorkerThreadPool* pool) {
+    model::gdd::graph_t result(table.NumVertices());
+    std::vector<std::string> const names(table.attribute_names.begin(),
+                                         table.attribute_names.end());
+    auto const label_it = std::ranges::find(names, "label");
+    std::size_t const label_name = label_it - names.begin();
+    util::ParallelForRanges(
+            pool, table.NumVertices(), kMinRecordRange, [&](std::size_t begin, std::size_t end) {
+                for (std::size_t v = begin; v != end; ++v) {
+                    model::gdd::VertexProperties& vertex = result[v];
+                    std::int64_t const id = table.vertex_ids[v];
+                    if (!std::in_range<std::size_t>(id)) {
+                        throw std::runtime_error("Graph table: vertex id " + std::to_string(id) +
+                                                 " is out of range");
+                    }
+                    vertex.id = static_cast<std::size_t>(id);
+                    for (GraphTable::Attribute const& attribute : table.GetAttributes(v)) {
+                        if (attribute.name == label_name) {
+                            vertex.label = attribute.value;
+                        } else {
+                            vertex.attributes.emplace(names[attribute.name], attribute.value);
+                        }
+                    }
+                }
+            });
+    for (GraphTable::Edge const& edge : table.edges) {
+        boost::add_edge(edge.source, edge.target,
+                        model::gdd::EdgeProperties{std::string(edge.label)}, result);
+    }
+    return result;
+}
+
 }  // namespace
 
 model::gdd::graph_t ReadGraph(std::istream& stream) {
@@ -82,9 +121,38 @@ model::gdd::graph_t ReadGraph(std::istream& stream) {
     return result;
 }
 
-model::gdd::graph_t ReadGraph(std::filesystem::path const& path) {
+model::gdd::graph_t ReadGraph(std::filesystem::path const& path, config::ThreadNumType threads) {
+    std::optional<util::WorkerThreadPool> pool;
+    if (threads > 1) {
+        pool.emplace(threads);
+    }
+    util::WorkerThreadPool* pool_ptr = pool ? std::addressof(*pool) : nullptr;
+    if (std::optional<GraphTable> table = GraphTable::TryRead(path, pool_ptr)) {
+        return BuildGraph(*table, pool_ptr);
+    }
     std::ifstream f(path);
     return ReadGraph(f);
 }
 
+void WriteGraphSnapshot(std::filesystem::path const& path, model::gdd::graph_t const& result) {
+    GraphTable table;
+    std::unordered_map<std::string_view, std::uint32_t> name_indices = {{"label", 0}};
+    table.attribute_names.push_back("label");
+    for (model::gdd::vertex_t v : boost::make_iterator_range(boost::vertices(result))) {
+        table.vertex_ids.push_back(static_cast<std::int64_t>(result[v].id));
+        if (!result[v].label.empty()) table.attributes.push_back({0, result[v].label});
+        for (auto const& [name, value] : result[v].attributes) {
+            auto [it, inserted] = name_indices.try_emplace(name, name_indices.size());
+            if (inserted) table.attribute_names.push_back(name);
+            table.attributes.push_back({it->second, value});
+        }
+        table.attribute_offsets.push_back(table.attributes.size());
+    }
+    for (model::gdd::edge_t e : boost::make_iterator_range(boost::edges(result))) {
+        table.edges.push_back(
+                {boost::source(e, result), boost::target(e, result), result[e].label});
+    }
+    table.WriteSnapshot(path);
+}
+
 }  // namespace parser::graph_parser::gdd
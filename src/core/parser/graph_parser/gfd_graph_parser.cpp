@@ -1,3 +1,9 @@
+#include <cstdint>
+#include <memory>
+#include <stdexcept>
+#include <string>
+#include <utility>
+
 #include <boost/algorithm/string.hpp>
 #include <boost/bind/bind.hpp>
 #include <boost/graph/adjacency_list.hpp>
@@ -5,6 +11,8 @@
 #include <boost/property_map/function_property_map.hpp>
 
 #include "core/parser/graph_parser/graph_parser.h"
+#include "core/parser/graph_parser/graph_table.h"
+#include "core/util/parallel_for.h"
 
 namespace parser {
 
@@ -110,6 +118,34 @@ public:
         return attrs[v][name];
     }
 };
+
+model::graph_t BuildGraph(GraphTable const& table, util::WorkerThreadPool* pool) {
+    model::graph_t result(table.NumVertices());
+    std::vector<std::string> const names(table.attribute_names.begin(),
+                                         table.attribute_names.end());
+    util::ParallelForRanges(
+            pool, table.NumVertices(), kMinRecordRange, [&](std::size_t begin, std::size_t end) {
+                for (std::size_t v = begin; v != end; ++v) {
+                    model::Vertex& vertex = result[v];
+                    std::int64_t const id = table.vertex_ids[v];
+                    if (!std::in_range<int>(id)) {
+                        throw std::runtime_error("Graph table: vertex id " + std::to_string(id) +
+                                                 " is out of range");
+                    }
+                    vertex.node_id = static_cast<int>(id);
+                    auto const attributes = table.GetAttributes(v);
+                    vertex.attributes.reserve(attributes.size());
+                    for (GraphTable::Attribute const& attribute : attributes) {
+                        vertex.attributes.emplace(names[attribute.name], attribute.value);
+                    }
+                }
+            });
+    for (GraphTable::Edge const& edge : table.edges) {
+        boost::add_edge(edge.source, edge.target, model::Edge{std::string(edge.label)}, result);
+    }
+    return result;
+}
+
 }  // namespace
 
 model::graph_t ReadGraph(std::istream& stream) {
@@ -122,7 +158,15 @@ model::graph_t ReadGraph(std::istream& stream) {
     return result;
 };
 
-model::graph_t ReadGraph(std::filesystem::path const& path) {
+model::graph_t ReadGraph(std::filesystem::path const& path, config::ThreadNumType threads) {
+    std::optional<util::WorkerThreadPool> pool;
+    if (threads > 1) {
+        pool.emplace(threads);
+    }
+    util::WorkerThreadPool* pool_ptr = pool ? std::addressof(*pool) : nullptr;
+    if (std::optional<GraphTable> table = GraphTable::TryRead(path, pool_ptr)) {
+        return BuildGraph(*table, pool_ptr);
+    }
     std::ifstream f(path);
     model::graph_t result = ReadGraph(f);
     f.close();
@@ -146,6 +190,25 @@ void WriteGraph(std::filesystem::path const& path, model::graph_t const& result)
     f.close();
 };
 
+void WriteGraphSnapshot(std::filesystem::path const& path, model::graph_t const& result) {
+    GraphTable table;
+    std::unordered_map<std::string_view, std::uint32_t> name_indices;
+    for (model::vertex_t v : boost::make_iterator_range(boost::vertices(result))) {
+        table.vertex_ids.push_back(result[v].node_id);
+        for (auto const& [name, value] : result[v].attributes) {
+            auto [it, inserted] = name_indices.try_emplace(name, name_indices.size());
+            if (inserted) table.attribute_names.push_back(name);
+            table.attributes.push_back({it->second, value});
+        }
+        table.attribute_offsets.push_back(table.attributes.size());
+    }
+    for (model::edge_t e : boost::make_iterator_range(boost::edges(result))) {
+        table.edges.push_back(
+                {boost::source(e, result), boost::target(e, result), result[e].label});
+    }
+    table.WriteSnapshot(path);
+}
+
 model::Gfd ReadGfd(std::istream& stream) {
     model::Gfd result;
     result.SetPremises(ParseLiterals(stream));
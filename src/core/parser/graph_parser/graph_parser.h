@@ -7,16 +7,20 @@
 #include "core/algorithms/gdd/gdd_graph_description.h"
 #include "core/algorithms/gfd/gfd.h"
 #include "core/algorithms/gfd/graph_descriptor.h"
+#include "core/config/thread_number/type.h"
 
 namespace parser::graph_parser {
 
 namespace gfd {
 
 model::graph_t ReadGraph(std::istream& stream);
-model::graph_t ReadGraph(std::filesystem::path const& path);
+// Maps a graph snapshot or parses a .tsv/.csv vertex/edge table in parallel, see graph_table.h;
+// any other file is read as DOT
+model::graph_t ReadGraph(std::filesystem::path const& path, config::ThreadNumType threads = 1);
 
 void WriteGraph(std::ostream& stream, model::graph_t const& result);
 void WriteGraph(std::filesystem::path const& path, model::graph_t const& result);
+void WriteGraphSnapshot(std::filesystem::path const& path, model::graph_t const& result);
 
 model::Gfd ReadGfd(std::istream& stream);
 model::Gfd ReadGfd(std::filesystem::path const& path);
@@ -29,7 +33,10 @@ void WriteGfd(std::filesystem::path const& path, model::Gfd const& result);
 namespace gdd {
 
 model::gdd::graph_t ReadGraph(std::istream& stream);
-model::gdd::graph_t ReadGraph(std::filesystem::path const& path);
+model::gdd::graph_t ReadGraph(std::filesystem::path const& path,
+                              config::ThreadNumType threads = 1);
+
+void WriteGraphSnapshot(std::filesystem::path const& path, model::gdd::graph_t const& result);
 
 }  // namespace gdd
 
@@ -0,0 +1,452 @@
+#include "core/parser/graph_parser/graph_table.h"
+
+#include <algorithm>
+#include <cctype>
+#include <charconv>
+#include <cstring>
+#include <fstream>
+#include <random>
+#include <stdexcept>
+#include <string>
+#include <type_traits>
+#include <unordered_map>
+
+#include <boost/interprocess/file_mapping.hpp>
+
+#include "core/util/parallel_for.h"
+
+namespace parser::graph_parser {
+
+namespace {
+
+namespace bip = boost::interprocess;
+
+constexpr char kMagic[8] = {'D', 'E', 'S', 'B', 'G', 'R', 'P', 'H'};
+constexpr std::uint32_t kVersion = 1;
+constexpr std::size_t kAlignment = 8;
+
+/* Lines of a table are split into chunks of at least this many bytes, so that small files are
+ * parsed on the calling thread */
+constexpr std::size_t kMinChunkSize = 1 << 16;
+
+/* All strings of the snapshot are stored once in a string table and referenced by index */
+struct FileHeader {
+    char magic[8];
+    std::uint32_t version;
+    std::uint32_t reserved;
+    std::uint64_t num_strings;
+    std::uint64_t strings_size;
+    std::uint64_t num_attribute_names;
+    std::uint64_t num_vertices;
+    std::uint64_t num_attributes;
+    std::uint64_t num_edges;
+};
+
+struct AttributeRecord {
+    std::uint32_t name;
+    std::uint32_t value;
+};
+
+struct EdgeRecord {
+    std::uint64_t source;
+    std::uint64_t target;
+    std::uint32_t label;
+    std::uint32_t padding;
+};
+
+static_assert(std::is_trivially_copyable_v<FileHeader> && sizeof(FileHeader) % kAlignment == 0);
+static_assert(std::is_trivially_copyable_v<EdgeRecord> && sizeof(EdgeRecord) % kAlignment == 0);
+
+class Writer {
+    std::ofstream out_;
+    std::size_t written_ = 0;
+
+public:
+    explicit Writer(std::filesystem::path const& path) : out_(path, std::ios::binary) {
+        if (!out_) {
+            throw std::runtime_error("Cannot create graph snapshot " + path.string());
+        }
+    }
+
+    template <typename T>
+    void WriteArray(T const* data, std::size_t count) {
+        static_assert(std::is_trivially_copyable_v<T>);
+        std::size_t const bytes = sizeof(T) * count;
+        out_.write(reinterpret_cast<char const*>(data), bytes);
+        written_ += bytes;
+        if (std::size_t const remainder = written_ % kAlignment; remainder != 0) {
+            static constexpr char kZeros[kAlignment] = {};
+            out_.write(kZeros, kAlignment - remainder);
+            written_ += kAlignment - remainder;
+        }
+    }
+
+    template <typename T>
+    void Write(T const& value) {
+        WriteArray(&value, 1);
+    }
+
+    void Close() {
+        out_.close();
+        if (!out_) throw std::runtime_error("Failed to write graph snapshot");
+    }
+};
+
+class Reader {
+    std::byte const* begin_;
+    std::size_t size_;
+    std::size_t pos_ = 0;
+
+public:
+    Reader(void const* data, std::size_t size)
+        : begin_(static_cast<std::byte const*>(data)), size_(size) {}
+
+    template <typename T>
+    std::span<T const> TakeArray(std::size_t count) {
+        static_assert(alignof(T) <= kAlignment);
+        if (count > (size_ - pos_) / sizeof(T)) {
+            throw std::runtime_error("Graph snapshot is truncated");
+        }
+        std::span<T const> result{reinterpret_cast<T const*>(begin_ + pos_), count};
+        pos_ += sizeof(T) * count;
+        pos_ = std::min(size_, (pos_ + kAlignment - 1) / kAlignment * kAlignment);
+        return result;
+    }
+
+    template <typename T>
+    T const& Take() {
+        return TakeArray<T>(1).front();
+    }
+
+    /* count + 1 offsets delimiting count records, checked before count + 1 can overflow */
+    std::span<std::uint64_t const> TakeOffsets(std::uint64_t count) {
+        if (count >= (size_ - pos_) / sizeof(std::uint64_t)) {
+            throw std::runtime_error("Graph snapshot is truncated");
+        }
+        return TakeArray<std::uint64_t>(count + 1);
+    }
+};
+
+bip::mapped_region MapFile(std::filesystem::path const& path) {
+    try {
+        bip::file_mapping file(path.c_str(), bip::read_only);
+        return bip::mapped_region(file, bip::read_only);
+    } catch (bip::interprocess_exception const& e) {
+        throw std::runtime_error("Cannot map graph file " + path.string() + ": " + e.what());
+    }
+}
+
+void SplitFields(std::string_view line, char separator, std::vector<std::string_view>& fields) {
+    fields.clear();
+    while (true) {
+        std::size_t const end = line.find(separator);
+        fields.push_back(line.substr(0, end));
+        if (end == std::string_view::npos) return;
+        line.remove_prefix(end + 1);
+    }
+}
+
+std::int64_t ParseId(std::string_view field, std::string_view line) {
+    std::int64_t id;
+    auto [end, ec] = std::from_chars(field.data(), field.data() + field.size(), id);
+    if (ec != std::errc{} || end != field.data() + field.size()) {
+        throw std::runtime_error("Graph table: invalid vertex id in \"" + std::string(line) +
+                                 "\"");
+    }
+    return id;
+}
+
+/* Records of a chunk of lines, with edge endpoints not yet resolved to vertex indices */
+struct Chunk {
+    std::vector<std::int64_t> vertex_ids;
+    std::vector<std::size_t> attribute_offsets = {0};
+    std::vector<GraphTable::Attribute> attributes;
+    std::vector<std::int64_t> edge_ends;
+    std::vector<std::string_view> edge_labels;
+};
+
+void ParseChunk(std::string_view text, char separator, std::size_t num_attribute_names,
+                Chunk& chunk) {
+    std::vector<std::string_view> fields;
+    while (!text.empty()) {
+        std::size_t const eol = text.find('\n');
+        std::string_view line = text.substr(0, eol);
+        text.remove_prefix(eol == std::string_view::npos ? text.size() : eol + 1);
+        if (!line.empty() && line.back() == '\r') line.remove_suffix(1);
+        if (line.empty()) continue;
+
+        SplitFields(line, separator, fields);
+        if (fields.front() == "v") {
+            if (fields.size() < 2 || fields.size() > num_attribute_names + 2) {
+                throw std::runtime_error("Graph table: wrong number of fields in \"" +
+                                         std::string(line) + "\"");
+            }
+            chunk.vertex_ids.push_back(ParseId(fields[1], line));
+            for (std::size_t i = 2; i < fields.size(); ++i) {
+                if (fields[i].empty()) continue;
+                chunk.attributes.push_back({static_cast<std::uint32_t>(i - 2), fields[i]});
+            }
+            chunk.attribute_offsets.push_back(chunk.attributes.size());
+        } else if (fields.front() == "e") {
+            if (fields.size() < 3 || fields.size() > 4) {
+                throw std::runtime_error("Graph table: wrong number of fields in \"" +
+                                         std::string(line) + "\"");
+            }
+            chunk.edge_ends.push_back(ParseId(fields[1], line));
+            chunk.edge_ends.push_back(ParseId(fields[2], line));
+            chunk.edge_labels.push_back(fields.size() == 4 ? fields[3] : std::string_view{});
+        } else {
+            throw std::runtime_error("Graph table: unknown record \"" + std::string(line) + "\"");
+        }
+    }
+}
+
+}  // namespace
+
+GraphTable GraphTable::ReadTable(std::filesystem::path const& path, char separator,
+                                 util::WorkerThreadPool* pool) {
+    GraphTable table;
+    if (std::filesystem::file_size(path) == 0) return table;
+    table.region = MapFile(path);
+    std::string_view text{static_cast<char const*>(table.region.get_address()),
+                          table.region.get_size()};
+
+    std::size_t const header_end = std::min(text.find('\n'), text.size());
+    std::string_view header = text.substr(0, header_end);
+    if (!header.empty() && header.back() == '\r') header.remove_suffix(1);
+    std::vector<std::string_view> fields;
+    SplitFields(header, separator, fields);
+    if (fields.size() < 2 || fields[0] != "v" || fields[1] != "id") {
+        throw std::runtime_error("Graph table " + path.string() +
+                                 " must start with a \"v" + separator + "id\" header");
+    }
+    table.attribute_names.assign(fields.begin() + 2, fields.end());
+    text.remove_prefix(std::min(header_end + 1, text.size()));
+
+    /* Chunk boundaries are moved forward to the next line start */
+    std::size_t const num_threads = pool == nullptr ? 1 : pool->ThreadNum();
+    std::size_t const num_chunks = std::clamp<std::size_t>(text.size() / kMinChunkSize, 1,
+                                                           num_threads);
+    std::vector<std::size_t> bounds(num_chunks + 1, text.size());
+    bounds.front() = 0;
+    for (std::size_t i = 1; i != num_chunks; ++i) {
+        std::size_t const pos = std::max(text.size() * i / num_chunks, bounds[i - 1]);
+        std::size_t const eol = text.find('\n', pos);
+        bounds[i] = eol == std::string_view::npos ? text.size() : eol + 1;
+    }
+
+    std::vector<Chunk> chunks(num_chunks);
+    util::ParallelFor(pool, num_chunks, [&](std::size_t i) {
+        ParseChunk(text.substr(bounds[i], bounds[i + 1] - bounds[i]), separator,
+                   table.attribute_names.size(), chunks[i]);
+    });
+
+    std::vector<std::size_t> vertex_starts(num_chunks + 1, 0);
+    std::vector<std::size_t> attribute_starts(num_chunks + 1, 0);
+    std::vector<std::size_t> edge_starts(num_chunks + 1, 0);
+    for (std::size_t i = 0; i != num_chunks; ++i) {
+        vertex_starts[i + 1] = vertex_starts[i] + chunks[i].vertex_ids.size();
+        attribute_starts[i + 1] = attribute_starts[i] + chunks[i].attributes.size();
+        edge_starts[i + 1] = edge_starts[i] + chunks[i].edge_labels.size();
+    }
+    table.vertex_ids.resize(vertex_starts.back());
+    table.attribute_offsets.resize(vertex_starts.back() + 1);
+    table.attributes.resize(attribute_starts.back());
+    table.edges.resize(edge_starts.back());
+
+    util::ParallelFor(pool, num_chunks, [&](std::size_t i) {
+        Chunk const& chunk = chunks[i];
+        std::ranges::copy(chunk.vertex_ids, table.vertex_ids.begin() + vertex_starts[i]);
+        std::ranges::copy(chunk.attributes, table.attributes.begin() + attribute_starts[i]);
+        for (std::size_t v = 0; v != chunk.vertex_ids.size(); ++v) {
+            table.attribute_offsets[vertex_starts[i] + v + 1] =
+                    attribute_starts[i] + chunk.attribute_offsets[v + 1];
+        }
+    });
+
+    /* Vertex ids are usually 0, 1, ..., in which case they are their own indices */
+    std::size_t const num_vertices = table.NumVertices();
+    bool dense = true;
+    for (std::size_t v = 0; v != num_vertices && dense; ++v) {
+        dense = table.vertex_ids[v] == static_cast<std::int64_t>(v);
+    }
+    std::unordered_map<std::int64_t, std::size_t> indices;
+    if (!dense) {
+        indices.reserve(num_vertices);
+        for (std::size_t v = 0; v != num_vertices; ++v) {
+            if (!indices.emplace(table.vertex_ids[v], v).second) {
+                throw std::runtime_error("Graph table: duplicate vertex id " +
+                                         std::to_string(table.vertex_ids[v]));
+            }
+        }
+    }
+    auto index_of = [&](std::int64_t id) {
+        if (dense) {
+            if (id >= 0 && static_cast<std::size_t>(id) < num_vertices) {
+                return static_cast<std::size_t>(id);
+            }
+        } else if (auto it = indices.find(id); it != indices.end()) {
+            return it->second;
+        }
+        throw std::runtime_error("Graph table: edge refers to unknown vertex " +
+                                 std::to_string(id));
+    };
+
+    util::ParallelFor(pool, num_chunks, [&](std::size_t i) {
+        Chunk const& chunk = chunks[i];
+        for (std::size_t e = 0; e != chunk.edge_labels.size(); ++e) {
+            table.edges[edge_starts[i] + e] = {index_of(chunk.edge_ends[2 * e]),
+                                               index_of(chunk.edge_ends[2 * e + 1]),
+                                               chunk.edge_labels[e]};
+        }
+    });
+    return table;
+}
+
+bool GraphTable::IsSnapshot(std::filesystem::path const& path) {
+    std::ifstream in(path, std::ios::binary);
+    char magic[sizeof(kMagic)] = {};
+    in.read(magic, sizeof(magic));
+    return in && std::memcmp(magic, kMagic, sizeof(kMagic)) == 0;
+}
+
+std::optional<GraphTable> GraphTable::TryRead(std::filesystem::path const& path,
+                                              util::WorkerThreadPool* pool) {
+    if (IsSnapshot(path)) return ReadSnapshot(path, pool);
+    std::string extension = path.extension().string();
+    std::ranges::transform(extension, extension.begin(),
+                           [](unsigned char c) { return std::tolower(c); });
+    if (extension == ".tsv") return ReadTable(path, '\t', pool);
+    if (extension == ".csv") return ReadTable(path, ',', pool);
+    return std::nullopt;
+}
+
+GraphTable GraphTable::ReadSnapshot(std::filesystem::path const& path,
+                                    util::WorkerThreadPool* pool) {
+    GraphTable table;
+    table.region = MapFile(path);
+    Reader reader(table.region.get_address(), table.region.get_size());
+    FileHeader const& header = reader.Take<FileHeader>();
+    if (std::memcmp(header.magic, kMagic, sizeof(kMagic)) != 0 || header.version != kVersion) {
+        throw std::runtime_error(path.string() + " is not a compatible graph snapshot");
+    }
+    auto const string_offsets = reader.TakeOffsets(header.num_strings);
+    auto const chars = reader.TakeArray<char>(header.strings_size);
+    auto const attribute_names = reader.TakeArray<std::uint32_t>(header.num_attribute_names);
+    auto const vertex_ids = reader.TakeArray<std::int64_t>(header.num_vertices);
+    auto const attribute_offsets = reader.TakeOffsets(header.num_vertices);
+    auto const attributes = reader.TakeArray<AttributeRecord>(header.num_attributes);
+    auto const edges = reader.TakeArray<EdgeRecord>(header.num_edges);
+
+    auto corrupted = []() { return std::runtime_error("Graph snapshot is corrupted"); };
+    /* All offsets are checked before any of them is used, so that the parallel passes below
+     * never index past the mapped arrays */
+    auto is_valid = [](std::span<std::uint64_t const> offsets, std::uint64_t size) {
+        return offsets.front() == 0 && offsets.back() == size &&
+               std::ranges::is_sorted(offsets);
+    };
+    if (!is_valid(string_offsets, header.strings_size) ||
+        !is_valid(attribute_offsets, header.num_attributes)) {
+        throw corrupted();
+    }
+    std::vector<std::string_view> strings(header.num_strings);
+    util::ParallelForRanges(pool, strings.size(), kMinRecordRange,
+                            [&](std::size_t begin, std::size_t end) {
+                                for (std::size_t i = begin; i != end; ++i) {
+                                    strings[i] = {chars.data() + string_offsets[i],
+                                                  string_offsets[i + 1] - string_offsets[i]};
+                                }
+                            });
+    auto string_at = [&](std::uint32_t index) {
+        if (index >= strings.size()) throw corrupted();
+        return strings[index];
+    };
+
+    for (std::uint32_t name : attribute_names) {
+        table.attribute_names.push_back(string_at(name));
+    }
+    table.vertex_ids.assign(vertex_ids.begin(), vertex_ids.end());
+    table.attribute_offsets.resize(attribute_offsets.size());
+    table.attributes.resize(attributes.size());
+    table.edges.resize(edges.size());
+
+    util::ParallelForRanges(
+            pool, vertex_ids.size(), kMinRecordRange, [&](std::size_t begin, std::size_t end) {
+                for (std::size_t v = begin; v != end; ++v) {
+                    table.attribute_offsets[v + 1] = attribute_offsets[v + 1];
+                    for (std::size_t i = attribute_offsets[v]; i != attribute_offsets[v + 1]; ++i) {
+                        if (attributes[i].name >= attribute_names.size()) throw corrupted();
+                        table.attributes[i] = {attributes[i].name, string_at(attributes[i].value)};
+                    }
+                }
+            });
+    util::ParallelForRanges(
+            pool, edges.size(), kMinRecordRange, [&](std::size_t begin, std::size_t end) {
+                for (std::size_t e = begin; e != end; ++e) {
+                    EdgeRecord const& edge = edges[e];
+                    if (edge.source >= vertex_ids.size() || edge.target >= vertex_ids.size()) {
+                        throw corrupted();
+                    }
+                    table.edges[e] = {edge.source, edge.target, string_at(edge.label)};
+                }
+            });
+    return table;
+}
+
+void GraphTable::WriteSnapshot(std::filesystem::path const& path) const {
+    std::unordered_map<std::string_view, std::uint32_t> string_indices;
+    std::vector<std::uint64_t> string_offsets = {0};
+    std::string chars;
+    auto intern = [&](std::string_view str) {
+        auto [it, inserted] = string_indices.try_emplace(str, string_indices.size());
+        if (inserted) {
+            chars += str;
+            string_offsets.push_back(chars.size());
+        }
+        return it->second;
+    };
+
+    std::vector<std::uint32_t> name_records;
+    name_records.reserve(attribute_names.size());
+    for (std::string_view name : attribute_names) {
+        name_records.push_back(intern(name));
+    }
+    std::vector<AttributeRecord> attribute_records;
+    attribute_records.reserve(attributes.size());
+    for (Attribute const& attribute : attributes) {
+        attribute_records.push_back({attribute.name, intern(attribute.value)});
+    }
+    std::vector<EdgeRecord> edge_records;
+    edge_records.reserve(edges.size());
+    for (Edge const& edge : edges) {
+        edge_records.push_back({edge.source, edge.target, intern(edge.label), 0});
+    }
+    std::vector<std::uint64_t> offset_records(attribute_offsets.begin(), attribute_offsets.end());
+
+    std::filesystem::path tmp_path = path;
+    tmp_path += ".tmp" + std::to_string(std::random_device{}());
+    Writer writer(tmp_path);
+
+    FileHeader header{};
+    std::memcpy(header.magic, kMagic, sizeof(kMagic));
+    header.version = kVersion;
+    header.num_strings = string_indices.size();
+    header.strings_size = chars.size();
+    header.num_attribute_names = name_records.size();
+    header.num_vertices = vertex_ids.size();
+    header.num_attributes = attribute_records.size();
+    header.num_edges = edge_records.size();
+    writer.Write(header);
+    writer.WriteArray(string_offsets.data(), string_offsets.size());
+    writer.WriteArray(chars.data(), chars.size());
+    writer.WriteArray(name_records.data(), name_records.size());
+    writer.WriteArray(vertex_ids.data(), vertex_ids.size());
+    writer.WriteArray(offset_records.data(), offset_records.size());
+    writer.WriteArray(attribute_records.data(), attribute_records.size());
+    writer.WriteArray(edge_records.data(), edge_records.size());
+    writer.Close();
+
+    std::filesystem::rename(tmp_path, path);
+}
+
+}  // namespace parser::graph_parser
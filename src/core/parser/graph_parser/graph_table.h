@@ -0,0 +1,84 @@
+/** \file
+ * \brief Vertex and edge tables of a graph read from a text table or a binary snapshot
+ *
+ * Both formats are parsed into the same flat arrays, which the GFD and GDD parsers then turn into
+ * their boost graphs. Input files are mapped read-only and all strings are views into the mapped
+ * region, so nothing is copied until the graph is built.
+ *
+ * The table format is one record per line, fields separated by a single separator character
+ * (no quoting). The first line is a header `v<sep>id[<sep>attribute]...` naming the vertex
+ * attribute columns. Vertex records are `v<sep>id[<sep>value]...`, an empty value meaning that the
+ * vertex has no such attribute; `label` is an ordinary attribute column. Edge records are
+ * `e<sep>source id<sep>target id[<sep>label]`. Empty lines are skipped.
+ */
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <filesystem>
+#include <optional>
+#include <span>
+#include <string_view>
+#include <vector>
+
+#include <boost/interprocess/mapped_region.hpp>
+
+#include "core/util/worker_thread_pool.h"
+
+namespace parser::graph_parser {
+
+/* Vertices and edges are processed in ranges of at least this many records */
+inline constexpr std::size_t kMinRecordRange = 1 << 12;
+
+struct GraphTable {
+    struct Attribute {
+        /* index into attribute_names */
+        std::uint32_t name;
+        std::string_view value;
+    };
+
+    struct Edge {
+        /* indices of the endpoints in vertex_ids */
+        std::size_t source;
+        std::size_t target;
+        std::string_view label;
+    };
+
+    std::vector<std::string_view> attribute_names;
+    std::vector<std::int64_t> vertex_ids;
+    /* attributes of vertex i are attributes[attribute_offsets[i], attribute_offsets[i + 1]) */
+    std::vector<std::size_t> attribute_offsets = {0};
+    std::vector<Attribute> attributes;
+    std::vector<Edge> edges;
+
+    /* keeps the views valid */
+    boost::interprocess::mapped_region region;
+
+    std::size_t NumVertices() const noexcept {
+        return vertex_ids.size();
+    }
+
+    std::span<Attribute const> GetAttributes(std::size_t vertex) const noexcept {
+        return {attributes.data() + attribute_offsets[vertex],
+                attributes.data() + attribute_offsets[vertex + 1]};
+    }
+
+    /// Parses a vertex/edge table, splitting it into one chunk of lines per thread of pool.
+    /// pool may be nullptr, in which case everything runs on the calling thread.
+    static GraphTable ReadTable(std::filesystem::path const& path, char separator,
+                                util::WorkerThreadPool* pool);
+
+    /// Maps a snapshot written by WriteSnapshot.
+    static GraphTable ReadSnapshot(std::filesystem::path const& path, util::WorkerThreadPool* pool);
+
+    static bool IsSnapshot(std::filesystem::path const& path);
+
+    /// Reads a snapshot, recognized by its magic bytes, or a table with a .tsv or .csv
+    /// extension. Returns nullopt for any other file, which is left to the DOT parser.
+    static std::optional<GraphTable> TryRead(std::filesystem::path const& path,
+                                             util::WorkerThreadPool* pool);
+
+    void WriteSnapshot(std::filesystem::path const& path) const;
+};
+
+}  // namespace parser::graph_parser
@@ -0,0 +1,26 @@
+#include "core/util/arena.h"
+
+namespace util {
+
+void* CountingResource::do_allocate(std::size_t bytes, std::size_t alignment) {
+    void* p = upstream_->allocate(bytes, alignment);
+    std::size_t const now = bytes_.fetch_add(bytes, std::memory_order_relaxed) + bytes;
+    std::size_t peak = peak_bytes_.load(std::memory_order_relaxed);
+    while (peak < now &&
+           !peak_bytes_.compare_exchange_weak(peak, now, std::memory_order_relaxed)) {
+    }
+    return p;
+}
+
+void CountingResource::do_deallocate(void* p, std::size_t bytes, std::size_t alignment) {
+    upstream_->deallocate(p, bytes, alignment);
+    bytes_.fetch_sub(bytes, std::memory_order_relaxed);
+}
+
+void Arena::Release() {
+    pool_.release();
+    monotonic_.release();
+    counting_.ResetPeak();
+}
+
+}  // namespace util
@@ -0,0 +1,88 @@
+#pragma once
+
+#include <atomic>
+#include <cstddef>
+#include <memory_resource>
+
+namespace util {
+
+/// Memory resource that forwards to an upstream resource and counts the bytes currently taken
+/// from it, as well as their peak. Thread-safe if the upstream resource is.
+class CountingResource : public std::pmr::memory_resource {
+private:
+    std::pmr::memory_resource* upstream_;
+    std::atomic<std::size_t> bytes_ = 0;
+    std::atomic<std::size_t> peak_bytes_ = 0;
+
+    void* do_allocate(std::size_t bytes, std::size_t alignment) override;
+    void do_deallocate(void* p, std::size_t bytes, std::size_t alignment) override;
+
+    bool do_is_equal(std::pmr::memory_resource const& other) const noexcept override {
+        return this == &other;
+    }
+
+public:
+    explicit CountingResource(
+            std::pmr::memory_resource* upstream = std::pmr::new_delete_resource()) noexcept
+        : upstream_(upstream) {}
+
+    std::size_t GetBytes() const noexcept {
+        return bytes_.load(std::memory_order_relaxed);
+    }
+
+    std::size_t GetPeakBytes() const noexcept {
+        return peak_bytes_.load(std::memory_order_relaxed);
+    }
+
+    /// Starts counting the peak anew from the current number of bytes.
+    void ResetPeak() noexcept {
+        peak_bytes_.store(GetBytes(), std::memory_order_relaxed);
+    }
+};
+
+///
+/// \brief Memory of one algorithm run.
+///
+/// Structures built during Execute and dropped by ResetState can take their memory from the
+/// arena through std::pmr containers and polymorphic allocators instead of taking small blocks
+/// from the global heap one by one. All the arena's memory is counted, so it can be checked
+/// against a memory budget exactly. Release() returns all of it at once, visiting only the
+/// chunks of the arena and never the objects in them. Every object allocated from the arena must
+/// be destroyed or abandoned before that.
+///
+class Arena {
+private:
+    CountingResource counting_;
+    std::pmr::synchronized_pool_resource pool_{&counting_};
+    std::pmr::monotonic_buffer_resource monotonic_{&counting_};
+
+public:
+    Arena() = default;
+    Arena(Arena const&) = delete;
+    Arena& operator=(Arena const&) = delete;
+
+    /// Pools of blocks of a few sizes, where freed blocks are reused. Thread-safe.
+    std::pmr::memory_resource* GetPool() noexcept {
+        return &pool_;
+    }
+
+    /// Bump allocation for structures that only grow until the end of the run: deallocation does
+    /// nothing. Not thread-safe.
+    std::pmr::memory_resource* GetMonotonic() noexcept {
+        return &monotonic_;
+    }
+
+    /// Bytes the arena holds, counted in whole chunks taken from the heap.
+    std::size_t GetBytes() const noexcept {
+        return counting_.GetBytes();
+    }
+
+    /// Peak of GetBytes() since the last Release().
+    std::size_t GetPeakBytes() const noexcept {
+        return counting_.GetPeakBytes();
+    }
+
+    void Release();
+};
+
+}  // namespace util
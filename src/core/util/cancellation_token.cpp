@@ -0,0 +1,82 @@
+#include "core/util/cancellation_token.h"
+
+#include <fstream>
+
+#if defined(__APPLE__)
+#include <mach/mach.h>
+#elif defined(__unix__)
+#include <unistd.h>
+#endif
+
+namespace util {
+
+std::size_t GetResidentMemoryBytes() {
+#if defined(__APPLE__)
+    mach_task_basic_info info{};
+    mach_msg_type_number_t count = MACH_TASK_BASIC_INFO_COUNT;
+    if (task_info(mach_task_self(), MACH_TASK_BASIC_INFO, reinterpret_cast<task_info_t>(&info),
+                  &count) != KERN_SUCCESS) {
+        return 0;
+    }
+    return info.resident_size;
+#elif defined(__unix__)
+    std::ifstream statm("/proc/self/statm");
+    std::size_t total_pages = 0;
+    std::size_t resident_pages = 0;
+    if (!(statm >> total_pages >> resident_pages)) {
+        return 0;
+    }
+    return resident_pages * static_cast<std::size_t>(sysconf(_SC_PAGESIZE));
+#else
+    return 0;
+#endif
+}
+
+void CancellationToken::Start() {
+    reason_.store(StopReason::kNone, std::memory_order_relaxed);
+    Clock::time_point const now = Clock::now();
+    deadline_ = time_budget_.count() > 0 ? now + time_budget_ : Clock::time_point::max();
+    memory_limit_ = memory_budget_ > 0 ? GetResidentMemoryBytes() + memory_budget_ : 0;
+    arena_limit_ = memory_budget_;
+    next_memory_check_.store(now.time_since_epoch().count(), std::memory_order_relaxed);
+}
+
+/* Keeps the first reason if several threads hit different limits at once */
+bool CancellationToken::Latch(StopReason reason) const noexcept {
+    StopReason expected = StopReason::kNone;
+    reason_.compare_exchange_strong(expected, reason, std::memory_order_relaxed);
+    return true;
+}
+
+bool CancellationToken::IsOverMemoryBudget(Clock::time_point now) const {
+    Clock::rep const now_ticks = now.time_since_epoch().count();
+    Clock::rep next_check = next_memory_check_.load(std::memory_order_relaxed);
+    if (now_ticks < next_check) return false;
+    Clock::rep const following_check =
+            now_ticks + std::chrono::duration_cast<Clock::duration>(kMemoryCheckInterval).count();
+    /* Only one of the threads that poll at the same time reads the memory usage */
+    if (!next_memory_check_.compare_exchange_strong(next_check, following_check,
+                                                    std::memory_order_relaxed)) {
+        return false;
+    }
+    return GetResidentMemoryBytes() > memory_limit_;
+}
+
+bool CancellationToken::IsStopRequested() const {
+    if (reason_.load(std::memory_order_relaxed) != StopReason::kNone) return true;
+    if (cancel_requested_.load(std::memory_order_relaxed)) return Latch(StopReason::kCancelled);
+    if (deadline_ == Clock::time_point::max() && memory_limit_ == 0) return false;
+
+    Clock::time_point const now = Clock::now();
+    if (now >= deadline_) return Latch(StopReason::kTimeLimit);
+    if (memory_limit_ != 0) {
+        /* The arena is released before every computation, so all it holds was allocated since */
+        if (arena_ != nullptr && arena_->GetBytes() > arena_limit_) {
+            return Latch(StopReason::kMemoryLimit);
+        }
+        if (IsOverMemoryBudget(now)) return Latch(StopReason::kMemoryLimit);
+    }
+    return false;
+}
+
+}  // namespace util
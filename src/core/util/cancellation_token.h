@@ -0,0 +1,88 @@
+#pragma once
+
+#include <atomic>
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+
+#include "core/util/arena.h"
+
+namespace util {
+
+/// Why a computation stopped before it was finished.
+enum class StopReason : std::uint8_t { kNone, kCancelled, kTimeLimit, kMemoryLimit };
+
+/// Resident memory of the current process in bytes, or 0 if it cannot be determined.
+std::size_t GetResidentMemoryBytes();
+
+///
+/// \brief Cooperative stop signal with optional time and memory budgets.
+///
+/// Long computations poll IsStopRequested() at safe points and wind down when it returns true.
+/// Cancel() and IsStopRequested() may be called from any thread. The memory budget limits the
+/// growth of the process' resident memory since Start(), and it is sampled at most every
+/// kMemoryCheckInterval, so it is a soft limit. Memory of a tracked arena is checked against the
+/// budget exactly, on every poll.
+///
+class CancellationToken {
+public:
+    using Clock = std::chrono::steady_clock;
+
+    static constexpr std::chrono::milliseconds kMemoryCheckInterval{20};
+
+private:
+    std::atomic<bool> cancel_requested_ = false;
+    mutable std::atomic<StopReason> reason_ = StopReason::kNone;
+
+    std::chrono::milliseconds time_budget_{0};
+    std::size_t memory_budget_ = 0;
+
+    Clock::time_point deadline_ = Clock::time_point::max();
+    std::size_t memory_limit_ = 0;
+    // the memory budget as of Start(), for the exact check of the arena
+    std::size_t arena_limit_ = 0;
+    mutable std::atomic<Clock::rep> next_memory_check_ = 0;
+    Arena const* arena_ = nullptr;
+
+    bool Latch(StopReason reason) const noexcept;
+    bool IsOverMemoryBudget(Clock::time_point now) const;
+
+public:
+    /// Zero means no limit. Takes effect on the next Start().
+    void SetTimeBudget(std::chrono::milliseconds budget) noexcept {
+        time_budget_ = budget;
+    }
+
+    /// Zero means no limit. Takes effect on the next Start().
+    void SetMemoryBudget(std::size_t bytes) noexcept {
+        memory_budget_ = bytes;
+    }
+
+    /// The arena the computation allocates from, or nullptr. Must outlive the token.
+    void TrackArena(Arena const* arena) noexcept {
+        arena_ = arena;
+    }
+
+    /// Begin a new computation: budgets are counted from now and the last stop reason is
+    /// forgotten. A pending cancellation request is kept.
+    void Start();
+
+    /// Mark the computation as finished. Consumes a pending cancellation request.
+    void Finish() noexcept {
+        cancel_requested_.store(false, std::memory_order_relaxed);
+    }
+
+    /// Ask the running computation, or the next one if none is running, to stop.
+    void Cancel() noexcept {
+        cancel_requested_.store(true, std::memory_order_relaxed);
+    }
+
+    /// Safe point check. Once it has returned true, it keeps returning true until Start().
+    bool IsStopRequested() const;
+
+    StopReason GetStopReason() const noexcept {
+        return reason_.load(std::memory_order_relaxed);
+    }
+};
+
+}  // namespace util
@@ -21,7 +21,9 @@ private:
     }
 
 public:
-    explicit CustomRandom(long long seed = 12345) : seed_(InitialScramble(seed)) {
+    static constexpr long long kDefaultSeed = 12345;
+
+    explicit CustomRandom(long long seed = kDefaultSeed) : seed_(InitialScramble(seed)) {
         // std::cout << "Initializing with seed = " << seed << '\n';
     }
 
@@ -5,6 +5,7 @@
 #include <memory>
 #include <sstream>
 #include <stdexcept>
+#include <utility>
 #include <vector>
 
 namespace util {
@@ -246,4 +247,89 @@ void KDTree<PointType>::InsertRecursive(T&& point, std::unique_ptr<KDTree<PointT
     }
 }
 
+// @brief k-dimensional tree over a fixed set of points, built in bulk.
+// Points are stored in a single array: the root of a subtree over [first, last) is
+// the median on its axis at the middle of the range, the subtrees are the halves
+// around it. Unlike KDTree, there are no nodes to allocate, building takes
+// O(n log n) and the tree is safe to query from several threads.
+template <SubscriptableOrder PointType>
+class StaticKDTree {
+private:
+    std::vector<PointType> points_;
+
+    void Build(size_t first, size_t last, size_t depth);
+
+    template <typename Visitor>
+    bool SearchRecursive(size_t first, size_t last, size_t depth, Rect<PointType> const& box,
+                         Visitor& visit) const;
+
+public:
+    StaticKDTree() = default;
+    explicit StaticKDTree(std::vector<PointType> points);
+
+    size_t Size() const noexcept {
+        return points_.size();
+    }
+
+    // Calls visit for every point inside box until it returns false.
+    // Returns false if the search was stopped by visit
+    template <typename Visitor>
+    bool ForEachInRange(Rect<PointType> const& box, Visitor visit) const {
+        if (!points_.empty() && points_.front().GetDim() == 0) {
+            return std::all_of(points_.begin(), points_.end(), visit);
+        }
+        return SearchRecursive(0, points_.size(), 0, box, visit);
+    }
+
+    std::vector<PointType> QuerySearch(Rect<PointType> const& box) const;
+};
+
+template <SubscriptableOrder PointType>
+StaticKDTree<PointType>::StaticKDTree(std::vector<PointType> points) : points_(std::move(points)) {
+    Build(0, points_.size(), 0);
+}
+
+template <SubscriptableOrder PointType>
+void StaticKDTree<PointType>::Build(size_t first, size_t last, size_t depth) {
+    if (last - first <= 1 || points_[first].GetDim() == 0) return;
+
+    size_t axis = depth % points_[first].GetDim();
+    size_t mid = first + (last - first) / 2;
+    std::nth_element(points_.begin() + first, points_.begin() + mid, points_.begin() + last,
+                     [axis](PointType const& a, PointType const& b) { return a[axis] < b[axis]; });
+    Build(first, mid, depth + 1);
+    Build(mid + 1, last, depth + 1);
+}
+
+template <SubscriptableOrder PointType>
+template <typename Visitor>
+bool StaticKDTree<PointType>::SearchRecursive(size_t first, size_t last, size_t depth,
+                                              Rect<PointType> const& box, Visitor& visit) const {
+    if (first == last) return true;
+
+    size_t mid = first + (last - first) / 2;
+    PointType const& point = points_[mid];
+    size_t axis = depth % point.GetDim();
+    auto cur_val = point[axis];
+    if (box.Fits(point) && !visit(point)) return false;
+
+    if (box.lower_bound_[axis] <= cur_val && !SearchRecursive(first, mid, depth + 1, box, visit))
+        return false;
+
+    if (cur_val <= box.upper_bound_[axis] && !SearchRecursive(mid + 1, last, depth + 1, box, visit))
+        return false;
+
+    return true;
+}
+
+template <SubscriptableOrder PointType>
+std::vector<PointType> StaticKDTree<PointType>::QuerySearch(Rect<PointType> const& box) const {
+    std::vector<PointType> res;
+    ForEachInRange(box, [&res](PointType const& point) {
+        res.push_back(point);
+        return true;
+    });
+    return res;
+}
+
 }  // namespace util
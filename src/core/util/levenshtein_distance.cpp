@@ -1,11 +1,38 @@
 #include "core/util/levenshtein_distance.h"
 
 #include <algorithm>
-#include <cassert>
+#include <limits>
 #include <vector>
 
+#include "core/util/target_clones.h"
+
 namespace util {
 
+namespace {
+
+/* Fills row[lo..hi] of the distance matrix of l and r from prev, the previous row, for the
+ * character c of l. row[lo - 1] must already be set, and cells are capped at cap.
+ * Returns the minimum of row[lo - 1..hi].
+ */
+DESBORDANTE_TARGET_CLONES
+unsigned FillRow(unsigned const* prev, unsigned* row, char c, char const* r, size_t lo, size_t hi,
+                 unsigned cap) {
+    /* deletions and substitutions only read the previous row, so this loop is vectorized */
+    for (size_t j = lo; j <= hi; ++j) {
+        unsigned const substitution_cost = prev[j - 1] + (c == r[j - 1] ? 0 : 1);
+        row[j] = std::min({prev[j] + 1, substitution_cost, cap});
+    }
+    /* insertions read the cell to the left, which leaves a cheap sequential scan */
+    unsigned row_min = row[lo - 1];
+    for (size_t j = lo; j <= hi; ++j) {
+        row[j] = std::min(row[j], row[j - 1] + 1);
+        row_min = std::min(row_min, row[j]);
+    }
+    return row_min;
+}
+
+}  // namespace
+
 /* Levenshtein distance computation algorithm taken from
  * https://en.wikipedia.org/wiki/Levenshtein_distance
  */
@@ -20,25 +47,51 @@ unsigned LevenshteinDistance(std::string_view l, std::string_view r) {
 
     for (unsigned i = 0; i != l.size(); ++i) {
         v1[0] = i + 1;
-
-        for (unsigned j = 0; j != r.size(); ++j) {
-            assert(j + 1 < v0.size());
-            unsigned del_cost = v0[j + 1] + 1;
-            unsigned insert_cost = v1[j] + 1;
-            unsigned substitution_cost;
-            if (l[i] == r[j]) {
-                substitution_cost = v0[j];
-            } else {
-                substitution_cost = v0[j] + 1;
-            }
-
-            v1[j + 1] = std::min({del_cost, insert_cost, substitution_cost});
+        if (r_size != 0) {
+            FillRow(v0.data(), v1.data(), l[i], r.data(), 1, r_size,
+                    std::numeric_limits<unsigned>::max());
         }
-
         std::swap(v0, v1);
     }
 
     return v0.back();
 }
 
+unsigned BoundedLevenshteinDistance(std::string_view l, std::string_view r, unsigned bound) {
+    while (!l.empty() && !r.empty() && l.front() == r.front()) {
+        l.remove_prefix(1);
+        r.remove_prefix(1);
+    }
+    while (!l.empty() && !r.empty() && l.back() == r.back()) {
+        l.remove_suffix(1);
+        r.remove_suffix(1);
+    }
+    if (l.size() > r.size()) std::swap(l, r);
+    /* the distance never exceeds the length of the longer string */
+    bound = std::min<size_t>(bound, r.size());
+    unsigned const over = bound + 1;
+    if (r.size() - l.size() > bound) return over;
+    if (l.empty()) return r.size();
+
+    /* Cells outside of the band are at least bound + 1 away, so they are stored as over */
+    size_t const r_size = r.size();
+    std::vector<unsigned> v0(r_size + 1);
+    std::vector<unsigned> v1(r_size + 1);
+    for (size_t j = 0; j != r_size + 1; ++j) {
+        v0[j] = std::min<size_t>(j, over);
+    }
+
+    for (size_t i = 0; i != l.size(); ++i) {
+        size_t const lo = i + 1 > bound ? i + 1 - bound : 1;
+        size_t const hi = std::min(r_size, i + 1 + bound);
+        v1[lo - 1] = lo == 1 ? std::min<size_t>(i + 1, over) : over;
+        unsigned const row_min = FillRow(v0.data(), v1.data(), l[i], r.data(), lo, hi, over);
+        if (hi < r_size) v1[hi + 1] = over;
+        if (row_min > bound) return over;
+        std::swap(v0, v1);
+    }
+
+    return v0[r_size];
+}
+
 }  // namespace util
@@ -6,4 +6,8 @@ namespace util {
 
 unsigned LevenshteinDistance(std::string_view l, std::string_view r);
 
+/* Levenshtein distance if it does not exceed bound, bound + 1 otherwise. Only a band of
+ * 2 * bound + 1 diagonals is computed, and the computation stops once a whole row exceeds bound */
+unsigned BoundedLevenshteinDistance(std::string_view l, std::string_view r, unsigned bound);
+
 }  // namespace util
@@ -1,11 +1,17 @@
 #pragma once
 
+#include <algorithm>
+#include <atomic>
 #include <cassert>
+#include <cstddef>
+#include <exception>
+#include <mutex>
 #include <system_error>
 #include <thread>
 #include <vector>
 
 #include "core/util/logger.h"
+#include "core/util/worker_thread_pool.h"
 
 namespace util {
 
@@ -58,4 +64,55 @@ inline void ParallelForeach(It begin, It end, unsigned const threads_num_max, Un
     }
 }
 
+/* Calls body(i) for every i in [0, size), on the threads of pool or sequentially if pool is
+ * nullptr. Indices are handed out one at a time, so uneven work is balanced. After body has
+ * thrown, no new indices are started, and the first exception is rethrown once all threads are
+ * done. The pool must not be running other work.
+ */
+template <typename Body>
+void ParallelFor(WorkerThreadPool* pool, std::size_t size, Body&& body) {
+    if (pool == nullptr || size < 2) {
+        for (std::size_t i = 0; i < size; ++i) {
+            body(i);
+        }
+        return;
+    }
+
+    std::atomic<bool> failed = false;
+    std::exception_ptr exception;
+    std::mutex exception_mutex;
+    pool->ExecIndex(
+            [&](std::size_t i) {
+                if (failed.load(std::memory_order_relaxed)) return;
+                try {
+                    body(i);
+                } catch (...) {
+                    std::scoped_lock lock(exception_mutex);
+                    if (!exception) exception = std::current_exception();
+                    failed.store(true, std::memory_order_relaxed);
+                }
+            },
+            size);
+    if (exception) {
+        std::rethrow_exception(exception);
+    }
+}
+
+/* Like ParallelFor, but calls body(begin, end) for consecutive ranges that cover [0, size). The
+ * ranges hold at least min_range indices, and there are a few of them per thread, so that cheap
+ * iterations are not handed out one by one.
+ */
+template <typename Body>
+void ParallelForRanges(WorkerThreadPool* pool, std::size_t size, std::size_t min_range,
+                       Body&& body) {
+    constexpr std::size_t kRangesPerThread = 4;
+    std::size_t const num_threads = pool == nullptr ? 1 : pool->ThreadNum();
+    std::size_t const num_ranges = kRangesPerThread * num_threads;
+    std::size_t const range =
+            std::max({min_range, std::size_t{1}, (size + num_ranges - 1) / num_ranges});
+    ParallelFor(pool, (size + range - 1) / range, [&](std::size_t r) {
+        body(r * range, std::min(size, (r + 1) * range));
+    });
+}
+
 }  // namespace util
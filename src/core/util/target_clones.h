@@ -0,0 +1,16 @@
+#pragma once
+
+// Compiles the marked function once per x86-64 microarchitecture level (baseline, SSE4.2, AVX2,
+// AVX-512) and lets the dynamic loader pick the version matching the CPU, so a portable build
+// still runs vector code on modern machines. Only worth it for out-of-line kernels that loop over
+// enough data to amortize the indirect call: the marked function is never inlined.
+// Expands to nothing in native builds, which already target the host CPU, and on platforms
+// without ifunc support.
+#if defined(DESBORDANTE_MULTIVERSIONING) && defined(__x86_64__) && defined(__ELF__) && \
+        ((defined(__clang__) && __clang_major__ >= 14) ||                               \
+         (!defined(__clang__) && defined(__GNUC__) && __GNUC__ >= 11))
+#define DESBORDANTE_TARGET_CLONES \
+    __attribute__((target_clones("default", "arch=x86-64-v2", "arch=x86-64-v3", "arch=x86-64-v4")))
+#else
+#define DESBORDANTE_TARGET_CLONES /* Ignore */
+#endif
@@ -2,6 +2,9 @@
 
 #include <pybind11/pybind11.h>
 
+#include <chrono>
+#include <optional>
+#include <string_view>
 #include <typeindex>
 #include <typeinfo>
 
@@ -109,9 +112,49 @@ void BindMainClasses(py::module_& main_module) {
                     "execute",
                     [](Algorithm& algo, py::kwargs const& kwargs) {
                         ConfigureAlgo(algo, kwargs);
+                        // Lets other Python threads run, e.g. to call cancel.
+                        py::gil_scoped_release release;
                         return algo.Execute();
                     },
-                    "Process data.");
+                    "Process data.")
+            .def("cancel", &Algorithm::Cancel,
+                 "Ask a running execute call to stop at its next safe point and keep the "
+                 "results found so far. Can be called from another thread. If the algorithm is "
+                 "not running, the next execute call stops right away.")
+            .def(
+                    "set_time_budget",
+                    [](Algorithm& algo, double seconds) {
+                        algo.SetTimeBudget(std::chrono::milliseconds(
+                                static_cast<std::chrono::milliseconds::rep>(seconds * 1000)));
+                    },
+                    "seconds"_a,
+                    "Stop every following execute call after the given time and keep the "
+                    "results found so far. 0 means no limit.")
+            .def(
+                    "set_memory_budget",
+                    [](Algorithm& algo, std::size_t megabytes) {
+                        algo.SetMemoryBudget(megabytes << 20);
+                    },
+                    "megabytes"_a,
+                    "Stop every following execute call once the process has grown by the given "
+                    "amount of resident memory and keep the results found so far. 0 means no "
+                    "limit.")
+            .def(
+                    "get_stop_reason",
+                    [](Algorithm const& algo) -> std::optional<std::string_view> {
+                        switch (algo.GetStopReason()) {
+                            case util::StopReason::kCancelled:
+                                return "cancelled";
+                            case util::StopReason::kTimeLimit:
+                                return "time_limit";
+                            case util::StopReason::kMemoryLimit:
+                                return "memory_limit";
+                            default:
+                                return std::nullopt;
+                        }
+                    },
+                    "Get why the last execute call stopped early, or None if it ran to "
+                    "completion. Results of a stopped run are valid but incomplete.");
 #undef CERTAIN_SCRIPTS_ONLY
 }
 }  // namespace python_bindings
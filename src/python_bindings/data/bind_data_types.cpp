@@ -3,9 +3,12 @@
 #include <pybind11/pybind11.h>
 
 #include <pybind11/stl.h>
+#include <pybind11/stl/filesystem.h>
 
 #include "core/config/tabular_data/input_table_type.h"
 #include "core/model/table/column_combination.h"
+#include "core/model/table/dataset.h"
+#include "python_bindings/py_util/create_dataframe_reader.h"
 
 namespace {
 namespace py = pybind11;
@@ -21,6 +24,26 @@ void BindDataTypes(py::module_& main_module) {
     )doc";
     py::class_<config::InputTable>(data_module, "Table");
 
+    py::class_<model::Dataset, std::shared_ptr<model::Dataset>>(data_module, "Dataset", R"doc(
+        A table that is loaded once and shared by all algorithms it is passed to as `table`.
+        Encoded columns, typed columns and transactions are built on first use and reused
+        afterwards.
+    )doc")
+            .def(py::init([](std::filesystem::path path, char separator, bool has_header,
+                             std::optional<std::filesystem::path> snapshot_dir) {
+                     return model::Dataset::FromCsv({std::move(path), separator, has_header},
+                                                    snapshot_dir);
+                 }),
+                 py::arg("path"), py::arg("separator"), py::arg("has_header"),
+                 py::arg("snapshot_dir") = py::none())
+            .def(py::init([](py::handle dataframe) {
+                     return std::make_shared<model::Dataset>(CreateDataFrameReader(dataframe));
+                 }),
+                 py::arg("dataframe"))
+            .def_property_readonly("materialized_count", &model::Dataset::GetNumRepresentations)
+            .def("release", &model::Dataset::ReleaseRepresentations,
+                 "Drop the cached representations of the table.");
+
     using namespace model;
     py::class_<ColumnCombination>(data_module, "ColumnCombination")
             .def("__str__", &ColumnCombination::ToString)
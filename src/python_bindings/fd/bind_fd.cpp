@@ -81,6 +81,12 @@ void BindFd(py::module_& main_module) {
             {"HyFD", "Aid", "EulerFD", "Depminer", "DFD", "FastFDs", "FDep", "FdMine", "FUN",
              kPyroName, kTaneName, kPFDTaneName});
 
+    py::reinterpret_borrow<py::class_<FDAlgorithm, algos::Algorithm>>(
+            fd_module.attr("FdAlgorithm"))
+            .def("get_candidate_frontier", &FDAlgorithm::CandidateFrontier,
+                 "Get the FD candidates left unchecked because the last execute call stopped "
+                 "early.");
+
     auto define_submodule = [&fd_algos_module, &main_module](char const* name,
                                                              std::vector<char const*> algorithms) {
         auto algos_module = main_module.def_submodule(name).def_submodule("algorithms");
@@ -4,6 +4,7 @@
 
 #include <pybind11/stl.h>
 
+#include "core/algorithms/fd/fd_verifier/batch_verifier.h"
 #include "core/algorithms/fd/fd_verifier/fd_verifier.h"
 #include "core/algorithms/fd/fd_verifier/highlight.h"
 #include "core/algorithms/fd/verification_algorithms.h"
@@ -31,6 +32,23 @@ void BindFdVerification(pybind11::module_& main_module) {
             .def("get_num_error_rows", &FDVerifier::GetNumErrorRows)
             .def("get_highlights", &FDVerifier::GetHighlights);
 
+    py::class_<FdVerificationSummary>(fd_verification_module, "FdVerificationSummary")
+            .def_property_readonly("holds", &FdVerificationSummary::Holds)
+            .def_readonly("error", &FdVerificationSummary::error)
+            .def_readonly("num_error_clusters", &FdVerificationSummary::num_error_clusters)
+            .def_readonly("num_error_rows", &FdVerificationSummary::num_error_rows)
+            .def_readonly("highlights", &FdVerificationSummary::highlights);
+    py::class_<UccVerificationSummary>(fd_verification_module, "UccVerificationSummary")
+            .def_property_readonly("holds", &UccVerificationSummary::Holds)
+            .def_readonly("error", &UccVerificationSummary::error)
+            .def_readonly("num_error_clusters", &UccVerificationSummary::num_error_clusters)
+            .def_readonly("num_error_rows", &UccVerificationSummary::num_error_rows)
+            .def_readonly("highlights", &UccVerificationSummary::highlights);
+    auto algos_module = fd_verification_module.attr("algorithms").cast<py::module_>();
+    detail::RegisterAlgorithm<BatchVerifier, Algorithm>(algos_module, "BatchVerifier")
+            .def("get_fd_results", &BatchVerifier::GetFdResults)
+            .def("get_ucc_results", &BatchVerifier::GetUccResults);
+
     main_module.attr("afd_verification") = fd_verification_module;
 }
 }  // namespace python_bindings
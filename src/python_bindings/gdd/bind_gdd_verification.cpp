@@ -15,6 +15,7 @@
 #include "core/algorithms/gdd/gdd.h"
 #include "core/algorithms/gdd/gdd_graph_description.h"
 #include "core/algorithms/gdd/gdd_validator/gdd_validator.h"
+#include "core/algorithms/gdd/gdd_validator/indexed_gdd_validator.h"
 #include "core/algorithms/gdd/gdd_validator/naive_gdd_validator.h"
 #include "core/parser/graph_parser/graph_parser.h"
 #include "python_bindings/py_util/bind_primitive.h"
@@ -146,6 +147,7 @@ void BindGddVerification(pybind11::module_& main_module) {
     namespace py = pybind11;
     using algos::Algorithm;
     using algos::GddValidator;
+    using algos::IndexedGddValidator;
     using algos::NaiveGddValidator;
     using model::Gdd;
     using model::GddCounterexample;
@@ -524,8 +526,10 @@ void BindGddVerification(pybind11::module_& main_module) {
 
     auto const gdd_algos_module = gdd_module.def_submodule("algorithms");
 
-    auto default_cls = detail::RegisterAlgorithm<NaiveGddValidator, GddValidator>(
-            gdd_algos_module, "NaiveGddValidator");
+    detail::RegisterAlgorithm<NaiveGddValidator, GddValidator>(gdd_algos_module,
+                                                               "NaiveGddValidator");
+    auto default_cls = detail::RegisterAlgorithm<IndexedGddValidator, GddValidator>(
+            gdd_algos_module, "IndexedGddValidator");
 
     gdd_algos_module.attr("Default") = default_cls;
     gdd_module.attr("Default") = gdd_algos_module.attr("Default");
@@ -24,6 +24,7 @@
 #include "core/algorithms/md/hymd/preprocessing/column_matches/number_difference.h"
 #include "core/algorithms/md/md.h"
 #include "core/algorithms/md/mining_algorithms.h"
+#include "python_bindings/bind_main_classes.h"
 #include "python_bindings/md/object_similarity_measure.h"
 #include "python_bindings/py_util/bind_primitive.h"
 #include "python_bindings/py_util/table_serialization.h"
@@ -290,5 +291,15 @@ void BindMd(py::module_& main_module) {
             .doc() = R"(Defines a column match with a custom similarity measure.)";
 
     BindPrimitive<HyMD>(md_module, &MdAlgorithm::MdList, "MdAlgorithm", "get_mds", {"HyMD"});
+    // Custom column matches call Python functions while mining, so unlike the other algorithms
+    // the MD miners keep the GIL during execution.
+    py::reinterpret_borrow<py::class_<MdAlgorithm, Algorithm>>(md_module.attr("MdAlgorithm"))
+            .def(
+                    "execute",
+                    [](MdAlgorithm& algo, py::kwargs const& kwargs) {
+                        configure_algorithm::ConfigureAlgo(algo, kwargs);
+                        return algo.Execute();
+                    },
+                    "Process data.");
 }
 }  // namespace python_bindings
@@ -31,7 +31,14 @@ DataframeReaderBase::DataframeReaderBase(py::handle dataframe, std::string name)
       name_(std::move(name)),
       column_names_(GetColumnNames(dataframe_)) {}
 
+DataframeReaderBase::~DataframeReaderBase() {
+    py::gil_scoped_acquire gil;
+    df_iter_ = py::iterator{};
+    dataframe_ = py::object{};
+}
+
 void DataframeReaderBase::Reset() {
+    py::gil_scoped_acquire gil;
     df_iter_ = dataframe_.attr("itertuples")(false, py::none{});
 }
 
@@ -48,14 +55,35 @@ size_t DataframeReaderBase::GetNumberOfColumns() const {
 }
 
 bool DataframeReaderBase::HasNextRow() const {
+    py::gil_scoped_acquire gil;
     return df_iter_ != py::iterator::sentinel();
 }
 
 std::vector<std::string> StringDataframeReader::GetNextRow() {
+    py::gil_scoped_acquire gil;
     return py::cast<std::vector<std::string>>(*df_iter_++);
 }
 
+std::vector<std::string> StringDataframeReader::GetNextProjectedRow(
+        std::vector<model::ColumnIndex> const& column_indices) {
+    py::gil_scoped_acquire gil;
+    auto tuple_row = py::reinterpret_borrow<py::tuple>(*df_iter_);
+    ++df_iter_;
+    std::vector<std::string> strings;
+    strings.reserve(column_indices.size());
+    for (model::ColumnIndex index : column_indices) {
+        strings.push_back(tuple_row[index].cast<std::string>());
+    }
+    return strings;
+}
+
+ArbitraryDataframeReader::~ArbitraryDataframeReader() {
+    py::gil_scoped_acquire gil;
+    is_null_ = nullptr;
+}
+
 std::vector<std::string> ArbitraryDataframeReader::GetNextRow() {
+    py::gil_scoped_acquire gil;
     std::vector<std::string> strings{};
     auto tuple_row = py::reinterpret_borrow<py::object>(*df_iter_);
     ++df_iter_;
@@ -69,4 +97,18 @@ std::vector<std::string> ArbitraryDataframeReader::GetNextRow() {
     return strings;
 }
 
+std::vector<std::string> ArbitraryDataframeReader::GetNextProjectedRow(
+        std::vector<model::ColumnIndex> const& column_indices) {
+    py::gil_scoped_acquire gil;
+    auto tuple_row = py::reinterpret_borrow<py::tuple>(*df_iter_);
+    ++df_iter_;
+    std::vector<std::string> strings;
+    strings.reserve(column_indices.size());
+    for (model::ColumnIndex index : column_indices) {
+        py::handle el = tuple_row[index];
+        strings.emplace_back(is_null_(el) ? model::Null::kValue : py::str(el));
+    }
+    return strings;
+}
+
 }  // namespace python_bindings
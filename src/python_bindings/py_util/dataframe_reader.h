@@ -6,6 +6,8 @@
 
 namespace python_bindings {
 
+// Algorithms run without the GIL (see Algorithm.execute), so every method that touches Python
+// objects takes it first.
 class DataframeReaderBase : public model::IDatasetStream {
 protected:
     pybind11::object dataframe_;
@@ -15,6 +17,7 @@ protected:
 
 public:
     explicit DataframeReaderBase(pybind11::handle dataframe, std::string name = "Pandas dataframe");
+    ~DataframeReaderBase() override;
 
     void Reset() final;
     [[nodiscard]] std::string GetRelationName() const final;
@@ -31,6 +34,8 @@ public:
     using DataframeReaderBase::DataframeReaderBase;
 
     std::vector<std::string> GetNextRow() final;
+    std::vector<std::string> GetNextProjectedRow(
+            std::vector<model::ColumnIndex> const& column_indices) final;
 };
 
 // If a dataframe consists of arbitrary Python objects, we have to first check
@@ -53,8 +58,11 @@ private:
 
 public:
     using DataframeReaderBase::DataframeReaderBase;
+    ~ArbitraryDataframeReader() override;
 
     [[nodiscard]] std::vector<std::string> GetNextRow() final;
+    [[nodiscard]] std::vector<std::string> GetNextProjectedRow(
+            std::vector<model::ColumnIndex> const& column_indices) final;
 };
 
 }  // namespace python_bindings
@@ -14,6 +14,7 @@
 
 #include "core/algorithms/cfd/enums.h"
 #include "core/algorithms/dd/dd.h"
+#include "core/algorithms/fd/fd_verifier/batch_verifier.h"
 #include "core/algorithms/gdd/gdd.h"
 #include "core/algorithms/md/hymd/enums.h"
 #include "core/algorithms/md/hymd/hymd.h"
@@ -95,9 +96,12 @@ py::tuple GetPyType(std::type_index type_index) {
             PyTypePair<config::AfdErrorMeasureType, kPyStr>,
             PyTypePair<model::InputFormatType, kPyStr>,
             PyTypePair<algos::cfd::Substrategy, kPyStr>,
+            PyTypePair<algos::cfd::TIdListType, kPyStr>,
             PyTypePair<algos::hymd::LevelDefinition, kPyStr>,
             PyTypePair<algos::od::Ordering, kPyStr>,
             PyTypePair<std::vector<unsigned int>, kPyList, kPyInt>,
+            PyTypePair<algos::fd_verifier::BatchVerifier::FdList, kPyList, kPyTuple>,
+            PyTypePair<algos::fd_verifier::BatchVerifier::UccList, kPyList, kPyList>,
             {typeid(algos::hymd::HyMD::ColumnMatches),
              []() {
                  return MakeTypeTuple(
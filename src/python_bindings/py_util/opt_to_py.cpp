@@ -10,6 +10,7 @@
 #include <pybind11/stl.h>
 
 #include "core/algorithms/dd/dd.h"
+#include "core/algorithms/fd/fd_verifier/batch_verifier.h"
 #include "core/algorithms/gdd/gdd.h"
 #include "core/algorithms/md/hymd/enums.h"
 #include "core/algorithms/metric/enums.h"
@@ -48,6 +49,8 @@ std::unordered_map<std::type_index, ConvFunction> const kConverters{
         normal_conv_pair<config::MaxLhsType>,
         normal_conv_pair<config::ErrorType>,
         normal_conv_pair<config::IndicesType>,
+        normal_conv_pair<algos::fd_verifier::BatchVerifier::FdList>,
+        normal_conv_pair<algos::fd_verifier::BatchVerifier::UccList>,
         normal_conv_pair<model::DDString>,
         normal_conv_pair<model::Gdd>,
         enum_conv_pair<algos::metric::MetricAlgo>,
@@ -17,6 +17,7 @@
 #include "core/algorithms/dd/dd.h"
 #include "core/algorithms/dd/dd_verifier/Metric.h"
 #include "core/algorithms/fd/afd_metric/afd_metric.h"
+#include "core/algorithms/fd/fd_verifier/batch_verifier.h"
 #include "core/algorithms/gdd/gdd.h"
 #include "core/algorithms/md/hymd/enums.h"
 #include "core/algorithms/md/hymd/hymd.h"
@@ -28,6 +29,7 @@
 #include "core/config/exceptions.h"
 #include "core/config/tabular_data/input_table_type.h"
 #include "core/config/tabular_data/input_tables_type.h"
+#include "core/model/table/dataset.h"
 #include "core/model/transaction/input_format_type.h"
 #include "core/parser/csv_parser/csv_parser.h"
 #include "core/util/enum_to_available_values.h"
@@ -62,6 +64,9 @@ config::InputTable CreateCsvParser(std::string_view option_name, py::tuple const
 }
 
 config::InputTable PythonObjToInputTable(std::string_view option_name, py::handle obj) {
+    if (py::isinstance<model::Dataset>(obj)) {
+        return py::cast<std::shared_ptr<model::Dataset>>(obj);
+    }
     if (py::isinstance<py::tuple>(obj)) {
         return CreateCsvParser(option_name, py::cast<py::tuple>(obj));
     }
@@ -170,6 +175,8 @@ std::unordered_map<std::type_index, ConvFunc> const kConverters{
         kNormalConvPair<unsigned int>,
         kNormalConvPair<long double>,
         kNormalConvPair<std::vector<unsigned int>>,
+        kNormalConvPair<algos::fd_verifier::BatchVerifier::FdList>,
+        kNormalConvPair<algos::fd_verifier::BatchVerifier::UccList>,
         kNormalConvPair<unsigned short>,
         kNormalConvPair<int>,
         kNormalConvPair<size_t>,
@@ -184,6 +191,7 @@ std::unordered_map<std::type_index, ConvFunc> const kConverters{
         kEnumConvPair<algos::afd_metric_calculator::AFDMetric>,
         kEnumConvPair<model::InputFormatType>,
         kEnumConvPair<algos::cfd::Substrategy>,
+        kEnumConvPair<algos::cfd::TIdListType>,
         kEnumConvPair<algos::hymd::LevelDefinition>,
         kEnumConvPair<algos::od::Ordering>,
         kEnumConvPair<algos::cind::CondType>,
@@ -73,7 +73,9 @@ void BindStatistics(pybind11::module_& main_module) {
             .def("get_number_of_values", &DataStats::NumberOfValues,
                  "Get number of values in the column.", py::arg("index"))
             .def("get_number_of_columns", &DataStats::GetNumberOfColumns,
-                 "Get number of columns in the table.")
+                 "Get number of loaded columns.")
+            .def("get_loaded_columns", &DataStats::GetLoadedColumns,
+                 "Get indices in the table of the loaded columns.")
             .def("get_null_columns", &DataStats::GetNullColumns,
                  "Get indices of columns with only null values.")
             .def("get_columns_with_null", &DataStats::GetColumnsWithNull,
@@ -1,3 +1,8 @@
+import os
+import random
+import tempfile
+import threading
+import time
 import unittest
 from collections import namedtuple
 from itertools import chain
@@ -22,6 +27,18 @@ def get_apriori_load_container(load_options):
     return OptionContainer("TestWide.csv", load_options, {})
 
 
+# A table of small random values, on which FD discovery takes a while
+def write_random_table(directory, rows, columns) -> str:
+    rng = random.Random(0)
+    domains = [2 + 3 * column for column in range(columns)]
+    path = os.path.join(directory, "random_table.csv")
+    with open(path, "w") as table:
+        table.write(",".join(f"c{column}" for column in range(columns)) + "\n")
+        for _ in range(rows):
+            table.write(",".join(str(rng.randrange(domain)) for domain in domains) + "\n")
+    return path
+
+
 def check_metric_verifier_failure(dataset, options) -> bool:
     alg = desb.mfd_verification.algorithms.MetricVerifier()
     alg.load_data(table=(dataset, ",", True))
@@ -44,6 +61,7 @@ ALGO_CORRECT_OPTIONS_INFO = [
         get_common_option_container(
             {
                 "threads": 15,
+                "mem_limit": 64,
             }
         ),
     ]),
@@ -66,6 +84,16 @@ ALGO_CORRECT_OPTIONS_INFO = [
         get_common_option_container(
             {"lhs_indices": [1, 2, 3], "rhs_indices": [1, 2, 3]}
         ),
+        OptionContainer(
+            "WDC_satellites.csv",
+            {"load_columns": [1, 2, 3]},
+            {"lhs_indices": [1, 2], "rhs_indices": [3]},
+        ),
+    ]),
+    (desb.fd_verification.algorithms.BatchVerifier, [
+        get_common_option_container(
+            {"fds": [([1, 2], [3]), ([1], [2, 3])], "uccs": [[0, 1]], "max_highlights": 3}
+        ),
     ]),
     (desb.ar.algorithms.Apriori, [
         get_apriori_load_container({"input_format": "tabular", "has_tid": True}),
@@ -83,6 +111,12 @@ ALGO_CORRECT_OPTIONS_INFO = [
             {"minconf": 0.00312, "minsup": 0.2321},
         ),
     ]),
+    (desb.ar.algorithms.Eclat, [
+        get_apriori_load_container({"input_format": "tabular", "has_tid": True}),
+        get_apriori_load_container(
+            {"input_format": "singular", "tid_column_index": 0, "item_column_index": 2}
+        ),
+    ]),
     (desb.mfd_verification.algorithms.MetricVerifier, [
         OptionContainer(
             "TestLong.csv",
@@ -190,6 +224,82 @@ class TestPythonBindings(unittest.TestCase):
                         algo, option.path, ",", True, option
                     )
 
+    def test_shared_dataset(self):
+        dataset = desb.data_types.Dataset("WDC_satellites.csv", ",", True)
+        for algo in (desb.fd.algorithms.HyFD, desb.ucc.algorithms.HyUCC,
+                     desb.afd.algorithms.Tane):
+            with self.subTest(msg=f"loading shared dataset into {algo.__name__}"):
+                testing_algo = algo()
+                testing_algo.load_data(table=dataset)
+                testing_algo.execute()
+        self.assertEqual(dataset.materialized_count, 1)
+
+    def test_cancel(self):
+        testing_algo = desb.fd.algorithms.HyFD()
+        testing_algo.load_data(table=("WDC_satellites.csv", ",", True))
+        testing_algo.execute()
+        full_fds = set(testing_algo.get_fds())
+        self.assertIsNone(testing_algo.get_stop_reason())
+
+        testing_algo.cancel()
+        testing_algo.execute()
+        self.assertEqual(testing_algo.get_stop_reason(), "cancelled")
+        self.assertTrue(set(testing_algo.get_fds()) <= full_fds)
+
+        testing_algo.execute()
+        self.assertIsNone(testing_algo.get_stop_reason())
+        self.assertEqual(set(testing_algo.get_fds()), full_fds)
+
+    def test_cancel_from_another_thread(self):
+        with tempfile.TemporaryDirectory() as tmp_dir:
+            table = (write_random_table(tmp_dir, rows=20000, columns=12), ",", True)
+            full_algo = desb.fd.algorithms.Tane()
+            full_algo.load_data(table=table)
+            start = time.monotonic()
+            full_algo.execute()
+            full_time = time.monotonic() - start
+            full_fds = set(full_algo.get_fds())
+
+            testing_algo = desb.fd.algorithms.Tane()
+            testing_algo.load_data(table=table)
+            started = threading.Event()
+
+            # The cancel comes well after the check at the start of execute, so only a safe
+            # point in the middle of the run can stop it
+            def cancel_after_start():
+                started.wait()
+                time.sleep(full_time / 10)
+                testing_algo.cancel()
+
+            canceller = threading.Thread(target=cancel_after_start)
+            canceller.start()
+            started.set()
+            try:
+                testing_algo.execute()
+            finally:
+                canceller.join()
+        self.assertEqual(testing_algo.get_stop_reason(), "cancelled")
+        self.assertTrue(set(testing_algo.get_fds()) <= full_fds)
+
+    def test_batch_verifier(self):
+        fds = [([0], [1]), ([1, 2], [3]), ([1, 2], [4]), ([2], [0, 1])]
+        batch_verifier = desb.fd_verification.algorithms.BatchVerifier()
+        batch_verifier.load_data(table=("WDC_satellites.csv", ",", True))
+        batch_verifier.execute(fds=fds, uccs=[[0], [1, 2]], threads=2)
+        fd_results = batch_verifier.get_fd_results()
+        self.assertEqual(len(fd_results), len(fds))
+        self.assertEqual(len(batch_verifier.get_ucc_results()), 2)
+
+        for (lhs, rhs), result in zip(fds, fd_results):
+            with self.subTest(msg=f"batch verifying {lhs} -> {rhs}"):
+                verifier = desb.fd_verification.algorithms.FDVerifier()
+                verifier.load_data(table=("WDC_satellites.csv", ",", True))
+                verifier.execute(lhs_indices=lhs, rhs_indices=rhs)
+                self.assertEqual(result.holds, verifier.fd_holds())
+                self.assertEqual(result.num_error_clusters, verifier.get_num_error_clusters())
+                self.assertEqual(result.num_error_rows, verifier.get_num_error_rows())
+                self.assertAlmostEqual(result.error, verifier.get_error())
+
     def test_metric_verifier_failure_cases(self):
         for load in METRIC_VERIFIER_FAILURE_CASES:
             with self.subTest(msg=f"metric_verifier_load: {load}"):
@@ -1,5 +1,7 @@
 #pragma once
 
+#include <string>
+
 #include <magic_enum/magic_enum.hpp>
 
 #include "core/algorithms/fd/aidfd/aid.h"
@@ -36,6 +38,18 @@ inline void FDBenchmark(BenchmarkRunner& runner, BenchmarkComparer& comparer) {
             "");
     comparer.SetThreshold(pyro_name, 22);
 
+    // iowa550k has fewer than 32 columns: with 32 and 64 threads Pyro splits the search spaces
+    for (config::ThreadNumType threads : {8, 16, 32, 64}) {
+        auto parallel_pyro_name = runner.RegisterSimpleBenchmark<algos::Pyro>(
+                tests::kIowa550k,
+                {{kError, static_cast<config::ErrorType>(0.0)},
+                 {kSeed, static_cast<decltype(algos::pyro::Parameters::seed)>(0)},
+                 {kMaximumLhs, static_cast<config::MaxLhsType>(2)},
+                 {kThreads, threads}},
+                std::to_string(threads) + " threads");
+        comparer.SetThreshold(parallel_pyro_name, 22);
+    }
+
     for (auto measure : magic_enum::enum_values<algos::AfdErrorMeasure>()) {
         // mu_plus is much slower than other measures
         auto dataset = measure == algos::AfdErrorMeasure::kMuPlus ? tests::kMushroomPlus2attr1500
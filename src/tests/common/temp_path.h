@@ -0,0 +1,25 @@
+#pragma once
+
+#include <filesystem>
+#include <string>
+
+#include <gtest/gtest.h>
+#include <unistd.h>
+
+namespace tests {
+
+/// path in the temporary directory that is unique to the running test and process, so test
+/// cases run in parallel by ctest do not share files
+inline std::filesystem::path MakeTempPath(std::string const& suffix) {
+    ::testing::TestInfo const* info = ::testing::UnitTest::GetInstance()->current_test_info();
+    std::string name = "desbordante_" + std::to_string(::getpid());
+    if (info != nullptr) {
+        name += '_' + std::string(info->test_suite_name()) + '_' + info->name();
+    }
+    for (char& c : name) {
+        if (c == '/') c = '_';
+    }
+    return std::filesystem::temp_directory_path() / (name + suffix);
+}
+
+}  // namespace tests
@@ -203,4 +203,33 @@ TEST_F(ACAlgorithmTest, RangesReconstruction) {
 
     AssertRanges(expected_ranges, ranges_collection);
 }
+
+TEST_F(ACAlgorithmTest, SameInParallel) {
+    auto run = [](config::ThreadNumType threads) {
+        algos::StdParamsMap params =
+                GetParamMap(kIris, algos::Binop::kDivision, 0.2, 0.9, 0.05, 0, 10, 7);
+        params.emplace(config::names::kThreads, threads);
+        auto a = algos::CreateAndLoadAlgorithm<algos::ACAlgorithm>(params);
+        a->Execute();
+        a->CollectACExceptions();
+        return a;
+    };
+    auto serial = run(1);
+    auto parallel = run(4);
+
+    auto const& serial_ranges = serial->GetRangesCollections();
+    auto const& parallel_ranges = parallel->GetRangesCollections();
+    ASSERT_EQ(serial_ranges.size(), parallel_ranges.size());
+    for (size_t i = 0; i < serial_ranges.size(); ++i) {
+        EXPECT_EQ(serial_ranges[i].col_pair.col_i, parallel_ranges[i].col_pair.col_i);
+        std::vector<model::Double> expected_ranges;
+        for (std::byte const* border : serial_ranges[i].ranges) {
+            expected_ranges.push_back(model::Type::GetValue<model::Double>(border));
+        }
+        AssertRanges(expected_ranges, parallel_ranges[i]);
+    }
+
+    ACExceptions expected = serial->GetACExceptions();
+    AssertACExceptions(expected, parallel->GetACExceptions());
+}
 }  // namespace tests
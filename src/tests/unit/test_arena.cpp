@@ -0,0 +1,74 @@
+#include <cstddef>
+#include <list>
+#include <memory_resource>
+#include <vector>
+
+#include <gtest/gtest.h>
+
+#include "core/util/arena.h"
+#include "core/util/cancellation_token.h"
+
+namespace tests {
+
+TEST(Arena, CountsBytesAndPeak) {
+    util::Arena arena;
+    {
+        std::pmr::vector<int> values(1 << 20, 0, arena.GetPool());
+        EXPECT_GE(arena.GetBytes(), (1 << 20) * sizeof(int));
+    }
+    EXPECT_GE(arena.GetPeakBytes(), (1 << 20) * sizeof(int));
+
+    arena.Release();
+    EXPECT_EQ(arena.GetBytes(), 0u);
+    EXPECT_EQ(arena.GetPeakBytes(), 0u);
+}
+
+TEST(Arena, ReleaseDropsAbandonedMemory) {
+    util::Arena arena;
+    for (std::pmr::memory_resource* resource : {arena.GetPool(), arena.GetMonotonic()}) {
+        for (int i = 0; i < 1000; ++i) {
+            // Never deallocated, like the nodes of a structure that is not destroyed
+            [[maybe_unused]] void* node = resource->allocate(48);
+        }
+    }
+    EXPECT_GT(arena.GetBytes(), 0u);
+
+    arena.Release();
+    EXPECT_EQ(arena.GetBytes(), 0u);
+
+    std::pmr::list<int> reused({1, 2, 3}, arena.GetMonotonic());
+    EXPECT_EQ(reused.size(), 3u);
+}
+
+TEST(Arena, BytesCountAgainstMemoryBudget) {
+    util::Arena arena;
+    util::CancellationToken token;
+    token.TrackArena(&arena);
+    token.SetMemoryBudget(std::size_t{1} << 24);
+    token.Start();
+    EXPECT_FALSE(token.IsStopRequested());
+
+    std::pmr::vector<char> values(std::size_t{1} << 25, 0, arena.GetMonotonic());
+    EXPECT_TRUE(token.IsStopRequested());
+    EXPECT_EQ(token.GetStopReason(), util::StopReason::kMemoryLimit);
+}
+
+TEST(Arena, MemoryBudgetTakesEffectOnStart) {
+    util::Arena arena;
+    util::CancellationToken token;
+    token.TrackArena(&arena);
+    token.SetMemoryBudget(std::size_t{1} << 24);
+    token.Start();
+    token.SetMemoryBudget(std::size_t{1} << 30);
+    // Not written, so only the arena sees it
+    [[maybe_unused]] void* block = arena.GetMonotonic()->allocate(std::size_t{1} << 25);
+    EXPECT_TRUE(token.IsStopRequested());
+
+    arena.Release();
+    token.Start();
+    token.SetMemoryBudget(1);
+    [[maybe_unused]] void* small_block = arena.GetMonotonic()->allocate(1 << 10);
+    EXPECT_FALSE(token.IsStopRequested());
+}
+
+}  // namespace tests
@@ -1,6 +1,9 @@
 
 // see input_data/cfd_data/LICENSE
 
+#include <string>
+#include <vector>
+
 #include <gtest/gtest.h>
 #include <magic_enum/magic_enum.hpp>
 
@@ -8,6 +11,7 @@
 #include "core/algorithms/cfd/enums.h"
 #include "core/algorithms/cfd/fd_first_algorithm.h"
 #include "core/config/names.h"
+#include "core/config/thread_number/type.h"
 #include "tests/common/all_csv_configs.h"
 
 namespace tests {
@@ -29,7 +33,9 @@ class CFDAlgorithmTest : public ::testing::Test {
 protected:
     static std::unique_ptr<algos::cfd::FDFirstAlgorithm> CreateAlgorithmInstance(
             CSVConfig const& csv_config, unsigned minsup, double minconf, char const* substrategy,
-            unsigned int max_lhs, unsigned columns_number = 0, unsigned tuples_number = 0) {
+            unsigned int max_lhs, unsigned columns_number = 0, unsigned tuples_number = 0,
+            algos::cfd::TIdListType tidlist_type = algos::cfd::TIdListType::kVector,
+            config::ThreadNumType threads = 1) {
         using namespace config::names;
 
         algos::StdParamsMap params{
@@ -40,9 +46,43 @@ protected:
                 {kCfdSubstrategy,
                  magic_enum::enum_cast<algos::cfd::Substrategy>(substrategy).value()},
                 {kCfdTuplesNumber, tuples_number},
-                {kCfdColumnsNumber, columns_number}};
+                {kCfdColumnsNumber, columns_number},
+                {kCfdTIdListType, tidlist_type},
+                {kThreads, threads}};
         return algos::CreateAndLoadAlgorithm<algos::cfd::FDFirstAlgorithm>(params);
     }
+
+    static std::vector<std::string> GetCfdStrings(algos::cfd::FDFirstAlgorithm const& algorithm) {
+        std::vector<std::string> cfds;
+        for (auto const& cfd : algorithm.GetItemsetCfds()) {
+            cfds.push_back(algorithm.GetCfdString(cfd));
+        }
+        return cfds;
+    }
+
+    /* Bitmap tid-lists and parallel mining must give the same rules, in the same order, as
+     * the default sequential run on vectors */
+    static void CheckSameAsDefault(CSVConfig const& csv_config, unsigned minsup, double minconf,
+                                   unsigned int max_lhs, unsigned columns_number = 0,
+                                   unsigned tuples_number = 0) {
+        using algos::cfd::TIdListType;
+        auto algorithm = CreateAlgorithmInstance(csv_config, minsup, minconf, "kDfs", max_lhs,
+                                                 columns_number, tuples_number);
+        algorithm->Execute();
+        std::vector<std::string> const expected = GetCfdStrings(*algorithm);
+        ASSERT_FALSE(expected.empty());
+        for (TIdListType tidlist_type : {TIdListType::kVector, TIdListType::kBitmap}) {
+            for (config::ThreadNumType threads : {1, 4}) {
+                algorithm = CreateAlgorithmInstance(csv_config, minsup, minconf, "kDfs", max_lhs,
+                                                    columns_number, tuples_number, tidlist_type,
+                                                    threads);
+                algorithm->Execute();
+                EXPECT_EQ(GetCfdStrings(*algorithm), expected)
+                        << "tidlist type " << magic_enum::enum_name(tidlist_type) << ", "
+                        << threads << " threads";
+            }
+        }
+    }
 };
 
 TEST_F(CFDAlgorithmTest, CfdRelationDataStringFormatTest) {
@@ -120,4 +160,16 @@ TEST_F(CFDAlgorithmTest, PartialMushroomDataset) {
 
     CheckCfdSetsEquality(actual_cfds, expected_cfds);
 }
+
+TEST_F(CFDAlgorithmTest, TennisTIdListTypesAndThreads) {
+    CheckSameAsDefault(kTennis, 8, 0.85, 3);
+}
+
+TEST_F(CFDAlgorithmTest, MushroomTIdListTypesAndThreads) {
+    CheckSameAsDefault(kMushroom, 4, 0.9, 4, 4, 50);
+}
+
+TEST_F(CFDAlgorithmTest, FullMushroomTIdListTypesAndThreads) {
+    CheckSameAsDefault(kMushroom, 800, 0.9, 3, 8);
+}
 }  // namespace tests
@@ -1,3 +1,4 @@
+#include <algorithm>
 #include <iostream>
 #include <string>
 #include <vector>
@@ -6,6 +7,7 @@
 
 #include "core/algorithms/algo_factory.h"
 #include "core/algorithms/cfd/cfd_verifier/cfd_verifier.h"
+#include "core/config/indices/type.h"
 #include "core/config/names_and_descriptions.h"
 #include "tests/common/all_csv_configs.h"
 
@@ -38,6 +40,42 @@ TEST_P(CFDVerifierTest, Test) {
     EXPECT_EQ(verifier->CFDHolds(), p.expect_holds);
 }
 
+TEST_P(CFDVerifierTest, LoadColumnsMatchesFullLoad) {
+    using algos::cfd_verifier::CFDAttributeValuePair;
+    namespace onam = config::names;
+
+    algos::StdParamsMap params = GetParam().params;
+    auto verifier = algos::CreateAndLoadAlgorithm<algos::cfd_verifier::CFDVerifier>(params);
+    verifier->Execute();
+
+    std::vector<std::string> const columns = {"outlook", "temp", "humidity", "windy", "play"};
+    auto rule_columns =
+            boost::any_cast<std::vector<CFDAttributeValuePair>>(params.at(onam::kCFDRuleLeft));
+    rule_columns.push_back(boost::any_cast<CFDAttributeValuePair>(params.at(onam::kCFDRuleRight)));
+    config::IndicesType load_columns;
+    for (auto const& [attr_name, _] : rule_columns) {
+        load_columns.push_back(std::ranges::find(columns, attr_name) - columns.begin());
+    }
+    params.emplace(onam::kLoadColumns, load_columns);
+    auto projected_verifier =
+            algos::CreateAndLoadAlgorithm<algos::cfd_verifier::CFDVerifier>(params);
+    projected_verifier->Execute();
+
+    EXPECT_EQ(projected_verifier->CFDHolds(), verifier->CFDHolds());
+    EXPECT_EQ(projected_verifier->GetRealSupport(), verifier->GetRealSupport());
+    EXPECT_DOUBLE_EQ(projected_verifier->GetRealConfidence(), verifier->GetRealConfidence());
+    EXPECT_EQ(projected_verifier->GetNumRowsViolatingCFD(), verifier->GetNumRowsViolatingCFD());
+    EXPECT_EQ(projected_verifier->GetNumClustersViolatingCFD(),
+              verifier->GetNumClustersViolatingCFD());
+    auto const& highlights = verifier->GetHighlights();
+    auto const& projected_highlights = projected_verifier->GetHighlights();
+    ASSERT_EQ(projected_highlights.size(), highlights.size());
+    for (size_t i = 0; i < highlights.size(); ++i) {
+        EXPECT_EQ(projected_highlights[i].GetCluster(), highlights[i].GetCluster());
+        EXPECT_EQ(projected_highlights[i].GetViolatingRows(), highlights[i].GetViolatingRows());
+    }
+}
+
 INSTANTIATE_TEST_SUITE_P(
         CFDVerifierAdditionalTests, CFDVerifierTest,
         ::testing::Values(
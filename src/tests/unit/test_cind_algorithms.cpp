@@ -1,3 +1,6 @@
+#include <string>
+#include <vector>
+
 #include <gtest/gtest.h>
 
 #include "core/algorithms/algo_factory.h"
@@ -5,6 +8,7 @@
 #include "core/algorithms/cind/types.h"
 #include "core/config/error/type.h"
 #include "core/config/names.h"
+#include "core/config/thread_number/type.h"
 #include "tests/common/all_csv_configs.h"
 #include "tests/common/csv_config_util.h"
 
@@ -83,26 +87,55 @@ TEST_P(TestCINDConditions, SimpleTest) {
 // clang-format off
 INSTANTIATE_TEST_SUITE_P(
     CINDTestSuite, TestCINDConditions, ::testing::Values(
-        CINDConditionsParams(algos::cind::AlgoType::cinderella, algos::cind::CondType::row, 0.0, 0.01, 61),
-        CINDConditionsParams(algos::cind::AlgoType::cinderella, algos::cind::CondType::row, 0.0, 0.15, 23),
-        CINDConditionsParams(algos::cind::AlgoType::cinderella, algos::cind::CondType::row, 0.0, 0.56, 3),
-        CINDConditionsParams(algos::cind::AlgoType::cinderella, algos::cind::CondType::row, 1.0, 0.01, 56),
-        CINDConditionsParams(algos::cind::AlgoType::cinderella, algos::cind::CondType::row, 1.0, 0.15, 18),
-        CINDConditionsParams(algos::cind::AlgoType::cinderella, algos::cind::CondType::row, 1.0, 0.56, 2),
-        CINDConditionsParams(algos::cind::AlgoType::pli_cind, algos::cind::CondType::row, 0.0, 0.01, 61),
-        CINDConditionsParams(algos::cind::AlgoType::pli_cind, algos::cind::CondType::row, 0.0, 0.15, 23),
-        CINDConditionsParams(algos::cind::AlgoType::pli_cind, algos::cind::CondType::row, 0.0, 0.56, 3),
-        CINDConditionsParams(algos::cind::AlgoType::pli_cind, algos::cind::CondType::row, 1.0, 0.01, 56),
-        CINDConditionsParams(algos::cind::AlgoType::pli_cind, algos::cind::CondType::row, 1.0, 0.15, 18),
-        CINDConditionsParams(algos::cind::AlgoType::pli_cind, algos::cind::CondType::row, 1.0, 0.56, 2),
-        CINDConditionsParams(algos::cind::AlgoType::cinderella, algos::cind::CondType::group, 0.1, 0.4, 61),
-        CINDConditionsParams(algos::cind::AlgoType::cinderella, algos::cind::CondType::group, 0.1, 0.6, 1),
-        CINDConditionsParams(algos::cind::AlgoType::cinderella, algos::cind::CondType::group, 0.75, 0.4, 56),
-        CINDConditionsParams(algos::cind::AlgoType::cinderella, algos::cind::CondType::group, 0.75, 0.6, 0),
-        CINDConditionsParams(algos::cind::AlgoType::pli_cind, algos::cind::CondType::group, 0.1, 0.4, 61),
-        CINDConditionsParams(algos::cind::AlgoType::pli_cind, algos::cind::CondType::group, 0.1, 0.6, 1),
-        CINDConditionsParams(algos::cind::AlgoType::pli_cind, algos::cind::CondType::group, 0.75, 0.4, 56),
-        CINDConditionsParams(algos::cind::AlgoType::pli_cind, algos::cind::CondType::group, 0.75, 0.6, 0)
+        CINDConditionsParams(algos::cind::AlgoType::kCinderella, algos::cind::CondType::kRow, 0.0, 0.01, 61),
+        CINDConditionsParams(algos::cind::AlgoType::kCinderella, algos::cind::CondType::kRow, 0.0, 0.15, 23),
+        CINDConditionsParams(algos::cind::AlgoType::kCinderella, algos::cind::CondType::kRow, 0.0, 0.56, 3),
+        CINDConditionsParams(algos::cind::AlgoType::kCinderella, algos::cind::CondType::kRow, 1.0, 0.01, 56),
+        CINDConditionsParams(algos::cind::AlgoType::kCinderella, algos::cind::CondType::kRow, 1.0, 0.15, 18),
+        CINDConditionsParams(algos::cind::AlgoType::kCinderella, algos::cind::CondType::kRow, 1.0, 0.56, 2),
+        CINDConditionsParams(algos::cind::AlgoType::kPliCind, algos::cind::CondType::kRow, 0.0, 0.01, 61),
+        CINDConditionsParams(algos::cind::AlgoType::kPliCind, algos::cind::CondType::kRow, 0.0, 0.15, 23),
+        CINDConditionsParams(algos::cind::AlgoType::kPliCind, algos::cind::CondType::kRow, 0.0, 0.56, 3),
+        CINDConditionsParams(algos::cind::AlgoType::kPliCind, algos::cind::CondType::kRow, 1.0, 0.01, 56),
+        CINDConditionsParams(algos::cind::AlgoType::kPliCind, algos::cind::CondType::kRow, 1.0, 0.15, 18),
+        CINDConditionsParams(algos::cind::AlgoType::kPliCind, algos::cind::CondType::kRow, 1.0, 0.56, 2),
+        CINDConditionsParams(algos::cind::AlgoType::kCinderella, algos::cind::CondType::kGroup, 0.1, 0.4, 61),
+        CINDConditionsParams(algos::cind::AlgoType::kCinderella, algos::cind::CondType::kGroup, 0.1, 0.6, 1),
+        CINDConditionsParams(algos::cind::AlgoType::kCinderella, algos::cind::CondType::kGroup, 0.75, 0.4, 56),
+        CINDConditionsParams(algos::cind::AlgoType::kCinderella, algos::cind::CondType::kGroup, 0.75, 0.6, 0),
+        CINDConditionsParams(algos::cind::AlgoType::kPliCind, algos::cind::CondType::kGroup, 0.1, 0.4, 61),
+        CINDConditionsParams(algos::cind::AlgoType::kPliCind, algos::cind::CondType::kGroup, 0.1, 0.6, 1),
+        CINDConditionsParams(algos::cind::AlgoType::kPliCind, algos::cind::CondType::kGroup, 0.75, 0.4, 56),
+        CINDConditionsParams(algos::cind::AlgoType::kPliCind, algos::cind::CondType::kGroup, 0.75, 0.6, 0)
+    ));
+// clang-format on
+
+class TestCINDThreads : public ::testing::TestWithParam<CINDConditionsParams> {};
+
+TEST_P(TestCINDThreads, SameAsSingleThread) {
+    auto mine = [](algos::StdParamsMap params, config::ThreadNumType threads) {
+        params.emplace(config::names::kThreads, threads);
+        auto cind_algo = algos::CreateAndLoadAlgorithm<algos::cind::CindAlgorithm>(params);
+        cind_algo->Execute();
+        std::vector<std::string> cinds;
+        for (auto const& cind : cind_algo->CINDList()) {
+            cinds.push_back(cind.ToString());
+        }
+        return cinds;
+    };
+    auto const& p = GetParam();
+    std::vector<std::string> const expected = mine(p.params, 1);
+    ASSERT_FALSE(expected.empty());
+    ASSERT_EQ(mine(p.params, 4), expected);
+}
+
+// clang-format off
+INSTANTIATE_TEST_SUITE_P(
+    CINDTestSuite, TestCINDThreads, ::testing::Values(
+        CINDConditionsParams(algos::cind::AlgoType::kCinderella, algos::cind::CondType::kRow, 0.0, 0.01, 61),
+        CINDConditionsParams(algos::cind::AlgoType::kPliCind, algos::cind::CondType::kRow, 0.0, 0.01, 61),
+        CINDConditionsParams(algos::cind::AlgoType::kCinderella, algos::cind::CondType::kGroup, 0.1, 0.4, 61),
+        CINDConditionsParams(algos::cind::AlgoType::kPliCind, algos::cind::CondType::kGroup, 0.1, 0.4, 61)
     ));
 // clang-format on
 
@@ -1,7 +1,11 @@
+#include <vector>
+
 #include <gmock/gmock.h>
 
 #include "core/algorithms/algo_factory.h"
 #include "core/algorithms/statistics/data_stats.h"
+#include "core/config/exceptions.h"
+#include "core/config/indices/type.h"
 #include "core/config/names.h"
 #include "core/util/logger.h"
 #include "tests/common/all_csv_configs.h"
@@ -956,4 +960,32 @@ TEST(TestDataStats, TestGetNumberOfDiacriticChars) {
     EXPECT_GE(value, 6);
 }
 
+TEST(TestDataStats, LoadColumnsMatchesFullLoad) {
+    using namespace config::names;
+    auto full_stats = MakeStatAlgorithm(kTestDataStats);
+    full_stats->Execute();
+
+    std::vector<size_t> const load_columns = {2, 5, 7, 9, 11};
+    algos::StdParamsMap params = GetParamMap(kTestDataStats);
+    params.emplace(kLoadColumns, config::IndicesType{11, 2, 9, 5, 7});
+    auto projected_stats = algos::CreateAndLoadAlgorithm<algos::DataStats>(params);
+    projected_stats->Execute();
+
+    ASSERT_EQ(projected_stats->GetNumberOfColumns(), load_columns.size());
+    ASSERT_EQ(projected_stats->GetLoadedColumns(), load_columns);
+    for (size_t i = 0; i < load_columns.size(); ++i) {
+        EXPECT_EQ(projected_stats->GetAllStats(i).ToKeyValueMap(),
+                  full_stats->GetAllStats(load_columns[i]).ToKeyValueMap())
+                << "column " << load_columns[i];
+    }
+}
+
+TEST(TestDataStats, EmptyLoadColumnsIsAnError) {
+    // Not setting load_columns loads every column, an empty list would load none
+    algos::StdParamsMap params = GetParamMap(kTestDataStats);
+    params.emplace(config::names::kLoadColumns, config::IndicesType{});
+    EXPECT_THROW(algos::CreateAndLoadAlgorithm<algos::DataStats>(params),
+                 config::ConfigurationError);
+}
+
 };  // namespace tests
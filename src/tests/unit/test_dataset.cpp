@@ -0,0 +1,52 @@
+#include <memory>
+
+#include <gtest/gtest.h>
+
+#include "core/model/table/dataset.h"
+#include "tests/common/all_csv_configs.h"
+#include "tests/common/csv_config_util.h"
+
+namespace tests {
+
+namespace mo = model;
+
+TEST(Dataset, RepresentationsAreBuiltOnce) {
+    auto dataset = std::make_shared<mo::Dataset>(MakeInputTable(kWdcSatellites));
+
+    std::shared_ptr<ColumnLayoutRelationData const> relation = mo::LoadRelation(*dataset);
+    EXPECT_EQ(mo::LoadRelation(*dataset), relation);
+    EXPECT_EQ(dataset->GetNumRepresentations(), 1);
+
+    auto typed = mo::LoadTypedRelation(*dataset, true);
+    EXPECT_EQ(mo::LoadTypedRelation(*dataset, true), typed);
+    EXPECT_NE(mo::LoadTypedRelation(*dataset, false), typed);
+    EXPECT_EQ(dataset->GetNumRepresentations(), 3);
+
+    EXPECT_EQ(relation->GetNumRows(), typed->GetNumRows());
+    EXPECT_EQ(relation->GetNumColumns(), dataset->GetNumberOfColumns());
+}
+
+TEST(Dataset, RowsStayReadable) {
+    auto dataset = std::make_shared<mo::Dataset>(MakeInputTable(kWdcSatellites));
+    auto relation = mo::LoadRelation(*dataset);
+
+    size_t num_rows = 0;
+    while (dataset->HasNextRow()) {
+        dataset->GetNextRow();
+        ++num_rows;
+    }
+    EXPECT_EQ(num_rows, relation->GetNumRows());
+
+    dataset->ReleaseRepresentations();
+    EXPECT_EQ(dataset->GetNumRepresentations(), 0);
+    EXPECT_NE(mo::LoadRelation(*dataset), relation);
+}
+
+TEST(Dataset, PlainStreamIsNotCached) {
+    auto table = MakeInputTable(kWdcSatellites);
+    auto first = mo::LoadRelation(*table);
+    table->Reset();
+    EXPECT_NE(mo::LoadRelation(*table), first);
+}
+
+}  // namespace tests
@@ -1,11 +1,13 @@
 #include <memory>
 #include <string>
+#include <vector>
 
 #include <gmock/gmock.h>
 #include <gtest/gtest.h>
 
 #include "core/algorithms/algo_factory.h"
 #include "core/algorithms/dc/verifier/dc_verifier.h"
+#include "core/config/indices/type.h"
 #include "core/config/names_and_descriptions.h"
 #include "tests/common/all_csv_configs.h"
 
@@ -17,11 +19,13 @@ using namespace algos::dc;
 namespace mo = model;
 
 static algos::StdParamsMap GetParamMap(CSVConfig const& csv_config, std::string dc,
-                                       bool do_collect_violations) {
+                                       bool do_collect_violations,
+                                       config::ThreadNumType threads = 1) {
     using namespace config::names;
     return {{kCsvConfig, csv_config},
             {kDenialConstraint, dc},
-            {kDoCollectViolations, do_collect_violations}};
+            {kDoCollectViolations, do_collect_violations},
+            {kThreads, threads}};
 }
 
 struct DCTestParams {
@@ -45,6 +49,79 @@ TEST_P(TestDCVerifier, DefaultTest) {
     EXPECT_EQ(verifier->DCHolds(), p.dc_holds_);
 }
 
+TEST_P(TestDCVerifier, SameInParallel) {
+    DCTestParams const& p = GetParam();
+    algos::StdParamsMap params =
+            GetParamMap(p.csv_config, p.dc_string, p.do_collect_violations_, 4);
+    std::unique_ptr<DCVerifier> verifier = algos::CreateAndLoadAlgorithm<DCVerifier>(params);
+    verifier->Execute();
+
+    EXPECT_EQ(verifier->GetViolations(), p.violations);
+    EXPECT_EQ(verifier->DCHolds(), p.dc_holds_);
+}
+
+// The table has several times more rows than the verifier hands to a thread at once, so that
+// the blocks are spread over the threads and their violations are merged
+TEST(DCVerifierParallelTest, SameInParallelOnManyRows) {
+    std::vector<std::string> const dcs = {
+            "!(s.Aadt > 10000)",
+            "!(s.HwySys == t.HwySys and s.StHwy1 == t.StHwy1)",
+            "!(s.HwySys == t.HwySys and s.HwyClassrdtpID == t.HwyClassrdtpID and s.Aadt < t.Aadt)",
+            "!(s.HwyClassCD == t.HwyClassCD and s.Aadt < t.Aadt and s.PctTruk > t.PctTruk)",
+            "!(s.HwySys == t.HwySys and s.Aadt < t.Aadt and s.PctTruk > 5)"};
+    for (std::string const& dc : dcs) {
+        for (bool do_collect_violations : {true, false}) {
+            SCOPED_TRACE(dc);
+            auto sequential_verifier = algos::CreateAndLoadAlgorithm<DCVerifier>(
+                    GetParamMap(kCIPublicHighway700, dc, do_collect_violations, 1));
+            sequential_verifier->Execute();
+            auto parallel_verifier = algos::CreateAndLoadAlgorithm<DCVerifier>(
+                    GetParamMap(kCIPublicHighway700, dc, do_collect_violations, 4));
+            parallel_verifier->Execute();
+
+            EXPECT_EQ(parallel_verifier->DCHolds(), sequential_verifier->DCHolds());
+            EXPECT_EQ(parallel_verifier->GetViolations(), sequential_verifier->GetViolations());
+        }
+    }
+}
+
+TEST(DCVerifierTest, LoadColumnsMatchesFullLoad) {
+    // Columns given by index keep the numbering of the whole table
+    std::vector<std::string> const dcs = {
+            "!(s.HwySys == t.HwySys and s.StHwy1 == t.StHwy1)",
+            "!(s.HwySys == t.HwySys and s.HwyClassrdtpID == t.HwyClassrdtpID and s.Aadt < t.Aadt)",
+            "!(s.HwyClassCD == t.HwyClassCD and s.Aadt < t.Aadt and s.PctTruk > t.PctTruk)",
+            "!(s.3 == t.3 and s.11 < t.11 and s.PctTruk > 5)",
+            "!(s.13 > 10)"};
+    config::IndicesType const load_columns = {3, 4, 5, 6, 11, 13};
+    for (std::string const& dc : dcs) {
+        SCOPED_TRACE(dc);
+        algos::StdParamsMap params = GetParamMap(kCIPublicHighway700, dc, true);
+        auto verifier = algos::CreateAndLoadAlgorithm<DCVerifier>(params);
+        verifier->Execute();
+        params.emplace(config::names::kLoadColumns, load_columns);
+        auto projected_verifier = algos::CreateAndLoadAlgorithm<DCVerifier>(params);
+        projected_verifier->Execute();
+
+        EXPECT_EQ(projected_verifier->DCHolds(), verifier->DCHolds());
+        EXPECT_EQ(projected_verifier->GetViolations(), verifier->GetViolations());
+    }
+}
+
+TEST(DCVerifierTest, RepeatedPredicateIsNotSwappedPair) {
+    // t.Col2 > s.Col1 is s.Col1 < t.Col2 written the other way round, not its swapped pair
+    // s.Col2 > t.Col1, so both signs of s.Col0 != t.Col0 have to be checked
+    auto verifier = algos::CreateAndLoadAlgorithm<DCVerifier>(GetParamMap(
+            kTestDC, "!(s.Col1 < t.Col2 and t.Col2 > s.Col1 and s.Col0 != t.Col0)", true));
+    verifier->Execute();
+    auto expected_verifier = algos::CreateAndLoadAlgorithm<DCVerifier>(
+            GetParamMap(kTestDC, "!(s.Col1 < t.Col2 and s.Col0 != t.Col0)", true));
+    expected_verifier->Execute();
+
+    EXPECT_FALSE(expected_verifier->DCHolds());
+    EXPECT_EQ(verifier->GetViolations(), expected_verifier->GetViolations());
+}
+
 INSTANTIATE_TEST_SUITE_P(
         DCVerifierTestSuite, TestDCVerifier,
         ::testing::Values(
@@ -3,6 +3,7 @@
 #include "core/algorithms/algo_factory.h"
 #include "core/algorithms/nar/des/des.h"
 #include "core/config/names.h"
+#include "core/config/thread_number/type.h"
 #include "tests/common/all_csv_configs.h"
 
 namespace tests {
@@ -12,12 +13,14 @@ protected:
     static algos::StdParamsMap GetParamMap(CSVConfig const& csv_config, double minsup,
                                            double minconf, unsigned int popSize,
                                            unsigned int evalNum, double crossProb, double diffScale,
-                                           algos::des::DifferentialStrategy diffStrategy) {
+                                           algos::des::DifferentialStrategy diffStrategy,
+                                           config::ThreadNumType threads = 1) {
         using namespace config::names;
         return {{kCsvConfig, csv_config},          {kArMinimumSupport, minsup},
                 {kArMinimumConfidence, minconf},   {kPopulationSize, popSize},
                 {kMaxFitnessEvaluations, evalNum}, {kCrossoverProbability, crossProb},
-                {kDifferentialScale, diffScale},   {kDifferentialStrategy, diffStrategy}};
+                {kDifferentialScale, diffScale},   {kDifferentialStrategy, diffStrategy},
+                {kThreads, threads}};
     }
 
     template <typename... Args>
@@ -60,4 +63,15 @@ TEST_F(DESTest, LaunchTest2) {
     ASSERT_EQ(result, expected);
 }
 
+TEST_F(DESTest, ThreadsDoNotChangeResult) {
+    auto sequential = CreateAlgorithmInstance(kAbalone, 0.0, 0.0, 100u, 500u, 0.9, 0.5,
+                                              algos::des::DifferentialStrategy::kRand1Bin, 1);
+    auto parallel = CreateAlgorithmInstance(kAbalone, 0.0, 0.0, 100u, 500u, 0.9, 0.5,
+                                            algos::des::DifferentialStrategy::kRand1Bin, 4);
+    sequential->Execute();
+    parallel->Execute();
+    ASSERT_EQ(ExtractFitnessValues(parallel->GetNARVector()),
+              ExtractFitnessValues(sequential->GetNARVector()));
+}
+
 }  // namespace tests
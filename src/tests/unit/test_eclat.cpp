@@ -0,0 +1,99 @@
+#include <map>
+#include <memory>
+#include <set>
+#include <string>
+#include <utility>
+
+#include <gtest/gtest.h>
+
+#include "core/algorithms/algo_factory.h"
+#include "core/algorithms/ar/apriori/apriori.h"
+#include "core/algorithms/ar/eclat/eclat.h"
+#include "core/config/names.h"
+#include "core/config/thread_number/type.h"
+#include "core/model/transaction/input_format_type.h"
+#include "tests/common/all_csv_configs.h"
+
+namespace tests {
+
+namespace {
+
+using RuleKey = std::pair<std::set<std::string>, std::set<std::string>>;
+
+struct EclatParams {
+    CSVConfig const& csv_config;
+    double minsup;
+    double minconf;
+    model::InputFormatType input_format;
+};
+
+std::map<RuleKey, std::pair<double, double>> ToMap(std::list<model::ARStrings> const& rules) {
+    std::map<RuleKey, std::pair<double, double>> map;
+    for (auto const& rule : rules) {
+        map.emplace(RuleKey{{rule.left.begin(), rule.left.end()},
+                            {rule.right.begin(), rule.right.end()}},
+                    std::make_pair(rule.support, rule.confidence));
+    }
+    return map;
+}
+
+class EclatTest : public ::testing::TestWithParam<std::tuple<EclatParams, unsigned>> {
+protected:
+    static algos::StdParamsMap GetParamMap(EclatParams const& params) {
+        using namespace config::names;
+        algos::StdParamsMap map{{kCsvConfig, params.csv_config},
+                                {kInputFormat, params.input_format},
+                                {kArMinimumSupport, params.minsup},
+                                {kArMinimumConfidence, params.minconf}};
+        if (params.input_format == model::InputFormatType::kSingular) {
+            map.emplace(kTIdColumnIndex, 0u);
+            map.emplace(kItemColumnIndex, 1u);
+        } else {
+            map.emplace(kFirstColumnTId, true);
+        }
+        return map;
+    }
+};
+
+}  // namespace
+
+TEST_P(EclatTest, SameResultAsApriori) {
+    auto const& [params, threads] = GetParam();
+    algos::StdParamsMap param_map = GetParamMap(params);
+    auto apriori = algos::CreateAndLoadAlgorithm<algos::Apriori>(param_map);
+    apriori->Execute();
+
+    param_map.emplace(config::names::kThreads, static_cast<config::ThreadNumType>(threads));
+    auto eclat = algos::CreateAndLoadAlgorithm<algos::Eclat>(param_map);
+    eclat->Execute();
+
+    auto const expected_frequent = apriori->GetFrequentList();
+    auto const actual_frequent = eclat->GetFrequentList();
+    EXPECT_EQ(std::set(actual_frequent.begin(), actual_frequent.end()),
+              std::set(expected_frequent.begin(), expected_frequent.end()));
+    EXPECT_EQ(actual_frequent.size(), expected_frequent.size());
+
+    auto const expected_rules = ToMap(apriori->GetArStringsList());
+    auto const actual_rules = ToMap(eclat->GetArStringsList());
+    ASSERT_EQ(actual_rules.size(), expected_rules.size());
+    for (auto const& [rule, expected] : expected_rules) {
+        auto it = actual_rules.find(rule);
+        ASSERT_NE(it, actual_rules.end());
+        EXPECT_DOUBLE_EQ(it->second.first, expected.first);
+        EXPECT_DOUBLE_EQ(it->second.second, expected.second);
+    }
+}
+
+INSTANTIATE_TEST_SUITE_P(
+        EclatTestSuite, EclatTest,
+        ::testing::Combine(
+                ::testing::Values(
+                        EclatParams{kRulesBook, 0.2, 0.5, model::InputFormatType::kSingular},
+                        EclatParams{kRulesPresentation, 0.6, 0, model::InputFormatType::kSingular},
+                        EclatParams{kRulesSynthetic2, 0.13, 1, model::InputFormatType::kSingular},
+                        EclatParams{kRulesKaggleRows, 0.1, 0.5, model::InputFormatType::kTabular},
+                        EclatParams{kRulesKaggleRows, 0.01, 0.3,
+                                    model::InputFormatType::kTabular}),
+                ::testing::Values(1u, 4u)));
+
+}  // namespace tests
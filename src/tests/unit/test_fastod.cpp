@@ -6,7 +6,10 @@
 #include "core/algorithms/algo_factory.h"
 #include "core/algorithms/od/fastod/fastod.h"
 #include "core/algorithms/od/fastod/hashing/hashing.h"
+#include "core/algorithms/od/fastod/storage/cache_with_limit.h"
+#include "core/config/mem_limit/type.h"
 #include "core/config/names.h"
+#include "core/config/thread_number/type.h"
 #include "tests/common/all_csv_configs.h"
 #include "tests/common/csv_config_util.h"
 
@@ -44,6 +47,20 @@ class ExactFastodResultHashTest : public ::testing::TestWithParam<CSVConfigHash>
 
 class ApproximateFastodResultHashTest : public ::testing::TestWithParam<CSVConfigHash> {};
 
+/* Fastod that is cancelled once the ODs of its first level are computed, so that the run stops
+ * between levels rather than in the middle of one */
+class CancelledAfterFirstLevelFastod : public algos::Fastod {
+    bool is_cancelled_ = false;
+
+protected:
+    void OnLevelComputed() override {
+        if (!is_cancelled_) {
+            is_cancelled_ = true;
+            Cancel();
+        }
+    }
+};
+
 }  // namespace
 
 TEST_P(ExactFastodResultHashTest, CorrectnessTest) {
@@ -54,6 +71,18 @@ TEST_P(ExactFastodResultHashTest, CorrectnessTest) {
     EXPECT_EQ(actual_hash, csv_config_hash.hash);
 }
 
+/* The smallest allowed limit rarely makes the cache evict anything on these tables, eviction
+ * itself is covered by the CacheWithLimit tests below */
+TEST_P(ExactFastodResultHashTest, ParallelWithMemoryLimitTest) {
+    using namespace config::names;
+    CSVConfigHash csv_config_hash = GetParam();
+    algos::StdParamsMap params{{kCsvConfig, csv_config_hash.config},
+                               {kThreads, static_cast<config::ThreadNumType>(4)},
+                               {kMemLimitMB, static_cast<config::MemLimitMBType>(16)}};
+    size_t actual_hash = RunFastod(params);
+    EXPECT_EQ(actual_hash, csv_config_hash.hash);
+}
+
 TEST_P(ApproximateFastodResultHashTest, CorrectnessTest) {
     using namespace config::names;
     CSVConfigHash csv_config_hash = GetParam();
@@ -62,6 +91,58 @@ TEST_P(ApproximateFastodResultHashTest, CorrectnessTest) {
     EXPECT_EQ(actual_hash, csv_config_hash.hash);
 }
 
+TEST(FastodStopTest, StoppedBetweenLevelsIsIncomplete) {
+    using namespace config::names;
+    algos::StdParamsMap const params{{kCsvConfig, kOdTestNormAbalone}};
+    auto full_fastod = algos::CreateAndLoadAlgorithm<algos::Fastod>(params);
+    full_fastod->Execute();
+    ASSERT_TRUE(full_fastod->IsComplete());
+
+    auto fastod = algos::CreateAndLoadAlgorithm<CancelledAfterFirstLevelFastod>(params);
+    fastod->Execute();
+    EXPECT_EQ(fastod->GetStopReason(), util::StopReason::kCancelled);
+    EXPECT_FALSE(fastod->IsComplete());
+    size_t const full_count = full_fastod->GetAscendingDependencies().size() +
+                              full_fastod->GetDescendingDependencies().size() +
+                              full_fastod->GetSimpleDependencies().size();
+    size_t const count = fastod->GetAscendingDependencies().size() +
+                         fastod->GetDescendingDependencies().size() +
+                         fastod->GetSimpleDependencies().size();
+    EXPECT_LT(count, full_count);
+}
+
+TEST(CacheWithLimitTest, EvictsOneOffValuesFirst) {
+    algos::fastod::CacheWithLimit<int, int> cache(300);
+    cache.GetOrInsert(1, std::make_shared<int const>(1), 100);
+    cache.GetOrInsert(2, std::make_shared<int const>(2), 100);
+    /* 1 is reused, so it is protected, while the newer 2 is left on probation */
+    ASSERT_NE(cache.Find(1), nullptr);
+    cache.GetOrInsert(3, std::make_shared<int const>(3), 100);
+    cache.GetOrInsert(4, std::make_shared<int const>(4), 100);
+
+    EXPECT_EQ(cache.GetUsedBytes(), 300u);
+    EXPECT_TRUE(cache.Contains(1));
+    EXPECT_FALSE(cache.Contains(2));
+    EXPECT_TRUE(cache.Contains(3));
+    EXPECT_TRUE(cache.Contains(4));
+}
+
+TEST(CacheWithLimitTest, EvictedValuesStayAliveWhileUsed) {
+    algos::fastod::CacheWithLimit<int, int> cache(2);
+    std::shared_ptr<int const> const first =
+            cache.GetOrInsert(1, std::make_shared<int const>(1), 2);
+    cache.GetOrInsert(2, std::make_shared<int const>(2), 2);
+
+    EXPECT_FALSE(cache.Contains(1));
+    EXPECT_TRUE(cache.Contains(2));
+    EXPECT_EQ(cache.GetUsedBytes(), 2u);
+    EXPECT_EQ(*first, 1);
+    /* Values larger than the whole budget are returned without evicting anything */
+    EXPECT_EQ(*cache.GetOrInsert(3, std::make_shared<int const>(3), 3), 3);
+    EXPECT_TRUE(cache.Contains(2));
+    EXPECT_FALSE(cache.Contains(3));
+}
+
 INSTANTIATE_TEST_SUITE_P(
         TestFastodSuite, ExactFastodResultHashTest,
         ::testing::Values(CSVConfigHash{kOdTestNormOd, 8741296102670149192ULL},
@@ -1,10 +1,16 @@
 #include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <functional>
+#include <thread>
+#include <typeinfo>
 
 #include <gmock/gmock.h>
 #include <gtest/gtest.h>
 
 #include "core/algorithms/fd/depminer/depminer.h"
 #include "core/algorithms/fd/dfd/dfd.h"
+#include "core/algorithms/fd/dfd/partition_storage/partition_storage.h"
 #include "core/algorithms/fd/fastfds/fastfds.h"
 #include "core/algorithms/fd/fdep/fdep.h"
 #include "core/algorithms/fd/fun/fun.h"
@@ -12,7 +18,10 @@
 #include "core/algorithms/fd/pyro/pyro.h"
 #include "core/algorithms/fd/tane/pfdtane.h"
 #include "core/algorithms/fd/tane/tane.h"
+#include "core/model/table/column_layout_relation_data.h"
 #include "core/model/table/relational_schema.h"
+#include "core/util/arena.h"
+#include "core/util/cancellation_token.h"
 #include "tests/unit/test_fd_util.h"
 
 using std::string, std::vector;
@@ -121,6 +130,26 @@ TYPED_TEST_P(AlgorithmTest, ConsistentRepeatedExecution) {
     }
 }
 
+TYPED_TEST_P(AlgorithmTest, StopsWhenCancelled) {
+    auto algorithm = TestFixture::CreateAlgorithmInstance(kWdcAstronomical);
+    algorithm->Execute();
+    auto const full_res = FDsToSet(algorithm->FdList());
+    ASSERT_EQ(algorithm->GetStopReason(), util::StopReason::kNone);
+
+    algos::ConfigureFromMap(*algorithm, TestFixture::GetParamMap(kWdcAstronomical));
+    algorithm->Cancel();
+    algorithm->Execute();
+    ASSERT_EQ(algorithm->GetStopReason(), util::StopReason::kCancelled);
+    for (auto const& fd : FDsToSet(algorithm->FdList())) {
+        ASSERT_TRUE(full_res.contains(fd));
+    }
+
+    algos::ConfigureFromMap(*algorithm, TestFixture::GetParamMap(kWdcAstronomical));
+    algorithm->Execute();
+    ASSERT_EQ(algorithm->GetStopReason(), util::StopReason::kNone);
+    ASSERT_TRUE(CheckFdListEquality(full_res, algorithm->FdList()));
+}
+
 namespace {
 void MaxLhsTestFun(CSVConfig config, std::list<FD> const& fds_list, config::MaxLhsType max_lhs) {
     using namespace config::names;
@@ -154,11 +183,230 @@ TYPED_TEST_P(AlgorithmTest, MaxLHSOptionWork) {
 REGISTER_TYPED_TEST_SUITE_P(AlgorithmTest, ThrowsOnEmpty, ReturnsEmptyOnSingleNonKey,
                             WorksOnLongDataset, WorksOnWideDataset, LightDatasetsConsistentHash,
                             HeavyDatasetsConsistentHash, ConsistentRepeatedExecution,
-                            MaxLHSOptionWork);
+                            StopsWhenCancelled, MaxLHSOptionWork);
 
 using Algorithms =
         ::testing::Types<algos::Tane, algos::Pyro, algos::FastFDs, algos::DFD, algos::Depminer,
                          algos::FDep, algos::FUN, algos::hyfd::HyFD, algos::PFDTane>;
 INSTANTIATE_TYPED_TEST_SUITE_P(AlgorithmTest, AlgorithmTest, Algorithms);
 
+// With more threads than columns Pyro splits the search spaces between the workers
+TEST(PyroTest, SplitSearchSpacesFindSameFDs) {
+    using namespace config::names;
+    for (CSVConfig const& csv_config : {kTestFD, kCIPublicHighway700, kBreastCancer}) {
+        auto tane = algos::CreateAndLoadAlgorithm<algos::Tane>(
+                {{kCsvConfig, csv_config}, {kError, config::ErrorType{0.0}}});
+        tane->Execute();
+
+        auto pyro = algos::CreateAndLoadAlgorithm<algos::Pyro>(
+                {{kCsvConfig, csv_config},
+                 {kError, config::ErrorType{0.0}},
+                 {kSeed, decltype(algos::pyro::Parameters::seed){0}},
+                 {kThreads, config::ThreadNumType{64}}});
+        pyro->Execute();
+        EXPECT_TRUE(CheckFdListEquality(FDsToSet(tane->FdList()), pyro->FdList()))
+                << "for " << csv_config.path.filename();
+    }
+}
+
+namespace {
+/* Tane that runs a hook inside Execute right after it has registered its first FD, so that the
+ * stop conditions can be triggered in the middle of a run deterministically */
+class HookedTane : public algos::Tane {
+private:
+    std::function<void(HookedTane&)> on_first_fd_;
+    bool hook_ran_ = false;
+
+protected:
+    using algos::Tane::RegisterFd;
+
+    void RegisterFd(Vertical lhs, Column rhs,
+                    std::shared_ptr<RelationalSchema const> const& schema) override {
+        algos::Tane::RegisterFd(std::move(lhs), std::move(rhs), schema);
+        if (!hook_ran_ && on_first_fd_) {
+            hook_ran_ = true;
+            on_first_fd_(*this);
+        }
+    }
+
+public:
+    void SetOnFirstFd(std::function<void(HookedTane&)> on_first_fd) {
+        on_first_fd_ = std::move(on_first_fd);
+        hook_ran_ = false;
+    }
+
+    /* Counts against the memory budget without becoming resident, as the memory is not written */
+    void AllocateFromArena(size_t bytes) {
+        GetArena().GetMonotonic()->allocate(bytes);
+    }
+};
+
+algos::StdParamsMap MidRunStopParams() {
+    using namespace config::names;
+    return {{kCsvConfig, kCIPublicHighway700}, {kError, config::ErrorType{0.0}}};
+}
+
+void CheckStoppedMidRun(HookedTane const& algorithm, util::StopReason expected_reason) {
+    auto full_algorithm = algos::CreateAndLoadAlgorithm<algos::Tane>(MidRunStopParams());
+    full_algorithm->Execute();
+    auto const full_res = FDsToSet(full_algorithm->FdList());
+
+    ASSERT_EQ(algorithm.GetStopReason(), expected_reason);
+    auto const partial_res = FDsToSet(algorithm.FdList());
+    ASSERT_LT(partial_res.size(), full_res.size());
+    for (auto const& fd : partial_res) {
+        ASSERT_TRUE(full_res.contains(fd));
+    }
+    /* What was left unchecked was not reported as found */
+    ASSERT_FALSE(algorithm.CandidateFrontier().empty());
+    for (auto const& fd : FDsToSet(algorithm.CandidateFrontier())) {
+        ASSERT_FALSE(partial_res.contains(fd));
+    }
+}
+}  // namespace
+
+TEST(StopMidRunTest, CancelFromAnotherThread) {
+    auto algorithm = algos::CreateAndLoadAlgorithm<HookedTane>(MidRunStopParams());
+    algorithm->SetOnFirstFd([](HookedTane& self) {
+        std::thread([&self]() { self.Cancel(); }).join();
+    });
+    algorithm->Execute();
+    CheckStoppedMidRun(*algorithm, util::StopReason::kCancelled);
+}
+
+TEST(StopMidRunTest, TimeBudget) {
+    auto algorithm = algos::CreateAndLoadAlgorithm<HookedTane>(MidRunStopParams());
+    algorithm->SetTimeBudget(std::chrono::milliseconds{1});
+    algorithm->SetOnFirstFd(
+            [](HookedTane&) { std::this_thread::sleep_for(std::chrono::milliseconds{5}); });
+    algorithm->Execute();
+    CheckStoppedMidRun(*algorithm, util::StopReason::kTimeLimit);
+}
+
+TEST(StopMidRunTest, MemoryBudget) {
+    /* The budget is far above what the run itself takes, in the arena or resident, so it is only
+     * exceeded by the arena allocation of the hook, which the next safe point counts exactly */
+    constexpr size_t kBudgetBytes = size_t{128} << 20;
+    auto algorithm = algos::CreateAndLoadAlgorithm<HookedTane>(MidRunStopParams());
+    algorithm->SetMemoryBudget(kBudgetBytes);
+    algorithm->SetOnFirstFd([](HookedTane& self) { self.AllocateFromArena(2 * kBudgetBytes); });
+    algorithm->Execute();
+    ASSERT_GT(algorithm->GetPeakArenaBytes(), kBudgetBytes);
+    CheckStoppedMidRun(*algorithm, util::StopReason::kMemoryLimit);
+}
+
+class DFDPartitionStorageTest : public ::testing::Test {
+protected:
+    std::unique_ptr<ColumnLayoutRelationData> relation_;
+    std::vector<Vertical> verticals_;
+    std::vector<unsigned long long> expected_neps_;
+
+    void SetUp() override {
+        auto input_table = MakeInputTable(kCIPublicHighway700);
+        relation_ = ColumnLayoutRelationData::CreateFrom(*input_table);
+        RelationalSchema const* schema = relation_->GetSchema();
+        size_t const num_columns = std::min<size_t>(schema->GetNumColumns(), 8);
+
+        for (size_t i = 0; i < num_columns; ++i) {
+            for (size_t j = i + 1; j < num_columns; ++j) {
+                for (size_t k = j + 1; k <= num_columns; ++k) {
+                    boost::dynamic_bitset<> indices(schema->GetNumColumns());
+                    indices.set(i).set(j);
+                    auto pli = relation_->GetColumnData(i).GetPositionListIndex()->Intersect(
+                            relation_->GetColumnData(j).GetPositionListIndex());
+                    if (k < num_columns) {
+                        indices.set(k);
+                        pli = pli->Intersect(relation_->GetColumnData(k).GetPositionListIndex());
+                    }
+                    verticals_.push_back(schema->GetVertical(indices));
+                    expected_neps_.push_back(pli->GetNepAsLong());
+                }
+            }
+        }
+    }
+
+    /* Requests every vertical num_rounds times from each thread, half of the threads in reverse
+     * order, and returns the number of PLIs that came out wrong */
+    size_t RequestConcurrently(PartitionStorage& storage, unsigned num_threads,
+                               unsigned num_rounds) {
+        std::atomic<size_t> num_mismatches = 0;
+        std::vector<std::thread> threads;
+        for (unsigned t = 0; t < num_threads; ++t) {
+            threads.emplace_back([&, t]() {
+                for (unsigned round = 0; round < num_rounds; ++round) {
+                    for (size_t n = 0; n < verticals_.size(); ++n) {
+                        size_t const i = t % 2 == 0 ? n : verticals_.size() - 1 - n;
+                        if (storage.GetOrCreateFor(verticals_[i])->GetNepAsLong() !=
+                            expected_neps_[i]) {
+                            ++num_mismatches;
+                        }
+                    }
+                }
+            });
+        }
+        for (std::thread& thread : threads) {
+            thread.join();
+        }
+        return num_mismatches;
+    }
+};
+
+TEST_F(DFDPartitionStorageTest, ConcurrentRequestsWithinBudget) {
+    constexpr size_t kMaxBytes = 16 * 1024;
+
+    PartitionStorage storage(relation_.get(), kMaxBytes);
+    ASSERT_EQ(RequestConcurrently(storage, 4, 1), 0);
+    ASSERT_LE(storage.GetUsedBytes(), kMaxBytes);
+}
+
+TEST_F(DFDPartitionStorageTest, StressWithTinyBudget) {
+    /* Most insertions overflow the budget, so threads evict while others insert */
+    constexpr size_t kMaxBytes = 2 * 1024;
+    /* Far above anything a PLI of this table takes, far below a wrapped-around counter */
+    constexpr size_t kSaneBytes = 1 << 20;
+
+    PartitionStorage storage(relation_.get(), kMaxBytes);
+    std::atomic<bool> done = false;
+    size_t max_used_bytes = 0;
+    std::thread watcher([&]() {
+        while (!done) {
+            max_used_bytes = std::max(max_used_bytes, storage.GetUsedBytes());
+        }
+    });
+    size_t const num_mismatches = RequestConcurrently(storage, 8, 20);
+    done = true;
+    watcher.join();
+
+    ASSERT_EQ(num_mismatches, 0);
+    ASSERT_LT(max_used_bytes, kSaneBytes);
+    ASSERT_LE(storage.GetUsedBytes(), kMaxBytes);
+}
+
+TEST_F(DFDPartitionStorageTest, PlisTakenFromGivenResource) {
+    util::CountingResource upstream;
+    {
+        PartitionStorage storage(relation_.get(), size_t{1} << 20, &upstream);
+        ASSERT_EQ(RequestConcurrently(storage, 4, 2), 0);
+        ASSERT_GT(storage.GetUsedBytes(), 0u);
+        ASSERT_EQ(upstream.GetBytes(), storage.GetUsedBytes());
+    }
+    ASSERT_EQ(upstream.GetBytes(), 0u);
+}
+
+template <typename Algorithm>
+void CheckRunTakesArenaMemory() {
+    auto algorithm = algos::CreateAndLoadAlgorithm<Algorithm>(MidRunStopParams());
+    algorithm->Execute();
+    ASSERT_GT(algorithm->GetPeakArenaBytes(), 0u) << typeid(Algorithm).name();
+}
+
+/* The lattice of Tane, the PLI cache of DFD, the FD tree of HyFD and the cover trees of FDep are
+ * allocated from the arena, so a memory budget covers them */
+TEST(ArenaUseTest, RunsTakeArenaMemory) {
+    CheckRunTakesArenaMemory<algos::Tane>();
+    CheckRunTakesArenaMemory<algos::DFD>();
+    CheckRunTakesArenaMemory<algos::hyfd::HyFD>();
+    CheckRunTakesArenaMemory<algos::FDep>();
+}
+
 }  // namespace tests
@@ -1,13 +1,19 @@
 #include <algorithm>
 #include <memory>
+#include <utility>
+#include <vector>
 
 #include <gtest/gtest.h>
 
 #include "core/algorithms/algo_factory.h"
+#include "core/algorithms/fd/fd_verifier/batch_verifier.h"
 #include "core/algorithms/fd/fd_verifier/fd_verifier.h"
 #include "core/algorithms/fd/fd_verifier/stats_calculator.h"
+#include "core/algorithms/ucc/ucc_verifier/ucc_verifier.h"
+#include "core/config/exceptions.h"
 #include "core/config/indices/type.h"
 #include "core/config/names.h"
+#include "core/config/thread_number/type.h"
 #include "core/model/types/builtin.h"
 #include "tests/common/all_csv_configs.h"
 #include "tests/common/csv_config_util.h"
@@ -111,3 +117,90 @@ INSTANTIATE_TEST_SUITE_P(
                           FDVerifyingParams({1, 4}, {2, 3, 5}, 3, 8, 10.L / 132),
                           FDVerifyingParams({0, 1}, {1, 4}, 2, 6, 8.L / 132)));
 }  // namespace tests
+
+namespace tests {
+
+TEST(FDVerifierTest, LoadColumnsMatchesFullLoad) {
+    using algos::fd_verifier::FDVerifier;
+    namespace onam = config::names;
+
+    std::vector<std::pair<config::IndicesType, config::IndicesType>> const fds = {
+            {{4}, {3}}, {{1, 3}, {5}}, {{3, 4}, {1, 2}}, {{0}, {2, 3}}, {{2}, {5}}};
+    for (auto const& [lhs, rhs] : fds) {
+        config::IndicesType load_columns = lhs;
+        load_columns.insert(load_columns.end(), rhs.begin(), rhs.end());
+        algos::StdParamsMap params{{onam::kCsvConfig, kTestFD},
+                                   {onam::kLhsIndices, lhs},
+                                   {onam::kRhsIndices, rhs},
+                                   {onam::kEqualNulls, true}};
+        auto verifier = algos::CreateAndLoadAlgorithm<FDVerifier>(params);
+        verifier->Execute();
+        params.emplace(onam::kLoadColumns, load_columns);
+        auto projected_verifier = algos::CreateAndLoadAlgorithm<FDVerifier>(params);
+        projected_verifier->Execute();
+
+        EXPECT_EQ(projected_verifier->FDHolds(), verifier->FDHolds());
+        EXPECT_DOUBLE_EQ(projected_verifier->GetError(), verifier->GetError());
+        EXPECT_EQ(projected_verifier->GetNumErrorClusters(), verifier->GetNumErrorClusters());
+        EXPECT_EQ(projected_verifier->GetNumErrorRows(), verifier->GetNumErrorRows());
+        EXPECT_EQ(projected_verifier->GetHighlights().size(), verifier->GetHighlights().size());
+    }
+
+    algos::StdParamsMap params{{onam::kCsvConfig, kTestFD},
+                               {onam::kLoadColumns, config::IndicesType{1, 2}},
+                               {onam::kLhsIndices, config::IndicesType{1}},
+                               {onam::kRhsIndices, config::IndicesType{3}},
+                               {onam::kEqualNulls, true}};
+    EXPECT_THROW(algos::CreateAndLoadAlgorithm<FDVerifier>(params), config::ConfigurationError);
+}
+
+TEST(BatchVerifierTest, MatchesSingleVerifiers) {
+    using FdList = algos::fd_verifier::BatchVerifier::FdList;
+    using UccList = algos::fd_verifier::BatchVerifier::UccList;
+    namespace onam = config::names;
+
+    FdList const fds = {{{1}, {0}},          {{2, 3}, {5}},   {{4}, {3}},       {{3}, {4}},
+                        {{0}, {1}},          {{1}, {2}},      {{1}, {2, 3}},    {{1, 3}, {5}},
+                        {{1, 2}, {0, 3}},    {{3, 4}, {1, 2}}, {{0}, {2, 3}},   {{2}, {5}},
+                        {{1, 4}, {2, 3, 5}}, {{0, 1}, {1, 4}}};
+    UccList const uccs = {{0}, {1}, {1, 2}, {3, 4}, {0, 1, 2, 3, 4, 5}};
+
+    algos::StdParamsMap params{{onam::kCsvConfig, kTestFD},
+                               {onam::kFdsToVerify, fds},
+                               {onam::kUccsToVerify, uccs},
+                               {onam::kMaxHighlights, 100u},
+                               {onam::kThreads, static_cast<config::ThreadNumType>(4)}};
+    auto batch_verifier =
+            algos::CreateAndLoadAlgorithm<algos::fd_verifier::BatchVerifier>(params);
+    batch_verifier->Execute();
+    auto const& fd_results = batch_verifier->GetFdResults();
+    auto const& ucc_results = batch_verifier->GetUccResults();
+    ASSERT_EQ(fd_results.size(), fds.size());
+    ASSERT_EQ(ucc_results.size(), uccs.size());
+
+    for (std::size_t i = 0; i < fds.size(); ++i) {
+        algos::StdParamsMap fd_params{{onam::kCsvConfig, kTestFD},
+                                      {onam::kLhsIndices, fds[i].first},
+                                      {onam::kRhsIndices, fds[i].second},
+                                      {onam::kEqualNulls, true}};
+        auto verifier = algos::CreateAndLoadAlgorithm<algos::fd_verifier::FDVerifier>(fd_params);
+        verifier->Execute();
+        EXPECT_EQ(fd_results[i].Holds(), verifier->FDHolds());
+        EXPECT_DOUBLE_EQ(fd_results[i].error, verifier->GetError());
+        EXPECT_EQ(fd_results[i].num_error_clusters, verifier->GetNumErrorClusters());
+        EXPECT_EQ(fd_results[i].num_error_rows, verifier->GetNumErrorRows());
+        EXPECT_EQ(fd_results[i].highlights.size(), verifier->GetHighlights().size());
+    }
+
+    for (std::size_t i = 0; i < uccs.size(); ++i) {
+        algos::StdParamsMap ucc_params{{onam::kCsvConfig, kTestFD}, {onam::kUCCIndices, uccs[i]}};
+        auto verifier = algos::CreateAndLoadAlgorithm<algos::UCCVerifier>(ucc_params);
+        verifier->Execute();
+        EXPECT_EQ(ucc_results[i].Holds(), verifier->UCCHolds());
+        EXPECT_DOUBLE_EQ(ucc_results[i].error, verifier->GetError());
+        EXPECT_EQ(ucc_results[i].num_error_clusters, verifier->GetNumClustersViolatingUCC());
+        EXPECT_EQ(ucc_results[i].num_error_rows, verifier->GetNumRowsViolatingUCC());
+    }
+}
+
+}  // namespace tests
@@ -11,8 +11,10 @@
 
 #include "core/algorithms/algo_factory.h"
 #include "core/algorithms/gdd/gdd.h"
+#include "core/algorithms/gdd/gdd_validator/indexed_gdd_validator.h"
 #include "core/algorithms/gdd/gdd_validator/naive_gdd_validator.h"
 #include "core/config/names.h"
+#include "core/config/thread_number/type.h"
 #include "tests/unit/test_gdd_utils.h"
 
 using model::Gdd;
@@ -61,13 +63,13 @@ protected:
         return path;
     }
 
+    template <typename Validator>
     static std::unique_ptr<algos::GddValidator> CreateGddValidatorInstance(
-            std::filesystem::path const& graph_path, std::vector<Gdd> const& gdds) {
-        algos::StdParamsMap const option_map = {
-                {config::names::kGraphData, graph_path},
-                {config::names::kGddData, gdds},
-        };
-        return algos::CreateAndLoadAlgorithm<algos::NaiveGddValidator>(option_map);
+            std::filesystem::path const& graph_path, std::vector<Gdd> const& gdds,
+            algos::StdParamsMap option_map = {}) {
+        option_map.emplace(config::names::kGraphData, graph_path);
+        option_map.emplace(config::names::kGddData, gdds);
+        return algos::CreateAndLoadAlgorithm<Validator>(option_map);
     }
 };
 
@@ -75,21 +77,31 @@ TEST_P(GddValidatorCasesTest, ReturnsExpectedValidGdds) {
     ValidatorCase const& tc = GetParam();
 
     auto const graph_path = WriteTempDotFile(tc.graph_dot, tc.temp_file_name);
-    auto const validator = CreateGddValidatorInstance(graph_path, tc.input_gdds);
-
-    validator->Execute();
-    auto const out = validator->GetResult();
-
-    EXPECT_THAT(out, testing::UnorderedElementsAreArray(tc.expected_valid_gdds));
-
-    std::vector<std::size_t> actual_counterexample_indices;
-    actual_counterexample_indices.reserve(validator->GetCounterexamples().size());
-    for (auto const& [gdd_index, match] : validator->GetCounterexamples()) {
-        actual_counterexample_indices.push_back(gdd_index);
+    std::unique_ptr<algos::GddValidator> const validators[] = {
+            CreateGddValidatorInstance<algos::NaiveGddValidator>(graph_path, tc.input_gdds),
+            CreateGddValidatorInstance<algos::IndexedGddValidator>(graph_path, tc.input_gdds,
+                                                                   {{config::names::kThreads,
+                                                                     config::ThreadNumType{1}}}),
+            CreateGddValidatorInstance<algos::IndexedGddValidator>(graph_path, tc.input_gdds,
+                                                                   {{config::names::kThreads,
+                                                                     config::ThreadNumType{4}}}),
+    };
+
+    for (auto const& validator : validators) {
+        validator->Execute();
+        auto const out = validator->GetResult();
+
+        EXPECT_THAT(out, testing::UnorderedElementsAreArray(tc.expected_valid_gdds));
+
+        std::vector<std::size_t> actual_counterexample_indices;
+        actual_counterexample_indices.reserve(validator->GetCounterexamples().size());
+        for (auto const& [gdd_index, match] : validator->GetCounterexamples()) {
+            actual_counterexample_indices.push_back(gdd_index);
+        }
+
+        EXPECT_THAT(actual_counterexample_indices,
+                    testing::UnorderedElementsAreArray(tc.expected_counterexample_gdd_indices));
     }
-
-    EXPECT_THAT(actual_counterexample_indices,
-                testing::UnorderedElementsAreArray(tc.expected_counterexample_gdd_indices));
 }
 
 INSTANTIATE_TEST_SUITE_P(
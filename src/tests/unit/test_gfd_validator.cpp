@@ -1,3 +1,13 @@
+#include <algorithm>
+#include <cstddef>
+#include <filesystem>
+#include <fstream>
+#include <optional>
+#include <random>
+#include <string>
+#include <tuple>
+#include <vector>
+
 #include <gmock/gmock.h>
 #include <gtest/gtest.h>
 
@@ -6,6 +16,7 @@
 #include "core/algorithms/gfd/gfd_validator/gfd_validator.h"
 #include "core/algorithms/gfd/gfd_validator/naivegfd_validator.h"
 #include "core/config/names.h"
+#include "tests/common/temp_path.h"
 #include "tests/unit/all_gfd_paths.h"
 
 using namespace algos;
@@ -54,6 +65,265 @@ using GfdAlgorithms =
 
 INSTANTIATE_TYPED_TEST_SUITE_P(GfdValidatorTest, GfdValidatorTest, GfdAlgorithms);
 
+TEST(EGfdValidatorTest, TestThreads) {
+    std::vector<std::filesystem::path> gfd_paths = {kGfdTestSymbolsGfd1, kGfdTestSymbolsGfd2};
+    for (config::ThreadNumType threads : {1, 4}) {
+        StdParamsMap option_map = {{config::names::kGraphData, kGfdTestSymbolsGraph},
+                                   {config::names::kGfdData, gfd_paths},
+                                   {config::names::kThreads, threads}};
+        auto algorithm = algos::CreateAndLoadAlgorithm<algos::EGfdValidator>(option_map);
+        algorithm->Execute();
+        ASSERT_EQ(2, algorithm->GfdList().size());
+    }
+}
+
+TEST(EGfdValidatorTest, TestGraphSnapshot) {
+    std::filesystem::path const snapshot_path = MakeTempPath(".snapshot");
+    parser::graph_parser::gfd::WriteGraphSnapshot(
+            snapshot_path, parser::graph_parser::gfd::ReadGraph(kGfdTestSymbolsGraph));
+    std::vector<std::filesystem::path> gfd_paths = {kGfdTestSymbolsGfd1, kGfdTestSymbolsGfd2};
+    StdParamsMap option_map = {{config::names::kGraphData, snapshot_path},
+                               {config::names::kGfdData, gfd_paths},
+                               {config::names::kThreads, config::ThreadNumType{4}}};
+    auto algorithm = algos::CreateAndLoadAlgorithm<algos::EGfdValidator>(option_map);
+    std::filesystem::remove(snapshot_path);
+    algorithm->Execute();
+    ASSERT_EQ(2, algorithm->GfdList().size());
+}
+
+/* Validates GFDs given as text with EGfdValidator, through temporary files */
+class EGfdValidatorTextTest : public ::testing::Test {
+protected:
+    std::filesystem::path graph_path_ = MakeTempPath("_graph.dot");
+    std::filesystem::path gfd_path_ = MakeTempPath("_gfd.dot");
+
+    void TearDown() override {
+        std::filesystem::remove(graph_path_);
+        std::filesystem::remove(gfd_path_);
+    }
+
+    bool IsSatisfied(std::string const& graph, std::string const& gfd,
+                     config::ThreadNumType threads = 1) const {
+        std::ofstream(graph_path_) << graph;
+        std::ofstream(gfd_path_) << gfd;
+        std::vector<std::filesystem::path> gfd_paths = {gfd_path_};
+        StdParamsMap option_map = {{config::names::kGraphData, graph_path_},
+                                   {config::names::kGfdData, gfd_paths},
+                                   {config::names::kThreads, threads}};
+        auto algorithm = algos::CreateAndLoadAlgorithm<algos::EGfdValidator>(option_map);
+        algorithm->Execute();
+        return algorithm->GfdList().size() == 1;
+    }
+};
+
+/* A labeled graph with an optional attribute x on every vertex */
+struct LabeledGraph {
+    std::vector<std::string> labels;
+    // value of x, or empty if the vertex has no x
+    std::vector<std::string> values;
+    std::vector<std::tuple<std::size_t, std::size_t, std::string>> edges;
+
+    std::string ToDot() const {
+        std::string dot = "graph G {\n";
+        for (std::size_t v = 0; v != labels.size(); ++v) {
+            dot += std::to_string(v) + "[label=" + labels[v];
+            if (!values[v].empty()) dot += " x=" + values[v];
+            dot += "];\n";
+        }
+        for (auto const& [source, target, label] : edges) {
+            dot += std::to_string(source) + "--" + std::to_string(target) + " [label=" + label +
+                   "];\n";
+        }
+        return dot + "}\n";
+    }
+
+    std::string const* FindEdgeLabel(std::size_t u, std::size_t v) const {
+        for (auto const& [source, target, label] : edges) {
+            if ((source == u && target == v) || (source == v && target == u)) return &label;
+        }
+        return nullptr;
+    }
+};
+
+/* Literal i.x=j.x, or i.x=value if j is absent */
+struct XLiteral {
+    std::size_t i;
+    std::optional<std::size_t> j;
+    std::string value;
+
+    std::string ToString() const {
+        return std::to_string(i) + ".x=" + (j ? std::to_string(*j) + ".x" : value);
+    }
+
+    bool Holds(LabeledGraph const& graph, std::vector<std::size_t> const& match) const {
+        std::string const& fst = graph.values[match[i]];
+        std::string const& snd = j ? graph.values[match[*j]] : value;
+        return !fst.empty() && !snd.empty() && fst == snd;
+    }
+};
+
+std::string LiteralsLine(std::vector<XLiteral> const& literals) {
+    std::string line;
+    for (XLiteral const& literal : literals) {
+        if (!line.empty()) line += ' ';
+        line += literal.ToString();
+    }
+    return line + '\n';
+}
+
+/* Tries every injective mapping of the pattern into the graph */
+bool IsSatisfiedExhaustive(LabeledGraph const& graph, LabeledGraph const& pattern,
+                           std::vector<XLiteral> const& premises,
+                           std::vector<XLiteral> const& conclusion) {
+    std::vector<std::size_t> match;
+    std::vector<bool> used(graph.labels.size(), false);
+    auto extend = [&](auto&& self) -> bool {
+        std::size_t const u = match.size();
+        if (u == pattern.labels.size()) {
+            auto holds = [&](XLiteral const& literal) { return literal.Holds(graph, match); };
+            return !std::ranges::all_of(premises, holds) || std::ranges::all_of(conclusion, holds);
+        }
+        for (std::size_t v = 0; v != graph.labels.size(); ++v) {
+            if (used[v] || graph.labels[v] != pattern.labels[u]) continue;
+            bool edges_match = true;
+            for (std::size_t prev = 0; prev != u && edges_match; ++prev) {
+                std::string const* pattern_label = pattern.FindEdgeLabel(prev, u);
+                if (pattern_label == nullptr) continue;
+                std::string const* graph_label = graph.FindEdgeLabel(match[prev], v);
+                edges_match = graph_label != nullptr && *graph_label == *pattern_label;
+            }
+            if (!edges_match) continue;
+            used[v] = true;
+            match.push_back(v);
+            bool const satisfied = self(self);
+            match.pop_back();
+            used[v] = false;
+            if (!satisfied) return false;
+        }
+        return true;
+    };
+    return extend(extend);
+}
+
+/* A candidate of the root has no candidates of its child along the labeled edge */
+TEST_F(EGfdValidatorTextTest, CandidateWithoutChildren) {
+    std::string const graph =
+            "graph G {\n0[label=A x=1];\n1[label=B x=1];\n2[label=A x=2];\n3[label=B x=3];\n"
+            "0--1 [label=e];\n2--3 [label=f];\n}\n";
+    std::string const gfd = "\n0.x=1.x\ngraph G {\n0[label=A];\n1[label=B];\n0--1 [label=e];\n}\n";
+    EXPECT_TRUE(IsSatisfied(graph, gfd));
+}
+
+/* Paths of the matching order that share a prefix with an earlier path but not with the
+ * order built so far */
+TEST_F(EGfdValidatorTextTest, MatchingOrderOfBranchingTree) {
+    std::string const pattern =
+            "graph G {\n0[label=R];\n1[label=A];\n2[label=B];\n3[label=C];\n4[label=D];\n"
+            "0--1 [label=e];\n1--2 [label=e];\n0--3 [label=e];\n1--4 [label=e];\n}\n";
+    std::string const graph =
+            "graph G {\n0[label=R x=0];\n1[label=A x=0];\n2[label=B x=0];\n3[label=C x=0];\n"
+            "4[label=D x=1];\n0--1 [label=e];\n1--2 [label=e];\n0--3 [label=e];\n"
+            "1--4 [label=e];\n}\n";
+    EXPECT_FALSE(IsSatisfied(graph, "\n0.x=4.x\n" + pattern));
+    EXPECT_TRUE(IsSatisfied(graph, "\n0.x=3.x\n" + pattern));
+}
+
+/* The first matches of the core have no extension to the dangling vertex, a later one has and
+ * violates the GFD */
+TEST_F(EGfdValidatorTextTest, FailedForestExtension) {
+    std::string const gfd =
+            "\n0.x=1.x\ngraph G {\n0[label=A];\n1[label=B];\n2[label=C];\n3[label=C];\n"
+            "0--1 [label=e];\n1--2 [label=e];\n0--2 [label=e];\n0--3 [label=e];\n}\n";
+    std::string graph = "graph G {\n";
+    // the last vertex of a triangle hangs on an f edge in the first two, on an e edge in the last
+    for (int triangle = 0; triangle != 3; ++triangle) {
+        std::string const a = std::to_string(4 * triangle);
+        std::string const b = std::to_string(4 * triangle + 1);
+        std::string const c = std::to_string(4 * triangle + 2);
+        std::string const d = std::to_string(4 * triangle + 3);
+        graph += a + "[label=A x=0];\n" + b + "[label=B x=" + (triangle == 2 ? "1" : "0") +
+                 "];\n" + c + "[label=C];\n" + d + "[label=C];\n";
+        graph += a + "--" + b + " [label=e];\n" + b + "--" + c + " [label=e];\n" + a + "--" + c +
+                 " [label=e];\n" + a + "--" + d + " [label=" + (triangle == 2 ? "e" : "f") +
+                 "];\n";
+    }
+    graph += "}\n";
+    EXPECT_FALSE(IsSatisfied(graph, gfd));
+}
+
+/* A graph vertex is a candidate of two pattern vertices with the same label and is refined
+ * away from one of them only */
+TEST_F(EGfdValidatorTextTest, DeletionKeepsOtherPatternVertices) {
+    std::string const gfd =
+            "\n0.x=5.x\ngraph G {\n0[label=R];\n1[label=A];\n2[label=B];\n3[label=D];\n"
+            "4[label=E];\n5[label=A];\n6[label=C];\n0--1 [label=e];\n1--2 [label=e];\n"
+            "2--3 [label=e];\n3--4 [label=e];\n0--5 [label=e];\n5--6 [label=e];\n}\n";
+    // 1 is no match of pattern vertex 1, as its path through 2 ends without an E vertex, but it
+    // is the only match of pattern vertex 5
+    std::string const graph =
+            "graph G {\n0[label=R x=0];\n1[label=A x=1];\n2[label=C];\n3[label=B];\n"
+            "4[label=D];\n5[label=A];\n6[label=B];\n7[label=D];\n8[label=E];\n"
+            "0--1 [label=e];\n1--2 [label=e];\n1--3 [label=e];\n3--4 [label=e];\n"
+            "0--5 [label=e];\n5--6 [label=e];\n6--7 [label=e];\n7--8 [label=e];\n}\n";
+    EXPECT_FALSE(IsSatisfied(graph, gfd));
+}
+
+/* The validator agrees with the exhaustive matcher, with one thread and with several */
+TEST_F(EGfdValidatorTextTest, RandomGraphs) {
+    std::mt19937 gen(0);
+    auto random_graph = [&gen](std::size_t min_vertices, std::size_t max_vertices,
+                               double edge_probability, bool with_values) {
+        std::uniform_int_distribution<std::size_t> num_vertices(min_vertices, max_vertices);
+        std::bernoulli_distribution coin(0.5);
+        std::bernoulli_distribution has_edge(edge_probability);
+        std::bernoulli_distribution has_value(0.9);
+        LabeledGraph graph;
+        std::size_t const n = num_vertices(gen);
+        for (std::size_t v = 0; v != n; ++v) {
+            graph.labels.push_back(coin(gen) ? "A" : "B");
+            graph.values.push_back(with_values && has_value(gen) ? (coin(gen) ? "0" : "1") : "");
+            // every vertex is joined to an earlier one, so patterns are connected
+            std::size_t const tree_parent = std::uniform_int_distribution<std::size_t>(
+                    0, std::max<std::size_t>(v, 1) - 1)(gen);
+            for (std::size_t u = 0; u != v; ++u) {
+                if (u == tree_parent || has_edge(gen)) {
+                    graph.edges.emplace_back(u, v, coin(gen) ? "e" : "f");
+                }
+            }
+        }
+        return graph;
+    };
+    auto random_literal = [&gen](std::size_t pattern_size) {
+        std::uniform_int_distribution<std::size_t> vertex(0, pattern_size - 1);
+        std::size_t const i = vertex(gen);
+        if (std::bernoulli_distribution(0.3)(gen)) {
+            return XLiteral{i, std::nullopt, std::bernoulli_distribution(0.5)(gen) ? "0" : "1"};
+        }
+        std::size_t j = vertex(gen);
+        while (j == i) j = vertex(gen);
+        return XLiteral{i, j, {}};
+    };
+
+    for (int iteration = 0; iteration != 300; ++iteration) {
+        LabeledGraph const graph = random_graph(4, 9, 0.35, true);
+        LabeledGraph const pattern = random_graph(2, 5, 0.3, false);
+        std::vector<XLiteral> premises;
+        if (std::bernoulli_distribution(0.5)(gen)) {
+            premises.push_back(random_literal(pattern.labels.size()));
+        }
+        std::vector<XLiteral> const conclusion = {random_literal(pattern.labels.size())};
+        std::string const gfd =
+                LiteralsLine(premises) + LiteralsLine(conclusion) + pattern.ToDot();
+        bool const expected = IsSatisfiedExhaustive(graph, pattern, premises, conclusion);
+        for (config::ThreadNumType threads : {1, 4}) {
+            ASSERT_EQ(IsSatisfied(graph.ToDot(), gfd, threads), expected)
+                    << "threads: " << threads << "\ngraph:\n"
+                    << graph.ToDot() << "gfd:\n"
+                    << gfd;
+        }
+    }
+}
+
 }  // namespace
 
 }  // namespace tests
@@ -0,0 +1,225 @@
+#include <cstdint>
+#include <cstring>
+#include <filesystem>
+#include <fstream>
+#include <iterator>
+#include <stdexcept>
+#include <string>
+#include <string_view>
+#include <tuple>
+#include <utility>
+#include <vector>
+
+#include <gtest/gtest.h>
+
+#include "core/parser/graph_parser/graph_table.h"
+#include "core/util/worker_thread_pool.h"
+#include "tests/common/temp_path.h"
+
+namespace tests {
+
+namespace {
+
+using parser::graph_parser::GraphTable;
+
+/* Attributes and edges of a table with the views resolved, so that tables can be compared */
+struct Contents {
+    std::vector<std::string> attribute_names;
+    std::vector<std::int64_t> vertex_ids;
+    std::vector<std::vector<std::pair<std::string, std::string>>> attributes;
+    std::vector<std::tuple<std::size_t, std::size_t, std::string>> edges;
+
+    explicit Contents(GraphTable const& table)
+        : attribute_names(table.attribute_names.begin(), table.attribute_names.end()),
+          vertex_ids(table.vertex_ids) {
+        for (std::size_t v = 0; v != table.NumVertices(); ++v) {
+            auto& vertex = attributes.emplace_back();
+            for (GraphTable::Attribute const& attribute : table.GetAttributes(v)) {
+                vertex.emplace_back(attribute_names[attribute.name], attribute.value);
+            }
+        }
+        for (GraphTable::Edge const& edge : table.edges) {
+            edges.emplace_back(edge.source, edge.target, edge.label);
+        }
+    }
+
+    bool operator==(Contents const&) const = default;
+};
+
+class GraphTableTest : public ::testing::Test {
+protected:
+    std::filesystem::path path_ = MakeTempPath(".tsv");
+    util::WorkerThreadPool pool_{4};
+
+    void Write(std::string const& text) const {
+        std::ofstream out(path_, std::ios::binary);
+        out << text;
+    }
+
+    void TearDown() override {
+        std::filesystem::remove(path_);
+    }
+};
+
+TEST_F(GraphTableTest, ChunksMatchSequentialRead) {
+    /* large enough to be split into a chunk per thread */
+    constexpr int kVertices = 20000;
+    std::string text = "v\tid\tlabel\tname\n";
+    for (int v = 0; v != kVertices; ++v) {
+        text += "v\t" + std::to_string(v) + "\tperson\t" +
+                (v % 3 == 0 ? std::string{} : "name_" + std::to_string(v)) + '\n';
+    }
+    for (int v = 0; v != kVertices; ++v) {
+        text += "e\t" + std::to_string(v) + '\t' + std::to_string((v * 7 + 1) % kVertices) +
+                "\tknows\n";
+    }
+    Write(text);
+
+    Contents const sequential(GraphTable::ReadTable(path_, '\t', nullptr));
+    ASSERT_EQ(sequential.vertex_ids.size(), std::size_t{kVertices});
+    ASSERT_EQ(sequential.edges.size(), std::size_t{kVertices});
+    for (int v = 0; v != kVertices; ++v) {
+        ASSERT_EQ(sequential.vertex_ids[v], v);
+        ASSERT_EQ(sequential.attributes[v].size(), v % 3 == 0 ? 1u : 2u);
+        ASSERT_EQ(sequential.edges[v], std::make_tuple(v, (v * 7 + 1) % kVertices, "knows"));
+    }
+    EXPECT_TRUE(Contents(GraphTable::ReadTable(path_, '\t', &pool_)) == sequential);
+}
+
+TEST_F(GraphTableTest, SparseIdsAndCrlf) {
+    Write("v,id,label\r\nv,1000,a\r\n\r\nv,-5,b\r\nv,10,\r\ne,10,-5,x\r\ne,1000,10\r\n");
+    for (util::WorkerThreadPool* pool : {static_cast<util::WorkerThreadPool*>(nullptr), &pool_}) {
+        Contents const contents(GraphTable::ReadTable(path_, ',', pool));
+        EXPECT_EQ(contents.attribute_names, std::vector<std::string>{"label"});
+        EXPECT_EQ(contents.vertex_ids, (std::vector<std::int64_t>{1000, -5, 10}));
+        using Attributes = std::vector<std::pair<std::string, std::string>>;
+        EXPECT_EQ(contents.attributes,
+                  (std::vector<Attributes>{{{"label", "a"}}, {{"label", "b"}}, {}}));
+        EXPECT_EQ(contents.edges, (std::vector<std::tuple<std::size_t, std::size_t, std::string>>{
+                                          {2, 1, "x"}, {0, 2, ""}}));
+    }
+}
+
+TEST_F(GraphTableTest, MalformedRows) {
+    std::string const header = "v\tid\tlabel\n";
+    for (std::string const row : {"v\t1\ta\tb\n", "v\tone\ta\n", "x\t1\n", "e\t1\n",
+                                  "v\t1\na\n", "v\t1\nv\t1\ne\t1\t1\n", "v\t1\ne\t1\t2\n"}) {
+        Write(header + row);
+        EXPECT_THROW(GraphTable::ReadTable(path_, '\t', nullptr), std::runtime_error) << row;
+        EXPECT_THROW(GraphTable::ReadTable(path_, '\t', &pool_), std::runtime_error) << row;
+    }
+    Write("id\tv\n");
+    EXPECT_THROW(GraphTable::ReadTable(path_, '\t', nullptr), std::runtime_error);
+}
+
+class GraphSnapshotTest : public ::testing::Test {
+protected:
+    std::filesystem::path path_ = MakeTempPath(".snapshot");
+
+    /* Field offsets of the snapshot layout: a 64-byte header with the array sizes, followed by
+     * the string offsets, characters, attribute names, vertex ids and attribute offsets, each
+     * padded to 8 bytes */
+    static constexpr std::size_t kNumStringsPos = 16;
+    static constexpr std::size_t kStringsSizePos = 24;
+    static constexpr std::size_t kNumNamesPos = 32;
+    static constexpr std::size_t kNumVerticesPos = 40;
+    static constexpr std::size_t kHeaderSize = 64;
+
+    static std::size_t Align(std::size_t size) {
+        return (size + 7) / 8 * 8;
+    }
+
+    void TearDown() override {
+        std::filesystem::remove(path_);
+    }
+
+    /* Two vertices with one attribute each and an edge between them */
+    void WriteSnapshot() const {
+        GraphTable table;
+        table.attribute_names = {"label"};
+        table.vertex_ids = {0, 1};
+        table.attributes = {{0, "a"}, {0, "b"}};
+        table.attribute_offsets = {0, 1, 2};
+        table.edges = {{0, 1, "x"}};
+        table.WriteSnapshot(path_);
+    }
+
+    std::string ReadBytes() const {
+        std::ifstream in(path_, std::ios::binary);
+        return {std::istreambuf_iterator<char>(in), {}};
+    }
+
+    void WriteBytes(std::string const& bytes) const {
+        std::ofstream out(path_, std::ios::binary | std::ios::trunc);
+        out << bytes;
+    }
+
+    static std::uint64_t GetField(std::string const& bytes, std::size_t pos) {
+        std::uint64_t value;
+        std::memcpy(&value, bytes.data() + pos, sizeof(value));
+        return value;
+    }
+
+    static void SetField(std::string& bytes, std::size_t pos, std::uint64_t value) {
+        std::memcpy(bytes.data() + pos, &value, sizeof(value));
+    }
+
+    static std::size_t StringOffsetsPos() {
+        return kHeaderSize;
+    }
+
+    static std::size_t AttributeOffsetsPos(std::string const& bytes) {
+        return StringOffsetsPos() + Align((GetField(bytes, kNumStringsPos) + 1) * 8) +
+               Align(GetField(bytes, kStringsSizePos)) +
+               Align(GetField(bytes, kNumNamesPos) * 4) + GetField(bytes, kNumVerticesPos) * 8;
+    }
+
+    void ExpectCorrupted() const {
+        util::WorkerThreadPool pool{4};
+        EXPECT_THROW(GraphTable::ReadSnapshot(path_, nullptr), std::runtime_error);
+        EXPECT_THROW(GraphTable::ReadSnapshot(path_, &pool), std::runtime_error);
+    }
+};
+
+TEST_F(GraphSnapshotTest, RoundTrip) {
+    WriteSnapshot();
+    ASSERT_TRUE(GraphTable::IsSnapshot(path_));
+    Contents const contents(GraphTable::ReadSnapshot(path_, nullptr));
+    EXPECT_EQ(contents.vertex_ids, (std::vector<std::int64_t>{0, 1}));
+    using Attributes = std::vector<std::pair<std::string, std::string>>;
+    EXPECT_EQ(contents.attributes, (std::vector<Attributes>{{{"label", "a"}}, {{"label", "b"}}}));
+    EXPECT_EQ(contents.edges,
+              (std::vector<std::tuple<std::size_t, std::size_t, std::string>>{{0, 1, "x"}}));
+}
+
+TEST_F(GraphSnapshotTest, AttributeOffsetPastEnd) {
+    WriteSnapshot();
+    std::string bytes = ReadBytes();
+    std::size_t const pos = AttributeOffsetsPos(bytes);
+    ASSERT_EQ(GetField(bytes, pos + 8), 1u);
+    /* the offsets become [0, 100, 2]: the last one still matches the number of attributes */
+    SetField(bytes, pos + 8, 100);
+    WriteBytes(bytes);
+    ExpectCorrupted();
+}
+
+TEST_F(GraphSnapshotTest, StringOffsetPastEnd) {
+    WriteSnapshot();
+    std::string bytes = ReadBytes();
+    ASSERT_GE(GetField(bytes, kNumStringsPos), 2u);
+    SetField(bytes, StringOffsetsPos() + 8, 1 << 20);
+    WriteBytes(bytes);
+    ExpectCorrupted();
+}
+
+TEST_F(GraphSnapshotTest, Truncated) {
+    WriteSnapshot();
+    std::string bytes = ReadBytes();
+    bytes.resize(bytes.size() / 2);
+    WriteBytes(bytes);
+    ExpectCorrupted();
+}
+
+}  // namespace
+
+}  // namespace tests
@@ -362,6 +362,29 @@ TEST_F(GSpanTest, MaxEdgesConstraint) {
     EXPECT_GE(large_subgraphs.size(), small_subgraphs.size());
 }
 
+TEST_F(GSpanTest, ThreadsGiveSameResult) {
+    // the default thread number is the hardware concurrency, so the baseline sets it explicitly
+    auto params = CreateGSpanParams(kGSpanLargeGraph, 0.5);
+    params[config::names::kThreads] = static_cast<config::ThreadNumType>(1);
+    auto algorithm_single = algos::CreateAndLoadAlgorithm<algos::GSpan>(params);
+    algorithm_single->Execute();
+
+    params[config::names::kThreads] = static_cast<config::ThreadNumType>(4);
+    auto algorithm_parallel = algos::CreateAndLoadAlgorithm<algos::GSpan>(params);
+    algorithm_parallel->Execute();
+
+    auto const& single_subgraphs = algorithm_single->GetFrequentSubgraphs();
+    auto const& parallel_subgraphs = algorithm_parallel->GetFrequentSubgraphs();
+    ASSERT_EQ(single_subgraphs.size(), parallel_subgraphs.size());
+    for (size_t i = 0; i < single_subgraphs.size(); i++) {
+        EXPECT_EQ(single_subgraphs[i].id, parallel_subgraphs[i].id);
+        EXPECT_EQ(single_subgraphs[i].dfs_code.ToString(),
+                  parallel_subgraphs[i].dfs_code.ToString());
+        EXPECT_EQ(single_subgraphs[i].support, parallel_subgraphs[i].support);
+        EXPECT_EQ(single_subgraphs[i].graphs_ids, parallel_subgraphs[i].graphs_ids);
+    }
+}
+
 struct GSpanTestParams {
     std::filesystem::path graph_path;
     double min_support;
@@ -1,6 +1,7 @@
 #include <limits>
 #include <memory>
 #include <set>
+#include <string>
 
 #include <gtest/gtest.h>
 
@@ -10,6 +11,7 @@
 #include "core/algorithms/md/md_verifier/highlights/highlights.h"
 #include "core/algorithms/md/md_verifier/md_verifier.h"
 #include "core/config/names.h"
+#include "core/model/table/dataset.h"
 #include "tests/common/all_csv_configs.h"
 
 namespace tests {
@@ -126,6 +128,32 @@ TEST_P(TestMDVerifierSuggestions, DefaultCase) {
     }
 }
 
+// The verifier reads only the columns of the MD from a parser, while a Dataset is loaded whole
+TEST_P(TestMDVerifierHighlights, LoadsOnlyMDColumnsLikeFullLoad) {
+    using Highlight = algos::md::MDHighlights::Highlight;
+    auto get_highlights = [](algos::md::MDVerifier const& verifier) {
+        std::multiset<std::string> highlights;
+        for (Highlight const& highlight : verifier.GetHighlights()) {
+            highlights.insert(highlight.ToString());
+        }
+        return highlights;
+    };
+
+    algos::StdParamsMap params = GetParam().params;
+    auto table = boost::any_cast<config::InputTable>(params.at(kLeftTable));
+    table->Reset();
+    std::unique_ptr<algos::md::MDVerifier> verifier = CreateMDVerifier(params);
+    bool const md_result = ExecuteAlgo(*verifier);
+
+    table->Reset();
+    params[kLeftTable] = config::InputTable{std::make_shared<model::Dataset>(table)};
+    std::unique_ptr<algos::md::MDVerifier> full_verifier = CreateMDVerifier(params);
+    ASSERT_EQ(ExecuteAlgo(*full_verifier), md_result);
+    EXPECT_DOUBLE_EQ(verifier->GetTrueRhsDecisionBoundary(),
+                     full_verifier->GetTrueRhsDecisionBoundary());
+    EXPECT_EQ(get_highlights(*verifier), get_highlights(*full_verifier));
+}
+
 double const kEps = std::numeric_limits<DecisionBoundary>::epsilon();
 
 INSTANTIATE_TEST_SUITE_P(
@@ -9,6 +9,7 @@
 #include "core/algorithms/metric/enums.h"
 #include "core/algorithms/metric/metric_verifier.h"
 #include "core/config/names.h"
+#include "core/config/thread_number/type.h"
 #include "tests/common/all_csv_configs.h"
 
 namespace tests {
@@ -124,6 +125,48 @@ TEST_P(TestHighlights, DefaultTest) {  // Assumes that highlights are sorted by
     }
 }
 
+TEST_P(TestHighlights, SameInParallel) {
+    auto params = GetParam().params;
+    params[onam::kThreads] = static_cast<config::ThreadNumType>(1);
+    auto sequential_verifier = CreateMetricVerifier(params);
+    params[onam::kThreads] = static_cast<config::ThreadNumType>(4);
+    auto parallel_verifier = CreateMetricVerifier(params);
+    ASSERT_EQ(GetResult(*sequential_verifier), GetResult(*parallel_verifier));
+
+    auto const& sequential_highlights = sequential_verifier->GetHighlights();
+    auto const& parallel_highlights = parallel_verifier->GetHighlights();
+    ASSERT_EQ(sequential_highlights.size(), parallel_highlights.size());
+    for (size_t i = 0; i < sequential_highlights.size(); ++i) {
+        ASSERT_EQ(sequential_highlights[i].size(), parallel_highlights[i].size());
+        for (size_t j = 0; j < sequential_highlights[i].size(); ++j) {
+            EXPECT_EQ(sequential_highlights[i][j].ToTuple(), parallel_highlights[i][j].ToTuple());
+        }
+    }
+}
+
+TEST_P(TestHighlights, LoadColumnsMatchesFullLoad) {
+    auto params = GetParam().params;
+    auto verifier = CreateMetricVerifier(params);
+
+    auto load_columns = boost::any_cast<std::vector<unsigned int>>(params.at(onam::kLhsIndices));
+    auto const rhs_indices =
+            boost::any_cast<std::vector<unsigned int>>(params.at(onam::kRhsIndices));
+    load_columns.insert(load_columns.end(), rhs_indices.begin(), rhs_indices.end());
+    params.emplace(onam::kLoadColumns, load_columns);
+    auto projected_verifier = CreateMetricVerifier(params);
+    ASSERT_EQ(GetResult(*projected_verifier), GetResult(*verifier));
+
+    auto const& highlights = verifier->GetHighlights();
+    auto const& projected_highlights = projected_verifier->GetHighlights();
+    ASSERT_EQ(projected_highlights.size(), highlights.size());
+    for (size_t i = 0; i < highlights.size(); ++i) {
+        ASSERT_EQ(projected_highlights[i].size(), highlights[i].size());
+        for (size_t j = 0; j < highlights[i].size(); ++j) {
+            EXPECT_EQ(projected_highlights[i][j].ToTuple(), highlights[i][j].ToTuple());
+        }
+    }
+}
+
 INSTANTIATE_TEST_SUITE_P(
         MetricVerifierTestSuite, TestMetricVerifying,
         ::testing::Values(
@@ -0,0 +1,238 @@
+#include <cstdint>
+#include <filesystem>
+#include <fstream>
+#include <functional>
+#include <iterator>
+#include <memory>
+#include <span>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+#include <gtest/gtest.h>
+
+#include "core/model/table/column_layout_relation_data.h"
+#include "core/model/table/column_layout_typed_relation_data.h"
+#include "core/model/table/relation_snapshot.h"
+#include "tests/common/all_csv_configs.h"
+#include "tests/common/csv_config_util.h"
+#include "tests/common/temp_path.h"
+
+namespace tests {
+
+namespace mo = model;
+
+namespace {
+
+/* Overwrites the bytes at skip past the first occurrence of stored in the file with replacement.
+ * Arrays of a snapshot are located by their bytes, as they are laid out in the file */
+template <typename T>
+void RewriteStored(std::filesystem::path const& path, std::string const& stored, size_t skip,
+                   std::vector<T> const& replacement) {
+    std::string bytes;
+    {
+        std::ifstream in(path, std::ios::binary);
+        bytes.assign(std::istreambuf_iterator<char>(in), std::istreambuf_iterator<char>());
+    }
+    size_t const pos = bytes.find(stored);
+    ASSERT_NE(pos, std::string::npos);
+    bytes.replace(pos + skip, replacement.size() * sizeof(T),
+                  reinterpret_cast<char const*>(replacement.data()),
+                  replacement.size() * sizeof(T));
+    std::ofstream(path, std::ios::binary | std::ios::trunc) << bytes;
+}
+
+template <typename T>
+void AppendBytes(std::string& bytes, std::span<T const> array) {
+    bytes.append(reinterpret_cast<char const*>(array.data()), array.size_bytes());
+}
+
+/* Clusters of the first column that has any */
+mo::RelationSnapshot::Clusters const* FindClusters(mo::RelationSnapshot const& snapshot) {
+    for (size_t i = 0; i != snapshot.GetNumColumns(); ++i) {
+        mo::RelationSnapshot::Clusters const& clusters = snapshot.GetColumn(i).clusters;
+        if (clusters.Size() != 0) return &clusters;
+    }
+    return nullptr;
+}
+
+/* Rewrites the stored cluster offsets of the first column that has clusters */
+void CorruptClusterOffsets(std::filesystem::path const& path,
+                           std::function<void(std::vector<std::uint64_t>&)> const& corrupt) {
+    std::string stored;
+    std::vector<std::uint64_t> offsets;
+    {
+        auto snapshot = mo::RelationSnapshot::Open(path);
+        mo::RelationSnapshot::Clusters const* clusters = FindClusters(*snapshot);
+        ASSERT_NE(clusters, nullptr) << "No column has clusters";
+        AppendBytes(stored, clusters->offsets);
+        AppendBytes(stored, clusters->rows);
+        offsets.assign(clusters->offsets.begin(), clusters->offsets.end());
+    }
+    corrupt(offsets);
+    ASSERT_NO_FATAL_FAILURE(RewriteStored(path, stored, 0, offsets));
+}
+
+/* Rewrites the stored cluster rows of the first column that has clusters */
+void CorruptClusterRows(std::filesystem::path const& path,
+                        std::function<void(std::vector<int>&)> const& corrupt) {
+    std::string stored;
+    size_t offsets_size;
+    std::vector<int> rows;
+    {
+        auto snapshot = mo::RelationSnapshot::Open(path);
+        mo::RelationSnapshot::Clusters const* clusters = FindClusters(*snapshot);
+        ASSERT_NE(clusters, nullptr) << "No column has clusters";
+        AppendBytes(stored, clusters->offsets);
+        offsets_size = stored.size();
+        AppendBytes(stored, clusters->rows);
+        rows.assign(clusters->rows.begin(), clusters->rows.end());
+    }
+    corrupt(rows);
+    ASSERT_NO_FATAL_FAILURE(RewriteStored(path, stored, offsets_size, rows));
+}
+
+/* Rewrites the stored type of the first value of the first column. The types are followed by
+ * zero padding and the value offsets */
+void CorruptTypeLayout(std::filesystem::path const& path, mo::TypeId type_id) {
+    std::string stored;
+    std::vector<mo::TypeId> type_layout;
+    {
+        auto snapshot = mo::RelationSnapshot::Open(path);
+        ASSERT_NE(snapshot->GetNumColumns(), 0u);
+        mo::RelationSnapshot::ColumnView const& column = snapshot->GetColumn(0);
+        ASSERT_FALSE(column.type_layout.empty());
+        AppendBytes(stored, column.type_layout);
+        stored.append((8 - stored.size() % 8) % 8, '\0');
+        AppendBytes(stored, column.value_offsets);
+        type_layout.assign(column.type_layout.begin(), column.type_layout.end());
+    }
+    type_layout.front() = type_id;
+    ASSERT_NO_FATAL_FAILURE(RewriteStored(path, stored, 0, type_layout));
+}
+
+}  // namespace
+
+class TestRelationSnapshot : public ::testing::TestWithParam<CSVConfig> {
+protected:
+    std::filesystem::path cache_dir_ = MakeTempPath("_snapshots");
+
+    void TearDown() override {
+        std::filesystem::remove_all(cache_dir_);
+    }
+};
+
+TEST_P(TestRelationSnapshot, MatchesParsedRelation) {
+    CSVConfig const& csv_config = GetParam();
+    mo::RelationSnapshotCache cache(cache_dir_);
+    auto snapshot = cache.GetOrCreate(csv_config);
+
+    auto parsed = ColumnLayoutRelationData::CreateFrom(*MakeInputTable(csv_config));
+    mo::SnapshotDatasetStream snapshot_stream(snapshot);
+    auto loaded = ColumnLayoutRelationData::CreateFrom(snapshot_stream);
+
+    ASSERT_EQ(loaded->GetNumRows(), parsed->GetNumRows());
+    ASSERT_EQ(loaded->GetNumColumns(), parsed->GetNumColumns());
+    for (size_t i = 0; i != parsed->GetNumColumns(); ++i) {
+        EXPECT_EQ(loaded->GetSchema()->GetColumn(i)->GetName(),
+                  parsed->GetSchema()->GetColumn(i)->GetName());
+        EXPECT_EQ(loaded->GetColumnData(i).GetProbingTable(),
+                  parsed->GetColumnData(i).GetProbingTable())
+                << "Column index: " << i;
+        EXPECT_EQ(loaded->GetColumnData(i).GetPositionListIndex()->GetNepAsLong(),
+                  parsed->GetColumnData(i).GetPositionListIndex()->GetNepAsLong());
+    }
+
+    auto parsed_typed =
+            mo::ColumnLayoutTypedRelationData::CreateFrom(*MakeInputTable(csv_config), true);
+    snapshot_stream.Reset();
+    auto loaded_typed = mo::ColumnLayoutTypedRelationData::CreateFrom(snapshot_stream, true);
+
+    ASSERT_EQ(loaded_typed->GetNumRows(), parsed_typed->GetNumRows());
+    for (size_t i = 0; i != parsed_typed->GetNumColumns(); ++i) {
+        mo::TypedColumnData const& expected = parsed_typed->GetColumnData(i);
+        mo::TypedColumnData const& actual = loaded_typed->GetColumnData(i);
+        ASSERT_EQ(actual.GetTypeId(), expected.GetTypeId()) << "Column index: " << i;
+        for (size_t row = 0; row != expected.GetNumRows(); ++row) {
+            ASSERT_EQ(actual.GetValueTypeId(row), expected.GetValueTypeId(row));
+            ASSERT_EQ(actual.GetDataAsString(row), expected.GetDataAsString(row));
+        }
+    }
+}
+
+TEST_P(TestRelationSnapshot, ReusedWhileSourceIsUnchanged) {
+    CSVConfig const& csv_config = GetParam();
+    mo::RelationSnapshotCache cache(cache_dir_);
+    auto first = cache.GetOrCreate(csv_config);
+    auto second = cache.GetOrCreate(csv_config);
+
+    EXPECT_EQ(first->GetKey(), second->GetKey());
+    EXPECT_EQ(std::distance(std::filesystem::directory_iterator(cache_dir_),
+                            std::filesystem::directory_iterator{}),
+              1);
+
+    CSVConfig other_options = csv_config;
+    other_options.has_header = !csv_config.has_header;
+    EXPECT_NE(cache.GetSnapshotPath(mo::RelationSnapshotKey::For(other_options)),
+              cache.GetSnapshotPath(first->GetKey()));
+}
+
+TEST_P(TestRelationSnapshot, RejectsCorruptedClusterOffsets) {
+    CSVConfig const& csv_config = GetParam();
+    mo::RelationSnapshotCache cache(cache_dir_);
+    std::filesystem::path const path =
+            cache.GetSnapshotPath(cache.GetOrCreate(csv_config)->GetKey());
+    std::filesystem::path const corrupted_path = cache_dir_ / "corrupted";
+
+    std::vector<std::function<void(std::vector<std::uint64_t>&)>> const corruptions = {
+            /* does not start at 0 */
+            [](std::vector<std::uint64_t>& offsets) { offsets.front() = 1; },
+            /* decreases, but still ends at the number of rows */
+            [](std::vector<std::uint64_t>& offsets) {
+                offsets[offsets.size() - 2] = offsets.back() + 1;
+            },
+            /* ends beyond the rows */
+            [](std::vector<std::uint64_t>& offsets) { offsets.back() += 1; },
+    };
+    for (size_t i = 0; i != corruptions.size(); ++i) {
+        std::filesystem::copy_file(path, corrupted_path,
+                                   std::filesystem::copy_options::overwrite_existing);
+        ASSERT_NO_FATAL_FAILURE(CorruptClusterOffsets(corrupted_path, corruptions[i]));
+        EXPECT_THROW(mo::RelationSnapshot::Open(corrupted_path), std::runtime_error)
+                << "Corruption " << i;
+    }
+}
+
+TEST_P(TestRelationSnapshot, RejectsCorruptedRowsAndTypes) {
+    CSVConfig const& csv_config = GetParam();
+    mo::RelationSnapshotCache cache(cache_dir_);
+    std::filesystem::path const path =
+            cache.GetSnapshotPath(cache.GetOrCreate(csv_config)->GetKey());
+    std::filesystem::path const corrupted_path = cache_dir_ / "corrupted";
+    auto const num_rows = static_cast<int>(mo::RelationSnapshot::Open(path)->GetNumRows());
+
+    std::vector<std::function<void()>> const corruptions = {
+            [&]() {
+                CorruptClusterRows(corrupted_path,
+                                   [](std::vector<int>& rows) { rows.front() = -1; });
+            },
+            [&]() {
+                CorruptClusterRows(corrupted_path,
+                                   [num_rows](std::vector<int>& rows) { rows.back() = num_rows; });
+            },
+            [&]() { CorruptTypeLayout(corrupted_path, static_cast<mo::TypeId>(0x7f)); },
+    };
+    for (size_t i = 0; i != corruptions.size(); ++i) {
+        std::filesystem::copy_file(path, corrupted_path,
+                                   std::filesystem::copy_options::overwrite_existing);
+        ASSERT_NO_FATAL_FAILURE(corruptions[i]());
+        EXPECT_THROW(mo::RelationSnapshot::Open(corrupted_path), std::runtime_error)
+                << "Corruption " << i;
+    }
+}
+
+INSTANTIATE_TEST_SUITE_P(RelationSnapshot, TestRelationSnapshot,
+                         ::testing::Values(kWdcSatellites, kCIPublicHighway700, kNullEmpty,
+                                           kBernoulliRelation));
+
+}  // namespace tests
@@ -0,0 +1,158 @@
+#include <algorithm>
+#include <cstddef>
+#include <iterator>
+#include <random>
+#include <vector>
+
+#include <gtest/gtest.h>
+
+#include "core/algorithms/cfd/model/cfd_types.h"
+#include "core/algorithms/cfd/model/tid_bitmap.h"
+
+namespace tests {
+
+namespace {
+
+using algos::cfd::SimpleTIdList;
+using algos::cfd::TIdBitmap;
+
+/* Ids of a chunk share their high 16 bits; a chunk of more than 4096 ids is a dense bitmap */
+constexpr int kChunkSize = 1 << 16;
+constexpr int kMaxArraySize = 4096;
+
+SimpleTIdList ToList(TIdBitmap const& bitmap) {
+    return {bitmap.begin(), bitmap.end()};
+}
+
+/* Every step-th id of a chunk starting from first, count ids in total */
+SimpleTIdList Strided(int chunk, int first, int step, int count) {
+    SimpleTIdList tids;
+    for (int i = 0; i != count; ++i) {
+        tids.push_back(chunk * kChunkSize + first + i * step);
+    }
+    return tids;
+}
+
+SimpleTIdList Concat(std::vector<SimpleTIdList> const& parts) {
+    SimpleTIdList tids;
+    for (SimpleTIdList const& part : parts) {
+        tids.insert(tids.end(), part.begin(), part.end());
+    }
+    return tids;
+}
+
+/* Each id of the first chunks is taken with its chunk's probability */
+SimpleTIdList Random(std::mt19937& gen, std::vector<double> const& chunk_densities) {
+    SimpleTIdList tids;
+    for (std::size_t chunk = 0; chunk != chunk_densities.size(); ++chunk) {
+        std::bernoulli_distribution take(chunk_densities[chunk]);
+        for (int low = 0; low != kChunkSize; ++low) {
+            if (take(gen)) tids.push_back(static_cast<int>(chunk) * kChunkSize + low);
+        }
+    }
+    return tids;
+}
+
+void CheckIntersection(SimpleTIdList const& lhs, SimpleTIdList const& rhs) {
+    SimpleTIdList expected;
+    std::ranges::set_intersection(lhs, rhs, std::back_inserter(expected));
+    TIdBitmap const lhs_bitmap = TIdBitmap::FromSorted(lhs);
+    TIdBitmap const rhs_bitmap = TIdBitmap::FromSorted(rhs);
+    for (TIdBitmap const& intersection :
+         {lhs_bitmap.Intersect(rhs_bitmap), rhs_bitmap.Intersect(lhs_bitmap)}) {
+        EXPECT_EQ(intersection.size(), expected.size());
+        EXPECT_EQ(intersection.empty(), expected.empty());
+        EXPECT_EQ(ToList(intersection), expected);
+    }
+}
+
+}  // namespace
+
+TEST(TIdBitmapTest, Empty) {
+    TIdBitmap const bitmap = TIdBitmap::FromSorted({});
+    EXPECT_TRUE(bitmap.empty());
+    EXPECT_EQ(bitmap.size(), 0u);
+    EXPECT_TRUE(bitmap.begin() == bitmap.end());
+    EXPECT_TRUE(TIdBitmap{}.Intersect(bitmap).empty());
+}
+
+TEST(TIdBitmapTest, FromSortedAroundArrayLimit) {
+    for (int count : {1, kMaxArraySize - 1, kMaxArraySize, kMaxArraySize + 1, kChunkSize}) {
+        SimpleTIdList const tids = Strided(0, 0, kChunkSize / count, count);
+        TIdBitmap const bitmap = TIdBitmap::FromSorted(tids);
+        EXPECT_EQ(bitmap.size(), tids.size()) << count;
+        EXPECT_EQ(ToList(bitmap), tids) << count;
+    }
+}
+
+TEST(TIdBitmapTest, FromSortedAtChunkBoundaries) {
+    SimpleTIdList const tids = {0,
+                                kChunkSize - 1,
+                                kChunkSize,
+                                kChunkSize + 1,
+                                2 * kChunkSize - 1,
+                                5 * kChunkSize,
+                                6 * kChunkSize - 1};
+    EXPECT_EQ(ToList(TIdBitmap::FromSorted(tids)), tids);
+
+    /* a dense chunk between sparse ones, with its first and last ids set */
+    SimpleTIdList const mixed = Concat({{kChunkSize - 1},
+                                        Strided(1, 0, 3, kChunkSize / 3 + 1),
+                                        {2 * kChunkSize + 5}});
+    ASSERT_EQ(mixed[mixed.size() - 2], 2 * kChunkSize - 1);
+    TIdBitmap const bitmap = TIdBitmap::FromSorted(mixed);
+    EXPECT_EQ(bitmap.size(), mixed.size());
+    EXPECT_EQ(ToList(bitmap), mixed);
+}
+
+TEST(TIdBitmapTest, IteratorIncrements) {
+    SimpleTIdList const tids = Concat({Strided(0, 1, 2, kMaxArraySize + 100), {3 * kChunkSize}});
+    TIdBitmap const bitmap = TIdBitmap::FromSorted(tids);
+    auto it = bitmap.begin();
+    for (int tid : tids) {
+        ASSERT_FALSE(it == bitmap.end());
+        EXPECT_EQ(*it++, tid);
+    }
+    EXPECT_TRUE(it == bitmap.end());
+}
+
+TEST(TIdBitmapTest, IntersectArrays) {
+    CheckIntersection(Strided(0, 0, 2, 1000), Strided(0, 0, 3, 1000));
+    /* chunks present on one side only */
+    CheckIntersection(Concat({Strided(0, 0, 5, 100), Strided(2, 0, 5, 100)}),
+                      Concat({Strided(1, 0, 5, 100), Strided(2, 1, 1, 100)}));
+    CheckIntersection(Strided(0, 0, 2, 100), Strided(0, 1, 2, 100));
+}
+
+TEST(TIdBitmapTest, IntersectArrayWithBitmap) {
+    SimpleTIdList const dense = Strided(1, 0, 2, kChunkSize / 2);
+    CheckIntersection(Strided(1, 0, 7, 1000), dense);
+    CheckIntersection(Concat({Strided(0, 0, 1, 10), {kChunkSize, 2 * kChunkSize - 2}}), dense);
+    CheckIntersection(Strided(1, 1, 2, 1000), dense);
+}
+
+TEST(TIdBitmapTest, IntersectBitmaps) {
+    /* the intersection is dense again */
+    CheckIntersection(Strided(0, 0, 2, kChunkSize / 2), Strided(0, 0, 4, kChunkSize / 4));
+    /* it has exactly as many ids as an array may hold, and one more */
+    SimpleTIdList const first_ids = Strided(0, 0, 1, kMaxArraySize + 10);
+    CheckIntersection(first_ids, Strided(0, 10, 1, kMaxArraySize + 5));
+    CheckIntersection(first_ids, Strided(0, 9, 1, kMaxArraySize + 1));
+    CheckIntersection(Strided(0, 0, 2, kChunkSize / 2), Strided(0, 1, 2, kChunkSize / 2));
+}
+
+TEST(TIdBitmapTest, IntersectRandom) {
+    std::mt19937 gen(0);
+    std::vector<std::vector<double>> const densities = {
+            {0.01, 0.5, 0.0, 0.06, 0.9}, {0.5, 0.01, 0.3, 0.07, 0.001}, {0.2, 0.2, 0.2}};
+    for (std::vector<double> const& lhs_densities : densities) {
+        for (std::vector<double> const& rhs_densities : densities) {
+            SimpleTIdList const lhs = Random(gen, lhs_densities);
+            SimpleTIdList const rhs = Random(gen, rhs_densities);
+            EXPECT_EQ(ToList(TIdBitmap::FromSorted(lhs)), lhs);
+            CheckIntersection(lhs, rhs);
+        }
+    }
+}
+
+}  // namespace tests
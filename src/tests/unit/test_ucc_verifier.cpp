@@ -78,6 +78,26 @@ TEST_P(TestUCCVerifierSimple, DefaultTest) {
     EXPECT_DOUBLE_EQ(verifier->GetError(), p.GetExpectedError());
 }
 
+TEST_P(TestUCCVerifierSimple, LoadColumnsMatchesFullLoad) {
+    algos::StdParamsMap params = GetParam().GetParamsMap();
+    auto it = params.find(onam::kUCCIndices);
+    if (it == params.end()) {
+        GTEST_SKIP() << "the UCC spans the whole table";
+    }
+    auto verifier = algos::CreateAndLoadAlgorithm<algos::UCCVerifier>(params);
+    verifier->Execute();
+    params.emplace(onam::kLoadColumns, boost::any_cast<config::IndicesType>(it->second));
+    auto projected_verifier = algos::CreateAndLoadAlgorithm<algos::UCCVerifier>(params);
+    projected_verifier->Execute();
+
+    EXPECT_EQ(projected_verifier->UCCHolds(), verifier->UCCHolds());
+    EXPECT_EQ(projected_verifier->GetNumRowsViolatingUCC(), verifier->GetNumRowsViolatingUCC());
+    EXPECT_EQ(projected_verifier->GetNumClustersViolatingUCC(),
+              verifier->GetNumClustersViolatingUCC());
+    EXPECT_EQ(projected_verifier->GetClustersViolatingUCC(), verifier->GetClustersViolatingUCC());
+    EXPECT_DOUBLE_EQ(projected_verifier->GetError(), verifier->GetError());
+}
+
 INSTANTIATE_TEST_SUITE_P(
         UCCVerifierSimpleTestSuite, TestUCCVerifierSimple,
         ::testing::Values(
@@ -1,5 +1,7 @@
 #include <iostream>
+#include <set>
 #include <thread>
+#include <vector>
 
 #include <gmock/gmock.h>
 #include <gtest/gtest.h>
@@ -8,7 +10,9 @@
 #include "core/model/table/agree_set_factory.h"
 #include "core/model/table/column_layout_relation_data.h"
 #include "core/model/table/identifier_set.h"
+#include "core/model/table/tuple_matrix.h"
 #include "core/util/levenshtein_distance.h"
+#include "core/util/worker_thread_pool.h"
 #include "tests/common/all_csv_configs.h"
 #include "tests/common/csv_config_util.h"
 
@@ -17,12 +21,13 @@ namespace tests {
 using std::deque, std::vector, std::cout, std::endl, std::unique_ptr, model::AgreeSetFactory,
         model::MCGenMethod, model::AgreeSetsGenMethod;
 using ::testing::ContainerEq, ::testing::Eq;
+using Cluster = model::PLI::Cluster;
 
 namespace fs = std::filesystem;
 
 TEST(pliChecker, first) {
-    deque<vector<int>> ans = {{0, 2, 8, 11}, {1, 5, 9}, {4, 14}, {6, 7, 18}, {10, 17}};
-    deque<vector<int>> index;
+    deque<Cluster> ans = {{0, 2, 8, 11}, {1, 5, 9}, {4, 14}, {6, 7, 18}, {10, 17}};
+    deque<Cluster> index;
     try {
         auto input_table = MakeInputTable(kTest1);
         auto test = ColumnLayoutRelationData::CreateFrom(*input_table);
@@ -36,7 +41,7 @@ TEST(pliChecker, first) {
 }
 
 TEST(pliIntersectChecker, first) {
-    deque<vector<int>> ans = {{2, 5}};
+    deque<Cluster> ans = {{2, 5}};
     std::shared_ptr<model::PositionListIndex> intersection;
 
     try {
@@ -57,10 +62,10 @@ TEST(pliIntersectChecker, first) {
 }
 
 TEST(pliwsChecker, first) {
-    deque<vector<int>> ans_index = {{0, 2, 8, 11}, {1, 5, 9}, {4, 14}, {6, 7, 18}, {10, 17}};
-    deque<vector<int>> ans_sngt = {{3}, {12}, {13}, {15}, {16}};
-    deque<vector<int>> index;
-    deque<vector<int>> sngt;
+    deque<Cluster> ans_index = {{0, 2, 8, 11}, {1, 5, 9}, {4, 14}, {6, 7, 18}, {10, 17}};
+    deque<Cluster> ans_sngt = {{3}, {12}, {13}, {15}, {16}};
+    deque<Cluster> index;
+    deque<Cluster> sngt;
     try {
         auto input_table = MakeInputTable(kTest1);
         auto test = ColumnLayoutRelationData::CreateFrom(*input_table);
@@ -76,8 +81,8 @@ TEST(pliwsChecker, first) {
 }
 
 TEST(pliwsIntersectChecker, first) {
-    deque<vector<int>> ans_index = {{2, 5}};
-    deque<vector<int>> ans_sngt = {{0}, {1}, {3}, {4}, {6}, {7}, {8}, {9}, {10}, {11}};
+    deque<Cluster> ans_index = {{2, 5}};
+    deque<Cluster> ans_sngt = {{0}, {1}, {3}, {4}, {6}, {7}, {8}, {9}, {10}, {11}};
     std::shared_ptr<model::PLIWithSingletons> intersection;
 
     try {
@@ -223,6 +228,29 @@ void TestAgreeSetFactory(AgreeSetFactory::Configuration c) {
     ASSERT_THAT(agree_sets_ans, ContainerEq(agree_sets_actual));
 }
 
+void TestAgreeSetList(AgreeSetFactory::Configuration c) {
+    try {
+        auto input_table = MakeInputTable(kCIPublicHighway700);
+        auto relation = ColumnLayoutRelationData::CreateFrom(*input_table);
+        RelationalSchema const* schema = relation->GetSchema();
+        AgreeSetFactory factory(relation.get(), c);
+        AgreeSetFactory::SetOfAgreeSets const agree_sets_ans = factory.GenAgreeSets();
+        model::ColumnSetList const agree_sets_actual = factory.GenAgreeSetList();
+
+        ASSERT_EQ(agree_sets_actual.Size(), agree_sets_ans.size());
+        for (size_t i = 0; i < agree_sets_actual.Size(); ++i) {
+            ASSERT_TRUE(agree_sets_ans.contains(agree_sets_actual.GetVertical(i, schema)));
+            if (i > 0) {
+                ASSERT_FALSE(agree_sets_actual.IsSubset(agree_sets_actual.GetRow(i),
+                                                        agree_sets_actual.GetRow(i - 1)));
+            }
+        }
+    } catch (std::runtime_error const& e) {
+        cout << "Exception raised in test: " << e.what() << endl;
+        FAIL();
+    }
+}
+
 TEST(AgreeSetFactoryTest, UsingVectorOfIDSets) {
     AgreeSetFactory::Configuration c(AgreeSetsGenMethod::kUsingVectorOfIDSets);
     TestAgreeSetFactory(c);
@@ -238,6 +266,46 @@ TEST(AgreeSetFactoryTest, UsingGetAgreeSet) {
     TestAgreeSetFactory(c);
 }
 
+TEST(TupleMatrixTest, AllPairsAgreeSets) {
+    auto input_table = MakeInputTable(kCIPublicHighway700);
+    model::TupleMatrix const tuples = model::TupleMatrix::ReadTable(*input_table);
+    size_t const num_columns = tuples.GetNumColumns();
+
+    std::set<boost::dynamic_bitset<>> agree_sets_ans;
+    std::vector<model::TupleMatrix::TuplePair> pairs;
+    for (size_t t1 = 0; t1 < tuples.GetNumRows(); ++t1) {
+        for (size_t t2 = t1 + 1; t2 < tuples.GetNumRows(); ++t2) {
+            boost::dynamic_bitset<> agree_set(num_columns);
+            for (size_t i = 0; i < num_columns; ++i) {
+                agree_set[i] = tuples.GetValue(t1, i) == tuples.GetValue(t2, i);
+            }
+            if (agree_sets_ans.insert(agree_set).second) {
+                pairs.emplace_back(t1, t2);
+            }
+        }
+    }
+
+    util::WorkerThreadPool pool(4);
+    std::vector<util::WorkerThreadPool*> const pools = {nullptr, &pool};
+    for (util::WorkerThreadPool* pool_ptr : pools) {
+        model::ColumnSetList const agree_sets = tuples.GetAllPairsAgreeSets(pool_ptr);
+        ASSERT_EQ(agree_sets.Size(), agree_sets_ans.size());
+        for (size_t i = 0; i < agree_sets.Size(); ++i) {
+            ASSERT_TRUE(agree_sets_ans.contains(agree_sets.GetBitset(i)));
+        }
+
+        model::ColumnSetList const pair_agree_sets = tuples.GetAgreeSets(pairs, pool_ptr);
+        ASSERT_EQ(pair_agree_sets.Size(), pairs.size());
+        for (size_t i = 0; i < pairs.size(); ++i) {
+            auto const [t1, t2] = pairs[i];
+            for (size_t column = 0; column < num_columns; ++column) {
+                ASSERT_EQ(pair_agree_sets.Contains(i, column),
+                          tuples.GetValue(t1, column) == tuples.GetValue(t2, column));
+            }
+        }
+    }
+}
+
 TEST(AgreeSetFactoryTest, UsingMCAndGetAgreeSet) {
     AgreeSetFactory::Configuration c(AgreeSetsGenMethod::kUsingMCAndGetAgreeSet);
     TestAgreeSetFactory(c);
@@ -258,6 +326,14 @@ TEST(AgreeSetFactoryTest, UsingHandlePartition) {
     TestAgreeSetFactory(c);
 }
 
+TEST(AgreeSetFactoryTest, AgreeSetList) {
+    TestAgreeSetList(AgreeSetFactory::Configuration(1));
+}
+
+TEST(AgreeSetFactoryTest, AgreeSetListParallel) {
+    TestAgreeSetList(AgreeSetFactory::Configuration(4));
+}
+
 #if 0
 TEST(AgreeSetFactoryTest, MCGenParallel) {
     AgreeSetFactory::Configuration c(AgreeSetsGenMethod::kUsingVectorOfIDSets,
@@ -284,6 +360,16 @@ TEST_P(TestLevenshtein, Default) {
     EXPECT_EQ(actual, p.expected);
 }
 
+TEST_P(TestLevenshtein, Bounded) {
+    TestLevenshteinParam const& p = GetParam();
+    EXPECT_EQ(util::BoundedLevenshteinDistance(p.l, p.r, p.expected), p.expected);
+    EXPECT_EQ(util::BoundedLevenshteinDistance(p.l, p.r, p.expected + 3), p.expected);
+    if (p.expected != 0) {
+        EXPECT_EQ(util::BoundedLevenshteinDistance(p.l, p.r, p.expected - 1), p.expected);
+        EXPECT_EQ(util::BoundedLevenshteinDistance(p.l, p.r, 0), 1);
+    }
+}
+
 INSTANTIATE_TEST_SUITE_P(TestLevenshteinSuite, TestLevenshtein,
                          ::testing::Values(TestLevenshteinParam("1", "1", 0),
                                            TestLevenshteinParam("1", "12", 1),
@@ -0,0 +1,205 @@
+#include <algorithm>
+#include <map>
+#include <memory>
+#include <random>
+#include <string>
+#include <utility>
+#include <variant>
+#include <vector>
+
+#include <boost/dynamic_bitset.hpp>
+#include <gtest/gtest.h>
+
+#include "core/model/table/relational_schema.h"
+#include "core/model/table/vertical.h"
+#include "core/model/table/vertical_map.h"
+
+namespace tests {
+
+class TestVerticalMap : public ::testing::TestWithParam<std::size_t> {
+protected:
+    RelationalSchema schema_{"test"};
+
+    void SetUp() override {
+        for (std::size_t i = 0; i != GetParam(); ++i) {
+            schema_.AppendColumn(std::to_string(i));
+        }
+    }
+
+    Vertical MakeVertical(std::initializer_list<std::size_t> columns) const {
+        boost::dynamic_bitset<> indices(schema_.GetNumColumns());
+        for (std::size_t column : columns) {
+            indices.set(column);
+        }
+        return schema_.GetVertical(std::move(indices));
+    }
+};
+
+TEST_P(TestVerticalMap, VerticalEquality) {
+    std::size_t const last = GetParam() - 1;
+    Vertical const a = MakeVertical({0, last});
+    Vertical const b = MakeVertical({0, last});
+    Vertical const c = MakeVertical({0});
+
+    EXPECT_EQ(a, b);
+    EXPECT_EQ(std::hash<Vertical>()(a), std::hash<Vertical>()(b));
+    EXPECT_NE(a, c);
+    EXPECT_TRUE(a.Contains(c));
+    EXPECT_FALSE(c.Contains(a));
+    EXPECT_TRUE(c < a);
+    EXPECT_EQ(a.Without(MakeVertical({last})), c);
+
+    Vertical moved = a;
+    Vertical const taken = std::move(moved);
+    EXPECT_EQ(taken, a);
+}
+
+TEST_P(TestVerticalMap, PutGetRemove) {
+    model::VerticalMap<Vertical> map(&schema_);
+    Vertical const key = MakeVertical({1, 2});
+    Vertical const first = MakeVertical({1});
+    Vertical const second = MakeVertical({2});
+
+    EXPECT_EQ(map.Put(key, std::make_shared<Vertical>(first)), nullptr);
+    EXPECT_EQ(*map.Put(key, std::make_shared<Vertical>(second)), first);
+    EXPECT_EQ(map.GetSize(), 1);
+    EXPECT_EQ(*map.Get(key), second);
+    EXPECT_EQ(map.Get(first), nullptr);
+
+    EXPECT_EQ(*map.Remove(key), second);
+    EXPECT_EQ(map.Remove(key), nullptr);
+    EXPECT_TRUE(map.IsEmpty());
+}
+
+TEST_P(TestVerticalMap, SubsetAndSupersetQueries) {
+    std::size_t const last = GetParam() - 1;
+    model::VerticalMap<std::monostate> map(&schema_);
+    auto const value = std::make_shared<std::monostate>();
+    for (Vertical const& key : {schema_.CreateEmptyVertical(), MakeVertical({0}),
+                                MakeVertical({0, 1}), MakeVertical({1, last}),
+                                MakeVertical({0, 1, last})}) {
+        map.Put(key, value);
+    }
+
+    EXPECT_EQ(map.GetSubsetEntries(MakeVertical({0, 1})).size(), 3);
+    EXPECT_EQ(map.GetSupersetEntries(MakeVertical({1})).size(), 3);
+    EXPECT_EQ(map.GetRestrictedSupersetEntries(MakeVertical({1}), MakeVertical({last})).size(), 1);
+    EXPECT_EQ(map.GetAnySupersetEntry(MakeVertical({2})).second, nullptr);
+
+    EXPECT_TRUE(map.RemoveSupersetEntries(MakeVertical({last})));
+    EXPECT_EQ(map.GetSize(), 3);
+    EXPECT_EQ(map.GetSupersetEntries(MakeVertical({1})).size(), 1);
+    EXPECT_TRUE(map.RemoveSubsetEntries(MakeVertical({0})));
+    EXPECT_EQ(map.KeySet().size(), 1);
+}
+
+TEST_P(TestVerticalMap, ManyEntriesMatchReference) {
+    using Bitset = boost::dynamic_bitset<>;
+    constexpr int kSteps = 20000;
+    constexpr int kCheckPeriod = 2000;
+    std::size_t const num_columns = GetParam();
+    // values are single-column verticals, identified by their column
+    model::VerticalMap<Vertical> map(&schema_);
+    std::map<Bitset, std::size_t> reference;
+    std::mt19937 gen(42);
+
+    // keys of fewer than 8 of the first 24 columns: puts often hit present keys, while there are
+    // still thousands of distinct keys, enough for several rehashes (except for the 4-column
+    // schema, which has only 16 keys)
+    auto random_key = [&]() {
+        Bitset key(num_columns);
+        std::size_t const arity = gen() % std::min<std::size_t>(num_columns, 8);
+        for (std::size_t i = 0; i != arity; ++i) {
+            key.set(gen() % std::min<std::size_t>(num_columns, 24));
+        }
+        return key;
+    };
+
+    auto make_value = [&](std::size_t column) {
+        return std::make_shared<Vertical>(MakeVertical({column}));
+    };
+    auto column_of = [](std::shared_ptr<Vertical const> const& value) {
+        return value->GetColumnIndicesRef().find_first();
+    };
+
+    auto check = [&]() {
+        ASSERT_EQ(map.GetSize(), reference.size());
+        for (auto const& [key, value] : reference) {
+            auto const found = map.Get(key);
+            ASSERT_NE(found, nullptr);
+            ASSERT_EQ(column_of(found), value);
+        }
+        for (int query = 0; query != 50; ++query) {
+            Bitset const key = random_key();
+            Vertical const vertical = schema_.GetVertical(key);
+            std::map<Bitset, std::size_t> expected_subsets;
+            std::map<Bitset, std::size_t> expected_supersets;
+            for (auto const& [other, value] : reference) {
+                if (other.is_subset_of(key)) expected_subsets.emplace(other, value);
+                if (key.is_subset_of(other)) expected_supersets.emplace(other, value);
+            }
+            std::map<Bitset, std::size_t> subsets;
+            for (auto const& [other, value] : map.GetSubsetEntries(vertical)) {
+                ASSERT_TRUE(subsets.emplace(other.GetColumnIndices(), column_of(value)).second);
+            }
+            std::map<Bitset, std::size_t> supersets;
+            for (auto const& [other, value] : map.GetSupersetEntries(vertical)) {
+                ASSERT_TRUE(supersets.emplace(other.GetColumnIndices(), column_of(value)).second);
+            }
+            ASSERT_EQ(subsets, expected_subsets);
+            ASSERT_EQ(supersets, expected_supersets);
+            ASSERT_EQ(map.Get(key) == nullptr, !reference.contains(key));
+        }
+    };
+
+    // puts outweigh removals, so the map grows while leaving removed positions in its table
+    for (int step = 1; step <= kSteps; ++step) {
+        Bitset const key = random_key();
+        Vertical const vertical = schema_.GetVertical(key);
+        if (gen() % 3 != 0) {
+            std::size_t const value = step % num_columns;
+            auto const previous = map.Put(vertical, make_value(value));
+            auto const it = reference.find(key);
+            if (it == reference.end()) {
+                ASSERT_EQ(previous, nullptr);
+                reference.emplace(key, value);
+            } else {
+                ASSERT_NE(previous, nullptr);
+                ASSERT_EQ(column_of(previous), it->second);
+                it->second = value;
+            }
+        } else {
+            auto const removed = map.Remove(vertical);
+            auto const it = reference.find(key);
+            if (it == reference.end()) {
+                ASSERT_EQ(removed, nullptr);
+            } else {
+                ASSERT_NE(removed, nullptr);
+                ASSERT_EQ(column_of(removed), it->second);
+                reference.erase(it);
+            }
+        }
+        if (step % kCheckPeriod == 0) {
+            ASSERT_NO_FATAL_FAILURE(check());
+        }
+    }
+
+    // emptying the map and filling it again reuses the freed slots
+    for (auto const& [key, value] : reference) {
+        ASSERT_NE(map.Remove(key), nullptr);
+    }
+    reference.clear();
+    ASSERT_TRUE(map.IsEmpty());
+    ASSERT_NO_FATAL_FAILURE(check());
+    for (int step = 0; step != kCheckPeriod; ++step) {
+        Bitset const key = random_key();
+        map.Put(schema_.GetVertical(key), make_value(step % num_columns));
+        reference[key] = step % num_columns;
+    }
+    ASSERT_NO_FATAL_FAILURE(check());
+}
+
+// Schemas of inline and heap-only vertical representations
+INSTANTIATE_TEST_SUITE_P(VerticalMapTests, TestVerticalMap, ::testing::Values(4, 100, 300));
+
+}  // namespace tests
@@ -1,5 +1,11 @@
+#include <atomic>
+#include <cstddef>
+#include <stdexcept>
+#include <vector>
+
 #include <gtest/gtest.h>
 
+#include "core/util/parallel_for.h"
 #include "core/util/worker_thread_pool.h"
 
 namespace tests {
@@ -14,4 +20,30 @@ TEST(WorkerThreadPool, RepeatedConstructAndDestroyWithoutWork) {
     }
 }
 
+TEST(ParallelFor, VisitsEveryIndexOnce) {
+    constexpr std::size_t kSize = 1000;
+    util::WorkerThreadPool pool{4};
+    std::vector<util::WorkerThreadPool*> const pools = {&pool, nullptr};
+    for (util::WorkerThreadPool* pool_ptr : pools) {
+        std::vector<std::atomic<int>> visits(kSize);
+        util::ParallelFor(pool_ptr, kSize, [&](std::size_t i) { ++visits[i]; });
+        for (std::size_t i = 0; i < kSize; ++i) {
+            ASSERT_EQ(visits[i], 1);
+        }
+    }
+}
+
+TEST(ParallelFor, RethrowsAndPoolStaysUsable) {
+    util::WorkerThreadPool pool{4};
+    EXPECT_THROW(util::ParallelFor(&pool, 100,
+                                   [](std::size_t i) {
+                                       if (i == 10) throw std::runtime_error("failed");
+                                   }),
+                 std::runtime_error);
+
+    std::atomic<std::size_t> sum = 0;
+    util::ParallelFor(&pool, 100, [&](std::size_t i) { sum += i; });
+    EXPECT_EQ(sum, 99 * 100 / 2);
+}
+
 }  // namespace tests